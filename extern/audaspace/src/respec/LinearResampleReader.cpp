@@ -144,16 +144,23 @@ void LinearResampleReader::read(int& length, bool& eos, sample_t* buffer)
 	if(length == 0)
 		return;
 
-	for(int channel = 0; channel < m_channels; channel++)
+	// the source position only depends on the sample, compute it once for all channels
+	for(int i = 0; i < length; i++)
 	{
-		for(int i = 0; i < length; i++)
-		{
-			spos = (i + 1) / factor + m_cache_pos;
+		spos = (i + 1) / factor + m_cache_pos;
+
+		const float spos_floor = std::floor(spos);
+		const float fraction = spos - spos_floor;
+		const sample_t* low_samples = buf + (int)spos_floor * m_channels;
+		const sample_t* high_samples = buf + (int)std::ceil(spos) * m_channels;
+		sample_t* out = buffer + i * m_channels;
 
-			low = buf[(int)std::floor(spos) * m_channels + channel];
-			high = buf[(int)std::ceil(spos) * m_channels + channel];
+		for(int channel = 0; channel < m_channels; channel++)
+		{
+			low = low_samples[channel];
+			high = high_samples[channel];
 
-			buffer[i * m_channels + channel] = low + (spos - std::floor(spos)) * (high - low);
+			out[channel] = low + fraction * (high - low);
 		}
 	}
 
@@ -75,35 +75,58 @@ void Mixer::clear(int length)
 
 void Mixer::mix(sample_t* buffer, int start, int length, float volume)
 {
-	sample_t* out = m_buffer.getBuffer();
+	// the mixing buffer never aliases the input, which lets the compiler vectorize the loops
+	sample_t* __restrict out = m_buffer.getBuffer() + start * m_specs.channels;
+	const sample_t* __restrict in = buffer;
 
 	length = (std::min(m_length, length + start) - start) * m_specs.channels;
-	start *= m_specs.channels;
 
 	for(int i = 0; i < length; i++)
-		out[i + start] += buffer[i] * volume;
+		out[i] += in[i] * volume;
 }
 
 void Mixer::mix(sample_t* buffer, int start, int length, float volume_to, float volume_from)
 {
-	sample_t* out = m_buffer.getBuffer();
+	const int channels = m_specs.channels;
+	sample_t* __restrict out = m_buffer.getBuffer() + start * channels;
+	const sample_t* __restrict in = buffer;
 
 	length = (std::min(m_length, length + start) - start);
 
-	for(int i = 0; i < length; i++)
+	const float volume_step = (volume_to - volume_from) / float(length);
+
+	switch(channels)
 	{
-		float volume = volume_from * (1.0f - i / float(length)) + volume_to * (i / float(length));
+	case CHANNELS_MONO:
+		for(int i = 0; i < length; i++)
+			out[i] += in[i] * (volume_from + volume_step * i);
+		break;
+	case CHANNELS_STEREO:
+		for(int i = 0; i < length; i++)
+		{
+			const float volume = volume_from + volume_step * i;
+			out[i * 2] += in[i * 2] * volume;
+			out[i * 2 + 1] += in[i * 2 + 1] * volume;
+		}
+		break;
+	default:
+		for(int i = 0; i < length; i++)
+		{
+			const float volume = volume_from + volume_step * i;
 
-		for(int c = 0; c < m_specs.channels; c++)
-			out[(i + start) * m_specs.channels + c] += buffer[i * m_specs.channels + c] * volume;
+			for(int c = 0; c < channels; c++)
+				out[i * channels + c] += in[i * channels + c] * volume;
+		}
+		break;
 	}
 }
 
 void Mixer::read(data_t* buffer, float volume)
 {
-	sample_t* out = m_buffer.getBuffer();
+	sample_t* __restrict out = m_buffer.getBuffer();
+	const int length = m_length * m_specs.channels;
 
-	for(int i = 0; i < m_length * m_specs.channels; i++)
+	for(int i = 0; i < length; i++)
 		out[i] *= volume;
 
 	m_convert(buffer, (data_t*) out, m_length * m_specs.channels);
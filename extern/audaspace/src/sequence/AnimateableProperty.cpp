@@ -60,6 +60,10 @@ void AnimateableProperty::write(const float* data)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
+	// non-animated values are usually written again unchanged on every update
+	if(!m_isAnimated && std::memcmp(getBuffer(), data, m_count * sizeof(float)) == 0)
+		return;
+
 	m_isAnimated = false;
 	m_unknown.clear();
 	std::memcpy(getBuffer(), data, m_count * sizeof(float));
@@ -158,8 +158,11 @@ void SequenceEntry::setVolumeMaximum(float volume)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_volume_max = volume;
-	m_status++;
+	if(m_volume_max != volume)
+	{
+		m_volume_max = volume;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getVolumeMinimum()
@@ -171,8 +174,11 @@ void SequenceEntry::setVolumeMinimum(float volume)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_volume_min = volume;
-	m_status++;
+	if(m_volume_min != volume)
+	{
+		m_volume_min = volume;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getDistanceMaximum()
@@ -184,8 +190,11 @@ void SequenceEntry::setDistanceMaximum(float distance)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_distance_max = distance;
-	m_status++;
+	if(m_distance_max != distance)
+	{
+		m_distance_max = distance;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getDistanceReference()
@@ -197,8 +206,11 @@ void SequenceEntry::setDistanceReference(float distance)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_distance_reference = distance;
-	m_status++;
+	if(m_distance_reference != distance)
+	{
+		m_distance_reference = distance;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getAttenuation()
@@ -210,8 +222,11 @@ void SequenceEntry::setAttenuation(float factor)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_attenuation = factor;
-	m_status++;
+	if(m_attenuation != factor)
+	{
+		m_attenuation = factor;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getConeAngleOuter()
@@ -223,8 +238,11 @@ void SequenceEntry::setConeAngleOuter(float angle)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_cone_angle_outer = angle;
-	m_status++;
+	if(m_cone_angle_outer != angle)
+	{
+		m_cone_angle_outer = angle;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getConeAngleInner()
@@ -236,8 +254,11 @@ void SequenceEntry::setConeAngleInner(float angle)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_cone_angle_inner = angle;
-	m_status++;
+	if(m_cone_angle_inner != angle)
+	{
+		m_cone_angle_inner = angle;
+		m_status++;
+	}
 }
 
 float SequenceEntry::getConeVolumeOuter()
@@ -249,8 +270,11 @@ void SequenceEntry::setConeVolumeOuter(float volume)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
-	m_cone_volume_outer = volume;
-	m_status++;
+	if(m_cone_volume_outer != volume)
+	{
+		m_cone_volume_outer = volume;
+		m_status++;
+	}
 }
 
 AUD_NAMESPACE_END
@@ -18,8 +18,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
 
 #include "mantaio.h"
 #include "grid.h"
@@ -381,6 +385,43 @@ static void registerCustomCodecs()
                                        openvdb::points::TruncateCodec>::registerType();
 }
 
+// Files are compressed and written on background threads. The objects have already been
+// converted to OpenVDB grids at that point, so the simulation can continue. Only a few writes
+// can be pending, which bounds the memory used by the converted grids.
+static const size_t maxPendingWrites = 2;
+static std::mutex pendingWritesMutex;
+static std::deque<std::future<void>> pendingWrites;
+
+static void writeGridsVDB(const string &filename, openvdb::GridPtrVec gridsVDB, int vdbFlags)
+{
+  // Write to a temporary file which is renamed once complete, readers never see partial files.
+  const string tmpFilename = filename + ".tmp";
+  try {
+    openvdb::io::File file(tmpFilename);
+    file.setCompression(vdbFlags);
+    file.write(gridsVDB);
+    file.close();
+  }
+  catch (const openvdb::Exception &e) {
+    debMsg("writeObjectsVDB: Writing " << filename << " failed: " << e.what(), 1);
+    std::remove(tmpFilename.c_str());
+    return;
+  }
+  std::remove(filename.c_str());
+  if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+    debMsg("writeObjectsVDB: Could not rename " << tmpFilename << " to " << filename, 1);
+  }
+}
+
+void flushObjectsVDB()
+{
+  std::lock_guard<std::mutex> lock(pendingWritesMutex);
+  for (std::future<void> &write : pendingWrites) {
+    write.wait();
+  }
+  pendingWrites.clear();
+}
+
 int writeObjectsVDB(const string &filename,
                     std::vector<PbClass *> *objects,
                     float worldSize,
@@ -391,7 +432,6 @@ int writeObjectsVDB(const string &filename,
                     const Grid<Real> *clipGrid)
 {
   openvdb::initialize();
-  openvdb::io::File file(filename);
   openvdb::GridPtrVec gridsVDB;
 
   // Register custom codecs, this makes sure custom attributes can be read
@@ -526,15 +566,22 @@ int writeObjectsVDB(const string &filename,
         break;
       }
     }
-    file.setCompression(vdb_flags);
-    file.write(gridsVDB);
+
+    std::lock_guard<std::mutex> lock(pendingWritesMutex);
+    while (pendingWrites.size() >= maxPendingWrites) {
+      pendingWrites.front().wait();
+      pendingWrites.pop_front();
+    }
+    pendingWrites.push_back(
+        std::async(std::launch::async, writeGridsVDB, filename, std::move(gridsVDB), vdb_flags));
   }
-  file.close();
   return 1;
 }
 
 int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, float worldSize)
 {
+  // The file may still be written.
+  flushObjectsVDB();
 
   openvdb::initialize();
   openvdb::io::File file(filename);
@@ -741,6 +788,10 @@ int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, floa
   return 0;
 }
 
+void flushObjectsVDB()
+{
+}
+
 #endif  // OPENVDB==1
 
 }  // namespace Manta
@@ -81,6 +81,8 @@ int writeObjectsVDB(const std::string &filename,
 int readObjectsVDB(const std::string &filename,
                    std::vector<PbClass *> *objects,
                    float scale = 1.0);
+// Wait until the files passed to writeObjectsVDB() have been written.
+void flushObjectsVDB();
 
 // Numpy
 template<class T> int writeGridNumpy(const std::string &name, Grid<T> *grid);
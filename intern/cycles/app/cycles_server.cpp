@@ -39,7 +39,7 @@ int main(int argc, const char **argv)
   bool list = false, debug = false;
   int threads = 0, verbosity = 1;
 
-  vector<DeviceType> &types = Device::available_types();
+  vector<DeviceType> types = Device::available_types();
 
   foreach (DeviceType type, types) {
     if (devicelist != "")
@@ -83,7 +83,7 @@ int main(int argc, const char **argv)
   }
 
   if (list) {
-    vector<DeviceInfo> &devices = Device::available_devices();
+    vector<DeviceInfo> devices = Device::available_devices();
 
     printf("Devices:\n");
 
@@ -96,7 +96,7 @@ int main(int argc, const char **argv)
 
   /* find matching device */
   DeviceType device_type = Device::type_from_string(devicename.c_str());
-  vector<DeviceInfo> &devices = Device::available_devices();
+  vector<DeviceInfo> devices = Device::available_devices();
   DeviceInfo device_info;
 
   foreach (DeviceInfo &device, devices) {
@@ -110,7 +110,8 @@ int main(int argc, const char **argv)
 
   while (1) {
     Stats stats;
-    Device *device = Device::create(device_info, stats, true);
+    Profiler profiler;
+    Device *device = Device::create(device_info, stats, profiler, true);
     printf("Cycles Server with device: %s\n", device->info.description.c_str());
     device->server_run();
     delete device;
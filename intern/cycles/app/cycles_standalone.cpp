@@ -22,6 +22,7 @@
 #include "render/integrator.h"
 #include "render/scene.h"
 #include "render/session.h"
+#include "render/stats.h"
 
 #include "util/util_args.h"
 #include "util/util_foreach.h"
@@ -54,6 +55,8 @@ struct Options {
   bool quiet;
   bool show_help, interactive, pause;
   string output_path;
+  string stats_path;
+  double load_time;
 } options;
 
 static void session_print(const string &str)
@@ -128,8 +131,14 @@ static void scene_init()
 {
   options.scene = new Scene(options.scene_params, options.session->device);
 
+  if (!options.stats_path.empty()) {
+    options.scene->enable_update_stats();
+  }
+
   /* Read XML */
+  const double load_start_time = time_dt();
   xml_read_file(options.scene, options.filepath.c_str());
+  options.load_time = time_dt() - load_start_time;
 
   /* Camera width/height override? */
   if (!(options.width == 0 || options.height == 0)) {
@@ -165,9 +174,68 @@ static void session_init()
   options.session->start();
 }
 
+static string stats_json_string(const string &str)
+{
+  string result = str;
+  string_replace(result, "\\", "\\\\");
+  string_replace(result, "\"", "\\\"");
+  return "\"" + result + "\"";
+}
+
+static double stats_update_time(const NamedTimeStats &stats, const char *prefix)
+{
+  double time = 0.0;
+  foreach (const NamedTimeEntry &entry, stats.entries) {
+    if (string_startswith(entry.name, prefix)) {
+      time += entry.time;
+    }
+  }
+  return time;
+}
+
+/* Append the statistics of the finished render to the stats file, as one JSON object per
+ * line so that runs of different scenes, devices and revisions can be collected together. */
+static void stats_write()
+{
+  Session *session = options.session;
+  const SceneUpdateStats *update_stats = session->scene->update_stats;
+
+  double total_time, render_time;
+  session->progress.get_time(total_time, render_time);
+
+  const int samples = options.session_params.samples;
+  const double samples_per_second = (render_time > 0.0) ? samples / render_time : 0.0;
+
+  string json = "{";
+  json += "\"scene\": " + stats_json_string(options.filepath);
+  json += ", \"device\": " + stats_json_string(session->device->info.description);
+  json += string_printf(", \"width\": %d, \"height\": %d", options.width, options.height);
+  json += string_printf(", \"samples\": %d", samples);
+  json += string_printf(", \"load_time\": %f", options.load_time);
+  json += string_printf(", \"update_time\": %f", update_stats->scene.times.total_time);
+  json += string_printf(", \"bvh_build_time\": %f",
+                        stats_update_time(update_stats->geometry.times, "device_update (build"));
+  json += string_printf(", \"render_time\": %f", render_time);
+  json += string_printf(", \"samples_per_second\": %f", samples_per_second);
+  json += string_printf(", \"mem_peak\": %zu", session->stats.mem_peak);
+  json += "}\n";
+
+  FILE *file = path_fopen(options.stats_path, "a");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to write statistics to %s\n", options.stats_path.c_str());
+    return;
+  }
+  fputs(json.c_str(), file);
+  fclose(file);
+}
+
 static void session_exit()
 {
   if (options.session) {
+    if (!options.stats_path.empty() && !options.session->progress.get_cancel()) {
+      stats_write();
+    }
+
     delete options.session;
     options.session = NULL;
   }
@@ -367,6 +435,7 @@ static void options_parse(int argc, const char **argv)
   options.filepath = "";
   options.session = NULL;
   options.quiet = false;
+  options.load_time = 0.0;
 
   /* device names */
   string device_names = "";
@@ -414,6 +483,9 @@ static void options_parse(int argc, const char **argv)
              "--output %s",
              &options.output_path,
              "File path to write output image",
+             "--stats %s",
+             &options.stats_path,
+             "File path to append render statistics to, as JSON lines for benchmarking",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -390,6 +390,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Sample all lights (for indirect samples), rather than randomly picking one",
         default=True,
     )
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Pick lights using a hierarchy over their location and orientation, favoring lights close to "
+        "the shading point (less noise in scenes with many lights, not used when sampling all lights)",
+        default=False,
+    )
     light_sampling_threshold: FloatProperty(
         name="Light Sampling Threshold",
         description="Probabilistically terminate light samples when the light contribution is below this threshold (more noise but faster rendering). "
@@ -651,6 +657,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0, max=(1 << 24),
         default=1,
     )
+    preview_denoising_interval: FloatProperty(
+        name="Denoising Interval",
+        description="Minimum time in seconds between denoised preview updates, leaving more time to render samples in between (0 for automatic)",
+        min=0.0, max=10.0,
+        default=0.0,
+    )
 
     debug_reset_timeout: FloatProperty(
         name="Reset timeout",
@@ -687,6 +699,16 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use special type BVH optimized for hair (uses more ram but renders faster)",
         default=True,
     )
+    debug_use_compressed_bvh: BoolProperty(
+        name="Use Compressed BVH",
+        description="Store BVH nodes with quantized bounds (uses less ram but renders slower)",
+        default=False,
+    )
+    debug_use_hair_curve_primitives: BoolProperty(
+        name="Use Hair Curve Primitives",
+        description="Use a single BVH primitive for all segments of a hair curve (uses less ram but renders slower)",
+        default=False,
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -838,6 +860,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
 
     debug_optix_cuda_streams: IntProperty(name="CUDA Streams", default=1, min=1)
     debug_optix_curves_api: BoolProperty(name="Native OptiX Curve Primitive", default=False)
+    debug_optix_bvh_cache: BoolProperty(
+        name="Cache Acceleration Structures",
+        description="Store acceleration structures on disk and reuse them for unchanged geometry",
+        default=False,
+    )
 
     debug_opencl_kernel_type: EnumProperty(
         name="OpenCL Kernel Type",
@@ -285,6 +285,10 @@ class CYCLES_RENDER_PT_sampling_denoising(CyclesButtonsPanel, Panel):
         sub.active = cscene.use_preview_denoising
         sub.prop(cscene, "preview_denoising_start_sample", text="Start Sample")
 
+        sub = heading.row(align=True)
+        sub.active = cscene.use_preview_denoising
+        sub.prop(cscene, "preview_denoising_interval", text="Interval")
+
 
 class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
     bl_label = "Advanced"
@@ -315,6 +319,7 @@ class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
         col.prop(cscene, "min_light_bounces")
         col.prop(cscene, "min_transparent_bounces")
         col.prop(cscene, "light_sampling_threshold", text="Light Threshold")
+        col.prop(cscene, "use_light_tree")
 
         if cscene.progressive != 'PATH' and use_branched_path(context):
             col = layout.column(align=True)
@@ -720,6 +725,8 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
         sub = col.column()
         sub.active = not use_embree
         sub.prop(cscene, "debug_use_hair_bvh")
+        sub.prop(cscene, "debug_use_compressed_bvh")
+        sub.prop(cscene, "debug_use_hair_curve_primitives")
         sub = col.column()
         sub.active = not cscene.debug_use_spatial_splits and not use_embree
         sub.prop(cscene, "debug_bvh_time_steps")
@@ -740,7 +747,7 @@ class CYCLES_RENDER_PT_performance_final_render(CyclesButtonsPanel, Panel):
         col = layout.column()
 
         col.prop(rd, "use_save_buffers")
-        col.prop(rd, "use_persistent_data", text="Persistent Images")
+        col.prop(rd, "use_persistent_data", text="Persistent Data")
 
 
 class CYCLES_RENDER_PT_performance_viewport(CyclesButtonsPanel, Panel):
@@ -2020,6 +2027,7 @@ class CYCLES_RENDER_PT_debug(CyclesButtonsPanel, Panel):
         col.label(text="OptiX Flags:")
         col.prop(cscene, "debug_optix_cuda_streams")
         col.prop(cscene, "debug_optix_curves_api")
+        col.prop(cscene, "debug_optix_bvh_cache")
 
         col.separator()
 
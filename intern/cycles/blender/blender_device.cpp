@@ -69,10 +69,11 @@ DeviceInfo blender_device_info(BL::Preferences &b_preferences, BL::Scene &b_scen
     }
   }
   else if (get_enum(cscene, "device") == 2) {
-    /* Find network device. */
+    /* Distribute tiles over all network devices. */
     vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK_NETWORK);
     if (!devices.empty()) {
-      device = devices.front();
+      int threads = blender_device_threads(b_scene);
+      device = Device::get_multi_device(devices, threads, background);
     }
   }
   else if (get_enum(cscene, "device") == 1) {
@@ -25,6 +25,8 @@
 #include "blender/blender_util.h"
 
 #include "util/util_foreach.h"
+#include "util/util_logging.h"
+#include "util/util_md5.h"
 #include "util/util_task.h"
 
 CCL_NAMESPACE_BEGIN
@@ -180,6 +182,140 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+/* The sync of the geometry may still be running in the task pool, do not access its modified
+ * flags in that case and assume it is modified. */
+bool BlenderSync::geometry_is_modified(Geometry *geom) const
+{
+  if (geom == NULL) {
+    return false;
+  }
+  if (geometry_synced.find(geom) != geometry_synced.end()) {
+    return true;
+  }
+  return geom->is_modified();
+}
+
+static void attributes_hash(const AttributeSet &attributes, MD5Hash &md5)
+{
+  foreach (const Attribute &attr, attributes.attributes) {
+    md5.append(attr.name.string());
+    md5.append((const uint8_t *)&attr.std, sizeof(attr.std));
+    md5.append((const uint8_t *)&attr.element, sizeof(attr.element));
+    md5.append(attr.type.c_str());
+    if (!attr.buffer.empty()) {
+      md5.append((const uint8_t *)attr.buffer.data(), attr.buffer.size());
+    }
+  }
+}
+
+static bool attributes_equal(const AttributeSet &a, const AttributeSet &b)
+{
+  if (a.attributes.size() != b.attributes.size()) {
+    return false;
+  }
+
+  list<Attribute>::const_iterator it_a = a.attributes.begin();
+  list<Attribute>::const_iterator it_b = b.attributes.begin();
+  for (; it_a != a.attributes.end(); it_a++, it_b++) {
+    if (it_a->name != it_b->name || it_a->std != it_b->std || it_a->element != it_b->element ||
+        it_a->type != it_b->type || it_a->buffer != it_b->buffer) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static size_t attributes_size_in_bytes(const AttributeSet &attributes)
+{
+  size_t size = 0;
+  foreach (const Attribute &attr, attributes.attributes) {
+    size += attr.buffer.size();
+  }
+  return size;
+}
+
+/* Different evaluated datablocks can still result in identical meshes, for example linked
+ * duplicates with the same modifiers, or geometry realized by instancing. Make the objects of
+ * meshes synced with the same content share a single one, so that it is stored and gets its
+ * BVH built only once.
+ *
+ * Only done for final renders, as the removed duplicates need to be synced again on the next
+ * update, which would make viewport updates slower. */
+void BlenderSync::deduplicate_geometry()
+{
+  if (preview || progress.get_cancel()) {
+    return;
+  }
+
+  /* Go over the scene geometry rather than the synced set, to pick the kept mesh in a
+   * deterministic order. */
+  map<string, vector<Mesh *>> unique_meshes;
+  map<Geometry *, Geometry *> duplicate_to_unique;
+
+  foreach (Geometry *geom, scene->geometry) {
+    if (geom->geometry_type != Geometry::MESH ||
+        geometry_synced.find(geom) == geometry_synced.end()) {
+      continue;
+    }
+
+    /* Subdivision is diced per object. */
+    Mesh *mesh = static_cast<Mesh *>(geom);
+    if (mesh->get_subdivision_type() != Mesh::SUBDIVISION_NONE || mesh->num_triangles() == 0) {
+      continue;
+    }
+
+    MD5Hash md5;
+    mesh->hash(md5);
+    attributes_hash(mesh->attributes, md5);
+
+    vector<Mesh *> &candidates = unique_meshes[md5.get_hex()];
+
+    Mesh *unique_mesh = NULL;
+    foreach (Mesh *candidate, candidates) {
+      if (mesh->equals(*candidate) && attributes_equal(mesh->attributes, candidate->attributes)) {
+        unique_mesh = candidate;
+        break;
+      }
+    }
+
+    if (unique_mesh) {
+      duplicate_to_unique[mesh] = unique_mesh;
+    }
+    else {
+      candidates.push_back(mesh);
+    }
+  }
+
+  if (duplicate_to_unique.empty()) {
+    return;
+  }
+
+  foreach (Object *object, scene->objects) {
+    map<Geometry *, Geometry *>::iterator it = duplicate_to_unique.find(object->get_geometry());
+    if (it != duplicate_to_unique.end()) {
+      object->set_geometry(it->second);
+    }
+  }
+
+  set<Geometry *> duplicates;
+  size_t saved_size = 0;
+
+  for (const pair<Geometry *const, Geometry *> &it : duplicate_to_unique) {
+    Geometry *geom = it.first;
+    saved_size += geom->get_total_size_in_bytes() + attributes_size_in_bytes(geom->attributes);
+
+    geometry_map.remove(geom);
+    geometry_synced.erase(geom);
+    duplicates.insert(geom);
+  }
+
+  scene->delete_nodes(duplicates);
+
+  VLOG(1) << "Deduplicated " << duplicates.size() << " identical meshes, saving "
+          << string_human_readable_size(saved_size) << ".";
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BL::Object &b_ob,
                                        Object *object,
@@ -157,6 +157,22 @@ template<typename K, typename T> class id_map {
     b_map[NULL] = data;
   }
 
+  /* Remove data from the map without deleting it, the caller takes care of that. */
+  void remove(T *data)
+  {
+    typename map<K, T *>::iterator jt = b_map.begin();
+    while (jt != b_map.end()) {
+      if (jt->second == data) {
+        jt = b_map.erase(jt);
+      }
+      else {
+        jt++;
+      }
+    }
+
+    used_set.erase(data);
+  }
+
   void post_sync(bool do_delete = true)
   {
     map<K, T *> new_map;
@@ -36,8 +36,25 @@
 
 #include "mikktspace.h"
 
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
+/* Direct access to the arrays of the evaluated mesh. Iterating over them through RNA is very
+ * slow for large meshes, and the data is read-only here. */
+
+static inline const ::Mesh *mesh_data(BL::Mesh &b_mesh)
+{
+  return static_cast<const ::Mesh *>(b_mesh.ptr.data);
+}
+
+static inline const MLoopTri *mesh_looptris(BL::Mesh &b_mesh)
+{
+  /* Go through RNA to ensure the loop triangles are computed. */
+  return static_cast<const MLoopTri *>(b_mesh.loop_triangles[0].ptr.data);
+}
+
 /* Tangent Space */
 
 struct MikkUserData {
@@ -406,11 +423,15 @@ static void attr_create_uv_map(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh)
 
         float2 *fdata = uv_attr->data_float2();
 
-        for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-          int3 li = get_int3(t.loops());
-          fdata[0] = get_float2(l.data[li[0]].uv());
-          fdata[1] = get_float2(l.data[li[1]].uv());
-          fdata[2] = get_float2(l.data[li[2]].uv());
+        const MLoopTri *looptris = mesh_looptris(b_mesh);
+        const MLoopUV *mloopuv = static_cast<const MLoopUV *>(l.data[0].ptr.data);
+        const int numtris = b_mesh.loop_triangles.length();
+
+        for (int t = 0; t < numtris; t++) {
+          for (int i = 0; i < 3; i++) {
+            const float *uv = mloopuv[looptris[t].tri[i]].uv;
+            fdata[i] = make_float2(uv[0], uv[1]);
+          }
           fdata += 3;
         }
       }
@@ -756,18 +777,23 @@ static void create_mesh(Scene *scene,
 
   mesh->reserve_mesh(numverts, numtris);
 
+  const ::Mesh *me = mesh_data(b_mesh);
+  const MVert *mvert = me->mvert;
+  const MPoly *mpoly = me->mpoly;
+  const MLoop *mloop = me->mloop;
+
   /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  for (int i = 0; i < numverts; i++) {
+    mesh->add_vertex(make_float3(mvert[i].co[0], mvert[i].co[1], mvert[i].co[2]));
+  }
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  for (int i = 0; i < numverts; i++) {
+    N[i] = make_float3(mvert[i].no[0], mvert[i].no[1], mvert[i].no[2]) * (1.0f / 32767.0f);
+  }
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -782,6 +808,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -789,18 +816,26 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-      BL::MeshPolygon p = b_mesh.polygons[t.polygon_index()];
-      int3 vi = get_int3(t.vertices());
+    const MLoopTri *looptris = mesh_looptris(b_mesh);
+    const float(*loop_normals)[3] = (use_loop_normals) ?
+                                        static_cast<const float(*)[3]>(
+                                            CustomData_get_layer(&me->ldata, CD_NORMAL)) :
+                                        NULL;
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int t = 0; t < numtris; t++) {
+      const MLoopTri &lt = looptris[t];
+      const MPoly &p = mpoly[lt.poly];
+      int3 vi = make_int3(mloop[lt.tri[0]].v, mloop[lt.tri[1]].v, mloop[lt.tri[2]].v);
+
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       if (use_loop_normals) {
-        BL::Array<float, 9> loop_normals = t.split_normals();
         for (int i = 0; i < 3; i++) {
-          N[vi[i]] = make_float3(
-              loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
+          N[vi[i]] = (loop_normals) ? make_float3(loop_normals[lt.tri[i]][0],
+                                                  loop_normals[lt.tri[i]][1],
+                                                  loop_normals[lt.tri[i]][2]) :
+                                      make_float3(0.0f, 0.0f, 0.0f);
         }
       }
 
@@ -814,15 +849,16 @@ static void create_mesh(Scene *scene,
   else {
     vector<int> vi;
 
-    for (BL::MeshPolygon &p : b_mesh.polygons) {
-      int n = p.loop_total();
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int f = 0; f < numfaces; f++) {
+      const MPoly &p = mpoly[f];
+      int n = p.totloop;
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       vi.resize(n);
       for (int i = 0; i < n; i++) {
         /* NOTE: Autosmooth is already taken care about. */
-        vi[i] = b_mesh.loops[p.loop_start() + i].vertex_index();
+        vi[i] = mloop[p.loopstart + i].v;
       }
 
       /* create subd faces */
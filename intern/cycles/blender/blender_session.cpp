@@ -212,8 +212,10 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
       b_engine, b_userpref, b_scene, background);
   SceneParams scene_params = BlenderSync::get_scene_params(b_scene, background);
 
+  /* A reused depsgraph is also used for baking several objects in a row, without persistent
+   * data. */
   if (scene->params.modified(scene_params) || session->params.modified(session_params) ||
-      !scene_params.persistent_data) {
+      !(scene_params.persistent_data || b_engine.is_depsgraph_reused())) {
     /* if scene or session parameters changed, it's easier to simply re-create
      * them rather than trying to distinguish which settings need to be updated
      */
@@ -225,7 +227,6 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   }
 
   session->progress.reset();
-  scene->reset();
 
   session->tile_manager.set_tile_order(session_params.tile_order);
 
@@ -234,12 +235,21 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
    */
   session->stats.mem_peak = session->stats.mem_used;
 
-  /* There is no single depsgraph to use for the entire render.
-   * See note on create_session().
-   */
-  /* sync object should be re-created */
-  delete sync;
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  if (b_engine.is_depsgraph_reused()) {
+    /* Same depsgraph as the previous frame, the synced scene still matches its evaluated
+     * datablocks so only sync what changed since. */
+    sync->sync_recalc(b_depsgraph, b_v3d);
+  }
+  else {
+    scene->reset();
+
+    /* There is no single depsgraph to use for the entire render.
+     * See note on create_session().
+     */
+    /* sync object should be re-created */
+    delete sync;
+    sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  }
 
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
@@ -791,6 +801,7 @@ void BlenderSession::synchronize(BL::Depsgraph &b_depsgraph_)
   /* increase samples, but never decrease */
   session->set_samples(session_params.samples);
   session->set_denoising_start_sample(session_params.denoising.start_sample);
+  session->set_denoising_update_interval(session_params.denoising.update_interval);
   session->set_pause(session_pause);
 
   /* copy recalc flags, outside of mutex so we can decide to do the real
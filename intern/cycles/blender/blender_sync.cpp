@@ -42,6 +42,8 @@
 #include "util/util_opengl.h"
 #include "util/util_openimagedenoise.h"
 
+#include "BLI_trace.h"
+
 CCL_NAMESPACE_BEGIN
 
 static const char *cryptomatte_prefix = "Crypto";
@@ -226,22 +228,31 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
                             void **python_thread_state)
 {
   scoped_timer timer;
+  BLI_trace_begin("cycles", "Sync data");
 
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
 
   sync_view_layer(b_v3d, b_view_layer);
   sync_integrator();
   sync_film(b_v3d);
+  BLI_trace_begin("cycles", "Sync shaders");
   sync_shaders(b_depsgraph, b_v3d);
+  BLI_trace_end();
   sync_images();
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == Camera::MOTION_POSITION_CENTER) {
+    BLI_trace_begin("cycles", "Sync objects");
     sync_objects(b_depsgraph, b_v3d);
+    BLI_trace_end();
   }
+  BLI_trace_begin("cycles", "Sync motion");
   sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  BLI_trace_end();
+
+  deduplicate_geometry();
 
   geometry_synced.clear();
 
@@ -251,6 +262,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
 
   free_data_after_sync(b_depsgraph);
 
+  BLI_trace_end();
   VLOG(1) << "Total time spent synchronizing data: " << timer.get_time();
 }
 
@@ -311,6 +323,7 @@ void BlenderSync::sync_integrator()
   integrator->set_sample_all_lights_direct(get_boolean(cscene, "sample_all_lights_direct"));
   integrator->set_sample_all_lights_indirect(get_boolean(cscene, "sample_all_lights_indirect"));
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -769,6 +782,8 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
 
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
+  params.use_bvh_compressed_nodes = RNA_boolean_get(&cscene, "debug_use_compressed_bvh");
+  params.use_bvh_curve_primitives = RNA_boolean_get(&cscene, "debug_use_hair_curve_primitives");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
@@ -999,6 +1014,7 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
     denoising.type = (DenoiserType)get_enum(
         cscene, "preview_denoiser", DENOISER_NUM, DENOISER_NONE);
     denoising.start_sample = get_int(cscene, "preview_denoising_start_sample");
+    denoising.update_interval = get_float(cscene, "preview_denoising_interval");
 
     /* Auto select fastest denoiser. */
     if (denoising.type == DENOISER_NONE) {
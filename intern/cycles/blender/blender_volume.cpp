@@ -221,6 +221,18 @@ class BlenderVolumeLoader : public VDBImageLoader {
   {
     b_volume.grids.load(b_data.ptr.data);
 
+    switch (b_volume.render().precision()) {
+      case BL::VolumeRender::precision_HALF:
+        precision = PRECISION_HALF;
+        break;
+      case BL::VolumeRender::precision_VARIABLE:
+        precision = PRECISION_VARIABLE;
+        break;
+      case BL::VolumeRender::precision_FULL:
+        precision = PRECISION_FULL;
+        break;
+    }
+
 #ifdef WITH_OPENVDB
     for (BL::VolumeGrid &b_volume_grid : b_volume.grids) {
       if (b_volume_grid.name() == grid_name) {
@@ -39,6 +39,101 @@ int BVHStackEntry::encodeIdx() const
   return (node->is_leaf()) ? ~idx : idx;
 }
 
+/* Compressed Nodes
+ *
+ * Child bounds are stored as 8 bit offsets from the minimum of the node, in steps of a power of
+ * two per axis. Decoding must match bvh_compressed_node_decode() in the kernel exactly, the
+ * multiplication is exact so it does not matter whether it gets fused with the addition. */
+
+static float bvh_compressed_decode(const float origin, const uint exponent, const uint q)
+{
+  return origin + (float)q * __uint_as_float(exponent << 23);
+}
+
+/* Quantize the child bounds along one axis. Bounds are rounded outwards and checked against
+ * the decoded values, so the decoded boxes always contain the original ones. Returns the
+ * minimum of the node, the biased exponent of the step and the four 8 bit bounds ordered like
+ * the bounds of uncompressed nodes. */
+static float bvh_compress_axis(const BoundBox &b0,
+                               const BoundBox &b1,
+                               const int axis,
+                               uint *r_exponent,
+                               uint *r_quantized)
+{
+  const BoundBox *bounds[2] = {&b0, &b1};
+  bool use_child[2];
+  bool is_finite = true;
+  float lo = FLT_MAX, hi = -FLT_MAX;
+
+  for (int i = 0; i < 2; i++) {
+    const float child_lo = bounds[i]->min[axis];
+    const float child_hi = bounds[i]->max[axis];
+    /* Empty children are culled by their visibility, the bounds do not matter. */
+    use_child[i] = (child_lo <= child_hi);
+    if (use_child[i]) {
+      is_finite &= isfinite(child_lo) && isfinite(child_hi);
+      lo = min(lo, child_lo);
+      hi = max(hi, child_hi);
+    }
+  }
+
+  if (!use_child[0] && !use_child[1]) {
+    *r_exponent = 127;
+    *r_quantized = 0;
+    return 0.0f;
+  }
+
+  const float extent = hi - lo;
+  if (is_finite && isfinite(extent)) {
+    /* Smallest step for which the 255 steps cover the extent. */
+    int exponent = 1;
+    if (extent > 0.0f) {
+      int e;
+      frexpf(extent / 255.0f, &e);
+      exponent = clamp(e + 127, 1, 254);
+    }
+
+    for (; exponent <= 254; exponent++) {
+      const float step = __uint_as_float(exponent << 23);
+      uint quantized = 0;
+      bool fits = true;
+
+      for (int i = 0; i < 2 && fits; i++) {
+        if (!use_child[i]) {
+          continue;
+        }
+
+        const float child_lo = bounds[i]->min[axis];
+        const float child_hi = bounds[i]->max[axis];
+
+        uint q_lo = (uint)clamp(floorf((child_lo - lo) / step), 0.0f, 255.0f);
+        while (q_lo > 0 && bvh_compressed_decode(lo, exponent, q_lo) > child_lo) {
+          q_lo--;
+        }
+
+        uint q_hi = (uint)clamp(ceilf((child_hi - lo) / step), 0.0f, 255.0f);
+        while (q_hi < 255 && bvh_compressed_decode(lo, exponent, q_hi) < child_hi) {
+          q_hi++;
+        }
+
+        fits = bvh_compressed_decode(lo, exponent, q_hi) >= child_hi;
+        quantized |= (q_lo << (i * 8)) | (q_hi << (16 + i * 8));
+      }
+
+      if (fits) {
+        *r_exponent = exponent;
+        *r_quantized = quantized;
+        return lo;
+      }
+    }
+  }
+
+  /* Bounds that can not be represented, cover everything. */
+  *r_exponent = 254;
+  *r_quantized = 0xffff0000;
+  return -FLT_MAX;
+}
+
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
@@ -100,8 +195,14 @@ void BVH2::build(Progress &progress, Stats *)
 
 void BVH2::refit(Progress &progress)
 {
-  progress.set_substatus("Packing BVH primitives");
-  pack_primitives();
+  if (params.top_level) {
+    progress.set_substatus("Packing BVH instances");
+    refit_instances();
+  }
+  else {
+    progress.set_substatus("Packing BVH primitives");
+    pack_primitives();
+  }
 
   if (progress.get_cancel())
     return;
@@ -152,6 +253,17 @@ void BVH2::pack_aligned_inner(const BVHStackEntry &e,
                               const BVHStackEntry &e0,
                               const BVHStackEntry &e1)
 {
+  if (params.use_compressed_nodes) {
+    pack_compressed_node(e.idx,
+                         e0.node->bounds,
+                         e1.node->bounds,
+                         e0.encodeIdx(),
+                         e1.encodeIdx(),
+                         e0.node->visibility,
+                         e1.node->visibility);
+    return;
+  }
+
   pack_aligned_node(e.idx,
                     e0.node->bounds,
                     e1.node->bounds,
@@ -173,9 +285,9 @@ void BVH2::pack_aligned_node(int idx,
   assert(c0 < 0 || c0 < pack.nodes.size());
   assert(c1 < 0 || c1 < pack.nodes.size());
 
+  const uint node_flags = PATH_RAY_NODE_UNALIGNED | PATH_RAY_NODE_COMPRESSED;
   int4 data[BVH_NODE_SIZE] = {
-      make_int4(
-          visibility0 & ~PATH_RAY_NODE_UNALIGNED, visibility1 & ~PATH_RAY_NODE_UNALIGNED, c0, c1),
+      make_int4(visibility0 & ~node_flags, visibility1 & ~node_flags, c0, c1),
       make_int4(__float_as_int(b0.min.x),
                 __float_as_int(b1.min.x),
                 __float_as_int(b0.max.x),
@@ -193,6 +305,48 @@ void BVH2::pack_aligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_NODE_SIZE);
 }
 
+void BVH2::pack_compressed_node(int idx,
+                                const BoundBox &b0,
+                                const BoundBox &b1,
+                                int c0,
+                                int c1,
+                                uint visibility0,
+                                uint visibility1)
+{
+  assert(idx + BVH_COMPRESSED_NODE_SIZE <= pack.nodes.size());
+  assert(c0 < 0 || c0 < pack.nodes.size());
+  assert(c1 < 0 || c1 < pack.nodes.size());
+
+  float origin[3];
+  uint exponent[3], quantized[3];
+  for (int axis = 0; axis < 3; axis++) {
+    origin[axis] = bvh_compress_axis(b0, b1, axis, &exponent[axis], &quantized[axis]);
+  }
+
+  const uint node_flags = PATH_RAY_NODE_UNALIGNED | PATH_RAY_NODE_COMPRESSED;
+  int4 data[BVH_COMPRESSED_NODE_SIZE] = {
+      make_int4((visibility0 & ~node_flags) | PATH_RAY_NODE_COMPRESSED,
+                (visibility1 & ~node_flags) | PATH_RAY_NODE_COMPRESSED,
+                c0,
+                c1),
+      make_int4(__float_as_int(origin[0]),
+                __float_as_int(origin[1]),
+                __float_as_int(origin[2]),
+                exponent[0] | (exponent[1] << 8) | (exponent[2] << 16)),
+      make_int4(quantized[0], quantized[1], quantized[2], 0),
+  };
+
+  memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_COMPRESSED_NODE_SIZE);
+}
+
+int BVH2::inner_node_size(const BVHNode *node) const
+{
+  if (node->has_unaligned()) {
+    return BVH_UNALIGNED_NODE_SIZE;
+  }
+  return (params.use_compressed_nodes) ? BVH_COMPRESSED_NODE_SIZE : BVH_NODE_SIZE;
+}
+
 void BVH2::pack_unaligned_inner(const BVHStackEntry &e,
                                 const BVHStackEntry &e0,
                                 const BVHStackEntry &e1)
@@ -246,14 +400,16 @@ void BVH2::pack_nodes(const BVHNode *root)
   const size_t num_leaf_nodes = root->getSubtreeSize(BVH_STAT_LEAF_COUNT);
   assert(num_leaf_nodes <= num_nodes);
   const size_t num_inner_nodes = num_nodes - num_leaf_nodes;
+  const size_t aligned_node_size = (params.use_compressed_nodes) ? BVH_COMPRESSED_NODE_SIZE :
+                                                                    BVH_NODE_SIZE;
   size_t node_size;
   if (params.use_unaligned_nodes) {
     const size_t num_unaligned_nodes = root->getSubtreeSize(BVH_STAT_UNALIGNED_INNER_COUNT);
     node_size = (num_unaligned_nodes * BVH_UNALIGNED_NODE_SIZE) +
-                (num_inner_nodes - num_unaligned_nodes) * BVH_NODE_SIZE;
+                (num_inner_nodes - num_unaligned_nodes) * aligned_node_size;
   }
   else {
-    node_size = num_inner_nodes * BVH_NODE_SIZE;
+    node_size = num_inner_nodes * aligned_node_size;
   }
   /* Resize arrays */
   pack.nodes.clear();
@@ -276,7 +432,7 @@ void BVH2::pack_nodes(const BVHNode *root)
   }
   else {
     stack.push_back(BVHStackEntry(root, nextNodeIdx));
-    nextNodeIdx += root->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE : BVH_NODE_SIZE;
+    nextNodeIdx += inner_node_size(root);
   }
 
   while (stack.size()) {
@@ -297,8 +453,7 @@ void BVH2::pack_nodes(const BVHNode *root)
         }
         else {
           idx[i] = nextNodeIdx;
-          nextNodeIdx += e.node->get_child(i)->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE :
-                                                                 BVH_NODE_SIZE;
+          nextNodeIdx += inner_node_size(e.node->get_child(i));
         }
       }
 
@@ -315,8 +470,6 @@ void BVH2::pack_nodes(const BVHNode *root)
 
 void BVH2::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
@@ -331,7 +484,13 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c0 = data[0].x;
     const int c1 = data[0].y;
 
-    refit_primitives(c0, c1, bbox, visibility);
+    if (c0 < 0) {
+      /* Object instance in the top level BVH, see pack_leaf(). */
+      refit_primitives(~c0, ~c0 + 1, bbox, visibility);
+    }
+    else {
+      refit_primitives(c0, c1, bbox, visibility);
+    }
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -342,10 +501,11 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     memcpy(&pack.leaf_nodes[idx], leaf_data, sizeof(float4) * BVH_NODE_LEAF_SIZE);
   }
   else {
-    assert(idx + BVH_NODE_SIZE <= pack.nodes.size());
+    assert(idx + BVH_COMPRESSED_NODE_SIZE <= pack.nodes.size());
 
     const int4 *data = &pack.nodes[idx];
     const bool is_unaligned = (data[0].x & PATH_RAY_NODE_UNALIGNED) != 0;
+    const bool is_compressed = (data[0].x & PATH_RAY_NODE_COMPRESSED) != 0;
     const int c0 = data[0].z;
     const int c1 = data[0].w;
     /* refit inner node, set bbox from children */
@@ -360,6 +520,9 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
       pack_unaligned_node(
           idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
+    else if (is_compressed) {
+      pack_compressed_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+    }
     else {
       pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
@@ -513,9 +676,15 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
   }
 
   /* track offsets of instanced BVH data in global array */
-  size_t prim_offset = pack.prim_index.size();
-  size_t nodes_offset = nodes_size;
-  size_t nodes_leaf_offset = leaf_nodes_size;
+  InstanceOffsets offsets;
+  offsets.prim_index = pack.prim_index.size();
+  offsets.prim_tri_verts = pack.prim_tri_verts.size();
+  offsets.nodes = nodes_size;
+  offsets.leaf_nodes = leaf_nodes_size;
+
+  num_top_level_prims = pack.prim_index.size();
+  instance_offsets.clear();
+  object_geometry.clear();
 
   /* clear array that gives the node indexes for instanced objects */
   pack.object_node.clear();
@@ -524,12 +693,6 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
   size_t prim_index_size = pack.prim_index.size();
   size_t prim_tri_verts_size = pack.prim_tri_verts.size();
 
-  size_t pack_prim_index_offset = prim_index_size;
-  size_t pack_prim_tri_verts_offset = prim_tri_verts_size;
-  size_t pack_nodes_offset = nodes_size;
-  size_t pack_leaf_nodes_offset = leaf_nodes_size;
-  size_t object_offset = 0;
-
   foreach (Geometry *geom, geometry) {
     BVH2 *bvh = static_cast<BVH2 *>(geom->bvh);
 
@@ -555,21 +718,12 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
     pack.prim_time.resize(prim_index_size);
   }
 
-  int *pack_prim_index = (pack.prim_index.size()) ? &pack.prim_index[0] : NULL;
-  int *pack_prim_type = (pack.prim_type.size()) ? &pack.prim_type[0] : NULL;
-  int *pack_prim_object = (pack.prim_object.size()) ? &pack.prim_object[0] : NULL;
-  uint *pack_prim_visibility = (pack.prim_visibility.size()) ? &pack.prim_visibility[0] : NULL;
-  float4 *pack_prim_tri_verts = (pack.prim_tri_verts.size()) ? &pack.prim_tri_verts[0] : NULL;
-  uint *pack_prim_tri_index = (pack.prim_tri_index.size()) ? &pack.prim_tri_index[0] : NULL;
-  int4 *pack_nodes = (pack.nodes.size()) ? &pack.nodes[0] : NULL;
-  int4 *pack_leaf_nodes = (pack.leaf_nodes.size()) ? &pack.leaf_nodes[0] : NULL;
-  float2 *pack_prim_time = (pack.prim_time.size()) ? &pack.prim_time[0] : NULL;
-
-  unordered_map<Geometry *, int> geometry_map;
+  size_t object_offset = 0;
 
   /* merge */
   foreach (Object *ob, objects) {
     Geometry *geom = ob->get_geometry();
+    object_geometry.push_back(geom);
 
     /* We assume that if mesh doesn't need own BVH it was already included
      * into a top-level BVH and no packing here is needed.
@@ -579,123 +733,212 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
       continue;
     }
 
+    BVH2 *bvh = static_cast<BVH2 *>(geom->bvh);
+
     /* if mesh already added once, don't add it again, but used set
      * node offset for this object */
-    unordered_map<Geometry *, int>::iterator it = geometry_map.find(geom);
+    unordered_map<Geometry *, InstanceOffsets>::iterator it = instance_offsets.find(geom);
+    const InstanceOffsets &geom_offsets = (it != instance_offsets.end()) ? it->second : offsets;
+
+    /* fill in node indexes for instances */
+    if (bvh->pack.root_index == -1)
+      pack.object_node[object_offset++] = -(int)geom_offsets.leaf_nodes - 1;
+    else
+      pack.object_node[object_offset++] = (int)geom_offsets.nodes;
 
-    if (geometry_map.find(geom) != geometry_map.end()) {
-      int noffset = it->second;
-      pack.object_node[object_offset++] = noffset;
+    if (it != instance_offsets.end()) {
       continue;
     }
 
-    BVH2 *bvh = static_cast<BVH2 *>(geom->bvh);
+    instance_offsets[geom] = offsets;
+    pack_instance(geom, offsets);
 
-    int noffset = nodes_offset;
-    int noffset_leaf = nodes_leaf_offset;
-    int geom_prim_offset = geom->prim_offset;
+    offsets.prim_index += bvh->pack.prim_index.size();
+    offsets.prim_tri_verts += bvh->pack.prim_tri_verts.size();
+    offsets.nodes += bvh->pack.nodes.size();
+    offsets.leaf_nodes += bvh->pack.leaf_nodes.size();
+  }
+}
 
-    /* fill in node indexes for instances */
-    if (bvh->pack.root_index == -1)
-      pack.object_node[object_offset++] = -noffset_leaf - 1;
-    else
-      pack.object_node[object_offset++] = noffset;
-
-    geometry_map[geom] = pack.object_node[object_offset - 1];
-
-    /* merge primitive, object and triangle indexes */
-    if (bvh->pack.prim_index.size()) {
-      size_t bvh_prim_index_size = bvh->pack.prim_index.size();
-      int *bvh_prim_index = &bvh->pack.prim_index[0];
-      int *bvh_prim_type = &bvh->pack.prim_type[0];
-      uint *bvh_prim_visibility = &bvh->pack.prim_visibility[0];
-      uint *bvh_prim_tri_index = &bvh->pack.prim_tri_index[0];
-      float2 *bvh_prim_time = bvh->pack.prim_time.size() ? &bvh->pack.prim_time[0] : NULL;
-
-      for (size_t i = 0; i < bvh_prim_index_size; i++) {
-        if (bvh->pack.prim_type[i] & PRIMITIVE_ALL_CURVE) {
-          pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
-          pack_prim_tri_index[pack_prim_index_offset] = -1;
-        }
-        else {
-          pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
-          pack_prim_tri_index[pack_prim_index_offset] = bvh_prim_tri_index[i] +
-                                                        pack_prim_tri_verts_offset;
-        }
+/* Merge the data of an instanced BVH into the top level arrays, at the given offsets. */
+void BVH2::pack_instance(const Geometry *geom, const InstanceOffsets &offsets)
+{
+  const BVH2 *bvh = static_cast<const BVH2 *>(geom->bvh);
+
+  const int geom_prim_offset = geom->prim_offset;
+  const int prim_offset = offsets.prim_index;
+  const int noffset = offsets.nodes;
+  const int noffset_leaf = offsets.leaf_nodes;
+
+  size_t pack_prim_index_offset = offsets.prim_index;
+  size_t pack_nodes_offset = offsets.nodes;
+  size_t pack_leaf_nodes_offset = offsets.leaf_nodes;
+
+  /* merge primitive, object and triangle indexes */
+  if (bvh->pack.prim_index.size()) {
+    size_t bvh_prim_index_size = bvh->pack.prim_index.size();
+    const int *bvh_prim_index = &bvh->pack.prim_index[0];
+    const int *bvh_prim_type = &bvh->pack.prim_type[0];
+    const uint *bvh_prim_visibility = &bvh->pack.prim_visibility[0];
+    const uint *bvh_prim_tri_index = &bvh->pack.prim_tri_index[0];
+    const float2 *bvh_prim_time = bvh->pack.prim_time.size() ? &bvh->pack.prim_time[0] : NULL;
+
+    int *pack_prim_index = &pack.prim_index[0];
+    int *pack_prim_type = &pack.prim_type[0];
+    int *pack_prim_object = &pack.prim_object[0];
+    uint *pack_prim_visibility = &pack.prim_visibility[0];
+    uint *pack_prim_tri_index = &pack.prim_tri_index[0];
+    float2 *pack_prim_time = (pack.prim_time.size()) ? &pack.prim_time[0] : NULL;
+
+    for (size_t i = 0; i < bvh_prim_index_size; i++) {
+      if (bvh->pack.prim_type[i] & PRIMITIVE_ALL_CURVE) {
+        pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
+        pack_prim_tri_index[pack_prim_index_offset] = -1;
+      }
+      else {
+        pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
+        pack_prim_tri_index[pack_prim_index_offset] = bvh_prim_tri_index[i] +
+                                                      offsets.prim_tri_verts;
+      }
 
-        pack_prim_type[pack_prim_index_offset] = bvh_prim_type[i];
-        pack_prim_visibility[pack_prim_index_offset] = bvh_prim_visibility[i];
-        pack_prim_object[pack_prim_index_offset] = 0;  // unused for instances
-        if (bvh_prim_time != NULL) {
-          pack_prim_time[pack_prim_index_offset] = bvh_prim_time[i];
-        }
-        pack_prim_index_offset++;
+      pack_prim_type[pack_prim_index_offset] = bvh_prim_type[i];
+      pack_prim_visibility[pack_prim_index_offset] = bvh_prim_visibility[i];
+      pack_prim_object[pack_prim_index_offset] = 0;  // unused for instances
+      if (bvh_prim_time != NULL) {
+        pack_prim_time[pack_prim_index_offset] = bvh_prim_time[i];
       }
+      pack_prim_index_offset++;
     }
+  }
 
-    /* Merge triangle vertices data. */
-    if (bvh->pack.prim_tri_verts.size()) {
-      const size_t prim_tri_size = bvh->pack.prim_tri_verts.size();
-      memcpy(pack_prim_tri_verts + pack_prim_tri_verts_offset,
-             &bvh->pack.prim_tri_verts[0],
-             prim_tri_size * sizeof(float4));
-      pack_prim_tri_verts_offset += prim_tri_size;
+  /* Merge triangle vertices data. */
+  if (bvh->pack.prim_tri_verts.size()) {
+    const size_t prim_tri_size = bvh->pack.prim_tri_verts.size();
+    memcpy(&pack.prim_tri_verts[offsets.prim_tri_verts],
+           &bvh->pack.prim_tri_verts[0],
+           prim_tri_size * sizeof(float4));
+  }
+
+  /* merge nodes */
+  if (bvh->pack.leaf_nodes.size()) {
+    const int4 *leaf_nodes_offset = &bvh->pack.leaf_nodes[0];
+    int4 *pack_leaf_nodes = &pack.leaf_nodes[0];
+    size_t leaf_nodes_offset_size = bvh->pack.leaf_nodes.size();
+    for (size_t i = 0, j = 0; i < leaf_nodes_offset_size; i += BVH_NODE_LEAF_SIZE, j++) {
+      int4 data = leaf_nodes_offset[i];
+      data.x += prim_offset;
+      data.y += prim_offset;
+      pack_leaf_nodes[pack_leaf_nodes_offset] = data;
+      for (int j = 1; j < BVH_NODE_LEAF_SIZE; ++j) {
+        pack_leaf_nodes[pack_leaf_nodes_offset + j] = leaf_nodes_offset[i + j];
+      }
+      pack_leaf_nodes_offset += BVH_NODE_LEAF_SIZE;
     }
+  }
 
-    /* merge nodes */
-    if (bvh->pack.leaf_nodes.size()) {
-      int4 *leaf_nodes_offset = &bvh->pack.leaf_nodes[0];
-      size_t leaf_nodes_offset_size = bvh->pack.leaf_nodes.size();
-      for (size_t i = 0, j = 0; i < leaf_nodes_offset_size; i += BVH_NODE_LEAF_SIZE, j++) {
-        int4 data = leaf_nodes_offset[i];
-        data.x += prim_offset;
-        data.y += prim_offset;
-        pack_leaf_nodes[pack_leaf_nodes_offset] = data;
-        for (int j = 1; j < BVH_NODE_LEAF_SIZE; ++j) {
-          pack_leaf_nodes[pack_leaf_nodes_offset + j] = leaf_nodes_offset[i + j];
-        }
-        pack_leaf_nodes_offset += BVH_NODE_LEAF_SIZE;
+  if (bvh->pack.nodes.size()) {
+    const int4 *bvh_nodes = &bvh->pack.nodes[0];
+    int4 *pack_nodes = &pack.nodes[0];
+    size_t bvh_nodes_size = bvh->pack.nodes.size();
+
+    for (size_t i = 0, j = 0; i < bvh_nodes_size; j++) {
+      size_t nsize, nsize_bbox;
+      if (bvh_nodes[i].x & PATH_RAY_NODE_UNALIGNED) {
+        nsize = BVH_UNALIGNED_NODE_SIZE;
+        nsize_bbox = 0;
+      }
+      else if (bvh_nodes[i].x & PATH_RAY_NODE_COMPRESSED) {
+        nsize = BVH_COMPRESSED_NODE_SIZE;
+        nsize_bbox = 0;
       }
+      else {
+        nsize = BVH_NODE_SIZE;
+        nsize_bbox = 0;
+      }
+
+      memcpy(pack_nodes + pack_nodes_offset, bvh_nodes + i, nsize_bbox * sizeof(int4));
+
+      /* Modify offsets into arrays */
+      int4 data = bvh_nodes[i + nsize_bbox];
+      data.z += (data.z < 0) ? -noffset_leaf : noffset;
+      data.w += (data.w < 0) ? -noffset_leaf : noffset;
+      pack_nodes[pack_nodes_offset + nsize_bbox] = data;
+
+      /* Usually this copies nothing, but we better
+       * be prepared for possible node size extension.
+       */
+      memcpy(&pack_nodes[pack_nodes_offset + nsize_bbox + 1],
+             &bvh_nodes[i + nsize_bbox + 1],
+             sizeof(int4) * (nsize - (nsize_bbox + 1)));
+
+      pack_nodes_offset += nsize;
+      i += nsize;
     }
+  }
+}
 
-    if (bvh->pack.nodes.size()) {
-      int4 *bvh_nodes = &bvh->pack.nodes[0];
-      size_t bvh_nodes_size = bvh->pack.nodes.size();
+bool BVH2::can_refit_instances(const vector<Geometry *> &geometry_,
+                               const vector<Object *> &objects_) const
+{
+  assert(params.top_level);
 
-      for (size_t i = 0, j = 0; i < bvh_nodes_size; j++) {
-        size_t nsize, nsize_bbox;
-        if (bvh_nodes[i].x & PATH_RAY_NODE_UNALIGNED) {
-          nsize = BVH_UNALIGNED_NODE_SIZE;
-          nsize_bbox = 0;
-        }
-        else {
-          nsize = BVH_NODE_SIZE;
-          nsize_bbox = 0;
-        }
+  if (geometry_ != geometry || objects_ != objects || object_geometry.size() != objects.size()) {
+    return false;
+  }
 
-        memcpy(pack_nodes + pack_nodes_offset, bvh_nodes + i, nsize_bbox * sizeof(int4));
+  for (size_t i = 0; i < objects.size(); i++) {
+    Geometry *geom = objects[i]->get_geometry();
+    if (geom != object_geometry[i]) {
+      return false;
+    }
+    /* Geometry moved in or out of the top level BVH. */
+    const bool is_packed_instance = instance_offsets.find(geom) != instance_offsets.end();
+    if (geom->need_build_bvh(params.bvh_layout) != is_packed_instance) {
+      return false;
+    }
+  }
 
-        /* Modify offsets into arrays */
-        int4 data = bvh_nodes[i + nsize_bbox];
-        data.z += (data.z < 0) ? -noffset_leaf : noffset;
-        data.w += (data.w < 0) ? -noffset_leaf : noffset;
-        pack_nodes[pack_nodes_offset + nsize_bbox] = data;
+  return true;
+}
 
-        /* Usually this copies nothing, but we better
-         * be prepared for possible node size extension.
-         */
-        memcpy(&pack_nodes[pack_nodes_offset + nsize_bbox + 1],
-               &bvh_nodes[i + nsize_bbox + 1],
-               sizeof(int4) * (nsize - (nsize_bbox + 1)));
+/* Update in place the data of the modified geometry, keeping the layout of the last build.
+ * Unmodified instanced BVHs are not merged again, which avoids copying all the scene data when
+ * only a few objects are animated. */
+void BVH2::refit_instances()
+{
+  assert(params.top_level);
 
-        pack_nodes_offset += nsize;
-        i += nsize;
-      }
+  /* Geometry with transform applied, directly in the top level BVH. */
+  for (size_t i = 0; i < num_top_level_prims; i++) {
+    const int prim_index = pack.prim_index[i];
+    if (prim_index == -1) {
+      continue;
+    }
+
+    Object *ob = objects[pack.prim_object[i]];
+    pack.prim_visibility[i] = ob->visibility_for_tracing();
+
+    Geometry *geom = ob->get_geometry();
+    if (!geom->is_modified()) {
+      continue;
     }
 
-    nodes_offset += bvh->pack.nodes.size();
-    nodes_leaf_offset += bvh->pack.leaf_nodes.size();
-    prim_offset += bvh->pack.prim_index.size();
+    if (pack.prim_type[i] & PRIMITIVE_ALL_TRIANGLE) {
+      const Mesh *mesh = static_cast<const Mesh *>(geom);
+      Mesh::Triangle t = mesh->get_triangle(prim_index - mesh->prim_offset);
+      const float3 *vpos = &mesh->verts[0];
+      float4 *tri_verts = &pack.prim_tri_verts[pack.prim_tri_index[i]];
+      tri_verts[0] = float3_to_float4(vpos[t.v[0]]);
+      tri_verts[1] = float3_to_float4(vpos[t.v[1]]);
+      tri_verts[2] = float3_to_float4(vpos[t.v[2]]);
+    }
+  }
+
+  /* Instanced BVHs, their sizes did not change since they were only refit. */
+  foreach (const auto &item, instance_offsets) {
+    if (item.first->is_modified()) {
+      pack_instance(item.first, item.second);
+    }
   }
 }
 
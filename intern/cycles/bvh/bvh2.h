@@ -21,6 +21,7 @@
 #include "bvh/bvh.h"
 #include "bvh/bvh_params.h"
 
+#include "util/util_map.h"
 #include "util/util_types.h"
 #include "util/util_vector.h"
 
@@ -29,6 +30,7 @@ CCL_NAMESPACE_BEGIN
 #define BVH_NODE_SIZE 4
 #define BVH_NODE_LEAF_SIZE 1
 #define BVH_UNALIGNED_NODE_SIZE 7
+#define BVH_COMPRESSED_NODE_SIZE 3
 
 /* Pack Utility */
 struct BVHStackEntry {
@@ -48,6 +50,12 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Top level BVH: test if it can be refit for the given objects instead of being built again.
+   * This requires the same objects and geometry as the last build, with the instanced BVHs only
+   * refit since then so that they can be merged again in place. */
+  bool can_refit_instances(const vector<Geometry *> &geometry,
+                           const vector<Object *> &objects) const;
+
   PackedBVH pack;
 
  protected:
@@ -77,6 +85,17 @@ class BVH2 : public BVH {
                          uint visibility0,
                          uint visibility1);
 
+  void pack_compressed_node(int idx,
+                            const BoundBox &b0,
+                            const BoundBox &b1,
+                            int c0,
+                            int c1,
+                            uint visibility0,
+                            uint visibility1);
+
+  /* Size of the packed inner node. */
+  int inner_node_size(const BVHNode *node) const;
+
   void pack_unaligned_inner(const BVHStackEntry &e,
                             const BVHStackEntry &e0,
                             const BVHStackEntry &e1);
@@ -103,6 +122,22 @@ class BVH2 : public BVH {
 
   /* merge instance BVH's */
   void pack_instances(size_t nodes_size, size_t leaf_nodes_size);
+
+  /* Offsets of the data of an instanced BVH in the arrays of the top level BVH. */
+  struct InstanceOffsets {
+    size_t prim_index;
+    size_t prim_tri_verts;
+    size_t nodes;
+    size_t leaf_nodes;
+  };
+
+  void pack_instance(const Geometry *geom, const InstanceOffsets &offsets);
+  void refit_instances();
+
+  /* Layout of the top level BVH arrays from the last build, used when refitting. */
+  unordered_map<Geometry *, InstanceOffsets> instance_offsets;
+  vector<Geometry *> object_geometry;
+  size_t num_top_level_prims = 0;
 };
 
 CCL_NAMESPACE_END
@@ -170,6 +170,10 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
   for (uint j = 0; j < num_curves; j++) {
     const Hair::Curve curve = hair->get_curve(j);
     const float *curve_radius = &hair->get_curve_radius()[0];
+    if (params.use_curve_primitives && curve.num_segments() > 1) {
+      add_reference_curve_all_segments(root, center, hair, curve_attr_mP, primitive_type, j, i);
+      continue;
+    }
     for (int k = 0; k < curve.num_keys - 1; k++) {
       if (curve_attr_mP == NULL) {
         /* Really simple logic for static hair. */
@@ -268,6 +272,93 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
   }
 }
 
+/* Number of segments of a reference covering a whole curve, zero for all other references. */
+static int curve_reference_num_segments(const vector<Object *> &objects, const BVHReference &ref)
+{
+  if (ref.prim_index() == -1 ||
+      PRIMITIVE_UNPACK_SEGMENT(ref.prim_type()) != BVH_CURVE_ALL_SEGMENTS) {
+    return 0;
+  }
+  const Hair *hair = static_cast<const Hair *>(objects[ref.prim_object()]->get_geometry());
+  return hair->get_curve(ref.prim_index()).num_segments();
+}
+
+/* Add a single reference for all the segments of the curve, it is expanded to the segments
+ * again in create_leaf_node(). */
+void BVHBuild::add_reference_curve_all_segments(BoundBox &root,
+                                                BoundBox &center,
+                                                Hair *hair,
+                                                const Attribute *curve_attr_mP,
+                                                int primitive_type,
+                                                int curve_index,
+                                                int i)
+{
+  const Hair::Curve curve = hair->get_curve(curve_index);
+  const float3 *curve_keys = &hair->get_curve_keys()[0];
+  const float *curve_radius = &hair->get_curve_radius()[0];
+  const int num_segments = curve.num_segments();
+  const int packed_type = PRIMITIVE_PACK_SEGMENT(primitive_type, BVH_CURVE_ALL_SEGMENTS);
+
+  if (curve_attr_mP == NULL || params.num_motion_curve_steps == 0) {
+    /* Single reference for the whole shutter time. */
+    const size_t num_keys = hair->get_curve_keys().size();
+    const size_t num_steps = (curve_attr_mP != NULL) ? hair->get_motion_steps() : 1;
+    const float3 *key_steps = (curve_attr_mP != NULL) ? curve_attr_mP->data_float3() : NULL;
+    BoundBox bounds = BoundBox::empty;
+    for (int k = 0; k < num_segments; k++) {
+      curve.bounds_grow(k, curve_keys, curve_radius, bounds);
+      for (size_t step = 0; step < num_steps - 1; step++) {
+        curve.bounds_grow(k, key_steps + step * num_keys, curve_radius, bounds);
+      }
+    }
+    if (bounds.valid()) {
+      references.push_back(BVHReference(bounds, curve_index, i, packed_type));
+      root.grow(bounds);
+      center.grow(bounds.center2());
+    }
+    return;
+  }
+
+  /* Motion curves, one reference per BVH time step like for the individual segments. */
+  const int num_bvh_steps = params.num_motion_curve_steps * 2 + 1;
+  const float num_bvh_steps_inv_1 = 1.0f / (num_bvh_steps - 1);
+  const size_t num_steps = hair->get_motion_steps();
+  const float3 *key_steps = curve_attr_mP->data_float3();
+  const size_t num_keys = hair->get_curve_keys().size();
+  BoundBox prev_bounds = BoundBox::empty;
+  for (int bvh_step = 0; bvh_step < num_bvh_steps; ++bvh_step) {
+    const float curr_time = (float)(bvh_step)*num_bvh_steps_inv_1;
+    BoundBox curr_bounds = BoundBox::empty;
+    for (int k = 0; k < num_segments; k++) {
+      float4 curr_keys[4];
+      curve.cardinal_motion_keys(curve_keys,
+                                 curve_radius,
+                                 key_steps,
+                                 num_keys,
+                                 num_steps,
+                                 curr_time,
+                                 k - 1,
+                                 k,
+                                 k + 1,
+                                 k + 2,
+                                 curr_keys);
+      curve.bounds_grow(curr_keys, curr_bounds);
+    }
+    if (bvh_step > 0) {
+      BoundBox bounds = prev_bounds;
+      bounds.grow(curr_bounds);
+      if (bounds.valid()) {
+        const float prev_time = (float)(bvh_step - 1) * num_bvh_steps_inv_1;
+        references.push_back(
+            BVHReference(bounds, curve_index, i, packed_type, prev_time, curr_time));
+        root.grow(bounds);
+        center.grow(bounds.center2());
+      }
+    }
+    prev_bounds = curr_bounds;
+  }
+}
+
 void BVHBuild::add_reference_geometry(BoundBox &root, BoundBox &center, Geometry *geom, int i)
 {
   if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -371,6 +462,11 @@ BVHNode *BVHBuild::run()
 {
   BVHRange root;
 
+  if (params.use_curve_primitives) {
+    /* References covering whole curves can not be split. */
+    params.use_spatial_split = false;
+  }
+
   /* add references */
   add_references(root);
 
@@ -399,11 +495,22 @@ BVHNode *BVHBuild::run()
   progress_total = references.size();
   progress_original_total = progress_total;
 
-  prim_type.resize(references.size());
-  prim_index.resize(references.size());
-  prim_object.resize(references.size());
+  size_t num_prims = references.size();
+  if (params.use_curve_primitives) {
+    /* Make room for the segments of the curve references. */
+    foreach (const BVHReference &ref, references) {
+      const int num_segments = curve_reference_num_segments(objects, ref);
+      if (num_segments != 0) {
+        num_prims += num_segments - 1;
+      }
+    }
+  }
+
+  prim_type.resize(num_prims);
+  prim_index.resize(num_prims);
+  prim_object.resize(num_prims);
   if (need_prim_time) {
-    prim_time.resize(references.size());
+    prim_time.resize(num_prims);
   }
   else {
     prim_time.resize(0);
@@ -850,7 +957,30 @@ BVHNode *BVHBuild::create_leaf_node(const BVHRange &range, const vector<BVHRefer
   /* Fill in per-type type/index array. */
   for (int i = 0; i < range.size(); i++) {
     const BVHReference &ref = references[range.start() + i];
-    if (ref.prim_index() != -1) {
+    const int num_segments = curve_reference_num_segments(objects, ref);
+    if (num_segments != 0) {
+      /* Expand the reference to all the segments of the curve. */
+      const int type = ref.prim_type() & PRIMITIVE_ALL;
+      const int type_index = bitscan(type);
+      for (int k = 0; k < num_segments; k++) {
+        const int packed_type = PRIMITIVE_PACK_SEGMENT(type, k);
+        p_ref[type_index].push_back(BVHReference(ref.bounds(),
+                                                 ref.prim_index(),
+                                                 ref.prim_object(),
+                                                 packed_type,
+                                                 ref.time_from(),
+                                                 ref.time_to()));
+        p_type[type_index].push_back(packed_type);
+        p_index[type_index].push_back(ref.prim_index());
+        p_object[type_index].push_back(ref.prim_object());
+        p_time[type_index].push_back(make_float2(ref.time_from(), ref.time_to()));
+      }
+
+      bounds[type_index].grow(ref.bounds());
+      visibility[type_index] |= objects[ref.prim_object()]->visibility_for_tracing();
+      num_new_prims += num_segments;
+    }
+    else if (ref.prim_index() != -1) {
       int type_index = bitscan(ref.prim_type() & PRIMITIVE_ALL);
       p_ref[type_index].push_back(ref);
       p_type[type_index].push_back(ref.prim_type());
@@ -938,18 +1068,20 @@ BVHNode *BVHBuild::create_leaf_node(const BVHRange &range, const vector<BVHRefer
   const int num_new_leaf_data = start_index;
   const size_t new_leaf_data_size = sizeof(int) * num_new_leaf_data;
   /* Copy actual data to the packed array. */
-  if (params.use_spatial_split) {
+  if (params.use_spatial_split || params.use_curve_primitives) {
     spatial_spin_lock.lock();
     /* We use first free index in the packed arrays and mode pointer to the
-     * end of the current range.
+     * end of the current range. Curve references expand to more than one
+     * primitive, so in that case the range can not be used either.
      *
      * This doesn't give deterministic packed arrays, but it shouldn't really
      * matter because order of children in BVH is deterministic.
      */
+    const size_t num_leaf_data = num_new_leaf_data + ob_num;
     start_index = spatial_free_index;
-    spatial_free_index += range.size();
+    spatial_free_index += num_leaf_data;
     /* Extend an array when needed. */
-    const size_t range_end = start_index + range.size();
+    const size_t range_end = start_index + num_leaf_data;
     if (prim_type.size() < range_end) {
       /* Avoid extra re-allocations by pre-allocating bigger array in an
        * advance.
@@ -29,6 +29,7 @@
 
 CCL_NAMESPACE_BEGIN
 
+class Attribute;
 class Boundbox;
 class BVHBuildTask;
 class BVHNode;
@@ -68,6 +69,13 @@ class BVHBuild {
   /* Adding references. */
   void add_reference_triangles(BoundBox &root, BoundBox &center, Mesh *mesh, int i);
   void add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int i);
+  void add_reference_curve_all_segments(BoundBox &root,
+                                        BoundBox &center,
+                                        Hair *hair,
+                                        const Attribute *curve_attr_mP,
+                                        int primitive_type,
+                                        int curve_index,
+                                        int i);
   void add_reference_geometry(BoundBox &root, BoundBox &center, Geometry *geom, int i);
   void add_reference_object(BoundBox &root, BoundBox &center, Object *ob, int i);
   void add_references(BVHRange &root);
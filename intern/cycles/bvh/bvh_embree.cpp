@@ -225,14 +225,23 @@ static void rtc_filter_occluded_func(const RTCFilterFunctionNArguments *args)
 
 static void rtc_filter_func_thick_curve(const RTCFilterFunctionNArguments *args)
 {
-  const RTCRay *ray = (RTCRay *)args->ray;
-  RTCHit *hit = (RTCHit *)args->hit;
+  /* Camera rays are traced as streams, so this can be called for ray packets. */
+  for (unsigned int i = 0; i < args->N; i++) {
+    if (args->valid[i] == 0) {
+      continue;
+    }
 
-  /* Always ignore backfacing intersections. */
-  if (dot(make_float3(ray->dir_x, ray->dir_y, ray->dir_z),
-          make_float3(hit->Ng_x, hit->Ng_y, hit->Ng_z)) > 0.0f) {
-    *args->valid = 0;
-    return;
+    const float3 dir = make_float3(RTCRayN_dir_x(args->ray, args->N, i),
+                                   RTCRayN_dir_y(args->ray, args->N, i),
+                                   RTCRayN_dir_z(args->ray, args->N, i));
+    const float3 Ng = make_float3(RTCHitN_Ng_x(args->hit, args->N, i),
+                                  RTCHitN_Ng_y(args->hit, args->N, i),
+                                  RTCHitN_Ng_z(args->hit, args->N, i));
+
+    /* Always ignore backfacing intersections. */
+    if (dot(dir, Ng) > 0.0f) {
+      args->valid[i] = 0;
+    }
   }
 }
 
@@ -74,6 +74,17 @@ class BVHParams {
    */
   bool use_unaligned_nodes;
 
+  /* Store aligned nodes with their bounds quantized to 8 bits relative to the node, using 3
+   * instead of 4 float4. Saves memory at the cost of looser bounds.
+   */
+  bool use_compressed_nodes;
+
+  /* Create a single reference for all the segments of a curve, expanded to the segments
+   * when creating its leaf. Reduces the number of nodes of hair heavy scenes a lot, at the
+   * cost of looser bounds. Spatial splits are not supported in this case.
+   */
+  bool use_curve_primitives;
+
   /* Split time range to this number of steps and create leaf node for each
    * of this time steps.
    *
@@ -115,6 +126,8 @@ class BVHParams {
     top_level = false;
     bvh_layout = BVH_LAYOUT_BVH2;
     use_unaligned_nodes = false;
+    use_compressed_nodes = false;
+    use_curve_primitives = false;
 
     num_motion_curve_steps = 0;
     num_motion_triangle_steps = 0;
@@ -153,6 +166,10 @@ class BVHParams {
   static BVHLayout best_bvh_layout(BVHLayout requested_layout, BVHLayoutMask supported_layouts);
 };
 
+/* Segment of curve references covering all the segments of the curve, see
+ * BVHParams::use_curve_primitives. */
+#define BVH_CURVE_ALL_SEGMENTS 0xffffff
+
 /* BVH Reference
  *
  * Reference to a primitive. Primitive index and object are sneakily packed
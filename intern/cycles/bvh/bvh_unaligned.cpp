@@ -74,8 +74,17 @@ bool BVHUnaligned::compute_aligned_space(const BVHReference &ref, Transform *ali
     const int segment = PRIMITIVE_UNPACK_SEGMENT(packed_type);
     const Hair *hair = static_cast<const Hair *>(object->get_geometry());
     const Hair::Curve &curve = hair->get_curve(curve_index);
-    const int key = curve.first_key + segment;
-    const float3 v1 = hair->get_curve_keys()[key], v2 = hair->get_curve_keys()[key + 1];
+    float3 v1, v2;
+    if (segment == BVH_CURVE_ALL_SEGMENTS) {
+      /* Orient along the root to tip direction for references covering the whole curve. */
+      v1 = hair->get_curve_keys()[curve.first_key];
+      v2 = hair->get_curve_keys()[curve.first_key + curve.num_keys - 1];
+    }
+    else {
+      const int key = curve.first_key + segment;
+      v1 = hair->get_curve_keys()[key];
+      v2 = hair->get_curve_keys()[key + 1];
+    }
     float length;
     const float3 axis = normalize_len(v2 - v1, &length);
     if (length > 1e-6f) {
@@ -100,8 +109,19 @@ BoundBox BVHUnaligned::compute_aligned_prim_boundbox(const BVHReference &prim,
     const int segment = PRIMITIVE_UNPACK_SEGMENT(packed_type);
     const Hair *hair = static_cast<const Hair *>(object->get_geometry());
     const Hair::Curve &curve = hair->get_curve(curve_index);
-    curve.bounds_grow(
-        segment, &hair->get_curve_keys()[0], &hair->get_curve_radius()[0], aligned_space, bounds);
+    if (segment == BVH_CURVE_ALL_SEGMENTS) {
+      for (int k = 0; k < curve.num_segments(); k++) {
+        curve.bounds_grow(
+            k, &hair->get_curve_keys()[0], &hair->get_curve_radius()[0], aligned_space, bounds);
+      }
+    }
+    else {
+      curve.bounds_grow(segment,
+                        &hair->get_curve_keys()[0],
+                        &hair->get_curve_radius()[0],
+                        aligned_space,
+                        bounds);
+    }
   }
   else {
     bounds = prim.bounds().transformed(&aligned_space);
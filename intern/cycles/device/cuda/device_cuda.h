@@ -219,6 +219,8 @@ class CUDADevice : public Device {
                                 WorkTile *wtile,
                                 CUdeviceptr d_wtile,
                                 CUstream stream = 0);
+  bool adaptive_sampling_converged(WorkTile *wtile, CUdeviceptr d_wtile);
+
   void adaptive_sampling_post(RenderTile &rtile,
                               WorkTile *wtile,
                               CUdeviceptr d_wtile,
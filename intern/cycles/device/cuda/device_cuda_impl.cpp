@@ -106,6 +106,7 @@ class CUDASplitKernel : public DeviceSplitKernel {
                                                          const DeviceRequestedFeatures &);
   virtual int2 split_kernel_local_size();
   virtual int2 split_kernel_global_size(device_memory &kg, device_memory &data, DeviceTask &task);
+  virtual void synchronize();
 };
 
 /* Utility to push/pop CUDA context. */
@@ -1278,8 +1279,7 @@ void CUDADevice::tex_alloc(device_texture &mem)
   texture_info[slot] = mem.info;
   need_texture_info = true;
 
-  if (mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT &&
-      mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT3) {
+  if (!is_nanovdb_type(mem.info.data_type)) {
     /* Kepler+, bindless textures. */
     CUDA_RESOURCE_DESC resDesc;
     memset(&resDesc, 0, sizeof(resDesc));
@@ -1852,6 +1852,14 @@ void CUDADevice::adaptive_sampling_filter(uint filter_sample,
                              0));
 }
 
+bool CUDADevice::adaptive_sampling_converged(WorkTile *wtile, CUdeviceptr d_wtile)
+{
+  cuda_assert(cuMemcpyDtoH(&wtile->num_active_rows,
+                           d_wtile + offsetof(WorkTile, num_active_rows),
+                           sizeof(wtile->num_active_rows)));
+  return wtile->num_active_rows == 0;
+}
+
 void CUDADevice::adaptive_sampling_post(RenderTile &rtile,
                                         WorkTile *wtile,
                                         CUdeviceptr d_wtile,
@@ -1938,6 +1946,7 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
       wtile->num_samples = task.adaptive_sampling.align_samples(sample, step_samples);
     }
     wtile->num_samples = min(wtile->num_samples, end_sample - sample);
+    wtile->num_active_rows = 0;
     work_tiles.copy_to_device();
 
     CUdeviceptr d_work_tiles = (CUdeviceptr)work_tiles.device_pointer;
@@ -1952,7 +1961,9 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
 
     /* Run the adaptive sampling kernels at selected samples aligned to step samples. */
     uint filter_sample = sample + wtile->num_samples - 1;
-    if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
+    const bool need_filter = task.adaptive_sampling.use &&
+                             task.adaptive_sampling.need_filter(filter_sample);
+    if (need_filter) {
       adaptive_sampling_filter(filter_sample, wtile, d_work_tiles);
     }
 
@@ -1963,14 +1974,29 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
     rtile.sample = sample;
     task.update_progress(&rtile, rtile.w * rtile.h * wtile->num_samples);
 
+    /* Stop once all pixels of the tile converged, only the active row count set by the
+     * filter is read back. */
+    if (need_filter && adaptive_sampling_converged(wtile, d_work_tiles)) {
+      VLOG(3) << "Adaptive sampling converged tile at sample " << sample << " of "
+              << end_sample << ".";
+      task.update_progress(&rtile, rtile.w * rtile.h * (end_sample - sample));
+      rtile.sample = end_sample;
+      break;
+    }
+
     if (task.get_cancel()) {
       if (task.need_finish_queue == false)
         break;
     }
+
+    if (rtile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen(rtile)) {
+      rtile.stealing_state = RenderTile::WAS_STOLEN;
+      break;
+    }
   }
 
   /* Finalize adaptive sampling. */
-  if (task.adaptive_sampling.use) {
+  if (task.adaptive_sampling.use && (rtile.stealing_state != RenderTile::WAS_STOLEN)) {
     CUdeviceptr d_work_tiles = (CUdeviceptr)work_tiles.device_pointer;
     adaptive_sampling_post(rtile, wtile, d_work_tiles);
     cuda_assert(cuCtxSynchronize());
@@ -2705,6 +2731,12 @@ int2 CUDASplitKernel::split_kernel_global_size(device_memory &kg,
   return global_size;
 }
 
+void CUDASplitKernel::synchronize()
+{
+  CUDAContextScope scope(device);
+  cuda_assert(cuCtxSynchronize());
+}
+
 CCL_NAMESPACE_END
 
 #endif
@@ -78,6 +78,7 @@ class DeviceInfo {
   int num;
   bool display_device;               /* GPU is used as a display device. */
   bool has_half_images;              /* Support half-float textures. */
+  bool has_nanovdb_compression;      /* Support reduced precision NanoVDB grids. */
   bool has_volume_decoupled;         /* Decoupled volume shading. */
   bool has_branched_path;            /* Supports branched path tracing. */
   bool has_adaptive_stop_per_sample; /* Per-sample adaptive sampling stopping. */
@@ -99,6 +100,7 @@ class DeviceInfo {
     cpu_threads = 0;
     display_device = false;
     has_half_images = false;
+    has_nanovdb_compression = false;
     has_volume_decoupled = false;
     has_branched_path = true;
     has_adaptive_stop_per_sample = false;
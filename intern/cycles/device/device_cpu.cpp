@@ -199,6 +199,8 @@ class CPUDevice : public Device {
   DeviceRequestedFeatures requested_features;
 
   KernelFunctions<void (*)(KernelGlobals *, float *, int, int, int, int, int)> path_trace_kernel;
+  KernelFunctions<void (*)(KernelGlobals *, float *, int, int, int, int, int, int)>
+      path_trace_row_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
       convert_to_half_float_kernel;
   KernelFunctions<void (*)(KernelGlobals *, uchar4 *, float *, float, int, int, int, int)>
@@ -285,6 +287,7 @@ class CPUDevice : public Device {
         texture_info(this, "__texture_info", MEM_GLOBAL),
 #define REGISTER_KERNEL(name) name##_kernel(KERNEL_FUNCTIONS(name))
         REGISTER_KERNEL(path_trace),
+        REGISTER_KERNEL(path_trace_row),
         REGISTER_KERNEL(convert_to_half_float),
         REGISTER_KERNEL(convert_to_byte),
         REGISTER_KERNEL(shader),
@@ -956,18 +959,23 @@ class CPUDevice : public Device {
           break;
       }
 
-      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen()) {
+      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen(tile)) {
         tile.stealing_state = RenderTile::WAS_STOLEN;
         break;
       }
 
       if (tile.task == RenderTile::PATH_TRACE) {
         for (int y = tile.y; y < tile.y + tile.h; y++) {
-          for (int x = tile.x; x < tile.x + tile.w; x++) {
-            if (use_coverage) {
+          if (use_coverage) {
+            /* Coverage is accumulated per pixel, trace them one by one. */
+            for (int x = tile.x; x < tile.x + tile.w; x++) {
               coverage.init_pixel(x, y);
+              path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
             }
-            path_trace_kernel()(kg, render_buffer, sample, x, y, tile.offset, tile.stride);
+          }
+          else {
+            path_trace_row_kernel()(
+                kg, render_buffer, sample, tile.x, y, tile.w, tile.offset, tile.stride);
           }
         }
       }
@@ -1477,6 +1485,7 @@ class CPUDevice : public Device {
   {
     KernelGlobals kg = kernel_globals;
     kg.transparent_shadow_intersections = NULL;
+    kg.primary_isect = NULL;
     const int decoupled_count = sizeof(kg.decoupled_volume_steps) /
                                 sizeof(*kg.decoupled_volume_steps);
     for (int i = 0; i < decoupled_count; ++i) {
@@ -1655,6 +1664,7 @@ void device_cpu_info(vector<DeviceInfo> &devices)
   info.has_adaptive_stop_per_sample = true;
   info.has_osl = true;
   info.has_half_images = true;
+  info.has_nanovdb_compression = true;
   info.has_profiling = true;
   info.denoisers = DENOISER_NLM;
   if (openimagedenoise_supported()) {
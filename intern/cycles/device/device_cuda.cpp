@@ -128,6 +128,7 @@ void device_cuda_info(vector<DeviceInfo> &devices)
     info.num = num;
 
     info.has_half_images = (major >= 3);
+    info.has_nanovdb_compression = true;
     info.has_volume_decoupled = false;
     info.has_adaptive_stop_per_sample = false;
     info.denoisers = DENOISER_NLM;
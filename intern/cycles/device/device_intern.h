@@ -37,10 +37,7 @@ bool device_optix_init();
 Device *device_optix_create(DeviceInfo &info, Stats &stats, Profiler &profiler, bool background);
 Device *device_dummy_create(DeviceInfo &info, Stats &stats, Profiler &profiler, bool background);
 
-Device *device_network_create(DeviceInfo &info,
-                              Stats &stats,
-                              Profiler &profiler,
-                              const char *address);
+Device *device_network_create(DeviceInfo &info, Stats &stats, Profiler &profiler);
 Device *device_multi_create(DeviceInfo &info, Stats &stats, Profiler &profiler, bool background);
 
 void device_cpu_info(vector<DeviceInfo> &devices);
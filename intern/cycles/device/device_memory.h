@@ -197,7 +197,7 @@ template<> struct device_type_traits<uint64_t> {
 
 class device_memory {
  public:
-  size_t memory_size()
+  size_t memory_size() const
   {
     return data_size * data_elements * datatype_size(data_type);
   }
@@ -472,6 +472,11 @@ template<typename T> class device_vector : public device_memory {
     return (T *)host_pointer;
   }
 
+  const T *data() const
+  {
+    return (const T *)host_pointer;
+  }
+
   T &operator[](size_t i)
   {
     assert(i < data_size);
@@ -20,6 +20,9 @@
 
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
+#include "util/util_string.h"
+#include "util/util_thread.h"
+#include "util/util_time.h"
 
 #if defined(WITH_NETWORK)
 
@@ -32,6 +35,9 @@ typedef map<device_ptr, DataVector> DataMap;
 /* tile list */
 typedef vector<RenderTile> TileList;
 
+/* Network devices are identified by the address of their server. */
+static const char *NETWORK_DEVICE_ID_PREFIX = "NETWORK_";
+
 /* search a list of tiles and find the one that matches the passed render tile */
 static TileList::iterator tile_list_find(TileList &tile_list, RenderTile &tile)
 {
@@ -45,8 +51,11 @@ class NetworkDevice : public Device {
  public:
   boost::asio::io_service io_service;
   tcp::socket socket;
+  string address;
   device_ptr mem_counter;
   DeviceTask the_task; /* todo: handle multiple tasks */
+  /* Serves the tile requests of the server while its task runs. */
+  thread *task_thread;
 
   thread_mutex rpc_lock;
 
@@ -55,10 +64,12 @@ class NetworkDevice : public Device {
     return false;
   }
 
-  NetworkDevice(DeviceInfo &info, Stats &stats, Profiler &profiler, const char *address)
-      : Device(info, stats, profiler, true), socket(io_service)
+  NetworkDevice(DeviceInfo &info, Stats &stats, Profiler &profiler)
+      : Device(info, stats, profiler, true), socket(io_service), task_thread(NULL)
   {
     error_func = NetworkError();
+    address = info.id.substr(strlen(NETWORK_DEVICE_ID_PREFIX));
+
     stringstream portstr;
     portstr << SERVER_PORT;
 
@@ -73,16 +84,22 @@ class NetworkDevice : public Device {
       socket.connect(*endpoint_iterator++, error);
     }
 
-    if (error)
+    if (error) {
       error_func.network_error(error.message());
+      set_error("Failed to connect to render server " + address + ": " + error.message());
+    }
 
     mem_counter = 0;
   }
 
   ~NetworkDevice()
   {
-    RPCSend snd(socket, &error_func, "stop");
-    snd.write();
+    task_wait();
+
+    if (!error_func.have_error()) {
+      RPCSend snd(socket, &error_func, "stop");
+      snd.write();
+    }
   }
 
   virtual BVHLayoutMask get_bvh_layout_mask() const
@@ -183,10 +200,7 @@ class NetworkDevice : public Device {
     thread_scoped_lock lock(rpc_lock);
 
     RPCSend snd(socket, &error_func, "load_kernels");
-    snd.add(requested_features.experimental);
-    snd.add(requested_features.max_closure);
-    snd.add(requested_features.max_nodes_group);
-    snd.add(requested_features.nodes_features);
+    snd.add(requested_features);
     snd.write();
 
     bool result;
@@ -198,6 +212,12 @@ class NetworkDevice : public Device {
 
   void task_add(DeviceTask &task)
   {
+    if (error_func.have_error())
+      return;
+
+    /* Finish serving the previous task first. */
+    task_wait();
+
     thread_scoped_lock lock(rpc_lock);
 
     the_task = task;
@@ -205,34 +225,46 @@ class NetworkDevice : public Device {
     RPCSend snd(socket, &error_func, "task_add");
     snd.add(task);
     snd.write();
+
+    /* Ask for the task to be waited for right away, so every server of a multi device renders
+     * at the same time instead of one after the other in task_wait(). */
+    RPCSend snd_wait(socket, &error_func, "task_wait");
+    snd_wait.write();
+
+    lock.unlock();
+
+    task_thread = new thread(function_bind(&NetworkDevice::task_run, this));
   }
 
   void task_wait()
   {
-    thread_scoped_lock lock(rpc_lock);
-
-    RPCSend snd(socket, &error_func, "task_wait");
-    snd.write();
-
-    lock.unlock();
+    if (task_thread) {
+      task_thread->join();
+      delete task_thread;
+      task_thread = NULL;
+    }
+  }
 
+  void task_run()
+  {
     TileList the_tiles;
 
-    /* todo: run this threaded for connecting to multiple clients */
     for (;;) {
       if (error_func.have_error())
         break;
 
       RenderTile tile;
 
-      lock.lock();
+      thread_scoped_lock lock(rpc_lock);
       RPCReceive rcv(socket, &error_func);
 
       if (rcv.name == "acquire_tile") {
+        uint tile_types;
+        rcv.read(tile_types);
         lock.unlock();
 
         /* todo: watch out for recursive calls! */
-        if (the_task.acquire_tile(this, tile)) { /* write return as bool */
+        if (the_task.acquire_tile(this, tile, tile_types)) { /* write return as bool */
           the_tiles.push_back(tile);
 
           lock.lock();
@@ -260,6 +292,7 @@ class NetworkDevice : public Device {
 
         assert(tile.buffers != NULL);
 
+        /* Copies the tile buffer back from the server and merges it into the render result. */
         the_task.release_tile(tile);
 
         lock.lock();
@@ -274,6 +307,12 @@ class NetworkDevice : public Device {
       else
         lock.unlock();
     }
+
+    if (error_func.have_error()) {
+      /* Tiles still held by the server are lost, fail the render instead of leaving holes. */
+      set_error("Lost connection to render server " + address + ": " +
+                error_func.error_message());
+    }
   }
 
   void task_cancel()
@@ -292,30 +331,42 @@ class NetworkDevice : public Device {
   NetworkError error_func;
 };
 
-Device *device_network_create(DeviceInfo &info,
-                              Stats &stats,
-                              Profiler &profiler,
-                              const char *address)
+Device *device_network_create(DeviceInfo &info, Stats &stats, Profiler &profiler)
 {
-  return new NetworkDevice(info, stats, profiler, address);
+  return new NetworkDevice(info, stats, profiler);
 }
 
 void device_network_info(vector<DeviceInfo> &devices)
 {
-  DeviceInfo info;
+  /* Servers can be listed explicitly, for render farms where broadcast is not available. */
+  vector<string> servers;
+  const char *servers_env = getenv("CYCLES_NETWORK_SERVERS");
+
+  if (servers_env) {
+    string_split(servers, servers_env, ", ");
+  }
+  else {
+    ServerDiscovery discovery(true);
+    time_sleep(1.0);
+    servers = discovery.get_server_list();
+  }
 
-  info.type = DEVICE_NETWORK;
-  info.description = "Network Device";
-  info.id = "NETWORK";
-  info.num = 0;
+  foreach (const string &server, servers) {
+    DeviceInfo info;
 
-  /* todo: get this info from device */
-  info.has_volume_decoupled = false;
-  info.has_adaptive_stop_per_sample = false;
-  info.has_osl = false;
-  info.denoisers = DENOISER_NONE;
+    info.type = DEVICE_NETWORK;
+    info.description = "Network Device (" + server + ")";
+    info.id = NETWORK_DEVICE_ID_PREFIX + server;
+    info.num = devices.size();
 
-  devices.push_back(info);
+    /* todo: get this info from device */
+    info.has_volume_decoupled = false;
+    info.has_adaptive_stop_per_sample = false;
+    info.has_osl = false;
+    info.denoisers = DENOISER_NONE;
+
+    devices.push_back(info);
+  }
 }
 
 class DeviceServer {
@@ -333,7 +384,7 @@ class DeviceServer {
   }
 
   DeviceServer(Device *device_, tcp::socket &socket_)
-      : device(device_), socket(socket_), stop(false), blocked_waiting(false)
+      : device(device_), socket(socket_), stop(false), blocked_waiting(false), cancelled(false)
   {
     error_func = NetworkError();
   }
@@ -507,7 +558,7 @@ class DeviceServer {
 
       DataVector &data_v = data_vector_find(client_pointer);
 
-      mem.host_pointer = (device_ptr) & (data_v[0]);
+      mem.host_pointer = (void *)&(data_v[0]);
 
       device->mem_copy_from(mem, y, w, h, elem);
 
@@ -538,7 +589,7 @@ class DeviceServer {
       else {
         /* Allocate host side data buffer. */
         DataVector &data_v = data_vector_insert(client_pointer, data_size);
-        mem.host_pointer = (void *) ? (device_ptr) & (data_v[0]) : 0;
+        mem.host_pointer = (data_size) ? (void *)&(data_v[0]) : 0;
       }
 
       /* Zero memory. */
@@ -577,10 +628,7 @@ class DeviceServer {
     }
     else if (rcv.name == "load_kernels") {
       DeviceRequestedFeatures requested_features;
-      rcv.read(requested_features.experimental);
-      rcv.read(requested_features.max_closure);
-      rcv.read(requested_features.max_nodes_group);
-      rcv.read(requested_features.nodes_features);
+      rcv.read(requested_features);
 
       bool result;
       result = device->load_kernels(requested_features);
@@ -610,13 +658,14 @@ class DeviceServer {
       if (task.shader_output)
         task.shader_output = device_ptr_from_client_pointer(task.shader_output);
 
-      task.acquire_tile = function_bind(&DeviceServer::task_acquire_tile, this, _1, _2);
+      task.acquire_tile = function_bind(&DeviceServer::task_acquire_tile, this, _1, _2, _3);
       task.release_tile = function_bind(&DeviceServer::task_release_tile, this, _1);
-      task.update_progress_sample = function_bind(&DeviceServer::task_update_progress_sample,
-                                                  this);
+      task.update_progress_sample = function_bind(
+          &DeviceServer::task_update_progress_sample, this, _1, _2);
       task.update_tile_sample = function_bind(&DeviceServer::task_update_tile_sample, this, _1);
       task.get_cancel = function_bind(&DeviceServer::task_get_cancel, this);
 
+      cancelled = false;
       device->task_add(task);
     }
     else if (rcv.name == "task_wait") {
@@ -633,6 +682,7 @@ class DeviceServer {
     }
     else if (rcv.name == "task_cancel") {
       lock.unlock();
+      cancelled = true;
       device->task_cancel();
     }
     else if (rcv.name == "acquire_tile") {
@@ -660,13 +710,14 @@ class DeviceServer {
     }
   }
 
-  bool task_acquire_tile(Device *, RenderTile &tile)
+  bool task_acquire_tile(Device *, RenderTile &tile, uint tile_types)
   {
     thread_scoped_lock acquire_lock(acquire_mutex);
 
     bool result = false;
 
     RPCSend snd(socket, &error_func, "acquire_tile");
+    snd.add(tile_types);
     snd.write();
 
     do {
@@ -701,7 +752,7 @@ class DeviceServer {
     return result;
   }
 
-  void task_update_progress_sample()
+  void task_update_progress_sample(long, int)
   {
     ; /* skip */
   }
@@ -750,7 +801,7 @@ class DeviceServer {
 
   bool task_get_cancel()
   {
-    return false;
+    return cancelled || have_error();
   }
 
   /* properties */
@@ -772,6 +823,7 @@ class DeviceServer {
 
   bool stop;
   bool blocked_waiting;
+  bool cancelled;
 
  private:
   NetworkError error_func;
@@ -33,10 +33,13 @@
 #  include <iostream>
 #  include <sstream>
 
+#  include "device/device.h"
+
 #  include "render/buffers.h"
 
 #  include "util/util_foreach.h"
 #  include "util/util_list.h"
+#  include "util/util_logging.h"
 #  include "util/util_map.h"
 #  include "util/util_param.h"
 #  include "util/util_string.h"
@@ -66,14 +69,19 @@ typedef boost::archive::binary_iarchive i_archive;
 
 /* Serialization of device memory */
 
-class network_device_memory : public device_memory {
+/* Derives from device_texture so it can be passed on to the texture allocation of the real
+ * device, the actual memory type is read from the network. */
+class network_device_memory : public device_texture {
  public:
-  network_device_memory(Device *device) : device_memory(device, "", MEM_READ_ONLY)
+  network_device_memory(Device *device)
+      : device_texture(device, "", 0, IMAGE_DATA_TYPE_FLOAT, INTERPOLATION_NONE, EXTENSION_REPEAT)
   {
   }
 
   ~network_device_memory()
   {
+    /* Owned by the server data buffers. */
+    host_pointer = 0;
     device_pointer = 0;
   };
 
@@ -104,6 +112,11 @@ class NetworkError {
     return true ? error_count > 0 : false;
   }
 
+  const string &error_message()
+  {
+    return error;
+  }
+
  private:
   string error;
   int error_count;
@@ -118,7 +131,7 @@ class RPCSend {
   {
     archive &name_;
     error_func = e;
-    fprintf(stderr, "rpc send %s\n", name.c_str());
+    VLOG(4) << "RPC send " << name;
   }
 
   ~RPCSend()
@@ -130,8 +143,17 @@ class RPCSend {
     archive &mem.data_type &mem.data_elements &mem.data_size;
     archive &mem.data_width &mem.data_height &mem.data_depth &mem.device_pointer;
     archive &mem.type &string(mem.name);
-    archive &mem.interpolation &mem.extension;
     archive &mem.device_pointer;
+
+    if (mem.type == MEM_TEXTURE) {
+      const device_texture &tex = (const device_texture &)mem;
+      archive &tex.slot &tex.info.data_type &tex.info.interpolation &tex.info.extension;
+      archive &tex.info.use_transform_3d;
+      const float *transform = (const float *)&tex.info.transform_3d;
+      for (int i = 0; i < sizeof(Transform) / sizeof(float); i++) {
+        archive &transform[i];
+      }
+    }
   }
 
   template<typename T> void add(const T &data)
@@ -145,14 +167,33 @@ class RPCSend {
     archive &type &task.x &task.y &task.w &task.h;
     archive &task.rgba_byte &task.rgba_half &task.buffer &task.sample &task.num_samples;
     archive &task.offset &task.stride;
-    archive &task.shader_input &task.shader_output &task.shader_eval_type;
+    archive &task.shader_input &task.shader_output &task.shader_eval_type &task.shader_filter;
     archive &task.shader_x &task.shader_w;
-    archive &task.need_finish_queue;
+    archive &task.tile_types &task.pass_stride &task.frame_stride &task.target_pass_stride;
+    archive &task.pass_denoising_data &task.pass_denoising_clean;
+    archive &task.need_finish_queue &task.integrator_branched;
+    archive &task.adaptive_sampling.use &task.adaptive_sampling.adaptive_step;
+    archive &task.adaptive_sampling.min_samples;
+  }
+
+  void add(const DeviceRequestedFeatures &requested_features)
+  {
+    archive &requested_features.experimental &requested_features.max_nodes_group;
+    archive &requested_features.nodes_features &requested_features.use_hair;
+    archive &requested_features.use_hair_thick &requested_features.use_object_motion;
+    archive &requested_features.use_camera_motion &requested_features.use_baking;
+    archive &requested_features.use_subsurface &requested_features.use_volume;
+    archive &requested_features.use_integrator_branched &requested_features.use_patch_evaluation;
+    archive &requested_features.use_transparent &requested_features.use_shadow_tricks;
+    archive &requested_features.use_principled &requested_features.use_denoising;
+    archive &requested_features.use_shader_raytrace &requested_features.use_true_displacement;
+    archive &requested_features.use_background_light;
   }
 
   void add(const RenderTile &tile)
   {
-    archive &tile.x &tile.y &tile.w &tile.h;
+    int task = (int)tile.task;
+    archive &task &tile.x &tile.y &tile.w &tile.h;
     archive &tile.start_sample &tile.num_samples &tile.sample;
     archive &tile.resolution &tile.offset &tile.stride;
     archive &tile.buffer;
@@ -246,7 +287,7 @@ class RPCReceive {
           archive = new i_archive(*archive_stream);
 
           *archive &name;
-          fprintf(stderr, "rpc receive %s\n", name.c_str());
+          VLOG(4) << "RPC receive " << name;
         }
         else {
           error_func->network_error("Network receive error: data size doesn't match header");
@@ -272,9 +313,21 @@ class RPCReceive {
     *archive &mem.data_type &mem.data_elements &mem.data_size;
     *archive &mem.data_width &mem.data_height &mem.data_depth &mem.device_pointer;
     *archive &mem.type &name;
-    *archive &mem.interpolation &mem.extension;
     *archive &mem.device_pointer;
 
+    if (mem.type == MEM_TEXTURE) {
+      *archive &mem.slot &mem.info.data_type &mem.info.interpolation &mem.info.extension;
+      *archive &mem.info.use_transform_3d;
+      float *transform = (float *)&mem.info.transform_3d;
+      for (int i = 0; i < sizeof(Transform) / sizeof(float); i++) {
+        *archive &transform[i];
+      }
+
+      mem.info.width = mem.data_width;
+      mem.info.height = mem.data_height;
+      mem.info.depth = mem.data_depth;
+    }
+
     mem.name = name.c_str();
     mem.host_pointer = 0;
 
@@ -309,20 +362,40 @@ class RPCReceive {
     *archive &type &task.x &task.y &task.w &task.h;
     *archive &task.rgba_byte &task.rgba_half &task.buffer &task.sample &task.num_samples;
     *archive &task.offset &task.stride;
-    *archive &task.shader_input &task.shader_output &task.shader_eval_type;
+    *archive &task.shader_input &task.shader_output &task.shader_eval_type &task.shader_filter;
     *archive &task.shader_x &task.shader_w;
-    *archive &task.need_finish_queue;
+    *archive &task.tile_types &task.pass_stride &task.frame_stride &task.target_pass_stride;
+    *archive &task.pass_denoising_data &task.pass_denoising_clean;
+    *archive &task.need_finish_queue &task.integrator_branched;
+    *archive &task.adaptive_sampling.use &task.adaptive_sampling.adaptive_step;
+    *archive &task.adaptive_sampling.min_samples;
 
     task.type = (DeviceTask::Type)type;
   }
 
+  void read(DeviceRequestedFeatures &requested_features)
+  {
+    *archive &requested_features.experimental &requested_features.max_nodes_group;
+    *archive &requested_features.nodes_features &requested_features.use_hair;
+    *archive &requested_features.use_hair_thick &requested_features.use_object_motion;
+    *archive &requested_features.use_camera_motion &requested_features.use_baking;
+    *archive &requested_features.use_subsurface &requested_features.use_volume;
+    *archive &requested_features.use_integrator_branched &requested_features.use_patch_evaluation;
+    *archive &requested_features.use_transparent &requested_features.use_shadow_tricks;
+    *archive &requested_features.use_principled &requested_features.use_denoising;
+    *archive &requested_features.use_shader_raytrace &requested_features.use_true_displacement;
+    *archive &requested_features.use_background_light;
+  }
+
   void read(RenderTile &tile)
   {
-    *archive &tile.x &tile.y &tile.w &tile.h;
+    int task;
+    *archive &task &tile.x &tile.y &tile.w &tile.h;
     *archive &tile.start_sample &tile.num_samples &tile.sample;
     *archive &tile.resolution &tile.offset &tile.stride;
     *archive &tile.buffer;
 
+    tile.task = (RenderTile::Task)task;
     tile.buffers = NULL;
   }
 
@@ -30,6 +30,7 @@
 #  include "util/util_debug.h"
 #  include "util/util_logging.h"
 #  include "util/util_md5.h"
+#  include "util/util_murmurhash.h"
 #  include "util/util_path.h"
 #  include "util/util_progress.h"
 #  include "util/util_time.h"
@@ -57,6 +58,49 @@ struct ShaderParams {
   int offset;
   int sample;
 };
+
+// Header of the acceleration structures stored in the disk cache
+struct BVHCacheHeader {
+  char magic[8];
+  OptixAccelRelocationInfo relocation_info;
+  uint64_t size;
+};
+
+static const char bvh_cache_magic[8] = {'C', 'Y', 'O', 'P', 'T', 'B', 'V', 'H'};
+
+// Hash of the build input data, used as key for the acceleration structure disk cache
+class BVHCacheKey {
+ public:
+  BVHCacheKey() : hash1(0), hash2(0x9e3779b9)
+  {
+  }
+
+  void append(const void *data, size_t size)
+  {
+    // Hash large buffers in chunks, since the hash function takes the length as an integer
+    const size_t chunk_size = (size_t)1 << 30;
+    const char *bytes = static_cast<const char *>(data);
+    for (size_t offset = 0; offset < size; offset += chunk_size) {
+      const int len = (int)min(size - offset, chunk_size);
+      hash1 = util_murmur_hash3(bytes + offset, len, hash1);
+      hash2 = util_murmur_hash3(bytes + offset, len, hash2);
+    }
+  }
+
+  template<typename T> void append(const T &value)
+  {
+    append(&value, sizeof(value));
+  }
+
+  string filepath() const
+  {
+    return path_cache_get(path_join("optix_bvh", string_printf("%08x%08x.bin", hash1, hash2)));
+  }
+
+ protected:
+  uint32_t hash1, hash2;
+};
+
 struct KernelParams {
   WorkTile tile;
   KernelData data;
@@ -240,6 +284,15 @@ class OptiXDevice : public CUDADevice {
         context, options.logCallbackFunction, options.logCallbackData, options.logCallbackLevel));
 #  endif
 
+    // Store compiled modules next to the other cached kernels, so that they are only compiled
+    // from PTX once and not every time a session starts. This is not fatal if it fails.
+    const string module_cache_path = path_cache_get("optix");
+    path_create_directories(path_join(module_cache_path, "cache"));
+    if (optixDeviceContextSetCacheLocation(context, module_cache_path.c_str()) != OPTIX_SUCCESS ||
+        optixDeviceContextSetCacheEnabled(context, 1) != OPTIX_SUCCESS) {
+      VLOG(1) << "Failed to enable OptiX module cache in " << module_cache_path << ".";
+    }
+
     // Create launch streams
     cuda_stream.resize(info.cpu_threads);
     for (int i = 0; i < info.cpu_threads; ++i)
@@ -775,6 +828,7 @@ class OptiXDevice : public CUDADevice {
         wtile.num_samples = task.adaptive_sampling.align_samples(sample, step_samples);
       }
       wtile.num_samples = min(wtile.num_samples, end_sample - sample);
+      wtile.num_active_rows = 0;
       device_ptr d_wtile_ptr = launch_params_ptr + offsetof(KernelParams, tile);
       check_result_cuda(
           cuMemcpyHtoDAsync(d_wtile_ptr, &wtile, sizeof(wtile), cuda_stream[thread_index]));
@@ -808,7 +862,9 @@ class OptiXDevice : public CUDADevice {
 
       // Run the adaptive sampling kernels at selected samples aligned to step samples.
       uint filter_sample = wtile.start_sample + wtile.num_samples - 1;
-      if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
+      const bool need_filter = task.adaptive_sampling.use &&
+                               task.adaptive_sampling.need_filter(filter_sample);
+      if (need_filter) {
         adaptive_sampling_filter(filter_sample, &wtile, d_wtile_ptr, cuda_stream[thread_index]);
       }
 
@@ -821,6 +877,15 @@ class OptiXDevice : public CUDADevice {
       // Update task progress after the kernel completed rendering
       task.update_progress(&rtile, wtile.w * wtile.h * wtile.num_samples);
 
+      // Stop once all pixels of the tile converged
+      if (need_filter && adaptive_sampling_converged(&wtile, d_wtile_ptr)) {
+        VLOG(3) << "Adaptive sampling converged tile at sample " << sample << " of "
+                << end_sample << ".";
+        task.update_progress(&rtile, wtile.w * wtile.h * (end_sample - sample));
+        rtile.sample = end_sample;
+        break;
+      }
+
       if (task.get_cancel() && !task.need_finish_queue)
         return;  // Cancel rendering
     }
@@ -1141,13 +1206,94 @@ class OptiXDevice : public CUDADevice {
     }
   }
 
+  bool load_optix_bvh_cache(BVHOptiX *bvh, const string &filepath)
+  {
+    vector<uint8_t> data;
+    if (!path_read_binary(filepath, data) || data.size() < sizeof(BVHCacheHeader)) {
+      return false;
+    }
+
+    BVHCacheHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, bvh_cache_magic, sizeof(header.magic)) != 0 ||
+        header.size != data.size() - sizeof(header)) {
+      return false;
+    }
+
+    // Acceleration structures can only be reused with a compatible device and driver
+    int compatible = 0;
+    if (optixAccelCheckRelocationCompatibility(context, &header.relocation_info, &compatible) !=
+            OPTIX_SUCCESS ||
+        !compatible) {
+      return false;
+    }
+
+    device_only_memory<char> &out_data = bvh->as_data;
+    out_data.alloc_to_device(header.size);
+    if (!out_data.device_pointer) {
+      return false;
+    }
+
+    // Failures are not fatal, the acceleration structure is built again instead
+    OptixTraversableHandle out_handle = 0;
+    if (cuMemcpyHtoD(out_data.device_pointer, data.data() + sizeof(header), header.size) !=
+            CUDA_SUCCESS ||
+        optixAccelRelocate(context,
+                           NULL,
+                           &header.relocation_info,
+                           0,
+                           0,
+                           out_data.device_pointer,
+                           header.size,
+                           &out_handle) != OPTIX_SUCCESS ||
+        cuStreamSynchronize(NULL) != CUDA_SUCCESS) {
+      out_data.free();
+      return false;
+    }
+
+    bvh->traversable_handle = static_cast<uint64_t>(out_handle);
+    return true;
+  }
+
+  void save_optix_bvh_cache(const BVHOptiX *bvh, const string &filepath)
+  {
+    BVHCacheHeader header;
+    memcpy(header.magic, bvh_cache_magic, sizeof(header.magic));
+    header.size = bvh->as_data.device_size;
+    if (optixAccelGetRelocationInfo(
+            context, bvh->traversable_handle, &header.relocation_info) != OPTIX_SUCCESS) {
+      return;
+    }
+
+    vector<uint8_t> data(sizeof(header) + header.size);
+    memcpy(data.data(), &header, sizeof(header));
+    if (cuMemcpyDtoH(data.data() + sizeof(header), bvh->as_data.device_pointer, header.size) !=
+        CUDA_SUCCESS) {
+      return;
+    }
+
+    path_create_directories(filepath);
+    if (!path_write_binary(filepath, data)) {
+      VLOG(1) << "Failed to write OptiX acceleration structure cache " << filepath << ".";
+    }
+  }
+
   bool build_optix_bvh(BVHOptiX *bvh,
                        OptixBuildOperation operation,
                        const OptixBuildInput &build_input,
-                       uint16_t num_motion_steps)
+                       uint16_t num_motion_steps,
+                       const BVHCacheKey *cache_key = NULL)
   {
     const CUDAContextScope scope(cuContext);
 
+    // Reuse a previously built acceleration structure with the same build input
+    const bool use_cache = cache_key && operation == OPTIX_BUILD_OPERATION_BUILD;
+    const string cache_filepath = use_cache ? cache_key->filepath() : "";
+    if (use_cache && load_optix_bvh_cache(bvh, cache_filepath)) {
+      VLOG(2) << "Using cached OptiX acceleration structure " << cache_filepath << ".";
+      return true;
+    }
+
     // Compute memory usage
     OptixAccelBufferSizes sizes = {};
     OptixAccelBuildOptions options;
@@ -1245,6 +1391,10 @@ class OptiXDevice : public CUDADevice {
       }
     }
 
+    if (use_cache) {
+      save_optix_bvh_cache(bvh, cache_filepath);
+    }
+
     return true;
   }
 
@@ -1277,6 +1427,15 @@ class OptiXDevice : public CUDADevice {
 
       // Build bottom level acceleration structures (BLAS)
       Geometry *const geom = bvh->geometry[0];
+
+      // Key of the disk cache entry, made of the build options and all of the build input data
+      BVHCacheKey cache_key;
+      const bool use_bvh_cache = DebugFlags().optix.bvh_cache;
+      if (use_bvh_cache) {
+        cache_key.append(background);
+        cache_key.append(geom->geometry_type);
+        cache_key.append(geom->optix_prim_offset);
+      }
       if (geom->geometry_type == Geometry::HAIR) {
         // Build BLAS for curve primitives
         Hair *const hair = static_cast<Hair *const>(geom);
@@ -1372,6 +1531,15 @@ class OptiXDevice : public CUDADevice {
           }
         }
 
+        if (use_bvh_cache) {
+          cache_key.append(num_motion_steps);
+          cache_key.append(aabb_data.data(), aabb_data.size() * sizeof(OptixAabb));
+#  if OPTIX_ABI_VERSION >= 36
+          cache_key.append(index_data.data(), index_data.size() * sizeof(int));
+          cache_key.append(vertex_data.data(), vertex_data.size() * sizeof(float4));
+#  endif
+        }
+
         // Upload AABB data to GPU
         aabb_data.copy_to_device();
 #  if OPTIX_ABI_VERSION >= 36
@@ -1440,7 +1608,11 @@ class OptiXDevice : public CUDADevice {
 #  endif
         }
 
-        if (!build_optix_bvh(bvh_optix, operation, build_input, num_motion_steps)) {
+        if (!build_optix_bvh(bvh_optix,
+                             operation,
+                             build_input,
+                             num_motion_steps,
+                             use_bvh_cache ? &cache_key : NULL)) {
           progress.set_error("Failed to build OptiX acceleration structure");
         }
       }
@@ -1480,6 +1652,12 @@ class OptiXDevice : public CUDADevice {
           memcpy(vertex_data.data() + num_verts * step, verts, num_verts * sizeof(float3));
         }
 
+        if (use_bvh_cache) {
+          cache_key.append(num_motion_steps);
+          cache_key.append(index_data.data(), index_data.size() * sizeof(int));
+          cache_key.append(vertex_data.data(), vertex_data.size() * sizeof(float3));
+        }
+
         // Upload triangle data to GPU
         index_data.copy_to_device();
         vertex_data.copy_to_device();
@@ -1509,7 +1687,11 @@ class OptiXDevice : public CUDADevice {
         build_input.triangleArray.numSbtRecords = 1;
         build_input.triangleArray.primitiveIndexOffset = mesh->optix_prim_offset;
 
-        if (!build_optix_bvh(bvh_optix, operation, build_input, num_motion_steps)) {
+        if (!build_optix_bvh(bvh_optix,
+                             operation,
+                             build_input,
+                             num_motion_steps,
+                             use_bvh_cache ? &cache_key : NULL)) {
           progress.set_error("Failed to build OptiX acceleration structure");
         }
       }
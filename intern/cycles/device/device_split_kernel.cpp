@@ -19,6 +19,8 @@
 #include "kernel/kernel_types.h"
 #include "kernel/split/kernel_split_data_types.h"
 
+#include "util/util_debug.h"
+#include "util/util_foreach.h"
 #include "util/util_logging.h"
 #include "util/util_time.h"
 
@@ -33,7 +35,8 @@ DeviceSplitKernel::DeviceSplitKernel(Device *device)
       queue_index(device, "queue_index"),
       use_queues_flag(device, "use_queues_flag"),
       work_pool_wgs(device, "work_pool_wgs"),
-      kernel_data_initialized(false)
+      kernel_data_initialized(false),
+      use_profiling(DebugFlags().split_kernel_profile)
 {
   avg_time_per_sample = 0.0;
 
@@ -63,6 +66,21 @@ DeviceSplitKernel::DeviceSplitKernel(Device *device)
 
 DeviceSplitKernel::~DeviceSplitKernel()
 {
+  if (use_profiling && !stage_stats.empty()) {
+    double total_time = 0.0;
+    foreach (const auto &stage, stage_stats) {
+      total_time += stage.second.time;
+    }
+
+    VLOG(1) << "Split kernel stages:";
+    foreach (const auto &stage, stage_stats) {
+      const StageStats &stats = stage.second;
+      VLOG(1) << "  " << stage.first << ": " << stats.time << "s ("
+              << 100.0 * stats.time / max(total_time, 1e-9) << "%), " << stats.num_launches
+              << " launches, " << 1e6 * stats.time / stats.num_launches << "us per launch";
+    }
+  }
+
   split_data.free();
   ray_state.free();
   use_queues_flag.free();
@@ -145,6 +163,15 @@ size_t DeviceSplitKernel::max_elements_for_max_buffer_size(device_memory &kg,
   return max_buffer_size / size_per_element;
 }
 
+void DeviceSplitKernel::profile_stage(const char *name, double start_time)
+{
+  synchronize();
+
+  StageStats &stats = stage_stats[name];
+  stats.time += time_dt() - start_time;
+  stats.num_launches++;
+}
+
 bool DeviceSplitKernel::path_trace(DeviceTask &task,
                                    RenderTile &tile,
                                    device_memory &kgbuffer,
@@ -197,9 +224,15 @@ bool DeviceSplitKernel::path_trace(DeviceTask &task,
   if (device->have_error()) { \
     return false; \
   } \
-  if (!kernel_##name->enqueue( \
-          KernelDimensions(global_size, local_size), kgbuffer, kernel_data)) { \
-    return false; \
+  { \
+    const double stage_start_time = (use_profiling) ? time_dt() : 0.0; \
+    if (!kernel_##name->enqueue( \
+            KernelDimensions(global_size, local_size), kgbuffer, kernel_data)) { \
+      return false; \
+    } \
+    if (use_profiling) { \
+      profile_stage(#name, stage_start_time); \
+    } \
   }
 
   tile.sample = tile.start_sample;
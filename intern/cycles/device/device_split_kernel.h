@@ -20,6 +20,8 @@
 #include "device/device.h"
 #include "render/buffers.h"
 
+#include "util/util_map.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* When allocate global memory in chunks. We may not be able to
@@ -104,6 +106,16 @@ class DeviceSplitKernel {
   size_t local_size[2];
   size_t global_size[2];
 
+  /* Time spent and number of launches of each stage, when profiling. */
+  struct StageStats {
+    double time;
+    uint64_t num_launches;
+  };
+  bool use_profiling;
+  map<string, StageStats> stage_stats;
+
+  void profile_stage(const char *name, double start_time);
+
  public:
   explicit DeviceSplitKernel(Device *device);
   virtual ~DeviceSplitKernel();
@@ -138,6 +150,11 @@ class DeviceSplitKernel {
   virtual int2 split_kernel_global_size(device_memory &kg,
                                         device_memory &data,
                                         DeviceTask &task) = 0;
+
+  /* Wait for enqueued kernels to finish, used to time the individual stages. */
+  virtual void synchronize()
+  {
+  }
 };
 
 CCL_NAMESPACE_END
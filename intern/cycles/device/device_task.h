@@ -64,6 +64,8 @@ class DenoiseParams {
 
   /* Viewport start sample. */
   int start_sample;
+  /* Viewport minimum time in seconds between denoised updates, zero for automatic. */
+  float update_interval;
 
   /** Native Denoiser **/
 
@@ -105,6 +107,7 @@ class DenoiseParams {
     input_passes = DENOISER_INPUT_RGB_ALBEDO;
 
     start_sample = 0;
+    update_interval = 0.0f;
   }
 
   /* Test if a denoising task needs to run, also to prefilter passes for the native
@@ -160,7 +163,7 @@ class DeviceTask {
   function<void(RenderTile &)> update_tile_sample;
   function<void(RenderTile &)> release_tile;
   function<bool()> get_cancel;
-  function<bool()> get_tile_stolen;
+  function<bool(const RenderTile &)> get_tile_stolen;
   function<void(RenderTileNeighbors &, Device *)> map_neighbor_tiles;
   function<void(RenderTileNeighbors &, Device *)> unmap_neighbor_tiles;
 
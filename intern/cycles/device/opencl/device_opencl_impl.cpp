@@ -572,6 +572,11 @@ class OpenCLSplitKernel : public DeviceSplitKernel {
     VLOG(1) << "Global size: " << global_size << ".";
     return global_size;
   }
+
+  virtual void synchronize()
+  {
+    clFinish(device->cqCommandQueue);
+  }
 };
 
 bool OpenCLDevice::opencl_error(cl_int err)
@@ -236,6 +236,63 @@ ccl_device_intersect bool scene_intersect(KernelGlobals *kg,
 #endif   /* __KERNEL_OPTIX__ */
 }
 
+#ifdef __KERNEL_CPU__
+/* Maximum number of rays intersected together by scene_intersect_stream. */
+#  define BVH_STREAM_SIZE 16
+
+/* Intersect a stream of rays sharing the same visibility, like the camera rays of neighbouring
+ * pixels. Embree traces them together to take advantage of their coherence, other BVHs trace
+ * them one by one. A missed ray gets an intersection of type PRIMITIVE_NONE. */
+ccl_device_intersect void scene_intersect_stream(KernelGlobals *kg,
+                                                 const Ray *rays,
+                                                 const int num_rays,
+                                                 const uint visibility,
+                                                 Intersection *isects)
+{
+  kernel_assert(num_rays <= BVH_STREAM_SIZE);
+
+#  ifdef __EMBREE__
+  if (kernel_data.bvh.scene) {
+    CCLIntersectContext ctx(kg, CCLIntersectContext::RAY_REGULAR);
+    IntersectContext rtc_ctx(&ctx);
+    rtc_ctx.context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+
+    RTCRayHit ray_hits[BVH_STREAM_SIZE];
+    for (int i = 0; i < num_rays; i++) {
+      kernel_embree_setup_rayhit(rays[i], ray_hits[i], visibility);
+      if (!scene_intersect_valid(&rays[i])) {
+        /* Rays with tnear > tfar are skipped by Embree. */
+        ray_hits[i].ray.tfar = -FLT_MAX;
+      }
+    }
+
+    rtcIntersect1M(
+        kernel_data.bvh.scene, &rtc_ctx.context, ray_hits, num_rays, sizeof(RTCRayHit));
+
+    for (int i = 0; i < num_rays; i++) {
+      const RTCRayHit &ray_hit = ray_hits[i];
+      if (ray_hit.hit.geomID != RTC_INVALID_GEOMETRY_ID &&
+          ray_hit.hit.primID != RTC_INVALID_GEOMETRY_ID) {
+        kernel_embree_convert_hit(kg, &ray_hit.ray, &ray_hit.hit, &isects[i]);
+      }
+      else {
+        isects[i].t = rays[i].t;
+        isects[i].type = PRIMITIVE_NONE;
+      }
+    }
+    return;
+  }
+#  endif /* __EMBREE__ */
+
+  for (int i = 0; i < num_rays; i++) {
+    if (!scene_intersect(kg, &rays[i], visibility, &isects[i])) {
+      isects[i].t = rays[i].t;
+      isects[i].type = PRIMITIVE_NONE;
+    }
+  }
+}
+#endif /* __KERNEL_CPU__ */
+
 #ifdef __BVH_LOCAL__
 ccl_device_intersect bool scene_intersect_local(KernelGlobals *kg,
                                                 const Ray *ray,
@@ -28,6 +28,36 @@ ccl_device_forceinline Transform bvh_unaligned_node_fetch_space(KernelGlobals *k
   return space;
 }
 
+/* Decode the child bounds of a compressed node into the layout of an aligned node. The bounds
+ * are 8 bit steps of a power of two from the minimum of the node, see BVH2 packing. */
+ccl_device_forceinline void bvh_compressed_node_decode(
+    KernelGlobals *kg, const int node_addr, float4 *node0, float4 *node1, float4 *node2)
+{
+  const float4 origin = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
+  const float4 quantized = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
+  const uint exponents = __float_as_uint(origin.w);
+
+  const float step_x = __uint_as_float((exponents & 0xff) << 23);
+  const float step_y = __uint_as_float(((exponents >> 8) & 0xff) << 23);
+  const float step_z = __uint_as_float(((exponents >> 16) & 0xff) << 23);
+  const uint qx = __float_as_uint(quantized.x);
+  const uint qy = __float_as_uint(quantized.y);
+  const uint qz = __float_as_uint(quantized.z);
+
+  *node0 = make_float4(origin.x + (float)(qx & 0xff) * step_x,
+                       origin.x + (float)((qx >> 8) & 0xff) * step_x,
+                       origin.x + (float)((qx >> 16) & 0xff) * step_x,
+                       origin.x + (float)(qx >> 24) * step_x);
+  *node1 = make_float4(origin.y + (float)(qy & 0xff) * step_y,
+                       origin.y + (float)((qy >> 8) & 0xff) * step_y,
+                       origin.y + (float)((qy >> 16) & 0xff) * step_y,
+                       origin.y + (float)(qy >> 24) * step_y);
+  *node2 = make_float4(origin.z + (float)(qz & 0xff) * step_z,
+                       origin.z + (float)((qz >> 8) & 0xff) * step_z,
+                       origin.z + (float)((qz >> 16) & 0xff) * step_z,
+                       origin.z + (float)(qz >> 24) * step_z);
+}
+
 ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals *kg,
                                                       const float3 P,
                                                       const float3 idir,
@@ -38,12 +68,16 @@ ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals *kg,
 {
 
   /* fetch node data */
-#ifdef __VISIBILITY_FLAG__
   float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
-#endif
-  float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
-  float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
-  float4 node2 = kernel_tex_fetch(__bvh_nodes, node_addr + 3);
+  float4 node0, node1, node2;
+  if (__float_as_uint(cnodes.x) & PATH_RAY_NODE_COMPRESSED) {
+    bvh_compressed_node_decode(kg, node_addr, &node0, &node1, &node2);
+  }
+  else {
+    node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
+    node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
+    node2 = kernel_tex_fetch(__bvh_nodes, node_addr + 3);
+  }
 
   /* intersect ray against child nodes */
   float c0lox = (node0.x - P.x) * idir.x;
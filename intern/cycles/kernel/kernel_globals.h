@@ -69,6 +69,10 @@ typedef struct KernelGlobals {
   /* Heap-allocated storage for transparent shadows intersections. */
   Intersection *transparent_shadow_intersections;
 
+  /* Intersection of the camera ray found ahead of the path by kernel_path_trace_row,
+   * consumed by the first scene intersection of the path. */
+  Intersection *primary_isect;
+
   /* Storage for decoupled volume steps. */
   VolumeStep *decoupled_volume_steps[2];
   int decoupled_volume_steps_index;
@@ -15,6 +15,7 @@
  */
 
 #include "kernel_light_background.h"
+#include "kernel_light_tree.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -293,6 +294,10 @@ ccl_device bool lamp_light_eval(
 
   ls->pdf *= kernel_data.integrator.pdf_lights;
 
+  if (kernel_data.integrator.use_light_tree) {
+    ls->pdf *= light_tree_pdf_factor(kg, P, light_tree_lamp_leaf(kg, lamp));
+  }
+
   return true;
 }
 
@@ -351,6 +356,13 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
   float3 V[3];
   bool has_motion = triangle_world_space_vertices(kg, sd->object, sd->prim, sd->time, V);
 
+  float pdf_factor = 1.0f;
+  if (kernel_data.integrator.use_light_tree) {
+    /* The light tree probability depends on the shading point. */
+    pdf_factor = light_tree_pdf_factor(
+        kg, sd->P + sd->I * t, light_tree_triangle_leaf(kg, sd->object, sd->prim));
+  }
+
   const float3 e0 = V[1] - V[0];
   const float3 e1 = V[2] - V[0];
   const float3 e2 = V[2] - V[1];
@@ -390,7 +402,7 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
         area = 0.5f * len(N);
       }
       const float pdf = area * kernel_data.integrator.pdf_triangles;
-      return pdf / solid_angle;
+      return pdf_factor * pdf / solid_angle;
     }
   }
   else {
@@ -407,7 +419,7 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       const float area_pre = triangle_area(V[0], V[1], V[2]);
       pdf = pdf * area_pre / area;
     }
-    return pdf;
+    return pdf_factor * pdf;
   }
 }
 
@@ -632,9 +644,13 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
                                       int bounce,
                                       LightSample *ls)
 {
+  float pdf_factor = 1.0f;
+
   if (lamp < 0) {
     /* sample index */
-    int index = light_distribution_sample(kg, &randu);
+    int index = (kernel_data.integrator.use_light_tree) ?
+                    light_tree_sample(kg, P, &randu, &pdf_factor) :
+                    light_distribution_sample(kg, &randu);
 
     /* fetch light data */
     const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
@@ -647,6 +663,7 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
 
       triangle_light_sample(kg, prim, object, randu, randv, time, ls, P);
       ls->shader |= shader_flag;
+      ls->pdf *= pdf_factor;
       return (ls->pdf > 0.0f);
     }
 
@@ -657,7 +674,12 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
     return false;
   }
 
-  return lamp_light_sample(kg, lamp, randu, randv, P, ls);
+  if (!lamp_light_sample(kg, lamp, randu, randv, P, ls)) {
+    return false;
+  }
+
+  ls->pdf *= pdf_factor;
+  return true;
 }
 
 ccl_device_inline int light_select_num_samples(KernelGlobals *kg, int index)
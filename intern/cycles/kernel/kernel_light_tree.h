@@ -0,0 +1,205 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Hierarchy over the emitters of the light distribution, used to pick an emitter with a
+ * probability depending on the shading point. Nodes store the sum of the flat distribution
+ * probabilities of their emitters, so the probability of an emitter is always expressed as
+ * its flat distribution probability times a factor, and the same factor is applied to the
+ * flat pdf of triangles and lamps. Distant and background lights can not be bounded, they
+ * are sampled outside of the tree with their flat distribution probability. */
+
+ccl_device float light_tree_node_importance(const ccl_global KernelLightTreeNode *knode,
+                                            const float3 P)
+{
+  const float3 bbox_min = make_float3(knode->bbox_min[0], knode->bbox_min[1], knode->bbox_min[2]);
+  const float3 bbox_max = make_float3(knode->bbox_max[0], knode->bbox_max[1], knode->bbox_max[2]);
+  const float3 centroid = 0.5f * (bbox_min + bbox_max);
+  const float radius_squared = 0.25f * len_squared(bbox_max - bbox_min);
+
+  float distance;
+  const float3 D = normalize_len(P - centroid, &distance);
+  const float distance_squared = distance * distance;
+
+  float cos_theta_prime = 1.0f;
+  if (knode->cos_theta_o > -1.0f && distance_squared > radius_squared) {
+    /* Emitters are two-sided, measure the angle to the closest of the two cone directions. */
+    const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+    const float theta = safe_acosf(fabsf(dot(axis, D)));
+    const float theta_o = safe_acosf(knode->cos_theta_o);
+    const float theta_u = safe_asinf(sqrtf(radius_squared) / distance);
+    const float theta_prime = theta - theta_o - theta_u;
+    if (theta_prime > 0.0f) {
+      cos_theta_prime = cosf(theta_prime);
+    }
+  }
+
+  return knode->energy * cos_theta_prime / max(distance_squared, radius_squared);
+}
+
+/* Probability of picking the first child of an inner node. */
+ccl_device float light_tree_child_probability(KernelGlobals *kg, int node, const float3 P)
+{
+  const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node);
+  const ccl_global KernelLightTreeNode *kleft = &kernel_tex_fetch(__light_tree_nodes, node + 1);
+  const ccl_global KernelLightTreeNode *kright = &kernel_tex_fetch(__light_tree_nodes,
+                                                                   knode->second_child);
+
+  const float importance_left = light_tree_node_importance(kleft, P);
+  const float importance_right = light_tree_node_importance(kright, P);
+  const float importance = importance_left + importance_right;
+
+  if (!(importance > 0.0f)) {
+    /* Fall back to the flat distribution. */
+    return kleft->energy / (kleft->energy + kright->energy);
+  }
+
+  return importance_left / importance;
+}
+
+/* Flat distribution probability of the emitter. */
+ccl_device_inline float light_tree_emitter_weight(KernelGlobals *kg, int index)
+{
+  return kernel_tex_fetch(__light_distribution, index + 1).totarea -
+         kernel_tex_fetch(__light_distribution, index).totarea;
+}
+
+/* Pick an emitter from the light distribution for shading point P, and return the ratio
+ * between its probability and the flat distribution one in pdf_factor. */
+ccl_device int light_tree_sample(KernelGlobals *kg, float3 P, float *randu, float *pdf_factor)
+{
+  const float local_weight = kernel_data.integrator.light_tree_local_weight;
+  float r = *randu;
+
+  int first_emitter, num_emitters;
+  float range_weight;
+
+  if (r < local_weight) {
+    r /= local_weight;
+
+    float pdf = local_weight;
+    int node = 0;
+    const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node);
+
+    while (knode->num_emitters == 0) {
+      const float probability_left = light_tree_child_probability(kg, node, P);
+
+      if (r < probability_left) {
+        node = node + 1;
+        r /= probability_left;
+        pdf *= probability_left;
+      }
+      else {
+        node = knode->second_child;
+        r = (r - probability_left) / (1.0f - probability_left);
+        pdf *= 1.0f - probability_left;
+      }
+
+      knode = &kernel_tex_fetch(__light_tree_nodes, node);
+    }
+
+    first_emitter = knode->first_emitter;
+    num_emitters = knode->num_emitters;
+    range_weight = knode->energy;
+    *pdf_factor = pdf / range_weight;
+  }
+  else {
+    r = (r - local_weight) / (1.0f - local_weight);
+
+    first_emitter = kernel_data.integrator.light_tree_infinite_offset;
+    num_emitters = kernel_data.integrator.light_tree_num_infinite;
+    range_weight = 1.0f - local_weight;
+    *pdf_factor = 1.0f;
+  }
+
+  /* Pick proportionally to the flat distribution within the range, leaves only contain a few
+   * emitters so a linear search is fine. */
+  r *= range_weight;
+
+  int index = -1;
+  float weight = 0.0f;
+
+  for (int i = 0; i < num_emitters; i++) {
+    index = kernel_tex_fetch(__light_tree_emitters, first_emitter + i);
+    weight = light_tree_emitter_weight(kg, index);
+
+    if (r < weight || i == num_emitters - 1) {
+      break;
+    }
+    r -= weight;
+  }
+
+  /* Rescale to reuse random number, like the flat distribution does. */
+  *randu = (weight > 0.0f) ? saturate(r / weight) : 0.0f;
+
+  return index;
+}
+
+/* Ratio between the probability of picking an emitter from the given leaf for shading
+ * point P and its flat distribution probability. */
+ccl_device float light_tree_pdf_factor(KernelGlobals *kg, float3 P, int leaf)
+{
+  if (leaf < 0) {
+    /* Distant and background lights. */
+    return 1.0f;
+  }
+
+  const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, leaf);
+  if (!(knode->energy > 0.0f)) {
+    /* Degenerate emitters that are never sampled. */
+    return 0.0f;
+  }
+
+  float pdf = kernel_data.integrator.light_tree_local_weight / knode->energy;
+
+  int node = leaf;
+  int parent = knode->parent;
+
+  while (parent != -1) {
+    const float probability_left = light_tree_child_probability(kg, parent, P);
+    pdf *= (node == parent + 1) ? probability_left : 1.0f - probability_left;
+
+    node = parent;
+    parent = kernel_tex_fetch(__light_tree_nodes, node).parent;
+  }
+
+  return pdf;
+}
+
+/* Leaf containing lamp, or -1. */
+ccl_device_inline int light_tree_lamp_leaf(KernelGlobals *kg, int lamp)
+{
+  return kernel_tex_fetch(__light_tree_lookup, lamp);
+}
+
+/* Leaf containing the triangle, or -1. */
+ccl_device_inline int light_tree_triangle_leaf(KernelGlobals *kg, int object, int prim)
+{
+  const int object_lookup = kernel_data.integrator.num_all_lights + object * 2;
+  const int triangles_offset = kernel_tex_fetch(__light_tree_lookup, object_lookup);
+
+  if (triangles_offset == -1) {
+    return -1;
+  }
+
+  const int prim_offset = kernel_tex_fetch(__light_tree_lookup, object_lookup + 1);
+  return kernel_tex_fetch(__light_tree_lookup, triangles_offset + prim - prim_offset);
+}
+
+CCL_NAMESPACE_END
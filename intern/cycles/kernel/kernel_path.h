@@ -69,7 +69,20 @@ ccl_device_forceinline bool kernel_path_scene_intersect(KernelGlobals *kg,
     ray->t = kernel_data.background.ao_distance;
   }
 
+#ifdef __KERNEL_CPU__
+  bool hit;
+  if (kg->primary_isect != NULL) {
+    /* Camera ray already intersected by kernel_path_trace_row. */
+    *isect = *kg->primary_isect;
+    kg->primary_isect = NULL;
+    hit = (isect->type != PRIMITIVE_NONE);
+  }
+  else {
+    hit = scene_intersect(kg, ray, visibility, isect);
+  }
+#else
   bool hit = scene_intersect(kg, ray, visibility, isect);
+#endif
 
 #ifdef __KERNEL_DEBUG__
   if (state->flag & PATH_RAY_CAMERA) {
@@ -694,6 +707,85 @@ ccl_device void kernel_path_trace(
   kernel_write_result(kg, buffer, sample, &L);
 }
 
+#  ifdef __KERNEL_CPU__
+/* Path trace a row of w pixels. The camera rays of neighbouring pixels are coherent, so they
+ * are intersected together as a stream before each path continues on its own. */
+ccl_device void kernel_path_trace_row(KernelGlobals *kg,
+                                      ccl_global float *buffer,
+                                      int sample,
+                                      int x,
+                                      int y,
+                                      int w,
+                                      int offset,
+                                      int stride)
+{
+  const int pass_stride = kernel_data.film.pass_stride;
+
+  for (int stream_x = x; stream_x < x + w; stream_x += BVH_STREAM_SIZE) {
+    PROFILING_INIT(kg, PROFILING_RAY_SETUP);
+
+    const int stream_end = min(stream_x + BVH_STREAM_SIZE, x + w);
+
+    Ray rays[BVH_STREAM_SIZE];
+    Intersection isects[BVH_STREAM_SIZE];
+    uint rng_hashes[BVH_STREAM_SIZE];
+    ccl_global float *buffers[BVH_STREAM_SIZE];
+    int num_rays = 0;
+
+    /* Initialize random numbers and sample rays of the pixels that need it. */
+    for (int px = stream_x; px < stream_end; px++) {
+      ccl_global float *pixel_buffer = buffer + (offset + px + y * stride) * pass_stride;
+
+      if (kernel_data.film.pass_adaptive_aux_buffer) {
+        ccl_global float4 *aux = (ccl_global float4 *)(pixel_buffer +
+                                                       kernel_data.film.pass_adaptive_aux_buffer);
+        if ((*aux).w > 0.0f) {
+          continue;
+        }
+      }
+
+      kernel_path_trace_setup(kg, sample, px, y, &rng_hashes[num_rays], &rays[num_rays]);
+
+      if (rays[num_rays].t == 0.0f) {
+        continue;
+      }
+
+      buffers[num_rays++] = pixel_buffer;
+    }
+
+    if (num_rays == 0) {
+      continue;
+    }
+
+    {
+      PROFILING_INIT(kg, PROFILING_SCENE_INTERSECT);
+      scene_intersect_stream(kg, rays, num_rays, PATH_RAY_CAMERA, isects);
+    }
+
+    for (int i = 0; i < num_rays; i++) {
+      /* Initialize state. */
+      float3 throughput = make_float3(1.0f, 1.0f, 1.0f);
+
+      PathRadiance L;
+      path_radiance_init(kg, &L);
+
+      ShaderDataTinyStorage emission_sd_storage;
+      ShaderData *emission_sd = AS_SHADER_DATA(&emission_sd_storage);
+
+      PathState state;
+      path_state_init(kg, emission_sd, &state, rng_hashes[i], sample, &rays[i]);
+
+      /* Integrate, starting from the intersection of the camera ray. */
+      kg->primary_isect = &isects[i];
+      kernel_path_integrate(kg, &state, throughput, &rays[i], &L, buffers[i], emission_sd);
+      kg->primary_isect = NULL;
+
+      kernel_write_result(kg, buffers[i], sample, &L);
+    }
+  }
+}
+#  endif /* __KERNEL_CPU__ */
+
 #endif /* __SPLIT_KERNEL__ */
 
 CCL_NAMESPACE_END
@@ -287,8 +287,8 @@ enum PathRayFlag {
                                  PATH_RAY_SHADOW_TRANSPARENT_NON_CATCHER),
   PATH_RAY_SHADOW = (PATH_RAY_SHADOW_OPAQUE | PATH_RAY_SHADOW_TRANSPARENT),
 
-  /* Unused, free to reuse. */
-  PATH_RAY_UNUSED = (1 << 11),
+  /* Special flag to tag compressed BVH nodes. */
+  PATH_RAY_NODE_COMPRESSED = (1 << 11),
 
   /* Ray visibility for volume scattering. */
   PATH_RAY_VOLUME_SCATTER = (1 << 12),
@@ -1326,6 +1326,12 @@ typedef struct KernelIntegrator {
   float pdf_lights;
   float light_inv_rr_threshold;
 
+  /* light tree */
+  int use_light_tree;
+  int light_tree_num_infinite;
+  int light_tree_infinite_offset;
+  float light_tree_local_weight;
+
   /* bounces */
   int min_bounce;
   int max_bounce;
@@ -1548,6 +1554,24 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+typedef struct KernelLightTreeNode {
+  float bbox_min[3];
+  /* Sum of the flat distribution probabilities of the emitters. */
+  float energy;
+  float bbox_max[3];
+  /* Cosine of the largest angle between the axis and the two-sided emitter normals, -1 for
+   * emitters without orientation. */
+  float cos_theta_o;
+  float axis[3];
+  int parent;
+  /* Inner nodes have their first child right after them, and num_emitters of zero. */
+  int second_child;
+  int first_emitter;
+  int num_emitters;
+  int pad;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
@@ -1697,6 +1721,10 @@ typedef struct WorkTile {
   uint stride;
 
   ccl_global float *buffer;
+
+  /* Number of rows with pixels that still need samples, counted by the adaptive sampling
+   * filter on the device so the tile can stop rendering once it converged. */
+  uint num_active_rows;
 } WorkTile;
 
 /* Precoumputed sample table sizes for PMJ02 sampler. */
@@ -19,6 +19,9 @@
 void KERNEL_FUNCTION_FULL_NAME(path_trace)(
     KernelGlobals *kg, float *buffer, int sample, int x, int y, int offset, int stride);
 
+void KERNEL_FUNCTION_FULL_NAME(path_trace_row)(
+    KernelGlobals *kg, float *buffer, int sample, int x, int y, int w, int offset, int stride);
+
 void KERNEL_FUNCTION_FULL_NAME(convert_to_byte)(KernelGlobals *kg,
                                                 uchar4 *rgba,
                                                 float *buffer,
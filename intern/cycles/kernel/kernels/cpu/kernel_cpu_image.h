@@ -645,6 +645,10 @@ ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals *kg,
       return NanoVDBInterpolator<float>::interp_3d(info, P.x, P.y, P.z, interp);
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
       return NanoVDBInterpolator<nanovdb::Vec3f>::interp_3d(info, P.x, P.y, P.z, interp);
+    case IMAGE_DATA_TYPE_NANOVDB_FPN:
+      return NanoVDBInterpolator<nanovdb::FpN>::interp_3d(info, P.x, P.y, P.z, interp);
+    case IMAGE_DATA_TYPE_NANOVDB_FP16:
+      return NanoVDBInterpolator<nanovdb::Fp16>::interp_3d(info, P.x, P.y, P.z, interp);
 #endif
     default:
       assert(0);
@@ -98,6 +98,26 @@ void KERNEL_FUNCTION_FULL_NAME(path_trace)(
 #  endif /* KERNEL_STUB */
 }
 
+void KERNEL_FUNCTION_FULL_NAME(path_trace_row)(
+    KernelGlobals *kg, float *buffer, int sample, int x, int y, int w, int offset, int stride)
+{
+#  ifdef KERNEL_STUB
+  STUB_ASSERT(KERNEL_ARCH, path_trace_row);
+#  else
+#    ifdef __BRANCHED_PATH__
+  if (kernel_data.integrator.branched) {
+    for (int px = x; px < x + w; px++) {
+      kernel_branched_path_trace(kg, buffer, sample, px, y, offset, stride);
+    }
+  }
+  else
+#    endif
+  {
+    kernel_path_trace_row(kg, buffer, sample, x, y, w, offset, stride);
+  }
+#  endif /* KERNEL_STUB */
+}
+
 /* Film */
 
 void KERNEL_FUNCTION_FULL_NAME(convert_to_byte)(KernelGlobals *kg,
@@ -106,7 +106,9 @@ kernel_cuda_adaptive_filter_x(WorkTile *tile, int sample, uint)
 	if(kernel_data.film.pass_adaptive_aux_buffer && sample > kernel_data.integrator.adaptive_min_samples) {
 		if(ccl_global_id(0) < tile->h) {
 			int y = tile->y + ccl_global_id(0);
-			kernel_do_adaptive_filter_x(&kg, y, tile);
+			if(kernel_do_adaptive_filter_x(&kg, y, tile)) {
+				atomic_fetch_and_inc_uint32(&tile->num_active_rows);
+			}
 		}
 	}
 }
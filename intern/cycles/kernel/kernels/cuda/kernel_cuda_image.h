@@ -156,14 +156,16 @@ ccl_device T kernel_tex_image_interp_tricubic_nanovdb(S &s, float x, float y, fl
                 g1y * (g0x * s(Vec3f(x0, y1, z1)) + g1x * s(Vec3f(x1, y1, z1))));
 }
 
+/* The value type differs from the build type for compressed grids, which store floats. */
 template<typename T>
-ccl_device_inline T kernel_tex_image_interp_nanovdb(
+ccl_device_inline typename nanovdb::NanoGrid<T>::ValueType kernel_tex_image_interp_nanovdb(
     const TextureInfo &info, float x, float y, float z, uint interpolation)
 {
   using namespace nanovdb;
 
   NanoGrid<T> *const grid = (NanoGrid<T> *)info.data;
   typedef typename nanovdb::NanoGrid<T>::AccessorType AccessorType;
+  typedef typename nanovdb::NanoGrid<T>::ValueType ValueType;
   AccessorType acc = grid->getAccessor();
 
   switch (interpolation) {
@@ -173,7 +175,8 @@ ccl_device_inline T kernel_tex_image_interp_nanovdb(
       return SampleFromVoxels<AccessorType, 1, false>(acc)(Vec3f(x - 0.5f, y - 0.5f, z - 0.5f));
     default:
       SampleFromVoxels<AccessorType, 1, false> s(acc);
-      return kernel_tex_image_interp_tricubic_nanovdb<T>(s, x - 0.5f, y - 0.5f, z - 0.5f);
+      return kernel_tex_image_interp_tricubic_nanovdb<ValueType>(
+          s, x - 0.5f, y - 0.5f, z - 0.5f);
   }
 }
 #endif
@@ -238,6 +241,14 @@ ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals *kg,
         info, x, y, z, interpolation);
     return make_float4(f[0], f[1], f[2], 1.0f);
   }
+  if (texture_type == IMAGE_DATA_TYPE_NANOVDB_FPN) {
+    float f = kernel_tex_image_interp_nanovdb<nanovdb::FpN>(info, x, y, z, interpolation);
+    return make_float4(f, f, f, 1.0f);
+  }
+  if (texture_type == IMAGE_DATA_TYPE_NANOVDB_FP16) {
+    float f = kernel_tex_image_interp_nanovdb<nanovdb::Fp16>(info, x, y, z, interpolation);
+    return make_float4(f, f, f, 1.0f);
+  }
 #endif
   if (texture_type == IMAGE_DATA_TYPE_FLOAT4 || texture_type == IMAGE_DATA_TYPE_BYTE4 ||
       texture_type == IMAGE_DATA_TYPE_HALF4 || texture_type == IMAGE_DATA_TYPE_USHORT4) {
@@ -217,26 +217,12 @@ CCL_NAMESPACE_END
 CCL_NAMESPACE_BEGIN
 
 /* Main Interpreter Loop */
-#if defined(__KERNEL_OPTIX__) && defined(__SHADER_RAYTRACE__)
-ccl_device_inline void svm_eval_nodes(KernelGlobals *kg,
-                                      ShaderData *sd,
-                                      ccl_addr_space PathState *state,
-                                      ccl_global float *buffer,
-                                      ShaderType type,
-                                      int path_flag)
-{
-  optixDirectCall<void>(0, kg, sd, state, buffer, type, path_flag);
-}
-extern "C" __device__ void __direct_callable__svm_eval_nodes(
-#else
-ccl_device_noinline void svm_eval_nodes(
-#endif
-    KernelGlobals *kg,
-    ShaderData *sd,
-    ccl_addr_space PathState *state,
-    ccl_global float *buffer,
-    ShaderType type,
-    int path_flag)
+ccl_device_forceinline void svm_eval_nodes_impl(KernelGlobals *kg,
+                                                ShaderData *sd,
+                                                ccl_addr_space PathState *state,
+                                                ccl_global float *buffer,
+                                                ShaderType type,
+                                                int path_flag)
 {
   float stack[SVM_STACK_SIZE];
   int offset = sd->shader & SHADER_MASK;
@@ -562,6 +548,85 @@ ccl_device_noinline void svm_eval_nodes(
   }
 }
 
+#if defined(__KERNEL_OPTIX__) && defined(__SHADER_RAYTRACE__)
+ccl_device_inline void svm_eval_nodes(KernelGlobals *kg,
+                                      ShaderData *sd,
+                                      ccl_addr_space PathState *state,
+                                      ccl_global float *buffer,
+                                      ShaderType type,
+                                      int path_flag)
+{
+  optixDirectCall<void>(0, kg, sd, state, buffer, type, path_flag);
+}
+
+extern "C" __device__ void __direct_callable__svm_eval_nodes(KernelGlobals *kg,
+                                                             ShaderData *sd,
+                                                             PathState *state,
+                                                             float *buffer,
+                                                             ShaderType type,
+                                                             int path_flag)
+{
+  svm_eval_nodes_impl(kg, sd, state, buffer, type, path_flag);
+}
+#elif defined(__KERNEL_CPU__)
+/* On the CPU the interpreter is specialized for each shader type. The checks of the type in
+ * the nodes fold at compile time, which leaves the closures of the other types out of each
+ * loop and keeps it smaller. GPU kernels keep a single loop for compile time and code size. */
+ccl_device_noinline void svm_eval_nodes_surface(
+    KernelGlobals *kg, ShaderData *sd, PathState *state, float *buffer, int path_flag)
+{
+  svm_eval_nodes_impl(kg, sd, state, buffer, SHADER_TYPE_SURFACE, path_flag);
+}
+
+ccl_device_noinline void svm_eval_nodes_volume(KernelGlobals *kg,
+                                               ShaderData *sd,
+                                               PathState *state,
+                                               int path_flag)
+{
+  svm_eval_nodes_impl(kg, sd, state, NULL, SHADER_TYPE_VOLUME, path_flag);
+}
+
+ccl_device_noinline void svm_eval_nodes_displacement(KernelGlobals *kg,
+                                                     ShaderData *sd,
+                                                     PathState *state)
+{
+  svm_eval_nodes_impl(kg, sd, state, NULL, SHADER_TYPE_DISPLACEMENT, 0);
+}
+
+ccl_device_inline void svm_eval_nodes(KernelGlobals *kg,
+                                      ShaderData *sd,
+                                      PathState *state,
+                                      float *buffer,
+                                      ShaderType type,
+                                      int path_flag)
+{
+  switch (type) {
+    case SHADER_TYPE_SURFACE:
+      svm_eval_nodes_surface(kg, sd, state, buffer, path_flag);
+      break;
+    case SHADER_TYPE_VOLUME:
+      svm_eval_nodes_volume(kg, sd, state, path_flag);
+      break;
+    case SHADER_TYPE_DISPLACEMENT:
+      svm_eval_nodes_displacement(kg, sd, state);
+      break;
+    default:
+      kernel_assert(!"Unknown shader type was passed to the SVM machine");
+      break;
+  }
+}
+#else
+ccl_device_noinline void svm_eval_nodes(KernelGlobals *kg,
+                                        ShaderData *sd,
+                                        ccl_addr_space PathState *state,
+                                        ccl_global float *buffer,
+                                        ShaderType type,
+                                        int path_flag)
+{
+  svm_eval_nodes_impl(kg, sd, state, buffer, type, path_flag);
+}
+#endif
+
 CCL_NAMESPACE_END
 
 #endif /* __SVM_H__ */
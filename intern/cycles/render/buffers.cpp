@@ -126,6 +126,9 @@ RenderTile::RenderTile()
 
   buffers = NULL;
   stealing_state = NO_STEALING;
+
+  device_num = 0;
+  start_time = 0.0;
 }
 
 /* Render Buffers */
@@ -149,6 +149,11 @@ class RenderTile {
   typedef enum { NO_STEALING = 0, CAN_BE_STOLEN = 1, WAS_STOLEN = 2 } StealingState;
   StealingState stealing_state;
 
+  /* Device rendering the tile and the time it started on it, used to measure the throughput of
+   * the devices for tile stealing. */
+  int device_num;
+  double start_time;
+
   RenderBuffers *buffers;
 
   RenderTile();
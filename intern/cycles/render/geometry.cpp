@@ -229,6 +229,8 @@ void Geometry::compute_bvh(
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
+      bparams.use_compressed_nodes = params->use_bvh_compressed_nodes;
+      bparams.use_curve_primitives = params->use_bvh_curve_primitives;
       bparams.num_motion_triangle_steps = params->num_bvh_time_steps;
       bparams.num_motion_curve_steps = params->num_bvh_time_steps;
       bparams.bvh_type = params->bvh_type;
@@ -1222,6 +1224,8 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
+  bparams.use_compressed_nodes = scene->params.use_bvh_compressed_nodes;
+  bparams.use_curve_primitives = scene->params.use_bvh_curve_primitives;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_curve_steps = scene->params.num_bvh_time_steps;
   bparams.bvh_type = scene->params.bvh_type;
@@ -1229,14 +1233,41 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  const bool has_bvh2_layout = (bparams.bvh_layout == BVH_LAYOUT_BVH2);
+
+  /* The scene BVH is only kept when no geometry BVH was rebuilt. With BVH2, the top level can
+   * then be refit as long as the same objects use the same geometry, only merging again the data
+   * of the modified geometry. */
   const bool can_refit = scene->bvh != nullptr &&
-                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX);
+                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
+                          (has_bvh2_layout && static_cast<BVH2 *>(scene->bvh)->can_refit_instances(
+                                                  scene->geometry, scene->objects)));
   const bool pack_all = scene->bvh == nullptr;
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
     bvh = scene->bvh = BVH::create(bparams, scene->geometry, scene->objects, device);
   }
+  else if (has_bvh2_layout) {
+    BVH2 *bvh2 = static_cast<BVH2 *>(bvh);
+    if (can_refit) {
+      /* Take back the arrays of the last build, they are updated in place. */
+      dscene->bvh_nodes.give_data(bvh2->pack.nodes);
+      dscene->bvh_leaf_nodes.give_data(bvh2->pack.leaf_nodes);
+      dscene->object_node.give_data(bvh2->pack.object_node);
+      dscene->prim_tri_index.give_data(bvh2->pack.prim_tri_index);
+      dscene->prim_tri_verts.give_data(bvh2->pack.prim_tri_verts);
+      dscene->prim_type.give_data(bvh2->pack.prim_type);
+      dscene->prim_visibility.give_data(bvh2->pack.prim_visibility);
+      dscene->prim_index.give_data(bvh2->pack.prim_index);
+      dscene->prim_object.give_data(bvh2->pack.prim_object);
+      dscene->prim_time.give_data(bvh2->pack.prim_time);
+    }
+    else {
+      bvh2->geometry = scene->geometry;
+      bvh2->objects = scene->objects;
+    }
+  }
 
   device->build_bvh(bvh, progress, can_refit);
 
@@ -1244,8 +1275,6 @@ void GeometryManager::device_update_bvh(Device *device,
     return;
   }
 
-  const bool has_bvh2_layout = (bparams.bvh_layout == BVH_LAYOUT_BVH2);
-
   PackedBVH pack;
   if (has_bvh2_layout) {
     pack = std::move(static_cast<BVH2 *>(bvh)->pack);
@@ -1830,6 +1859,12 @@ void GeometryManager::device_update(Device *device,
       }
     });
     device_update_mesh(device, dscene, scene, true, progress);
+
+    if (bvh_layout == BVH_LAYOUT_BVH2) {
+      /* The triangles of the scene BVH were overwritten, it can not be refit. */
+      delete scene->bvh;
+      scene->bvh = nullptr;
+    }
   }
   if (progress.get_cancel()) {
     return;
@@ -2089,6 +2124,38 @@ void GeometryManager::collect_statistics(const Scene *scene, RenderStats *stats)
     stats->mesh.geometry.add_entry(
         NamedSizeEntry(string(geometry->name.c_str()), geometry->get_total_size_in_bytes()));
   }
+
+  const device_vector<int4> &bvh_nodes = scene->dscene.bvh_nodes;
+  const device_vector<int4> &bvh_leaf_nodes = scene->dscene.bvh_leaf_nodes;
+  if (bvh_nodes.size() == 0 && bvh_leaf_nodes.size() == 0) {
+    return;
+  }
+
+  stats->mesh.bvh.add_entry(NamedSizeEntry("Inner nodes", bvh_nodes.memory_size()));
+  stats->mesh.bvh.add_entry(NamedSizeEntry("Leaf nodes", bvh_leaf_nodes.memory_size()));
+
+  /* Walk the BVH2 inner nodes to compare with the size they would have uncompressed. */
+  const int4 *nodes = bvh_nodes.data();
+  size_t num_compressed = 0;
+  for (size_t i = 0; nodes && i < bvh_nodes.size();) {
+    if (nodes[i].x & PATH_RAY_NODE_UNALIGNED) {
+      i += BVH_UNALIGNED_NODE_SIZE;
+    }
+    else if (nodes[i].x & PATH_RAY_NODE_COMPRESSED) {
+      i += BVH_COMPRESSED_NODE_SIZE;
+      num_compressed++;
+    }
+    else {
+      i += BVH_NODE_SIZE;
+    }
+  }
+
+  if (num_compressed) {
+    stats->mesh.bvh_uncompressed_nodes_size = bvh_nodes.memory_size() +
+                                              num_compressed *
+                                                  (BVH_NODE_SIZE - BVH_COMPRESSED_NODE_SIZE) *
+                                                  sizeof(int4);
+  }
 }
 
 CCL_NAMESPACE_END
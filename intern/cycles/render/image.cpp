@@ -77,6 +77,10 @@ const char *name_from_type(ImageDataType type)
       return "nanovdb_float";
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
       return "nanovdb_float3";
+    case IMAGE_DATA_TYPE_NANOVDB_FPN:
+      return "nanovdb_fpn";
+    case IMAGE_DATA_TYPE_NANOVDB_FP16:
+      return "nanovdb_fp16";
     case IMAGE_DATA_NUM_TYPES:
       assert(!"System enumerator type, should never be used");
       return "";
@@ -274,6 +278,11 @@ ImageLoader::ImageLoader()
 {
 }
 
+bool ImageLoader::load_reduced_metadata(ImageMetaData &, const int)
+{
+  return false;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -304,6 +313,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   has_half_images = info.has_half_images;
+  has_nanovdb_compression = info.has_nanovdb_compression;
 }
 
 ImageManager::~ImageManager()
@@ -347,6 +357,11 @@ void ImageManager::load_image_metadata(Image *img)
   metadata = ImageMetaData();
   metadata.colorspace = img->params.colorspace;
 
+  /* No reduced precision NanoVDB grids on OpenCL, use full float instead. */
+  if (!has_nanovdb_compression && img->loader->is_vdb_loader()) {
+    dynamic_cast<VDBImageLoader *>(img->loader)->set_precision(VDBImageLoader::PRECISION_FULL);
+  }
+
   if (img->loader->load_metadata(metadata)) {
     assert(metadata.type != IMAGE_DATA_NUM_TYPES);
   }
@@ -499,10 +514,20 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  if (texture_limit > 0 &&
+      max(max(metadata.width, metadata.height), metadata.depth) > texture_limit) {
+    /* Avoid reading the full resolution pixels if the file has a smaller version. */
+    if (img->loader->load_reduced_metadata(metadata, texture_limit)) {
+      VLOG(1) << "Loading image " << img->loader->name() << " at reduced resolution "
+              << metadata.width << "x" << metadata.height << ".";
+    }
+  }
+
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -529,8 +554,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -762,7 +786,7 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
     }
   }
 #ifdef WITH_NANOVDB
-  else if (type == IMAGE_DATA_TYPE_NANOVDB_FLOAT || type == IMAGE_DATA_TYPE_NANOVDB_FLOAT3) {
+  else if (is_nanovdb_type(type)) {
     thread_scoped_lock device_lock(device_mutex);
     void *pixels = img->mem->alloc(img->metadata.byte_size, 0);
 
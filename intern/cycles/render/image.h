@@ -113,6 +113,12 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional, select a lower resolution version of the image stored in the file (for example
+   * a MIP level of a tiled texture) no larger than max_size, so that it can be loaded without
+   * reading and scaling down the full resolution pixels. Updates the metadata dimensions to the
+   * ones of the selected version, used by the following load_pixels calls. */
+  virtual bool load_reduced_metadata(ImageMetaData &metadata, const int max_size);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
@@ -213,6 +219,7 @@ class ImageManager {
  private:
   bool need_update_;
   bool has_half_images;
+  bool has_nanovdb_compression;
 
   thread_mutex device_mutex;
   thread_mutex images_mutex;
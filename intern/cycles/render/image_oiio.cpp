@@ -22,7 +22,7 @@
 
 CCL_NAMESPACE_BEGIN
 
-OIIOImageLoader::OIIOImageLoader(const string &filepath) : filepath(filepath)
+OIIOImageLoader::OIIOImageLoader(const string &filepath) : filepath(filepath), miplevel(0)
 {
 }
 
@@ -192,6 +192,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (miplevel > 0 && !in->seek_subimage(0, miplevel, spec)) {
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -211,6 +215,8 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
       break;
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
+    case IMAGE_DATA_TYPE_NANOVDB_FPN:
+    case IMAGE_DATA_TYPE_NANOVDB_FP16:
     case IMAGE_DATA_NUM_TYPES:
       break;
   }
@@ -219,6 +225,47 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   return true;
 }
 
+bool OIIOImageLoader::load_reduced_metadata(ImageMetaData &metadata, const int max_size)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Find the largest MIP level fitting in the limit, or the smallest one stored in the file.
+   * Any remaining scaling is done by the image manager. */
+  int level = 0;
+  ImageSpec level_spec;
+  while (max(max(spec.width, spec.height), spec.depth) > max_size &&
+         in->seek_subimage(0, level + 1, level_spec)) {
+    spec = level_spec;
+    level++;
+  }
+
+  in->close();
+
+  if (level == 0 || spec.nchannels != metadata.channels) {
+    return false;
+  }
+
+  miplevel = level;
+  metadata.width = spec.width;
+  metadata.height = spec.height;
+  metadata.depth = spec.depth;
+
+  return true;
+}
+
+void OIIOImageLoader::cleanup()
+{
+  miplevel = 0;
+}
+
 string OIIOImageLoader::name() const
 {
   return path_filename(filepath.string());
@@ -33,14 +33,20 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  bool load_reduced_metadata(ImageMetaData &metadata, const int max_size) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
 
+  void cleanup() override;
+
   bool equals(const ImageLoader &other) const override;
 
  protected:
   ustring filepath;
+  /* MIP level to load the pixels from, selected by load_reduced_metadata. */
+  int miplevel;
 };
 
 CCL_NAMESPACE_END
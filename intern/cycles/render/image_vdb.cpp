@@ -26,7 +26,26 @@
 
 CCL_NAMESPACE_BEGIN
 
-VDBImageLoader::VDBImageLoader(const string &grid_name) : grid_name(grid_name)
+#if defined(WITH_OPENVDB) && defined(WITH_NANOVDB)
+static nanovdb::GridHandle<> nanovdb_from_float_grid(const openvdb::FloatGrid &grid,
+                                                     const VDBImageLoader::Precision precision)
+{
+  switch (precision) {
+    case VDBImageLoader::PRECISION_HALF:
+      return nanovdb::openToNanoVDB<nanovdb::HostBuffer, openvdb::FloatTree, nanovdb::Fp16>(
+          grid);
+    case VDBImageLoader::PRECISION_VARIABLE:
+      return nanovdb::openToNanoVDB<nanovdb::HostBuffer, openvdb::FloatTree, nanovdb::FpN>(
+          grid);
+    case VDBImageLoader::PRECISION_FULL:
+      break;
+  }
+  return nanovdb::openToNanoVDB(grid);
+}
+#endif
+
+VDBImageLoader::VDBImageLoader(const string &grid_name)
+    : grid_name(grid_name), precision(PRECISION_FULL)
 {
 }
 
@@ -56,7 +75,8 @@ bool VDBImageLoader::load_metadata(ImageMetaData &metadata)
   if (grid->isType<openvdb::FloatGrid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    nanogrid = nanovdb::openToNanoVDB(*openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid));
+    nanogrid = nanovdb_from_float_grid(*openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid),
+                                       precision);
 #  endif
   }
   else if (grid->isType<openvdb::Vec3fGrid>()) {
@@ -68,29 +88,29 @@ bool VDBImageLoader::load_metadata(ImageMetaData &metadata)
   else if (grid->isType<openvdb::BoolGrid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    nanogrid = nanovdb::openToNanoVDB(
-        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::BoolGrid>(grid)));
+    nanogrid = nanovdb_from_float_grid(
+        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::BoolGrid>(grid)), precision);
 #  endif
   }
   else if (grid->isType<openvdb::DoubleGrid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    nanogrid = nanovdb::openToNanoVDB(
-        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::DoubleGrid>(grid)));
+    nanogrid = nanovdb_from_float_grid(
+        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::DoubleGrid>(grid)), precision);
 #  endif
   }
   else if (grid->isType<openvdb::Int32Grid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    nanogrid = nanovdb::openToNanoVDB(
-        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::Int32Grid>(grid)));
+    nanogrid = nanovdb_from_float_grid(
+        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::Int32Grid>(grid)), precision);
 #  endif
   }
   else if (grid->isType<openvdb::Int64Grid>()) {
     metadata.channels = 1;
 #  ifdef WITH_NANOVDB
-    nanogrid = nanovdb::openToNanoVDB(
-        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::Int64Grid>(grid)));
+    nanogrid = nanovdb_from_float_grid(
+        openvdb::FloatGrid(*openvdb::gridConstPtrCast<openvdb::Int64Grid>(grid)), precision);
 #  endif
   }
   else if (grid->isType<openvdb::Vec3IGrid>()) {
@@ -120,7 +140,15 @@ bool VDBImageLoader::load_metadata(ImageMetaData &metadata)
 #  ifdef WITH_NANOVDB
   metadata.byte_size = nanogrid.size();
   if (metadata.channels == 1) {
-    metadata.type = IMAGE_DATA_TYPE_NANOVDB_FLOAT;
+    if (precision == PRECISION_HALF) {
+      metadata.type = IMAGE_DATA_TYPE_NANOVDB_FP16;
+    }
+    else if (precision == PRECISION_VARIABLE) {
+      metadata.type = IMAGE_DATA_TYPE_NANOVDB_FPN;
+    }
+    else {
+      metadata.type = IMAGE_DATA_TYPE_NANOVDB_FLOAT;
+    }
   }
   else {
     metadata.type = IMAGE_DATA_TYPE_NANOVDB_FLOAT3;
@@ -223,7 +251,7 @@ bool VDBImageLoader::equals(const ImageLoader &other) const
 {
 #ifdef WITH_OPENVDB
   const VDBImageLoader &other_loader = (const VDBImageLoader &)other;
-  return grid == other_loader.grid;
+  return grid == other_loader.grid && precision == other_loader.precision;
 #else
   (void)other;
   return true;
@@ -246,6 +274,11 @@ bool VDBImageLoader::is_vdb_loader() const
   return true;
 }
 
+void VDBImageLoader::set_precision(const Precision precision)
+{
+  this->precision = precision;
+}
+
 #ifdef WITH_OPENVDB
 openvdb::GridBase::ConstPtr VDBImageLoader::get_grid()
 {
@@ -30,6 +30,15 @@ CCL_NAMESPACE_BEGIN
 
 class VDBImageLoader : public ImageLoader {
  public:
+  /* Precision of the scalar grids on the device. Reduced precisions quantize the voxel values
+   * of the NanoVDB leaf nodes, either to 16 bit or to the smallest bit width that keeps the
+   * error within a tolerance. */
+  enum Precision {
+    PRECISION_FULL = 0,
+    PRECISION_HALF = 1,
+    PRECISION_VARIABLE = 2,
+  };
+
   VDBImageLoader(const string &grid_name);
   ~VDBImageLoader();
 
@@ -48,12 +57,16 @@ class VDBImageLoader : public ImageLoader {
 
   virtual bool is_vdb_loader() const override;
 
+  /* Reduced precisions are only used with NanoVDB, and ignored for vector grids. */
+  void set_precision(const Precision precision);
+
 #ifdef WITH_OPENVDB
   openvdb::GridBase::ConstPtr get_grid();
 #endif
 
  protected:
   string grid_name;
+  Precision precision;
 #ifdef WITH_OPENVDB
   openvdb::GridBase::ConstPtr grid;
   openvdb::CoordBBox bbox;
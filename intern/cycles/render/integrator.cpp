@@ -81,6 +81,7 @@ NODE_DEFINE(Integrator)
   SOCKET_BOOLEAN(sample_all_lights_direct, "Sample All Lights Direct", true);
   SOCKET_BOOLEAN(sample_all_lights_indirect, "Sample All Lights Indirect", true);
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
 
   static NodeEnum method_enum;
   method_enum.insert("path", PATH);
@@ -315,6 +316,12 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
     }
   }
 
+  if (use_light_tree_is_modified() || method_is_modified() ||
+      sample_all_lights_direct_is_modified() || sample_all_lights_indirect_is_modified()) {
+    /* The light tree is only built when usable with the integrator settings. */
+    scene->light_manager->tag_update(scene, LightManager::INTEGRATOR_MODIFIED);
+  }
+
   if (motion_blur_is_modified()) {
     scene->object_manager->tag_update(scene, ObjectManager::MOTION_BLUR_MODIFIED);
     scene->camera->tag_modified();
@@ -20,6 +20,7 @@
 #include "render/film.h"
 #include "render/graph.h"
 #include "render/integrator.h"
+#include "render/light_tree.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/object.h"
@@ -282,6 +283,60 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* The light tree picks emitters depending on the shading point, which does not work with
+ * sampling lamps and mesh lights separately in the branched path integrator. */
+static bool light_tree_enabled(Scene *scene)
+{
+  const Integrator *integrator = scene->integrator;
+  if (!integrator->get_use_light_tree()) {
+    return false;
+  }
+
+  return !(integrator->get_method() == Integrator::BRANCHED_PATH &&
+           (integrator->get_sample_all_lights_direct() ||
+            integrator->get_sample_all_lights_indirect()));
+}
+
+static LightTreeEmitter light_tree_lamp_emitter(const Light *light, int index)
+{
+  LightTreeEmitter emitter;
+  emitter.normal = make_float3(0.0f, 0.0f, 0.0f);
+  emitter.weight = 0.0f;
+  emitter.index = index;
+  emitter.is_infinite = (light->get_light_type() == LIGHT_DISTANT ||
+                         light->get_light_type() == LIGHT_BACKGROUND);
+
+  const float3 co = light->get_co();
+  float3 extent;
+  if (light->get_light_type() == LIGHT_AREA) {
+    extent = 0.5f * (fabs(light->get_axisu() * (light->get_sizeu() * light->get_size())) +
+                     fabs(light->get_axisv() * (light->get_sizev() * light->get_size())));
+  }
+  else {
+    extent = make_float3(light->get_size(), light->get_size(), light->get_size());
+  }
+  emitter.bounds = BoundBox(co - extent, co + extent);
+
+  return emitter;
+}
+
+static LightTreeEmitter light_tree_triangle_emitter(const float3 p1,
+                                                    const float3 p2,
+                                                    const float3 p3,
+                                                    int index)
+{
+  LightTreeEmitter emitter;
+  emitter.bounds = BoundBox::empty;
+  emitter.bounds.grow(p1);
+  emitter.bounds.grow(p2);
+  emitter.bounds.grow(p3);
+  emitter.normal = safe_normalize(cross(p2 - p1, p3 - p1));
+  emitter.weight = 0.0f;
+  emitter.index = index;
+  emitter.is_infinite = false;
+  return emitter;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -332,6 +387,18 @@ void LightManager::device_update_distribution(Device *,
   size_t num_distribution = num_triangles + num_lights;
   VLOG(1) << "Total " << num_distribution << " of light distribution primitives.";
 
+  /* Light tree emitters, along with the lookup from lamps and triangles to their entry in the
+   * light distribution. The lookup starts with one entry per lamp, followed by two per object
+   * with the offset of its triangles in the lookup and its primitive offset. */
+  const bool use_light_tree = light_tree_enabled(scene);
+  vector<LightTreeEmitter> tree_emitters;
+  vector<int> tree_lookup;
+
+  if (use_light_tree) {
+    tree_emitters.reserve(num_distribution);
+    tree_lookup.resize(num_lights + scene->objects.size() * 2, -1);
+  }
+
   /* emission area */
   KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
   float totarea = 0.0f;
@@ -373,6 +440,14 @@ void LightManager::device_update_distribution(Device *,
     }
 
     size_t mesh_num_triangles = mesh->num_triangles();
+    size_t triangles_lookup = 0;
+    if (use_light_tree) {
+      triangles_lookup = tree_lookup.size();
+      tree_lookup[num_lights + object_id * 2] = triangles_lookup;
+      tree_lookup[num_lights + object_id * 2 + 1] = mesh->prim_offset;
+      tree_lookup.resize(triangles_lookup + mesh_num_triangles, -1);
+    }
+
     for (size_t i = 0; i < mesh_num_triangles; i++) {
       int shader_index = mesh->get_shader()[i];
       Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
@@ -380,6 +455,10 @@ void LightManager::device_update_distribution(Device *,
                            scene->default_surface;
 
       if (shader->get_use_mis() && shader->has_surface_emission) {
+        if (use_light_tree) {
+          tree_lookup[triangles_lookup + i] = offset;
+        }
+
         distribution[offset].totarea = totarea;
         distribution[offset].prim = i + mesh->prim_offset;
         distribution[offset].mesh_light.shader_flag = shader_flag;
@@ -401,6 +480,10 @@ void LightManager::device_update_distribution(Device *,
         }
 
         totarea += triangle_area(p1, p2, p3);
+
+        if (use_light_tree) {
+          tree_emitters.push_back(light_tree_triangle_emitter(p1, p2, p3, offset - 1));
+        }
       }
     }
 
@@ -424,6 +507,11 @@ void LightManager::device_update_distribution(Device *,
     distribution[offset].lamp.size = light->size;
     totarea += lightarea;
 
+    if (use_light_tree) {
+      tree_lookup[light_index] = offset;
+      tree_emitters.push_back(light_tree_lamp_emitter(light, offset));
+    }
+
     if (light->light_type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
     }
@@ -501,6 +589,44 @@ void LightManager::device_update_distribution(Device *,
     /* CDF */
     dscene->light_distribution.copy_to_device();
 
+    /* Light tree */
+    kintegrator->use_light_tree = use_light_tree;
+
+    if (use_light_tree) {
+      foreach (LightTreeEmitter &emitter, tree_emitters) {
+        emitter.weight = distribution[emitter.index + 1].totarea -
+                         distribution[emitter.index].totarea;
+      }
+
+      LightTree light_tree(tree_emitters, num_distribution);
+
+      /* Point the lookup to the leaves instead of the distribution entries. */
+      const size_t objects_lookup_end = num_lights + scene->objects.size() * 2;
+      for (size_t i = 0; i < tree_lookup.size(); i++) {
+        const bool is_object_entry = (i >= num_lights && i < objects_lookup_end);
+        if (!is_object_entry && tree_lookup[i] != -1) {
+          tree_lookup[i] = light_tree.leaf_of_emitter[tree_lookup[i]];
+        }
+      }
+
+      kintegrator->light_tree_num_infinite = light_tree.num_infinite;
+      kintegrator->light_tree_infinite_offset = light_tree.emitters.size() -
+                                                light_tree.num_infinite;
+      kintegrator->light_tree_local_weight = light_tree.local_weight;
+
+      KernelLightTreeNode *nodes = dscene->light_tree_nodes.alloc(light_tree.nodes.size());
+      memcpy(
+          nodes, light_tree.nodes.data(), sizeof(KernelLightTreeNode) * light_tree.nodes.size());
+      uint *emitters = dscene->light_tree_emitters.alloc(light_tree.emitters.size());
+      memcpy(emitters, light_tree.emitters.data(), sizeof(uint) * light_tree.emitters.size());
+      int *lookup = dscene->light_tree_lookup.alloc(tree_lookup.size());
+      memcpy(lookup, tree_lookup.data(), sizeof(int) * tree_lookup.size());
+
+      dscene->light_tree_nodes.copy_to_device();
+      dscene->light_tree_emitters.copy_to_device();
+      dscene->light_tree_lookup.copy_to_device();
+    }
+
     /* Portals */
     if (num_portals > 0) {
       kbackground->portal_offset = light_index;
@@ -520,6 +646,7 @@ void LightManager::device_update_distribution(Device *,
     dscene->light_distribution.free();
 
     kintegrator->num_distribution = 0;
+    kintegrator->use_light_tree = false;
     kintegrator->num_all_lights = 0;
     kintegrator->pdf_triangles = 0.0f;
     kintegrator->pdf_lights = 0.0f;
@@ -1013,6 +1140,9 @@ void LightManager::device_update(Device *device,
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
   dscene->light_distribution.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_tree_lookup.free();
   dscene->lights.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
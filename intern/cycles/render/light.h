@@ -100,6 +100,7 @@ class LightManager {
     OBJECT_MANAGER = (1 << 5),
     SHADER_COMPILED = (1 << 6),
     SHADER_MODIFIED = (1 << 7),
+    INTEGRATOR_MODIFIED = (1 << 8),
 
     /* tag everything in the manager for an update */
     UPDATE_ALL = ~0u,
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/light_tree.h"
+
+#include "util/util_algorithm.h"
+#include "util/util_foreach.h"
+#include "util/util_logging.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+LightTree::LightTree(vector<LightTreeEmitter> &tree_emitters, const size_t num_distribution)
+    : num_infinite(0), local_weight(0.0f)
+{
+  /* Move infinite emitters to the end, they are not part of the hierarchy. */
+  vector<LightTreeEmitter>::iterator infinite_begin = std::stable_partition(
+      tree_emitters.begin(), tree_emitters.end(), [](const LightTreeEmitter &emitter) {
+        return !emitter.is_infinite;
+      });
+
+  const int num_local = infinite_begin - tree_emitters.begin();
+  num_infinite = tree_emitters.size() - num_local;
+
+  leaf_of_emitter.resize(num_distribution, -1);
+
+  if (num_local > 0) {
+    build_node(tree_emitters, 0, num_local, -1);
+    local_weight = (num_infinite > 0) ? nodes[0].energy : 1.0f;
+  }
+  else {
+    /* Empty root, never traversed since the local weight is zero. */
+    nodes.push_back(KernelLightTreeNode());
+  }
+
+  emitters.reserve(tree_emitters.size());
+  foreach (const LightTreeEmitter &emitter, tree_emitters) {
+    emitters.push_back(emitter.index);
+  }
+
+  VLOG(1) << "Light tree: " << nodes.size() << " nodes for " << num_local
+          << " emitters, and " << num_infinite << " infinite emitters.";
+}
+
+int LightTree::build_node(vector<LightTreeEmitter> &tree_emitters,
+                          int first,
+                          int num,
+                          int parent)
+{
+  const int node_index = nodes.size();
+  nodes.push_back(KernelLightTreeNode());
+
+  /* Bounds, energy and orientation of the emitters. */
+  BoundBox bounds = BoundBox::empty;
+  BoundBox centroid_bounds = BoundBox::empty;
+  double energy = 0.0;
+  float3 reference_normal = make_float3(0.0f, 0.0f, 0.0f);
+  float3 axis = make_float3(0.0f, 0.0f, 0.0f);
+  bool has_orientation = true;
+
+  for (int i = first; i < first + num; i++) {
+    const LightTreeEmitter &emitter = tree_emitters[i];
+    bounds.grow(emitter.bounds);
+    centroid_bounds.grow(emitter.bounds.center());
+    energy += emitter.weight;
+
+    if (is_zero(emitter.normal)) {
+      has_orientation = false;
+    }
+    else if (has_orientation) {
+      /* Emitters are two-sided, align the normals to a common hemisphere. */
+      if (is_zero(reference_normal)) {
+        reference_normal = emitter.normal;
+      }
+      axis += (dot(emitter.normal, reference_normal) < 0.0f) ? -emitter.normal : emitter.normal;
+    }
+  }
+
+  float cos_theta_o = -1.0f;
+  if (has_orientation && len_squared(axis) > 1e-12f) {
+    axis = normalize(axis);
+    cos_theta_o = 1.0f;
+    for (int i = first; i < first + num; i++) {
+      cos_theta_o = min(cos_theta_o, fabsf(dot(axis, tree_emitters[i].normal)));
+    }
+  }
+  else {
+    axis = make_float3(0.0f, 0.0f, 1.0f);
+  }
+
+  KernelLightTreeNode &knode = nodes[node_index];
+  knode.bbox_min[0] = bounds.min.x;
+  knode.bbox_min[1] = bounds.min.y;
+  knode.bbox_min[2] = bounds.min.z;
+  knode.bbox_max[0] = bounds.max.x;
+  knode.bbox_max[1] = bounds.max.y;
+  knode.bbox_max[2] = bounds.max.z;
+  knode.energy = (float)energy;
+  knode.cos_theta_o = cos_theta_o;
+  knode.axis[0] = axis.x;
+  knode.axis[1] = axis.y;
+  knode.axis[2] = axis.z;
+  knode.parent = parent;
+  knode.second_child = -1;
+  knode.first_emitter = first;
+  knode.num_emitters = num;
+  knode.pad = 0;
+
+  if (num <= MAX_LEAF_SIZE) {
+    for (int i = first; i < first + num; i++) {
+      leaf_of_emitter[tree_emitters[i].index] = node_index;
+    }
+    return node_index;
+  }
+
+  /* Split at the median centroid along the largest axis. Splitting by count keeps the tree
+   * balanced even when many emitters share the same location. */
+  const float3 size = centroid_bounds.size();
+  const int split_axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z) ? 1 : 2;
+  const int middle = first + num / 2;
+
+  std::nth_element(tree_emitters.begin() + first,
+                   tree_emitters.begin() + middle,
+                   tree_emitters.begin() + first + num,
+                   [split_axis](const LightTreeEmitter &a, const LightTreeEmitter &b) {
+                     return a.bounds.center()[split_axis] < b.bounds.center()[split_axis];
+                   });
+
+  build_node(tree_emitters, first, middle - first, node_index);
+  const int second_child = build_node(tree_emitters, middle, first + num - middle, node_index);
+
+  /* The nodes array may have been reallocated while building the children. */
+  nodes[node_index].second_child = second_child;
+  nodes[node_index].first_emitter = 0;
+  nodes[node_index].num_emitters = 0;
+
+  return node_index;
+}
+
+CCL_NAMESPACE_END
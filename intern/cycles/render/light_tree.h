@@ -0,0 +1,71 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/kernel_types.h"
+
+#include "util/util_boundbox.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree Emitter
+ *
+ * Entry of the light distribution to be placed in the tree. */
+struct LightTreeEmitter {
+  BoundBox bounds;
+  /* Zero for emitters without orientation. */
+  float3 normal;
+  /* Flat distribution probability. */
+  float weight;
+  /* Index in the light distribution. */
+  int index;
+  /* Distant and background lights, sampled outside of the tree. */
+  bool is_infinite;
+};
+
+/* Light Tree
+ *
+ * Binary hierarchy over the emitters, split at the median of their centroids along the
+ * largest axis. Built on the host, traversed by kernel_light_tree.h. */
+class LightTree {
+ public:
+  /* Leaves contain at most this many emitters. */
+  static const int MAX_LEAF_SIZE = 4;
+
+  LightTree(vector<LightTreeEmitter> &emitters, const size_t num_distribution);
+
+  /* Nodes in depth first order, the root is the first one. */
+  vector<KernelLightTreeNode> nodes;
+  /* Distribution index of the emitters, local emitters in leaf order followed by the
+   * infinite ones. */
+  vector<uint> emitters;
+  int num_infinite;
+  /* Sum of the weights of the emitters in the tree. */
+  float local_weight;
+  /* Leaf containing each distribution entry, -1 for infinite emitters. */
+  vector<int> leaf_of_emitter;
+
+ protected:
+  int build_node(vector<LightTreeEmitter> &emitters, int first, int num, int parent);
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
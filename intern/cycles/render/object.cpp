@@ -340,8 +340,7 @@ float Object::compute_volume_step_size() const
           float3 size = make_float3(1.0f, 1.0f, 1.0f);
 #ifdef WITH_NANOVDB
           /* Dimensions were not applied to image transform with NanOVDB (see image_vdb.cpp) */
-          if (metadata.type != IMAGE_DATA_TYPE_NANOVDB_FLOAT &&
-              metadata.type != IMAGE_DATA_TYPE_NANOVDB_FLOAT3)
+          if (!is_nanovdb_type(metadata.type))
 #endif
             size /= make_float3(metadata.width, metadata.height, metadata.depth);
 
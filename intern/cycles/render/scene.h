@@ -116,6 +116,9 @@ class DeviceScene {
   device_vector<KernelLight> lights;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<uint> light_tree_emitters;
+  device_vector<int> light_tree_lookup;
 
   /* particles */
   device_vector<KernelParticle> particles;
@@ -175,6 +178,8 @@ class SceneParams {
   BVHType bvh_type;
   bool use_bvh_spatial_split;
   bool use_bvh_unaligned_nodes;
+  bool use_bvh_compressed_nodes;
+  bool use_bvh_curve_primitives;
   int num_bvh_time_steps;
   int hair_subdivisions;
   CurveShapeType hair_shape;
@@ -190,6 +195,8 @@ class SceneParams {
     bvh_type = BVH_DYNAMIC;
     use_bvh_spatial_split = false;
     use_bvh_unaligned_nodes = true;
+    use_bvh_compressed_nodes = false;
+    use_bvh_curve_primitives = false;
     num_bvh_time_steps = 0;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
@@ -204,6 +211,8 @@ class SceneParams {
              bvh_type == params.bvh_type &&
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
+             use_bvh_compressed_nodes == params.use_bvh_compressed_nodes &&
+             use_bvh_curve_primitives == params.use_bvh_curve_primitives &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
              persistent_data == params.persistent_data && texture_limit == params.texture_limit);
@@ -29,6 +29,7 @@
 #include "render/scene.h"
 #include "render/session.h"
 
+#include "util/util_algorithm.h"
 #include "util/util_foreach.h"
 #include "util/util_function.h"
 #include "util/util_logging.h"
@@ -387,35 +388,74 @@ bool Session::draw_cpu(BufferParams &buffer_params, DeviceDrawParams &draw_param
   return false;
 }
 
+/* Only steal tiles from devices that are this much slower, to compensate for the cost of
+ * moving the tile buffer to the other device. */
+#define TILE_STEAL_MIN_SPEEDUP 1.25
+
+int Session::num_stealable_tiles(int device_num)
+{
+  const double throughput = tile_throughput[device_num];
+  int num_tiles = 0;
+
+  for (int i = 0; i < stealable_tiles.size(); i++) {
+    /* Devices that did not finish a tile yet are assumed to be the slowest. */
+    if (i != device_num && throughput > tile_throughput[i] * TILE_STEAL_MIN_SPEEDUP) {
+      num_tiles += stealable_tiles[i];
+    }
+  }
+
+  return num_tiles;
+}
+
+void Session::update_tile_throughput(const RenderTile &rtile)
+{
+  const int num_samples = rtile.sample - rtile.start_sample;
+  const double time = time_dt() - rtile.start_time;
+
+  if (rtile.task == RenderTile::DENOISE || num_samples <= 0 || time <= 0.0) {
+    return;
+  }
+
+  /* Running average, so that the estimate follows changes in the cost of the tiles. */
+  const double throughput = (double)rtile.w * rtile.h * num_samples / time;
+  double &device_throughput = tile_throughput[rtile.device_num];
+  device_throughput = (device_throughput == 0.0) ? throughput :
+                                                   0.75 * device_throughput + 0.25 * throughput;
+}
+
 bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_lock &tile_lock)
 {
-  /* Devices that can get their tiles stolen don't steal tiles themselves.
-   * Additionally, if there are no stealable tiles in flight, give up here. */
-  if (tile_device->info.type == DEVICE_CPU || stealable_tiles == 0) {
+  const int device_num = device->device_number(tile_device);
+
+  /* If there are no stealable tiles in flight on slower devices, give up here. */
+  if (num_stealable_tiles(device_num) == 0) {
     return false;
   }
 
   /* Wait until no other thread is trying to steal a tile. */
-  while (tile_stealing_state != NOT_STEALING && stealable_tiles > 0) {
+  while (tile_stealing_state != NOT_STEALING && num_stealable_tiles(device_num) > 0) {
     /* Someone else is currently trying to get a tile.
      * Wait on the condition variable and try later. */
     tile_steal_cond.wait(tile_lock);
   }
   /* If another thread stole the last stealable tile in the meantime, give up. */
-  if (stealable_tiles == 0) {
+  if (num_stealable_tiles(device_num) == 0) {
     return false;
   }
 
   /* There are stealable tiles in flight, so signal that one should be released. */
+  stealing_device_num = device_num;
   tile_stealing_state = WAITING_FOR_TILE;
 
   /* Wait until a device notices the signal and releases its tile. */
-  while (tile_stealing_state != GOT_TILE && stealable_tiles > 0) {
+  while (tile_stealing_state != GOT_TILE && num_stealable_tiles(device_num) > 0) {
     tile_steal_cond.wait(tile_lock);
   }
   /* If the last stealable tile finished on its own, give up. */
   if (tile_stealing_state != GOT_TILE) {
     tile_stealing_state = NOT_STEALING;
+    /* Poke any threads which might be waiting for NOT_STEALING above. */
+    tile_steal_cond.notify_one();
     return false;
   }
 
@@ -426,6 +466,8 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
   rtile.stealing_state = RenderTile::NO_STEALING;
   rtile.num_samples -= (rtile.sample - rtile.start_sample);
   rtile.start_sample = rtile.sample;
+  rtile.device_num = device_num;
+  rtile.start_time = time_dt();
 
   tile_stealing_state = NOT_STEALING;
 
@@ -435,12 +477,23 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
   return true;
 }
 
-bool Session::get_tile_stolen()
+bool Session::get_tile_stolen(const RenderTile &rtile)
 {
+  if (tile_stealing_state != WAITING_FOR_TILE) {
+    return false;
+  }
+
+  /* Only release the tile if the waiting device renders faster than this one. */
+  thread_scoped_lock tile_lock(tile_mutex);
+  if (tile_throughput[stealing_device_num] <=
+      tile_throughput[rtile.device_num] * TILE_STEAL_MIN_SPEEDUP) {
+    return false;
+  }
+
   /* If tile_stealing_state is WAITING_FOR_TILE, atomically set it to RELEASING_TILE
    * and return true. */
   TileStealingState expected = WAITING_FOR_TILE;
-  return tile_stealing_state.compare_exchange_weak(expected, RELEASING_TILE);
+  return tile_stealing_state.compare_exchange_strong(expected, RELEASING_TILE);
 }
 
 bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_types)
@@ -458,6 +511,11 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   Tile *tile;
   int device_num = device->device_number(tile_device);
 
+  if (device_num >= stealable_tiles.size()) {
+    stealable_tiles.resize(device_num + 1, 0);
+    tile_throughput.resize(device_num + 1, 0.0);
+  }
+
   while (!tile_manager.next_tile(tile, device_num, tile_types)) {
     /* Can only steal tiles on devices that support rendering
      * This is because denoising tiles cannot be stolen (see below)
@@ -486,13 +544,18 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   rtile.resolution = tile_manager.state.resolution_divider;
   rtile.tile_index = tile->index;
   rtile.stealing_state = RenderTile::NO_STEALING;
+  rtile.device_num = device_num;
+  rtile.start_time = time_dt();
 
   if (tile->state == Tile::DENOISE) {
     rtile.task = RenderTile::DENOISE;
   }
   else {
-    if (tile_device->info.type == DEVICE_CPU) {
-      stealable_tiles++;
+    /* Devices that check for stealing while rendering. CUDA tiles are only moved when each
+     * tile has its own buffer. */
+    if (tile_device->info.type == DEVICE_CPU ||
+        (tile_device->info.type == DEVICE_CUDA && buffers == NULL)) {
+      stealable_tiles[device_num]++;
       rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
     }
 
@@ -596,8 +659,10 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
+  update_tile_throughput(rtile);
+
   if (rtile.stealing_state != RenderTile::NO_STEALING) {
-    stealable_tiles--;
+    stealable_tiles[rtile.device_num]--;
     if (rtile.stealing_state == RenderTile::WAS_STOLEN) {
       /* If the tile is being stolen, don't release it here - the new device will pick up where
        * the old one left off. */
@@ -610,8 +675,8 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
       tile_steal_cond.notify_all();
       return;
     }
-    else if (stealable_tiles == 0) {
-      /* If this was the last stealable tile, wake up any threads still waiting for one. */
+    else {
+      /* This may have been the last tile a waiting thread can steal, wake it up. */
       tile_steal_cond.notify_all();
     }
   }
@@ -923,7 +988,9 @@ void Session::reset_(BufferParams &buffer_params, int samples)
   }
 
   tile_manager.reset(buffer_params, samples);
-  stealable_tiles = 0;
+  std::fill(stealable_tiles.begin(), stealable_tiles.end(), 0);
+  std::fill(tile_throughput.begin(), tile_throughput.end(), 0.0);
+  stealing_device_num = 0;
   tile_stealing_state = NOT_STEALING;
   progress.reset_sample();
 
@@ -1010,6 +1077,15 @@ void Session::set_denoising_start_sample(int sample)
   }
 }
 
+void Session::set_denoising_update_interval(float interval)
+{
+  if (interval != params.denoising.update_interval) {
+    params.denoising.update_interval = interval;
+
+    pause_cond.notify_all();
+  }
+}
+
 void Session::wait()
 {
   if (session_thread) {
@@ -1148,9 +1224,17 @@ bool Session::render_need_denoise(bool &delayed)
     return false;
   }
 
-  /* Avoid excessive denoising in viewport after reaching a certain amount of samples. */
-  delayed = (tile_manager.state.sample >= 20 &&
-             (time_dt() - last_display_time) < params.progressive_update_timeout);
+  /* Avoid excessive denoising in viewport after reaching a certain amount of samples, or more
+   * often than the requested interval. Samples rendered in between are not displayed, so the
+   * device spends its time rendering instead of denoising every update. */
+  const float update_interval = params.denoising.update_interval;
+  if (update_interval > 0.0f) {
+    delayed = (time_dt() - last_display_time) < update_interval;
+  }
+  else {
+    delayed = (tile_manager.state.sample >= 20 &&
+               (time_dt() - last_display_time) < params.progressive_update_timeout);
+  }
   return !delayed;
 }
 
@@ -1175,7 +1259,7 @@ void Session::render(bool need_denoise)
   task.get_cancel = function_bind(&Progress::get_cancel, &this->progress);
   task.update_tile_sample = function_bind(&Session::update_tile_sample, this, _1);
   task.update_progress_sample = function_bind(&Progress::add_samples, &this->progress, _1, _2);
-  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this);
+  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this, _1);
   task.need_finish_queue = params.progressive_refine;
   task.integrator_branched = scene->integrator->get_method() == Integrator::BRANCHED_PATH;
 
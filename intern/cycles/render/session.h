@@ -157,6 +157,7 @@ class Session {
   void set_samples(int samples);
   void set_denoising(const DenoiseParams &denoising);
   void set_denoising_start_sample(int sample);
+  void set_denoising_update_interval(float interval);
 
   bool update_scene();
 
@@ -196,7 +197,9 @@ class Session {
   bool render_need_denoise(bool &delayed);
 
   bool steal_tile(RenderTile &tile, Device *tile_device, thread_scoped_lock &tile_lock);
-  bool get_tile_stolen();
+  bool get_tile_stolen(const RenderTile &tile);
+  int num_stealable_tiles(int device_num);
+  void update_tile_throughput(const RenderTile &tile);
   bool acquire_tile(RenderTile &tile, Device *tile_device, uint tile_types);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile, const bool need_denoise);
@@ -235,7 +238,13 @@ class Session {
     GOT_TILE /* A device has released a stealable tile, which is now stored in stolen_tile. */
   } TileStealingState;
   std::atomic<TileStealingState> tile_stealing_state;
-  int stealable_tiles;
+  /* Number of stealable tiles in flight on each device. */
+  vector<int> stealable_tiles;
+  /* Measured throughput of a single tile on each device, in pixel samples per second. Tiles
+   * are only stolen by devices that render them faster. */
+  vector<double> tile_throughput;
+  /* Device waiting for a tile to be released. */
+  int stealing_device_num;
 
   /* progressive refine */
   bool update_progressive_refine(bool cancel);
@@ -226,7 +226,7 @@ string NamedSampleCountStats::full_report(int indent_level)
 
 /* Mesh statistics. */
 
-MeshStats::MeshStats()
+MeshStats::MeshStats() : bvh_uncompressed_nodes_size(0)
 {
 }
 
@@ -235,6 +235,14 @@ string MeshStats::full_report(int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result = "";
   result += indent + "Geometry:\n" + geometry.full_report(indent_level + 1);
+  if (!bvh.entries.empty()) {
+    result += indent + "BVH:\n" + bvh.full_report(indent_level + 1);
+    if (bvh_uncompressed_nodes_size != 0) {
+      const string double_indent = indent + string(kIndentNumSpaces, ' ');
+      result += double_indent + "Uncompressed nodes would use " +
+                string_human_readable_size(bvh_uncompressed_nodes_size) + "\n";
+    }
+  }
   return result;
 }
 
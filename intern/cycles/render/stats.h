@@ -160,6 +160,11 @@ class MeshStats {
    * memory like BVH.
    */
   NamedSizeStats geometry;
+
+  /* Memory used by the BVH nodes. */
+  NamedSizeStats bvh;
+  /* Size the inner nodes would have without compression, zero when none is compressed. */
+  size_t bvh_uncompressed_nodes_size;
 };
 
 /* Statistics about images held in memory. */
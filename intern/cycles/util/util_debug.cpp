@@ -84,6 +84,7 @@ void DebugFlags::OptiX::reset()
 {
   cuda_streams = 1;
   curves_api = false;
+  bvh_cache = false;
 }
 
 DebugFlags::OpenCL::OpenCL() : device_type(DebugFlags::OpenCL::DEVICE_ALL), debug(false)
@@ -120,7 +121,10 @@ void DebugFlags::OpenCL::reset()
   debug = (getenv("CYCLES_OPENCL_DEBUG") != NULL);
 }
 
-DebugFlags::DebugFlags() : viewport_static_bvh(false), running_inside_blender(false)
+DebugFlags::DebugFlags()
+    : viewport_static_bvh(false),
+      running_inside_blender(false),
+      split_kernel_profile(getenv("CYCLES_SPLIT_KERNEL_PROFILE") != NULL)
 {
   /* Nothing for now. */
 }
@@ -128,6 +132,7 @@ DebugFlags::DebugFlags() : viewport_static_bvh(false), running_inside_blender(fa
 void DebugFlags::reset()
 {
   viewport_static_bvh = false;
+  split_kernel_profile = (getenv("CYCLES_SPLIT_KERNEL_PROFILE") != NULL);
   cpu.reset();
   cuda.reset();
   optix.reset();
@@ -145,11 +150,15 @@ std::ostream &operator<<(std::ostream &os, DebugFlagsConstRef debug_flags)
      << "  BVH layout : " << bvh_layout_name(debug_flags.cpu.bvh_layout) << "\n"
      << "  Split      : " << string_from_bool(debug_flags.cpu.split_kernel) << "\n";
 
+  os << "Split kernel flags:\n"
+     << "  Profile : " << string_from_bool(debug_flags.split_kernel_profile) << "\n";
+
   os << "CUDA flags:\n"
      << "  Adaptive Compile : " << string_from_bool(debug_flags.cuda.adaptive_compile) << "\n";
 
   os << "OptiX flags:\n"
-     << "  CUDA streams : " << debug_flags.optix.cuda_streams << "\n";
+     << "  CUDA streams : " << debug_flags.optix.cuda_streams << "\n"
+     << "  BVH cache    : " << string_from_bool(debug_flags.optix.bvh_cache) << "\n";
 
   const char *opencl_device_type;
   switch (debug_flags.opencl.device_type) {
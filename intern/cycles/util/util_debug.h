@@ -35,6 +35,10 @@ class DebugFlags {
 
   bool running_inside_blender;
 
+  /* Measure the time spent in each stage of the split kernel, and report it to the log when
+   * the device is freed. Set with the CYCLES_SPLIT_KERNEL_PROFILE environment variable. */
+  bool split_kernel_profile;
+
   /* Descriptor of CPU feature-set to be used. */
   struct CPU {
     CPU();
@@ -111,6 +115,10 @@ class DebugFlags {
 
     /* Use OptiX curves API for hair instead of custom implementation. */
     bool curves_api;
+
+    /* Store bottom level acceleration structures on disk, and reuse them for geometry with the
+     * same build input in later sessions. */
+    bool bvh_cache;
   };
 
   /* Descriptor of OpenCL feature-set to be used. */
@@ -59,10 +59,20 @@ typedef enum ImageDataType {
   IMAGE_DATA_TYPE_USHORT = 7,
   IMAGE_DATA_TYPE_NANOVDB_FLOAT = 8,
   IMAGE_DATA_TYPE_NANOVDB_FLOAT3 = 9,
+  IMAGE_DATA_TYPE_NANOVDB_FPN = 10,
+  IMAGE_DATA_TYPE_NANOVDB_FP16 = 11,
 
   IMAGE_DATA_NUM_TYPES
 } ImageDataType;
 
+/* NanoVDB grids are stored as a flat byte buffer and sampled through their tree, instead of
+ * being a dense texture. */
+ccl_device_inline bool is_nanovdb_type(int type)
+{
+  return (type == IMAGE_DATA_TYPE_NANOVDB_FLOAT || type == IMAGE_DATA_TYPE_NANOVDB_FLOAT3 ||
+          type == IMAGE_DATA_TYPE_NANOVDB_FPN || type == IMAGE_DATA_TYPE_NANOVDB_FP16);
+}
+
 /* Alpha types
  * How to treat alpha in images. */
 typedef enum ImageAlphaType {
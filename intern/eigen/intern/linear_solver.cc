@@ -25,6 +25,7 @@
 #include "linear_solver.h"
 
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 
 #include <algorithm>
 #include <cassert>
@@ -36,7 +37,9 @@
 
 typedef Eigen::SparseMatrix<double, Eigen::ColMajor> EigenSparseMatrix;
 typedef Eigen::SparseLU<EigenSparseMatrix> EigenSparseLU;
+typedef Eigen::SimplicialLDLT<EigenSparseMatrix> EigenSparseLDLT;
 typedef Eigen::VectorXd EigenVectorX;
+typedef Eigen::MatrixXd EigenMatrixX;
 typedef Eigen::Triplet<double> EigenTriplet;
 
 /* Linear Solver data structure */
@@ -78,6 +81,7 @@ struct LinearSolver {
     m = 0;
     n = 0;
     sparseLU = NULL;
+    sparseLDLT = NULL;
     num_variables = num_variables_;
     num_rhs = num_rhs_;
     num_rows = num_rows_;
@@ -89,6 +93,7 @@ struct LinearSolver {
   ~LinearSolver()
   {
     delete sparseLU;
+    delete sparseLDLT;
   }
 
   State state;
@@ -102,7 +107,10 @@ struct LinearSolver {
   std::vector<EigenVectorX> b;
   std::vector<EigenVectorX> x;
 
+  /* Only one of these is used: the normal equations of least squares problems are symmetric
+   * positive definite and use the cheaper Cholesky factorization, LU is the fallback. */
   EigenSparseLU *sparseLU;
+  EigenSparseLDLT *sparseLDLT;
 
   int num_variables;
   std::vector<Variable> variable;
@@ -292,18 +300,36 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
     EigenSparseMatrix &M = (solver->least_squares) ? solver->MtM : solver->M;
     M.makeCompressed();
 
+    /* MtM is symmetric positive (semi-)definite, try the Cholesky factorization first which
+     * avoids the pivoting of LU and needs roughly half the memory */
+    if (solver->least_squares) {
+      EigenSparseLDLT *sparseLDLT = new EigenSparseLDLT();
+      sparseLDLT->compute(M);
+
+      if (sparseLDLT->info() == Eigen::Success) {
+        solver->sparseLDLT = sparseLDLT;
+      }
+      else {
+        delete sparseLDLT;
+      }
+    }
+
     /* perform sparse LU factorization */
-    EigenSparseLU *sparseLU = new EigenSparseLU();
-    solver->sparseLU = sparseLU;
+    if (solver->sparseLDLT == NULL) {
+      EigenSparseLU *sparseLU = new EigenSparseLU();
+      solver->sparseLU = sparseLU;
 
-    sparseLU->compute(M);
-    result = (sparseLU->info() == Eigen::Success);
+      sparseLU->compute(M);
+      result = (sparseLU->info() == Eigen::Success);
+    }
 
     solver->state = LinearSolver::STATE_MATRIX_SOLVED;
   }
 
   if (result) {
-    /* solve for each right hand side */
+    /* gather all right hand sides, so they are solved in a single pass over the factors */
+    EigenMatrixX B(solver->least_squares ? solver->n : solver->m, solver->num_rhs);
+
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
       /* modify for locked variables */
       EigenVectorX &b = solver->b[rhs];
@@ -319,19 +345,26 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
         }
       }
 
-      /* solve */
-      if (solver->least_squares) {
-        EigenVectorX Mtb = solver->M.transpose() * b;
-        solver->x[rhs] = solver->sparseLU->solve(Mtb);
-      }
-      else {
-        EigenVectorX &b = solver->b[rhs];
-        solver->x[rhs] = solver->sparseLU->solve(b);
-      }
+      if (solver->least_squares)
+        B.col(rhs) = solver->M.transpose() * b;
+      else
+        B.col(rhs) = b;
+    }
+
+    /* solve */
+    EigenMatrixX X;
 
-      if (solver->sparseLU->info() != Eigen::Success)
-        result = false;
+    if (solver->sparseLDLT) {
+      X = solver->sparseLDLT->solve(B);
+      result = (solver->sparseLDLT->info() == Eigen::Success);
     }
+    else {
+      X = solver->sparseLU->solve(B);
+      result = (solver->sparseLU->info() == Eigen::Success);
+    }
+
+    for (int rhs = 0; rhs < solver->num_rhs; rhs++)
+      solver->x[rhs] = X.col(rhs);
 
     if (result)
       linear_solver_vector_to_variables(solver);
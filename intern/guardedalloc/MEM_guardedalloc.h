@@ -244,6 +244,31 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/* Memory accounting per subsystem.
+ *
+ * Blocks allocated by a thread while a scope is pushed are counted in that scope until they are
+ * freed, from any thread. Scopes are nested per thread, the innermost one counts the blocks.
+ * Tasks running in other threads are not part of the scope of the thread that created them.
+ * Scopes are identified by their name, which has to stay valid for the whole program, and at
+ * most #MEM_SCOPES_MAX of them can be used. Only the lock-free allocator counts memory in
+ * scopes, their statistics stay zero with the guarded allocator. */
+#define MEM_SCOPES_MAX 63
+
+void MEM_scope_push(const char *name);
+void MEM_scope_pop(void);
+
+typedef struct MEM_ScopeStats {
+  const char *name;
+  size_t mem_in_use;
+  size_t peak_mem;
+  /** Total of the sizes of all blocks allocated in the scope, to measure allocation rates. */
+  size_t mem_allocated;
+  unsigned int blocks_in_use;
+} MEM_ScopeStats;
+
+/** Get the statistics of all scopes that were pushed so far, returns their number. */
+int MEM_scope_stats_get(MEM_ScopeStats *r_stats, int stats_num_max);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -89,6 +89,12 @@ size_t malloc_usable_size(void *ptr);
 #  define MEM_INLINE static inline
 #endif
 
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
 #define IS_POW2(a) (((a) & ((a)-1)) == 0)
 
 /* Extra padding which needs to be applied on MemHead to make it aligned. */
@@ -112,6 +118,12 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Memory scopes, see #MEM_scope_push. Index of the scope of the calling thread counting an
+ * allocation, zero when outside of any scope. */
+unsigned int mem_scope_alloc(size_t len);
+void mem_scope_free(unsigned int scope, size_t len);
+void mem_scope_printmemlist_stats(void);
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -21,6 +21,7 @@
  */
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h> /* memcpy */
 #include <sys/types.h>
@@ -43,8 +44,17 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
+/* Uncomment this to count blocks and memory per thread, instead of in counters shared by all
+ * threads which are contended when many threads allocate at the same time. Totals are the sum
+ * of the counters of all threads, the peak memory is only updated when the memory in use of a
+ * thread grew by more than THREAD_PEAK_MEM_STEP since its last update. */
+// #define USE_THREAD_COUNTERS
+
+#ifndef USE_THREAD_COUNTERS
 static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
+static size_t mem_in_use = 0;
+#endif
+static size_t peak_mem = 0;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
@@ -58,6 +68,19 @@ enum {
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
 
+/* The memory scope of a block is stored in the highest bits of its length, which are never used
+ * on 64 bit platforms. Memory is not counted in scopes on 32 bit platforms. */
+#if SIZE_MAX > 0xffffffff
+#  define USE_MEM_SCOPES
+#  define MEMHEAD_SCOPE_SHIFT 58
+#  define MEMHEAD_LEN_MASK (((size_t)1 << MEMHEAD_SCOPE_SHIFT) - 1)
+#  define MEMHEAD_SCOPE(memhead) ((unsigned int)((memhead)->len >> MEMHEAD_SCOPE_SHIFT))
+#  define MEMHEAD_SCOPE_LEN_BITS(len) ((size_t)mem_scope_alloc(len) << MEMHEAD_SCOPE_SHIFT)
+#else
+#  define MEMHEAD_LEN_MASK SIZE_MAX
+#  define MEMHEAD_SCOPE_LEN_BITS(len) ((void)(len), (size_t)0)
+#endif
+
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
 
@@ -70,6 +93,106 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+#ifdef USE_THREAD_COUNTERS
+
+#  define THREAD_PEAK_MEM_STEP ((size_t)1024 * 1024)
+
+typedef struct MemThreadCounters {
+  struct MemThreadCounters *next;
+  /* Wrap around when blocks are freed by other threads than the allocating one,
+   * only the sums of all threads are meaningful. */
+  unsigned int totblock;
+  size_t mem_in_use;
+  /* Memory in use by this thread when the peak memory was last updated. */
+  size_t mem_in_use_peak_checked;
+} MemThreadCounters;
+
+/* Counters of all threads that ever allocated, they are never freed so that blocks allocated by
+ * threads that exited keep being counted. */
+static MemThreadCounters *thread_counters_list = NULL;
+/* Used when the counters of a thread can't be allocated. */
+static MemThreadCounters thread_counters_shared = {NULL};
+static MEM_THREAD_LOCAL MemThreadCounters *thread_counters = NULL;
+
+static MemThreadCounters *thread_counters_get(void)
+{
+  MemThreadCounters *counters = thread_counters;
+  if (LIKELY(counters)) {
+    return counters;
+  }
+
+  counters = (MemThreadCounters *)calloc(1, sizeof(MemThreadCounters));
+  if (counters == NULL) {
+    counters = &thread_counters_shared;
+  }
+  else {
+    MemThreadCounters *head;
+    do {
+      head = thread_counters_list;
+      counters->next = head;
+    } while (atomic_cas_ptr((void **)&thread_counters_list, head, counters) != head);
+  }
+  thread_counters = counters;
+  return counters;
+}
+
+static void thread_counters_sum(size_t *r_mem_in_use, unsigned int *r_totblock)
+{
+  /* Atomic reads, the counters are changed by their own thread meanwhile. */
+  size_t mem_sum = atomic_add_and_fetch_z(&thread_counters_shared.mem_in_use, 0);
+  unsigned int totblock_sum = atomic_add_and_fetch_u(&thread_counters_shared.totblock, 0);
+  for (MemThreadCounters *counters = thread_counters_list; counters; counters = counters->next) {
+    mem_sum += atomic_add_and_fetch_z(&counters->mem_in_use, 0);
+    totblock_sum += atomic_add_and_fetch_u(&counters->totblock, 0);
+  }
+  if (r_mem_in_use) {
+    *r_mem_in_use = mem_sum;
+  }
+  if (r_totblock) {
+    *r_totblock = totblock_sum;
+  }
+}
+
+#endif /* USE_THREAD_COUNTERS */
+
+MEM_INLINE void mem_counters_add(size_t len)
+{
+#ifdef USE_THREAD_COUNTERS
+  /* Atomic operations are still used so that the counters can be summed from any thread, but
+   * the memory they change is not shared with other allocating threads. */
+  MemThreadCounters *counters = thread_counters_get();
+  atomic_add_and_fetch_u(&counters->totblock, 1);
+  const size_t thread_mem = atomic_add_and_fetch_z(&counters->mem_in_use, len);
+  const size_t growth = thread_mem - counters->mem_in_use_peak_checked;
+  if (UNLIKELY(growth > THREAD_PEAK_MEM_STEP && growth < SIZE_MAX / 2)) {
+    counters->mem_in_use_peak_checked = thread_mem;
+    size_t mem_sum;
+    thread_counters_sum(&mem_sum, NULL);
+    update_maximum(&peak_mem, mem_sum);
+  }
+#else
+  atomic_add_and_fetch_u(&totblock, 1);
+  atomic_add_and_fetch_z(&mem_in_use, len);
+  update_maximum(&peak_mem, mem_in_use);
+#endif
+}
+
+MEM_INLINE void mem_counters_sub(size_t len)
+{
+#ifdef USE_THREAD_COUNTERS
+  MemThreadCounters *counters = thread_counters_get();
+  atomic_sub_and_fetch_u(&counters->totblock, 1);
+  const size_t thread_mem = atomic_sub_and_fetch_z(&counters->mem_in_use, len);
+  if (thread_mem - counters->mem_in_use_peak_checked > SIZE_MAX / 2) {
+    /* Measure growth from the lowest use since the last peak update. */
+    counters->mem_in_use_peak_checked = thread_mem;
+  }
+#else
+  atomic_sub_and_fetch_u(&totblock, 1);
+  atomic_sub_and_fetch_z(&mem_in_use, len);
+#endif
+}
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -92,7 +215,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len & MEMHEAD_LEN_MASK & ~((size_t)(MEMHEAD_ALIGN_FLAG));
   }
 
   return 0;
@@ -115,8 +238,12 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_counters_sub(len);
+#ifdef USE_MEM_SCOPES
+  if (UNLIKELY(MEMHEAD_SCOPE(memh) != 0)) {
+    mem_scope_free(MEMHEAD_SCOPE(memh), len);
+  }
+#endif
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -235,17 +362,15 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memh->len = len | MEMHEAD_SCOPE_LEN_BITS(len);
+    mem_counters_add(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -259,7 +384,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)MEM_lockfree_get_memory_in_use());
     abort();
     return NULL;
   }
@@ -280,17 +405,15 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memh->len = len | MEMHEAD_SCOPE_LEN_BITS(len);
+    mem_counters_add(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -304,7 +427,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)MEM_lockfree_get_memory_in_use());
     abort();
     return NULL;
   }
@@ -350,18 +473,16 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG | MEMHEAD_SCOPE_LEN_BITS(len);
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)MEM_lockfree_get_memory_in_use());
   return NULL;
 }
 
@@ -381,8 +502,11 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_memory_in_use() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_peak_memory() / (double)(1024 * 1024));
+  mem_scope_printmemlist_stats();
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -410,22 +534,38 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
+#ifdef USE_THREAD_COUNTERS
+  size_t mem_sum;
+  thread_counters_sum(&mem_sum, NULL);
+  return mem_sum;
+#else
   return mem_in_use;
+#endif
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
+#ifdef USE_THREAD_COUNTERS
+  unsigned int totblock_sum;
+  thread_counters_sum(NULL, &totblock_sum);
+  return totblock_sum;
+#else
   return totblock;
+#endif
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  peak_mem = MEM_lockfree_get_memory_in_use();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
+#ifdef USE_THREAD_COUNTERS
+  /* The peak is only updated by steps, make sure it's at least the current use. */
+  update_maximum(&peak_mem, MEM_lockfree_get_memory_in_use());
+#endif
   return peak_mem;
 }
 
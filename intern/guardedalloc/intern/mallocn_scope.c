@@ -0,0 +1,159 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Memory accounting per subsystem, see #MEM_scope_push.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+/* to ensure strict conversions */
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+#include "atomic_ops.h"
+#include "mallocn_intern.h"
+
+/* Deeper scopes are counted in the innermost scope that fits in the stack. */
+#define SCOPE_STACK_SIZE 16
+
+typedef struct MemScope {
+  const char *name;
+  size_t mem_in_use;
+  size_t peak_mem;
+  size_t mem_allocated;
+  unsigned int blocks_in_use;
+} MemScope;
+
+/* Index zero is used for blocks allocated outside of any scope, and is not counted. */
+static MemScope scopes[MEM_SCOPES_MAX + 1];
+static unsigned int scopes_num = 0;
+static unsigned int scopes_lock = 0;
+
+static MEM_THREAD_LOCAL unsigned int scope_stack[SCOPE_STACK_SIZE];
+static MEM_THREAD_LOCAL unsigned int scope_stack_depth = 0;
+
+static unsigned int scope_find(const char *name, const unsigned int num)
+{
+  for (unsigned int i = 1; i <= num; i++) {
+    if (strcmp(scopes[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+static unsigned int scope_find_or_add(const char *name)
+{
+  unsigned int scope = scope_find(name, atomic_add_and_fetch_u(&scopes_num, 0));
+  if (scope != 0) {
+    return scope;
+  }
+
+  while (atomic_cas_u(&scopes_lock, 0, 1) != 0) {
+    /* Adding scopes is rare, spin until the other thread added its scope. */
+  }
+  const unsigned int num = scopes_num;
+  scope = scope_find(name, num);
+  if (scope == 0 && num < MEM_SCOPES_MAX) {
+    scope = num + 1;
+    scopes[scope].name = name;
+    /* Make the scope visible to other threads after its name was set. */
+    atomic_add_and_fetch_u(&scopes_num, 1);
+  }
+  atomic_cas_u(&scopes_lock, 1, 0);
+  return scope;
+}
+
+void MEM_scope_push(const char *name)
+{
+  if (scope_stack_depth < SCOPE_STACK_SIZE) {
+    scope_stack[scope_stack_depth] = scope_find_or_add(name);
+  }
+  scope_stack_depth++;
+}
+
+void MEM_scope_pop(void)
+{
+  assert(scope_stack_depth > 0);
+  scope_stack_depth--;
+}
+
+unsigned int mem_scope_alloc(size_t len)
+{
+  const unsigned int depth = scope_stack_depth;
+  if (LIKELY(depth == 0)) {
+    return 0;
+  }
+  const unsigned int scope_index = scope_stack[(depth < SCOPE_STACK_SIZE) ? depth - 1 :
+                                                                             SCOPE_STACK_SIZE - 1];
+  if (scope_index == 0) {
+    /* Past the maximum number of scopes. */
+    return 0;
+  }
+  MemScope *scope = &scopes[scope_index];
+  atomic_add_and_fetch_u(&scope->blocks_in_use, 1);
+  atomic_add_and_fetch_z(&scope->mem_allocated, len);
+  atomic_fetch_and_update_max_z(&scope->peak_mem,
+                                atomic_add_and_fetch_z(&scope->mem_in_use, len));
+  return scope_index;
+}
+
+void mem_scope_free(unsigned int scope_index, size_t len)
+{
+  MemScope *scope = &scopes[scope_index];
+  atomic_sub_and_fetch_u(&scope->blocks_in_use, 1);
+  atomic_sub_and_fetch_z(&scope->mem_in_use, len);
+}
+
+int MEM_scope_stats_get(MEM_ScopeStats *r_stats, int stats_num_max)
+{
+  const unsigned int num = atomic_add_and_fetch_u(&scopes_num, 0);
+  int stats_num = 0;
+  for (unsigned int i = 1; i <= num && stats_num < stats_num_max; i++, stats_num++) {
+    MemScope *scope = &scopes[i];
+    MEM_ScopeStats *stats = &r_stats[stats_num];
+    stats->name = scope->name;
+    stats->mem_in_use = atomic_add_and_fetch_z(&scope->mem_in_use, 0);
+    stats->peak_mem = atomic_add_and_fetch_z(&scope->peak_mem, 0);
+    stats->mem_allocated = atomic_add_and_fetch_z(&scope->mem_allocated, 0);
+    stats->blocks_in_use = atomic_add_and_fetch_u(&scope->blocks_in_use, 0);
+  }
+  return stats_num;
+}
+
+void mem_scope_printmemlist_stats(void)
+{
+  MEM_ScopeStats stats[MEM_SCOPES_MAX];
+  const int stats_num = MEM_scope_stats_get(stats, MEM_SCOPES_MAX);
+  if (stats_num == 0) {
+    return;
+  }
+  printf("\nmemory scopes:\n");
+  for (int i = 0; i < stats_num; i++) {
+    printf("  %s: %u blocks, %.3f MB in use, %.3f MB peak, %.3f MB allocated in total\n",
+           stats[i].name,
+           stats[i].blocks_in_use,
+           (double)stats[i].mem_in_use / (double)(1024 * 1024),
+           (double)stats[i].peak_mem / (double)(1024 * 1024),
+           (double)stats[i].mem_allocated / (double)(1024 * 1024));
+  }
+}
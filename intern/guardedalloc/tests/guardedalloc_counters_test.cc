@@ -0,0 +1,124 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+/* Allocate blocks in some threads and free them in others, the totals have to match. */
+void CountersFromThreads()
+{
+  const int threads_num = 4;
+  const int blocks_num = 1000;
+  std::vector<std::vector<void *>> blocks(threads_num);
+
+  const unsigned int blocks_before = MEM_get_memory_blocks_in_use();
+  const size_t mem_before = MEM_get_memory_in_use();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threads_num; t++) {
+    threads.emplace_back([&blocks, t]() {
+      for (int i = 0; i < blocks_num; i++) {
+        blocks[t].push_back(MEM_mallocN(64, __func__));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before + threads_num * blocks_num);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_before + threads_num * blocks_num * 64);
+  EXPECT_GE(MEM_get_peak_memory(), MEM_get_memory_in_use());
+
+  for (int t = 0; t < threads_num; t++) {
+    threads.emplace_back([&blocks, t]() {
+      for (void *block : blocks[threads_num - 1 - t]) {
+        MEM_freeN(block);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_before);
+}
+
+const MEM_ScopeStats *find_scope_stats(const MEM_ScopeStats *stats,
+                                       const int stats_num,
+                                       const char *name)
+{
+  for (int i = 0; i < stats_num; i++) {
+    if (strcmp(stats[i].name, name) == 0) {
+      return &stats[i];
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, LockfreeCountersFromThreads)
+{
+  CountersFromThreads();
+}
+
+TEST_F(GuardedAllocatorTest, GuardedCountersFromThreads)
+{
+  CountersFromThreads();
+}
+
+TEST_F(LockFreeAllocatorTest, LockfreeScopes)
+{
+  void *outer_block = nullptr;
+  void *inner_block = nullptr;
+  std::thread thread([&]() {
+    MEM_scope_push("test outer");
+    outer_block = MEM_mallocN(100, __func__);
+    MEM_scope_push("test inner");
+    inner_block = MEM_callocN(200, __func__);
+    MEM_scope_pop();
+    MEM_scope_pop();
+  });
+  thread.join();
+
+  /* Allocated outside of any scope. */
+  void *block = MEM_mallocN(300, __func__);
+
+  MEM_ScopeStats stats[MEM_SCOPES_MAX];
+  int stats_num = MEM_scope_stats_get(stats, MEM_SCOPES_MAX);
+  const MEM_ScopeStats *outer = find_scope_stats(stats, stats_num, "test outer");
+  const MEM_ScopeStats *inner = find_scope_stats(stats, stats_num, "test inner");
+  ASSERT_NE(outer, nullptr);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(outer->blocks_in_use, 1);
+  EXPECT_EQ(outer->mem_in_use, 100);
+  EXPECT_EQ(inner->blocks_in_use, 1);
+  EXPECT_EQ(inner->mem_in_use, 200);
+  EXPECT_EQ(MEM_allocN_len(inner_block), 200);
+
+  /* Freed from another thread than the one that allocated the blocks. */
+  MEM_freeN(outer_block);
+  MEM_freeN(inner_block);
+  MEM_freeN(block);
+
+  stats_num = MEM_scope_stats_get(stats, MEM_SCOPES_MAX);
+  outer = find_scope_stats(stats, stats_num, "test outer");
+  inner = find_scope_stats(stats, stats_num, "test inner");
+  EXPECT_EQ(outer->blocks_in_use, 0);
+  EXPECT_EQ(outer->mem_in_use, 0);
+  EXPECT_EQ(outer->peak_mem, 100);
+  EXPECT_EQ(outer->mem_allocated, 100);
+  EXPECT_EQ(inner->mem_in_use, 0);
+  EXPECT_EQ(inner->peak_mem, 200);
+}
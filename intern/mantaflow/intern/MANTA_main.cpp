@@ -29,6 +29,7 @@
 
 #include "MANTA_main.h"
 #include "Python.h"
+#include "fileio/mantaio.h"
 #include "fluid_script.h"
 #include "liquid_script.h"
 #include "manta.h"
@@ -2141,23 +2142,37 @@ void MANTA::updatePointers(FluidModifierData *fmd, bool flush)
   mNoiseFromFile = false;
 }
 
+/* OpenVDB cache files are written in the background, to a temporary file that is renamed once
+ * complete. Wait for the write when the file is still being written. */
+static bool cacheFileExists(const string &filename)
+{
+  if (BLI_exists(filename.c_str())) {
+    return true;
+  }
+  if (BLI_exists((filename + ".tmp").c_str())) {
+    Manta::flushObjectsVDB();
+    return BLI_exists(filename.c_str());
+  }
+  return false;
+}
+
 bool MANTA::hasConfig(FluidModifierData *fmd, int framenr)
 {
   string extension = FLUID_DOMAIN_EXTENSION_UNI;
-  return BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_CONFIG, FLUID_NAME_CONFIG, extension, framenr).c_str());
+  return cacheFileExists(
+      getFile(fmd, FLUID_DOMAIN_DIR_CONFIG, FLUID_NAME_CONFIG, extension, framenr));
 }
 
 bool MANTA::hasData(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, extension, framenr).c_str());
+  bool exists = cacheFileExists(
+      getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
     string filename = (mUsingSmoke) ? FLUID_NAME_DENSITY : FLUID_NAME_PP;
-    exists = BLI_exists(getFile(fmd, FLUID_DOMAIN_DIR_DATA, filename, extension, framenr).c_str());
+    exists = cacheFileExists(getFile(fmd, FLUID_DOMAIN_DIR_DATA, filename, extension, framenr));
   }
   if (with_debug)
     cout << "Fluid: Has Data: " << exists << endl;
@@ -2168,22 +2183,20 @@ bool MANTA::hasData(FluidModifierData *fmd, int framenr)
 bool MANTA::hasNoise(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, extension, framenr).c_str());
+  bool exists = cacheFileExists(
+      getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
     extension = getCacheFileEnding(fmd->domain->cache_data_format);
-    exists = BLI_exists(
-        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_DENSITY_NOISE, extension, framenr)
-            .c_str());
+    exists = cacheFileExists(
+        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_DENSITY_NOISE, extension, framenr));
   }
   /* Check single file naming with deprecated extension. */
   if (!exists) {
     extension = getCacheFileEnding(fmd->domain->cache_noise_format);
-    exists = BLI_exists(
-        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_DENSITY_NOISE, extension, framenr)
-            .c_str());
+    exists = cacheFileExists(
+        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_DENSITY_NOISE, extension, framenr));
   }
   if (with_debug)
     cout << "Fluid: Has Noise: " << exists << endl;
@@ -2194,13 +2207,13 @@ bool MANTA::hasNoise(FluidModifierData *fmd, int framenr)
 bool MANTA::hasMesh(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_mesh_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, extension, framenr).c_str());
+  bool exists = cacheFileExists(
+      getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, extension, framenr));
 
   /* Check old file naming. */
   if (!exists) {
-    exists = BLI_exists(
-        getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_LMESH, extension, framenr).c_str());
+    exists = cacheFileExists(
+        getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_LMESH, extension, framenr));
   }
   if (with_debug)
     cout << "Fluid: Has Mesh: " << exists << endl;
@@ -2211,22 +2224,20 @@ bool MANTA::hasMesh(FluidModifierData *fmd, int framenr)
 bool MANTA::hasParticles(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, extension, framenr).c_str());
+  bool exists = cacheFileExists(
+      getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
     extension = getCacheFileEnding(fmd->domain->cache_data_format);
-    exists = BLI_exists(
-        getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PP_PARTICLES, extension, framenr)
-            .c_str());
+    exists = cacheFileExists(
+        getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PP_PARTICLES, extension, framenr));
   }
   /* Check single file naming with deprecated extension. */
   if (!exists) {
     extension = getCacheFileEnding(fmd->domain->cache_particle_format);
-    exists = BLI_exists(
-        getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PP_PARTICLES, extension, framenr)
-            .c_str());
+    exists = cacheFileExists(
+        getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PP_PARTICLES, extension, framenr));
   }
   if (with_debug)
     cout << "Fluid: Has Particles: " << exists << endl;
@@ -2239,12 +2250,12 @@ bool MANTA::hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   string subdirectory = (sourceDomain) ? FLUID_DOMAIN_DIR_DATA : FLUID_DOMAIN_DIR_GUIDE;
   string filename = (sourceDomain) ? FLUID_NAME_DATA : FLUID_NAME_GUIDING;
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(getFile(fmd, subdirectory, filename, extension, framenr).c_str());
+  bool exists = cacheFileExists(getFile(fmd, subdirectory, filename, extension, framenr));
 
   /* Check old file naming. */
   if (!exists) {
     filename = (sourceDomain) ? FLUID_NAME_VEL : FLUID_NAME_GUIDEVEL;
-    exists = BLI_exists(getFile(fmd, subdirectory, filename, extension, framenr).c_str());
+    exists = cacheFileExists(getFile(fmd, subdirectory, filename, extension, framenr));
   }
 
   if (with_debug)
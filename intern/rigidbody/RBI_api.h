@@ -207,6 +207,12 @@ void RB_body_get_orientation(rbRigidBody *body, float v_out[4]);
 /* Get RigidBody's local scale as a vector */
 void RB_body_get_scale(rbRigidBody *object, float v_out[3]);
 
+/* Get the position and orientation of several RigidBodies at once */
+void RB_bodies_get_loc_rot(rbRigidBody **bodies,
+                           int num_bodies,
+                           float (*r_loc)[3],
+                           float (*r_rot)[4]);
+
 /* ............ */
 
 void RB_body_apply_central_force(rbRigidBody *body, const float v_in[3]);
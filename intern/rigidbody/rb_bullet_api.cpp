@@ -659,6 +659,19 @@ void RB_body_get_scale(rbRigidBody *object, float v_out[3])
   copy_v3_btvec3(v_out, cshape->getLocalScaling());
 }
 
+void RB_bodies_get_loc_rot(rbRigidBody **bodies,
+                           int num_bodies,
+                           float (*r_loc)[3],
+                           float (*r_rot)[4])
+{
+  for (int i = 0; i < num_bodies; i++) {
+    const btTransform &trans = bodies[i]->body->getWorldTransform();
+
+    copy_v3_btvec3(r_loc[i], trans.getOrigin());
+    copy_quat_btquat(r_rot[i], trans.getRotation());
+  }
+}
+
 /* ............ */
 /* Overrides for simulation */
 
@@ -73,6 +73,7 @@ from freestyle.shaders import (
     BezierCurveShader,
     BlenderTextureShader,
     ConstantColorShader,
+    ConstantThicknessShader,
     GuidingLinesShader,
     PolygonalizationShader,
     pyBluePrintCirclesShader,
@@ -1449,8 +1450,13 @@ def process(layer_name, lineset_name):
             print("Warning: Thickness position options are applied when chaining is disabled\n"
                   "         or the Plain chaining is used with the Same Object option enabled.")
     shaders_list.append(ConstantColorShader(*(linestyle.color), alpha=linestyle.alpha))
-    shaders_list.append(BaseThicknessShader(linestyle.thickness, thickness_position,
-                                            linestyle.thickness_ratio))
+    if thickness_position == 'CENTER':
+        # Same result as BaseThicknessShader, both sides get half of the thickness,
+        # but without shading every stroke vertex in Python.
+        shaders_list.append(ConstantThicknessShader(linestyle.thickness))
+    else:
+        shaders_list.append(BaseThicknessShader(linestyle.thickness, thickness_position,
+                                                linestyle.thickness_ratio))
     # -- Modifiers -- #
     for m in linestyle.color_modifiers:
         if not m.use:
@@ -26,6 +26,7 @@ __all__ = (
     "disable",
     "disable_all",
     "reset_all",
+    "enable_lazy",
     "module_bl_info",
 )
 
@@ -39,14 +40,36 @@ addons_fake_modules = {}
 
 
 # called only once at startup, avoids calling 'reset_all', correct but slower.
+# Add-ons enabled in the preferences which are not loaded yet,
+# see `--enable-addons-lazy`.
+_addons_lazy = []
+
+
 def _initialize():
     path_list = paths()
     for path in path_list:
         _bpy.utils._sys_path_ensure_append(path)
+    if _bpy.app.background and _bpy.app.use_addons_lazy:
+        _addons_lazy[:] = [addon.module for addon in _preferences.addons]
+        return
     for addon in _preferences.addons:
         enable(addon.module)
 
 
+def enable_lazy():
+    """
+    Enables the add-ons which loading was deferred by `--enable-addons-lazy`.
+
+    :return: True when add-ons have been enabled.
+    :rtype: bool
+    """
+    module_names = _addons_lazy[:]
+    _addons_lazy.clear()
+    for module_name in module_names:
+        enable(module_name)
+    return bool(module_names)
+
+
 def paths():
     # RELEASE SCRIPTS: official scripts distributed in Blender releases
     addon_paths = _bpy.utils.script_paths("addons")
@@ -421,6 +444,9 @@ def disable(module_name, *, default_set=False, handle_error=None):
             import traceback
             traceback.print_exc()
 
+    if module_name in _addons_lazy:
+        _addons_lazy.remove(module_name)
+
     mod = sys.modules.get(module_name)
 
     # possible this addon is from a previous session and didn't load a
@@ -478,6 +504,8 @@ def reset_all(*, reload_scripts=False):
 
             if is_enabled == is_loaded:
                 pass
+            elif mod_name in _addons_lazy:
+                pass
             elif is_enabled:
                 enable(mod_name)
             elif is_loaded:
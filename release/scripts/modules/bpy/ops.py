@@ -94,6 +94,18 @@ class _BPyOpsSubModOp:
                 for view_layer in scene.view_layers:
                     view_layer.update()
 
+    @staticmethod
+    def _addons_lazy_ensure(idname_py):
+        # Operators from add-ons deferred by `--enable-addons-lazy`
+        # only exist once the add-ons are enabled.
+        import addon_utils
+        if not addon_utils._addons_lazy:
+            return
+        try:
+            _op_get_rna_type(idname_py)
+        except KeyError:
+            addon_utils.enable_lazy()
+
     __doc__ = property(_get_doc)
 
     def __init__(self, module, func):
@@ -102,6 +114,7 @@ class _BPyOpsSubModOp:
 
     def poll(self, *args):
         C_dict, C_exec, _C_undo = _BPyOpsSubModOp._parse_args(args)
+        _BPyOpsSubModOp._addons_lazy_ensure(self.idname_py())
         return _op_poll(self.idname_py(), C_dict, C_exec)
 
     def idname(self):
@@ -124,6 +137,7 @@ class _BPyOpsSubModOp:
         # operators are supposed to operate on. There might be some
         # corner cases when operator need a full scene update though.
         _BPyOpsSubModOp._view_layer_update(context)
+        _BPyOpsSubModOp._addons_lazy_ensure(self.idname_py())
 
         if args:
             C_dict, C_exec, C_undo = _BPyOpsSubModOp._parse_args(args)
@@ -128,6 +128,9 @@ class DATA_PT_volume_render(DataButtonsPanel, Panel):
         if scene.render.engine == 'CYCLES':
             col.prop(render, "step_size")
 
+            col = layout.column(align=True)
+            col.prop(render, "precision")
+
             col = layout.column(align=True)
             col.prop(render, "clipping")
 
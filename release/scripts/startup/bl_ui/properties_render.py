@@ -532,6 +532,9 @@ class RENDER_PT_eevee_performance(RenderButtonsPanel, Panel):
 
         layout.prop(rd, "use_high_quality_normals")
 
+        if context.engine == 'BLENDER_EEVEE':
+            layout.prop(scene.eevee, "use_occlusion_culling")
+
 
 class RENDER_PT_gpencil(RenderButtonsPanel, Panel):
     bl_label = "Grease Pencil"
@@ -2252,6 +2252,9 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
             context, (
                 ({"property": "use_new_hair_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
+                ({"property": "use_depsgraph_animation_cache"}, None),
+                ({"property": "use_gpu_shader_cache"}, None),
+                ({"property": "use_viewport_lod"}, None),
             ),
         )
 
@@ -5864,6 +5864,7 @@ class VIEW3D_PT_shading_options(Panel):
 
         if shading.type == 'SOLID':
             col.prop(shading, "show_backface_culling")
+            col.prop(shading, "use_occlusion_culling")
 
         row = col.row(align=True)
 
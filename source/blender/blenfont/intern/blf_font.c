@@ -111,6 +111,13 @@ static void blf_batch_draw_init(void)
 static void blf_batch_draw_exit(void)
 {
   GPU_BATCH_DISCARD_SAFE(g_batch.batch);
+
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
+  if (atlas->texture) {
+    GPU_texture_free(atlas->texture);
+  }
+  MEM_SAFE_FREE(atlas->bitmap_result);
+  memset(atlas, 0, sizeof(*atlas));
 }
 
 void blf_batch_draw_begin(FontBLF *font)
@@ -119,7 +126,6 @@ void blf_batch_draw_begin(FontBLF *font)
     blf_batch_draw_init();
   }
 
-  const bool font_changed = (g_batch.font != font);
   const bool simple_shader = ((font->flags & (BLF_ROTATION | BLF_MATRIX | BLF_ASPECT)) == 0);
   const bool shader_changed = (simple_shader != g_batch.simple_shader);
 
@@ -148,8 +154,9 @@ void blf_batch_draw_begin(FontBLF *font)
       GPU_matrix_set(g_batch.mat);
     }
 
-    /* flush cache if config is not the same. */
-    if (mat_changed || font_changed || shader_changed) {
+    /* Flush cache if config is not the same.
+     * Changing font or size doesn't, all glyphs are stored in the same atlas. */
+    if (mat_changed || shader_changed) {
       blf_batch_draw();
       g_batch.simple_shader = simple_shader;
       g_batch.font = font;
@@ -175,15 +182,14 @@ void blf_batch_draw_begin(FontBLF *font)
 
 static GPUTexture *blf_batch_cache_texture_load(void)
 {
-  GlyphCacheBLF *gc = g_batch.glyph_cache;
-  BLI_assert(gc);
-  BLI_assert(gc->bitmap_len > 0);
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
+  BLI_assert(atlas->bitmap_len > 0);
 
-  if (gc->bitmap_len > gc->bitmap_len_landed) {
-    const int tex_width = GPU_texture_width(gc->texture);
+  if (atlas->bitmap_len > atlas->bitmap_len_landed) {
+    const int tex_width = GPU_texture_width(atlas->texture);
 
-    int bitmap_len_landed = gc->bitmap_len_landed;
-    int remain = gc->bitmap_len - bitmap_len_landed;
+    int bitmap_len_landed = atlas->bitmap_len_landed;
+    int remain = atlas->bitmap_len - bitmap_len_landed;
     int offset_x = bitmap_len_landed % tex_width;
     int offset_y = bitmap_len_landed / tex_width;
 
@@ -191,9 +197,9 @@ static GPUTexture *blf_batch_cache_texture_load(void)
     while (remain) {
       int remain_row = tex_width - offset_x;
       int width = remain > remain_row ? remain_row : remain;
-      GPU_texture_update_sub(gc->texture,
+      GPU_texture_update_sub(atlas->texture,
                              GPU_DATA_UNSIGNED_BYTE,
-                             &gc->bitmap_result[bitmap_len_landed],
+                             &atlas->bitmap_result[bitmap_len_landed],
                              offset_x,
                              offset_y,
                              0,
@@ -207,10 +213,10 @@ static GPUTexture *blf_batch_cache_texture_load(void)
       offset_y += 1;
     }
 
-    gc->bitmap_len_landed = bitmap_len_landed;
+    atlas->bitmap_len_landed = bitmap_len_landed;
   }
 
-  return gc->texture;
+  return atlas->texture;
 }
 
 void blf_batch_draw(void)
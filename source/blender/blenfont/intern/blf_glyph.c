@@ -204,17 +204,21 @@ void blf_glyph_cache_clear(FontBLF *font)
 
 void blf_glyph_cache_free(GlyphCacheBLF *gc)
 {
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
   GlyphBLF *g;
   for (uint i = 0; i < ARRAY_SIZE(gc->bucket); i++) {
     while ((g = BLI_pophead(&gc->bucket[i]))) {
+      if (g->glyph_cache) {
+        atlas->glyphs_len--;
+      }
       blf_glyph_free(g);
     }
   }
-  if (gc->texture) {
-    GPU_texture_free(gc->texture);
-  }
-  if (gc->bitmap_result) {
-    MEM_freeN(gc->bitmap_result);
+  BLI_assert(atlas->glyphs_len >= 0);
+  if (atlas->glyphs_len == 0) {
+    /* No glyph references the atlas anymore, keep the allocation and start over. */
+    atlas->bitmap_len = 0;
+    atlas->bitmap_len_landed = 0;
   }
   MEM_freeN(gc);
 }
@@ -490,29 +494,31 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
       font->tex_size_max = GPU_max_texture_size();
     }
 
-    g->offset = gc->bitmap_len;
+    GlyphAtlasBLF *atlas = &g_batch.atlas;
+    g->offset = atlas->bitmap_len;
 
     int buff_size = g->dims[0] * g->dims[1];
-    int bitmap_len = gc->bitmap_len + buff_size;
+    int bitmap_len = atlas->bitmap_len + buff_size;
 
-    if (bitmap_len > gc->bitmap_len_alloc) {
+    if (bitmap_len > atlas->bitmap_len_alloc) {
       int w = font->tex_size_max;
       int h = bitmap_len / w + 1;
 
-      gc->bitmap_len_alloc = w * h;
-      gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
+      atlas->bitmap_len_alloc = w * h;
+      atlas->bitmap_result = MEM_reallocN(atlas->bitmap_result, (size_t)atlas->bitmap_len_alloc);
 
       /* Keep in sync with the texture. */
-      if (gc->texture) {
-        GPU_texture_free(gc->texture);
+      if (atlas->texture) {
+        GPU_texture_free(atlas->texture);
       }
-      gc->texture = GPU_texture_create_1d_array(__func__, w, h, 1, GPU_R8, NULL);
+      atlas->texture = GPU_texture_create_1d_array(__func__, w, h, 1, GPU_R8, NULL);
 
-      gc->bitmap_len_landed = 0;
+      atlas->bitmap_len_landed = 0;
     }
 
-    memcpy(&gc->bitmap_result[gc->bitmap_len], g->bitmap, (size_t)buff_size);
-    gc->bitmap_len = bitmap_len;
+    memcpy(&atlas->bitmap_result[atlas->bitmap_len], g->bitmap, (size_t)buff_size);
+    atlas->bitmap_len = bitmap_len;
+    atlas->glyphs_len++;
 
     gc->glyphs_len_free--;
     g->glyph_cache = gc;
@@ -528,11 +534,6 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
   }
 
-  if (g_batch.glyph_cache != g->glyph_cache) {
-    blf_batch_draw();
-    g_batch.glyph_cache = g->glyph_cache;
-  }
-
   if (font->flags & BLF_SHADOW) {
     rctf rect_ofs;
     blf_glyph_calc_rect_shadow(&rect_ofs, g, x, y, font);
@@ -28,8 +28,22 @@
 
 #define BLF_BATCH_DRAW_LEN_MAX 2048 /* in glyph */
 
+/**
+ * Texture array holding the bitmaps of all the glyphs drawn so far.
+ * Shared by every font, size and style, so changing any of them doesn't flush the batch.
+ */
+typedef struct GlyphAtlasBLF {
+  GPUTexture *texture;
+  char *bitmap_result;
+  int bitmap_len;
+  int bitmap_len_landed;
+  int bitmap_len_alloc;
+  /* Number of cached glyphs stored in the atlas, space is reused once it drops to zero. */
+  int glyphs_len;
+} GlyphAtlasBLF;
+
 typedef struct BatchBLF {
-  struct FontBLF *font; /* can only batch glyph from the same font */
+  struct FontBLF *font; /* font of the last batched string. */
   struct GPUBatch *batch;
   struct GPUVertBuf *verts;
   struct GPUVertBufRaw pos_step, col_step, offset_step, glyph_size_step;
@@ -38,7 +52,7 @@ typedef struct BatchBLF {
   float ofs[2];    /* copy of font->pos */
   float mat[4][4]; /* previous call modelmatrix. */
   bool enabled, active, simple_shader;
-  struct GlyphCacheBLF *glyph_cache;
+  GlyphAtlasBLF atlas;
 } BatchBLF;
 
 extern BatchBLF g_batch;
@@ -73,13 +87,6 @@ typedef struct GlyphCacheBLF {
   /* fast ascii lookup */
   struct GlyphBLF *glyph_ascii_table[256];
 
-  /* texture array, to draw the glyphs. */
-  GPUTexture *texture;
-  char *bitmap_result;
-  int bitmap_len;
-  int bitmap_len_landed;
-  int bitmap_len_alloc;
-
   /* and the bigger glyph in the font. */
   int glyph_width_max;
   int glyph_height_max;
@@ -113,7 +120,7 @@ typedef struct GlyphBLF {
   /* avoid conversion to int while drawing */
   int advance_i;
 
-  /* position inside the texture where this glyph is store. */
+  /* position inside the atlas texture where this glyph is store. */
   int offset;
 
   /* Bitmap data, from freetype. Take care that this
@@ -132,6 +139,7 @@ typedef struct GlyphBLF {
    */
   int pos[2];
 
+  /* Cache owning the glyph, set once its bitmap is stored in #BatchBLF.atlas. */
   struct GlyphCacheBLF *glyph_cache;
 } GlyphBLF;
 
@@ -410,6 +410,13 @@ void BKE_pose_splineik_evaluate(struct Depsgraph *depsgraph,
 
 void BKE_pose_eval_done(struct Depsgraph *depsgraph, struct Object *object);
 
+bool BKE_pose_use_compiled_eval(struct Object *object);
+void BKE_pose_eval_compiled(struct Depsgraph *depsgraph,
+                            struct Scene *scene,
+                            struct Object *object,
+                            int generation);
+void BKE_pose_eval_program_free(struct bPose *pose);
+
 void BKE_pose_eval_cleanup(struct Depsgraph *depsgraph,
                            struct Scene *scene,
                            struct Object *object);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <mutex>
+#include <optional>
 
 #include "FN_cpp_type.hh"
 #include "FN_spans.hh"
@@ -34,6 +35,65 @@ using fn::CPPType;
 const CPPType *custom_data_type_to_cpp_type(const CustomDataType type);
 CustomDataType cpp_type_to_custom_data_type(const CPPType &type);
 
+/**
+ * Reference to values that are stored with a constant distance in bytes between them. This allows
+ * accessing attributes embedded in arrays of structs, like the position in #MVert, without
+ * copying them. The values are contiguous when the stride is the size of the type.
+ */
+template<typename T> class StridedSpan {
+ private:
+  T *data_ = nullptr;
+  int64_t size_ = 0;
+  int64_t stride_ = sizeof(T);
+
+ public:
+  StridedSpan() = default;
+
+  StridedSpan(T *data, const int64_t size, const int64_t stride)
+      : data_(data), size_(size), stride_(stride)
+  {
+    BLI_assert(stride >= (int64_t)sizeof(T));
+  }
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  T *data() const
+  {
+    return data_;
+  }
+
+  int64_t stride() const
+  {
+    return stride_;
+  }
+
+  IndexRange index_range() const
+  {
+    return IndexRange(size_);
+  }
+
+  T &operator[](const int64_t index) const
+  {
+    BLI_assert(index >= 0 && index < size_);
+    return *(T *)((const char *)data_ + index * stride_);
+  }
+
+  bool is_contiguous() const
+  {
+    return stride_ == sizeof(T);
+  }
+
+  /* Only valid when the values are contiguous. */
+  Span<T> as_span() const
+  {
+    BLI_assert(this->is_contiguous());
+    return Span<T>(data_, size_);
+  }
+};
+
 /**
  * This class offers an indirection for reading an attribute.
  * This is useful for the following reasons:
@@ -106,11 +166,40 @@ class ReadAttribute {
     return this->get_span().typed<T>();
   }
 
+  /* Get a virtual span that does not allocate an array when all values are the same. */
+  fn::GVSpan get_virtual_span() const;
+
+  template<typename T> fn::VSpan<T> get_virtual_span() const
+  {
+    return this->get_virtual_span().typed<T>();
+  }
+
+  /**
+   * Access the values without copying them, when they are stored in an array with a constant
+   * stride. This is not possible for values that are computed, like vertex weights or attributes
+   * interpolated from another domain.
+   */
+  template<typename T> std::optional<StridedSpan<const T>> try_get_strided_span() const
+  {
+    BLI_assert(cpp_type_.is<T>());
+    const void *data;
+    int64_t stride;
+    if (!this->try_get_strided_internal(&data, &stride)) {
+      return {};
+    }
+    return StridedSpan<const T>(static_cast<const T *>(data), size_, stride);
+  }
+
  protected:
   /* r_value is expected to be uninitialized. */
   virtual void get_internal(const int64_t index, void *r_value) const = 0;
 
   virtual void initialize_span() const;
+
+  /* Returns the value of all elements when it is the same for all of them, otherwise null. */
+  virtual const void *get_single_value_internal() const;
+
+  virtual bool try_get_strided_internal(const void **r_data, int64_t *r_stride) const;
 };
 
 /**
@@ -192,12 +281,27 @@ class WriteAttribute {
     return this->get_span_for_write_only().typed<T>();
   }
 
+  /* Modify the values in place, see #ReadAttribute::try_get_strided_span. Changes done this way
+   * don't have to be applied. */
+  template<typename T> std::optional<StridedSpan<T>> try_get_strided_span()
+  {
+    BLI_assert(cpp_type_.is<T>());
+    void *data;
+    int64_t stride;
+    if (!this->try_get_strided_internal(&data, &stride)) {
+      return {};
+    }
+    return StridedSpan<T>(static_cast<T *>(data), size_, stride);
+  }
+
  protected:
   virtual void get_internal(const int64_t index, void *r_value) const = 0;
   virtual void set_internal(const int64_t index, const void *value) = 0;
 
   virtual void initialize_span(const bool write_only);
   virtual void apply_span_if_necessary();
+
+  virtual bool try_get_strided_internal(void **r_data, int64_t *r_stride);
 };
 
 using ReadAttributePtr = std::unique_ptr<ReadAttribute>;
@@ -241,6 +345,11 @@ template<typename T> class TypedReadAttribute {
   {
     return attribute_->get_span().template typed<T>();
   }
+
+  std::optional<StridedSpan<const T>> try_get_strided_span() const
+  {
+    return attribute_->template try_get_strided_span<T>();
+  }
 };
 
 /* This provides type safe access to an attribute.
@@ -298,6 +407,11 @@ template<typename T> class TypedWriteAttribute {
   {
     attribute_->apply_span();
   }
+
+  std::optional<StridedSpan<T>> try_get_strided_span()
+  {
+    return attribute_->template try_get_strided_span<T>();
+  }
 };
 
 using BooleanReadAttribute = TypedReadAttribute<bool>;
@@ -27,6 +27,7 @@
 extern "C" {
 #endif
 
+struct BoidParticle;
 struct BoidSettings;
 struct BoidState;
 struct Object;
@@ -47,6 +48,13 @@ typedef struct BoidBrainData {
   float goal_nor[3];
   float goal_priority;
 
+  /* Changes that other brains of the same step must not see, so that they can run in parallel.
+   * The jump is applied by #boid_body, the damage by the caller once all brains are done. */
+  float jump_vel[3];
+  bool jump;
+  struct BoidParticle *enemy;
+  float enemy_damage;
+
   struct RNG *rng;
 } BoidBrainData;
 
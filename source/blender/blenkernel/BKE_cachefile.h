@@ -49,6 +49,9 @@ bool BKE_cachefile_filepath_get(const struct Main *bmain,
                                 const struct CacheFile *cache_file,
                                 char r_filename[1024]);
 
+/* True when the path has the extension of a USD file, the other cache files are Alembic. */
+bool BKE_cachefile_filepath_is_usd(const char *filepath);
+
 float BKE_cachefile_time_offset(const struct CacheFile *cache_file,
                                 const float time,
                                 const float fps);
@@ -67,6 +67,8 @@ typedef struct ClothSolverResult {
   int max_iterations, min_iterations;
   float avg_iterations;
   float max_error, min_error, avg_error;
+  /* Time spent in the solver for all substeps, in seconds. */
+  float time;
 } ClothSolverResult;
 
 /**
@@ -205,6 +205,13 @@ struct bConstraintOb *BKE_constraints_make_evalob(struct Depsgraph *depsgraph,
                                                   void *subdata,
                                                   short datatype);
 void BKE_constraints_clear_evalob(struct bConstraintOb *cob);
+void BKE_constraints_evalob_init(struct bConstraintOb *cob,
+                                 struct Depsgraph *depsgraph,
+                                 struct Scene *scene,
+                                 struct Object *ob,
+                                 void *subdata,
+                                 short datatype);
+void BKE_constraints_evalob_apply(struct bConstraintOb *cob);
 
 void BKE_constraint_mat_convertspace(struct Object *ob,
                                      struct bPoseChannel *pchan,
@@ -123,6 +123,9 @@ void CustomData_data_mix_value(
  * enum (e.g. CD_MLOOPUV). the layer type's equal function is used to compare
  * the data, if it exists, otherwise memcmp is used.*/
 bool CustomData_data_equals(int type, const void *data1, const void *data2);
+/* Combine the types, names and content of all the layers into the given hash.
+ * Meant to detect changes of the data between evaluations. */
+uint64_t CustomData_hash(const struct CustomData *data, int totelem, uint64_t hash);
 void CustomData_data_initminmax(int type, void *min, void *max);
 void CustomData_data_dominmax(int type, const void *data, void *min, void *max);
 void CustomData_data_multiply(int type, void *data, float fac);
@@ -297,6 +300,13 @@ void CustomData_interp(const struct CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+void CustomData_interp_many(const struct CustomData *source,
+                            struct CustomData *dest,
+                            const int *src_indices,
+                            const float *weights,
+                            const int *src_offsets,
+                            int dest_num,
+                            int dest_index);
 void CustomData_bmesh_interp_n(struct CustomData *data,
                                const void **src_blocks,
                                const float *weights,
@@ -395,6 +405,7 @@ void CustomData_set_layer_stencil_index(struct CustomData *data, int type, int n
 void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block_data(struct CustomData *data, void *block);
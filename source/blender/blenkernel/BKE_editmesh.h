@@ -81,6 +81,13 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Only vertex coordinates changed since the last update (set while transforming),
+   * allows the draw cache to keep buffers which only depend on the topology.
+   * Cleared by #EDBM_update_generic.
+   */
+  char is_deform_only_update;
+
 } BMEditMesh;
 
 /* editmesh.c */
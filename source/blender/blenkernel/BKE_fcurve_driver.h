@@ -99,6 +99,9 @@ float evaluate_driver(struct PathResolvedRNA *anim_rna,
                       struct ChannelDriver *driver_orig,
                       const struct AnimationEvalContext *anim_eval_context);
 
+void BKE_driver_python_profile_print(void);
+void BKE_driver_python_profile_free(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -188,6 +188,10 @@ class GeometryComponent {
   virtual blender::Set<std::string> attribute_names() const;
   virtual bool is_empty() const;
 
+  /* Returns false when the data is owned by someone else, it might be freed while the component
+   * still exists. */
+  virtual bool owns_direct_data() const;
+
   /* Get a read-only attribute for the given domain and data type.
    * Returns null when it does not exist. */
   blender::bke::ReadAttributePtr attribute_try_get_for_read(
@@ -357,6 +361,7 @@ class MeshComponent : public GeometryComponent {
   Mesh *release();
 
   void copy_vertex_group_names_from_object(const struct Object &object);
+  const blender::Map<std::string, int> &vertex_group_names() const;
 
   const Mesh *get_for_read() const;
   Mesh *get_for_write();
@@ -379,6 +384,7 @@ class MeshComponent : public GeometryComponent {
 
   blender::Set<std::string> attribute_names() const final;
   bool is_empty() const final;
+  bool owns_direct_data() const final;
 
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Mesh;
 };
@@ -421,6 +427,7 @@ class PointCloudComponent : public GeometryComponent {
 
   blender::Set<std::string> attribute_names() const final;
   bool is_empty() const final;
+  bool owns_direct_data() const final;
 
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::PointCloud;
 };
@@ -441,11 +448,15 @@ class InstancesComponent : public GeometryComponent {
   void add_instance(Object *object, blender::float4x4 transform, const int id = -1);
   void add_instance(Collection *collection, blender::float4x4 transform, const int id = -1);
   void add_instance(InstancedData data, blender::float4x4 transform, const int id = -1);
+  /* Change the number of instances. Added instances have to be initialized with the spans. */
+  void resize(const int instances_amount);
 
   blender::Span<InstancedData> instanced_data() const;
   blender::Span<blender::float4x4> transforms() const;
   blender::Span<int> ids() const;
+  blender::MutableSpan<InstancedData> instanced_data();
   blender::MutableSpan<blender::float4x4> transforms();
+  blender::MutableSpan<int> ids();
   int instances_amount() const;
 
   bool is_empty() const final;
@@ -472,5 +483,7 @@ class VolumeComponent : public GeometryComponent {
   const Volume *get_for_read() const;
   Volume *get_for_write();
 
+  bool owns_direct_data() const final;
+
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::Volume;
 };
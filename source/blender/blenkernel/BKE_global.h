@@ -111,6 +111,10 @@ enum {
   /** Support simulating events (for testing). */
   G_FLAG_EVENT_SIMULATE = (1 << 3),
   G_FLAG_USERPREF_NO_SAVE_ON_EXIT = (1 << 4),
+  /** Defer enabling add-ons in background mode, until an operator which is not found is used. */
+  G_FLAG_SCRIPT_ADDONS_LAZY = (1 << 5),
+  /** Don't read UI and editor-only data-blocks of files loaded in background mode. */
+  G_FLAG_FILE_READ_NO_UI_DATA = (1 << 6),
 
   G_FLAG_SCRIPT_AUTOEXEC = (1 << 13),
   /** When this flag is set ignore the prefs #USER_SCRIPT_AUTOEXEC_DISABLE. */
@@ -122,7 +126,7 @@ enum {
 /** Don't overwrite these flags when reading a file. */
 #define G_FLAG_ALL_RUNTIME \
   (G_FLAG_SCRIPT_AUTOEXEC | G_FLAG_SCRIPT_OVERRIDE_PREF | G_FLAG_EVENT_SIMULATE | \
-   G_FLAG_USERPREF_NO_SAVE_ON_EXIT)
+   G_FLAG_USERPREF_NO_SAVE_ON_EXIT | G_FLAG_SCRIPT_ADDONS_LAZY | G_FLAG_FILE_READ_NO_UI_DATA)
 
 /** Flags to read from blend file. */
 #define G_FLAG_ALL_READFILE 0
@@ -153,7 +157,8 @@ enum {
   G_DEBUG_XR = (1 << 19),                    /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 20),               /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 21), /* Debug GHOST module. */
+  G_DEBUG_GHOST = (1 << 21),   /* Debug GHOST module. */
+  G_DEBUG_DRIVERS = (1 << 22), /* Timing statistics of drivers evaluated by Python. */
 };
 
 #define G_DEBUG_ALL \
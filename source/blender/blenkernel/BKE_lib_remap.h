@@ -76,6 +76,17 @@ enum {
   ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE = 1 << 4,
   /** Do not remap library override pointers. */
   ID_REMAP_SKIP_OVERRIDE_LIBRARY = 1 << 5,
+  /**
+   * Only visit the users of the remapped ID found in #Main.relations, instead of the whole Main
+   * database. Relations must have been created before the IDs they have to know about got new
+   * users, remapping keeps them valid by adding the users of the old ID to the new one.
+   */
+  ID_REMAP_USE_MAIN_RELATIONS = 1 << 6,
+  /**
+   * Skip the updates of collections and objects going over the whole Main database after each
+   * remapping, #BKE_libblock_remap_post_process_all must be called once done instead.
+   */
+  ID_REMAP_SKIP_POST_PROCESS = 1 << 7,
 };
 
 /* Note: Requiring new_id to be non-null, this *may* not be the case ultimately,
@@ -87,6 +98,18 @@ void BKE_libblock_remap_locked(struct Main *bmain,
 void BKE_libblock_remap(struct Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
     ATTR_NONNULL(1, 2);
 
+void BKE_libblock_remap_multiple_locked(struct Main *bmain,
+                                        struct ID **old_ids,
+                                        struct ID **new_ids,
+                                        const int ids_len,
+                                        const short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple(struct Main *bmain,
+                                 struct ID **old_ids,
+                                 struct ID **new_ids,
+                                 const int ids_len,
+                                 const short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_post_process_all(struct Main *bmain) ATTR_NONNULL();
+
 void BKE_libblock_unlink(struct Main *bmain,
                          void *idv,
                          const bool do_flag_never_null,
@@ -165,6 +165,7 @@ void BKE_mask_coord_to_image(struct Image *image,
 
 void BKE_mask_evaluate(struct Mask *mask, const float ctime, const bool do_newframe);
 void BKE_mask_layer_evaluate(struct MaskLayer *masklay, const float ctime, const bool do_newframe);
+bool BKE_mask_is_animated(const struct Mask *mask);
 void BKE_mask_parent_init(struct MaskParent *parent);
 void BKE_mask_calc_handle_adjacent_interp(struct MaskSpline *spline,
                                           struct MaskSplinePoint *point,
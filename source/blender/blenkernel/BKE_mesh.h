@@ -191,6 +191,7 @@ void BKE_mesh_smooth_flag_set(struct Mesh *me, const bool use_smooth);
 void BKE_mesh_edges_set_draw_render(struct Mesh *me);
 
 const char *BKE_mesh_cmp(struct Mesh *me1, struct Mesh *me2, float thresh);
+uint64_t BKE_mesh_content_hash(const struct Mesh *me, uint64_t hash);
 
 struct BoundBox *BKE_mesh_boundbox_get(struct Object *ob);
 
@@ -34,6 +34,7 @@ struct CustomData;
 struct CustomData_MeshMasks;
 struct Depsgraph;
 struct KeyBlock;
+struct MDeformVert;
 struct MLoop;
 struct MLoopTri;
 struct MVertTri;
@@ -41,11 +42,27 @@ struct Mesh;
 struct Object;
 struct Scene;
 
+/**
+ * Vertex group weights of all vertices in one contiguous block: the weights of vertex `i` are
+ * the items `offsets[i]` up to `offsets[i + 1]` of `def_nrs` and `weights`.
+ */
+typedef struct MeshDeformWeights {
+  /** `totvert + 1` items. */
+  int *offsets;
+  unsigned int *def_nrs;
+  float *weights;
+
+  /** The deform vertices the weights were read from, to detect changes. */
+  const struct MDeformVert *dvert;
+  int totvert;
+} MeshDeformWeights;
+
 void BKE_mesh_runtime_reset(struct Mesh *mesh);
 void BKE_mesh_runtime_reset_on_copy(struct Mesh *mesh, const int flag);
 int BKE_mesh_runtime_looptri_len(const struct Mesh *mesh);
 void BKE_mesh_runtime_looptri_recalc(struct Mesh *mesh);
 const struct MLoopTri *BKE_mesh_runtime_looptri_ensure(struct Mesh *mesh);
+const MeshDeformWeights *BKE_mesh_runtime_deform_weights_ensure(struct Mesh *mesh);
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_clear_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_reset_edit_data(struct Mesh *mesh);
@@ -115,6 +115,15 @@ typedef enum {
 
   /** Accepts #BMesh input (without conversion). */
   eModifierTypeFlag_AcceptsBMesh = (1 << 11),
+
+  /**
+   * For expensive modifiers, the result is kept between evaluations of the stack and is re-used
+   * as long as the input of the stack and the modifiers up to this one did not change.
+   * The cache is stored in #ModifierData.runtime, so the modifier must not use it and has to
+   * use #BKE_modifier_result_cache_free_data as `freeData` and #BKE_modifier_result_cache_free
+   * as `freeRuntimeData`.
+   */
+  eModifierTypeFlag_CacheResult = (1 << 12),
 } ModifierTypeFlag;
 
 typedef void (*IDWalkFunc)(void *userData, struct Object *ob, struct ID **idpoin, int cb_flag);
@@ -473,6 +482,17 @@ bool BKE_modifiers_uses_subsurf_facedots(struct Scene *scene, struct Object *ob)
 bool BKE_modifiers_is_correctable_deformed(struct Scene *scene, struct Object *ob);
 void BKE_modifier_free_temporary_data(struct ModifierData *md);
 
+/* Result of modifiers with #eModifierTypeFlag_CacheResult, see #mesh_calc_modifiers. */
+const struct Mesh *BKE_modifier_result_cache_lookup(const struct ModifierData *md,
+                                                    const uint64_t key,
+                                                    const struct Mesh **r_mesh_orco);
+void BKE_modifier_result_cache_store(struct ModifierData *md,
+                                     const uint64_t key,
+                                     const struct Mesh *mesh,
+                                     const struct Mesh *mesh_orco);
+void BKE_modifier_result_cache_free(void *runtime);
+void BKE_modifier_result_cache_free_data(struct ModifierData *md);
+
 typedef struct CDMaskLink {
   struct CDMaskLink *next;
   struct CustomData_MeshMasks mask;
@@ -312,6 +312,9 @@ typedef struct bNodeType {
 
   /* Execute a geometry node. */
   NodeGeometryExecFunction geometry_node_execute;
+  /* The execute callback only requests the inputs it needs, see
+   * #GeoNodeExecParams::lazy_require_input. */
+  bool geometry_node_execute_supports_laziness;
 
   /* RNA integration */
   ExtensionRNA rna_ext;
@@ -129,8 +129,26 @@ typedef struct SubdivStats {
   /* Per-value timestamp on when corresponding BKE_subdiv_stats_begin() was
    * called. */
   double begin_timestamp_[NUM_SUBDIV_STATS_VALUES];
+
+  /* Number of times an update of the descriptor had to create the topology
+   * refiner from scratch, and number of times it could re-use the existing one. */
+  int num_topology_refiner_rebuilds;
+  int num_topology_refiner_reuses;
 } SubdivStats;
 
+/* Cheap to compute summary of the mesh data the topology refiner is created
+ * from. Is used to skip the full topology comparison when the mesh did only
+ * deform since the previous update. */
+typedef struct SubdivTopologyFingerprint {
+  bool is_valid;
+  int num_vertices;
+  int num_edges;
+  int num_loops;
+  int num_polys;
+  int num_uv_layers;
+  uint32_t hash;
+} SubdivTopologyFingerprint;
+
 /* Functor which evaluates displacement at a given (u, v) of given ptex face. */
 typedef struct SubdivDisplacement {
   /* Initialize displacement evaluator.
@@ -184,6 +202,9 @@ typedef struct Subdiv {
   struct SubdivDisplacement *displacement_evaluator;
   /* Statistics for debugging. */
   SubdivStats stats;
+  /* Fingerprint of the mesh topology refiner was created for.
+   * Only valid when the descriptor was created by BKE_subdiv_update_from_mesh(). */
+  SubdivTopologyFingerprint topology_fingerprint;
 
   /* Cached values, are not supposed to be accessed directly. */
   struct {
@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 struct Mesh;
+struct OpenSubdiv_PatchCoord;
 struct Subdiv;
 
 /* Returns true if evaluator is ready for use. */
@@ -76,6 +77,17 @@ void BKE_subdiv_eval_limit_point_and_short_normal(struct Subdiv *subdiv,
                                                   float r_P[3],
                                                   short r_N[3]);
 
+/* Batched point queries. */
+
+/* Evaluate points at a limit surface with their derivatives. This is faster than evaluating the
+ * points one by one, since the patches are evaluated for all of them in one go. */
+void BKE_subdiv_eval_limit_points_and_derivatives(struct Subdiv *subdiv,
+                                                  const struct OpenSubdiv_PatchCoord *patch_coords,
+                                                  const int num_points,
+                                                  float (*r_P)[3],
+                                                  float (*r_dPdu)[3],
+                                                  float (*r_dPdv)[3]);
+
 /* Evaluate face-varying layer (such as UV). */
 void BKE_subdiv_eval_face_varying(struct Subdiv *subdiv,
                                   const int face_varying_channel,
@@ -39,6 +39,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_float2.hh"
+#include "BLI_hash.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
@@ -932,6 +933,75 @@ static Mesh *modifier_modify_mesh_and_geometry_set(ModifierData *md,
   return mesh_output;
 }
 
+struct ModifierResultCacheKey {
+  ModifierData *md;
+  CDMaskLink *md_datamask;
+  uint64_t key;
+};
+
+/**
+ * Compute the keys of the results of the modifiers with #eModifierTypeFlag_CacheResult.
+ * A key covers the input mesh of the stack, the settings of all modifiers up to the one caching
+ * its result and the data layers needed after it. Modifiers using data from other IDs or the
+ * current time are not covered, so results are only cached before the first of them.
+ */
+static blender::Vector<ModifierResultCacheKey> modifier_result_cache_keys(
+    const Scene *scene,
+    const Object *ob,
+    const Mesh *mesh_input,
+    ModifierData *firstmd,
+    CDMaskLink *datamasks,
+    const CustomData_MeshMasks *final_datamask,
+    const int required_mode)
+{
+  blender::Vector<ModifierResultCacheKey> keys;
+  uint64_t hash = BLI_hash_u64_combine(0, (uint64_t)required_mode);
+
+  CDMaskLink *md_datamask = datamasks;
+  for (ModifierData *md = firstmd; md; md = md->next, md_datamask = md_datamask->next) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+
+    if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
+      continue;
+    }
+    if (md->type == eModifierType_ShapeKey || mti->updateDepsgraph != nullptr ||
+        (mti->flags & eModifierTypeFlag_UsesPointCache) ||
+        (mti->dependsOnTime && mti->dependsOnTime(md)) ||
+        (md_datamask->mask.vmask & CD_MASK_CLOTH_ORCO)) {
+      break;
+    }
+
+    hash = BLI_hash_u64_combine(hash, (uint64_t)md->type);
+    hash = BLI_hash_buffer_u64(
+        (const char *)md + sizeof(ModifierData), mti->structSize - sizeof(ModifierData), hash);
+
+    if (mti->flags & eModifierTypeFlag_CacheResult) {
+      const CustomData_MeshMasks &next_mask = md_datamask->next ? md_datamask->next->mask :
+                                                                   *final_datamask;
+      uint64_t key = BLI_hash_buffer_u64(&md_datamask->mask, sizeof(CustomData_MeshMasks), hash);
+      key = BLI_hash_buffer_u64(&next_mask, sizeof(CustomData_MeshMasks), key);
+      keys.append({md, md_datamask, key});
+    }
+  }
+
+  if (keys.is_empty()) {
+    return keys;
+  }
+
+  /* Data used by modifiers outside of their settings, only hashed when something is cached. */
+  uint64_t input_hash = BKE_mesh_content_hash(mesh_input, 0);
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &ob->defbase) {
+    input_hash = BLI_hash_buffer_u64(dg->name, strlen(dg->name), input_hash);
+  }
+  input_hash = BLI_hash_u64_combine(input_hash, (uint64_t)(scene->r.mode & R_SIMPLIFY));
+  input_hash = BLI_hash_u64_combine(input_hash, (uint64_t)scene->r.simplify_subsurf);
+  input_hash = BLI_hash_u64_combine(input_hash, (uint64_t)scene->r.simplify_subsurf_render);
+  for (ModifierResultCacheKey &key : keys) {
+    key.key = BLI_hash_u64_combine(key.key, input_hash);
+  }
+  return keys;
+}
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -1022,6 +1092,27 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(ob);
 
+  /* Results of expensive modifiers are only cached for the regular evaluation of the stack. */
+  const bool use_result_cache = use_cache && useDeform == 1 && index == -1 && !need_mapping &&
+                                !sculpt_mode;
+  blender::Vector<ModifierResultCacheKey> result_cache_keys;
+  if (use_result_cache) {
+    result_cache_keys = modifier_result_cache_keys(
+        scene, ob, mesh_input, md, datamasks, &final_datamask, required_mode);
+  }
+  /* Restart the stack from the result of the last modifier in the stack which is still valid. */
+  const ModifierResultCacheKey *restart_key = nullptr;
+  const Mesh *restart_mesh = nullptr;
+  const Mesh *restart_mesh_orco = nullptr;
+  for (int i = result_cache_keys.size() - 1; i >= 0; i--) {
+    restart_mesh = BKE_modifier_result_cache_lookup(
+        result_cache_keys[i].md, result_cache_keys[i].key, &restart_mesh_orco);
+    if (restart_mesh != nullptr) {
+      restart_key = &result_cache_keys[i];
+      break;
+    }
+  }
+
   /* Apply all leading deform modifiers. */
   if (useDeform) {
     for (; md; md = md->next, md_datamask = md_datamask->next) {
@@ -1076,6 +1167,25 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
+
+  if (restart_key != nullptr) {
+    /* Everything up to the cached modifier is skipped, the leading deform modifiers are still
+     * evaluated above for the deform mesh. */
+    if (mesh_final != nullptr) {
+      BKE_id_free(nullptr, mesh_final);
+    }
+    MEM_SAFE_FREE(deformed_verts);
+    mesh_final = BKE_mesh_copy_for_eval((Mesh *)restart_mesh, false);
+    mesh_final->runtime.deformed_only = false;
+    if (restart_mesh_orco != nullptr) {
+      mesh_orco = BKE_mesh_copy_for_eval((Mesh *)restart_mesh_orco, false);
+    }
+    have_non_onlydeform_modifiers_appled = true;
+    isPrevDeform = false;
+    md = restart_key->md->next;
+    md_datamask = restart_key->md_datamask->next;
+  }
+
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1335,6 +1445,23 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      if (use_result_cache && (mti->flags & eModifierTypeFlag_CacheResult)) {
+        const ModifierResultCacheKey *key = nullptr;
+        for (const ModifierResultCacheKey &cache_key : result_cache_keys) {
+          if (cache_key.md == md) {
+            key = &cache_key;
+          }
+        }
+        if (key != nullptr) {
+          BKE_modifier_result_cache_store(md, key->key, mesh_final, mesh_orco);
+        }
+        else {
+          /* The result can not be re-used anymore. */
+          BKE_modifier_result_cache_free(md->runtime);
+          md->runtime = nullptr;
+        }
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -1841,6 +1968,82 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/* Take the draw cache of the previous evaluated mesh when it was created by deform-only modifiers,
+ * so that buffers which only depend on the topology can be kept by the next evaluation. */
+static void *mesh_build_data_batch_cache_steal(Object *ob)
+{
+  Mesh *mesh_eval = BKE_object_get_evaluated_mesh(ob);
+  if (mesh_eval == nullptr || !ob->runtime.is_data_eval_owned || mesh_eval->edit_mesh != nullptr ||
+      !mesh_eval->runtime.deformed_only) {
+    return nullptr;
+  }
+  void *batch_cache = mesh_eval->runtime.batch_cache;
+  mesh_eval->runtime.batch_cache = nullptr;
+  return batch_cache;
+}
+
+/* Hand the draw cache of the previous evaluation over to the new evaluated mesh. This is only done
+ * when both are the result of deform-only modifiers applied on an unchanged input mesh (armature
+ * or shape key animation for example), in which case they share the same topology and only the
+ * buffers depending on vertex coordinates are discarded. */
+static void mesh_build_data_batch_cache_restore(Object *ob,
+                                                const Mesh *mesh_input,
+                                                Mesh *mesh_eval,
+                                                void *batch_cache)
+{
+  if (batch_cache == nullptr) {
+    return;
+  }
+  const bool is_input_unchanged = (mesh_input->id.recalc &
+                                   (ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE)) == 0;
+  if (ob->runtime.is_data_eval_owned && mesh_eval->runtime.deformed_only && is_input_unchanged &&
+      mesh_eval->runtime.batch_cache == nullptr) {
+    mesh_eval->runtime.batch_cache = batch_cache;
+    BKE_mesh_batch_cache_dirty_tag(mesh_eval, BKE_MESH_BATCH_DIRTY_DEFORM);
+    return;
+  }
+  /* The draw cache only refers to the mesh through its runtime pointer. */
+  Mesh mesh_tmp = *mesh_eval;
+  mesh_tmp.runtime.batch_cache = batch_cache;
+  BKE_mesh_batch_cache_free(&mesh_tmp);
+}
+
+/* Take the BVH trees of the previous evaluated mesh, in the same cases as the draw cache, see
+ * #mesh_build_data_batch_cache_steal(). */
+static BVHCache *mesh_build_data_bvh_cache_steal(Object *ob)
+{
+  Mesh *mesh_eval = BKE_object_get_evaluated_mesh(ob);
+  if (mesh_eval == nullptr || !ob->runtime.is_data_eval_owned || mesh_eval->edit_mesh != nullptr ||
+      !mesh_eval->runtime.deformed_only) {
+    return nullptr;
+  }
+  BVHCache *bvh_cache = (BVHCache *)mesh_eval->runtime.bvh_cache;
+  mesh_eval->runtime.bvh_cache = nullptr;
+  return bvh_cache;
+}
+
+/* Give the BVH trees of the previous evaluation to the new evaluated mesh when both have the same
+ * topology, so that shrink-wrap, snapping, etc. against a deforming mesh refit them instead of
+ * building new ones. */
+static void mesh_build_data_bvh_cache_restore(Object *ob,
+                                              const Mesh *mesh_input,
+                                              Mesh *mesh_eval,
+                                              BVHCache *bvh_cache)
+{
+  if (bvh_cache == nullptr) {
+    return;
+  }
+  const bool is_input_unchanged = (mesh_input->id.recalc &
+                                   (ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE)) == 0;
+  if (ob->runtime.is_data_eval_owned && mesh_eval->runtime.deformed_only && is_input_unchanged &&
+      mesh_eval->runtime.bvh_cache == nullptr) {
+    bvhcache_prepare_refit(bvh_cache);
+    mesh_eval->runtime.bvh_cache = bvh_cache;
+    return;
+  }
+  bvhcache_free(bvh_cache);
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1853,6 +2056,8 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  void *batch_cache_prev = mesh_build_data_batch_cache_steal(ob);
+  BVHCache *bvh_cache_prev = mesh_build_data_bvh_cache_steal(ob);
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1891,6 +2096,8 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   Mesh *mesh = (Mesh *)ob->data;
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
+  mesh_build_data_batch_cache_restore(ob, mesh, mesh_eval, batch_cache_prev);
+  mesh_build_data_bvh_cache_restore(ob, mesh, mesh_eval, bvh_cache_prev);
 
   /* Add the final mesh as read-only non-owning component to the geometry set. */
   BLI_assert(!geometry_set_eval->has<MeshComponent>());
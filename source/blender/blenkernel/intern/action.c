@@ -72,6 +72,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 static CLG_LogRef LOG = {"bke.action"};
 
 /* *********************** NOTE ON POSE AND ACTION **********************
@@ -101,6 +103,9 @@ static CLG_LogRef LOG = {"bke.action"};
  *
  * \param flag: Copying options (see BKE_lib_id.h's LIB_ID_COPY_... flags for more).
  */
+/* Source of #bAction.eval_generation. */
+static uint32_t action_eval_generation = 0;
+
 static void action_copy_data(Main *UNUSED(bmain),
                              ID *id_dst,
                              const ID *id_src,
@@ -112,6 +117,8 @@ static void action_copy_data(Main *UNUSED(bmain),
   bActionGroup *group_dst, *group_src;
   FCurve *fcurve_dst, *fcurve_src;
 
+  action_dst->eval_generation = (int)atomic_add_and_fetch_uint32(&action_eval_generation, 1);
+
   /* Duplicate the lists of groups and markers. */
   BLI_duplicatelist(&action_dst->groups, &action_src->groups);
   BLI_duplicatelist(&action_dst->markers, &action_src->markers);
@@ -1125,6 +1132,7 @@ void BKE_pose_channels_free_ex(bPose *pose, bool do_id_user)
   BKE_pose_channels_hash_free(pose);
 
   MEM_SAFE_FREE(pose->chan_array);
+  BKE_pose_eval_program_free(pose);
 }
 
 void BKE_pose_channels_free(bPose *pose)
@@ -1913,6 +1921,7 @@ void BKE_pose_blend_read_data(BlendDataReader *reader, bPose *pose)
 
   pose->chanhash = NULL;
   pose->chan_array = NULL;
+  pose->eval_program = NULL;
 
   LISTBASE_FOREACH (bPoseChannel *, pchan, &pose->chanbase) {
     BKE_pose_channel_runtime_reset(&pchan->runtime);
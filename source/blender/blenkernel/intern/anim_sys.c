@@ -36,6 +36,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -780,6 +781,184 @@ void animsys_evaluate_action(PointerRNA *ptr,
   animsys_evaluate_action_ex(ptr, act, anim_eval_context, flush_to_original);
 }
 
+/* ----------------------------------------- */
+/* Compiled Action Evaluation
+ *
+ * Evaluating an action resolves the RNA path of every F-Curve and searches its keyframes, on
+ * every frame. With many channels (motion capture) this dominates playback, so the evaluated
+ * copies of IDs keep the resolved targets and a keyframe search cursor per F-Curve between frames.
+ * Evaluated copies are replaced when their data changes structurally, and the action generation
+ * tells when the F-Curves of the evaluated action have been replaced by a new copy.
+ */
+
+/* Channels evaluated on the calling thread below this amount. */
+#define COMPILED_ACTION_PARALLEL_THRESHOLD 1024
+
+typedef enum eAnimCompiledChannel_Flag {
+  /* The F-Curve is evaluated this time, its value is to be written. */
+  ANIM_COMPILED_CHANNEL_EVALUATED = (1 << 0),
+  /* The target in the original ID has been looked up, ... */
+  ANIM_COMPILED_CHANNEL_ORIG_RESOLVED = (1 << 1),
+  /* ... and was found. */
+  ANIM_COMPILED_CHANNEL_ORIG_VALID = (1 << 2),
+} eAnimCompiledChannel_Flag;
+
+typedef struct AnimCompiledChannel {
+  FCurve *fcu;
+  /* Target in the evaluated ID. */
+  PathResolvedRNA anim_rna;
+  /* Target in the original ID, for flushing the values. */
+  PathResolvedRNA orig_anim_rna;
+  /* Keyframe segment found at the previous evaluation. */
+  int cursor;
+  int flag;
+  float value;
+} AnimCompiledChannel;
+
+typedef struct AnimCompiledAction {
+  bAction *action;
+  int action_generation;
+
+  /* Only the F-Curves whose RNA path resolves, in the order of the action. */
+  AnimCompiledChannel *channels;
+  int channels_num;
+} AnimCompiledAction;
+
+static AnimCompiledAction *animsys_compile_action(PointerRNA *ptr, bAction *act)
+{
+  AnimCompiledAction *compiled = MEM_callocN(sizeof(*compiled), __func__);
+  compiled->action = act;
+  compiled->action_generation = act->eval_generation;
+  compiled->channels = MEM_malloc_arrayN(
+      BLI_listbase_count(&act->curves), sizeof(*compiled->channels), __func__);
+
+  LISTBASE_FOREACH (FCurve *, fcu, &act->curves) {
+    AnimCompiledChannel *channel = &compiled->channels[compiled->channels_num];
+    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &channel->anim_rna)) {
+      channel->fcu = fcu;
+      channel->cursor = 0;
+      channel->flag = 0;
+      channel->value = 0.0f;
+      compiled->channels_num++;
+    }
+  }
+
+  return compiled;
+}
+
+void BKE_animsys_free_compiled_action(AnimData *adt)
+{
+  if (adt->compiled_action != NULL) {
+    MEM_freeN(adt->compiled_action->channels);
+    MEM_freeN(adt->compiled_action);
+    adt->compiled_action = NULL;
+  }
+}
+
+typedef struct CompiledActionEvalData {
+  AnimCompiledAction *compiled;
+  const AnimationEvalContext *anim_eval_context;
+} CompiledActionEvalData;
+
+static void animsys_evaluate_compiled_channel(void *__restrict userdata,
+                                              const int index,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CompiledActionEvalData *data = userdata;
+  AnimCompiledChannel *channel = &data->compiled->channels[index];
+  FCurve *fcu = channel->fcu;
+
+  /* Muting is not a structural change, check it every time. */
+  if (!is_fcurve_evaluatable(fcu)) {
+    channel->flag &= ~ANIM_COMPILED_CHANNEL_EVALUATED;
+    return;
+  }
+
+  if (fcu->driver != NULL) {
+    channel->value = calculate_fcurve(&channel->anim_rna, fcu, data->anim_eval_context);
+  }
+  else {
+    channel->value = evaluate_fcurve_with_cursor(
+        fcu, data->anim_eval_context->eval_time, &channel->cursor);
+    fcu->curval = channel->value; /* Debug display only, not thread safe! */
+  }
+  channel->flag |= ANIM_COMPILED_CHANNEL_EVALUATED;
+}
+
+static void animsys_write_compiled_channel_orig(PointerRNA *ptr, AnimCompiledChannel *channel)
+{
+  if ((channel->flag & ANIM_COMPILED_CHANNEL_ORIG_RESOLVED) == 0) {
+    PointerRNA ptr_orig;
+    channel->flag |= ANIM_COMPILED_CHANNEL_ORIG_RESOLVED;
+    if (animsys_construct_orig_pointer_rna(ptr, &ptr_orig) &&
+        BKE_animsys_store_rna_setting(&ptr_orig,
+                                      channel->fcu->rna_path,
+                                      channel->fcu->array_index,
+                                      &channel->orig_anim_rna)) {
+      channel->flag |= ANIM_COMPILED_CHANNEL_ORIG_VALID;
+    }
+  }
+
+  if (channel->flag & ANIM_COMPILED_CHANNEL_ORIG_VALID) {
+    BKE_animsys_write_rna_setting(&channel->orig_anim_rna, channel->value);
+  }
+}
+
+/**
+ * Same as #animsys_evaluate_action for the active action of an evaluated ID, using the compiled
+ * action stored in its animation data. Returns false when the action can't be evaluated this way.
+ */
+static bool animsys_evaluate_compiled_action(PointerRNA *ptr,
+                                             AnimData *adt,
+                                             const AnimationEvalContext *anim_eval_context,
+                                             const bool flush_to_original)
+{
+  ID *id = ptr->owner_id;
+  bAction *act = adt->action;
+
+  /* Original data can change at any time, without anything telling the compiled action. */
+  if (id == NULL || (id->tag & LIB_TAG_COPIED_ON_WRITE) == 0) {
+    return false;
+  }
+
+  action_idcode_patch_check(id, act);
+
+  AnimCompiledAction *compiled = adt->compiled_action;
+  if (compiled != NULL &&
+      (compiled->action != act || compiled->action_generation != act->eval_generation)) {
+    BKE_animsys_free_compiled_action(adt);
+    compiled = NULL;
+  }
+  if (compiled == NULL) {
+    compiled = adt->compiled_action = animsys_compile_action(ptr, act);
+  }
+
+  /* The F-Curves are evaluated in parallel, but the values are written in order on this thread:
+   * RNA setters and updates of the same ID are not meant to run concurrently. */
+  CompiledActionEvalData data = {
+      .compiled = compiled,
+      .anim_eval_context = anim_eval_context,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = compiled->channels_num >= COMPILED_ACTION_PARALLEL_THRESHOLD;
+  settings.min_iter_per_thread = COMPILED_ACTION_PARALLEL_THRESHOLD / 4;
+  BLI_task_parallel_range(
+      0, compiled->channels_num, &data, animsys_evaluate_compiled_channel, &settings);
+
+  for (int i = 0; i < compiled->channels_num; i++) {
+    AnimCompiledChannel *channel = &compiled->channels[i];
+    if (channel->flag & ANIM_COMPILED_CHANNEL_EVALUATED) {
+      BKE_animsys_write_rna_setting(&channel->anim_rna, channel->value);
+      if (flush_to_original) {
+        animsys_write_compiled_channel_orig(ptr, channel);
+      }
+    }
+  }
+
+  return true;
+}
+
 /* ***************************************** */
 /* NLA System - Evaluation */
 
@@ -2864,7 +3043,9 @@ void BKE_animsys_evaluate_animdata(ID *id,
     }
     /* evaluate Active Action only */
     else if (adt->action) {
-      animsys_evaluate_action_ex(&id_ptr, adt->action, anim_eval_context, flush_to_original);
+      if (!animsys_evaluate_compiled_action(&id_ptr, adt, anim_eval_context, flush_to_original)) {
+        animsys_evaluate_action_ex(&id_ptr, adt->action, anim_eval_context, flush_to_original);
+      }
     }
   }
 
@@ -50,8 +50,10 @@
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
 #include "BKE_lattice.h"
+#include "BKE_mesh_runtime.h"
 
 #include "DEG_depsgraph_build.h"
+#include "DEG_depsgraph_query.h"
 
 #include "CLG_log.h"
 
@@ -237,6 +239,14 @@ static void pchan_bone_deform(bPoseChannel *pchan,
  * #BKE_armature_deform_coords and related functions.
  * \{ */
 
+/* Deforming bone of a vertex group, resolved once per evaluation. */
+typedef struct ArmatureDeformGroup {
+  /** NULL for groups without a deforming bone. */
+  bPoseChannel *pchan;
+  bool use_bbone;
+  bool use_envelope_multiply;
+} ArmatureDeformGroup;
+
 typedef struct ArmatureUserdata {
   const Object *ob_arm;
   const Object *ob_target;
@@ -258,6 +268,10 @@ typedef struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /** Packed weights of the target mesh, used instead of the deform vertices when set. */
+  const MeshDeformWeights *deform_weights;
+  const ArmatureDeformGroup *deform_groups;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -267,6 +281,90 @@ typedef struct ArmatureUserdata {
   } bmesh;
 } ArmatureUserdata;
 
+static float armature_vert_envelope_deform(
+    const ArmatureUserdata *data, float vec[3], DualQuat *dq, float mat[3][3], const float co[3])
+{
+  float contrib = 0.0f;
+  for (bPoseChannel *pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
+    if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+      contrib += dist_bone_deform(pchan, vec, dq, mat, co);
+    }
+  }
+  return contrib;
+}
+
+/**
+ * Accumulate the bones of the vertex groups from the packed weights. Plain bones blending
+ * linearly are summed into one weighted matrix, so the coordinate is transformed only once.
+ * Returns false when none of the groups has a deforming bone.
+ */
+static bool armature_vert_packed_weights_deform(const ArmatureUserdata *data,
+                                                const int i,
+                                                float vec[3],
+                                                DualQuat *dq,
+                                                float mat[3][3],
+                                                const float co[3],
+                                                float *contrib)
+{
+  const MeshDeformWeights *deform_weights = data->deform_weights;
+  const ArmatureDeformGroup *deform_groups = data->deform_groups;
+  const uint defbase_len = (uint)data->defbase_len;
+  float mat_accum[4][4];
+  float weight_accum = 0.0f;
+  bool deformed = false;
+
+  zero_m4(mat_accum);
+
+  for (int j = deform_weights->offsets[i]; j < deform_weights->offsets[i + 1]; j++) {
+    const uint def_nr = deform_weights->def_nrs[j];
+    if (def_nr >= defbase_len || deform_groups[def_nr].pchan == NULL) {
+      continue;
+    }
+    const ArmatureDeformGroup *group = &deform_groups[def_nr];
+    float weight = deform_weights->weights[j];
+
+    deformed = true;
+
+    if (group->use_envelope_multiply) {
+      const Bone *bone = group->pchan->bone;
+      weight *= distfactor_to_bone(
+          co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+    }
+
+    if (weight == 0.0f) {
+      continue;
+    }
+
+    if (group->use_bbone) {
+      b_bone_deform(group->pchan, co, weight, vec, dq, mat);
+    }
+    else if (dq) {
+      add_weighted_dq_dq(dq, &group->pchan->runtime.deform_dual_quat, weight);
+    }
+    else {
+      madd_m4_m4m4fl(mat_accum, mat_accum, group->pchan->chan_mat, weight);
+      weight_accum += weight;
+    }
+
+    (*contrib) += weight;
+  }
+
+  if (weight_accum != 0.0f) {
+    float tmp[3];
+    mul_v3_m4v3(tmp, mat_accum, co);
+    madd_v3_v3fl(tmp, co, -weight_accum);
+    add_v3_v3(vec, tmp);
+
+    if (mat) {
+      float tmpmat[3][3];
+      copy_m3_m4(tmpmat, mat_accum);
+      add_m3_m3m3(mat, mat, tmpmat);
+    }
+  }
+
+  return deformed;
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -327,7 +425,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+  if (data->deform_weights) {
+    /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
+    if (!armature_vert_packed_weights_deform(data, i, vec, dq, smat, co, &contrib) &&
+        use_envelope) {
+      contrib += armature_vert_envelope_deform(data, vec, dq, smat, co);
+    }
+  }
+  else if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     unsigned int j;
@@ -349,19 +454,11 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
-      for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
-        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-        }
-      }
+      contrib += armature_vert_envelope_deform(data, vec, dq, smat, co);
     }
   }
   else if (use_envelope) {
-    for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
-      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-      }
-    }
+    contrib += armature_vert_envelope_deform(data, vec, dq, smat, co);
   }
 
   /* actually should be EPSILON? weight values and contrib can be like 10e-39 small */
@@ -473,6 +570,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 {
   bArmature *arm = ob_arm->data;
   bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureDeformGroup *deform_groups = NULL;
+  const MeshDeformWeights *deform_weights = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -560,6 +659,33 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     }
   }
 
+  /* The weights of the evaluated copy of the mesh don't change between evaluations, use them
+   * packed from the mesh cache. Meshes created by modifiers may be changed in place and keep
+   * reading the deform vertices. */
+  if (use_dverts && defbase_len != 0 && ob_target->type == OB_MESH && em_target == NULL) {
+    Mesh *me = ob_target->data;
+    const MDeformVert *dverts_target = me_target ? me_target->dvert : dverts;
+    if (DEG_is_evaluated_id(&me->id) && dverts_target == me->dvert &&
+        vert_coords_len <= me->totvert &&
+        (me_target == NULL || me_target->totvert == me->totvert)) {
+      deform_weights = BKE_mesh_runtime_deform_weights_ensure(me);
+    }
+  }
+
+  if (deform_weights) {
+    deform_groups = MEM_malloc_arrayN(defbase_len, sizeof(*deform_groups), __func__);
+    for (i = 0; i < defbase_len; i++) {
+      bPoseChannel *pchan = pchan_from_defbase[i];
+      ArmatureDeformGroup *group = &deform_groups[i];
+      group->pchan = pchan;
+      if (pchan) {
+        const Bone *bone = pchan->bone;
+        group->use_bbone = bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments;
+        group->use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
+      }
+    }
+  }
+
   ArmatureUserdata data = {
       .ob_arm = ob_arm,
       .ob_target = ob_target,
@@ -576,6 +702,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .dverts_len = dverts_len,
       .pchan_from_defbase = pchan_from_defbase,
       .defbase_len = defbase_len,
+      .deform_weights = deform_weights,
+      .deform_groups = deform_groups,
       .bmesh =
           {
               .cd_dvert_offset = cd_dvert_offset,
@@ -611,6 +739,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
   }
+  MEM_SAFE_FREE(deform_groups);
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
@@ -25,10 +25,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_constraint_types.h"
 #include "DNA_object_types.h"
@@ -37,9 +40,11 @@
 #include "BKE_action.h"
 #include "BKE_anim_path.h"
 #include "BKE_armature.h"
+#include "BKE_constraint.h"
 #include "BKE_curve.h"
 #include "BKE_displist.h"
 #include "BKE_fcurve.h"
+#include "BKE_fcurve_driver.h"
 #include "BKE_object.h"
 #include "BKE_scene.h"
 
@@ -594,6 +599,7 @@ void BKE_splineik_execute_tree(
 void BKE_pose_pchan_index_rebuild(bPose *pose)
 {
   MEM_SAFE_FREE(pose->chan_array);
+  BKE_pose_eval_program_free(pose);
   const int num_channels = BLI_listbase_count(&pose->chanbase);
   pose->chan_array = MEM_malloc_arrayN(num_channels, sizeof(bPoseChannel *), "pose->chan_array");
   int pchan_index = 0;
@@ -913,3 +919,363 @@ void BKE_pose_eval_proxy_copy_bone(struct Depsgraph *depsgraph, Object *object,
 
   pose_channel_flush_to_orig_if_needed(depsgraph, object, pchan);
 }
+
+/* *************** Compiled pose evaluation ************ */
+
+/* A pose with #POSE_COMPILED_EVAL set is evaluated by a single dependency graph operation, which
+ * runs the same steps as the operations of the bones, in an order computed once. The steps are
+ * split in levels: a step only depends on steps of the previous levels, so the steps of a level
+ * are evaluated in parallel when there are enough of them. Rigs with independent chains give wide
+ * levels, long chains are evaluated serially without any scheduling overhead. */
+
+/* Steps of a level are only evaluated in parallel when there are at least this many of them. */
+#define POSE_EVAL_PARALLEL_THRESHOLD 64
+
+/* Every bone has two steps: its matrices, and then its B-Bone segments. */
+#define POSE_EVAL_STEP_BONE(pchan_index) ((pchan_index)*2)
+#define POSE_EVAL_STEP_SEGMENTS(pchan_index) ((pchan_index)*2 + 1)
+
+typedef struct bPoseEvalProgram {
+  /** Depsgraph build this program was made for, see #BKE_pose_eval_compiled. */
+  int generation;
+  int levels_num;
+  /** Steps sorted by level. */
+  int *steps;
+  /** Start of every level in steps, levels_num + 1 items. */
+  int *level_offsets;
+} bPoseEvalProgram;
+
+typedef struct PoseEvalConstraintIDData {
+  Object *object;
+  bool is_supported;
+} PoseEvalConstraintIDData;
+
+static void pose_eval_constraint_id_check(bConstraint *UNUSED(con),
+                                          ID **idpoin,
+                                          bool UNUSED(is_reference),
+                                          void *userdata)
+{
+  PoseEvalConstraintIDData *data = userdata;
+  if (*idpoin != NULL && *idpoin != &data->object->id) {
+    data->is_supported = false;
+  }
+}
+
+static bool pose_eval_drivers_use_object(const AnimData *adt, const Object *object)
+{
+  if (adt == NULL) {
+    return false;
+  }
+  LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
+    if (fcu->driver == NULL) {
+      continue;
+    }
+    LISTBASE_FOREACH (DriverVar *, dvar, &fcu->driver->variables) {
+      DRIVER_TARGETS_USED_LOOPER_BEGIN (dvar) {
+        if (dtar->id == &object->id) {
+          return true;
+        }
+      }
+      DRIVER_TARGETS_LOOPER_END;
+    }
+  }
+  return false;
+}
+
+/**
+ * Whether the pose is to be evaluated by #BKE_pose_eval_compiled. Only rigs which don't depend on
+ * anything else than their own object and bones are supported: dependencies on other data-blocks
+ * and IK solvers have to be interleaved with the bones by the dependency graph.
+ */
+bool BKE_pose_use_compiled_eval(Object *object)
+{
+  bPose *pose = object->pose;
+  if (pose == NULL || (pose->flag & POSE_COMPILED_EVAL) == 0) {
+    return false;
+  }
+  if (ID_IS_LINKED(object) && object->proxy_from != NULL) {
+    return false;
+  }
+  PoseEvalConstraintIDData data = {object, true};
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &pose->chanbase) {
+    LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+      if (ELEM(con->type,
+               CONSTRAINT_TYPE_KINEMATIC,
+               CONSTRAINT_TYPE_SPLINEIK,
+               CONSTRAINT_TYPE_FOLLOWTRACK,
+               CONSTRAINT_TYPE_CAMERASOLVER,
+               CONSTRAINT_TYPE_OBJECTSOLVER,
+               CONSTRAINT_TYPE_TRANSFORM_CACHE)) {
+        return false;
+      }
+    }
+    BKE_constraints_id_loop(&pchan->constraints, pose_eval_constraint_id_check, &data);
+    if (!data.is_supported) {
+      return false;
+    }
+  }
+  /* Drivers reading the pose would have to be evaluated in-between the bones. */
+  const bArmature *armature = object->data;
+  if (pose_eval_drivers_use_object(object->adt, object) ||
+      pose_eval_drivers_use_object(armature->adt, object)) {
+    return false;
+  }
+  return true;
+}
+
+static void pose_eval_program_add_dependency(int *deps, int *r_deps_num, const int dep)
+{
+  deps[(*r_deps_num)++] = dep;
+}
+
+static int pose_eval_program_step_dependencies(Object *object,
+                                               GHash *pchan_indices,
+                                               const int step,
+                                               int *deps,
+                                               const int deps_max)
+{
+  bPoseChannel *pchan = object->pose->chan_array[step / 2];
+  int deps_num = 0;
+
+#define PCHAN_INDEX(pchan_dep) POINTER_AS_INT(BLI_ghash_lookup(pchan_indices, pchan_dep))
+
+  if (step == POSE_EVAL_STEP_SEGMENTS(step / 2)) {
+    pose_eval_program_add_dependency(deps, &deps_num, POSE_EVAL_STEP_BONE(step / 2));
+    /* B-Bone shape depends on final position of handle bones. */
+    bPoseChannel *prev, *next;
+    BKE_pchan_bbone_handles_get(pchan, &prev, &next);
+    if (prev != NULL) {
+      const int prev_index = PCHAN_INDEX(prev);
+      pose_eval_program_add_dependency(deps, &deps_num, POSE_EVAL_STEP_BONE(prev_index));
+      /* Inheriting parent roll requires access to prev handle's B-Bone properties. */
+      if (pchan->bone != NULL && (pchan->bone->flag & BONE_ADD_PARENT_END_ROLL) != 0) {
+        pose_eval_program_add_dependency(deps, &deps_num, POSE_EVAL_STEP_SEGMENTS(prev_index));
+      }
+    }
+    if (next != NULL) {
+      pose_eval_program_add_dependency(deps, &deps_num, POSE_EVAL_STEP_BONE(PCHAN_INDEX(next)));
+    }
+    return deps_num;
+  }
+
+  if (pchan->parent != NULL) {
+    pose_eval_program_add_dependency(
+        deps, &deps_num, POSE_EVAL_STEP_BONE(PCHAN_INDEX(pchan->parent)));
+  }
+  LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+    const bConstraintTypeInfo *cti = BKE_constraint_typeinfo_get(con);
+    if (cti == NULL || cti->get_constraint_targets == NULL) {
+      continue;
+    }
+    ListBase targets = {NULL, NULL};
+    cti->get_constraint_targets(con, &targets);
+    LISTBASE_FOREACH (bConstraintTarget *, ct, &targets) {
+      if (ct->tar != object || ct->subtarget[0] == '\0' || deps_num == deps_max) {
+        continue;
+      }
+      bPoseChannel *pchan_target = BKE_pose_channel_find_name(object->pose, ct->subtarget);
+      if (pchan_target == NULL || pchan_target == pchan) {
+        continue;
+      }
+      const int target_index = PCHAN_INDEX(pchan_target);
+      pose_eval_program_add_dependency(deps,
+                                       &deps_num,
+                                       BKE_constraint_target_uses_bbone(con, ct) ?
+                                           POSE_EVAL_STEP_SEGMENTS(target_index) :
+                                           POSE_EVAL_STEP_BONE(target_index));
+    }
+    if (cti->flush_constraint_targets) {
+      cti->flush_constraint_targets(con, &targets, true);
+    }
+  }
+
+#undef PCHAN_INDEX
+
+  return deps_num;
+}
+
+static int pose_eval_program_step_dependencies_max(const bPoseChannel *pchan)
+{
+  /* Parent or the bone itself, the handles and the segments of the previous handle. */
+  int deps_max = 4;
+  LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+    const bConstraintTypeInfo *cti = BKE_constraint_typeinfo_get(con);
+    if (cti != NULL && cti->get_constraint_targets != NULL) {
+      ListBase targets = {NULL, NULL};
+      deps_max += cti->get_constraint_targets(con, &targets);
+      if (cti->flush_constraint_targets) {
+        cti->flush_constraint_targets(con, &targets, true);
+      }
+    }
+  }
+  return deps_max;
+}
+
+/* Topological sort of the steps, level by level (Kahn's algorithm). */
+static bPoseEvalProgram *pose_eval_program_build(Object *object, const int generation)
+{
+  bPose *pose = object->pose;
+  const int pchans_num = BLI_listbase_count(&pose->chanbase);
+  const int steps_num = pchans_num * 2;
+
+  GHash *pchan_indices = BLI_ghash_ptr_new_ex(__func__, (uint)pchans_num);
+  for (int i = 0; i < pchans_num; i++) {
+    BLI_ghash_insert(pchan_indices, pose->chan_array[i], POINTER_FROM_INT(i));
+  }
+
+  /* Dependencies of every step, as offsets in one array. */
+  int *deps_offsets = MEM_malloc_arrayN((size_t)steps_num + 1, sizeof(int), __func__);
+  int deps_max_num = 0;
+  for (int i = 0; i < pchans_num; i++) {
+    deps_max_num += pose_eval_program_step_dependencies_max(pose->chan_array[i]) * 2;
+  }
+  int *deps = MEM_malloc_arrayN((size_t)max_ii(deps_max_num, 1), sizeof(int), __func__);
+  int deps_num = 0;
+  for (int step = 0; step < steps_num; step++) {
+    const int deps_step_max = pose_eval_program_step_dependencies_max(pose->chan_array[step / 2]);
+    deps_offsets[step] = deps_num;
+    deps_num += pose_eval_program_step_dependencies(
+        object, pchan_indices, step, deps + deps_num, deps_step_max);
+  }
+  deps_offsets[steps_num] = deps_num;
+  BLI_ghash_free(pchan_indices, NULL, NULL);
+
+  /* Users of every step, to decrement their counter of remaining dependencies. */
+  int *users_offsets = MEM_calloc_arrayN((size_t)steps_num + 1, sizeof(int), __func__);
+  int *users = MEM_malloc_arrayN((size_t)max_ii(deps_num, 1), sizeof(int), __func__);
+  int *deps_remaining = MEM_malloc_arrayN((size_t)steps_num, sizeof(int), __func__);
+  for (int i = 0; i < deps_num; i++) {
+    users_offsets[deps[i] + 1]++;
+  }
+  for (int step = 0; step < steps_num; step++) {
+    users_offsets[step + 1] += users_offsets[step];
+    deps_remaining[step] = deps_offsets[step + 1] - deps_offsets[step];
+  }
+  int *users_cursor = MEM_dupallocN(users_offsets);
+  for (int step = 0; step < steps_num; step++) {
+    for (int i = deps_offsets[step]; i < deps_offsets[step + 1]; i++) {
+      users[users_cursor[deps[i]]++] = step;
+    }
+  }
+  MEM_freeN(users_cursor);
+
+  bPoseEvalProgram *program = MEM_callocN(sizeof(bPoseEvalProgram), __func__);
+  program->generation = generation;
+  program->steps = MEM_malloc_arrayN((size_t)max_ii(steps_num, 1), sizeof(int), __func__);
+  /* Every step in its own level is the worst case. */
+  program->level_offsets = MEM_malloc_arrayN((size_t)steps_num + 1, sizeof(int), __func__);
+
+  int sorted_num = 0;
+  for (int step = 0; step < steps_num; step++) {
+    if (deps_remaining[step] == 0) {
+      program->steps[sorted_num++] = step;
+    }
+  }
+  int level_start = 0;
+  while (sorted_num < steps_num || level_start < sorted_num) {
+    if (level_start == sorted_num) {
+      /* Dependency cycle, evaluate the first remaining step, the same way the dependency graph
+       * breaks cycles. */
+      for (int step = 0; step < steps_num; step++) {
+        if (deps_remaining[step] > 0) {
+          deps_remaining[step] = 0;
+          program->steps[sorted_num++] = step;
+          break;
+        }
+      }
+    }
+    const int level_end = sorted_num;
+    program->level_offsets[program->levels_num++] = level_start;
+    for (int i = level_start; i < level_end; i++) {
+      const int step = program->steps[i];
+      for (int j = users_offsets[step]; j < users_offsets[step + 1]; j++) {
+        if (--deps_remaining[users[j]] == 0) {
+          program->steps[sorted_num++] = users[j];
+        }
+      }
+    }
+    level_start = level_end;
+  }
+  program->level_offsets[program->levels_num] = sorted_num;
+
+  MEM_freeN(deps_offsets);
+  MEM_freeN(deps);
+  MEM_freeN(users_offsets);
+  MEM_freeN(users);
+  MEM_freeN(deps_remaining);
+  return program;
+}
+
+void BKE_pose_eval_program_free(bPose *pose)
+{
+  bPoseEvalProgram *program = pose->eval_program;
+  if (program == NULL) {
+    return;
+  }
+  MEM_freeN(program->steps);
+  MEM_freeN(program->level_offsets);
+  MEM_freeN(program);
+  pose->eval_program = NULL;
+}
+
+typedef struct PoseEvalProgramData {
+  struct Depsgraph *depsgraph;
+  Scene *scene;
+  Object *object;
+  const int *steps;
+} PoseEvalProgramData;
+
+static void pose_eval_program_step(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PoseEvalProgramData *data = userdata;
+  const int step = data->steps[i];
+  const int pchan_index = step / 2;
+  if (step == POSE_EVAL_STEP_SEGMENTS(pchan_index)) {
+    BKE_pose_eval_bbone_segments(data->depsgraph, data->object, pchan_index);
+    return;
+  }
+  BKE_pose_eval_bone(data->depsgraph, data->scene, data->object, pchan_index);
+  if (data->object->pose->chan_array[pchan_index]->constraints.first != NULL) {
+    BKE_pose_constraints_evaluate(data->depsgraph, data->scene, data->object, pchan_index);
+  }
+  BKE_pose_bone_done(data->depsgraph, data->object, pchan_index);
+}
+
+/**
+ * Evaluate all bones of the pose, replacing the operations of the bones.
+ *
+ * \param generation: Changes every time the dependency graph relations are rebuilt, since the
+ * dependencies of the bones might have changed.
+ */
+void BKE_pose_eval_compiled(struct Depsgraph *depsgraph,
+                            Scene *scene,
+                            Object *object,
+                            const int generation)
+{
+  const bArmature *armature = (bArmature *)object->data;
+  if (armature->edbo != NULL) {
+    return;
+  }
+  DEG_debug_print_eval(depsgraph, __func__, object->id.name, object);
+  bPose *pose = object->pose;
+  if (pose->eval_program != NULL && pose->eval_program->generation != generation) {
+    BKE_pose_eval_program_free(pose);
+  }
+  if (pose->eval_program == NULL) {
+    pose->eval_program = pose_eval_program_build(object, generation);
+  }
+  const bPoseEvalProgram *program = pose->eval_program;
+
+  PoseEvalProgramData data = {depsgraph, scene, object, program->steps};
+  for (int level = 0; level < program->levels_num; level++) {
+    const int start = program->level_offsets[level];
+    const int end = program->level_offsets[level + 1];
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (end - start >= POSE_EVAL_PARALLEL_THRESHOLD);
+    settings.min_iter_per_thread = POSE_EVAL_PARALLEL_THRESHOLD / 4;
+    BLI_task_parallel_range(start, end, &data, pose_eval_program_step, &settings);
+  }
+}
@@ -86,6 +86,26 @@ void ReadAttribute::initialize_span() const
   }
 }
 
+fn::GVSpan ReadAttribute::get_virtual_span() const
+{
+  const void *value = this->get_single_value_internal();
+  if (value != nullptr) {
+    return fn::GVSpan::FromSingle(cpp_type_, value, size_);
+  }
+  return fn::GVSpan(this->get_span());
+}
+
+const void *ReadAttribute::get_single_value_internal() const
+{
+  return nullptr;
+}
+
+bool ReadAttribute::try_get_strided_internal(const void **UNUSED(r_data),
+                                             int64_t *UNUSED(r_stride)) const
+{
+  return false;
+}
+
 WriteAttribute::~WriteAttribute()
 {
   if (array_should_be_applied_) {
@@ -157,6 +177,11 @@ void WriteAttribute::apply_span_if_necessary()
   }
 }
 
+bool WriteAttribute::try_get_strided_internal(void **UNUSED(r_data), int64_t *UNUSED(r_stride))
+{
+  return false;
+}
+
 class VertexWeightWriteAttribute final : public WriteAttribute {
  private:
   MDeformVert *dverts_;
@@ -250,6 +275,13 @@ template<typename T> class ArrayWriteAttribute final : public WriteAttribute {
   {
     /* Do nothing, because the span contains the attribute itself already. */
   }
+
+  bool try_get_strided_internal(void **r_data, int64_t *r_stride) override
+  {
+    *r_data = data_.data();
+    *r_stride = sizeof(T);
+    return true;
+  }
 };
 
 /* This is used by the #OutputAttributePtr class. */
@@ -298,6 +330,13 @@ class TemporaryWriteAttribute final : public WriteAttribute {
   {
     /* Do nothing, because the span contains the attribute itself already. */
   }
+
+  bool try_get_strided_internal(void **r_data, int64_t *r_stride) override
+  {
+    *r_data = data.data();
+    *r_stride = cpp_type_.size();
+    return true;
+  }
 };
 
 template<typename T> class ArrayReadAttribute final : public ReadAttribute {
@@ -321,64 +360,116 @@ template<typename T> class ArrayReadAttribute final : public ReadAttribute {
     array_buffer_ = const_cast<T *>(data_.data());
     array_is_temporary_ = false;
   }
+
+  bool try_get_strided_internal(const void **r_data, int64_t *r_stride) const override
+  {
+    *r_data = data_.data();
+    *r_stride = sizeof(T);
+    return true;
+  }
 };
 
-template<typename StructT, typename ElemT, typename GetFuncT, typename SetFuncT>
-class DerivedArrayWriteAttribute final : public WriteAttribute {
+/**
+ * Attribute stored in an array of structs, like the position of vertices in #MVert. The values
+ * are copied with a simple loop when a span is requested, and can be accessed in place with
+ * #WriteAttribute::try_get_strided_span.
+ */
+template<typename T> class StridedWriteAttribute final : public WriteAttribute {
  private:
-  MutableSpan<StructT> data_;
-  GetFuncT get_function_;
-  SetFuncT set_function_;
+  StridedSpan<T> data_;
 
  public:
-  DerivedArrayWriteAttribute(AttributeDomain domain,
-                             MutableSpan<StructT> data,
-                             GetFuncT get_function,
-                             SetFuncT set_function)
-      : WriteAttribute(domain, CPPType::get<ElemT>(), data.size()),
-        data_(data),
-        get_function_(std::move(get_function)),
-        set_function_(std::move(set_function))
+  StridedWriteAttribute(AttributeDomain domain, StridedSpan<T> data)
+      : WriteAttribute(domain, CPPType::get<T>(), data.size()), data_(data)
   {
   }
 
   void get_internal(const int64_t index, void *r_value) const override
   {
-    const StructT &struct_value = data_[index];
-    const ElemT value = get_function_(struct_value);
-    new (r_value) ElemT(value);
+    new (r_value) T(data_[index]);
   }
 
   void set_internal(const int64_t index, const void *value) override
   {
-    StructT &struct_value = data_[index];
-    const ElemT &typed_value = *reinterpret_cast<const ElemT *>(value);
-    set_function_(struct_value, typed_value);
+    data_[index] = *reinterpret_cast<const T *>(value);
+  }
+
+  void initialize_span(const bool write_only) override
+  {
+    T *buffer = (T *)MEM_mallocN_aligned(sizeof(T) * size_, alignof(T), __func__);
+    if (write_only) {
+      default_construct_n(buffer, size_);
+    }
+    else {
+      for (const int64_t i : data_.index_range()) {
+        new (buffer + i) T(data_[i]);
+      }
+    }
+    array_buffer_ = buffer;
+    array_is_temporary_ = true;
+  }
+
+  void apply_span_if_necessary() override
+  {
+    const T *buffer = static_cast<const T *>(array_buffer_);
+    for (const int64_t i : data_.index_range()) {
+      data_[i] = buffer[i];
+    }
+  }
+
+  bool try_get_strided_internal(void **r_data, int64_t *r_stride) override
+  {
+    *r_data = data_.data();
+    *r_stride = data_.stride();
+    return true;
   }
 };
 
-template<typename StructT, typename ElemT, typename GetFuncT>
-class DerivedArrayReadAttribute final : public ReadAttribute {
+template<typename T> class StridedReadAttribute final : public ReadAttribute {
  private:
-  Span<StructT> data_;
-  GetFuncT get_function_;
+  StridedSpan<const T> data_;
 
  public:
-  DerivedArrayReadAttribute(AttributeDomain domain, Span<StructT> data, GetFuncT get_function)
-      : ReadAttribute(domain, CPPType::get<ElemT>(), data.size()),
-        data_(data),
-        get_function_(std::move(get_function))
+  StridedReadAttribute(AttributeDomain domain, StridedSpan<const T> data)
+      : ReadAttribute(domain, CPPType::get<T>(), data.size()), data_(data)
   {
   }
 
   void get_internal(const int64_t index, void *r_value) const override
   {
-    const StructT &struct_value = data_[index];
-    const ElemT value = get_function_(struct_value);
-    new (r_value) ElemT(value);
+    new (r_value) T(data_[index]);
+  }
+
+  void initialize_span() const override
+  {
+    T *buffer = (T *)MEM_mallocN_aligned(sizeof(T) * size_, alignof(T), __func__);
+    for (const int64_t i : data_.index_range()) {
+      new (buffer + i) T(data_[i]);
+    }
+    array_buffer_ = buffer;
+    array_is_temporary_ = true;
+  }
+
+  bool try_get_strided_internal(const void **r_data, int64_t *r_stride) const override
+  {
+    *r_data = data_.data();
+    *r_stride = data_.stride();
+    return true;
   }
 };
 
+/* Access a member of all structs in an array, e.g. the position of vertices in #MVert. */
+template<typename T, typename StructT>
+static StridedSpan<T> get_struct_member_span(StructT *structs,
+                                             const int64_t size,
+                                             const int64_t member_offset)
+{
+  if (structs == nullptr) {
+    return {};
+  }
+  return StridedSpan<T>((T *)POINTER_OFFSET(structs, member_offset), size, sizeof(StructT));
+}
+
 class ConstantReadAttribute final : public ReadAttribute {
  private:
   void *value_;
@@ -412,6 +503,11 @@ class ConstantReadAttribute final : public ReadAttribute {
     array_is_temporary_ = true;
     cpp_type_.fill_uninitialized(value_, array_buffer_, size_);
   }
+
+  const void *get_single_value_internal() const override
+  {
+    return value_;
+  }
 };
 
 class ConvertedReadAttribute final : public ReadAttribute {
@@ -444,6 +540,22 @@ class ConvertedReadAttribute final : public ReadAttribute {
     base_attribute_->get(index, buffer.ptr());
     conversions_.convert(from_type_, to_type_, buffer.ptr(), r_value);
   }
+
+  void initialize_span() const override
+  {
+    /* Convert all values with a single call of the conversion function rather than converting
+     * them one by one. */
+    const fn::MultiFunction &fn = *conversions_.get_conversion(
+        fn::MFDataType::ForSingle(from_type_), fn::MFDataType::ForSingle(to_type_));
+    array_buffer_ = MEM_mallocN_aligned(size_ * to_type_.size(), to_type_.alignment(), __func__);
+    array_is_temporary_ = true;
+
+    fn::MFParamsBuilder params{fn, size_};
+    params.add_readonly_single_input(base_attribute_->get_virtual_span());
+    params.add_uninitialized_single_output(fn::GMutableSpan(to_type_, array_buffer_, size_));
+    fn::MFContextBuilder context;
+    fn.call(IndexRange(size_), params, context);
+  }
 };
 
 /** \} */
@@ -527,9 +639,10 @@ static ReadAttributePtr read_attribute_from_custom_data(const CustomData &custom
           return std::make_unique<ArrayReadAttribute<bool>>(
               domain, Span(static_cast<bool *>(layer.data), size));
         case CD_MLOOPUV:
-          auto get_uv = [](const MLoopUV &uv) { return float2(uv.uv); };
-          return std::make_unique<DerivedArrayReadAttribute<MLoopUV, float2, decltype(get_uv)>>(
-              domain, Span(static_cast<MLoopUV *>(layer.data), size), get_uv);
+          return std::make_unique<StridedReadAttribute<float2>>(
+              domain,
+              get_struct_member_span<const float2>(
+                  static_cast<const MLoopUV *>(layer.data), size, offsetof(MLoopUV, uv)));
       }
     }
   }
@@ -575,11 +688,10 @@ static WriteAttributePtr write_attribute_from_custom_data(
           return std::make_unique<ArrayWriteAttribute<bool>>(
               domain, MutableSpan(static_cast<bool *>(layer.data), size));
         case CD_MLOOPUV:
-          auto get_uv = [](const MLoopUV &uv) { return float2(uv.uv); };
-          auto set_uv = [](MLoopUV &uv, const float2 value) { copy_v2_v2(uv.uv, value); };
-          return std::make_unique<
-              DerivedArrayWriteAttribute<MLoopUV, float2, decltype(get_uv), decltype(set_uv)>>(
-              domain, MutableSpan(static_cast<MLoopUV *>(layer.data), size), get_uv, set_uv);
+          return std::make_unique<StridedWriteAttribute<float2>>(
+              domain,
+              get_struct_member_span<float2>(
+                  static_cast<MLoopUV *>(layer.data), size, offsetof(MLoopUV, uv)));
       }
     }
   }
@@ -1133,10 +1245,10 @@ ReadAttributePtr MeshComponent::attribute_try_get_for_read(const StringRef attri
   }
 
   if (attribute_name == "position") {
-    auto get_vertex_position = [](const MVert &vert) { return float3(vert.co); };
-    return std::make_unique<
-        blender::bke::DerivedArrayReadAttribute<MVert, float3, decltype(get_vertex_position)>>(
-        ATTR_DOMAIN_POINT, blender::Span(mesh_->mvert, mesh_->totvert), get_vertex_position);
+    return std::make_unique<blender::bke::StridedReadAttribute<float3>>(
+        ATTR_DOMAIN_POINT,
+        blender::bke::get_struct_member_span<const float3>(
+            (const MVert *)mesh_->mvert, mesh_->totvert, offsetof(MVert, co)));
   }
 
   ReadAttributePtr corner_attribute = read_attribute_from_custom_data(
@@ -1187,17 +1299,10 @@ WriteAttributePtr MeshComponent::attribute_try_get_for_write(const StringRef att
     CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
     update_mesh_pointers();
 
-    auto get_vertex_position = [](const MVert &vert) { return float3(vert.co); };
-    auto set_vertex_position = [](MVert &vert, const float3 &co) { copy_v3_v3(vert.co, co); };
-    return std::make_unique<
-        blender::bke::DerivedArrayWriteAttribute<MVert,
-                                                 float3,
-                                                 decltype(get_vertex_position),
-                                                 decltype(set_vertex_position)>>(
+    return std::make_unique<blender::bke::StridedWriteAttribute<float3>>(
         ATTR_DOMAIN_POINT,
-        blender::MutableSpan(mesh_->mvert, mesh_->totvert),
-        get_vertex_position,
-        set_vertex_position);
+        blender::bke::get_struct_member_span<float3>(
+            mesh_->mvert, mesh_->totvert, offsetof(MVert, co)));
   }
 
   WriteAttributePtr corner_attribute = write_attribute_from_custom_data(
@@ -44,6 +44,7 @@
 #include "BKE_brush.h"
 #include "BKE_cachefile.h"
 #include "BKE_callbacks.h"
+#include "BKE_fcurve_driver.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
 #include "BKE_image.h"
@@ -82,6 +83,11 @@ void BKE_blender_free(void)
   BKE_main_free(G_MAIN);
   G_MAIN = NULL;
 
+  if (G.debug & G_DEBUG_DRIVERS) {
+    BKE_driver_python_profile_print();
+  }
+  BKE_driver_python_profile_free();
+
   if (G.log.file != NULL) {
     fclose(G.log.file);
   }
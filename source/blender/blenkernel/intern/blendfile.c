@@ -152,6 +152,10 @@ static void setup_app_data(bContext *C,
     BLI_assert(bfd->curscene != NULL);
     mode = LOAD_UNDO;
   }
+  /* UI data-blocks were not read, keep the current ones. */
+  else if (params->skip_flags & BLO_READ_SKIP_UI) {
+    mode = LOAD_UI_OFF;
+  }
   /* may happen with library files - UNDO file should never have NULL curscene (but may have a
    * NULL curscreen)... */
   else if (ELEM(NULL, bfd->curscreen, bfd->curscene)) {
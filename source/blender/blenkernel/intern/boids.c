@@ -777,8 +777,8 @@ static bool rule_fight(BoidRule *rule, BoidBrainData *bbd, BoidValues *val, Part
 
       /* must face enemy to fight */
       if (dot_v3v3(pa->prev_state.ave, enemy_dir) > 0.5f) {
-        bpa = enemy_pa->boid;
-        bpa->data.health -= bbd->part->boids->strength * bbd->timestep *
+        bbd->enemy = enemy_pa->boid;
+        bbd->enemy_damage = bbd->part->boids->strength * bbd->timestep *
                             ((1.0f - bbd->part->boids->accuracy) * damage +
                              bbd->part->boids->accuracy);
       }
@@ -1087,6 +1087,9 @@ void boid_brain(BoidBrainData *bbd, int p, ParticleData *pa)
   int rand;
   // BoidCondition *cond;
 
+  bbd->jump = false;
+  bbd->enemy = NULL;
+
   if (bpa->data.health <= 0.0f) {
     pa->alive = PARS_DYING;
     pa->dietime = bbd->cfra;
@@ -1225,7 +1228,9 @@ void boid_brain(BoidBrainData *bbd, int p, ParticleData *pa)
       }
 
       if (jump) {
-        copy_v3_v3(pa->prev_state.vel, jump_v);
+        /* Other brains read the previous velocity, set it in #boid_body. */
+        copy_v3_v3(bbd->jump_vel, jump_v);
+        bbd->jump = true;
         bpa->data.mode = eBoidMode_Falling;
       }
     }
@@ -1250,6 +1255,10 @@ void boid_body(BoidBrainData *bbd, ParticleData *pa)
 
   set_boid_values(&val, boids, pa);
 
+  if (bbd->jump) {
+    copy_v3_v3(pa->prev_state.vel, bbd->jump_vel);
+  }
+
   /* make sure there's something in new velocity, location & rotation */
   copy_particle_key(&pa->state, &pa->prev_state, 0);
 
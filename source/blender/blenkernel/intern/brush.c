@@ -2458,6 +2458,84 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+/**
+ * Same as #BKE_brush_curve_strength for \a num distances at once. The curve preset is only
+ * checked once, so the loops over the values can be vectorized.
+ */
+void BKE_brush_curve_strength_array(const Brush *br,
+                                    const float *dists,
+                                    const int num,
+                                    const float len,
+                                    float *r_strengths)
+{
+  for (int i = 0; i < num; i++) {
+    r_strengths[i] = max_ff(1.0f - dists[i] / len, 0.0f);
+  }
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      for (int i = 0; i < num; i++) {
+        r_strengths[i] = BKE_curvemapping_evaluateF(br->curve, 0, 1.0f - r_strengths[i]);
+      }
+      break;
+    case BRUSH_CURVE_SHARP:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = p * p;
+      }
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = 3.0f * p * p - 2.0f * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = pow3f(p) * (p * (p * 6.0f - 15.0f) + 10.0f);
+      }
+      break;
+    case BRUSH_CURVE_ROOT:
+      for (int i = 0; i < num; i++) {
+        r_strengths[i] = sqrtf(r_strengths[i]);
+      }
+      break;
+    case BRUSH_CURVE_LIN:
+      break;
+    case BRUSH_CURVE_CONSTANT:
+      for (int i = 0; i < num; i++) {
+        r_strengths[i] = 1.0f;
+      }
+      break;
+    case BRUSH_CURVE_SPHERE:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = sqrtf(2 * p - p * p);
+      }
+      break;
+    case BRUSH_CURVE_POW4:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = p * p * p * p;
+      }
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      for (int i = 0; i < num; i++) {
+        const float p = r_strengths[i];
+        r_strengths[i] = p * (2.0f - p);
+      }
+      break;
+  }
+
+  /* Outside of the radius, also for presets which are not zero there. */
+  for (int i = 0; i < num; i++) {
+    if (dists[i] >= len) {
+      r_strengths[i] = 0.0f;
+    }
+  }
+}
+
 /* Uses the brush curve control to find a strength value between 0 and 1 */
 float BKE_brush_curve_strength_clamped(Brush *br, float p, const float len)
 {
@@ -2516,12 +2594,18 @@ struct ImBuf *BKE_brush_gen_radial_control_imbuf(Brush *br, bool secondary, bool
   im->x = im->y = side;
 
   if (display_gradient || texcache) {
+    float *magn = MEM_mallocN(sizeof(*magn) * side, __func__);
     for (i = 0; i < side; i++) {
+      float *row = &im->rect_float[i * side];
+      for (j = 0; j < side; j++) {
+        magn[j] = sqrtf(pow2f(i - half) + pow2f(j - half));
+      }
+      BKE_brush_curve_strength_array(br, magn, side, half, row);
       for (j = 0; j < side; j++) {
-        float magn = sqrtf(pow2f(i - half) + pow2f(j - half));
-        im->rect_float[i * side + j] = BKE_brush_curve_strength_clamped(br, magn, half);
+        CLAMP(row[j], 0.0f, 1.0f);
       }
     }
+    MEM_freeN(magn);
   }
 
   if (texcache) {
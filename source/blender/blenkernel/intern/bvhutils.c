@@ -47,6 +47,10 @@
 typedef struct BVHCacheItem {
   bool is_filled;
   BVHTree *tree;
+  /** Tree of a previous mesh with the same topology, refitted instead of built on first use. */
+  BVHTree *tree_refit;
+  /** Set when `tree_refit` was given, constant afterwards so it can be read without locking. */
+  bool has_tree_refit;
 } BVHCacheItem;
 
 typedef struct BVHCache {
@@ -154,11 +158,48 @@ void bvhcache_free(BVHCache *bvh_cache)
     BVHCacheItem *item = &bvh_cache->items[index];
     BLI_bvhtree_free(item->tree);
     item->tree = NULL;
+    if (item->tree_refit) {
+      BLI_bvhtree_free(item->tree_refit);
+      item->tree_refit = NULL;
+    }
   }
   BLI_mutex_end(&bvh_cache->mutex);
   MEM_freeN(bvh_cache);
 }
 
+/**
+ * Prepare the cache of a mesh to be used by a new mesh with the same topology and different
+ * vertex coordinates, the trees are refitted to the new coordinates when they are requested
+ * again instead of being built from scratch. Trees of tessellated faces and edit-mesh trees are
+ * freed, their elements might not be available in the new mesh.
+ *
+ * Only call this on a cache which isn't used by any mesh, before giving it to the new one.
+ */
+void bvhcache_prepare_refit(BVHCache *bvh_cache)
+{
+  for (BVHCacheType index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (item->tree_refit) {
+      /* Never used since the previous refit. */
+      BLI_bvhtree_free(item->tree_refit);
+      item->tree_refit = NULL;
+    }
+    if (item->tree && !ELEM(index,
+                            BVHTREE_FROM_FACES,
+                            BVHTREE_FROM_EM_VERTS,
+                            BVHTREE_FROM_EM_EDGES,
+                            BVHTREE_FROM_EM_LOOPTRI)) {
+      item->tree_refit = item->tree;
+    }
+    else {
+      BLI_bvhtree_free(item->tree);
+    }
+    item->tree = NULL;
+    item->is_filled = false;
+    item->has_tree_refit = item->tree_refit != NULL;
+  }
+}
+
 /** \} */
 /* -------------------------------------------------------------------- */
 /** \name Local Callbacks
@@ -530,6 +571,49 @@ static void mesh_edges_spherecast(void *userdata,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Leaf Coordinates
+ * \{ */
+
+/* Coordinates of the elements stored in the leafs, for #BLI_bvhtree_insert_many and
+ * #BLI_bvhtree_refit. */
+typedef struct BVHLeafCoordsData {
+  const MVert *vert;
+  const MEdge *edge;
+  const MLoop *loop;
+  const MLoopTri *looptri;
+} BVHLeafCoordsData;
+
+static int mesh_verts_leaf_coords(void *userdata, int index, float r_co[BVH_LEAF_POINTS_MAX][3])
+{
+  const BVHLeafCoordsData *data = userdata;
+  copy_v3_v3(r_co[0], data->vert[index].co);
+  return 1;
+}
+
+static int mesh_edges_leaf_coords(void *userdata, int index, float r_co[BVH_LEAF_POINTS_MAX][3])
+{
+  const BVHLeafCoordsData *data = userdata;
+  const MEdge *edge = &data->edge[index];
+  copy_v3_v3(r_co[0], data->vert[edge->v1].co);
+  copy_v3_v3(r_co[1], data->vert[edge->v2].co);
+  return 2;
+}
+
+static int mesh_looptri_leaf_coords(void *userdata,
+                                    int index,
+                                    float r_co[BVH_LEAF_POINTS_MAX][3])
+{
+  const BVHLeafCoordsData *data = userdata;
+  const MLoopTri *lt = &data->looptri[index];
+  copy_v3_v3(r_co[0], data->vert[data->loop[lt->tri[0]].v].co);
+  copy_v3_v3(r_co[1], data->vert[data->loop[lt->tri[1]].v].co);
+  copy_v3_v3(r_co[2], data->vert[data->loop[lt->tri[2]].v].co);
+  return 3;
+}
+
+/** \} */
+
 /*
  * BVH builders
  */
@@ -592,11 +676,17 @@ static BVHTree *bvhtree_from_mesh_verts_create_tree(float epsilon,
     tree = BLI_bvhtree_new(verts_num_active, epsilon, tree_type, axis);
 
     if (tree) {
-      for (int i = 0; i < verts_num; i++) {
-        if (verts_mask && !BLI_BITMAP_TEST_BOOL(verts_mask, i)) {
-          continue;
+      if (verts_mask == NULL) {
+        BVHLeafCoordsData data = {.vert = vert};
+        BLI_bvhtree_insert_many(tree, NULL, verts_num, mesh_verts_leaf_coords, &data);
+      }
+      else {
+        for (int i = 0; i < verts_num; i++) {
+          if (!BLI_BITMAP_TEST_BOOL(verts_mask, i)) {
+            continue;
+          }
+          BLI_bvhtree_insert(tree, i, vert[i].co, 1);
         }
-        BLI_bvhtree_insert(tree, i, vert[i].co, 1);
       }
       BLI_assert(BLI_bvhtree_get_len(tree) == verts_num_active);
       BLI_bvhtree_balance(tree);
@@ -798,15 +888,21 @@ static BVHTree *bvhtree_from_mesh_edges_create_tree(const MVert *vert,
     /* Create a bvh-tree of the given target */
     tree = BLI_bvhtree_new(edges_num_active, epsilon, tree_type, axis);
     if (tree) {
-      for (int i = 0; i < edge_num; i++) {
-        if (edges_mask && !BLI_BITMAP_TEST_BOOL(edges_mask, i)) {
-          continue;
-        }
-        float co[2][3];
-        copy_v3_v3(co[0], vert[edge[i].v1].co);
-        copy_v3_v3(co[1], vert[edge[i].v2].co);
+      if (edges_mask == NULL) {
+        BVHLeafCoordsData data = {.vert = vert, .edge = edge};
+        BLI_bvhtree_insert_many(tree, NULL, edge_num, mesh_edges_leaf_coords, &data);
+      }
+      else {
+        for (int i = 0; i < edge_num; i++) {
+          if (!BLI_BITMAP_TEST_BOOL(edges_mask, i)) {
+            continue;
+          }
+          float co[2][3];
+          copy_v3_v3(co[0], vert[edge[i].v1].co);
+          copy_v3_v3(co[1], vert[edge[i].v2].co);
 
-        BLI_bvhtree_insert(tree, i, co[0], 2);
+          BLI_bvhtree_insert(tree, i, co[0], 2);
+        }
       }
       BLI_bvhtree_balance(tree);
     }
@@ -1157,10 +1253,14 @@ static BVHTree *bvhtree_from_mesh_looptri_create_tree(float epsilon,
     /* printf("%s: building BVH, total=%d\n", __func__, numFaces); */
     tree = BLI_bvhtree_new(looptri_num_active, epsilon, tree_type, axis);
     if (tree) {
-      if (vert && looptri) {
+      if (vert && looptri && looptri_mask == NULL) {
+        BVHLeafCoordsData data = {.vert = vert, .loop = mloop, .looptri = looptri};
+        BLI_bvhtree_insert_many(tree, NULL, looptri_num, mesh_looptri_leaf_coords, &data);
+      }
+      else if (vert && looptri) {
         for (int i = 0; i < looptri_num; i++) {
           float co[3][3];
-          if (looptri_mask && !BLI_BITMAP_TEST_BOOL(looptri_mask, i)) {
+          if (!BLI_BITMAP_TEST_BOOL(looptri_mask, i)) {
             continue;
           }
 
@@ -1409,6 +1509,71 @@ static BLI_bitmap *looptri_no_hidden_map_get(const MPoly *mpoly,
 /**
  * Builds or queries a bvhcache for the cache bvhtree of the request type.
  */
+/**
+ * Use the tree given by #bvhcache_prepare_refit for the new coordinates of the mesh.
+ * Returns false when there is no such tree.
+ */
+static bool bvhcache_refit_from_mesh(BVHCache *bvh_cache,
+                                     const BVHCacheType bvh_cache_type,
+                                     const Mesh *mesh,
+                                     const MLoopTri *looptri,
+                                     BVHTree **r_tree)
+{
+  BVHCacheItem *item = &bvh_cache->items[bvh_cache_type];
+  bool found = false;
+
+  BLI_mutex_lock(&bvh_cache->mutex);
+  if (item->is_filled) {
+    /* Refitted by another thread. */
+    *r_tree = item->tree;
+    found = true;
+  }
+  else if (item->tree_refit) {
+    BVHLeafCoordsData data = {
+        .vert = mesh->mvert,
+        .edge = mesh->medge,
+        .loop = mesh->mloop,
+        .looptri = looptri,
+    };
+    BVHTree_LeafCoordsCallback callback = NULL;
+    switch (bvh_cache_type) {
+      case BVHTREE_FROM_VERTS:
+      case BVHTREE_FROM_LOOSEVERTS:
+        callback = mesh_verts_leaf_coords;
+        break;
+      case BVHTREE_FROM_EDGES:
+      case BVHTREE_FROM_LOOSEEDGES:
+        callback = mesh_edges_leaf_coords;
+        break;
+      case BVHTREE_FROM_LOOPTRI:
+      case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
+        callback = mesh_looptri_leaf_coords;
+        break;
+      case BVHTREE_FROM_FACES:
+      case BVHTREE_FROM_EM_VERTS:
+      case BVHTREE_FROM_EM_EDGES:
+      case BVHTREE_FROM_EM_LOOPTRI:
+      case BVHTREE_MAX_ITEM:
+        BLI_assert(false);
+        break;
+    }
+
+    if (callback) {
+      BLI_bvhtree_refit(item->tree_refit, callback, &data);
+      bvhcache_insert(bvh_cache, item->tree_refit, bvh_cache_type);
+      *r_tree = item->tree;
+      found = true;
+    }
+    else {
+      BLI_bvhtree_free(item->tree_refit);
+    }
+    item->tree_refit = NULL;
+  }
+  BLI_mutex_unlock(&bvh_cache->mutex);
+
+  return found;
+}
+
 BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    struct Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
@@ -1420,6 +1585,16 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
 
   bool is_cached = bvhcache_find(bvh_cache_p, bvh_cache_type, &tree, NULL, NULL);
 
+  if (!is_cached && *bvh_cache_p != NULL && (*bvh_cache_p)->items[bvh_cache_type].has_tree_refit) {
+    /* Ensure the triangles before locking the cache, they use the mesh evaluation mutex. */
+    const MLoopTri *looptri = ELEM(bvh_cache_type,
+                                   BVHTREE_FROM_LOOPTRI,
+                                   BVHTREE_FROM_LOOPTRI_NO_HIDDEN) ?
+                                  BKE_mesh_runtime_looptri_ensure(mesh) :
+                                  NULL;
+    is_cached = bvhcache_refit_from_mesh(*bvh_cache_p, bvh_cache_type, mesh, looptri, &tree);
+  }
+
   if (is_cached && tree == NULL) {
     memset(data, 0, sizeof(*data));
     return tree;
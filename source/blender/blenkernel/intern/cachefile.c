@@ -55,6 +55,10 @@
 #  include "ABC_alembic.h"
 #endif
 
+#ifdef WITH_USD
+#  include "usd.h"
+#endif
+
 static void cachefile_handle_free(CacheFile *cache_file);
 
 static void cache_file_init_data(ID *id)
@@ -164,15 +168,27 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
                                Object *object,
                                const char *object_path)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   BLI_assert(cache_file->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
   if (cache_file->handle == NULL) {
     return;
   }
 
-  /* Open Alembic cache reader. */
-  *reader = CacheReader_open_alembic_object(cache_file->handle, *reader, object, object_path);
+  switch (cache_file->type) {
+    case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+      /* Open Alembic cache reader. */
+      *reader = CacheReader_open_alembic_object(cache_file->handle, *reader, object, object_path);
+#  endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+      /* Open USD cache reader. */
+      *reader = CacheReader_open_usd_object(cache_file->handle, *reader, object, object_path);
+#  endif
+      break;
+  }
 
   /* Multiple modifiers and constraints can call this function concurrently. */
   BLI_spin_lock(&spin);
@@ -184,7 +200,7 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
     BLI_gset_reinsert(cache_file->handle_readers, reader, NULL);
   }
   else if (cache_file->handle_readers) {
-    /* Remove in case CacheReader_open_alembic_object free the existing reader. */
+    /* Remove in case the open function freed the existing reader. */
     BLI_gset_remove(cache_file->handle_readers, reader, NULL);
   }
   BLI_spin_unlock(&spin);
@@ -193,15 +209,35 @@ void BKE_cachefile_reader_open(CacheFile *cache_file,
 #endif
 }
 
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
+static void cachefile_reader_free_for_type(const char type, struct CacheReader *reader)
+{
+  switch (type) {
+    case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+      ABC_CacheReader_free(reader);
+#  endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+      USD_CacheReader_free(reader);
+#  endif
+      break;
+  }
+}
+#endif
+
 void BKE_cachefile_reader_free(CacheFile *cache_file, struct CacheReader **reader)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   if (*reader != NULL) {
     if (cache_file) {
       BLI_assert(cache_file->id.tag & LIB_TAG_COPIED_ON_WRITE);
     }
 
-    CacheReader_free(*reader);
+    /* Readers are only opened through a cache file, without one assume the original format. */
+    cachefile_reader_free_for_type(cache_file ? cache_file->type : CACHEFILE_TYPE_ALEMBIC,
+                                   *reader);
     *reader = NULL;
 
     /* Multiple modifiers and constraints can call this function concurrently. */
@@ -218,7 +254,7 @@ void BKE_cachefile_reader_free(CacheFile *cache_file, struct CacheReader **reade
 
 static void cachefile_handle_free(CacheFile *cache_file)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   /* Free readers in all modifiers and constraints that use the handle, before
    * we free the handle itself. */
   BLI_spin_lock(&spin);
@@ -227,7 +263,7 @@ static void cachefile_handle_free(CacheFile *cache_file)
     GSET_ITER (gs_iter, cache_file->handle_readers) {
       struct CacheReader **reader = BLI_gsetIterator_getKey(&gs_iter);
       if (*reader != NULL) {
-        CacheReader_free(*reader);
+        cachefile_reader_free_for_type(cache_file->type, *reader);
         *reader = NULL;
       }
     }
@@ -239,7 +275,18 @@ static void cachefile_handle_free(CacheFile *cache_file)
 
   /* Free handle. */
   if (cache_file->handle) {
-    ABC_free_handle(cache_file->handle);
+    switch (cache_file->type) {
+      case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+        ABC_free_handle(cache_file->handle);
+#  endif
+        break;
+      case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+        USD_free_handle(cache_file->handle);
+#  endif
+        break;
+    }
     cache_file->handle = NULL;
   }
 
@@ -285,16 +332,30 @@ void BKE_cachefile_eval(Main *bmain, Depsgraph *depsgraph, CacheFile *cache_file
   cachefile_handle_free(cache_file);
   BLI_freelistN(&cache_file->object_paths);
 
+  cache_file->type = BKE_cachefile_filepath_is_usd(filepath) ? CACHEFILE_TYPE_USD :
+                                                               CACHEFILE_TYPE_ALEMBIC;
+
+  switch (cache_file->type) {
+    case CACHEFILE_TYPE_ALEMBIC:
 #ifdef WITH_ALEMBIC
-  cache_file->handle = ABC_create_handle(bmain, filepath, &cache_file->object_paths);
-  BLI_strncpy(cache_file->handle_filepath, filepath, FILE_MAX);
+      cache_file->handle = ABC_create_handle(bmain, filepath, &cache_file->object_paths);
+      BLI_strncpy(cache_file->handle_filepath, filepath, FILE_MAX);
+#endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#ifdef WITH_USD
+      cache_file->handle = USD_create_handle(bmain, filepath, &cache_file->object_paths);
+      BLI_strncpy(cache_file->handle_filepath, filepath, FILE_MAX);
 #endif
+      break;
+  }
 
   if (DEG_is_active(depsgraph)) {
-    /* Flush object paths back to original datablock for UI. */
+    /* Flush object paths and type back to original datablock for UI. */
     CacheFile *cache_file_orig = (CacheFile *)DEG_get_original_id(&cache_file->id);
     BLI_freelistN(&cache_file_orig->object_paths);
     BLI_duplicatelist(&cache_file_orig->object_paths, &cache_file->object_paths);
+    cache_file_orig->type = cache_file->type;
   }
 }
 
@@ -327,6 +388,11 @@ bool BKE_cachefile_filepath_get(const Main *bmain,
   return true;
 }
 
+bool BKE_cachefile_filepath_is_usd(const char *filepath)
+{
+  return BLI_path_extension_check_n(filepath, ".usd", ".usda", ".usdc", NULL);
+}
+
 float BKE_cachefile_time_offset(const CacheFile *cache_file, const float time, const float fps)
 {
   const float time_offset = cache_file->frame_offset / fps;
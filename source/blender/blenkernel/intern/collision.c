@@ -53,10 +53,14 @@
 #include "DEG_depsgraph_physics.h"
 #include "DEG_depsgraph_query.h"
 
+#include "CLG_log.h"
+
 #ifdef WITH_ELTOPO
 #  include "eltopo-capi.h"
 #endif
 
+static CLG_LogRef LOG = {"bke.collision"};
+
 typedef struct ColDetectData {
   ClothModifierData *clmd;
   CollisionModifierData *collmd;
@@ -837,107 +841,148 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+/* Result of the impulse computation for a self collision pair. */
+enum {
+  /* Not a static collision, the pair is ignored. */
+  SELFCOL_PAIR_SKIP = 0,
+  SELFCOL_PAIR_NO_IMPULSE,
+  SELFCOL_PAIR_IMPULSE,
+};
+
+typedef struct SelfColPairImpulse {
+  float ia[3][3];
+  float ib[3][3];
+  char state;
+} SelfColPairImpulse;
+
+typedef struct SelfColResponseData {
+  const ClothModifierData *clmd;
+  const CollPair *collisions;
+  SelfColPairImpulse *impulses;
+  float time_multiplier;
+  float min_distance;
+} SelfColResponseData;
+
+/**
+ * Compute the impulses of a self collision pair on the vertices of both triangles.
+ * Only reads the cloth vertices, so pairs can be handled in parallel.
+ */
+static char cloth_selfcollision_pair_impulse(const ClothModifierData *clmd,
+                                             const CollPair *collpair,
+                                             const float time_multiplier,
+                                             const float min_distance,
+                                             float ia[3][3],
+                                             float ib[3][3])
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const Cloth *cloth = clmd->clothObject;
+  float w1, w2, w3, u1, u2, u3;
+  float v1[3], v2[3], relativeVelocity[3];
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float w1, w2, w3, u1, u2, u3;
-    float v1[3], v2[3], relativeVelocity[3];
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return SELFCOL_PAIR_SKIP;
+  }
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  zero_m3(ia);
+  zero_m3(ib);
 
-    /* Compute barycentric coordinates for both collision points. */
-    collision_compute_barycentric(collpair->pa,
-                                  cloth->verts[collpair->ap1].tx,
-                                  cloth->verts[collpair->ap2].tx,
-                                  cloth->verts[collpair->ap3].tx,
-                                  &w1,
-                                  &w2,
-                                  &w3);
+  /* Compute barycentric coordinates for both collision points. */
+  collision_compute_barycentric(collpair->pa,
+                                cloth->verts[collpair->ap1].tx,
+                                cloth->verts[collpair->ap2].tx,
+                                cloth->verts[collpair->ap3].tx,
+                                &w1,
+                                &w2,
+                                &w3);
 
-    collision_compute_barycentric(collpair->pb,
-                                  cloth->verts[collpair->bp1].tx,
-                                  cloth->verts[collpair->bp2].tx,
-                                  cloth->verts[collpair->bp3].tx,
-                                  &u1,
-                                  &u2,
-                                  &u3);
+  collision_compute_barycentric(collpair->pb,
+                                cloth->verts[collpair->bp1].tx,
+                                cloth->verts[collpair->bp2].tx,
+                                cloth->verts[collpair->bp3].tx,
+                                &u1,
+                                &u2,
+                                &u3);
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    sub_v3_v3v3(relativeVelocity, v2, v1);
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
 
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
+      impulse = magtangent / 1.5;
 
-        impulse = magtangent / 1.5;
+      VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
+
+      VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+    }
+
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
 
-        VECADDMUL(ia[0], vrel_t_pre, (double)w1 * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, (double)w2 * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, (double)w3 * impulse);
+    VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
 
-        VECADDMUL(ib[0], vrel_t_pre, (double)u1 * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, (double)u2 * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, (double)u3 * -impulse);
+    VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
       VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
@@ -946,55 +991,92 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
       VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
       VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    return SELFCOL_PAIR_IMPULSE;
+  }
+  else if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-        VECADDMUL(ia[0], collpair->normal, (double)w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, (double)w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, (double)w3 * impulse);
+    return SELFCOL_PAIR_IMPULSE;
+  }
 
-        VECADDMUL(ib[0], collpair->normal, (double)u1 * -impulse);
-        VECADDMUL(ib[1], collpair->normal, (double)u2 * -impulse);
-        VECADDMUL(ib[2], collpair->normal, (double)u3 * -impulse);
-      }
+  return SELFCOL_PAIR_NO_IMPULSE;
+}
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+static void cloth_selfcollision_response_cb(void *__restrict userdata,
+                                            const int index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SelfColResponseData *data = (SelfColResponseData *)userdata;
+  SelfColPairImpulse *pair = &data->impulses[index];
+
+  pair->state = cloth_selfcollision_pair_impulse(data->clmd,
+                                                 &data->collisions[index],
+                                                 data->time_multiplier,
+                                                 data->min_distance,
+                                                 pair->ia,
+                                                 pair->ib);
+}
+
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
+
+  SelfColPairImpulse *impulses = MEM_mallocN(sizeof(*impulses) * collision_count, __func__);
+
+  SelfColResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .impulses = impulses,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f),
+  };
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  BLI_task_parallel_range(0, collision_count, &data, cloth_selfcollision_response_cb, &settings);
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+  /* Pairs share vertices, so the impulses are applied serially in the order of the pairs. */
+  for (int i = 0; i < collision_count; i++, collpair++) {
+    const SelfColPairImpulse *pair = &impulses[i];
 
+    if (pair->state == SELFCOL_PAIR_SKIP) {
+      continue;
+    }
+    if (pair->state == SELFCOL_PAIR_IMPULSE) {
       result = 1;
     }
 
     if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ia[0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ia[1], &cloth->verts[collpair->ap2]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ia[2], &cloth->verts[collpair->ap3]);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ib[0], &cloth->verts[collpair->bp1]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ib[1], &cloth->verts[collpair->bp2]);
+      cloth_collision_impulse_vert(clamp_sq, pair->ib[2], &cloth->verts[collpair->bp3]);
     }
   }
 
+  MEM_freeN(impulses);
+
   return result;
 }
 
@@ -1629,6 +1711,18 @@ int cloth_bvh_collision(
         cloth->bvhselftree, cloth->bvhselftree, &coll_count_self, cloth_bvh_self_overlap_cb, clmd);
   }
 
+  if (CLOG_CHECK(&LOG, 2)) {
+    uint coll_count_obj = 0;
+    for (i = 0; i < numcollobj; i++) {
+      coll_count_obj += (coll_counts_obj != NULL) ? coll_counts_obj[i] : 0;
+    }
+    CLOG_INFO(&LOG,
+              2,
+              "%u object and %u self collision candidate pairs",
+              coll_count_obj,
+              coll_count_self);
+  }
+
   do {
     ret2 = 0;
 
@@ -1713,6 +1807,8 @@ int cloth_bvh_collision(
     rounds++;
   } while (ret2 && (clmd->coll_parms->loop_count > rounds));
 
+  CLOG_INFO(&LOG, 2, "%d vertex impulses applied in %d rounds", ret, rounds);
+
   if (overlap_obj) {
     for (i = 0; i < numcollobj; i++) {
       MEM_SAFE_FREE(overlap_obj[i]);
@@ -95,6 +95,10 @@
 #  include "ABC_alembic.h"
 #endif
 
+#ifdef WITH_USD
+#  include "usd.h"
+#endif
+
 /* ---------------------------------------------------------------------------- */
 /* Useful macros for testing various common flag combinations */
 
@@ -133,10 +137,36 @@ void BKE_constraint_unique_name(bConstraint *con, ListBase *list)
 bConstraintOb *BKE_constraints_make_evalob(
     Depsgraph *depsgraph, Scene *scene, Object *ob, void *subdata, short datatype)
 {
-  bConstraintOb *cob;
-
   /* create regardless of whether we have any data! */
-  cob = MEM_callocN(sizeof(bConstraintOb), "bConstraintOb");
+  bConstraintOb *cob = MEM_mallocN(sizeof(bConstraintOb), "bConstraintOb");
+  BKE_constraints_evalob_init(cob, depsgraph, scene, ob, subdata, datatype);
+  return cob;
+}
+
+/* cleanup after constraint evaluation */
+void BKE_constraints_clear_evalob(bConstraintOb *cob)
+{
+  /* prevent crashes */
+  if (cob == NULL) {
+    return;
+  }
+
+  BKE_constraints_evalob_apply(cob);
+
+  /* free tempolary struct */
+  MEM_freeN(cob);
+}
+
+/* Same as #BKE_constraints_make_evalob for a caller owned struct, e.g. on the stack, so the
+ * evaluation of every object and bone doesn't need an allocation. */
+void BKE_constraints_evalob_init(bConstraintOb *cob,
+                                 Depsgraph *depsgraph,
+                                 Scene *scene,
+                                 Object *ob,
+                                 void *subdata,
+                                 short datatype)
+{
+  memset(cob, 0, sizeof(*cob));
 
   /* for system time, part of deglobalization, code nicer later with local time (ton) */
   cob->scene = scene;
@@ -203,20 +233,13 @@ bConstraintOb *BKE_constraints_make_evalob(
       unit_m4(cob->startmat);
       break;
   }
-
-  return cob;
 }
 
-/* cleanup after constraint evaluation */
-void BKE_constraints_clear_evalob(bConstraintOb *cob)
+/* Copy the result of the evaluation back to the owner, without freeing \a cob. */
+void BKE_constraints_evalob_apply(bConstraintOb *cob)
 {
   float delta[4][4], imat[4][4];
 
-  /* prevent crashes */
-  if (cob == NULL) {
-    return;
-  }
-
   /* calculate delta of constraints evaluation */
   invert_m4_m4(imat, cob->startmat);
   /* XXX This would seem to be in wrong order. However, it does not work in 'right' order -
@@ -250,9 +273,6 @@ void BKE_constraints_clear_evalob(bConstraintOb *cob)
       break;
     }
   }
-
-  /* free tempolary struct */
-  MEM_freeN(cob);
 }
 
 /* -------------- Space-Conversion API -------------- */
@@ -809,6 +829,34 @@ static void default_get_tarmat_full_bbone(struct Depsgraph *UNUSED(depsgraph),
   }
 }
 
+/* Initialize a zeroed temporary target, used by #SINGLETARGET_GET_TARS. */
+static void constraint_target_init(bConstraintTarget *ct,
+                                   const bConstraint *con,
+                                   Object *tar,
+                                   const char *subtarget)
+{
+  ct->tar = tar;
+  BLI_strncpy(ct->subtarget, subtarget, sizeof(ct->subtarget));
+  ct->space = con->tarspace;
+  ct->flag = CONSTRAINT_TAR_TEMP;
+
+  if (ct->tar) {
+    if ((ct->tar->type == OB_ARMATURE) && (ct->subtarget[0])) {
+      bPoseChannel *pchan = BKE_pose_channel_find_name(ct->tar->pose, ct->subtarget);
+      ct->type = CONSTRAINT_OBTYPE_BONE;
+      ct->rotOrder = (pchan) ? (pchan->rotmode) : EULER_ORDER_DEFAULT;
+    }
+    else if (OB_TYPE_SUPPORT_VGROUP(ct->tar->type) && (ct->subtarget[0])) {
+      ct->type = CONSTRAINT_OBTYPE_VERT;
+      ct->rotOrder = EULER_ORDER_DEFAULT;
+    }
+    else {
+      ct->type = CONSTRAINT_OBTYPE_OBJECT;
+      ct->rotOrder = ct->tar->rotmode;
+    }
+  }
+}
+
 /* This following macro should be used for all standard single-target *_get_tars functions
  * to save typing and reduce maintenance woes.
  * (Hopefully all compilers will be happy with the lines with just a space on them.
@@ -818,28 +866,7 @@ static void default_get_tarmat_full_bbone(struct Depsgraph *UNUSED(depsgraph),
 #define SINGLETARGET_GET_TARS(con, datatar, datasubtarget, ct, list) \
   { \
     ct = MEM_callocN(sizeof(bConstraintTarget), "tempConstraintTarget"); \
-\
-    ct->tar = datatar; \
-    BLI_strncpy(ct->subtarget, datasubtarget, sizeof(ct->subtarget)); \
-    ct->space = con->tarspace; \
-    ct->flag = CONSTRAINT_TAR_TEMP; \
-\
-    if (ct->tar) { \
-      if ((ct->tar->type == OB_ARMATURE) && (ct->subtarget[0])) { \
-        bPoseChannel *pchan = BKE_pose_channel_find_name(ct->tar->pose, ct->subtarget); \
-        ct->type = CONSTRAINT_OBTYPE_BONE; \
-        ct->rotOrder = (pchan) ? (pchan->rotmode) : EULER_ORDER_DEFAULT; \
-      } \
-      else if (OB_TYPE_SUPPORT_VGROUP(ct->tar->type) && (ct->subtarget[0])) { \
-        ct->type = CONSTRAINT_OBTYPE_VERT; \
-        ct->rotOrder = EULER_ORDER_DEFAULT; \
-      } \
-      else { \
-        ct->type = CONSTRAINT_OBTYPE_OBJECT; \
-        ct->rotOrder = ct->tar->rotmode; \
-      } \
-    } \
-\
+    constraint_target_init(ct, con, datatar, datasubtarget); \
     BLI_addtail(list, ct); \
   } \
   (void)0
@@ -5303,7 +5330,7 @@ static void transformcache_id_looper(bConstraint *con, ConstraintIDFunc func, vo
 
 static void transformcache_evaluate(bConstraint *con, bConstraintOb *cob, ListBase *targets)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   bTransformCacheConstraint *data = con->data;
   Scene *scene = cob->scene;
 
@@ -5321,7 +5348,18 @@ static void transformcache_evaluate(bConstraint *con, bConstraintOb *cob, ListBa
     BKE_cachefile_reader_open(cache_file, &data->reader, cob->ob, data->object_path);
   }
 
-  ABC_get_transform(data->reader, cob->matrix, time, cache_file->scale);
+  switch (cache_file->type) {
+    case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+      ABC_get_transform(data->reader, cob->matrix, time, cache_file->scale);
+#  endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+      USD_get_transform(data->reader, cob->matrix, time, cache_file->scale);
+#  endif
+      break;
+  }
 #else
   UNUSED_VARS(con, cob);
 #endif
@@ -6147,33 +6185,105 @@ void BKE_constraint_targets_for_solving_get(struct Depsgraph *depsgraph,
   }
 }
 
+/**
+ * Get the targets of the common constraint types that have one target with a sub-target and
+ * optionally the custom space target, without allocating them: the targets are initialized in
+ * \a r_storage and linked into \a targets, which must not be flushed afterwards.
+ * Returns false for other constraint types, these use #BKE_constraint_targets_for_solving_get.
+ */
+static bool constraint_targets_for_solving_get_static(struct Depsgraph *depsgraph,
+                                                      bConstraint *con,
+                                                      bConstraintOb *cob,
+                                                      ListBase *targets,
+                                                      bConstraintTarget r_storage[2],
+                                                      float ctime)
+{
+  const bConstraintTypeInfo *cti = BKE_constraint_typeinfo_get(con);
+  Object *tar = NULL;
+  const char *subtarget = NULL;
+  bool use_space_target = true;
+
+  /* Each case matches the `get_constraint_targets` callback of the type. */
+  switch (con->type) {
+#define CASE_SINGLETARGET(type, data_type, use_space) \
+  case type: { \
+    data_type *data = con->data; \
+    tar = data->tar; \
+    subtarget = data->subtarget; \
+    use_space_target = use_space; \
+    break; \
+  }
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_CHILDOF, bChildOfConstraint, false)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_TRACKTO, bTrackToConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_LOCLIKE, bLocateLikeConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_ROTLIKE, bRotateLikeConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_SIZELIKE, bSizeLikeConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_TRANSLIKE, bTransLikeConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_LOCKTRACK, bLockTrackConstraint, false)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_DISTLIMIT, bDistLimitConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_STRETCHTO, bStretchToConstraint, false)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_MINMAX, bMinMaxConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_TRANSFORM, bTransformConstraint, true)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_DAMPTRACK, bDampTrackConstraint, false)
+    CASE_SINGLETARGET(CONSTRAINT_TYPE_PIVOT, bPivotConstraint, false)
+#undef CASE_SINGLETARGET
+    /* Only the custom space target. */
+    case CONSTRAINT_TYPE_LOCLIMIT:
+    case CONSTRAINT_TYPE_ROTLIMIT:
+    case CONSTRAINT_TYPE_SIZELIMIT:
+    case CONSTRAINT_TYPE_SAMEVOL:
+      break;
+    default:
+      return false;
+  }
+
+  if (subtarget != NULL) {
+    memset(&r_storage[0], 0, sizeof(r_storage[0]));
+    constraint_target_init(&r_storage[0], con, tar, subtarget);
+    BLI_addtail(targets, &r_storage[0]);
+  }
+  if (use_space_target && ELEM(CONSTRAINT_SPACE_CUSTOM, con->ownspace, con->tarspace)) {
+    memset(&r_storage[1], 0, sizeof(r_storage[1]));
+    constraint_target_init(&r_storage[1], con, con->space_object, con->space_subtarget);
+    BLI_addtail(targets, &r_storage[1]);
+  }
+
+  LISTBASE_FOREACH (bConstraintTarget *, ct, targets) {
+    if (cti->get_target_matrix) {
+      cti->get_target_matrix(depsgraph, con, cob, ct, ctime);
+    }
+    else {
+      unit_m4(ct->matrix);
+    }
+  }
+
+  return true;
+}
+
 void BKE_constraint_custom_object_space_get(float r_mat[4][4], bConstraint *con)
 {
   if (!con ||
       (con->ownspace != CONSTRAINT_SPACE_CUSTOM && con->tarspace != CONSTRAINT_SPACE_CUSTOM)) {
     return;
   }
-  bConstraintTarget *ct;
-  ListBase target = {NULL, NULL};
-  SINGLETARGET_GET_TARS(con, con->space_object, con->space_subtarget, ct, &target);
+  bConstraintTarget ct = {NULL};
+  constraint_target_init(&ct, con, con->space_object, con->space_subtarget);
 
   /* Basically default_get_tarmat but without the unused parameters. */
-  if (VALID_CONS_TARGET(ct)) {
-    constraint_target_to_mat4(ct->tar,
-                              ct->subtarget,
+  if (ct.tar) {
+    constraint_target_to_mat4(ct.tar,
+                              ct.subtarget,
                               NULL,
-                              ct->matrix,
+                              ct.matrix,
                               CONSTRAINT_SPACE_WORLD,
                               CONSTRAINT_SPACE_WORLD,
                               0,
                               0);
-    copy_m4_m4(r_mat, ct->matrix);
+    copy_m4_m4(r_mat, ct.matrix);
   }
   else {
     unit_m4(r_mat);
   }
-
-  SINGLETARGET_FLUSH_TARS(con, con->space_object, con->space_subtarget, ct, &target, true);
 }
 
 /* ---------- Evaluation ----------- */
@@ -6202,6 +6312,8 @@ void BKE_constraints_solve(struct Depsgraph *depsgraph,
   for (con = conlist->first; con; con = con->next) {
     const bConstraintTypeInfo *cti = BKE_constraint_typeinfo_get(con);
     ListBase targets = {NULL, NULL};
+    bConstraintTarget targets_storage[2];
+    bool use_targets_storage;
 
     /* these we can skip completely (invalid constraints...) */
     if (cti == NULL) {
@@ -6234,8 +6346,12 @@ void BKE_constraints_solve(struct Depsgraph *depsgraph,
     BKE_constraint_mat_convertspace(
         cob->ob, cob->pchan, cob, cob->matrix, CONSTRAINT_SPACE_WORLD, con->ownspace, false);
 
-    /* prepare targets for constraint solving */
-    BKE_constraint_targets_for_solving_get(depsgraph, con, cob, &targets, ctime);
+    /* prepare targets for constraint solving, without allocations for the common types */
+    use_targets_storage = constraint_targets_for_solving_get_static(
+        depsgraph, con, cob, &targets, targets_storage, ctime);
+    if (!use_targets_storage) {
+      BKE_constraint_targets_for_solving_get(depsgraph, con, cob, &targets, ctime);
+    }
 
     /* Solve the constraint and put result in cob->matrix */
     cti->evaluate_constraint(con, cob, &targets);
@@ -6244,7 +6360,7 @@ void BKE_constraints_solve(struct Depsgraph *depsgraph,
      * - this should free temp targets but no data should be copied back
      *   as constraints may have done some nasty things to it...
      */
-    if (cti->flush_constraint_targets) {
+    if (cti->flush_constraint_targets && !use_targets_storage) {
       cti->flush_constraint_targets(con, &targets, 1);
     }
 
@@ -35,6 +35,7 @@
 #include "BLI_dynstr.h"
 #include "BLI_hash_mm3.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_string.h"
 
@@ -200,26 +201,24 @@ float BKE_cryptomatte_hash_to_float(uint32_t cryptomatte_hash)
   return f;
 }
 
-static ID *cryptomatte_find_id(const ListBase *ids, const float encoded_hash)
+static void cryptomatte_add_ids(const ListBase *ids, blender::Map<float, ID *> &r_ids)
 {
   LISTBASE_FOREACH (ID *, id, ids) {
     uint32_t hash = BKE_cryptomatte_hash((id->name + 2), BLI_strnlen(id->name + 2, MAX_NAME));
-    if (BKE_cryptomatte_hash_to_float(hash) == encoded_hash) {
-      return id;
-    }
+    /* Keep the first ID when names have the same hash. */
+    r_ids.add(BKE_cryptomatte_hash_to_float(hash), id);
   }
-  return nullptr;
 }
 
-/* Find an ID in the given main that matches the given encoded float. */
-static struct ID *BKE_cryptomatte_find_id(const Main *bmain, const float encoded_hash)
+/* Map the encoded floats of the objects and materials in the given main to their ID, so that
+ * many entries can be looked up without hashing all ID names for each of them. Objects take
+ * precedence over materials. */
+static blender::Map<float, ID *> cryptomatte_ids_by_encoded_hash(const Main *bmain)
 {
-  ID *result;
-  result = cryptomatte_find_id(&bmain->objects, encoded_hash);
-  if (result == nullptr) {
-    result = cryptomatte_find_id(&bmain->materials, encoded_hash);
-  }
-  return result;
+  blender::Map<float, ID *> ids;
+  cryptomatte_add_ids(&bmain->objects, ids);
+  cryptomatte_add_ids(&bmain->materials, ids);
+  return ids;
 }
 
 char *BKE_cryptomatte_entries_to_matte_id(NodeCryptomatte *node_storage)
@@ -249,6 +248,9 @@ void BKE_cryptomatte_matte_id_to_entries(const Main *bmain,
 {
   BLI_freelistN(&node_storage->entries);
 
+  blender::Map<float, ID *> ids;
+  bool ids_initialized = false;
+
   std::istringstream ss(matte_id);
   while (ss.good()) {
     CryptomatteEntry *entry = nullptr;
@@ -267,7 +269,11 @@ void BKE_cryptomatte_matte_id_to_entries(const Main *bmain,
         entry = (CryptomatteEntry *)MEM_callocN(sizeof(CryptomatteEntry), __func__);
         entry->encoded_hash = encoded_hash;
         if (bmain) {
-          ID *id = BKE_cryptomatte_find_id(bmain, encoded_hash);
+          if (!ids_initialized) {
+            ids = cryptomatte_ids_by_encoded_hash(bmain);
+            ids_initialized = true;
+          }
+          ID *id = ids.lookup_default(encoded_hash, nullptr);
           if (id != nullptr) {
             BLI_strncpy(entry->name, id->name + 2, sizeof(entry->name));
           }
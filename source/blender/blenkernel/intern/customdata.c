@@ -36,12 +36,14 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_endian_switch.h"
+#include "BLI_hash.h"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -3089,6 +3091,155 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+typedef struct CustomDataInterpManyData {
+  const LayerTypeInfo *type_info;
+  /** Number of floats of layers that are a plain weighted sum of floats, zero otherwise. */
+  int floats_num;
+  const void *src_data;
+  void *dst_data;
+  const int *src_indices;
+  const float *weights;
+  const int *src_offsets;
+} CustomDataInterpManyData;
+
+/* Number of floats of the layers interpolated as a weighted sum, which are done without going
+ * through the interpolation callback of the type. */
+static int customdata_interp_floats_num(const LayerTypeInfo *type_info)
+{
+  if (ELEM(type_info->interp, layerInterp_bweight, layerInterp_paint_mask)) {
+    return 1;
+  }
+  if (type_info->interp == layerInterp_propfloat2) {
+    return 2;
+  }
+  if (ELEM(type_info->interp, layerInterp_shapekey, layerInterp_propfloat3)) {
+    return 3;
+  }
+  return 0;
+}
+
+static void customdata_interp_many_cb(void *__restrict userdata,
+                                      const int dest_i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CustomDataInterpManyData *data = userdata;
+  const LayerTypeInfo *type_info = data->type_info;
+  const int src_begin = data->src_offsets[dest_i];
+  const int count = data->src_offsets[dest_i + 1] - src_begin;
+  const int *src_indices = data->src_indices + src_begin;
+  void *dst = POINTER_OFFSET(data->dst_data, (size_t)dest_i * type_info->size);
+
+  if (count <= 0) {
+    return;
+  }
+
+  float default_weights_buf[SOURCE_BUF_SIZE];
+  const float *weights = data->weights ? data->weights + src_begin : NULL;
+  if (weights == NULL && count <= SOURCE_BUF_SIZE) {
+    copy_vn_fl(default_weights_buf, count, 1.0f / count);
+    weights = default_weights_buf;
+  }
+
+  if (data->floats_num != 0 && weights != NULL) {
+    float result[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < count; i++) {
+      const float *src = POINTER_OFFSET(data->src_data,
+                                        (size_t)src_indices[i] * type_info->size);
+      for (int j = 0; j < data->floats_num; j++) {
+        result[j] += src[j] * weights[i];
+      }
+    }
+    memcpy(dst, result, sizeof(float) * (size_t)data->floats_num);
+    return;
+  }
+
+  if (count > SOURCE_BUF_SIZE) {
+    /* Same slow fallback as #CustomData_interp. */
+    float *default_weights = NULL;
+    if (weights == NULL) {
+      default_weights = MEM_mallocN(sizeof(*default_weights) * (size_t)count, __func__);
+      copy_vn_fl(default_weights, count, 1.0f / count);
+      weights = default_weights;
+    }
+    const void **sources = MEM_malloc_arrayN((size_t)count, sizeof(*sources), __func__);
+    for (int i = 0; i < count; i++) {
+      sources[i] = POINTER_OFFSET(data->src_data, (size_t)src_indices[i] * type_info->size);
+    }
+    type_info->interp(sources, weights, NULL, count, dst);
+    MEM_freeN((void *)sources);
+    MEM_SAFE_FREE(default_weights);
+    return;
+  }
+
+  const void *sources[SOURCE_BUF_SIZE];
+  for (int i = 0; i < count; i++) {
+    sources[i] = POINTER_OFFSET(data->src_data, (size_t)src_indices[i] * type_info->size);
+  }
+  type_info->interp(sources, weights, NULL, count, dst);
+}
+
+/**
+ * Interpolate many elements at once, the same as calling #CustomData_interp for every
+ * destination element without sub-weights, but a layer at a time and from multiple threads.
+ *
+ * \param src_offsets: The sources of element `dest_index + i` are the `src_indices` in the
+ * range `[src_offsets[i], src_offsets[i + 1])`, so the array has `dest_num + 1` items.
+ * \param weights: Weight of every source in `src_indices`, when NULL the sources of every
+ * element are averaged.
+ *
+ * \note The interpolated elements must not be used as sources when \a source is \a dest.
+ */
+void CustomData_interp_many(const CustomData *source,
+                            CustomData *dest,
+                            const int *src_indices,
+                            const float *weights,
+                            const int *src_offsets,
+                            int dest_num,
+                            int dest_index)
+{
+  if (dest_num <= 0) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (src_offsets[dest_num] - src_offsets[0]) > 4096;
+  settings.min_iter_per_thread = 1024;
+
+  /* interpolates a layer at a time */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+
+    /* Find the matching destination layer, like #CustomData_interp does. */
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+
+    if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      CustomDataInterpManyData data = {
+          .type_info = typeInfo,
+          .floats_num = customdata_interp_floats_num(typeInfo),
+          .src_data = source->layers[src_i].data,
+          .dst_data = POINTER_OFFSET(dest->layers[dest_i].data,
+                                     (size_t)dest_index * typeInfo->size),
+          .src_indices = src_indices,
+          .weights = weights,
+          .src_offsets = src_offsets,
+      };
+      BLI_task_parallel_range(0, dest_num, &data, customdata_interp_many_cb, &settings);
+
+      dest_i++;
+    }
+  }
+}
+
 /**
  * Swap data inside each item, for all layers.
  * This only applies to item types that may store several sub-item data
@@ -3626,7 +3777,12 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+/**
+ * Allocate a block for \a data without initializing it, freeing the existing one.
+ * The block can then be filled by #CustomData_to_bmesh_block from another thread,
+ * as the allocation is the only part using the (non thread-safe) memory pool.
+ */
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
@@ -3914,6 +4070,35 @@ bool CustomData_data_equals(int type, const void *data1, const void *data2)
   return !memcmp(data1, data2, typeInfo->size);
 }
 
+uint64_t CustomData_hash(const CustomData *data, int totelem, uint64_t hash)
+{
+  hash = BLI_hash_u64_combine(hash, (uint64_t)totelem);
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    hash = BLI_hash_u64_combine(hash, (uint64_t)layer->type);
+    hash = BLI_hash_buffer_u64(layer->name, strlen(layer->name), hash);
+    if (layer->data == NULL) {
+      continue;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      /* The weights are not stored in the layer itself. */
+      const MDeformVert *dverts = layer->data;
+      for (int j = 0; j < totelem; j++) {
+        hash = BLI_hash_u64_combine(hash, (uint64_t)dverts[j].totweight);
+        if (dverts[j].dw != NULL) {
+          hash = BLI_hash_buffer_u64(
+              dverts[j].dw, sizeof(MDeformWeight) * (size_t)dverts[j].totweight, hash);
+        }
+      }
+    }
+    else {
+      hash = BLI_hash_buffer_u64(
+          layer->data, (size_t)CustomData_sizeof(layer->type) * (size_t)totelem, hash);
+    }
+  }
+  return hash;
+}
+
 void CustomData_data_initminmax(int type, void *min, void *max)
 {
   const LayerTypeInfo *typeInfo = layerType_getInfo(type);
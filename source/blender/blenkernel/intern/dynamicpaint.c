@@ -5066,6 +5066,8 @@ typedef struct DynamicPaintEffectData {
   float *force;
   ListBase *effectors;
   const void *prevPoint;
+  /* Written by steps that read all their input from prevPoint, see #dynamicPaint_doEffectStep. */
+  void *newPoint;
   const float eff_scale;
 
   uint8_t *point_locks;
@@ -5215,14 +5217,16 @@ static void dynamic_paint_effect_spread_cb(void *__restrict userdata,
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
 
+  PaintPoint *pPoint = &((PaintPoint *)data->newPoint)[index];
+  const PaintPoint *prevPoint = data->prevPoint;
+  *pPoint = prevPoint[index];
+
   if (sData->adj_data->flags[index] & ADJ_BORDER_PIXEL) {
     return;
   }
 
   const int numOfNeighs = sData->adj_data->n_num[index];
   BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  PaintPoint *pPoint = &((PaintPoint *)sData->type_data)[index];
-  const PaintPoint *prevPoint = data->prevPoint;
   const float eff_scale = data->eff_scale;
 
   const int *n_index = sData->adj_data->n_index;
@@ -5274,14 +5278,16 @@ static void dynamic_paint_effect_shrink_cb(void *__restrict userdata,
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
 
+  PaintPoint *pPoint = &((PaintPoint *)data->newPoint)[index];
+  const PaintPoint *prevPoint = data->prevPoint;
+  *pPoint = prevPoint[index];
+
   if (sData->adj_data->flags[index] & ADJ_BORDER_PIXEL) {
     return;
   }
 
   const int numOfNeighs = sData->adj_data->n_num[index];
   BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  PaintPoint *pPoint = &((PaintPoint *)sData->type_data)[index];
-  const PaintPoint *prevPoint = data->prevPoint;
   const float eff_scale = data->eff_scale;
   float totalAlpha = 0.0f;
 
@@ -5452,12 +5458,16 @@ static void dynamic_paint_effect_drip_cb(void *__restrict userdata,
   }
 }
 
+/**
+ * Spread and shrink write the new values into \a point_buffer, which is then swapped with the
+ * surface data instead of copying the whole surface before each of them.
+ */
 static void dynamicPaint_doEffectStep(
     DynamicPaintSurface *surface,
     /* Cannot be const, because it is assigned to non-const variable.
      * NOLINTNEXTLINE: readability-non-const-parameter. */
     float *force,
-    PaintPoint *prevPoint,
+    void **point_buffer,
     float timescale,
     float steps)
 {
@@ -5477,12 +5487,10 @@ static void dynamicPaint_doEffectStep(
     const float eff_scale = distance_scale * EFF_MOVEMENT_PER_FRAME * surface->spread_speed *
                             timescale;
 
-    /* Copy current surface to the previous points array to read unmodified values */
-    memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
-
     DynamicPaintEffectData data = {
         .surface = surface,
-        .prevPoint = prevPoint,
+        .prevPoint = sData->type_data,
+        .newPoint = *point_buffer,
         .eff_scale = eff_scale,
     };
     TaskParallelSettings settings;
@@ -5490,6 +5498,8 @@ static void dynamicPaint_doEffectStep(
     settings.use_threading = (sData->total_points > 1000);
     BLI_task_parallel_range(
         0, sData->total_points, &data, dynamic_paint_effect_spread_cb, &settings);
+
+    SWAP(void *, sData->type_data, *point_buffer);
   }
 
   /*
@@ -5499,12 +5509,10 @@ static void dynamicPaint_doEffectStep(
     const float eff_scale = distance_scale * EFF_MOVEMENT_PER_FRAME * surface->shrink_speed *
                             timescale;
 
-    /* Copy current surface to the previous points array to read unmodified values */
-    memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
-
     DynamicPaintEffectData data = {
         .surface = surface,
-        .prevPoint = prevPoint,
+        .prevPoint = sData->type_data,
+        .newPoint = *point_buffer,
         .eff_scale = eff_scale,
     };
     TaskParallelSettings settings;
@@ -5512,6 +5520,8 @@ static void dynamicPaint_doEffectStep(
     settings.use_threading = (sData->total_points > 1000);
     BLI_task_parallel_range(
         0, sData->total_points, &data, dynamic_paint_effect_shrink_cb, &settings);
+
+    SWAP(void *, sData->type_data, *point_buffer);
   }
 
   /*
@@ -5524,7 +5534,9 @@ static void dynamicPaint_doEffectStep(
     const size_t point_locks_size = (sData->total_points / 8) + 1;
     uint8_t *point_locks = MEM_callocN(sizeof(*point_locks) * point_locks_size, __func__);
 
-    /* Copy current surface to the previous points array to read unmodified values */
+    /* Points are modified by their neighbors, copy current surface to the previous points array
+     * to read unmodified values. */
+    PaintPoint *prevPoint = *point_buffer;
     memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(struct PaintPoint));
 
     DynamicPaintEffectData data = {
@@ -5634,6 +5646,8 @@ static void dynamic_paint_wave_step_cb(void *__restrict userdata,
   const PaintSurfaceData *sData = surface->data;
   BakeAdjPoint *bNeighs = sData->bData->bNeighs;
   const PaintWavePoint *prevPoint = data->prevPoint;
+  PaintWavePoint *wPoint = &((PaintWavePoint *)data->newPoint)[index];
+  *wPoint = prevPoint[index];
 
   const float wave_speed = data->wave_speed;
   const float wave_scale = data->wave_scale;
@@ -5643,7 +5657,6 @@ static void dynamic_paint_wave_step_cb(void *__restrict userdata,
   const float min_dist = data->min_dist;
   const float damp_factor = data->damp_factor;
 
-  PaintWavePoint *wPoint = &((PaintWavePoint *)sData->type_data)[index];
   const int numOfNeighs = sData->adj_data->n_num[index];
   float force = 0.0f, avg_dist = 0.0f, avg_height = 0.0f, avg_n_height = 0.0f;
   int numOfN = 0, numOfRN = 0;
@@ -5738,9 +5751,9 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
   const float canvas_size = getSurfaceDimension(sData);
   const float wave_scale = CANVAS_REL_SIZE / canvas_size;
 
-  /* allocate memory */
-  PaintWavePoint *prevPoint = MEM_mallocN(sData->total_points * sizeof(PaintWavePoint), __func__);
-  if (!prevPoint) {
+  /* allocate memory, steps write into it and swap it with the surface data */
+  void *point_buffer = MEM_mallocN(sData->total_points * sizeof(PaintWavePoint), __func__);
+  if (!point_buffer) {
     return;
   }
 
@@ -5766,12 +5779,10 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
   damp_factor = pow((1.0f - surface->wave_damping), timescale * surface->wave_timescale);
 
   for (ss = 0; ss < steps; ss++) {
-    /* copy previous frame data */
-    memcpy(prevPoint, sData->type_data, sData->total_points * sizeof(PaintWavePoint));
-
     DynamicPaintEffectData data = {
         .surface = surface,
-        .prevPoint = prevPoint,
+        .prevPoint = sData->type_data,
+        .newPoint = point_buffer,
         .wave_speed = wave_speed,
         .wave_scale = wave_scale,
         .wave_max_slope = wave_max_slope,
@@ -5784,9 +5795,11 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
     BLI_parallel_range_settings_defaults(&settings);
     settings.use_threading = (sData->total_points > 1000);
     BLI_task_parallel_range(0, sData->total_points, &data, dynamic_paint_wave_step_cb, &settings);
+
+    SWAP(void *, sData->type_data, point_buffer);
   }
 
-  MEM_freeN(prevPoint);
+  MEM_freeN(point_buffer);
 }
 
 /* Do dissolve and fading effects */
@@ -6340,26 +6353,24 @@ static int dynamicPaint_doStep(Depsgraph *depsgraph,
     /* paint surface effects */
     if (surface->effect && surface->type == MOD_DPAINT_SURFACE_T_PAINT) {
       int steps = 1, s;
-      PaintPoint *prevPoint;
+      void *point_buffer;
       float *force = NULL;
 
-      /* Allocate memory for surface previous points to read unchanged values from */
-      prevPoint = MEM_mallocN(sData->total_points * sizeof(struct PaintPoint),
-                              "PaintSurfaceDataCopy");
-      if (!prevPoint) {
+      /* Allocate memory for the effect steps to write into or read unchanged values from */
+      point_buffer = MEM_mallocN(sData->total_points * sizeof(struct PaintPoint),
+                                 "PaintSurfaceDataCopy");
+      if (!point_buffer) {
         return setError(canvas, N_("Not enough free memory"));
       }
 
       /* Prepare effects and get number of required steps */
       steps = dynamicPaint_prepareEffectStep(depsgraph, surface, scene, ob, &force, timescale);
       for (s = 0; s < steps; s++) {
-        dynamicPaint_doEffectStep(surface, force, prevPoint, timescale, (float)steps);
+        dynamicPaint_doEffectStep(surface, force, &point_buffer, timescale, (float)steps);
       }
 
-      /* Free temporary effect data */
-      if (prevPoint) {
-        MEM_freeN(prevPoint);
-      }
+      /* Free temporary effect data, either buffer may have been swapped with the surface data */
+      MEM_freeN(point_buffer);
       if (force) {
         MEM_freeN(force);
       }
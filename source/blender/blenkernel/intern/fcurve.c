@@ -1760,7 +1760,43 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
-static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
+/**
+ * Same as #BKE_fcurve_bezt_binarysearch_index_ex for a frame between the first and last keyframe,
+ * trying the segment found by the previous search and the next one first. Curves are mostly
+ * evaluated at successive frames, so this avoids most of the searches.
+ */
+static int fcurve_bezt_search_index_from_cursor(
+    BezTriple *bezts, float frame, int arraylen, float threshold, int *cursor, bool *r_replace)
+{
+  for (int a = max_ii(*cursor, 1); a <= *cursor + 1 && a < arraylen; a++) {
+    const float prevframe = bezts[a - 1].vec[1][0];
+    const float nextframe = bezts[a].vec[1][0];
+
+    if (IS_EQT(frame, prevframe, threshold)) {
+      *r_replace = true;
+      *cursor = a;
+      return a - 1;
+    }
+    if (IS_EQT(frame, nextframe, threshold)) {
+      *r_replace = true;
+      *cursor = a;
+      return a;
+    }
+    if (prevframe < frame && frame < nextframe) {
+      *r_replace = false;
+      *cursor = a;
+      return a;
+    }
+  }
+
+  *cursor = BKE_fcurve_bezt_binarysearch_index_ex(bezts, frame, arraylen, threshold, r_replace);
+  return *cursor;
+}
+
+static float fcurve_eval_keyframes_interpolate(FCurve *fcu,
+                                               BezTriple *bezts,
+                                               float evaltime,
+                                               int *cursor)
 {
   const float eps = 1.e-8f;
   BezTriple *bezt, *prevbezt;
@@ -1779,7 +1815,13 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  if (cursor != NULL) {
+    a = fcurve_bezt_search_index_from_cursor(
+        bezts, evaltime, fcu->totvert, 0.0001, cursor, &exact);
+  }
+  else {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  }
   bezt = bezts + a;
 
   if (exact) {
@@ -2021,8 +2063,9 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
   return 0.0f;
 }
 
-/* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
-static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
+/* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes.
+ * The optional cursor is the keyframe index where the search for the current segment starts. */
+static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime, int *cursor)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -2033,7 +2076,7 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, cursor);
 }
 
 /* Calculate F-Curve value for 'evaltime' using #FPoint samples. */
@@ -2082,7 +2125,7 @@ static float fcurve_eval_samples(FCurve *fcu, FPoint *fpts, float evaltime)
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * Note: this is also used for drivers.
  */
-static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue, int *cursor)
 {
   float devaltime;
 
@@ -2099,7 +2142,7 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at.
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, cursor);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -2122,7 +2165,18 @@ float evaluate_fcurve(FCurve *fcu, float evaltime)
 {
   BLI_assert(fcu->driver == NULL);
 
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
+}
+
+/**
+ * Same as #evaluate_fcurve, with a cursor kept by the caller between evaluations to speed up
+ * finding the keyframes around \a evaltime. The cursor is only a hint, initialize it to 0.
+ */
+float evaluate_fcurve_with_cursor(FCurve *fcu, float evaltime, int *cursor)
+{
+  BLI_assert(fcu->driver == NULL);
+
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, cursor);
 }
 
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
@@ -2130,7 +2184,7 @@ float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
   /* Can be used to evaluate the (keyframed) fcurve only.
    * Also works for driver-fcurves when the driver itself is not relevant.
    * E.g. when inserting a keyframe in a driver fcurve. */
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, NULL);
 }
 
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
@@ -2178,7 +2232,7 @@ float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
     }
   }
 
-  return evaluate_fcurve_ex(fcu, evaltime, cvalue);
+  return evaluate_fcurve_ex(fcu, evaltime, cvalue, NULL);
 }
 
 /* Checks if the curve has valid keys, drivers or modifiers that produce an actual curve. */
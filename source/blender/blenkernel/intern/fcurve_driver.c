@@ -29,7 +29,9 @@
 
 #include "BLI_alloca.h"
 #include "BLI_expr_pylike_eval.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
+#include "BLI_string.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
@@ -50,6 +52,8 @@
 
 #include "CLG_log.h"
 
+#include "PIL_time.h"
+
 #ifdef WITH_PYTHON
 #  include "BPY_extern.h"
 #endif
@@ -1148,6 +1152,129 @@ void BKE_driver_invalidate_expression(ChannelDriver *driver,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Python Driver Profiling
+ *
+ * With `--debug-drivers`, the drivers that fall back to Python are timed, grouped by expression,
+ * to find the ones worth rewriting in the subset supported by the simple expression evaluator.
+ * \{ */
+
+#ifdef WITH_PYTHON
+typedef struct DriverPythonProfile {
+  /* Owned by the hash as its key. */
+  const char *expression;
+  int eval_count;
+  /* Whether any of the drivers with this expression uses `self`. */
+  bool use_self;
+  double time_total;
+  double time_max;
+} DriverPythonProfile;
+
+/* Expression to #DriverPythonProfile, guarded by #python_driver_lock. */
+static GHash *python_driver_profile = NULL;
+
+static void driver_python_profile_add(const ChannelDriver *driver, double time)
+{
+  if (python_driver_profile == NULL) {
+    python_driver_profile = BLI_ghash_str_new(__func__);
+  }
+
+  void **key_p, **value_p;
+  if (!BLI_ghash_ensure_p_ex(python_driver_profile, driver->expression, &key_p, &value_p)) {
+    DriverPythonProfile *profile = MEM_callocN(sizeof(*profile), __func__);
+    profile->expression = *key_p = BLI_strdup(driver->expression);
+    *value_p = profile;
+  }
+
+  DriverPythonProfile *profile = *value_p;
+  profile->eval_count++;
+  profile->use_self |= (driver->flag & DRIVER_FLAG_USE_SELF) != 0;
+  profile->time_total += time;
+  profile->time_max = max_dd(profile->time_max, time);
+}
+
+static int driver_python_profile_cmp(const void *a, const void *b)
+{
+  const DriverPythonProfile *profile_a = *(const DriverPythonProfile **)a;
+  const DriverPythonProfile *profile_b = *(const DriverPythonProfile **)b;
+
+  if (profile_a->time_total != profile_b->time_total) {
+    return (profile_a->time_total < profile_b->time_total) ? 1 : -1;
+  }
+  return strcmp(profile_a->expression, profile_b->expression);
+}
+#endif /* WITH_PYTHON */
+
+/* Print the expressions evaluated by Python, the most expensive first. */
+void BKE_driver_python_profile_print(void)
+{
+#ifdef WITH_PYTHON
+  BLI_mutex_lock(&python_driver_lock);
+
+  const int profiles_len = python_driver_profile ? BLI_ghash_len(python_driver_profile) : 0;
+  if (profiles_len == 0) {
+    BLI_mutex_unlock(&python_driver_lock);
+    printf("Python drivers: none evaluated\n");
+    return;
+  }
+
+  DriverPythonProfile **profiles = MEM_malloc_arrayN(profiles_len, sizeof(*profiles), __func__);
+  int eval_count = 0, i = 0;
+  double time_total = 0.0;
+
+  GHASH_FOREACH_BEGIN (DriverPythonProfile *, profile, python_driver_profile) {
+    profiles[i++] = profile;
+    eval_count += profile->eval_count;
+    time_total += profile->time_total;
+  }
+  GHASH_FOREACH_END();
+
+  qsort(profiles, profiles_len, sizeof(*profiles), driver_python_profile_cmp);
+
+  printf("Python drivers: %d expressions, %d evaluations, %.3f ms total\n",
+         profiles_len,
+         eval_count,
+         time_total * 1000.0);
+  printf("  %10s %12s %12s %12s  %s\n",
+         "count",
+         "total (ms)",
+         "avg (ms)",
+         "max (ms)",
+         "expression");
+
+  for (i = 0; i < profiles_len; i++) {
+    const DriverPythonProfile *profile = profiles[i];
+    printf("  %10d %12.3f %12.4f %12.4f  %s%s\n",
+           profile->eval_count,
+           profile->time_total * 1000.0,
+           profile->time_total * 1000.0 / profile->eval_count,
+           profile->time_max * 1000.0,
+           profile->expression,
+           profile->use_self ? "  (uses self)" : "");
+  }
+
+  MEM_freeN(profiles);
+
+  BLI_mutex_unlock(&python_driver_lock);
+#endif /* WITH_PYTHON */
+}
+
+void BKE_driver_python_profile_free(void)
+{
+#ifdef WITH_PYTHON
+  BLI_mutex_lock(&python_driver_lock);
+
+  if (python_driver_profile != NULL) {
+    BLI_ghash_free(python_driver_profile, MEM_freeN, MEM_freeN);
+    python_driver_profile = NULL;
+  }
+
+  BLI_mutex_unlock(&python_driver_lock);
+#endif /* WITH_PYTHON */
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Driver Evaluation
  * \{ */
@@ -1260,7 +1387,16 @@ static void evaluate_driver_python(PathResolvedRNA *anim_rna,
      * - on errors it reports, then returns 0.0f. */
     BLI_mutex_lock(&python_driver_lock);
 
-    driver->curval = BPY_driver_exec(anim_rna, driver, driver_orig, anim_eval_context);
+    if (G.debug & G_DEBUG_DRIVERS) {
+      const double start_time = PIL_check_seconds_timer();
+
+      driver->curval = BPY_driver_exec(anim_rna, driver, driver_orig, anim_eval_context);
+
+      driver_python_profile_add(driver_orig, PIL_check_seconds_timer() - start_time);
+    }
+    else {
+      driver->curval = BPY_driver_exec(anim_rna, driver, driver_orig, anim_eval_context);
+    }
 
     BLI_mutex_unlock(&python_driver_lock);
 #else  /* WITH_PYTHON */
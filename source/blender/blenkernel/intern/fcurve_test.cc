@@ -212,6 +212,31 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, WithCursor)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 10; i++) {
+    insert_vert_fcurve(fcu, i, i * i, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  }
+
+  /* Forwards, backwards, jumping around and close to the keys, the cursor only changes the
+   * search of the keyframes, not the result. */
+  const float times[] = {
+      0.5f, 1.0f, 1.5f, 2.00008f, 2.5f, 2.99992f, 8.25f, 3.75f, 3.5f, 0.25f, -1.0f, 9.5f, 4.5f};
+  int cursor = 0;
+  for (const float time : times) {
+    EXPECT_NEAR(evaluate_fcurve_with_cursor(fcu, time, &cursor), evaluate_fcurve(fcu, time), 0.0f);
+  }
+
+  /* A cursor out of range, e.g. after deleting keys, is only a hint too. */
+  cursor = 100;
+  EXPECT_NEAR(evaluate_fcurve_with_cursor(fcu, 4.5f, &cursor), evaluate_fcurve(fcu, 4.5f), 0.0f);
+  EXPECT_EQ(cursor, 5);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -90,6 +90,11 @@ bool GeometryComponent::is_empty() const
   return false;
 }
 
+bool GeometryComponent::owns_direct_data() const
+{
+  return true;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -360,6 +365,11 @@ void MeshComponent::copy_vertex_group_names_from_object(const Object &object)
   }
 }
 
+const blender::Map<std::string, int> &MeshComponent::vertex_group_names() const
+{
+  return vertex_group_names_;
+}
+
 /* Get the mesh from this component. This method can be used by multiple threads at the same
  * time. Therefore, the returned mesh should not be modified. No ownership is transferred. */
 const Mesh *MeshComponent::get_for_read() const
@@ -384,6 +394,11 @@ bool MeshComponent::is_empty() const
   return mesh_ == nullptr;
 }
 
+bool MeshComponent::owns_direct_data() const
+{
+  return mesh_ == nullptr || ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -470,6 +485,11 @@ bool PointCloudComponent::is_empty() const
   return pointcloud_ == nullptr;
 }
 
+bool PointCloudComponent::owns_direct_data() const
+{
+  return pointcloud_ == nullptr || ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -484,6 +504,7 @@ GeometryComponent *InstancesComponent::copy() const
 {
   InstancesComponent *new_component = new InstancesComponent();
   new_component->transforms_ = transforms_;
+  new_component->ids_ = ids_;
   new_component->instanced_data_ = instanced_data_;
   return new_component;
 }
@@ -492,6 +513,7 @@ void InstancesComponent::clear()
 {
   instanced_data_.clear();
   transforms_.clear();
+  ids_.clear();
 }
 
 void InstancesComponent::add_instance(Object *object, float4x4 transform, const int id)
@@ -517,6 +539,13 @@ void InstancesComponent::add_instance(InstancedData data, float4x4 transform, co
   ids_.append(id);
 }
 
+void InstancesComponent::resize(const int instances_amount)
+{
+  instanced_data_.resize(instances_amount);
+  transforms_.resize(instances_amount);
+  ids_.resize(instances_amount);
+}
+
 Span<InstancedData> InstancesComponent::instanced_data() const
 {
   return instanced_data_;
@@ -532,11 +561,21 @@ Span<int> InstancesComponent::ids() const
   return ids_;
 }
 
+MutableSpan<InstancedData> InstancesComponent::instanced_data()
+{
+  return instanced_data_;
+}
+
 MutableSpan<float4x4> InstancesComponent::transforms()
 {
   return transforms_;
 }
 
+MutableSpan<int> InstancesComponent::ids()
+{
+  return ids_;
+}
+
 int InstancesComponent::instances_amount() const
 {
   const int size = instanced_data_.size();
@@ -628,6 +667,11 @@ Volume *VolumeComponent::get_for_write()
   return volume_;
 }
 
+bool VolumeComponent::owns_direct_data() const
+{
+  return volume_ == nullptr || ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -2550,6 +2550,7 @@ static bool gpencil_is_layer_mask(ViewLayer *view_layer, bGPdata *gpd, bGPDlayer
  *
  * Iterate over all visible stroke of all visible layers inside a gpObject.
  * Also take into account onion-skinning.
+ * \p stroke_cb can be NULL to only iterate over the visible frames.
  * \{ */
 
 void BKE_gpencil_visible_stroke_iter(ViewLayer *view_layer,
@@ -2699,6 +2700,10 @@ void BKE_gpencil_visible_stroke_iter(ViewLayer *view_layer,
         layer_cb(gpl, gpf, NULL, thunk);
       }
 
+      if (stroke_cb == NULL) {
+        continue;
+      }
+
       LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
         if (gps->totpoints == 0) {
           continue;
@@ -2721,6 +2726,10 @@ void BKE_gpencil_visible_stroke_iter(ViewLayer *view_layer,
         continue;
       }
 
+      if (stroke_cb == NULL) {
+        continue;
+      }
+
       LISTBASE_FOREACH (bGPDstroke *, gps, &act_gpf->strokes) {
         if (gps->totpoints == 0) {
           continue;
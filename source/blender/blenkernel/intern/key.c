@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -935,6 +936,11 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          /* Weights are only used by meshes and lattices, which use a step of one. */
+          BLI_assert(step == 1);
+          weights += start;
+        }
 
         for (b = start; b < end; b += step) {
 
@@ -1390,6 +1396,61 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Amount of vertices evaluated at once, all shape keys are accumulated into one chunk of the
+ * output before moving to the next one, which also keeps it in the CPU cache. */
+#define KEY_EVALUATE_RELATIVE_CHUNK_SIZE 4096
+
+typedef struct KeyEvaluateRelativeData {
+  Key *key;
+  KeyBlock *actkb;
+  char *out;
+  float **per_keyblock_weights;
+  int tot;
+} KeyEvaluateRelativeData;
+
+static void key_evaluate_relative_chunk_task(void *__restrict userdata,
+                                             const int chunk,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyEvaluateRelativeData *data = userdata;
+  const int start = chunk * KEY_EVALUATE_RELATIVE_CHUNK_SIZE;
+  key_evaluate_relative(start,
+                        start + KEY_EVALUATE_RELATIVE_CHUNK_SIZE,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
+/* Evaluate relative mesh shape keys over chunks of vertices in parallel. */
+static void key_evaluate_relative_mesh(
+    Key *key, KeyBlock *actkb, char *out, const int tot, float **per_keyblock_weights)
+{
+  const Mesh *me = (const Mesh *)key->from;
+  /* The active shape key of an edit-mesh is read from the #BMesh, which is copied for every
+   * evaluated range, see #key_block_get_data. */
+  if (me->edit_mesh != NULL || tot <= KEY_EVALUATE_RELATIVE_CHUNK_SIZE) {
+    key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    return;
+  }
+
+  KeyEvaluateRelativeData data = {
+      .key = key,
+      .actkb = actkb,
+      .out = out,
+      .per_keyblock_weights = per_keyblock_weights,
+      .tot = tot,
+  };
+  const int chunks_num = divide_ceil_u(tot, KEY_EVALUATE_RELATIVE_CHUNK_SIZE);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, chunks_num, &data, key_evaluate_relative_chunk_task, &settings);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1400,8 +1461,7 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    key_evaluate_relative_mesh(key, actkb, out, tot, per_keyblock_weights);
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -254,8 +254,20 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
 
   base_count = set_listbasepointers(bmain, lbarray);
 
+  /* With batch deletion, use the relations between IDs so that removing the usages of each
+   * deleted ID only visits its users, instead of the whole Main database.
+   * Existing relations may be outdated, only use them if they are created here. */
+  const bool use_relations = do_tagged_deletion && (bmain->relations == NULL);
+  if (use_relations) {
+    BKE_main_relations_create(bmain, 0);
+  }
+
   BKE_main_lock(bmain);
   if (do_tagged_deletion) {
+    const short remap_flags = ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE |
+                              ID_REMAP_SKIP_POST_PROCESS |
+                              (use_relations ? ID_REMAP_USE_MAIN_RELATIONS : 0);
+
     /* Main idea of batch deletion is to remove all IDs to be deleted from Main database.
      * This means that we won't have to loop over all deleted IDs to remove usages
      * of other deleted IDs.
@@ -300,8 +312,7 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
          * links, this can lead to nasty crashing here in second, actual deleting loop.
          * Also, this will also flag users of deleted data that cannot be unlinked
          * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(
-            bmain, id, NULL, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
+        BKE_libblock_remap_locked(bmain, id, NULL, remap_flags);
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(bmain, id, NULL, NULL, 0);
@@ -312,6 +323,9 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         // id->us = 0;  /* Is it actually? */
       }
     }
+
+    /* Collections and objects updates skipped by the remapping of each ID. */
+    BKE_libblock_remap_post_process_all(bmain);
   }
   else {
     /* First tag all datablocks directly from target lib.
@@ -342,6 +356,10 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
   }
   BKE_main_unlock(bmain);
 
+  if (use_relations) {
+    BKE_main_relations_free(bmain);
+  }
+
   /* In usual reversed order, such that all usage of a given ID, even 'never NULL' ones,
    * have been already cleared when we reach it
    * (e.g. Objects being processed before meshes, they'll have already released their 'reference'
@@ -54,9 +54,13 @@
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "RNA_access.h"
 #include "RNA_types.h"
 
+#include "CLG_log.h"
+
 #include "atomic_ops.h"
 
 #define OVERRIDE_AUTO_CHECK_DELAY 0.2 /* 200ms between auto-override checks. */
@@ -66,6 +70,8 @@
 #  include "PIL_time_utildefines.h"
 #endif
 
+static CLG_LogRef LOG = {"bke.liboverride"};
+
 static void lib_override_library_property_copy(IDOverrideLibraryProperty *op_dst,
                                                IDOverrideLibraryProperty *op_src);
 static void lib_override_library_property_operation_copy(
@@ -369,63 +375,91 @@ bool BKE_lib_override_library_create_from_tag(Main *bmain)
 }
 
 typedef struct LibOverrideGroupTagData {
+  Main *bmain;
   ID *id_root;
   uint tag;
   uint missing_tag;
 } LibOverrideGroupTagData;
 
-static int lib_override_linked_group_tag_cb(LibraryIDLinkCallbackData *cb_data)
+/* Main relations may be built by the caller beforehand, to share them between several override
+ * operations. They remain valid as long as Main is not modified.
+ *
+ * \return true if the relations were created here, and should be freed by the caller. */
+static bool lib_override_main_relations_ensure(Main *bmain)
 {
-  if (cb_data->cb_flag & (IDWALK_CB_EMBEDDED | IDWALK_CB_LOOPBACK)) {
-    return IDWALK_RET_STOP_RECURSION;
+  if (bmain->relations != NULL) {
+    return false;
   }
+  BKE_main_relations_create(bmain, 0);
+  return true;
+}
 
-  LibOverrideGroupTagData *data = cb_data->user_data;
+/* Walk the relations of `id_owner`, tagging all collections and objects from the same library as
+ * the root ID, and recursing into all IDs from that library.
+ *
+ * Note: this uses the `MAINIDRELATIONS_ENTRY_TAGS_DOIT` tag of the relations entries to only
+ * process each ID once, callers have to clear it afterwards. */
+static void lib_override_linked_group_tag_recursive(LibOverrideGroupTagData *data, ID *id_owner)
+{
+  Main *bmain = data->bmain;
   const uint tag = data->tag;
   const uint missing_tag = data->missing_tag;
+  Library *library_root = data->id_root->lib;
 
-  ID *id_root = data->id_root;
-  Library *library_root = id_root->lib;
-  ID *id = *cb_data->id_pointer;
-  ID *id_owner = cb_data->id_owner;
-
-  BLI_assert(id_owner == cb_data->id_self);
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
+                                                 id_owner);
+  BLI_assert(entry != NULL);
 
-  if (ELEM(id, NULL, id_owner)) {
-    return IDWALK_RET_NOP;
+  if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_DOIT) {
+    /* This ID has already been processed. */
+    return;
   }
+  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_DOIT;
 
   BLI_assert(id_owner->lib == library_root);
 
-  if (*(uint *)&id->tag & (tag | missing_tag)) {
-    /* Already processed and tagged, nothing else to do here. */
-    return IDWALK_RET_STOP_RECURSION;
-  }
+  for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
+       to_id_entry = to_id_entry->next) {
+    if (to_id_entry->usage_flag & (IDWALK_CB_EMBEDDED | IDWALK_CB_LOOPBACK)) {
+      continue;
+    }
 
-  if (id->lib != library_root) {
-    /* We do not override data-blocks from other libraries, nor do we process them. */
-    return IDWALK_RET_STOP_RECURSION;
-  }
+    ID *id = *to_id_entry->id_pointer.to;
+    if (ELEM(id, NULL, id_owner)) {
+      continue;
+    }
 
-  /* We tag all collections and objects for override. And we also tag all other data-blocks which
-   * would use one of those.
-   * Note: missing IDs (aka placeholders) are never overridden. */
-  if (ELEM(GS(id->name), ID_OB, ID_GR)) {
-    if ((id->tag & LIB_TAG_MISSING)) {
-      id->tag |= missing_tag;
+    if (*(uint *)&id->tag & (tag | missing_tag)) {
+      /* Already processed and tagged, nothing else to do here. */
+      continue;
     }
-    else {
-      id->tag |= tag;
+
+    if (id->lib != library_root) {
+      /* We do not override data-blocks from other libraries, nor do we process them. */
+      continue;
     }
-  }
 
-  return IDWALK_RET_NOP;
+    /* We tag all collections and objects for override. And we also tag all other data-blocks
+     * which would use one of those.
+     * Note: missing IDs (aka placeholders) are never overridden. */
+    if (ELEM(GS(id->name), ID_OB, ID_GR)) {
+      if ((id->tag & LIB_TAG_MISSING)) {
+        id->tag |= missing_tag;
+      }
+      else {
+        id->tag |= tag;
+      }
+    }
+
+    lib_override_linked_group_tag_recursive(data, id);
+  }
 }
 
 /* Tag all IDs in dependency relationships within an override hierarchy/group.
  *
  * Note: this is typically called to complete `lib_override_linked_group_tag()`.
- * Note: BMain's relations mapping won't be valid anymore after that call.
+ * Note: the `MAINIDRELATIONS_ENTRY_TAGS_PROCESSED` tags of BMain's relations entries have to be
+ * cleared after that call, before the relations can be used again.
  */
 static bool lib_override_hierarchy_dependencies_recursive_tag(Main *bmain,
                                                               ID *id,
@@ -470,18 +504,19 @@ static bool lib_override_hierarchy_dependencies_recursive_tag(Main *bmain,
  * We currently only consider Collections and Objects (that are not used as bone shapes) as valid
  * boundary IDs to define an override group.
  */
-static void lib_override_linked_group_tag(
-    Main *bmain, ID *id, const uint tag, const uint missing_tag, const bool create_bmain_relations)
+static void lib_override_linked_group_tag(Main *bmain,
+                                          ID *id,
+                                          const uint tag,
+                                          const uint missing_tag)
 {
-  if (create_bmain_relations) {
-    BKE_main_relations_create(bmain, 0);
-  }
+  BLI_assert(bmain->relations != NULL);
 
   if (ELEM(GS(id->name), ID_OB, ID_GR)) {
-    LibOverrideGroupTagData data = {.id_root = id, .tag = tag, .missing_tag = missing_tag};
+    LibOverrideGroupTagData data = {
+        .bmain = bmain, .id_root = id, .tag = tag, .missing_tag = missing_tag};
     /* Tag all collections and objects. */
-    BKE_library_foreach_ID_link(
-        bmain, id, lib_override_linked_group_tag_cb, &data, IDWALK_READONLY | IDWALK_RECURSE);
+    lib_override_linked_group_tag_recursive(&data, id);
+    BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_DOIT, false);
 
     /* Then, we remove (untag) bone shape objects, you shall never want to directly/explicitly
      * override those. */
@@ -497,66 +532,73 @@ static void lib_override_linked_group_tag(
   }
 
   lib_override_hierarchy_dependencies_recursive_tag(bmain, id, tag, missing_tag);
-
-  if (create_bmain_relations) {
-    BKE_main_relations_free(bmain);
-  }
 }
 
-static int lib_override_local_group_tag_cb(LibraryIDLinkCallbackData *cb_data)
+/* Walk the relations of `id_owner`, tagging all local overrides of the same library as the root
+ * override ID.
+ *
+ * Note: this uses the `MAINIDRELATIONS_ENTRY_TAGS_DOIT` tag of the relations entries to only
+ * process each ID once, callers have to clear it afterwards. */
+static void lib_override_local_group_tag_recursive(LibOverrideGroupTagData *data, ID *id_owner)
 {
-  if (cb_data->cb_flag &
-      (IDWALK_CB_EMBEDDED | IDWALK_CB_LOOPBACK | IDWALK_CB_OVERRIDE_LIBRARY_REFERENCE)) {
-    return IDWALK_RET_STOP_RECURSION;
-  }
-
-  LibOverrideGroupTagData *data = cb_data->user_data;
+  Main *bmain = data->bmain;
   const uint tag = data->tag;
   const uint missing_tag = data->missing_tag;
+  Library *library_reference_root = data->id_root->override_library->reference->lib;
 
-  ID *id_root = data->id_root;
-  Library *library_reference_root = id_root->override_library->reference->lib;
-  ID *id = *cb_data->id_pointer;
-  ID *id_owner = cb_data->id_owner;
-
-  BLI_assert(id_owner == cb_data->id_self);
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->relations_from_pointers,
+                                                 id_owner);
+  BLI_assert(entry != NULL);
 
-  if (ELEM(id, NULL, id_owner)) {
-    return IDWALK_RET_NOP;
+  if (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_DOIT) {
+    /* This ID has already been processed. */
+    return;
   }
+  entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_DOIT;
 
-  if (*(uint *)&id->tag & (tag | missing_tag)) {
-    /* Already processed and tagged, nothing else to do here. */
-    return IDWALK_RET_STOP_RECURSION;
-  }
+  for (MainIDRelationsEntryItem *to_id_entry = entry->to_ids; to_id_entry != NULL;
+       to_id_entry = to_id_entry->next) {
+    if (to_id_entry->usage_flag &
+        (IDWALK_CB_EMBEDDED | IDWALK_CB_LOOPBACK | IDWALK_CB_OVERRIDE_LIBRARY_REFERENCE)) {
+      continue;
+    }
 
-  if (!ID_IS_OVERRIDE_LIBRARY(id) || ID_IS_LINKED(id)) {
-    /* Fully local, or linked ID, those are never part of a local override group. */
-    return IDWALK_RET_STOP_RECURSION;
-  }
+    ID *id = *to_id_entry->id_pointer.to;
+    if (ELEM(id, NULL, id_owner)) {
+      continue;
+    }
 
-  /* NOTE: Since we rejected embedded data too at the beginning of this function, id should only be
-   * a real override now.
-   *
-   * However, our usual trouble maker, Key, is not considered as an embedded ID currently, yet it
-   * is never a real override either. Enjoy. */
-  if (!ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
-    return IDWALK_RET_NOP;
-  }
+    if (*(uint *)&id->tag & (tag | missing_tag)) {
+      /* Already processed and tagged, nothing else to do here. */
+      continue;
+    }
 
-  if (id->override_library->reference->lib != library_reference_root) {
-    /* We do not override data-blocks from other libraries, nor do we process them. */
-    return IDWALK_RET_STOP_RECURSION;
-  }
+    if (!ID_IS_OVERRIDE_LIBRARY(id) || ID_IS_LINKED(id)) {
+      /* Fully local, or linked ID, those are never part of a local override group. */
+      continue;
+    }
 
-  if (id->override_library->reference->tag & LIB_TAG_MISSING) {
-    id->tag |= missing_tag;
-  }
-  else {
-    id->tag |= tag;
-  }
+    /* NOTE: Since we rejected embedded data too at the beginning of this loop, id should only be
+     * a real override now.
+     *
+     * However, our usual trouble maker, Key, is not considered as an embedded ID currently, yet it
+     * is never a real override either. Enjoy. */
+    if (ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
+      if (id->override_library->reference->lib != library_reference_root) {
+        /* We do not override data-blocks from other libraries, nor do we process them. */
+        continue;
+      }
+
+      if (id->override_library->reference->tag & LIB_TAG_MISSING) {
+        id->tag |= missing_tag;
+      }
+      else {
+        id->tag |= tag;
+      }
+    }
 
-  return IDWALK_RET_NOP;
+    lib_override_local_group_tag_recursive(data, id);
+  }
 }
 
 /* This will tag at least all 'boundary' linked IDs for a potential override group.
@@ -572,21 +614,25 @@ static void lib_override_local_group_tag(Main *bmain,
                                          const uint tag,
                                          const uint missing_tag)
 {
-  LibOverrideGroupTagData data = {.id_root = id, .tag = tag, .missing_tag = missing_tag};
+  BLI_assert(bmain->relations != NULL);
+
+  LibOverrideGroupTagData data = {
+      .bmain = bmain, .id_root = id, .tag = tag, .missing_tag = missing_tag};
   /* Tag all local overrides in id_root's group. */
-  BKE_library_foreach_ID_link(
-      bmain, id, lib_override_local_group_tag_cb, &data, IDWALK_READONLY | IDWALK_RECURSE);
+  lib_override_local_group_tag_recursive(&data, id);
+  BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_DOIT, false);
 }
 
 static bool lib_override_library_create_do(Main *bmain, ID *id_root)
 {
   id_root->tag |= LIB_TAG_DOIT;
 
-  BKE_main_relations_create(bmain, 0);
+  lib_override_main_relations_ensure(bmain);
 
-  lib_override_linked_group_tag(bmain, id_root, LIB_TAG_DOIT, LIB_TAG_MISSING, false);
+  lib_override_linked_group_tag(bmain, id_root, LIB_TAG_DOIT, LIB_TAG_MISSING);
   lib_override_hierarchy_dependencies_recursive_tag(bmain, id_root, LIB_TAG_DOIT, LIB_TAG_MISSING);
 
+  /* Creating the overrides modifies Main, relations cannot be kept around past this point. */
   BKE_main_relations_free(bmain);
 
   return BKE_lib_override_library_create_from_tag(bmain);
@@ -711,6 +757,8 @@ static void lib_override_library_create_post_process(
 bool BKE_lib_override_library_create(
     Main *bmain, Scene *scene, ViewLayer *view_layer, ID *id_root, ID *id_reference)
 {
+  const double start_time = PIL_check_seconds_timer();
+
   const bool success = lib_override_library_create_do(bmain, id_root);
 
   if (!success) {
@@ -723,6 +771,12 @@ bool BKE_lib_override_library_create(
   BKE_main_id_clear_newpoins(bmain);
   BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
 
+  CLOG_INFO(&LOG,
+            1,
+            "Override hierarchy of '%s' created in %.3f seconds",
+            id_root->name,
+            PIL_check_seconds_timer() - start_time);
+
   return success;
 }
 
@@ -769,10 +823,117 @@ bool BKE_lib_override_library_proxy_convert(Main *bmain,
   return BKE_lib_override_library_create(bmain, scene, view_layer, id_root, id_reference);
 }
 
+static MainIDRelationsEntryItem *lib_override_resync_usage_next(MainIDRelationsEntryItem *item)
+{
+  /* Loop-back pointers are never dependencies, and the reference pointer only exists in
+   * overrides. */
+  while (item != NULL &&
+         (item->usage_flag & (IDWALK_CB_LOOPBACK | IDWALK_CB_OVERRIDE_LIBRARY_REFERENCE))) {
+    item = item->next;
+  }
+  return item;
+}
+
+/* Check whether an existing override still uses the same IDs as its linked reference, once those
+ * are mapped to their existing overrides.
+ *
+ * Both IDs are of the same type, so as long as the override did not add or remove any sub-data
+ * using IDs (like constraints or modifiers), the relations are listed in the same order. Any
+ * difference is considered as a change in the linked data, this is conservative: a full resync is
+ * never wrongly skipped. */
+static bool lib_override_resync_id_usages_match(Main *bmain,
+                                                GHash *linkedref_to_old_override,
+                                                ID *id_reference,
+                                                ID *id_override)
+{
+  MainIDRelationsEntry *entry_reference = BLI_ghash_lookup(
+      bmain->relations->relations_from_pointers, id_reference);
+  MainIDRelationsEntry *entry_override = BLI_ghash_lookup(
+      bmain->relations->relations_from_pointers, id_override);
+  if (entry_reference == NULL || entry_override == NULL) {
+    return entry_reference == entry_override;
+  }
+
+  MainIDRelationsEntryItem *item_reference = entry_reference->to_ids;
+  MainIDRelationsEntryItem *item_override = entry_override->to_ids;
+  while (true) {
+    item_reference = lib_override_resync_usage_next(item_reference);
+    item_override = lib_override_resync_usage_next(item_override);
+    if (item_reference == NULL || item_override == NULL) {
+      return item_reference == item_override;
+    }
+    if (item_reference->usage_flag != item_override->usage_flag) {
+      return false;
+    }
+
+    ID *to_id_reference = *item_reference->id_pointer.to;
+    ID *to_id_override = *item_override->id_pointer.to;
+
+    if ((item_reference->usage_flag & IDWALK_CB_EMBEDDED) ||
+        (to_id_override->flag & LIB_EMBEDDED_DATA_LIB_OVERRIDE)) {
+      /* Embedded IDs and shape keys are owned by the override, compare their own usages. */
+      if (!lib_override_resync_id_usages_match(
+              bmain, linkedref_to_old_override, to_id_reference, to_id_override)) {
+        return false;
+      }
+    }
+    else {
+      ID *to_id_expected = BLI_ghash_lookup(linkedref_to_old_override, to_id_reference);
+      if (to_id_override != (to_id_expected != NULL ? to_id_expected : to_id_reference)) {
+        return false;
+      }
+    }
+
+    item_reference = item_reference->next;
+    item_override = item_override->next;
+  }
+}
+
+/* Check whether the tagged override hierarchy needs to be re-created from its linked reference,
+ * i.e. whether overrides have to be added, removed or relinked. Changes of other data in linked
+ * IDs are handled by the regular override update. */
+static bool lib_override_library_resync_is_needed(Main *bmain, GHash *linkedref_to_old_override)
+{
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (ID_IS_LINKED(id)) {
+      if ((id->tag & LIB_TAG_DOIT) && BKE_idtype_idcode_is_linkable(GS(id->name)) &&
+          !BLI_ghash_haskey(linkedref_to_old_override, id)) {
+        /* New linked data in the hierarchy. */
+        return true;
+      }
+    }
+    else if (id->tag & LIB_TAG_MISSING) {
+      /* Linked reference went missing. */
+      return true;
+    }
+    else if ((id->tag & LIB_TAG_DOIT) && ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
+      ID *id_reference = id->override_library->reference;
+      if ((id_reference->tag & LIB_TAG_DOIT) == 0 ||
+          BLI_ghash_lookup(linkedref_to_old_override, id_reference) != id) {
+        /* Reference left the linked hierarchy, or is overridden several times. */
+        return true;
+      }
+      if (!lib_override_resync_id_usages_match(
+              bmain, linkedref_to_old_override, id_reference, id)) {
+        return true;
+      }
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  return false;
+}
+
 /**
  * Advanced 'smart' function to resync, re-create fully functional overrides up-to-date with linked
  * data, from an existing override hierarchy.
  *
+ * When the linked hierarchy did not change, nothing is re-created.
+ *
+ * \note Existing `bmain->relations` are used if valid, and kept if nothing had to be re-created,
+ * so that they can be shared between the resync of several hierarchies.
+ *
  * \param id_root: The root liboverride ID to resync from.
  * \return true if override was successfully resynced.
  */
@@ -780,12 +941,17 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
 {
   BLI_assert(ID_IS_OVERRIDE_LIBRARY_REAL(id_root));
 
+  const double start_time = PIL_check_seconds_timer();
+
   id_root->tag |= LIB_TAG_DOIT;
   ID *id_root_reference = id_root->override_library->reference;
 
+  const bool do_free_relations = lib_override_main_relations_ensure(bmain);
+
   lib_override_local_group_tag(bmain, id_root, LIB_TAG_DOIT, LIB_TAG_MISSING);
 
-  lib_override_linked_group_tag(bmain, id_root_reference, LIB_TAG_DOIT, LIB_TAG_MISSING, true);
+  lib_override_linked_group_tag(bmain, id_root_reference, LIB_TAG_DOIT, LIB_TAG_MISSING);
+  BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
 
   /* Make a mapping 'linked reference IDs' -> 'Local override IDs' of existing overrides. */
   GHash *linkedref_to_old_override = BLI_ghash_new(
@@ -804,6 +970,24 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
   }
   FOREACH_MAIN_ID_END;
 
+  if (!lib_override_library_resync_is_needed(bmain, linkedref_to_old_override)) {
+    BLI_ghash_free(linkedref_to_old_override, NULL, NULL);
+    if (do_free_relations) {
+      BKE_main_relations_free(bmain);
+    }
+    BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+
+    CLOG_INFO(&LOG,
+              1,
+              "Override hierarchy of '%s' is up to date, checked in %.3f seconds",
+              id_root_reference->name,
+              PIL_check_seconds_timer() - start_time);
+    return true;
+  }
+
+  /* Re-creating the overrides modifies Main, relations cannot be kept around past this point. */
+  BKE_main_relations_free(bmain);
+
   /* Make new override from linked data. */
   /* Note that this call also remaps all pointers of tagged IDs from old override IDs to new
    * override IDs (including within the old overrides themselves, since those are tagged too
@@ -941,6 +1125,12 @@ bool BKE_lib_override_library_resync(Main *bmain, Scene *scene, ViewLayer *view_
   BKE_main_id_clear_newpoins(bmain);
   BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false); /* That one should not be needed in fact. */
 
+  CLOG_INFO(&LOG,
+            1,
+            "Override hierarchy of '%s' resynced in %.3f seconds",
+            id_root_reference->name,
+            PIL_check_seconds_timer() - start_time);
+
   return success;
 }
 
@@ -960,7 +1150,10 @@ void BKE_lib_override_library_delete(Main *bmain, ID *id_root)
   id_root->tag |= LIB_TAG_DOIT;
 
   /* Tag all library overrides in the chains of dependencies from the given root one. */
+  lib_override_main_relations_ensure(bmain);
   lib_override_local_group_tag(bmain, id_root, LIB_TAG_DOIT, LIB_TAG_DOIT);
+  /* Remapping and deleting modifies Main, relations cannot be kept around past this point. */
+  BKE_main_relations_free(bmain);
 
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
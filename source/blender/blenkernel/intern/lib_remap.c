@@ -22,6 +22,10 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
+#include "BLI_mempool.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -369,6 +373,80 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
  * (uselful to retrieve info about remapping process).
  */
 ATTR_NONNULL(1)
+/**
+ * Get the ID in Main holding \a id, which is \a id itself unless it is an embedded ID (e.g. the
+ * node tree of a material), relations store the embedded IDs as users of the IDs they use.
+ */
+static ID *libblock_remap_relations_owner_get(MainIDRelations *relations, ID *id)
+{
+  while (id != NULL && (id->flag & LIB_EMBEDDED_DATA) != 0) {
+    MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, id);
+    ID *id_owner = NULL;
+    if (entry != NULL) {
+      for (MainIDRelationsEntryItem *item = entry->from_ids; item != NULL; item = item->next) {
+        if (item->usage_flag & IDWALK_CB_EMBEDDED) {
+          id_owner = item->id_pointer.from;
+          break;
+        }
+      }
+    }
+    id = id_owner;
+  }
+  return id;
+}
+
+/**
+ * Remap the usages of \a r_id_remap_data old ID, only visiting the IDs using it according to
+ * #Main.relations.
+ */
+static void libblock_remap_data_from_relations(Main *bmain,
+                                               IDRemap *r_id_remap_data,
+                                               const int foreach_id_flags)
+{
+  MainIDRelations *relations = bmain->relations;
+  ID *old_id = r_id_remap_data->old_id;
+  ID *new_id = r_id_remap_data->new_id;
+
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (entry == NULL || entry->from_ids == NULL) {
+    return;
+  }
+
+  MainIDRelationsEntry *new_entry = NULL;
+  if (new_id != NULL) {
+    MainIDRelationsEntry **new_entry_p;
+    if (!BLI_ghash_ensure_p(relations->relations_from_pointers, new_id, (void ***)&new_entry_p)) {
+      *new_entry_p = MEM_callocN(sizeof(**new_entry_p), __func__);
+      (*new_entry_p)->session_uuid = new_id->session_uuid;
+    }
+    new_entry = *new_entry_p;
+  }
+
+  GSet *ids_handled = BLI_gset_ptr_new(__func__);
+  for (MainIDRelationsEntryItem *item = entry->from_ids; item != NULL; item = item->next) {
+    ID *id_owner = libblock_remap_relations_owner_get(relations, item->id_pointer.from);
+    if (id_owner != NULL && BLI_gset_add(ids_handled, id_owner)) {
+      r_id_remap_data->id_owner = id_owner;
+      libblock_remap_data_preprocess(r_id_remap_data);
+      BKE_library_foreach_ID_link(NULL,
+                                  id_owner,
+                                  foreach_libblock_remap_callback,
+                                  (void *)r_id_remap_data,
+                                  foreach_id_flags);
+    }
+
+    /* Keep relations valid for the following remappings, old users of old_id may now use new_id.
+     * Users of old_id are kept as well, some usages may have been skipped. */
+    if (new_entry != NULL) {
+      MainIDRelationsEntryItem *new_item = BLI_mempool_alloc(relations->entry_items_pool);
+      *new_item = *item;
+      new_item->next = new_entry->from_ids;
+      new_entry->from_ids = new_item;
+    }
+  }
+  BLI_gset_free(ids_handled, NULL);
+}
+
 static void libblock_remap_data(
     Main *bmain, ID *id, ID *old_id, ID *new_id, const short remap_flags, IDRemap *r_id_remap_data)
 {
@@ -399,6 +477,9 @@ static void libblock_remap_data(
     BKE_library_foreach_ID_link(
         NULL, id, foreach_libblock_remap_callback, (void *)r_id_remap_data, foreach_id_flags);
   }
+  else if ((remap_flags & ID_REMAP_USE_MAIN_RELATIONS) && bmain->relations != NULL) {
+    libblock_remap_data_from_relations(bmain, r_id_remap_data, foreach_id_flags);
+  }
   else {
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
@@ -512,11 +593,15 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
    * Maybe we should do a per-ID callback for this instead? */
   switch (GS(old_id->name)) {
     case ID_OB:
-      libblock_remap_data_postprocess_object_update(bmain, (Object *)old_id, (Object *)new_id);
+      if ((remap_flags & ID_REMAP_SKIP_POST_PROCESS) == 0) {
+        libblock_remap_data_postprocess_object_update(bmain, (Object *)old_id, (Object *)new_id);
+      }
       break;
     case ID_GR:
-      libblock_remap_data_postprocess_collection_update(
-          bmain, (Collection *)old_id, (Collection *)new_id);
+      if ((remap_flags & ID_REMAP_SKIP_POST_PROCESS) == 0) {
+        libblock_remap_data_postprocess_collection_update(
+            bmain, (Collection *)old_id, (Collection *)new_id);
+      }
       break;
     case ID_ME:
     case ID_CU:
@@ -555,6 +640,71 @@ void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short r
   BKE_main_unlock(bmain);
 }
 
+/**
+ * Remap all usages of each of \a old_ids by the matching item of \a new_ids (which may be NULL
+ * to unlink them all).
+ *
+ * Unlike calling #BKE_libblock_remap_locked for each of them, the whole Main database is only
+ * walked once to find the users of the IDs, and the updates of collections and objects are only
+ * done once at the end.
+ */
+void BKE_libblock_remap_multiple_locked(
+    Main *bmain, ID **old_ids, ID **new_ids, const int ids_len, const short remap_flags)
+{
+  if (ids_len == 0) {
+    return;
+  }
+
+  /* Existing relations may be outdated, only use them if they are created here. */
+  const bool use_relations = (bmain->relations == NULL);
+  if (use_relations) {
+    BKE_main_relations_create(bmain, 0);
+  }
+
+  const short remap_flags_multiple = remap_flags | ID_REMAP_SKIP_POST_PROCESS |
+                                     (use_relations ? ID_REMAP_USE_MAIN_RELATIONS : 0);
+  for (int i = 0; i < ids_len; i++) {
+    BKE_libblock_remap_locked(
+        bmain, old_ids[i], (new_ids != NULL) ? new_ids[i] : NULL, remap_flags_multiple);
+  }
+
+  if (use_relations) {
+    BKE_main_relations_free(bmain);
+  }
+
+  BKE_libblock_remap_post_process_all(bmain);
+}
+
+void BKE_libblock_remap_multiple(
+    Main *bmain, ID **old_ids, ID **new_ids, const int ids_len, const short remap_flags)
+{
+  BKE_main_lock(bmain);
+
+  BKE_libblock_remap_multiple_locked(bmain, old_ids, new_ids, ids_len, remap_flags);
+
+  BKE_main_unlock(bmain);
+}
+
+/**
+ * Update collections and objects of the whole Main database after remappings done with
+ * #ID_REMAP_SKIP_POST_PROCESS.
+ */
+void BKE_libblock_remap_post_process_all(Main *bmain)
+{
+  /* Same as the collection and object updates done after each remapping, for any old and new
+   * IDs. */
+  BKE_collections_child_remove_nulls(bmain, NULL);
+  BKE_main_collections_parent_relations_rebuild(bmain);
+  BKE_collections_object_remove_nulls(bmain);
+  BKE_main_collection_sync_remap(bmain);
+
+  for (Object *ob = bmain->objects.first; ob != NULL; ob = ob->id.next) {
+    if (ob->type == OB_MBALL && BKE_mball_is_basis(ob)) {
+      DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+    }
+  }
+}
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
@@ -309,6 +309,27 @@ void BKE_main_relations_free(Main *bmain)
   }
 }
 
+/** Set or clear given `tag` in all relation entries of given `bmain`. */
+void BKE_main_relations_tag_set(struct Main *bmain,
+                                const MainIDRelationsEntryTags tag,
+                                const bool value)
+{
+  if (bmain->relations == NULL) {
+    return;
+  }
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, bmain->relations->relations_from_pointers) {
+    MainIDRelationsEntry *entry = BLI_ghashIterator_getValue(&gh_iter);
+    if (value) {
+      entry->tags |= tag;
+    }
+    else {
+      entry->tags &= ~tag;
+    }
+  }
+}
+
 /**
  * Create a GSet storing all IDs present in given \a bmain, by their pointers.
  *
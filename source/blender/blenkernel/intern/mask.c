@@ -1600,6 +1600,36 @@ void BKE_mask_evaluate(Mask *mask, const float ctime, const bool do_newframe)
   }
 }
 
+/**
+ * Check whether evaluating the mask can give a different result depending on the frame:
+ * animation data, layer shape keys or parenting to motion tracking data.
+ */
+bool BKE_mask_is_animated(const Mask *mask)
+{
+  if (BKE_animdata_id_is_animated(&mask->id)) {
+    return true;
+  }
+
+  LISTBASE_FOREACH (const MaskLayer *, masklay, &mask->masklayers) {
+    if (!BLI_listbase_is_empty(&masklay->splines_shapes)) {
+      return true;
+    }
+
+    LISTBASE_FOREACH (const MaskSpline *, spline, &masklay->splines) {
+      if (spline->parent.id != NULL) {
+        return true;
+      }
+      for (int i = 0; i < spline->tot_point; i++) {
+        if (spline->points[i].parent.id != NULL) {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
 void BKE_mask_parent_init(MaskParent *parent)
 {
   parent->id_type = ID_MC;
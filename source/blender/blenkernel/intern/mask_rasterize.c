@@ -73,6 +73,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_vec_types.h"
 
+#include "BLI_alloca.h"
 #include "BLI_memarena.h"
 #include "BLI_scanfill.h"
 #include "BLI_utildefines.h"
@@ -1345,6 +1346,110 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
   return 1.0f;
 }
 
+/**
+ * Value of a single layer at \a xy, before blending it with the layers below.
+ */
+BLI_INLINE float maskrasterize_layer_value(MaskRasterLayer *layer, const float xy[2])
+{
+  float value_layer;
+
+  /* also used as signal for unused layer (when render is disabled) */
+  if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
+    value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
+
+    switch (layer->falloff) {
+      case PROP_SMOOTH:
+        /* ease - gives less hard lines for dilate/erode feather */
+        value_layer = (3.0f * value_layer * value_layer -
+                       2.0f * value_layer * value_layer * value_layer);
+        break;
+      case PROP_SPHERE:
+        value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
+        break;
+      case PROP_ROOT:
+        value_layer = sqrtf(value_layer);
+        break;
+      case PROP_SHARP:
+        value_layer = value_layer * value_layer;
+        break;
+      case PROP_INVSQUARE:
+        value_layer = value_layer * (2.0f - value_layer);
+        break;
+      case PROP_LIN:
+      default:
+        /* nothing */
+        break;
+    }
+
+    if (layer->blend != MASK_BLEND_REPLACE) {
+      value_layer *= layer->alpha;
+    }
+  }
+  else {
+    value_layer = 0.0f;
+  }
+
+  if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
+    value_layer = 1.0f - value_layer;
+  }
+
+  return value_layer;
+}
+
+/**
+ * Value of a layer outside of its bounds, which is the same for every pixel there.
+ */
+BLI_INLINE float maskrasterize_layer_value_outside(const MaskRasterLayer *layer)
+{
+  return (layer->blend_flag & MASK_BLENDFLAG_INVERT) ? 1.0f : 0.0f;
+}
+
+BLI_INLINE float maskrasterize_layer_blend(const MaskRasterLayer *layer,
+                                           float value,
+                                           const float value_layer)
+{
+  switch (layer->blend) {
+    case MASK_BLEND_MERGE_ADD:
+      value += value_layer * (1.0f - value);
+      break;
+    case MASK_BLEND_MERGE_SUBTRACT:
+      value -= value_layer * value;
+      break;
+    case MASK_BLEND_ADD:
+      value += value_layer;
+      break;
+    case MASK_BLEND_SUBTRACT:
+      value -= value_layer;
+      break;
+    case MASK_BLEND_LIGHTEN:
+      value = max_ff(value, value_layer);
+      break;
+    case MASK_BLEND_DARKEN:
+      value = min_ff(value, value_layer);
+      break;
+    case MASK_BLEND_MUL:
+      value *= value_layer;
+      break;
+    case MASK_BLEND_REPLACE:
+      value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
+      break;
+    case MASK_BLEND_DIFFERENCE:
+      value = fabsf(value - value_layer);
+      break;
+    default: /* same as add */
+      CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
+      BLI_assert(0);
+      value += value_layer;
+      break;
+  }
+
+  /* clamp after applying each layer so we don't get
+   * issues subtracting after accumulating over 1.0f */
+  CLAMP(value, 0.0f, 1.0f);
+
+  return value;
+}
+
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
 {
   /* can't do this because some layers may invert */
@@ -1357,102 +1462,27 @@ float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float x
   float value = 0.0f;
 
   for (uint i = 0; i < layers_tot; i++, layer++) {
-    float value_layer;
-
-    /* also used as signal for unused layer (when render is disabled) */
-    if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
-      value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
-
-      switch (layer->falloff) {
-        case PROP_SMOOTH:
-          /* ease - gives less hard lines for dilate/erode feather */
-          value_layer = (3.0f * value_layer * value_layer -
-                         2.0f * value_layer * value_layer * value_layer);
-          break;
-        case PROP_SPHERE:
-          value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
-          break;
-        case PROP_ROOT:
-          value_layer = sqrtf(value_layer);
-          break;
-        case PROP_SHARP:
-          value_layer = value_layer * value_layer;
-          break;
-        case PROP_INVSQUARE:
-          value_layer = value_layer * (2.0f - value_layer);
-          break;
-        case PROP_LIN:
-        default:
-          /* nothing */
-          break;
-      }
-
-      if (layer->blend != MASK_BLEND_REPLACE) {
-        value_layer *= layer->alpha;
-      }
-    }
-    else {
-      value_layer = 0.0f;
-    }
-
-    if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
-      value_layer = 1.0f - value_layer;
-    }
-
-    switch (layer->blend) {
-      case MASK_BLEND_MERGE_ADD:
-        value += value_layer * (1.0f - value);
-        break;
-      case MASK_BLEND_MERGE_SUBTRACT:
-        value -= value_layer * value;
-        break;
-      case MASK_BLEND_ADD:
-        value += value_layer;
-        break;
-      case MASK_BLEND_SUBTRACT:
-        value -= value_layer;
-        break;
-      case MASK_BLEND_LIGHTEN:
-        value = max_ff(value, value_layer);
-        break;
-      case MASK_BLEND_DARKEN:
-        value = min_ff(value, value_layer);
-        break;
-      case MASK_BLEND_MUL:
-        value *= value_layer;
-        break;
-      case MASK_BLEND_REPLACE:
-        value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
-        break;
-      case MASK_BLEND_DIFFERENCE:
-        value = fabsf(value - value_layer);
-        break;
-      default: /* same as add */
-        CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
-        BLI_assert(0);
-        value += value_layer;
-        break;
-    }
-
-    /* clamp after applying each layer so we don't get
-     * issues subtracting after accumulating over 1.0f */
-    CLAMP(value, 0.0f, 1.0f);
+    value = maskrasterize_layer_blend(layer, value, maskrasterize_layer_value(layer, xy));
   }
 
   return value;
 }
 
+/* Size in pixels of the square tiles the buffer is rasterized in. */
+#define MASK_RASTER_TILE_SIZE 64
+
 typedef struct MaskRasterizeBufferData {
   MaskRasterHandle *mr_handle;
   float x_inv, y_inv;
   float x_px_ofs, y_px_ofs;
-  uint width;
+  uint width, height;
+  uint tiles_x;
 
   float *buffer;
 } MaskRasterizeBufferData;
 
 static void maskrasterize_buffer_cb(void *__restrict userdata,
-                                    const int y,
+                                    const int tile_index,
                                     const TaskParallelTLS *__restrict UNUSED(tls))
 {
   MaskRasterizeBufferData *data = userdata;
@@ -1460,22 +1490,77 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   MaskRasterHandle *mr_handle = data->mr_handle;
   float *buffer = data->buffer;
 
+  const uint layers_tot = mr_handle->layers_tot;
   const uint width = data->width;
   const float x_inv = data->x_inv;
+  const float y_inv = data->y_inv;
   const float x_px_ofs = data->x_px_ofs;
+  const float y_px_ofs = data->y_px_ofs;
+
+  const uint x_start = ((uint)tile_index % data->tiles_x) * MASK_RASTER_TILE_SIZE;
+  const uint y_start = ((uint)tile_index / data->tiles_x) * MASK_RASTER_TILE_SIZE;
+  const uint x_end = MIN2(x_start + MASK_RASTER_TILE_SIZE, width);
+  const uint y_end = MIN2(y_start + MASK_RASTER_TILE_SIZE, data->height);
+
+  /* Bounds of the pixel centers of this tile, computed the same way as the sample positions. */
+  const rctf tile_bounds = {
+      .xmin = ((float)x_start * x_inv) + x_px_ofs,
+      .xmax = ((float)(x_end - 1) * x_inv) + x_px_ofs,
+      .ymin = ((float)y_start * y_inv) + y_px_ofs,
+      .ymax = ((float)(y_end - 1) * y_inv) + y_px_ofs,
+  };
 
-  uint i = (uint)y * width;
-  float xy[2];
-  xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
-  for (uint x = 0; x < width; x++, i++) {
-    xy[0] = ((float)x * x_inv) + x_px_ofs;
+  /* Layers which don't overlap the tile have the same value for all of its pixels,
+   * only sample the others. */
+  float *layer_outside_value = BLI_array_alloca(layer_outside_value, layers_tot);
+  bool any_layer_inside = false;
+  for (uint i = 0; i < layers_tot; i++) {
+    const MaskRasterLayer *layer = &mr_handle->layers[i];
+    if (layer->alpha != 0.0f && BLI_rctf_isect(&layer->bounds, &tile_bounds, NULL)) {
+      layer_outside_value[i] = -1.0f;
+      any_layer_inside = true;
+    }
+    else {
+      layer_outside_value[i] = maskrasterize_layer_value_outside(layer);
+    }
+  }
+
+  if (!any_layer_inside) {
+    float value = 0.0f;
+    for (uint i = 0; i < layers_tot; i++) {
+      value = maskrasterize_layer_blend(&mr_handle->layers[i], value, layer_outside_value[i]);
+    }
+    for (uint y = y_start; y < y_end; y++) {
+      copy_vn_fl(&buffer[(size_t)y * width + x_start], (int)(x_end - x_start), value);
+    }
+    return;
+  }
 
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
+  float xy[2];
+  for (uint y = y_start; y < y_end; y++) {
+    size_t i = (size_t)y * width + x_start;
+    xy[1] = ((float)y * y_inv) + y_px_ofs;
+    for (uint x = x_start; x < x_end; x++, i++) {
+      xy[0] = ((float)x * x_inv) + x_px_ofs;
+
+      float value = 0.0f;
+      for (uint layer_index = 0; layer_index < layers_tot; layer_index++) {
+        MaskRasterLayer *layer = &mr_handle->layers[layer_index];
+        const float value_layer = (layer_outside_value[layer_index] < 0.0f) ?
+                                      maskrasterize_layer_value(layer, xy) :
+                                      layer_outside_value[layer_index];
+        value = maskrasterize_layer_blend(layer, value, value_layer);
+      }
+      buffer[i] = value;
+    }
   }
 }
 
 /**
  * \brief Rasterize a buffer from a single mask (threaded execution).
+ *
+ * The buffer is filled in tiles, layers which don't overlap a tile are only evaluated once for
+ * the whole tile and tiles outside of all layers get a constant value.
  */
 void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
                               const unsigned int width,
@@ -1484,8 +1569,14 @@ void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
                                * NOLINTNEXTLINE: readability-non-const-parameter. */
                               float *buffer)
 {
+  if (width == 0 || height == 0) {
+    return;
+  }
+
   const float x_inv = 1.0f / (float)width;
   const float y_inv = 1.0f / (float)height;
+  const uint tiles_x = divide_ceil_u(width, MASK_RASTER_TILE_SIZE);
+  const uint tiles_y = divide_ceil_u(height, MASK_RASTER_TILE_SIZE);
 
   MaskRasterizeBufferData data = {
       .mr_handle = mr_handle,
@@ -1494,10 +1585,12 @@ void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
       .x_px_ofs = x_inv * 0.5f,
       .y_px_ofs = y_inv * 0.5f,
       .width = width,
+      .height = height,
+      .tiles_x = tiles_x,
       .buffer = buffer,
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = ((size_t)height * width > 10000);
-  BLI_task_parallel_range(0, (int)height, &data, maskrasterize_buffer_cb, &settings);
+  BLI_task_parallel_range(0, (int)(tiles_x * tiles_y), &data, maskrasterize_buffer_cb, &settings);
 }
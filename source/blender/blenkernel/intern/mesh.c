@@ -637,6 +637,25 @@ const char *BKE_mesh_cmp(Mesh *me1, Mesh *me2, float thresh)
   return NULL;
 }
 
+/**
+ * Combine the geometry and the settings of the mesh which are used by modifiers into the given
+ * hash, to detect changes between evaluations without keeping a copy of the mesh around.
+ */
+uint64_t BKE_mesh_content_hash(const Mesh *me, uint64_t hash)
+{
+  hash = CustomData_hash(&me->vdata, me->totvert, hash);
+  hash = CustomData_hash(&me->edata, me->totedge, hash);
+  hash = CustomData_hash(&me->ldata, me->totloop, hash);
+  hash = CustomData_hash(&me->pdata, me->totpoly, hash);
+  hash = BLI_hash_u64_combine(hash, (uint64_t)me->flag);
+  hash = BLI_hash_buffer_u64(&me->smoothresh, sizeof(me->smoothresh), hash);
+  hash = BLI_hash_u64_combine(hash, (uint64_t)me->totcol);
+  if (me->mat != NULL) {
+    hash = BLI_hash_buffer_u64(me->mat, sizeof(*me->mat) * (size_t)me->totcol, hash);
+  }
+  return hash;
+}
+
 static void mesh_ensure_tessellation_customdata(Mesh *me)
 {
   if (UNLIKELY((me->totface != 0) && (me->totpoly == 0))) {
@@ -1472,13 +1491,11 @@ void BKE_mesh_looptri_get_real_edges(const Mesh *mesh, const MLoopTri *looptri,
 /* basic vertex data functions */
 bool BKE_mesh_minmax(const Mesh *me, float r_min[3], float r_max[3])
 {
-  int i = me->totvert;
-  MVert *mvert;
-  for (mvert = me->mvert; i--; mvert++) {
-    minmax_v3v3_v3(r_min, r_max, mvert->co);
+  if (me->totvert == 0) {
+    return false;
   }
-
-  return (me->totvert != 0);
+  minmax_v3v3_v3_array_stride(r_min, r_max, me->mvert->co, me->totvert, sizeof(MVert));
+  return true;
 }
 
 void BKE_mesh_transform(Mesh *me, const float mat[4][4], bool do_keys)
@@ -1490,17 +1507,14 @@ void BKE_mesh_transform(Mesh *me, const float mat[4][4], bool do_keys)
   /* If the referenced l;ayer has been re-allocated need to update pointers stored in the mesh. */
   BKE_mesh_update_customdata_pointers(me, false);
 
-  for (i = 0; i < me->totvert; i++, mvert++) {
-    mul_m4_v3(mat, mvert->co);
+  if (me->totvert > 0) {
+    mul_m4_v3_array_stride(mat, mvert->co, me->totvert, sizeof(MVert));
   }
 
   if (do_keys && me->key) {
     KeyBlock *kb;
     for (kb = me->key->block.first; kb; kb = kb->next) {
-      float *fp = kb->data;
-      for (i = kb->totelem; i--; fp += 3) {
-        mul_m4_v3(mat, fp);
-      }
+      mul_m4_v3_array(mat, kb->data, kb->totelem);
     }
   }
 
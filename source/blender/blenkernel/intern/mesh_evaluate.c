@@ -49,6 +49,7 @@
 #include "BKE_editmesh_cache.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_multires.h"
 #include "BKE_report.h"
 
@@ -211,7 +212,6 @@ typedef struct MeshCalcNormalsData {
   const MLoop *mloop;
   MVert *mverts;
   float (*pnors)[3];
-  float (*lnors_weighted)[3];
   float (*vnors)[3];
 } MeshCalcNormalsData;
 
@@ -236,7 +236,7 @@ static void mesh_calc_normals_poly_prepare_cb(void *__restrict userdata,
 
   float pnor_temp[3];
   float *pnor = data->pnors ? data->pnors[pidx] : pnor_temp;
-  float(*lnors_weighted)[3] = data->lnors_weighted;
+  float(*vnors)[3] = data->vnors;
 
   const int nverts = mp->totloop;
   float(*edgevecbuf)[3] = BLI_array_alloca(edgevecbuf, (size_t)nverts);
@@ -267,21 +267,23 @@ static void mesh_calc_normals_poly_prepare_cb(void *__restrict userdata,
   }
 
   /* accumulate angle weighted face normal */
-  /* inline version of #accumulate_vertex_normals_poly_v3,
-   * split between this threaded callback and #mesh_calc_normals_poly_accum_cb. */
+  /* inline version of #accumulate_vertex_normals_poly_v3.
+   * Vertices are shared between polygons processed by different threads, so the sums are
+   * accumulated atomically instead of in a separate single-threaded pass over all loops. */
   {
     const float *prev_edge = edgevecbuf[nverts - 1];
 
     for (int i = 0; i < nverts; i++) {
-      const int lidx = mp->loopstart + i;
+      float *vnor = vnors[ml[i].v];
       const float *cur_edge = edgevecbuf[i];
 
       /* calculate angle between the two poly edges incident on
        * this vertex */
       const float fac = saacos(-dot_v3v3(cur_edge, prev_edge));
 
-      /* Store for later accumulation */
-      mul_v3_v3fl(lnors_weighted[lidx], pnor, fac);
+      atomic_add_and_fetch_fl(&vnor[0], pnor[0] * fac);
+      atomic_add_and_fetch_fl(&vnor[1], pnor[1] * fac);
+      atomic_add_and_fetch_fl(&vnor[2], pnor[2] * fac);
 
       prev_edge = cur_edge;
     }
@@ -310,7 +312,7 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
                                 int numVerts,
                                 const MLoop *mloop,
                                 const MPoly *mpolys,
-                                int numLoops,
+                                int UNUSED(numLoops),
                                 int numPolys,
                                 float (*r_polynors)[3],
                                 const bool only_face_normals)
@@ -337,8 +339,6 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
   }
 
   float(*vnors)[3] = r_vertnors;
-  float(*lnors_weighted)[3] = MEM_malloc_arrayN(
-      (size_t)numLoops, sizeof(*lnors_weighted), __func__);
   bool free_vnors = false;
 
   /* first go through and calculate normals for all the polys */
@@ -355,28 +355,18 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
       .mloop = mloop,
       .mverts = mverts,
       .pnors = pnors,
-      .lnors_weighted = lnors_weighted,
       .vnors = vnors,
   };
 
-  /* Compute poly normals, and prepare weighted loop normals. */
+  /* Compute poly normals, and accumulate them into vertex normals. */
   BLI_task_parallel_range(0, numPolys, &data, mesh_calc_normals_poly_prepare_cb, &settings);
 
-  /* Actually accumulate weighted loop normals into vertex ones. */
-  /* Unfortunately, not possible to thread that
-   * (not in a reasonable, totally lock- and barrier-free fashion),
-   * since several loops will point to the same vertex... */
-  for (int lidx = 0; lidx < numLoops; lidx++) {
-    add_v3_v3(vnors[mloop[lidx].v], data.lnors_weighted[lidx]);
-  }
-
   /* Normalize and validate computed vertex normals. */
   BLI_task_parallel_range(0, numVerts, &data, mesh_calc_normals_poly_finalize_cb, &settings);
 
   if (free_vnors) {
     MEM_freeN(vnors);
   }
-  MEM_freeN(lnors_weighted);
 }
 
 void BKE_mesh_ensure_normals(Mesh *mesh)
@@ -810,6 +800,7 @@ typedef struct LoopSplitTaskDataCommon {
   int *loop_to_poly;
   const float (*polynors)[3];
 
+  int numVerts;
   int numEdges;
   int numLoops;
   int numPolys;
@@ -1344,6 +1335,15 @@ static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
 #endif
 }
 
+/* Flags of the loops, used by #loop_split_generator to find the smooth fans. */
+enum {
+  /* Loop was already walked over while checking another loop of the same smooth fan. */
+  LOOP_SPLIT_SKIP = (1 << 0),
+  /* Loop is the entry point of a fan (or a single loop) to compute,
+   * only used when the fans are found beforehand, see #loop_split_fans_find. */
+  LOOP_SPLIT_FAN_START = (1 << 1),
+};
+
 /**
  * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
  * Needed because cyclic smooth fans have no obvious 'entry point',
@@ -1354,7 +1354,7 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
                                                          const int (*edge_to_loops)[2],
                                                          const int *loop_to_poly,
                                                          const int *e2l_prev,
-                                                         BLI_bitmap *skip_loops,
+                                                         char *loop_flags,
                                                          const MLoop *ml_curr,
                                                          const MLoop *ml_prev,
                                                          const int ml_curr_index,
@@ -1382,8 +1382,8 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
   BLI_assert(mlfan_vert_index >= 0);
   BLI_assert(mpfan_curr_index >= 0);
 
-  BLI_assert(!BLI_BITMAP_TEST(skip_loops, mlfan_vert_index));
-  BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+  BLI_assert((loop_flags[mlfan_vert_index] & LOOP_SPLIT_SKIP) == 0);
+  loop_flags[mlfan_vert_index] |= LOOP_SPLIT_SKIP;
 
   while (true) {
     /* Find next loop of the smooth fan. */
@@ -1404,7 +1404,7 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
       return false;
     }
     /* Smooth loop/edge... */
-    if (BLI_BITMAP_TEST(skip_loops, mlfan_vert_index)) {
+    if (loop_flags[mlfan_vert_index] & LOOP_SPLIT_SKIP) {
       if (mlfan_vert_index == ml_curr_index) {
         /* We walked around a whole cyclic smooth fan without finding any already-processed loop,
          * means we can use initial ml_curr/ml_prev edge as start for this smooth fan. */
@@ -1415,10 +1415,119 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
     }
 
     /* ... we can skip it in future, and keep checking the smooth fan. */
-    BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+    loop_flags[mlfan_vert_index] |= LOOP_SPLIT_SKIP;
+  }
+}
+
+/**
+ * Whether a task has to be generated for given loop, either because it is a single loop
+ * (between two sharp edges), or because it is the entry point of a smooth fan.
+ *
+ * All loops walked over only belong to the vertex of the given loop, so loops of different
+ * vertices can be checked concurrently, as long as loops of a same vertex are checked in order.
+ */
+static bool loop_split_generator_is_fan_start(const LoopSplitTaskDataCommon *common_data,
+                                              char *loop_flags,
+                                              const int ml_curr_index,
+                                              const int ml_prev_index,
+                                              const int mp_index)
+{
+  const MLoop *mloops = common_data->mloops;
+  const MLoop *ml_curr = &mloops[ml_curr_index];
+  const MLoop *ml_prev = &mloops[ml_prev_index];
+  const int *e2l_curr = common_data->edge_to_loops[ml_curr->e];
+  const int *e2l_prev = common_data->edge_to_loops[ml_prev->e];
+
+  /* A smooth edge, we have to check for cyclic smooth fan case.
+   * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
+   * as 'entry point', otherwise we can skip it. */
+
+  /* Note: In theory, we could make loop_split_generator_check_cyclic_smooth_fan() store
+   * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
+   * the vert during actual computation of clnor & clnorspace. However, this would complicate
+   * the code, add more memory usage, and despite its logical complexity,
+   * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
+   * so really think it's not worth it. */
+  if (IS_EDGE_SHARP(e2l_curr)) {
+    return true;
+  }
+  if (loop_flags[ml_curr_index] & LOOP_SPLIT_SKIP) {
+    return false;
+  }
+  return loop_split_generator_check_cyclic_smooth_fan(mloops,
+                                                      common_data->mpolys,
+                                                      (const int(*)[2])common_data->edge_to_loops,
+                                                      common_data->loop_to_poly,
+                                                      e2l_prev,
+                                                      loop_flags,
+                                                      ml_curr,
+                                                      ml_prev,
+                                                      ml_curr_index,
+                                                      ml_prev_index,
+                                                      mp_index);
+}
+
+typedef struct LoopSplitFansFindData {
+  const LoopSplitTaskDataCommon *common_data;
+  const MeshElemMap *vert_to_loop;
+  char *loop_flags;
+} LoopSplitFansFindData;
+
+static void loop_split_fans_find_cb(void *__restrict userdata,
+                                    const int vert_index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitFansFindData *data = userdata;
+  const LoopSplitTaskDataCommon *common_data = data->common_data;
+  const MeshElemMap *vert_loops = &data->vert_to_loop[vert_index];
+
+  /* Loops of the vertex are in the same order as in #loop_split_generator,
+   * so the same fans are found. */
+  for (int i = 0; i < vert_loops->count; i++) {
+    const int ml_curr_index = vert_loops->indices[i];
+    const int mp_index = common_data->loop_to_poly[ml_curr_index];
+    const MPoly *mp = &common_data->mpolys[mp_index];
+    const int ml_prev_index = (ml_curr_index == mp->loopstart) ?
+                                  mp->loopstart + mp->totloop - 1 :
+                                  ml_curr_index - 1;
+    if (loop_split_generator_is_fan_start(
+            common_data, data->loop_flags, ml_curr_index, ml_prev_index, mp_index)) {
+      data->loop_flags[ml_curr_index] |= LOOP_SPLIT_FAN_START;
+    }
   }
 }
 
+/**
+ * Find the entry points of all fans from multiple threads, walking around each vertex
+ * is independent from the other ones.
+ */
+static void loop_split_fans_find(const LoopSplitTaskDataCommon *common_data, char *loop_flags)
+{
+  MeshElemMap *vert_to_loop;
+  int *vert_to_loop_mem;
+  BKE_mesh_vert_loop_map_create(&vert_to_loop,
+                                &vert_to_loop_mem,
+                                common_data->mpolys,
+                                common_data->mloops,
+                                common_data->numVerts,
+                                common_data->numPolys,
+                                common_data->numLoops);
+
+  LoopSplitFansFindData data = {
+      .common_data = common_data,
+      .vert_to_loop = vert_to_loop,
+      .loop_flags = loop_flags,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, common_data->numVerts, &data, loop_split_fans_find_cb, &settings);
+
+  MEM_freeN(vert_to_loop);
+  MEM_freeN(vert_to_loop_mem);
+}
+
 static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
 {
   MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
@@ -1426,7 +1535,6 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
 
   const MLoop *mloops = common_data->mloops;
   const MPoly *mpolys = common_data->mpolys;
-  const int *loop_to_poly = common_data->loop_to_poly;
   const int(*edge_to_loops)[2] = common_data->edge_to_loops;
   const int numLoops = common_data->numLoops;
   const int numPolys = common_data->numPolys;
@@ -1439,7 +1547,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
   int ml_curr_index;
   int ml_prev_index;
 
-  BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  char *loop_flags = MEM_calloc_arrayN((size_t)numLoops, sizeof(*loop_flags), __func__);
 
   LoopSplitTaskData *data_buff = NULL;
   int data_idx = 0;
@@ -1457,6 +1565,10 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
       edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
     }
   }
+  else {
+    /* With many loops, walking around all vertices to find the fans is worth threading too. */
+    loop_split_fans_find(common_data, loop_flags);
+  }
 
   /* We now know edges that can be smoothed (with their vector, and their two loops),
    * and edges that will be hard! Now, time to generate the normals.
@@ -1481,31 +1593,16 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
              ml_curr->e,
              ml_curr->v,
              IS_EDGE_SHARP(e2l_curr),
-             BLI_BITMAP_TEST_BOOL(skip_loops, ml_curr_index));
+             (loop_flags[ml_curr_index] & LOOP_SPLIT_SKIP) != 0);
 #endif
 
-      /* A smooth edge, we have to check for cyclic smooth fan case.
-       * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
-       * as 'entry point', otherwise we can skip it. */
-
-      /* Note: In theory, we could make loop_split_generator_check_cyclic_smooth_fan() store
-       * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
-       * the vert during actual computation of clnor & clnorspace. However, this would complicate
-       * the code, add more memory usage, and despite its logical complexity,
-       * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
-       * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(e2l_curr) && (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
-                                       !loop_split_generator_check_cyclic_smooth_fan(mloops,
-                                                                                     mpolys,
-                                                                                     edge_to_loops,
-                                                                                     loop_to_poly,
-                                                                                     e2l_prev,
-                                                                                     skip_loops,
-                                                                                     ml_curr,
-                                                                                     ml_prev,
-                                                                                     ml_curr_index,
-                                                                                     ml_prev_index,
-                                                                                     mp_index))) {
+      const bool is_fan_start = pool ? (loop_flags[ml_curr_index] & LOOP_SPLIT_FAN_START) != 0 :
+                                       loop_split_generator_is_fan_start(common_data,
+                                                                         loop_flags,
+                                                                         ml_curr_index,
+                                                                         ml_prev_index,
+                                                                         mp_index);
+      if (!is_fan_start) {
         //              printf("SKIPPING!\n");
       }
       else {
@@ -1589,7 +1686,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
   if (edge_vectors) {
     BLI_stack_free(edge_vectors);
   }
-  MEM_freeN(skip_loops);
+  MEM_freeN(loop_flags);
 
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(loop_split_generator);
@@ -1602,7 +1699,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
  * (splitting edges).
  */
 void BKE_mesh_normals_loop_split(const MVert *mverts,
-                                 const int UNUSED(numVerts),
+                                 const int numVerts,
                                  MEdge *medges,
                                  const int numEdges,
                                  MLoop *mloops,
@@ -1702,6 +1799,7 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
       .edge_to_loops = edge_to_loops,
       .loop_to_poly = loop_to_poly,
       .polynors = polynors,
+      .numVerts = numVerts,
       .numEdges = numEdges,
       .numLoops = numLoops,
       .numPolys = numPolys,
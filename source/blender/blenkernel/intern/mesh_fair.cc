@@ -23,6 +23,7 @@
 
 #include "BLI_map.hh"
 #include "BLI_math.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -41,6 +42,7 @@
 #include "MEM_guardedalloc.h"
 #include "eigen_capi.h"
 
+using blender::IndexRange;
 using blender::Map;
 using blender::Vector;
 using std::array;
@@ -350,16 +352,18 @@ class UniformVertexWeight : public VertexWeight {
   UniformVertexWeight(FairingContext *fairing_context)
   {
     const int totvert = fairing_context->vertex_count_get();
-    vertex_weights_.reserve(totvert);
-    for (int i = 0; i < totvert; i++) {
-      const int tot_loop = fairing_context->vertex_loop_map_get(i)->count;
-      if (tot_loop != 0) {
-        vertex_weights_[i] = 1.0f / tot_loop;
-      }
-      else {
-        vertex_weights_[i] = FLT_MAX;
+    vertex_weights_.resize(totvert);
+    blender::parallel_for(IndexRange(totvert), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int tot_loop = fairing_context->vertex_loop_map_get(i)->count;
+        if (tot_loop != 0) {
+          vertex_weights_[i] = 1.0f / tot_loop;
+        }
+        else {
+          vertex_weights_[i] = FLT_MAX;
+        }
       }
-    }
+    });
   }
 
   float weight_at_index(const int index) override
@@ -378,41 +382,44 @@ class VoronoiVertexWeight : public VertexWeight {
   {
 
     const int totvert = fairing_context->vertex_count_get();
-    vertex_weights_.reserve(totvert);
-    for (int i = 0; i < totvert; i++) {
-
-      float area = 0.0f;
-      float a[3];
-      copy_v3_v3(a, fairing_context->vertex_deformation_co_get(i));
-      const float acute_threshold = M_PI_2;
-
-      MeshElemMap *vlmap_elem = fairing_context->vertex_loop_map_get(i);
-      for (int l = 0; l < vlmap_elem->count; l++) {
-        const int l_index = vlmap_elem->indices[l];
-
-        float b[3], c[3], d[3];
-        fairing_context->adjacents_coords_from_loop(l_index, b, c);
-
-        if (angle_v3v3v3(c, fairing_context->vertex_deformation_co_get(i), b) < acute_threshold) {
-          calc_circumcenter(d, a, b, c);
-        }
-        else {
-          add_v3_v3v3(d, b, c);
-          mul_v3_fl(d, 0.5f);
+    vertex_weights_.resize(totvert);
+    /* The area of each vertex only depends on its own neighborhood. */
+    blender::parallel_for(IndexRange(totvert), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        float area = 0.0f;
+        float a[3];
+        copy_v3_v3(a, fairing_context->vertex_deformation_co_get(i));
+        const float acute_threshold = M_PI_2;
+
+        MeshElemMap *vlmap_elem = fairing_context->vertex_loop_map_get(i);
+        for (int l = 0; l < vlmap_elem->count; l++) {
+          const int l_index = vlmap_elem->indices[l];
+
+          float b[3], c[3], d[3];
+          fairing_context->adjacents_coords_from_loop(l_index, b, c);
+
+          if (angle_v3v3v3(c, fairing_context->vertex_deformation_co_get(i), b) <
+              acute_threshold) {
+            calc_circumcenter(d, a, b, c);
+          }
+          else {
+            add_v3_v3v3(d, b, c);
+            mul_v3_fl(d, 0.5f);
+          }
+
+          float t[3];
+          add_v3_v3v3(t, a, b);
+          mul_v3_fl(t, 0.5f);
+          area += area_tri_v3(a, t, d);
+
+          add_v3_v3v3(t, a, c);
+          mul_v3_fl(t, 0.5f);
+          area += area_tri_v3(a, d, t);
         }
 
-        float t[3];
-        add_v3_v3v3(t, a, b);
-        mul_v3_fl(t, 0.5f);
-        area += area_tri_v3(a, t, d);
-
-        add_v3_v3v3(t, a, c);
-        mul_v3_fl(t, 0.5f);
-        area += area_tri_v3(a, d, t);
+        vertex_weights_[i] = area != 0.0f ? 1.0f / area : 1e12;
       }
-
-      vertex_weights_[i] = area != 0.0f ? 1.0f / area : 1e12;
-    }
+    });
   }
 
   float weight_at_index(const int index) override
@@ -26,6 +26,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_vec_types.h"
 
+#include "BLI_array_parallel.h"
 #include "BLI_bitmap.h"
 #include "BLI_buffer.h"
 #include "BLI_math.h"
@@ -201,6 +202,46 @@ void BKE_mesh_uv_vert_map_free(UvVertMap *vmap)
  *
  * Wrapped by #BKE_mesh_vert_poly_map_create & BKE_mesh_vert_loop_map_create
  */
+/**
+ * Fill a map from the groups of the loops, see #BLI_array_group_indices_by_key.
+ * \param loop_keys: The vertex or edge of every loop, -1 for loops not used by any poly.
+ * \param loop_polys: When not NULL, the poly of every loop, the map then stores the
+ * polys rather than the loops.
+ */
+static void mesh_loop_groups_map_create(MeshElemMap **r_map,
+                                        int **r_mem,
+                                        const int *loop_keys,
+                                        const int *loop_polys,
+                                        int totkey,
+                                        int totloop)
+{
+  MeshElemMap *map = MEM_mallocN(sizeof(MeshElemMap) * (size_t)totkey, __func__);
+  int *indices = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  int *offsets = MEM_mallocN(sizeof(int) * (size_t)(totkey + 1), __func__);
+  int i;
+
+  BLI_array_group_indices_by_key(loop_keys, totloop, totkey, offsets, indices);
+
+  /* Loops of the polys are contiguous and in the order of the polys,
+   * so sorted loops give sorted polys. */
+  if (loop_polys) {
+    const int totindex = offsets[totkey];
+    for (i = 0; i < totindex; i++) {
+      indices[i] = loop_polys[indices[i]];
+    }
+  }
+
+  for (i = 0; i < totkey; i++) {
+    map[i].indices = indices + offsets[i];
+    map[i].count = offsets[i + 1] - offsets[i];
+  }
+
+  MEM_freeN(offsets);
+
+  *r_map = map;
+  *r_mem = indices;
+}
+
 static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
                                               int **r_mem,
                                               const MPoly *mpoly,
@@ -210,44 +251,27 @@ static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
                                               int totloop,
                                               const bool do_loops)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, __func__);
-  int *indices, *index_iter;
+  int *loop_verts = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  int *loop_polys = do_loops ? NULL : MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
   int i, j;
 
-  indices = index_iter = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  copy_vn_i(loop_verts, totloop, -1);
 
-  /* Count number of polys for each vertex */
   for (i = 0; i < totpoly; i++) {
     const MPoly *p = &mpoly[i];
 
     for (j = 0; j < p->totloop; j++) {
-      map[mloop[p->loopstart + j].v].count++;
+      loop_verts[p->loopstart + j] = (int)mloop[p->loopstart + j].v;
+      if (loop_polys) {
+        loop_polys[p->loopstart + j] = i;
+      }
     }
   }
 
-  /* Assign indices mem */
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = index_iter;
-    index_iter += map[i].count;
-
-    /* Reset 'count' for use as index in last loop */
-    map[i].count = 0;
-  }
+  mesh_loop_groups_map_create(r_map, r_mem, loop_verts, loop_polys, totvert, totloop);
 
-  /* Find the users */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
-
-    for (j = 0; j < p->totloop; j++) {
-      unsigned int v = mloop[p->loopstart + j].v;
-
-      map[v].indices[map[v].count] = do_loops ? p->loopstart + j : i;
-      map[v].count++;
-    }
-  }
-
-  *r_map = map;
-  *r_mem = indices;
+  MEM_freeN(loop_verts);
+  MEM_SAFE_FREE(loop_polys);
 }
 
 /**
@@ -490,43 +514,25 @@ void BKE_mesh_edge_poly_map_create(MeshElemMap **r_map,
                                    const MLoop *mloop,
                                    const int totloop)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totedge, "edge-poly map");
-  int *indices = MEM_mallocN(sizeof(int) * (size_t)totloop, "edge-poly map mem");
-  int *index_step;
+  int *loop_edges = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  int *loop_polys = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
   const MPoly *mp;
   int i;
 
-  /* count face users */
-  for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    int j = mp->totloop;
-    for (ml = &mloop[mp->loopstart]; j--; ml++) {
-      map[ml->e].count++;
-    }
-  }
-
-  /* create offsets */
-  index_step = indices;
-  for (i = 0; i < totedge; i++) {
-    map[i].indices = index_step;
-    index_step += map[i].count;
-
-    /* re-count, using this as an index below */
-    map[i].count = 0;
-  }
+  copy_vn_i(loop_edges, totloop, -1);
 
-  /* assign poly-edge users */
   for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    int j = mp->totloop;
-    for (ml = &mloop[mp->loopstart]; j--; ml++) {
-      MeshElemMap *map_ele = &map[ml->e];
-      map_ele->indices[map_ele->count++] = i;
+    int j;
+    for (j = mp->loopstart; j < mp->loopstart + mp->totloop; j++) {
+      loop_edges[j] = (int)mloop[j].e;
+      loop_polys[j] = i;
     }
   }
 
-  *r_map = map;
-  *r_mem = indices;
+  mesh_loop_groups_map_create(r_map, r_mem, loop_edges, loop_polys, totedge, totloop);
+
+  MEM_freeN(loop_edges);
+  MEM_freeN(loop_polys);
 }
 
 /**
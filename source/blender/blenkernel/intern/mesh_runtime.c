@@ -67,6 +67,7 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->deform_weights = NULL;
 
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
@@ -172,6 +173,87 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
   return looptri;
 }
 
+static void mesh_runtime_deform_weights_free(Mesh *mesh)
+{
+  MeshDeformWeights *deform_weights = mesh->runtime.deform_weights;
+  if (deform_weights == NULL) {
+    return;
+  }
+  MEM_freeN(deform_weights->offsets);
+  MEM_SAFE_FREE(deform_weights->def_nrs);
+  MEM_SAFE_FREE(deform_weights->weights);
+  MEM_freeN(deform_weights);
+  mesh->runtime.deform_weights = NULL;
+}
+
+static MeshDeformWeights *mesh_runtime_deform_weights_create(const Mesh *mesh)
+{
+  const MDeformVert *dvert = mesh->dvert;
+  const int totvert = mesh->totvert;
+
+  MeshDeformWeights *deform_weights = MEM_callocN(sizeof(*deform_weights), __func__);
+  deform_weights->dvert = dvert;
+  deform_weights->totvert = totvert;
+  deform_weights->offsets = MEM_malloc_arrayN(
+      (size_t)totvert + 1, sizeof(*deform_weights->offsets), __func__);
+
+  int weights_len = 0;
+  for (int i = 0; i < totvert; i++) {
+    deform_weights->offsets[i] = weights_len;
+    weights_len += dvert[i].totweight;
+  }
+  deform_weights->offsets[totvert] = weights_len;
+
+  if (weights_len == 0) {
+    return deform_weights;
+  }
+
+  deform_weights->def_nrs = MEM_malloc_arrayN(
+      weights_len, sizeof(*deform_weights->def_nrs), __func__);
+  deform_weights->weights = MEM_malloc_arrayN(
+      weights_len, sizeof(*deform_weights->weights), __func__);
+
+  int index = 0;
+  for (int i = 0; i < totvert; i++) {
+    for (int j = 0; j < dvert[i].totweight; j++) {
+      deform_weights->def_nrs[index] = dvert[i].dw[j].def_nr;
+      deform_weights->weights[index] = dvert[i].dw[j].weight;
+      index++;
+    }
+  }
+  BLI_assert(index == weights_len);
+
+  return deform_weights;
+}
+
+/**
+ * Return the vertex group weights of the mesh packed for fast iteration, or NULL when the mesh
+ * has no vertex groups. The cache is created on first use and lives until the geometry is
+ * cleared, so it must only be used for meshes whose weights are not edited in place.
+ */
+const MeshDeformWeights *BKE_mesh_runtime_deform_weights_ensure(Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  MeshDeformWeights *deform_weights = mesh->runtime.deform_weights;
+
+  if (deform_weights != NULL &&
+      (deform_weights->dvert != mesh->dvert || deform_weights->totvert != mesh->totvert)) {
+    mesh_runtime_deform_weights_free(mesh);
+    deform_weights = NULL;
+  }
+
+  if (deform_weights == NULL && mesh->dvert != NULL) {
+    deform_weights = mesh_runtime_deform_weights_create(mesh);
+    mesh->runtime.deform_weights = deform_weights;
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return deform_weights;
+}
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -236,6 +318,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = NULL;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  mesh_runtime_deform_weights_free(mesh);
 }
 
 /** \} */
@@ -34,6 +34,7 @@
 
 #include "BLI_sys_types.h"
 
+#include "BLI_array_parallel.h"
 #include "BLI_edgehash.h"
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
@@ -1337,24 +1338,27 @@ static void to_edgesort(
   ed->is_draw = is_draw;
 }
 
-static int vergedgesort(const void *v1, const void *v2)
+/* Sort the edges by their vertices, equal edges keep their order. */
+static struct EdgeSort *edgesort_sort(struct EdgeSort *edsort, const int totedge)
 {
-  const struct EdgeSort *x1 = v1, *x2 = v2;
-
-  if (x1->v1 > x2->v1) {
-    return 1;
+  uint64_t *keys = MEM_mallocN(sizeof(*keys) * (size_t)totedge, __func__);
+  int *order = MEM_mallocN(sizeof(*order) * (size_t)totedge, __func__);
+  struct EdgeSort *edsort_sorted = MEM_mallocN(sizeof(*edsort_sorted) * (size_t)totedge,
+                                               "EdgeSort");
+  int a;
+
+  for (a = 0; a < totedge; a++) {
+    keys[a] = ((uint64_t)edsort[a].v1 << 32) | edsort[a].v2;
   }
-  if (x1->v1 < x2->v1) {
-    return -1;
-  }
-  if (x1->v2 > x2->v2) {
-    return 1;
-  }
-  if (x1->v2 < x2->v2) {
-    return -1;
+  BLI_array_sort_indices_by_key_u64(keys, totedge, order);
+  for (a = 0; a < totedge; a++) {
+    edsort_sorted[a] = edsort[order[a]];
   }
 
-  return 0;
+  MEM_freeN(keys);
+  MEM_freeN(order);
+  MEM_freeN(edsort);
+  return edsort_sorted;
 }
 
 /* Create edges based on known verts and faces,
@@ -1417,7 +1421,7 @@ static void mesh_calc_edges_mdata(MVert *UNUSED(allvert),
     }
   }
 
-  qsort(edsort, totedge, sizeof(struct EdgeSort), vergedgesort);
+  edsort = edgesort_sort(edsort, totedge);
 
   /* count final amount */
   for (a = totedge, ed = edsort; a > 1; a--, ed++) {
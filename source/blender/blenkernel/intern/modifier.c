@@ -36,6 +36,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_armature_types.h"
 #include "DNA_cloth_types.h"
 #include "DNA_dynamicpaint_types.h"
@@ -54,12 +56,14 @@
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
 
 #include "BKE_DerivedMesh.h"
 #include "BKE_appdir.h"
+#include "BKE_customdata.h"
 #include "BKE_editmesh.h"
 #include "BKE_editmesh_cache.h"
 #include "BKE_effect.h"
@@ -948,6 +952,112 @@ void BKE_modifier_free_temporary_data(ModifierData *md)
   }
 }
 
+/* Total memory used by all the cached modifier results, with evaluated copies of several scenes
+ * or view layers they would otherwise add up without any bound. */
+#define MODIFIER_RESULT_CACHE_MEMORY_BUDGET ((size_t)1024 * 1024 * 1024)
+
+static size_t modifier_result_cache_memory = 0;
+
+typedef struct ModifierResultCache {
+  /* Key computed from everything used to compute the result, see #mesh_calc_modifiers. */
+  uint64_t key;
+  struct Mesh *mesh;
+  /* Result of the modifier for the orco mesh, when it was needed. */
+  struct Mesh *mesh_orco;
+  size_t memory_size;
+} ModifierResultCache;
+
+static size_t mesh_memory_size(const Mesh *mesh)
+{
+  const CustomData *datas[4] = {&mesh->vdata, &mesh->edata, &mesh->ldata, &mesh->pdata};
+  const int totelems[4] = {mesh->totvert, mesh->totedge, mesh->totloop, mesh->totpoly};
+  size_t size = sizeof(Mesh);
+  for (int i = 0; i < 4; i++) {
+    for (int layer = 0; layer < datas[i]->totlayer; layer++) {
+      size += (size_t)CustomData_sizeof(datas[i]->layers[layer].type) * (size_t)totelems[i];
+    }
+  }
+  return size;
+}
+
+static void modifier_result_cache_clear(ModifierResultCache *cache)
+{
+  if (cache->mesh != NULL) {
+    BKE_id_free(NULL, cache->mesh);
+    cache->mesh = NULL;
+  }
+  if (cache->mesh_orco != NULL) {
+    BKE_id_free(NULL, cache->mesh_orco);
+    cache->mesh_orco = NULL;
+  }
+  atomic_sub_and_fetch_z(&modifier_result_cache_memory, cache->memory_size);
+  cache->memory_size = 0;
+}
+
+/**
+ * Get the cached result of the modifier computed with the given key, or NULL.
+ * The returned meshes are owned by the cache and have to be copied.
+ */
+const Mesh *BKE_modifier_result_cache_lookup(const ModifierData *md,
+                                             const uint64_t key,
+                                             const Mesh **r_mesh_orco)
+{
+  const ModifierResultCache *cache = md->runtime;
+  if (cache == NULL || cache->mesh == NULL || cache->key != key) {
+    return NULL;
+  }
+  *r_mesh_orco = cache->mesh_orco;
+  return cache->mesh;
+}
+
+/**
+ * Keep a copy of the result of the modifier, replacing the previous one. Nothing is kept when
+ * the memory budget of all caches would be exceeded.
+ */
+void BKE_modifier_result_cache_store(ModifierData *md,
+                                     const uint64_t key,
+                                     const Mesh *mesh,
+                                     const Mesh *mesh_orco)
+{
+  BLI_assert(BKE_modifier_get_info(md->type)->flags & eModifierTypeFlag_CacheResult);
+  ModifierResultCache *cache = md->runtime;
+  if (cache == NULL) {
+    cache = MEM_callocN(sizeof(*cache), __func__);
+    md->runtime = cache;
+  }
+  modifier_result_cache_clear(cache);
+
+  const size_t memory_size = mesh_memory_size(mesh) +
+                             ((mesh_orco != NULL) ? mesh_memory_size(mesh_orco) : 0);
+  if (atomic_add_and_fetch_z(&modifier_result_cache_memory, memory_size) >
+      MODIFIER_RESULT_CACHE_MEMORY_BUDGET) {
+    atomic_sub_and_fetch_z(&modifier_result_cache_memory, memory_size);
+    return;
+  }
+  cache->key = key;
+  cache->mesh = BKE_mesh_copy_for_eval((Mesh *)mesh, false);
+  if (mesh_orco != NULL) {
+    cache->mesh_orco = BKE_mesh_copy_for_eval((Mesh *)mesh_orco, false);
+  }
+  cache->memory_size = memory_size;
+}
+
+void BKE_modifier_result_cache_free(void *runtime)
+{
+  ModifierResultCache *cache = runtime;
+  if (cache == NULL) {
+    return;
+  }
+  modifier_result_cache_clear(cache);
+  MEM_freeN(cache);
+}
+
+void BKE_modifier_result_cache_free_data(ModifierData *md)
+{
+  BKE_modifier_result_cache_free(md->runtime);
+  md->runtime = NULL;
+}
+
 /* ensure modifier correctness when changing ob->data */
 void BKE_modifiers_test_object(Object *ob)
 {
@@ -1052,7 +1162,10 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+  BLI_trace_begin("modifier", md->name);
+  struct Mesh *result = mti->modifyMesh(md, ctx, me);
+  BLI_trace_end();
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1067,7 +1180,9 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+  BLI_trace_begin("modifier", md->name);
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  BLI_trace_end();
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1083,7 +1198,9 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     BKE_mesh_calc_normals(me);
   }
+  BLI_trace_begin("modifier", md->name);
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
+  BLI_trace_end();
 }
 
 /* end modifier callback wrappers */
@@ -1990,6 +1990,35 @@ bool BKE_movieclip_put_frame_if_possible(MovieClip *clip, MovieClipUser *user, I
   return result;
 }
 
+/**
+ * Load the frame to the cache ahead of its use, if it is not cached yet and there is space left
+ * in the cache. Files of image sequences are read outside of the clip lock, so other threads can
+ * keep getting cached frames meanwhile.
+ */
+void BKE_movieclip_prefetch_frame(MovieClip *clip, MovieClipUser *user)
+{
+  if (BKE_movieclip_has_cached_frame(clip, user)) {
+    return;
+  }
+
+  /* Same as in #movieclip_get_postprocessed_ibuf. */
+  const bool use_sequence = (user->render_flag & MCLIP_PROXY_RENDER_UNDISTORT) &&
+                            (user->render_size != MCLIP_PROXY_RENDER_SIZE_FULL);
+
+  ImBuf *ibuf;
+  if (clip->source == MCLIP_SRC_SEQUENCE || use_sequence) {
+    ibuf = movieclip_load_sequence_file(clip, user, user->framenr, clip->flag);
+  }
+  else {
+    ibuf = BKE_movieclip_anim_ibuf_for_frame(clip, user);
+  }
+
+  if (ibuf) {
+    BKE_movieclip_put_frame_if_possible(clip, user, ibuf);
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static void movieclip_selection_sync(MovieClip *clip_dst, const MovieClip *clip_src)
 {
   BLI_assert(clip_dst != clip_src);
@@ -3567,10 +3567,10 @@ static void object_where_is_calc_ex(Depsgraph *depsgraph,
 
   /* solve constraints */
   if (ob->constraints.first && !(ob->transflag & OB_NO_CONSTRAINTS)) {
-    bConstraintOb *cob;
-    cob = BKE_constraints_make_evalob(depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
-    BKE_constraints_solve(depsgraph, &ob->constraints, cob, ctime);
-    BKE_constraints_clear_evalob(cob);
+    bConstraintOb cob;
+    BKE_constraints_evalob_init(&cob, depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
+    BKE_constraints_solve(depsgraph, &ob->constraints, &cob, ctime);
+    BKE_constraints_evalob_apply(&cob);
   }
 
   /* set negative scale flag in object */
@@ -122,7 +122,7 @@ void BKE_object_eval_parent(Depsgraph *depsgraph, Object *ob)
 
 void BKE_object_eval_constraints(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
-  bConstraintOb *cob;
+  bConstraintOb cob;
   float ctime = BKE_scene_frame_get(scene);
 
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
@@ -136,9 +136,9 @@ void BKE_object_eval_constraints(Depsgraph *depsgraph, Scene *scene, Object *ob)
    * Not sure why, this is from Joshua - sergey
    *
    */
-  cob = BKE_constraints_make_evalob(depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
-  BKE_constraints_solve(depsgraph, &ob->constraints, cob, ctime);
-  BKE_constraints_clear_evalob(cob);
+  BKE_constraints_evalob_init(&cob, depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
+  BKE_constraints_solve(depsgraph, &ob->constraints, &cob, ctime);
+  BKE_constraints_evalob_apply(&cob);
 }
 
 void BKE_object_eval_transform_final(Depsgraph *depsgraph, Object *ob)
@@ -340,11 +340,45 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
   BKE_object_eval_proxy_copy(depsgraph, object);
 }
 
+/* Edit-mesh which only had its coordinates modified and is drawn directly from the BMesh (no
+ * modifiers changing the topology), allows to keep draw buffers which only depend on topology. */
+static bool object_mesh_is_deform_only_update(const Object *ob)
+{
+  const Mesh *mesh = ob->data;
+  const BMEditMesh *em = mesh->edit_mesh;
+  if (em == NULL || !em->is_deform_only_update) {
+    return false;
+  }
+  if (em->mesh_eval_final == NULL ||
+      em->mesh_eval_final->runtime.wrapper_type != ME_WRAPPER_TYPE_BMESH) {
+    return false;
+  }
+  if (em->mesh_eval_cage != NULL &&
+      em->mesh_eval_cage->runtime.wrapper_type != ME_WRAPPER_TYPE_BMESH) {
+    return false;
+  }
+  return true;
+}
+
+/* Evaluated mesh owned by the object and created by the data update, any draw cache it has was
+ * handed over from the previous evaluation and is already tagged, see #mesh_build_data. */
+static bool object_mesh_eval_is_newly_created(const Object *ob)
+{
+  if (ob->type != OB_MESH || !ob->runtime.is_data_eval_owned) {
+    return false;
+  }
+  const Mesh *mesh = ob->data;
+  return ob->runtime.data_eval == &mesh->id && mesh->edit_mesh == NULL;
+}
+
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
     case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+      BKE_mesh_batch_cache_dirty_tag(ob->data,
+                                     object_mesh_is_deform_only_update(ob) ?
+                                         BKE_MESH_BATCH_DIRTY_DEFORM :
+                                         BKE_MESH_BATCH_DIRTY_ALL);
       break;
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag(ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
@@ -377,7 +411,9 @@ void BKE_object_eval_uber_data(Depsgraph *depsgraph, Scene *scene, Object *ob)
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
   BLI_assert(ob->type != OB_ARMATURE);
   BKE_object_handle_data_update(depsgraph, scene, ob);
-  BKE_object_batch_cache_dirty_tag(ob);
+  if (!object_mesh_eval_is_newly_created(ob)) {
+    BKE_object_batch_cache_dirty_tag(ob);
+  }
 }
 
 void BKE_object_eval_ptcache_reset(Depsgraph *depsgraph, Scene *scene, Object *object)
@@ -1372,26 +1372,141 @@ void BKE_ocean_simulate_cache(struct OceanCache *och, int frame)
   och->ibufs_norm[f] = IMB_loadiffname(string, 0, NULL);
 }
 
-void BKE_ocean_bake(struct Ocean *o,
-                    struct OceanCache *och,
-                    void (*update_cb)(void *, float progress, int *cancel),
-                    void *update_cb_data)
+typedef struct OceanBakeData {
+  Ocean *o;
+  const OceanCache *och;
+  /* Index of the frame in the cache. */
+  int i;
+  float *prev_foam;
+
+  ImBuf *ibuf_disp, *ibuf_foam, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
+} OceanBakeData;
+
+static void ocean_bake_row(void *__restrict userdata,
+                           const int y,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  const OceanBakeData *data = userdata;
+  Ocean *o = data->o;
+  const OceanCache *och = data->och;
+  const int res_x = och->resolution_x;
+  float *prev_foam = data->prev_foam;
+
   /* note: some of these values remain uninitialized unless certain options
    * are enabled, take care that BKE_ocean_eval_ij() initializes a member
    * before use - campbell */
   OceanResult ocr;
 
+  for (int x = 0; x < res_x; x++) {
+
+    BKE_ocean_eval_ij(o, &ocr, x, y);
+
+    /* add to the image */
+    rgb_to_rgba_unit_alpha(&data->ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
+
+    if (o->_do_jacobian) {
+      /* TODO, cleanup unused code - campbell */
+
+      float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
+      float neg_disp, neg_eplus;
+
+      ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
+
+      /* accumulate previous value for this cell */
+      if (data->i > 0) {
+        pr = prev_foam[res_x * y + x];
+      }
+
+      /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
+
+      /* pr = pr * och->foam_fade; */ /* overall fade */
+
+      /* Remember ocean coord sys is Y up!
+       * break up the foam where height (Y) is low (wave valley),
+       * and X and Z displacement is greatest. */
+
+      neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
+      neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
+
+      /* foam, 'ocr.Eplus' only initialized with do_jacobian */
+      neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
+      neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
+
+      if (pr < 1.0f) {
+        pr *= pr;
+      }
+
+      pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
+
+      /* A full clamping should not be needed! */
+      foam_result = min_ff(pr + ocr.foam, 1.0f);
+
+      prev_foam[res_x * y + x] = foam_result;
+
+      /*foam_result = min_ff(foam_result, 1.0f); */
+
+      value_to_rgba_unit_alpha(&data->ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
+
+      /* spray map baking */
+      if (o->_do_spray) {
+        rgb_to_rgba_unit_alpha(&data->ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
+        rgb_to_rgba_unit_alpha(&data->ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
+                               ocr.Eminus);
+      }
+    }
+
+    if (o->_do_normals) {
+      rgb_to_rgba_unit_alpha(&data->ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
+    }
+  }
+}
+
+typedef struct OceanBakeWriteTask {
+  ImBuf *ibuf;
+  char filepath[FILE_MAX];
+  const char *name;
+} OceanBakeWriteTask;
+
+static void ocean_bake_write_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const ImageFormatData *imf = BLI_task_pool_user_data(pool);
+  OceanBakeWriteTask *task = taskdata;
+
+  if (0 == BKE_imbuf_write(task->ibuf, task->filepath, imf)) {
+    printf("Cannot save %s File Output to %s\n", task->name, task->filepath);
+  }
+  IMB_freeImBuf(task->ibuf);
+}
+
+/* Write and free the image in the background, the pool takes ownership of it. */
+static void ocean_bake_write_push(TaskPool *pool,
+                                  const OceanCache *och,
+                                  ImBuf *ibuf,
+                                  int frame,
+                                  int type,
+                                  const char *name)
+{
+  OceanBakeWriteTask *task = MEM_mallocN(sizeof(*task), __func__);
+  task->ibuf = ibuf;
+  task->name = name;
+  cache_filename(task->filepath, och->bakepath, och->relbase, frame, type);
+
+  BLI_task_pool_push(pool, ocean_bake_write_task, task, true, NULL);
+}
+
+void BKE_ocean_bake(struct Ocean *o,
+                    struct OceanCache *och,
+                    void (*update_cb)(void *, float progress, int *cancel),
+                    void *update_cb_data)
+{
   ImageFormatData imf = {0};
 
-  int f, i = 0, x, y, cancel = 0;
+  int f, i = 0, cancel = 0;
   float progress;
 
-  ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
   float *prev_foam;
   int res_x = och->resolution_x;
   int res_y = och->resolution_y;
-  char string[FILE_MAX];
   // RNG *rng;
 
   if (!o) {
@@ -1412,139 +1527,85 @@ void BKE_ocean_bake(struct Ocean *o,
   imf.depth = R_IMF_CHAN_DEPTH_16;
   imf.exr_codec = R_IMF_EXR_CODEC_ZIP;
 
+  /* Images of a frame are compressed and written while the next one is simulated. */
+  TaskPool *write_pool = BLI_task_pool_create(&imf, TASK_PRIORITY_LOW);
+
   for (f = och->start, i = 0; f <= och->end; f++, i++) {
 
     /* create a new imbuf to store image for this frame */
-    ibuf_foam = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_disp = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_normal = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_spray = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
-    ibuf_spray_inverse = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat);
+    OceanBakeData data = {
+        .o = o,
+        .och = och,
+        .i = i,
+        .prev_foam = prev_foam,
+        .ibuf_disp = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat),
+        .ibuf_foam = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat),
+        .ibuf_normal = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat),
+        .ibuf_spray = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat),
+        .ibuf_spray_inverse = IMB_allocImBuf(res_x, res_y, 32, IB_rectfloat),
+    };
 
     BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
 
     /* add new foam */
-    for (y = 0; y < res_y; y++) {
-      for (x = 0; x < res_x; x++) {
-
-        BKE_ocean_eval_ij(o, &ocr, x, y);
-
-        /* add to the image */
-        rgb_to_rgba_unit_alpha(&ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
-
-        if (o->_do_jacobian) {
-          /* TODO, cleanup unused code - campbell */
-
-          float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
-          float neg_disp, neg_eplus;
-
-          ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
-
-          /* accumulate previous value for this cell */
-          if (i > 0) {
-            pr = prev_foam[res_x * y + x];
-          }
-
-          /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
-
-          /* pr = pr * och->foam_fade; */ /* overall fade */
-
-          /* Remember ocean coord sys is Y up!
-           * break up the foam where height (Y) is low (wave valley),
-           * and X and Z displacement is greatest. */
-
-          neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
-          neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
-
-          /* foam, 'ocr.Eplus' only initialized with do_jacobian */
-          neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
-          neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
-
-          if (pr < 1.0f) {
-            pr *= pr;
-          }
-
-          pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
-
-          /* A full clamping should not be needed! */
-          foam_result = min_ff(pr + ocr.foam, 1.0f);
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, res_y, &data, ocean_bake_row, &settings);
 
-          prev_foam[res_x * y + x] = foam_result;
-
-          /*foam_result = min_ff(foam_result, 1.0f); */
-
-          value_to_rgba_unit_alpha(&ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
-
-          /* spray map baking */
-          if (o->_do_spray) {
-            rgb_to_rgba_unit_alpha(&ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
-            rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
-                                   ocr.Eminus);
-          }
-        }
-
-        if (o->_do_normals) {
-          rgb_to_rgba_unit_alpha(&ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
-        }
-      }
-    }
+    /* Keep at most the images of one frame waiting to be written. */
+    BLI_task_pool_work_and_wait(write_pool);
 
     /* write the images */
-    cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_DISPLACE);
-    if (0 == BKE_imbuf_write(ibuf_disp, string, &imf)) {
-      printf("Cannot save Displacement File Output to %s\n", string);
-    }
+    ocean_bake_write_push(
+        write_pool, och, data.ibuf_disp, f, CACHE_TYPE_DISPLACE, "Displacement");
 
     if (o->_do_jacobian) {
-      cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_FOAM);
-      if (0 == BKE_imbuf_write(ibuf_foam, string, &imf)) {
-        printf("Cannot save Foam File Output to %s\n", string);
-      }
+      ocean_bake_write_push(write_pool, och, data.ibuf_foam, f, CACHE_TYPE_FOAM, "Foam");
+    }
+    else {
+      IMB_freeImBuf(data.ibuf_foam);
+    }
 
-      if (o->_do_spray) {
-        cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_SPRAY);
-        if (0 == BKE_imbuf_write(ibuf_spray, string, &imf)) {
-          printf("Cannot save Spray File Output to %s\n", string);
-        }
-
-        cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_SPRAY_INVERSE);
-        if (0 == BKE_imbuf_write(ibuf_spray_inverse, string, &imf)) {
-          printf("Cannot save Spray Inverse File Output to %s\n", string);
-        }
-      }
+    if (o->_do_jacobian && o->_do_spray) {
+      ocean_bake_write_push(write_pool, och, data.ibuf_spray, f, CACHE_TYPE_SPRAY, "Spray");
+      ocean_bake_write_push(write_pool,
+                            och,
+                            data.ibuf_spray_inverse,
+                            f,
+                            CACHE_TYPE_SPRAY_INVERSE,
+                            "Spray Inverse");
+    }
+    else {
+      IMB_freeImBuf(data.ibuf_spray);
+      IMB_freeImBuf(data.ibuf_spray_inverse);
     }
 
     if (o->_do_normals) {
-      cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_NORMAL);
-      if (0 == BKE_imbuf_write(ibuf_normal, string, &imf)) {
-        printf("Cannot save Normal File Output to %s\n", string);
-      }
+      ocean_bake_write_push(write_pool, och, data.ibuf_normal, f, CACHE_TYPE_NORMAL, "Normal");
+    }
+    else {
+      IMB_freeImBuf(data.ibuf_normal);
     }
-
-    IMB_freeImBuf(ibuf_disp);
-    IMB_freeImBuf(ibuf_foam);
-    IMB_freeImBuf(ibuf_normal);
-    IMB_freeImBuf(ibuf_spray);
-    IMB_freeImBuf(ibuf_spray_inverse);
 
     progress = (f - och->start) / (float)och->duration;
 
     update_cb(update_cb_data, progress, &cancel);
 
     if (cancel) {
-      if (prev_foam) {
-        MEM_freeN(prev_foam);
-      }
-      // BLI_rng_free(rng);
-      return;
+      break;
     }
   }
 
+  BLI_task_pool_work_and_wait(write_pool);
+  BLI_task_pool_free(write_pool);
+
   // BLI_rng_free(rng);
   if (prev_foam) {
     MEM_freeN(prev_foam);
   }
-  och->baked = 1;
+  if (!cancel) {
+    och->baked = 1;
+  }
 }
 
 #else /* WITH_OCEANSIM */
@@ -48,6 +48,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_edgehash.h"
+#include "BLI_hash.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -3818,6 +3819,135 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+typedef struct BoidsStepTaskData {
+  ParticleSimulationData *sim;
+  const BoidBrainData *bbd;
+  /* Brain of every particle, written by the first pass and used by the second one. */
+  BoidBrainData *brains;
+  float cfra;
+  unsigned int seed;
+} BoidsStepTaskData;
+
+/* Random numbers depend on the particle only, so results don't depend on threading. */
+typedef struct BoidsStepTLS {
+  ParticleSimulationData sim;
+  RNG *rng;
+} BoidsStepTLS;
+
+static void dynamics_step_boids_tls_seed(BoidsStepTLS *boids_tls,
+                                         const BoidsStepTaskData *data,
+                                         const int p,
+                                         const unsigned int pass)
+{
+  if (boids_tls->rng == NULL) {
+    boids_tls->rng = BLI_rng_new(0);
+    boids_tls->sim.rng = boids_tls->rng;
+  }
+  BLI_rng_seed(boids_tls->rng, BLI_hash_int_3d(data->seed, (unsigned int)p, pass));
+}
+
+static void dynamics_step_boids_brain_task_cb_ex(void *__restrict userdata,
+                                                 const int p,
+                                                 const TaskParallelTLS *__restrict tls)
+{
+  const BoidsStepTaskData *data = userdata;
+  ParticleData *pa = data->sim->psys->particles + p;
+
+  if (pa->state.time <= 0.0f) {
+    return;
+  }
+
+  BoidsStepTLS *boids_tls = tls->userdata_chunk;
+  dynamics_step_boids_tls_seed(boids_tls, data, p, 0);
+
+  BoidBrainData *bbd = &data->brains[p];
+  *bbd = *data->bbd;
+  bbd->sim = &boids_tls->sim;
+  bbd->rng = boids_tls->rng;
+  bbd->goal_ob = NULL;
+
+  boid_brain(bbd, p, pa);
+}
+
+static void dynamics_step_boids_body_task_cb_ex(void *__restrict userdata,
+                                                const int p,
+                                                const TaskParallelTLS *__restrict tls)
+{
+  const BoidsStepTaskData *data = userdata;
+  ParticleData *pa = data->sim->psys->particles + p;
+
+  if (pa->state.time <= 0.0f || pa->alive == PARS_DYING) {
+    return;
+  }
+
+  BoidsStepTLS *boids_tls = tls->userdata_chunk;
+  dynamics_step_boids_tls_seed(boids_tls, data, p, 1);
+
+  BoidBrainData *bbd = &data->brains[p];
+  bbd->sim = &boids_tls->sim;
+  bbd->rng = boids_tls->rng;
+
+  boid_body(bbd, pa);
+
+  /* deflection */
+  if (boids_tls->sim.colliders) {
+    collision_check(&boids_tls->sim, p, pa->state.time, data->cfra);
+  }
+}
+
+static void dynamics_step_boids_free(const void *__restrict UNUSED(userdata),
+                                     void *__restrict chunk_v)
+{
+  BoidsStepTLS *boids_tls = chunk_v;
+  if (boids_tls->rng) {
+    /* Without threading the same chunk is used by both passes. */
+    BLI_rng_free(boids_tls->rng);
+    boids_tls->rng = NULL;
+  }
+}
+
+/**
+ * Brains only read the state of the other particles from before the step, and their changes to
+ * other particles are applied once all of them are done, so both passes can run in parallel.
+ */
+static void dynamics_step_boids(ParticleSimulationData *sim, const BoidBrainData *bbd, float cfra)
+{
+  ParticleSystem *psys = sim->psys;
+
+  BoidsStepTaskData task_data = {
+      .sim = sim,
+      .bbd = bbd,
+      .brains = MEM_malloc_arrayN(psys->totpart, sizeof(BoidBrainData), __func__),
+      .cfra = cfra,
+      .seed = (unsigned int)(31415926 + (int)cfra + psys->seed),
+  };
+  BoidsStepTLS boids_tls = {
+      .sim = *sim,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (psys->totpart > 100);
+  settings.userdata_chunk = &boids_tls;
+  settings.userdata_chunk_size = sizeof(boids_tls);
+  settings.func_free = dynamics_step_boids_free;
+  BLI_task_parallel_range(
+      0, psys->totpart, &task_data, dynamics_step_boids_brain_task_cb_ex, &settings);
+
+  /* Apply fight damage in particle order. */
+  for (int p = 0; p < psys->totpart; p++) {
+    const BoidBrainData *brain = &task_data.brains[p];
+    if (psys->particles[p].state.time > 0.0f && brain->enemy) {
+      brain->enemy->data.health -= brain->enemy_damage;
+    }
+  }
+
+  BLI_task_parallel_range(
+      0, psys->totpart, &task_data, dynamics_step_boids_body_task_cb_ex, &settings);
+
+  MEM_freeN(task_data.brains);
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3962,21 +4092,7 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
       break;
     }
     case PART_PHYS_BOIDS: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        bbd.goal_ob = NULL;
-
-        boid_brain(&bbd, p, pa);
-
-        if (pa->alive != PARS_DYING) {
-          boid_body(&bbd, pa);
-
-          /* deflection */
-          if (sim->colliders) {
-            collision_check(sim, p, pa->state.time, cfra);
-          }
-        }
-      }
+      dynamics_step_boids(sim, &bbd, cfra);
       break;
     }
     case PART_PHYS_FLUID: {
@@ -25,6 +25,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -940,54 +941,128 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/* Check if the edges of the face should be considered for the queue,
+ * only reads the mesh so it can run from multiple threads. */
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
+  return q->edge_queue_tri_in_range(q, f);
+}
+
+/* Add the edges of a face which passed #edge_queue_face_in_range. */
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  /* Check each edge of the face */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
 #ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
-      }
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+    }
 #else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  } while ((l_iter = l_iter->next) != l_first);
 }
 
+/* Add the edges of a face which passed #edge_queue_face_in_range. */
 static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  BMLoop *l_iter;
+  BMLoop *l_first;
+
+  /* Check each edge of the face */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+typedef struct EdgeQueueNodeFacesData {
+  const EdgeQueue *q;
+  PBVHNode **nodes;
+
+  /* Output, the faces in range of each node. */
+  BMFace ***node_faces;
+  int *node_faces_num;
+} EdgeQueueNodeFacesData;
+
+static void edge_queue_node_faces_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeQueueNodeFacesData *data = userdata;
+  PBVHNode *node = data->nodes[n];
+
+  BMFace **faces = MEM_mallocN(sizeof(*faces) * BLI_gset_len(node->bm_faces), __func__);
+  int faces_num = 0;
+
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, node->bm_faces) {
+    BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+    if (edge_queue_face_in_range(data->q, f)) {
+      faces[faces_num++] = f;
     }
   }
-#endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+  data->node_faces[n] = faces;
+  data->node_faces_num[n] = faces_num;
+}
+
+/* Add the edges of the faces in range of the leaf nodes marked for topology update.
+ *
+ * Testing the faces against the brush is the expensive part and is done for each node
+ * in parallel. The edges are then added from a single thread, in the same order as a
+ * serial loop would, since adding them tags edges shared between nodes. */
+static void edge_queue_nodes_add(EdgeQueueContext *eq_ctx,
+                                 PBVH *pbvh,
+                                 void (*face_add)(EdgeQueueContext *eq_ctx, BMFace *f))
+{
+  PBVHNode **nodes = MEM_mallocN(sizeof(*nodes) * pbvh->totnode, __func__);
+  int totnode = 0;
 
-    /* Check each edge of the face */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
+  for (int n = 0; n < pbvh->totnode; n++) {
+    PBVHNode *node = &pbvh->nodes[n];
+
+    /* Check leaf nodes marked for topology update */
+    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
+        !(node->flag & PBVH_FullyHidden)) {
+      nodes[totnode++] = node;
+    }
   }
+
+  EdgeQueueNodeFacesData data = {
+      .q = eq_ctx->q,
+      .nodes = nodes,
+      .node_faces = MEM_mallocN(sizeof(*data.node_faces) * totnode, __func__),
+      .node_faces_num = MEM_mallocN(sizeof(*data.node_faces_num) * totnode, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totnode);
+  BLI_task_parallel_range(0, totnode, &data, edge_queue_node_faces_task_cb, &settings);
+
+  for (int n = 0; n < totnode; n++) {
+    BMFace **faces = data.node_faces[n];
+    for (int i = 0; i < data.node_faces_num[n]; i++) {
+      face_add(eq_ctx, faces[i]);
+    }
+    MEM_freeN(faces);
+  }
+
+  MEM_freeN(data.node_faces);
+  MEM_freeN(data.node_faces_num);
+  MEM_freeN(nodes);
 }
 
 /* Create a priority queue containing vertex pairs connected by a long
@@ -1035,22 +1110,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_nodes_add(eq_ctx, pbvh, long_edge_queue_face_add);
 }
 
 /* Create a priority queue containing vertex pairs connected by a
@@ -1094,22 +1154,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_nodes_add(eq_ctx, pbvh, short_edge_queue_face_add);
 }
 
 /*************************** Topology update **************************/
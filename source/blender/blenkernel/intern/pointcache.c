@@ -47,6 +47,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -72,10 +73,6 @@
 
 #include "BIK_api.h"
 
-#ifdef WITH_BULLET
-#  include "RBI_api.h"
-#endif
-
 #ifdef WITH_LZO
 #  ifdef WITH_SYSTEM_LZO
 #    include <lzo/lzo1x.h>
@@ -773,11 +770,8 @@ static int ptcache_rigidbody_write(int index, void *rb_v, void **data, int UNUSE
   if (ob && ob->rigidbody_object) {
     RigidBodyOb *rbo = ob->rigidbody_object;
 
+    /* The transforms are copied from the simulation by #BKE_rigidbody_do_simulation. */
     if (rbo->type == RBO_TYPE_ACTIVE && rbo->shared->physics_object != NULL) {
-#ifdef WITH_BULLET
-      RB_body_get_position(rbo->shared->physics_object, rbo->pos);
-      RB_body_get_orientation(rbo->shared->physics_object, rbo->orn);
-#endif
       PTCACHE_DATA_FROM(data, BPHYS_DATA_LOCATION, rbo->pos);
       PTCACHE_DATA_FROM(data, BPHYS_DATA_ROTATION, rbo->orn);
     }
@@ -1513,55 +1507,94 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
-static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
-{
-  int r = 0;
-  unsigned char compressed = 0;
-  size_t in_len;
-#ifdef WITH_LZO
-  size_t out_len = len;
-#endif
+/**
+ * A block of a cache file, compressed blocks are read from the file first and decompressed
+ * afterwards, so that the blocks of a frame can be decompressed in parallel.
+ */
+typedef struct PTCacheCompressedChunk {
+  unsigned char *result;
+  unsigned int len;
+  /* Compressed data, NULL when the block is stored uncompressed or empty. */
   unsigned char *in;
-  unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
-
-  ptcache_file_read(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
+  size_t in_len;
+  unsigned char compressed;
+  unsigned char props[16];
+  size_t props_len;
+} PTCacheCompressedChunk;
+
+static void ptcache_file_compressed_chunk_read(PTCacheFile *pf,
+                                               PTCacheCompressedChunk *chunk,
+                                               unsigned char *result,
+                                               unsigned int len)
+{
+  memset(chunk, 0, sizeof(*chunk));
+  chunk->result = result;
+  chunk->len = len;
+
+  ptcache_file_read(pf, &chunk->compressed, 1, sizeof(unsigned char));
+  if (chunk->compressed) {
     unsigned int size;
     ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-    in_len = (size_t)size;
-    if (in_len == 0) {
-      /* do nothing */
-    }
-    else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
-                                        "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
-#ifdef WITH_LZO
-      if (compressed == 1) {
-        r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, NULL);
-      }
-#endif
-#ifdef WITH_LZMA
-      if (compressed == 2) {
-        size_t sizeOfIt;
-        size_t leni = in_len, leno = len;
+    chunk->in_len = (size_t)size;
+    if (chunk->in_len != 0) {
+      chunk->in = (unsigned char *)MEM_mallocN(sizeof(unsigned char) * chunk->in_len,
+                                               "pointcache_compressed_buffer");
+      ptcache_file_read(pf, chunk->in, chunk->in_len, sizeof(unsigned char));
+      if (chunk->compressed == 2) {
         ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-        sizeOfIt = (size_t)size;
-        ptcache_file_read(pf, props, sizeOfIt, sizeof(unsigned char));
-        r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
+        chunk->props_len = MIN2((size_t)size, sizeof(chunk->props));
+        ptcache_file_read(pf, chunk->props, chunk->props_len, sizeof(unsigned char));
       }
-#endif
-      MEM_freeN(in);
     }
   }
   else {
     ptcache_file_read(pf, result, len, sizeof(unsigned char));
   }
+}
 
-  MEM_freeN(props);
+/* Decompress a chunk read by #ptcache_file_compressed_chunk_read, only uses the chunk. */
+static int ptcache_compressed_chunk_decode(PTCacheCompressedChunk *chunk)
+{
+  int r = 0;
+
+  if (chunk->in == NULL) {
+    return r;
+  }
+
+#ifdef WITH_LZO
+  if (chunk->compressed == 1) {
+    size_t out_len = chunk->len;
+    r = lzo1x_decompress_safe(
+        chunk->in, (lzo_uint)chunk->in_len, chunk->result, (lzo_uint *)&out_len, NULL);
+  }
+#endif
+#ifdef WITH_LZMA
+  if (chunk->compressed == 2) {
+    size_t leni = chunk->in_len, leno = chunk->len;
+    r = LzmaUncompress(chunk->result, &leno, chunk->in, &leni, chunk->props, chunk->props_len);
+  }
+#endif
+
+  MEM_freeN(chunk->in);
+  chunk->in = NULL;
 
   return r;
 }
+
+static void ptcache_compressed_chunks_decode_cb(void *__restrict userdata,
+                                                const int index,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PTCacheCompressedChunk *chunks = (PTCacheCompressedChunk *)userdata;
+  ptcache_compressed_chunk_decode(&chunks[index]);
+}
+
+static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
+{
+  PTCacheCompressedChunk chunk;
+  ptcache_file_compressed_chunk_read(pf, &chunk, result, len);
+  return ptcache_compressed_chunk_decode(&chunk);
+}
 static int ptcache_file_compressed_write(
     PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
 {
@@ -1641,19 +1674,6 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_data_write(PTCacheFile *pf)
 {
   int i;
@@ -1967,25 +1987,54 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
     ptcache_data_alloc(pm);
 
     if (pf->flag & PTCACHE_TYPEFLAG_COMPRESS) {
+      PTCacheCompressedChunk chunks[BPHYS_TOT_DATA];
+      int chunks_num = 0;
+
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         unsigned int out_len = pm->totpoint * ptcache_data_size[i];
         if (pf->data_types & (1 << i)) {
-          ptcache_file_compressed_read(pf, (unsigned char *)(pm->data[i]), out_len);
+          ptcache_file_compressed_chunk_read(
+              pf, &chunks[chunks_num++], (unsigned char *)(pm->data[i]), out_len);
         }
       }
+
+      /* Every data type is compressed separately, decompress them in parallel. */
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(
+          0, chunks_num, chunks, ptcache_compressed_chunks_decode_cb, &settings);
     }
     else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
+      /* Points are stored interleaved, read them all at once and split them by data type. */
+      size_t point_size = 0;
+      for (i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pf->data_types & (1 << i)) {
+          point_size += ptcache_data_size[i];
+        }
+      }
 
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
+      if (pm->totpoint > 0 && point_size > 0) {
+        char *buffer = MEM_mallocN(point_size * pm->totpoint, "pointcache_read_buffer");
+
+        if (ptcache_file_read(pf, buffer, pm->totpoint, point_size)) {
+          const char *src = buffer;
+          for (i = 0; i < pm->totpoint; i++) {
+            for (int j = 0; j < BPHYS_TOT_DATA; j++) {
+              if (pm->data[j]) {
+                memcpy((char *)pm->data[j] + (size_t)i * ptcache_data_size[j],
+                       src,
+                       ptcache_data_size[j]);
+                src += ptcache_data_size[j];
+              }
+            }
+          }
+        }
+        else {
           error = 1;
-          break;
         }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
+
+        MEM_freeN(buffer);
       }
     }
   }
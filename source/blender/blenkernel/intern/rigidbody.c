@@ -2014,6 +2014,45 @@ static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBod
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 }
 
+/* Copy the simulated transforms of all active bodies to their rigid body objects, fetching them
+ * from the simulation in one batch. */
+static void rigidbody_update_transforms_from_sim(RigidBodyWorld *rbw)
+{
+  if (rbw->objects == NULL || rbw->numbodies == 0) {
+    return;
+  }
+
+  rbRigidBody **bodies = MEM_mallocN(sizeof(*bodies) * rbw->numbodies, __func__);
+  RigidBodyOb **rbos = MEM_mallocN(sizeof(*rbos) * rbw->numbodies, __func__);
+  int num_bodies = 0;
+
+  for (int i = 0; i < rbw->numbodies; i++) {
+    Object *ob = rbw->objects[i];
+    RigidBodyOb *rbo = ob ? ob->rigidbody_object : NULL;
+
+    if (rbo && rbo->type == RBO_TYPE_ACTIVE && rbo->shared->physics_object != NULL) {
+      bodies[num_bodies] = rbo->shared->physics_object;
+      rbos[num_bodies] = rbo;
+      num_bodies++;
+    }
+  }
+
+  float(*loc)[3] = MEM_malloc_arrayN(rbw->numbodies, sizeof(*loc), __func__);
+  float(*rot)[4] = MEM_malloc_arrayN(rbw->numbodies, sizeof(*rot), __func__);
+
+  RB_bodies_get_loc_rot(bodies, num_bodies, loc, rot);
+
+  for (int i = 0; i < num_bodies; i++) {
+    copy_v3_v3(rbos[i]->pos, loc[i]);
+    copy_qt_qt(rbos[i]->orn, rot[i]);
+  }
+
+  MEM_freeN(loc);
+  MEM_freeN(rot);
+  MEM_freeN(bodies);
+  MEM_freeN(rbos);
+}
+
 bool BKE_rigidbody_check_sim_running(RigidBodyWorld *rbw, float ctime)
 {
   return (rbw && (rbw->flag & RBW_FLAG_MUTED) == 0 && ctime > rbw->shared->pointcache->startframe);
@@ -2219,6 +2258,7 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
   if (compare_ff_relative(ctime, rbw->ltime + 1, FLT_EPSILON, 64)) {
     /* write cache for first frame when on second frame */
     if (rbw->ltime == startframe && (cache->flag & PTCACHE_OUTDATED || cache->last_exact == 0)) {
+      rigidbody_update_transforms_from_sim(rbw);
       BKE_ptcache_write(&pid, startframe);
     }
 
@@ -2244,6 +2284,7 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
     rigidbody_free_substep_data(&substep_targets);
 
     rigidbody_update_simulation_post_step(depsgraph, rbw);
+    rigidbody_update_transforms_from_sim(rbw);
 
     /* write cache for current frame */
     BKE_ptcache_validate(cache, (int)ctime);
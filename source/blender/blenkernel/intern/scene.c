@@ -2686,8 +2686,13 @@ void BKE_scene_graph_evaluated_ensure(Depsgraph *depsgraph, Main *bmain)
   scene_graph_update_tagged(depsgraph, bmain, true);
 }
 
-/* applies changes right away, does all sets too */
-void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
+/**
+ * Applies changes right away, does all sets too.
+ *
+ * \param clear_recalc: When false the recalc flags are kept, so that a render engine can still
+ * query what was updated. It is then responsible for clearing them.
+ */
+void BKE_scene_graph_update_for_newframe_ex(Depsgraph *depsgraph, const bool clear_recalc)
 {
   Scene *scene = DEG_get_input_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -2731,7 +2736,9 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
     /* Inform editors about possible changes. */
     DEG_ids_check_recalc(bmain, depsgraph, scene, view_layer, true);
     /* clear recalc flags */
-    DEG_ids_clear_recalc(bmain, depsgraph);
+    if (clear_recalc) {
+      DEG_ids_clear_recalc(bmain, depsgraph);
+    }
 
     /* If user callback did not tag anything for update we can skip second iteration.
      * Otherwise we update scene once again, but without running callbacks to bring
@@ -2742,6 +2749,11 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
   }
 }
 
+void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
+{
+  BKE_scene_graph_update_for_newframe_ex(depsgraph, true);
+}
+
 /**
  * Ensures given scene/view_layer pair has a valid, up-to-date depsgraph.
  *
@@ -59,7 +59,7 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
-#include "BLI_threads.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_collection.h"
@@ -1516,12 +1516,13 @@ static void _scan_for_ext_spring_forces(
   }
 }
 
-static void *exec_scan_for_ext_spring_forces(void *data)
+static void exec_scan_for_ext_spring_forces(void *__restrict data,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  SB_thread_context *pctx = (SB_thread_context *)data;
+  SB_thread_context *pctx = &((SB_thread_context *)data)[i];
   _scan_for_ext_spring_forces(
       pctx->scene, pctx->ob, pctx->timenow, pctx->ifirst, pctx->ilast, pctx->effectors);
-  return NULL;
 }
 
 static void sb_sfesf_threads_run(struct Depsgraph *depsgraph,
@@ -1531,7 +1532,6 @@ static void sb_sfesf_threads_run(struct Depsgraph *depsgraph,
                                  int totsprings,
                                  int *UNUSED(ptr_to_break_func(void)))
 {
-  ListBase threads;
   SB_thread_context *sb_threads;
   int i, totthread, left, dec;
 
@@ -1572,18 +1572,13 @@ static void sb_sfesf_threads_run(struct Depsgraph *depsgraph,
     sb_threads[i].nr = i;
     sb_threads[i].tot = totthread;
   }
-  if (totthread > 1) {
-    BLI_threadpool_init(&threads, exec_scan_for_ext_spring_forces, totthread);
-
-    for (i = 0; i < totthread; i++) {
-      BLI_threadpool_insert(&threads, &sb_threads[i]);
-    }
-
-    BLI_threadpool_end(&threads);
-  }
-  else {
-    exec_scan_for_ext_spring_forces(&sb_threads[0]);
-  }
+  /* Run the slices as tasks of the central scheduler, so they share the threads with the rest
+   * of the depsgraph evaluation instead of starting threads of their own. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totthread > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, totthread, sb_threads, exec_scan_for_ext_spring_forces, &settings);
   /* clean up */
   MEM_freeN(sb_threads);
 
@@ -2182,9 +2177,11 @@ static int _softbody_calc_forces_slice_in_a_thread(Scene *scene,
   return 0; /*done fine*/
 }
 
-static void *exec_softbody_calc_forces(void *data)
+static void exec_softbody_calc_forces(void *__restrict data,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  SB_thread_context *pctx = (SB_thread_context *)data;
+  SB_thread_context *pctx = &((SB_thread_context *)data)[i];
   _softbody_calc_forces_slice_in_a_thread(pctx->scene,
                                           pctx->ob,
                                           pctx->forcetime,
@@ -2196,7 +2193,6 @@ static void *exec_softbody_calc_forces(void *data)
                                           pctx->do_deflector,
                                           pctx->fieldfactor,
                                           pctx->windfactor);
-  return NULL;
 }
 
 static void sb_cf_threads_run(Scene *scene,
@@ -2210,7 +2206,6 @@ static void sb_cf_threads_run(Scene *scene,
                               float fieldfactor,
                               float windfactor)
 {
-  ListBase threads;
   SB_thread_context *sb_threads;
   int i, totthread, left, dec;
 
@@ -2252,18 +2247,13 @@ static void sb_cf_threads_run(Scene *scene,
     sb_threads[i].tot = totthread;
   }
 
-  if (totthread > 1) {
-    BLI_threadpool_init(&threads, exec_softbody_calc_forces, totthread);
-
-    for (i = 0; i < totthread; i++) {
-      BLI_threadpool_insert(&threads, &sb_threads[i]);
-    }
-
-    BLI_threadpool_end(&threads);
-  }
-  else {
-    exec_softbody_calc_forces(&sb_threads[0]);
-  }
+  /* Run the slices as tasks of the central scheduler, so they share the threads with the rest
+   * of the depsgraph evaluation instead of starting threads of their own. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totthread > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, totthread, sb_threads, exec_softbody_calc_forces, &settings);
   /* clean up */
   MEM_freeN(sb_threads);
 }
@@ -27,6 +27,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash_md5.h"
 #include "BLI_iterator.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
@@ -44,6 +45,7 @@
 #include "DNA_sequence_types.h"
 #include "DNA_sound_types.h"
 #include "DNA_speaker_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
 #ifdef WITH_AUDASPACE
@@ -1022,8 +1024,147 @@ void BKE_sound_free_waveform(bSound *sound)
   sound->tags &= ~SOUND_TAGS_WAVEFORM_NO_RELOAD;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Waveform Disk Cache
+ *
+ * Waveforms are stored in the `waveforms` folder of the sequencer disk cache directory,
+ * so they don't have to be decoded again in the next sessions.
+ * \{ */
+
+#define WAVEFORM_CACHE_VERSION 1
+
+typedef struct WaveformCacheHeader {
+  char magic[4];
+  int version;
+  int samples_per_second;
+  int length;
+} WaveformCacheHeader;
+
+/**
+ * The cache key is the hash of the packed data, or of the path, size and modification time of
+ * the sound file, hashing the content of external files would mean reading them entirely.
+ */
+static bool sound_waveform_cache_path(Main *bmain, bSound *sound, char r_path[FILE_MAX])
+{
+  if (U.sequencer_disk_cache_dir[0] == '\0') {
+    return false;
+  }
+
+  char digest[16];
+  if (sound->packedfile != NULL) {
+    const PackedFile *pf = sound->packedfile;
+    BLI_hash_md5_buffer(pf->data, (size_t)pf->size, digest);
+  }
+  else {
+    char fullpath[FILE_MAX];
+    BLI_strncpy(fullpath, sound->filepath, sizeof(fullpath));
+    BLI_path_abs(fullpath, ID_BLEND_PATH(bmain, &sound->id));
+
+    BLI_stat_t st;
+    if (BLI_stat(fullpath, &st) != 0) {
+      return false;
+    }
+    char key[FILE_MAX + 64];
+    const size_t key_len = BLI_snprintf_rlen(key,
+                                             sizeof(key),
+                                             "%s:%lld:%lld",
+                                             fullpath,
+                                             (long long)st.st_size,
+                                             (long long)st.st_mtime);
+    BLI_hash_md5_buffer(key, key_len, digest);
+  }
+
+  char digest_hex[33], filename[40];
+  BLI_hash_md5_to_hexdigest(digest, digest_hex);
+  BLI_snprintf(filename, sizeof(filename), "%s.wave", digest_hex);
+  BLI_join_dirfile(r_path, FILE_MAX, U.sequencer_disk_cache_dir, "waveforms");
+  BLI_path_append(r_path, FILE_MAX, filename);
+  return true;
+}
+
+static SoundWaveform *sound_waveform_cache_read(const char *path)
+{
+  FILE *file = BLI_fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  SoundWaveform *waveform = NULL;
+  WaveformCacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, "BWAV", 4) == 0 &&
+      header.version == WAVEFORM_CACHE_VERSION &&
+      header.samples_per_second == SOUND_WAVE_SAMPLES_PER_SECOND && header.length >= 0) {
+    waveform = MEM_callocN(sizeof(SoundWaveform), "SoundWaveform");
+    if (header.length > 0) {
+      waveform->data = MEM_mallocN(sizeof(float[3]) * (size_t)header.length,
+                                   "SoundWaveform.samples");
+      if (fread(waveform->data, sizeof(float[3]), (size_t)header.length, file) !=
+          (size_t)header.length) {
+        MEM_freeN(waveform->data);
+        MEM_freeN(waveform);
+        waveform = NULL;
+      }
+      else {
+        waveform->length = header.length;
+      }
+    }
+  }
+
+  fclose(file);
+  return waveform;
+}
+
+static void sound_waveform_cache_write(const char *path, const SoundWaveform *waveform)
+{
+  if (!BLI_make_existing_file(path)) {
+    return;
+  }
+
+  /* Write to a temporary file first, other instances may be reading the same waveform. */
+  char path_temp[FILE_MAX + 8];
+  BLI_snprintf(path_temp, sizeof(path_temp), "%s@", path);
+  FILE *file = BLI_fopen(path_temp, "wb");
+  if (file == NULL) {
+    return;
+  }
+
+  const WaveformCacheHeader header = {
+      .magic = {'B', 'W', 'A', 'V'},
+      .version = WAVEFORM_CACHE_VERSION,
+      .samples_per_second = SOUND_WAVE_SAMPLES_PER_SECOND,
+      .length = waveform->length,
+  };
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  if (ok && waveform->length > 0) {
+    ok = fwrite(waveform->data, sizeof(float[3]), (size_t)waveform->length, file) ==
+         (size_t)waveform->length;
+  }
+  fclose(file);
+
+  if (!ok || BLI_rename(path_temp, path) != 0) {
+    BLI_delete(path_temp, false, false);
+  }
+}
+
+/** \} */
+
 void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
 {
+  char cache_path[FILE_MAX];
+  const bool use_cache = sound_waveform_cache_path(bmain, sound, cache_path);
+  if (use_cache) {
+    SoundWaveform *waveform = sound_waveform_cache_read(cache_path);
+    if (waveform != NULL) {
+      BKE_sound_free_waveform(sound);
+
+      BLI_spin_lock(sound->spinlock);
+      sound->waveform = waveform;
+      sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+      BLI_spin_unlock(sound->spinlock);
+      return;
+    }
+  }
+
   bool need_close_audio_handles = false;
   if (sound->playback_handle == NULL) {
     /* TODO(sergey): Make it fully independent audio handle. */
@@ -1061,6 +1202,11 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
     return;
   }
 
+  /* Empty waveforms are not cached, the file may just not be readable yet. */
+  if (use_cache && waveform->length > 0) {
+    sound_waveform_cache_write(cache_path, waveform);
+  }
+
   BKE_sound_free_waveform(sound);
 
   BLI_spin_lock(sound->spinlock);
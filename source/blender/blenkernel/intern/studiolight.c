@@ -36,6 +36,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_threads.h"
 
 #include "DNA_listBase.h"
 
@@ -50,6 +51,9 @@
 
 /* Statics */
 static ListBase studiolights;
+/* Studio lights are only listed on first use, most background jobs never need them. */
+static bool studiolights_initialized = false;
+static ThreadMutex studiolights_init_mutex = BLI_MUTEX_INITIALIZER;
 static int last_studiolight_id = 0;
 #define STUDIOLIGHT_RADIANCE_CUBEMAP_SIZE 96
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT 32
@@ -1408,6 +1412,8 @@ void BKE_studiolight_default(SolidLight lights[4], float light_ambient[4])
 /* API */
 void BKE_studiolight_init(void)
 {
+  studiolights_initialized = true;
+
   /* Add default studio light */
   StudioLight *sl = studiolight_create(
       STUDIOLIGHT_INTERNAL | STUDIOLIGHT_SPHERICAL_HARMONICS_COEFFICIENTS_CALCULATED |
@@ -1453,6 +1459,16 @@ void BKE_studiolight_free(void)
   while ((sl = BLI_pophead(&studiolights))) {
     studiolight_free(sl);
   }
+  studiolights_initialized = false;
+}
+
+static void studiolight_ensure_init(void)
+{
+  BLI_mutex_lock(&studiolights_init_mutex);
+  if (!studiolights_initialized) {
+    BKE_studiolight_init();
+  }
+  BLI_mutex_unlock(&studiolights_init_mutex);
 }
 
 struct StudioLight *BKE_studiolight_find_default(int flag)
@@ -1466,6 +1482,8 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
     default_name = STUDIOLIGHT_MATCAP_DEFAULT;
   }
 
+  studiolight_ensure_init();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if ((sl->flag & flag) && STREQ(sl->name, default_name)) {
       return sl;
@@ -1482,6 +1500,8 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
 
 struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 {
+  studiolight_ensure_init();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (STREQLEN(sl->name, name, FILE_MAXFILE)) {
       if ((sl->flag & flag)) {
@@ -1498,6 +1518,8 @@ struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 
 struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 {
+  studiolight_ensure_init();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (sl->index == index) {
       return sl;
@@ -1509,6 +1531,8 @@ struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 
 struct ListBase *BKE_studiolight_listbase(void)
 {
+  studiolight_ensure_init();
+
   return &studiolights;
 }
 
@@ -1585,6 +1609,8 @@ void BKE_studiolight_remove(StudioLight *sl)
 
 StudioLight *BKE_studiolight_load(const char *path, int type)
 {
+  studiolight_ensure_init();
+
   StudioLight *sl = studiolight_add_file(path, type | STUDIOLIGHT_USER_DEFINED);
   return sl;
 }
@@ -1593,6 +1619,8 @@ StudioLight *BKE_studiolight_create(const char *path,
                                     const SolidLight light[4],
                                     const float light_ambient[3])
 {
+  studiolight_ensure_init();
+
   StudioLight *sl = studiolight_create(STUDIOLIGHT_EXTERNAL_FILE | STUDIOLIGHT_USER_DEFINED |
                                        STUDIOLIGHT_TYPE_STUDIO |
                                        STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
@@ -27,8 +27,11 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_customdata.h"
+
 #include "MEM_guardedalloc.h"
 
 #include "subdiv_converter.h"
@@ -164,23 +167,100 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
     can_reuse_subdiv = false;
   }
   if (can_reuse_subdiv) {
+    subdiv->stats.num_topology_refiner_reuses++;
     return subdiv;
   }
-  /* Create new subdiv. */
+  /* Create new subdiv, keeping the counters of the old one. */
+  int num_topology_refiner_rebuilds = 0;
+  int num_topology_refiner_reuses = 0;
   if (subdiv != NULL) {
+    num_topology_refiner_rebuilds = subdiv->stats.num_topology_refiner_rebuilds;
+    num_topology_refiner_reuses = subdiv->stats.num_topology_refiner_reuses;
     BKE_subdiv_free(subdiv);
   }
-  return BKE_subdiv_new_from_converter(settings, converter);
+  Subdiv *new_subdiv = BKE_subdiv_new_from_converter(settings, converter);
+  if (new_subdiv != NULL) {
+    new_subdiv->stats.num_topology_refiner_rebuilds = num_topology_refiner_rebuilds + 1;
+    new_subdiv->stats.num_topology_refiner_reuses = num_topology_refiner_reuses;
+  }
+  return new_subdiv;
+}
+
+/* Summarize everything the mesh converter passes to the topology refiner: faces, edges with
+ * their creases and UV islands. Positions are intentionally not a part of it. */
+static void subdiv_topology_fingerprint_from_mesh(SubdivTopologyFingerprint *fingerprint,
+                                                  const Mesh *mesh)
+{
+  fingerprint->is_valid = true;
+  fingerprint->num_vertices = mesh->totvert;
+  fingerprint->num_edges = mesh->totedge;
+  fingerprint->num_loops = mesh->totloop;
+  fingerprint->num_polys = mesh->totpoly;
+  fingerprint->num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
+
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  for (int poly_index = 0; poly_index < mesh->totpoly; poly_index++) {
+    const MPoly *poly = &mesh->mpoly[poly_index];
+    BLI_hash_mm2a_add_int(&mm2, poly->loopstart);
+    BLI_hash_mm2a_add_int(&mm2, poly->totloop);
+  }
+  BLI_hash_mm2a_add(&mm2, (const unsigned char *)mesh->mloop, sizeof(MLoop) * mesh->totloop);
+  for (int edge_index = 0; edge_index < mesh->totedge; edge_index++) {
+    const MEdge *edge = &mesh->medge[edge_index];
+    BLI_hash_mm2a_add_int(&mm2, (int)edge->v1);
+    BLI_hash_mm2a_add_int(&mm2, (int)edge->v2);
+    BLI_hash_mm2a_add_int(&mm2, edge->crease);
+  }
+  for (int layer_index = 0; layer_index < fingerprint->num_uv_layers; layer_index++) {
+    const MLoopUV *mloopuv = CustomData_get_layer_n(&mesh->ldata, CD_MLOOPUV, layer_index);
+    for (int loop_index = 0; loop_index < mesh->totloop; loop_index++) {
+      BLI_hash_mm2a_add(&mm2, (const unsigned char *)mloopuv[loop_index].uv, sizeof(float[2]));
+    }
+  }
+  fingerprint->hash = BLI_hash_mm2a_end(&mm2);
+}
+
+static bool subdiv_topology_fingerprint_equal(const SubdivTopologyFingerprint *fingerprint_a,
+                                              const SubdivTopologyFingerprint *fingerprint_b)
+{
+  return fingerprint_a->is_valid && fingerprint_b->is_valid &&
+         fingerprint_a->num_vertices == fingerprint_b->num_vertices &&
+         fingerprint_a->num_edges == fingerprint_b->num_edges &&
+         fingerprint_a->num_loops == fingerprint_b->num_loops &&
+         fingerprint_a->num_polys == fingerprint_b->num_polys &&
+         fingerprint_a->num_uv_layers == fingerprint_b->num_uv_layers &&
+         fingerprint_a->hash == fingerprint_b->hash;
 }
 
 Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  /* Deforming meshes are a new mesh on every frame, but keep their topology. Checking the
+   * fingerprint avoids both the creation of the converter and the full comparison. */
+  SubdivTopologyFingerprint fingerprint;
+  SubdivStats *stats = (subdiv != NULL) ? &subdiv->stats : NULL;
+  if (stats != NULL) {
+    BKE_subdiv_stats_begin(stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  }
+  subdiv_topology_fingerprint_from_mesh(&fingerprint, mesh);
+  if (stats != NULL) {
+    BKE_subdiv_stats_end(stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  }
+  if (subdiv != NULL && subdiv->topology_refiner != NULL &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings) &&
+      subdiv_topology_fingerprint_equal(&subdiv->topology_fingerprint, &fingerprint)) {
+    subdiv->stats.num_topology_refiner_reuses++;
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  if (subdiv != NULL) {
+    subdiv->topology_fingerprint = fingerprint;
+  }
   return subdiv;
 }
 
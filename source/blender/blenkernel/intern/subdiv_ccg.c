@@ -28,6 +28,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
@@ -45,6 +46,10 @@
  * \{ */
 
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key);
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces);
 
 static void subdiv_ccg_average_inner_face_grids(SubdivCCG *subdiv_ccg,
                                                 CCGKey *key,
@@ -889,11 +894,10 @@ void BKE_subdiv_ccg_update_normals(SubdivCCG *subdiv_ccg,
     return;
   }
   subdiv_ccg_recalc_modified_inner_grid_normals(subdiv_ccg, effected_faces, num_effected_faces);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
   CCGKey key;
   BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 /** \} */
@@ -1032,6 +1036,9 @@ static void subdiv_ccg_average_inner_grids_task(void *__restrict userdata_v,
 typedef struct AverageGridsBoundariesData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+
+  /* Indices of the adjacent edges to average, all of them when NULL. */
+  const int *adjacent_edge_index_map;
 } AverageGridsBoundariesData;
 
 typedef struct AverageGridsBoundariesTLSData {
@@ -1086,7 +1093,10 @@ static void subdiv_ccg_average_grids_boundaries_task(void *__restrict userdata_v
   AverageGridsBoundariesTLSData *tls = tls_v->userdata_chunk;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
-  SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[adjacent_edge_index];
+  const int index = data->adjacent_edge_index_map ?
+                        data->adjacent_edge_index_map[adjacent_edge_index] :
+                        adjacent_edge_index;
+  SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[index];
   subdiv_ccg_average_grids_boundary(subdiv_ccg, key, adjacent_edge, tls);
 }
 
@@ -1100,6 +1110,9 @@ static void subdiv_ccg_average_grids_boundaries_free(const void *__restrict UNUS
 typedef struct AverageGridsCornerData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+
+  /* Indices of the adjacent vertices to average, all of them when NULL. */
+  const int *adjacent_vert_index_map;
 } AverageGridsCornerData;
 
 static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
@@ -1134,50 +1147,129 @@ static void subdiv_ccg_average_grids_corners_task(void *__restrict userdata_v,
   AverageGridsCornerData *data = userdata_v;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
-  SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[adjacent_vertex_index];
+  const int index = data->adjacent_vert_index_map ?
+                        data->adjacent_vert_index_map[adjacent_vertex_index] :
+                        adjacent_vertex_index;
+  SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[index];
   subdiv_ccg_average_grids_corners(subdiv_ccg, key, adjacent_vertex);
 }
 
-static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_boundaries(SubdivCCG *subdiv_ccg,
+                                          CCGKey *key,
+                                          const int *adjacent_edge_index_map,
+                                          const int num_adjacent_edges)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsBoundariesData boundaries_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_edge_index_map = adjacent_edge_index_map,
   };
   AverageGridsBoundariesTLSData tls_data = {NULL};
   parallel_range_settings.userdata_chunk = &tls_data;
   parallel_range_settings.userdata_chunk_size = sizeof(tls_data);
   parallel_range_settings.func_free = subdiv_ccg_average_grids_boundaries_free;
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_edges,
+                          num_adjacent_edges,
                           &boundaries_data,
                           subdiv_ccg_average_grids_boundaries_task,
                           &parallel_range_settings);
 }
 
-static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key)
+{
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_edges);
+}
+
+static void subdiv_ccg_average_corners(SubdivCCG *subdiv_ccg,
+                                       CCGKey *key,
+                                       const int *adjacent_vert_index_map,
+                                       const int num_adjacent_vertices)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsCornerData corner_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_vert_index_map = adjacent_vert_index_map,
   };
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_vertices,
+                          num_adjacent_vertices,
                           &corner_data,
                           subdiv_ccg_average_grids_corners_task,
                           &parallel_range_settings);
 }
 
+static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
+{
+  subdiv_ccg_average_corners(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_vertices);
+}
+
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 {
   subdiv_ccg_average_all_boundaries(subdiv_ccg, key);
   subdiv_ccg_average_all_corners(subdiv_ccg, key);
 }
 
+/* Average boundaries and corners of grids which are adjacent to the given faces only. The edges
+ * and vertices of the faces are gathered first, so each of them is averaged once. */
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces)
+{
+  if (num_effected_faces == subdiv_ccg->num_faces) {
+    subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, key);
+    return;
+  }
+  Subdiv *subdiv = subdiv_ccg->subdiv;
+  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
+  const int num_edges = subdiv_ccg->num_adjacent_edges;
+  const int num_vertices = subdiv_ccg->num_adjacent_vertices;
+  BLI_bitmap *adjacent_edge_hash = BLI_BITMAP_NEW(num_edges, __func__);
+  BLI_bitmap *adjacent_vertex_hash = BLI_BITMAP_NEW(num_vertices, __func__);
+  int *adjacent_edge_index_map = MEM_malloc_arrayN(num_edges, sizeof(int), __func__);
+  int *adjacent_vert_index_map = MEM_malloc_arrayN(num_vertices, sizeof(int), __func__);
+  int num_adjacent_edges = 0;
+  int num_adjacent_vertices = 0;
+  StaticOrHeapIntStorage face_vertices_storage;
+  StaticOrHeapIntStorage face_edges_storage;
+  static_or_heap_storage_init(&face_vertices_storage);
+  static_or_heap_storage_init(&face_edges_storage);
+  for (int i = 0; i < num_effected_faces; i++) {
+    SubdivCCGFace *face = (SubdivCCGFace *)effected_faces[i];
+    const int face_index = face - subdiv_ccg->faces;
+    const int num_face_edges = face->num_grids;
+    int *face_vertices = static_or_heap_storage_get(&face_vertices_storage, num_face_edges);
+    topology_refiner->getFaceVertices(topology_refiner, face_index, face_vertices);
+    int *face_edges = static_or_heap_storage_get(&face_edges_storage, num_face_edges);
+    topology_refiner->getFaceEdges(topology_refiner, face_index, face_edges);
+    for (int corner = 0; corner < num_face_edges; corner++) {
+      const int vertex_index = face_vertices[corner];
+      const int edge_index = face_edges[corner];
+      if (edge_index < num_edges && !BLI_BITMAP_TEST(adjacent_edge_hash, edge_index)) {
+        BLI_BITMAP_ENABLE(adjacent_edge_hash, edge_index);
+        adjacent_edge_index_map[num_adjacent_edges++] = edge_index;
+      }
+      if (vertex_index < num_vertices && !BLI_BITMAP_TEST(adjacent_vertex_hash, vertex_index)) {
+        BLI_BITMAP_ENABLE(adjacent_vertex_hash, vertex_index);
+        adjacent_vert_index_map[num_adjacent_vertices++] = vertex_index;
+      }
+    }
+  }
+  static_or_heap_storage_free(&face_vertices_storage);
+  static_or_heap_storage_free(&face_edges_storage);
+
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edge_index_map, num_adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_vert_index_map, num_adjacent_vertices);
+
+  MEM_freeN(adjacent_edge_hash);
+  MEM_freeN(adjacent_vertex_hash);
+  MEM_freeN(adjacent_edge_index_map);
+  MEM_freeN(adjacent_vert_index_map);
+}
+
 void BKE_subdiv_ccg_average_grids(SubdivCCG *subdiv_ccg)
 {
   CCGKey key;
@@ -1236,9 +1328,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG *subdiv_ccg,
                           &data,
                           subdiv_ccg_stitch_face_inner_grids_task,
                           &parallel_range_settings);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 void BKE_subdiv_ccg_topology_counters(const SubdivCCG *subdiv_ccg,
@@ -35,6 +35,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_evaluator_capi.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
@@ -233,6 +234,36 @@ void BKE_subdiv_eval_limit_point_and_short_normal(Subdiv *subdiv,
   normal_float_to_short_v3(r_N, N_float);
 }
 
+/* ========================== Batched point queries ========================== */
+
+void BKE_subdiv_eval_limit_points_and_derivatives(Subdiv *subdiv,
+                                                  const OpenSubdiv_PatchCoord *patch_coords,
+                                                  const int num_points,
+                                                  float (*r_P)[3],
+                                                  float (*r_dPdu)[3],
+                                                  float (*r_dPdv)[3])
+{
+  subdiv->evaluator->evaluatePatchesLimit(subdiv->evaluator,
+                                          patch_coords,
+                                          num_points,
+                                          &r_P[0][0],
+                                          &r_dPdu[0][0],
+                                          &r_dPdv[0][0]);
+  /* Degenerate derivatives are handled by the single point evaluation, see
+   * #BKE_subdiv_eval_limit_point_and_derivatives. */
+  for (int i = 0; i < num_points; i++) {
+    if ((is_zero_v3(r_dPdu[i]) || is_zero_v3(r_dPdv[i])) || equals_v3v3(r_dPdu[i], r_dPdv[i])) {
+      BKE_subdiv_eval_limit_point_and_derivatives(subdiv,
+                                                  patch_coords[i].ptex_face,
+                                                  patch_coords[i].u,
+                                                  patch_coords[i].v,
+                                                  r_P[i],
+                                                  r_dPdu[i],
+                                                  r_dPdv[i]);
+    }
+  }
+}
+
 void BKE_subdiv_eval_face_varying(Subdiv *subdiv,
                                   const int face_varying_channel,
                                   const int ptex_face_index,
@@ -41,6 +41,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
+
 /* -------------------------------------------------------------------- */
 /** \name Subdivision Context
  * \{ */
@@ -425,7 +427,12 @@ static void loop_interpolation_end(LoopsForInterpolation *loop_interpolation)
 /** \name TLS
  * \{ */
 
+/* Maximum number of inner vertices which are evaluated together. */
+#define INNER_VERTICES_BATCH_SIZE 256
+
 typedef struct SubdivMeshTLS {
+  SubdivMeshContext *ctx;
+
   bool vertex_interpolation_initialized;
   VerticesForInterpolation vertex_interpolation;
   const MPoly *vertex_interpolation_coarse_poly;
@@ -435,11 +442,19 @@ typedef struct SubdivMeshTLS {
   LoopsForInterpolation loop_interpolation;
   const MPoly *loop_interpolation_coarse_poly;
   int loop_interpolation_coarse_corner;
+
+  /* Inner vertices whose position and normal are not evaluated yet. */
+  int num_pending_inner_vertices;
+  OpenSubdiv_PatchCoord pending_inner_patch_coords[INNER_VERTICES_BATCH_SIZE];
+  int pending_inner_vertex_indices[INNER_VERTICES_BATCH_SIZE];
 } SubdivMeshTLS;
 
+static void subdiv_mesh_flush_inner_vertices(SubdivMeshTLS *tls);
+
 static void subdiv_mesh_tls_free(void *tls_v)
 {
   SubdivMeshTLS *tls = tls_v;
+  subdiv_mesh_flush_inner_vertices(tls);
   if (tls->vertex_interpolation_initialized) {
     vertex_interpolation_end(&tls->vertex_interpolation);
   }
@@ -772,6 +787,31 @@ static void subdiv_mesh_tag_center_vertex(const MPoly *coarse_poly,
   }
 }
 
+/* Evaluate the positions and normals of all pending inner vertices at once. */
+static void subdiv_mesh_flush_inner_vertices(SubdivMeshTLS *tls)
+{
+  const int num_vertices = tls->num_pending_inner_vertices;
+  if (num_vertices == 0) {
+    return;
+  }
+  SubdivMeshContext *ctx = tls->ctx;
+  MVert *subdiv_mvert = ctx->subdiv_mesh->mvert;
+  float P[INNER_VERTICES_BATCH_SIZE][3];
+  float dPdu[INNER_VERTICES_BATCH_SIZE][3];
+  float dPdv[INNER_VERTICES_BATCH_SIZE][3];
+  BKE_subdiv_eval_limit_points_and_derivatives(
+      ctx->subdiv, tls->pending_inner_patch_coords, num_vertices, P, dPdu, dPdv);
+  for (int i = 0; i < num_vertices; i++) {
+    MVert *subdiv_vert = &subdiv_mvert[tls->pending_inner_vertex_indices[i]];
+    float N[3];
+    cross_v3_v3v3(N, dPdu[i], dPdv[i]);
+    normalize_v3(N);
+    copy_v3_v3(subdiv_vert->co, P[i]);
+    normal_float_to_short_v3(subdiv_vert->no, N);
+  }
+  tls->num_pending_inner_vertices = 0;
+}
+
 static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context,
                                      void *tls_v,
                                      const int ptex_face_index,
@@ -792,9 +832,24 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   MVert *subdiv_vert = &subdiv_mvert[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
-  eval_final_point_and_vertex_normal(
-      subdiv, ptex_face_index, u, v, subdiv_vert->co, subdiv_vert->no);
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
+  if (subdiv->displacement_evaluator != NULL) {
+    eval_final_point_and_vertex_normal(
+        subdiv, ptex_face_index, u, v, subdiv_vert->co, subdiv_vert->no);
+    return;
+  }
+  /* Nothing reads the inner vertices during the traversal, so their evaluation can be delayed
+   * until there are enough of them for a batch. */
+  OpenSubdiv_PatchCoord *patch_coord =
+      &tls->pending_inner_patch_coords[tls->num_pending_inner_vertices];
+  patch_coord->ptex_face = ptex_face_index;
+  patch_coord->u = u;
+  patch_coord->v = v;
+  tls->pending_inner_vertex_indices[tls->num_pending_inner_vertices] = subdiv_vertex_index;
+  tls->num_pending_inner_vertices++;
+  if (tls->num_pending_inner_vertices == INNER_VERTICES_BATCH_SIZE) {
+    subdiv_mesh_flush_inner_vertices(tls);
+  }
 }
 
 /** \} */
@@ -1223,6 +1278,7 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   SubdivForeachContext foreach_context;
   setup_foreach_callbacks(&subdiv_context, &foreach_context);
   SubdivMeshTLS tls = {0};
+  tls.ctx = &subdiv_context;
   foreach_context.user_data = &subdiv_context;
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
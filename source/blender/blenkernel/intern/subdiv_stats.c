@@ -37,6 +37,8 @@ void BKE_subdiv_stats_init(SubdivStats *stats)
   stats->subdiv_to_ccg_time = 0.0;
   stats->subdiv_to_ccg_elements_time = 0.0;
   stats->topology_compare_time = 0.0;
+  stats->num_topology_refiner_rebuilds = 0;
+  stats->num_topology_refiner_reuses = 0;
 }
 
 void BKE_subdiv_stats_begin(SubdivStats *stats, eSubdivStatsValue value)
@@ -63,6 +65,13 @@ void BKE_subdiv_stats_print(const SubdivStats *stats)
     } \
   } while (false)
 
+#define STATS_PRINT_COUNT(stats, value, description) \
+  do { \
+    if ((stats)->value > 0) { \
+      printf("  %s: %d\n", description, (stats)->value); \
+    } \
+  } while (false)
+
   printf("Subdivision surface statistics:\n");
 
   STATS_PRINT_TIME(stats, topology_refiner_creation_time, "Topology refiner creation time");
@@ -73,6 +82,9 @@ void BKE_subdiv_stats_print(const SubdivStats *stats)
   STATS_PRINT_TIME(stats, subdiv_to_ccg_time, "Subdivision to CCG time");
   STATS_PRINT_TIME(stats, subdiv_to_ccg_elements_time, "    Elements time");
   STATS_PRINT_TIME(stats, topology_compare_time, "Topology comparison time");
+  STATS_PRINT_COUNT(stats, num_topology_refiner_rebuilds, "Topology refiner rebuilds");
+  STATS_PRINT_COUNT(stats, num_topology_refiner_reuses, "Topology refiner reuses");
 
 #undef STATS_PRINT_TIME
+#undef STATS_PRINT_COUNT
 }
@@ -642,6 +642,44 @@ static void autotrack_context_step_cb(void *__restrict userdata,
   BLI_addtail(&autotrack_tls->results, autotrack_result);
 }
 
+/* Frame of a clip to be loaded to the cache while the markers are being tracked. */
+typedef struct AutoTrackPrefetchTask {
+  MovieClip *clip;
+  int clip_frame;
+} AutoTrackPrefetchTask;
+
+static void autotrack_context_prefetch_cb(TaskPool *__restrict UNUSED(pool), void *task_data)
+{
+  const AutoTrackPrefetchTask *prefetch_task = (AutoTrackPrefetchTask *)task_data;
+  MovieClip *clip = prefetch_task->clip;
+
+  /* Same settings as the image accessor, so the frame gets cached the way it is accessed. */
+  MovieClipUser user = {0};
+  BKE_movieclip_user_set_frame(
+      &user, BKE_movieclip_remap_clip_to_scene_frame(clip, prefetch_task->clip_frame));
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+
+  BKE_movieclip_prefetch_frame(clip, &user);
+}
+
+/* Load the frame which will be tracked to on the next step, so that it is read while the current
+ * step is tracking instead of when all the markers of the next step are waiting for it. */
+static TaskPool *autotrack_context_prefetch_begin(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  const int next_frame = context->autotrack_markers[0].libmv_marker.frame + 2 * frame_delta;
+
+  TaskPool *task_pool = BLI_task_pool_create(context, TASK_PRIORITY_LOW);
+  for (int clip_index = 0; clip_index < context->num_clips; ++clip_index) {
+    AutoTrackPrefetchTask *prefetch_task = MEM_mallocN(sizeof(*prefetch_task), __func__);
+    prefetch_task->clip = context->autotrack_clips[clip_index].clip;
+    prefetch_task->clip_frame = next_frame;
+    BLI_task_pool_push(task_pool, autotrack_context_prefetch_cb, prefetch_task, true, NULL);
+  }
+  return task_pool;
+}
+
 static void autotrack_context_reduce(const void *__restrict UNUSED(userdata),
                                      void *__restrict chunk_join,
                                      void *__restrict chunk)
@@ -672,9 +710,14 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   settings.userdata_chunk_size = sizeof(AutoTrackTLS);
   settings.func_reduce = autotrack_context_reduce;
 
+  TaskPool *prefetch_pool = autotrack_context_prefetch_begin(context);
+
   BLI_task_parallel_range(
       0, context->num_autotrack_markers, context, autotrack_context_step_cb, &settings);
 
+  BLI_task_pool_work_and_wait(prefetch_pool);
+  BLI_task_pool_free(prefetch_pool);
+
   /* Prepare next tracking step by updating the AutoTrack context with new markers and moving
    * tracked markers as an input for the next iteration. */
   context->num_autotrack_markers = 0;
@@ -22,6 +22,7 @@
 
 #include "BLI_array.hh"
 #include "BLI_float3.hh"
+#include "BLI_math_base.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_vector.hh"
@@ -101,21 +102,67 @@ static void create_texture_to_object_matrix(const openvdb::Mat4d &grid_transform
   mul_m4_m4m4(r_texture_to_object, index_to_object, texture_to_index);
 }
 
+/* Factor to scale the resolution of the grid by to fit in the limits, 1.0 when it fits. */
+static float dense_resolution_factor(const openvdb::CoordBBox &bbox,
+                                     const int max_resolution,
+                                     const int64_t max_voxels)
+{
+  const openvdb::Vec3i resolution = bbox.dim().asVec3i();
+  float factor = 1.0f;
+
+  const int max_axis = max_iii(resolution[0], resolution[1], resolution[2]);
+  if (max_resolution > 2 && max_axis > max_resolution) {
+    /* Leave room for the voxels added around the borders by the resampling filter. */
+    factor = min_ff(factor, (max_resolution - 2) / (float)max_axis);
+  }
+
+  const int64_t num_voxels = static_cast<int64_t>(resolution[0]) *
+                             static_cast<int64_t>(resolution[1]) *
+                             static_cast<int64_t>(resolution[2]);
+  if (max_voxels > 0 && num_voxels > max_voxels) {
+    factor = min_ff(factor, 0.99f * cbrtf((float)max_voxels / (float)num_voxels));
+  }
+
+  return factor;
+}
+
 #endif
 
+/**
+ * Copy the grid voxels inside its active bounding box to a dense array.
+ *
+ * Grids larger than \a max_resolution along an axis or with more than \a max_voxels are
+ * resampled at a lower resolution to fit, instead of failing. Zero means no limit.
+ */
 bool BKE_volume_grid_dense_floats(const Volume *volume,
                                   VolumeGrid *volume_grid,
+                                  const int max_resolution,
+                                  const int64_t max_voxels,
                                   DenseFloatVolumeGrid *r_dense_grid)
 {
 #ifdef WITH_OPENVDB
   const VolumeGridType grid_type = BKE_volume_grid_type(volume_grid);
   openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
 
-  const openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
+  openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
   if (bbox.empty()) {
     return false;
   }
 
+  const float resolution_factor = dense_resolution_factor(bbox, max_resolution, max_voxels);
+  if (resolution_factor < 1.0f) {
+    openvdb::GridBase::Ptr resampled_grid = BKE_volume_grid_create_with_changed_resolution(
+        grid_type, *grid, resolution_factor);
+    if (!resampled_grid) {
+      return false;
+    }
+    grid = resampled_grid;
+    bbox = grid->evalActiveVoxelBoundingBox();
+    if (bbox.empty()) {
+      return false;
+    }
+  }
+
   const openvdb::Vec3i resolution = bbox.dim().asVec3i();
   const int64_t num_voxels = static_cast<int64_t>(resolution[0]) *
                              static_cast<int64_t>(resolution[1]) *
@@ -137,7 +184,7 @@ bool BKE_volume_grid_dense_floats(const Volume *volume,
   copy_v3_v3_int(r_dense_grid->resolution, resolution.asV());
   return true;
 #endif
-  UNUSED_VARS(volume, volume_grid, r_dense_grid);
+  UNUSED_VARS(volume, volume_grid, max_resolution, max_voxels, r_dense_grid);
   return false;
 }
 
@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ * \brief Multi-threaded array algorithms: prefix sums, grouping and sorting of indices.
+ *
+ * The results never depend on the number of threads, small arrays are processed serially.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Replace every value by the sum of the values before it, and return the sum of all values.
+ */
+int BLI_array_exclusive_scan_i(int *data, const int data_len);
+
+/**
+ * Group the indices of \a keys by their value, like a counting sort.
+ *
+ * \param r_offsets: Array of \a groups_len + 1 values, the indices of the elements with key
+ * \a k are `r_indices[r_offsets[k]]` to `r_indices[r_offsets[k + 1] - 1]`.
+ * \param r_indices: Array of \a keys_len values,
+ * the indices within a group are in ascending order.
+ *
+ * Elements with a negative key are not part of any group, `r_offsets[groups_len]` is the number
+ * of grouped elements.
+ */
+void BLI_array_group_indices_by_key(const int *keys,
+                                    const int keys_len,
+                                    const int groups_len,
+                                    int *r_offsets,
+                                    int *r_indices);
+
+/**
+ * Fill \a r_indices with the indices of \a keys in ascending order of the keys.
+ * The sort is stable, so the order of equal keys is the order of their indices.
+ */
+void BLI_array_sort_indices_by_key_u64(const uint64_t *keys, const int keys_len, int *r_indices);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,234 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentMap<Key, Value>` is a `blender::Map` that can be used from multiple
+ * threads at the same time. It is split into shards, each being a `blender::Map` protected by a
+ * mutex of its own, so that threads accessing different keys rarely wait for each other. This is
+ * meant for caches shared by tasks running in parallel, a single `blender::Map` protected by one
+ * mutex should be preferred when contention is not a concern.
+ *
+ * Some noteworthy information:
+ * - The hash function, equality operator and probing strategy can be customized like for
+ *   `blender::Map`, the shard of a key is chosen from the bits of its hash which are not used by
+ *   the shards themselves.
+ * - There is no way to get pointers or references to keys and values, since those might be
+ *   changed by other threads as soon as the shard is unlocked. Lookups return copies of the
+ *   values, so values are typically small, like pointers or `std::shared_ptr`.
+ * - Callbacks passed to methods are called while the shard of the key is locked, they must be
+ *   short and must not access the map.
+ */
+
+#include <array>
+#include <mutex>
+
+#include "BLI_map.hh"
+
+namespace blender {
+
+template<
+    /** Type of the keys stored in the map, see #Map. */
+    typename Key,
+    /** Type of the value that is stored per key, it has to be copyable. */
+    typename Value,
+    /**
+     * Number of independently locked parts of the map, has to be a power of two. More shards
+     * reduce contention, at the cost of the memory of the map.
+     */
+    int64_t ShardsNum = 64,
+    typename ProbingStrategy = DefaultProbingStrategy,
+    typename Hash = DefaultHash<Key>,
+    typename IsEqual = DefaultEquality,
+    typename Allocator = GuardedAllocator>
+class ConcurrentMap {
+ public:
+  using MapType = Map<Key,
+                      Value,
+                      0,
+                      ProbingStrategy,
+                      Hash,
+                      IsEqual,
+                      typename DefaultMapSlot<Key, Value>::type,
+                      Allocator>;
+
+ private:
+  BLI_STATIC_ASSERT(ShardsNum > 0 && (ShardsNum & (ShardsNum - 1)) == 0,
+                    "The number of shards has to be a power of two");
+
+  static constexpr int get_shard_bits()
+  {
+    int bits = 0;
+    while (((int64_t)1 << bits) < ShardsNum) {
+      bits++;
+    }
+    return bits;
+  }
+  static constexpr int shard_bits = get_shard_bits();
+
+  struct Shard {
+    mutable std::mutex mutex;
+    MapType map;
+  };
+
+  std::array<Shard, ShardsNum> shards_;
+  Hash hash_;
+
+ public:
+  ConcurrentMap() = default;
+  ConcurrentMap(const ConcurrentMap &other) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &other) = delete;
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.add(key, value);
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, the previous value is
+   * overwritten. Returns true when the key has been added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.add_overwrite(key, value);
+  }
+
+  /**
+   * Returns true when the key is in the map, it might have been removed by another thread by the
+   * time this returns.
+   */
+  bool contains(const Key &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.contains(key);
+  }
+
+  /**
+   * Remove the key from the map, returns true when the key was in the map.
+   */
+  bool remove(const Key &key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.remove(key);
+  }
+
+  /**
+   * Returns a copy of the value corresponding to the key, or the default value when the key is
+   * not in the map.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.lookup_default(key, default_value);
+  }
+
+  /**
+   * Returns a copy of the value corresponding to the key. When the key is not in the map yet,
+   * the value is created by calling `create_value()` first. The value is created only once for
+   * every key, even when several threads need it at the same time, but other keys of the same
+   * shard can't be accessed while it is created.
+   */
+  template<typename CreateValueF>
+  Value lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.map.lookup_or_add_cb(key, create_value);
+  }
+
+  /**
+   * Call `fn(key, value)` for every item in the map. Every shard is locked while its items are
+   * visited, items added or removed by other threads in the meantime might be missed.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &fn) const
+  {
+    for (const Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock{shard.mutex};
+      for (const auto item : shard.map.items()) {
+        fn(item.key, item.value);
+      }
+    }
+  }
+
+  /**
+   * Number of items in the map, only exact when no other thread changes it.
+   */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock{shard.mutex};
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Remove all items from the map.
+   */
+  void clear()
+  {
+    for (Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock{shard.mutex};
+      shard.map.clear();
+    }
+  }
+
+ private:
+  int64_t shard_index(const Key &key) const
+  {
+    /* The maps use the lowest bits of the hash to find slots, so use the highest bits of a mixed
+     * hash. Mixing is needed because the hash of small integers has no high bits. */
+    if constexpr (shard_bits == 0) {
+      return 0;
+    }
+    else {
+      const uint64_t hash = (uint64_t)hash_(key) * 0x9e3779b97f4a7c15ull;
+      return (int64_t)(hash >> (64 - shard_bits));
+    }
+  }
+
+  Shard &shard_for_key(const Key &key)
+  {
+    return shards_[this->shard_index(key)];
+  }
+
+  const Shard &shard_for_key(const Key &key) const
+  {
+    return shards_[this->shard_index(key)];
+  }
+};
+
+}  // namespace blender
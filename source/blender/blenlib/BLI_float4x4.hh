@@ -45,6 +45,13 @@ struct float4x4 {
     return &values[0][0];
   }
 
+  static float4x4 identity()
+  {
+    float4x4 mat;
+    unit_m4(mat.values);
+    return mat;
+  }
+
   using c_style_float4x4 = float[4][4];
   c_style_float4x4 &ptr()
   {
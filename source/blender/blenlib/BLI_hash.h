@@ -20,6 +20,8 @@
  * \ingroup bli
  */
 
+#include <string.h>
+
 #include "BLI_utildefines.h"
 
 #ifdef __cplusplus
@@ -111,6 +113,32 @@ BLI_INLINE void BLI_hash_pointer_to_color(const void *ptr, int *r, int *g, int *
   *b = hash & 0x0000ff;
 }
 
+/**
+ * 64 bit hashing of arbitrary data, used to detect changes to it.
+ * Not meant for hash tables, use #BLI_ghashutil_strhash and friends for them.
+ */
+
+BLI_INLINE uint64_t BLI_hash_u64_combine(const uint64_t a, const uint64_t b)
+{
+  return a ^ (b + 0x9e3779b97f4a7c15ull + (a << 6) + (a >> 2));
+}
+
+BLI_INLINE uint64_t BLI_hash_buffer_u64(const void *data, const size_t size, uint64_t hash)
+{
+  const char *bytes = (const char *)data;
+  const size_t words_num = size / sizeof(uint64_t);
+  for (size_t i = 0; i < words_num; i++) {
+    uint64_t word;
+    memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * 0x100000001b3ull;
+    hash ^= hash >> 29;
+  }
+  for (size_t i = words_num * sizeof(uint64_t); i < size; i++) {
+    hash = (hash ^ (uint64_t)bytes[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -130,6 +130,13 @@ typedef void (*BVHTree_NearestProjectedCallback)(void *userdata,
                                                  const int clip_plane_len,
                                                  BVHTreeNearest *nearest);
 
+/* callback to BLI_bvhtree_insert_many and BLI_bvhtree_refit, fills the coordinates of the
+ * element stored under index and returns their number, which can't exceed BVH_LEAF_POINTS_MAX */
+#define BVH_LEAF_POINTS_MAX 4
+typedef int (*BVHTree_LeafCoordsCallback)(void *userdata,
+                                          int index,
+                                          float r_co[BVH_LEAF_POINTS_MAX][3]);
+
 /* callbacks to BLI_bvhtree_walk_dfs */
 /* return true to traverse into this nodes children, else skip. */
 typedef bool (*BVHTree_WalkParentCallback)(const BVHTreeAxisRange *bounds, void *userdata);
@@ -147,12 +154,20 @@ void BLI_bvhtree_free(BVHTree *tree);
 
 /* construct: first insert points, then call balance */
 void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoints);
+/* insert many elements from multiple threads, indices can be NULL to insert 0..indices_num-1 */
+void BLI_bvhtree_insert_many(BVHTree *tree,
+                             const int *indices,
+                             int indices_num,
+                             BVHTree_LeafCoordsCallback callback,
+                             void *userdata);
 void BLI_bvhtree_balance(BVHTree *tree);
 
 /* update: first update points/nodes, then call update_tree to refit the bounding volumes */
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints);
 void BLI_bvhtree_update_tree(BVHTree *tree);
+/* update all leafs from their element coordinates then refit, keeping the tree layout */
+void BLI_bvhtree_refit(BVHTree *tree, BVHTree_LeafCoordsCallback callback, void *userdata);
 
 int BLI_bvhtree_overlap_thread_num(const BVHTree *tree);
 
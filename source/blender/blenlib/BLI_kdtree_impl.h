@@ -67,6 +67,20 @@ void BLI_kdtree_nd_(range_search_cb)(
     bool (*search_cb)(void *user_data, int index, const float co[KD_DIMS], float dist_sq),
     void *user_data);
 
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest) ATTR_NONNULL(1, 2);
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    const uint co_len,
+    float range,
+    bool (*search_cb)(
+        void *user_data, int co_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data) ATTR_NONNULL(1, 2, 5);
+
 int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          const float range,
                                          bool use_index_order,
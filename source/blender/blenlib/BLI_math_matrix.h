@@ -185,6 +185,8 @@ void _va_mul_m4_series_9(float R[4][4],
 #define mul_m4_series(...) VA_NARGS_CALL_OVERLOAD(_va_mul_m4_series_, __VA_ARGS__)
 
 void mul_m4_v3(const float M[4][4], float r[3]);
+void mul_m4_v3_array(const float M[4][4], float (*r_arr)[3], const int nbr);
+void mul_m4_v3_array_stride(const float M[4][4], float *r_arr, const int nbr, const size_t stride);
 void mul_v3_m4v3(float r[3], const float M[4][4], const float v[3]);
 void mul_v3_m4v3_db(double r[3], const double mat[4][4], const double vec[3]);
 void mul_v4_m4v3_db(double r[4], const double mat[4][4], const double vec[3]);
@@ -46,6 +46,7 @@ void BLI_mempool_clear_ex(BLI_mempool *pool, const int totelem_reserve) ATTR_NON
 void BLI_mempool_clear(BLI_mempool *pool) ATTR_NONNULL(1);
 void BLI_mempool_destroy(BLI_mempool *pool) ATTR_NONNULL(1);
 int BLI_mempool_len(BLI_mempool *pool) ATTR_NONNULL(1);
+int BLI_mempool_capacity(BLI_mempool *pool) ATTR_NONNULL(1);
 void *BLI_mempool_findelem(BLI_mempool *pool, unsigned int index) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(1);
 
@@ -83,6 +84,15 @@ enum {
    * order of allocation when no chunks have been freed.
    */
   BLI_MEMPOOL_ALLOW_ITER = (1 << 0),
+  /**
+   * Allocate chunks of 2 MiB aligned to their size, that the system can back by huge pages,
+   * the requested number of elements per chunk is ignored. Use for pools with many elements.
+   *
+   * \note Iterating skips the unused elements using a bitmap of the elements in use,
+   * the content of the elements isn't restricted like with #BLI_MEMPOOL_ALLOW_ITER alone.
+   * \note Clearing doesn't touch the memory of the elements.
+   */
+  BLI_MEMPOOL_LARGE_CHUNKS = (1 << 1),
 };
 
 void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter) ATTR_NONNULL();
@@ -167,6 +167,9 @@ typedef struct TaskParallelSettings {
    *   thread which will be doing 16 iterators each.
    * This is a preferred way to tell scheduler when to start threading than
    * having a global use_threading switch based on just range size.
+   *
+   * When zero, it is tuned for the callback from the time its iterations took in the first
+   * calls, see #BLI_task_parallel_range_stats_print.
    */
   int min_iter_per_thread;
 } TaskParallelSettings;
@@ -179,6 +182,11 @@ void BLI_task_parallel_range(const int start,
                              TaskParallelRangeFunc func,
                              const TaskParallelSettings *settings);
 
+/* Print the number of calls, iterations, tuned chunk size and the average number of busy
+ * threads of the parallel ranges which chunk size is tuned automatically. Useful to find
+ * loops which are too small to benefit from threading, or which don't use all threads. */
+void BLI_task_parallel_range_stats_print(void);
+
 /* This data is shared between all tasks, its access needs thread lock or similar protection.
  */
 typedef struct TaskParallelIteratorStateShared {
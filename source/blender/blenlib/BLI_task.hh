@@ -41,11 +41,70 @@
 #  endif
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <typeinfo>
+
 #include "BLI_index_range.hh"
 #include "BLI_utildefines.h"
 
 namespace blender {
 
+namespace detail {
+
+/**
+ * Chooses the grain size of a parallel loop from the time its iterations took during the first
+ * calls, there is one tuner per call site. Chunks are made large enough for the scheduling
+ * overhead to be negligible, while keeping enough of them to balance the load over all threads.
+ */
+class ParallelRangeTuner {
+ public:
+  /** Number of first calls of which the iterations are timed. */
+  static constexpr int64_t measured_calls_num = 8;
+  /** Time (in nanoseconds) the iterations of a chunk should take. */
+  static constexpr int64_t chunk_target_ns = 50000;
+
+ private:
+  const char *name_;
+  const void *func_;
+  ParallelRangeTuner *next_;
+
+  std::atomic<int64_t> grain_size_{1};
+  std::atomic<int64_t> calls_num_{0};
+  std::atomic<int64_t> iterations_num_{0};
+  std::atomic<int64_t> wall_ns_{0};
+  std::atomic<int64_t> measured_calls_num_{0};
+  std::atomic<int64_t> measured_iterations_num_{0};
+  std::atomic<int64_t> measured_wall_ns_{0};
+  std::atomic<int64_t> measured_thread_ns_{0};
+
+ public:
+  /** Name or function of the call site, used to print the statistics. */
+  ParallelRangeTuner(const char *name, const void *func);
+
+  static int64_t time_ns()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /** Whether the time spent in each chunk has to be measured for the next call. */
+  bool is_measuring() const
+  {
+    return measured_calls_num_.load(std::memory_order_relaxed) < measured_calls_num;
+  }
+
+  int64_t grain_size(const int64_t range_size) const;
+
+  /** Pass a negative \a thread_ns when the time of the chunks wasn't measured. */
+  void add_call(const int64_t iterations_num, const int64_t wall_ns, const int64_t thread_ns);
+
+  static void print_stats();
+};
+
+}  // namespace detail
+
 template<typename Range, typename Function>
 void parallel_for_each(Range &range, const Function &function)
 {
@@ -75,4 +134,40 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
+/**
+ * Same as above, with a grain size tuned for the call site from the time its iterations took
+ * in the first calls.
+ */
+template<typename Function> void parallel_for(IndexRange range, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+#ifdef WITH_TBB
+  /* Every call site passes a lambda of a different type, so there is one tuner per call site. */
+  static detail::ParallelRangeTuner tuner(typeid(Function).name(), nullptr);
+  const bool is_measuring = tuner.is_measuring();
+  std::atomic<int64_t> thread_ns{0};
+  const int64_t start_ns = detail::ParallelRangeTuner::time_ns();
+
+  tbb::parallel_for(
+      tbb::blocked_range<int64_t>(
+          range.first(), range.one_after_last(), tuner.grain_size(range.size())),
+      [&](const tbb::blocked_range<int64_t> &subrange) {
+        const int64_t chunk_start_ns = is_measuring ? detail::ParallelRangeTuner::time_ns() : 0;
+        function(IndexRange(subrange.begin(), subrange.size()));
+        if (is_measuring) {
+          thread_ns.fetch_add(detail::ParallelRangeTuner::time_ns() - chunk_start_ns,
+                              std::memory_order_relaxed);
+        }
+      });
+
+  tuner.add_call(range.size(),
+                 detail::ParallelRangeTuner::time_ns() - start_ns,
+                 is_measuring ? thread_ns.load() : -1);
+#else
+  function(range);
+#endif
+}
+
 }  // namespace blender
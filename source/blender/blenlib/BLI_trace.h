@@ -0,0 +1,77 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Timeline of the zones of code executed by every thread, written in the Chrome trace event
+ * format which can be opened in `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * Every thread records its zones in a ring buffer of its own, so only the last zones are kept
+ * for long sessions. Recording is disabled unless #BLI_trace_init was called, zones then only
+ * cost a check of a global flag.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of zones kept per thread. */
+#define BLI_TRACE_ZONES_PER_THREAD (1 << 16)
+
+/**
+ * Start recording zones, the trace is written to \a filepath by #BLI_trace_exit.
+ */
+void BLI_trace_init(const char *filepath);
+/**
+ * Write the trace and stop recording, must be called when no other thread records zones.
+ */
+void BLI_trace_exit(void);
+bool BLI_trace_is_enabled(void);
+
+/**
+ * Begin a zone of the calling thread, zones are nested and ended in reverse order.
+ * The \a category has to be a static string, \a name is copied and truncated.
+ */
+void BLI_trace_begin(const char *category, const char *name);
+void BLI_trace_end(void);
+
+#ifdef __cplusplus
+}
+
+namespace blender {
+
+class ScopedTraceZone {
+ public:
+  ScopedTraceZone(const char *category, const char *name)
+  {
+    BLI_trace_begin(category, name);
+  }
+  ~ScopedTraceZone()
+  {
+    BLI_trace_end();
+  }
+};
+
+}  // namespace blender
+
+#  define SCOPED_TRACE_ZONE(category, name) \
+    blender::ScopedTraceZone scoped_trace_zone(category, name)
+#endif
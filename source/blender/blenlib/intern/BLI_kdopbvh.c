@@ -70,6 +70,10 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Branches with more leafs compute their bounds from multiple threads, this only happens on the
+ * first levels of big trees where there are less branches than threads. */
+#define KDOPBVH_THREAD_REFIT_THRESHOLD 65536
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -384,33 +388,75 @@ static void create_kdop_hull(
   }
 }
 
+static void refit_kdop_hull_bv(const BVHTree *tree, float *__restrict bv, const float *node_bv)
+{
+  float newmin, newmax;
+  axis_t axis_iter;
+
+  /* for all Axes. */
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    newmin = node_bv[(2 * axis_iter)];
+    if ((newmin < bv[(2 * axis_iter)])) {
+      bv[(2 * axis_iter)] = newmin;
+    }
+
+    newmax = node_bv[(2 * axis_iter) + 1];
+    if ((newmax > bv[(2 * axis_iter) + 1])) {
+      bv[(2 * axis_iter) + 1] = newmax;
+    }
+  }
+}
+
+typedef struct RefitKDopHullChunk {
+  float bv[13 * 2];
+} RefitKDopHullChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHTree *tree = userdata;
+  RefitKDopHullChunk *chunk = tls->userdata_chunk;
+  refit_kdop_hull_bv(tree, chunk->bv, tree->nodes[j]->bv);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHTree *tree = userdata;
+  refit_kdop_hull_bv(
+      tree, ((RefitKDopHullChunk *)chunk_join)->bv, ((const RefitKDopHullChunk *)chunk)->bv);
+}
+
 /**
  * \note depends on the fact that the BVH's for each face is already built
  */
 static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
 {
-  float newmin, newmax;
   float *__restrict bv = node->bv;
   int j;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
-  for (j = start; j < end; j++) {
-    float *__restrict node_bv = tree->nodes[j]->bv;
+  if (end - start > KDOPBVH_THREAD_REFIT_THRESHOLD) {
+    RefitKDopHullChunk chunk;
+    memcpy(chunk.bv, bv, sizeof(float) * 2 * (size_t)tree->stop_axis);
 
-    /* for all Axes. */
-    for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-      newmin = node_bv[(2 * axis_iter)];
-      if ((newmin < bv[(2 * axis_iter)])) {
-        bv[(2 * axis_iter)] = newmin;
-      }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.userdata_chunk = &chunk;
+    settings.userdata_chunk_size = sizeof(chunk);
+    settings.func_reduce = refit_kdop_hull_reduce;
+    settings.min_iter_per_thread = KDOPBVH_THREAD_REFIT_THRESHOLD / 16;
+    BLI_task_parallel_range(start, end, (void *)tree, refit_kdop_hull_task_cb, &settings);
 
-      newmax = node_bv[(2 * axis_iter) + 1];
-      if ((newmax > bv[(2 * axis_iter) + 1])) {
-        bv[(2 * axis_iter) + 1] = newmax;
-      }
-    }
+    memcpy(bv, chunk.bv, sizeof(float) * 2 * (size_t)tree->stop_axis);
+    return;
+  }
+
+  for (j = start; j < end; j++) {
+    refit_kdop_hull_bv(tree, bv, tree->nodes[j]->bv);
   }
 }
 
@@ -1013,6 +1059,60 @@ void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoin
   bvhtree_node_inflate(tree, node, tree->epsilon);
 }
 
+typedef struct BVHInsertManyData {
+  BVHTree *tree;
+  const int *indices;
+  BVHTree_LeafCoordsCallback callback;
+  void *userdata;
+} BVHInsertManyData;
+
+static void bvhtree_insert_many_task_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHInsertManyData *data = userdata;
+  BVHTree *tree = data->tree;
+  const int leaf_index = tree->totleaf + i;
+  BVHNode *node = tree->nodes[leaf_index] = &tree->nodearray[leaf_index];
+  float co[BVH_LEAF_POINTS_MAX][3];
+
+  node->index = data->indices ? data->indices[i] : i;
+  const int numpoints = data->callback(data->userdata, node->index, co);
+  BLI_assert(numpoints <= BVH_LEAF_POINTS_MAX);
+
+  create_kdop_hull(tree, node, co[0], numpoints, 0);
+  bvhtree_node_inflate(tree, node, tree->epsilon);
+}
+
+/**
+ * Same as calling #BLI_bvhtree_insert for all elements in order, with the coordinates given by
+ * \a callback, which must be thread-safe.
+ */
+void BLI_bvhtree_insert_many(BVHTree *tree,
+                             const int *indices,
+                             int indices_num,
+                             BVHTree_LeafCoordsCallback callback,
+                             void *userdata)
+{
+  BLI_assert(tree->totbranch <= 0);
+  BLI_assert((size_t)(tree->totleaf + indices_num) <=
+             MEM_allocN_len(tree->nodes) / sizeof(*(tree->nodes)));
+
+  BVHInsertManyData data = {
+      .tree = tree,
+      .indices = indices,
+      .callback = callback,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (indices_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, indices_num, &data, bvhtree_insert_many_task_cb, &settings);
+
+  tree->totleaf += indices_num;
+}
+
 /* call before BLI_bvhtree_update_tree() */
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints)
@@ -1020,7 +1120,7 @@ bool BLI_bvhtree_update_node(
   BVHNode *node = NULL;
 
   /* check if index exists */
-  if (index > tree->totleaf) {
+  if (index >= tree->totleaf) {
     return false;
   }
 
@@ -1054,6 +1154,49 @@ void BLI_bvhtree_update_tree(BVHTree *tree)
     node_join(tree, *index);
   }
 }
+typedef struct BVHRefitData {
+  BVHTree *tree;
+  BVHTree_LeafCoordsCallback callback;
+  void *userdata;
+} BVHRefitData;
+
+static void bvhtree_refit_leaf_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHRefitData *data = userdata;
+  BVHTree *tree = data->tree;
+  BVHNode *node = tree->nodearray + i;
+  float co[BVH_LEAF_POINTS_MAX][3];
+
+  const int numpoints = data->callback(data->userdata, node->index, co);
+  BLI_assert(numpoints <= BVH_LEAF_POINTS_MAX);
+
+  create_kdop_hull(tree, node, co[0], numpoints, 0);
+  bvhtree_node_inflate(tree, node, tree->epsilon);
+}
+
+/**
+ * Update the bounds of all leafs from the current coordinates of their elements, then the
+ * bounds of the branches. The layout of the tree is kept, which is much faster than building a
+ * new tree, but queries get slower when the elements moved far away from each other.
+ */
+void BLI_bvhtree_refit(BVHTree *tree, BVHTree_LeafCoordsCallback callback, void *userdata)
+{
+  BVHRefitData data = {
+      .tree = tree,
+      .callback = callback,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  BLI_task_parallel_range(0, tree->totleaf, &data, bvhtree_refit_leaf_task_cb, &settings);
+
+  BLI_bvhtree_update_tree(tree);
+}
+
 /**
  * Number of times #BLI_bvhtree_insert has been called.
  * mainly useful for asserts functions to check we added the correct number.
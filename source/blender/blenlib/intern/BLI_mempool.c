@@ -27,13 +27,20 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Large chunks (with the #BLI_MEMPOOL_LARGE_CHUNKS flag), which can be backed by huge pages.
  */
 
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
 #include "atomic_ops.h"
 
+#include "BLI_bitmap.h"
+#include "BLI_math_bits.h"
 #include "BLI_utildefines.h"
 
 #include "BLI_mempool.h" /* own include */
@@ -101,6 +108,11 @@ typedef struct BLI_freenode {
 /**
  * A chunk of memory in the mempool stored in
  * #BLI_mempool.chunks as a double linked list.
+ *
+ * Chunks of pools using #BLI_MEMPOOL_LARGE_CHUNKS are #MEMPOOL_LARGE_CHUNK_SIZE large and
+ * aligned to their size, so the chunk of an element is found from its address. The elements are
+ * followed by a bitmap of the elements in use (see #CHUNK_USED_BITMAP),
+ * and the chunk ends with #CHUNK_LARGE_ALLOC_PTR.
  */
 typedef struct BLI_mempool_chunk {
   struct BLI_mempool_chunk *next;
@@ -131,6 +143,14 @@ struct BLI_mempool {
   uint maxchunks;
   /** Number of elements currently in use. */
   uint totused;
+  /**
+   * Only used with #BLI_MEMPOOL_LARGE_CHUNKS, the elements of the chunks are not added to
+   * #BLI_mempool.free up-front, they are used in order instead. The elements from
+   * \a bump_index in \a bump_chunk and the chunks after it are unused.
+   * NULL when no element has been allocated from the chunks since they were cleared.
+   */
+  BLI_mempool_chunk *bump_chunk;
+  uint bump_index;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -147,6 +167,33 @@ struct BLI_mempool {
 /** Extra bytes implicitly used for every chunk alloc. */
 #define CHUNK_OVERHEAD (uint)(MEM_SIZE_OVERHEAD + sizeof(BLI_mempool_chunk))
 
+/** Size and alignment of the chunks of #BLI_MEMPOOL_LARGE_CHUNKS pools, a huge page on x86. */
+#define MEMPOOL_LARGE_CHUNK_SIZE ((size_t)1 << 21)
+/**
+ * The allocator doesn't support such alignments, the chunks are aligned within a larger
+ * allocation. Only the address space is wasted, the memory around the chunk is never touched.
+ */
+#define MEMPOOL_LARGE_CHUNK_ALLOC_SIZE (MEMPOOL_LARGE_CHUNK_SIZE * 2)
+
+/** The start of the allocation containing a large chunk, stored at the end of the chunk. */
+#define CHUNK_LARGE_ALLOC_PTR(chunk) \
+  ((void **)POINTER_OFFSET(chunk, MEMPOOL_LARGE_CHUNK_SIZE - sizeof(void *)))
+
+#define CHUNK_USED_BITMAP(pool, chunk) \
+  ((BLI_bitmap *)POINTER_OFFSET(CHUNK_DATA(chunk), (pool)->csize))
+
+BLI_INLINE BLI_mempool_chunk *mempool_large_chunk_of_elem(const void *addr)
+{
+  return (BLI_mempool_chunk *)((uintptr_t)addr & ~(uintptr_t)(MEMPOOL_LARGE_CHUNK_SIZE - 1));
+}
+
+BLI_INLINE uint mempool_large_chunk_elem_index(const BLI_mempool *pool,
+                                               BLI_mempool_chunk *mpchunk,
+                                               const void *addr)
+{
+  return (uint)(((const char *)addr - (const char *)CHUNK_DATA(mpchunk)) / pool->esize);
+}
+
 #ifdef USE_CHUNK_POW2
 static uint power_of_2_max_u(uint x)
 {
@@ -181,6 +228,19 @@ BLI_INLINE uint mempool_maxchunks(const uint totelem, const uint pchunk)
 
 static BLI_mempool_chunk *mempool_chunk_alloc(BLI_mempool *pool)
 {
+  if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    void *alloc = MEM_mallocN(MEMPOOL_LARGE_CHUNK_ALLOC_SIZE, "BLI_Mempool Large Chunk");
+    BLI_mempool_chunk *mpchunk = (BLI_mempool_chunk *)(
+        ((uintptr_t)alloc + (MEMPOOL_LARGE_CHUNK_SIZE - 1)) &
+        ~(uintptr_t)(MEMPOOL_LARGE_CHUNK_SIZE - 1));
+    *CHUNK_LARGE_ALLOC_PTR(mpchunk) = alloc;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    /* Transparent huge pages are only used for such regions when the system is configured to
+     * use them on request (the "madvise" mode). */
+    madvise(mpchunk, MEMPOOL_LARGE_CHUNK_SIZE, MADV_HUGEPAGE);
+#endif
+    return mpchunk;
+  }
   return MEM_mallocN(sizeof(BLI_mempool_chunk) + (size_t)pool->csize, "BLI_Mempool Chunk");
 }
 
@@ -213,6 +273,15 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
   mpchunk->next = NULL;
   pool->chunk_tail = mpchunk;
 
+  if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    /* The elements are used from #BLI_mempool.bump_chunk when the free list is empty. */
+    memset(CHUNK_USED_BITMAP(pool, mpchunk), 0, BLI_BITMAP_SIZE(pool->pchunk));
+#ifdef USE_TOTALLOC
+    pool->totalloc += pool->pchunk;
+#endif
+    return last_tail;
+  }
+
   if (UNLIKELY(pool->free == NULL)) {
     pool->free = curnode;
   }
@@ -250,18 +319,22 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
   return curnode;
 }
 
-static void mempool_chunk_free(BLI_mempool_chunk *mpchunk)
+static void mempool_chunk_free(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
 {
+  if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    MEM_freeN(*CHUNK_LARGE_ALLOC_PTR(mpchunk));
+    return;
+  }
   MEM_freeN(mpchunk);
 }
 
-static void mempool_chunk_free_all(BLI_mempool_chunk *mpchunk)
+static void mempool_chunk_free_all(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
 {
   BLI_mempool_chunk *mpchunk_next;
 
   for (; mpchunk; mpchunk = mpchunk_next) {
     mpchunk_next = mpchunk->next;
-    mempool_chunk_free(mpchunk);
+    mempool_chunk_free(pool, mpchunk);
   }
 }
 
@@ -283,34 +356,48 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
     esize = MAX2(esize, (uint)sizeof(BLI_freenode));
   }
 
-  maxchunks = mempool_maxchunks(totelem, pchunk);
-
   pool->chunks = NULL;
   pool->chunk_tail = NULL;
   pool->esize = esize;
 
-  /* Optimize chunk size to powers of 2, accounting for slop-space. */
-#ifdef USE_CHUNK_POW2
-  {
-    BLI_assert(power_of_2_max_u(pchunk * esize) > CHUNK_OVERHEAD);
-    pchunk = (power_of_2_max_u(pchunk * esize) - CHUNK_OVERHEAD) / esize;
+  if (flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    /* As many elements as fit with their bitmap, the requested chunk size is ignored. */
+    const size_t chunk_data_size = MEMPOOL_LARGE_CHUNK_SIZE - sizeof(BLI_mempool_chunk) -
+                                   sizeof(void *);
+    pchunk = (uint)((chunk_data_size * 8) / ((size_t)esize * 8 + 1));
+    while ((size_t)pchunk * esize + BLI_BITMAP_SIZE(pchunk) > chunk_data_size) {
+      pchunk--;
+    }
+    pool->csize = esize * pchunk;
   }
+  else {
+    /* Optimize chunk size to powers of 2, accounting for slop-space. */
+#ifdef USE_CHUNK_POW2
+    {
+      BLI_assert(power_of_2_max_u(pchunk * esize) > CHUNK_OVERHEAD);
+      pchunk = (power_of_2_max_u(pchunk * esize) - CHUNK_OVERHEAD) / esize;
+    }
 #endif
 
-  pool->csize = esize * pchunk;
+    pool->csize = esize * pchunk;
 
-  /* Ensure this is a power of 2, minus the rounding by element size. */
+    /* Ensure this is a power of 2, minus the rounding by element size. */
 #if defined(USE_CHUNK_POW2) && !defined(NDEBUG)
-  {
-    uint final_size = (uint)MEM_SIZE_OVERHEAD + (uint)sizeof(BLI_mempool_chunk) + pool->csize;
-    BLI_assert(((uint)power_of_2_max_u(final_size) - final_size) < pool->esize);
-  }
+    {
+      uint final_size = (uint)MEM_SIZE_OVERHEAD + (uint)sizeof(BLI_mempool_chunk) + pool->csize;
+      BLI_assert(((uint)power_of_2_max_u(final_size) - final_size) < pool->esize);
+    }
 #endif
+  }
+
+  maxchunks = mempool_maxchunks(totelem, pchunk);
 
   pool->pchunk = pchunk;
   pool->flag = flag;
   pool->free = NULL; /* mempool_chunk_add assigns */
   pool->maxchunks = maxchunks;
+  pool->bump_chunk = NULL;
+  pool->bump_index = 0;
 #ifdef USE_TOTALLOC
   pool->totalloc = 0;
 #endif
@@ -331,10 +418,44 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   return pool;
 }
 
+/**
+ * Allocate the next element never used since the chunks were added or cleared.
+ */
+static void *mempool_large_alloc_bump(BLI_mempool *pool)
+{
+  if (pool->bump_chunk == NULL) {
+    pool->bump_chunk = pool->chunks;
+    pool->bump_index = 0;
+  }
+  if (pool->bump_chunk == NULL || pool->bump_index == pool->pchunk) {
+    BLI_mempool_chunk *mpchunk = pool->bump_chunk ? pool->bump_chunk->next : NULL;
+    if (mpchunk == NULL) {
+      mpchunk = mempool_chunk_alloc(pool);
+      mempool_chunk_add(pool, mpchunk, NULL);
+    }
+    pool->bump_chunk = mpchunk;
+    pool->bump_index = 0;
+  }
+
+  const uint index = pool->bump_index++;
+  BLI_BITMAP_ENABLE(CHUNK_USED_BITMAP(pool, pool->bump_chunk), index);
+  pool->totused++;
+
+  void *elem = POINTER_OFFSET(CHUNK_DATA(pool->bump_chunk), pool->esize * index);
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, elem, pool->esize);
+#endif
+  return elem;
+}
+
 void *BLI_mempool_alloc(BLI_mempool *pool)
 {
   BLI_freenode *free_pop;
 
+  if ((pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) && (pool->free == NULL)) {
+    return mempool_large_alloc_bump(pool);
+  }
+
   if (UNLIKELY(pool->free == NULL)) {
     /* Need to allocate a new chunk. */
     BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
@@ -345,7 +466,12 @@ void *BLI_mempool_alloc(BLI_mempool *pool)
 
   BLI_assert(pool->chunk_tail->next == NULL);
 
-  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+  if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    BLI_mempool_chunk *mpchunk = mempool_large_chunk_of_elem(free_pop);
+    BLI_BITMAP_ENABLE(CHUNK_USED_BITMAP(pool, mpchunk),
+                      mempool_large_chunk_elem_index(pool, mpchunk, free_pop));
+  }
+  else if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
     free_pop->freeword = USEDWORD;
   }
 
@@ -396,7 +522,15 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 #endif
 
-  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+  if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    BLI_mempool_chunk *mpchunk = mempool_large_chunk_of_elem(addr);
+    BLI_bitmap *used = CHUNK_USED_BITMAP(pool, mpchunk);
+    const uint index = mempool_large_chunk_elem_index(pool, mpchunk, addr);
+    /* This will detect double free's. */
+    BLI_assert(BLI_BITMAP_TEST(used, index));
+    BLI_BITMAP_DISABLE(used, index);
+  }
+  else if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
 #ifndef NDEBUG
     /* This will detect double free's. */
     BLI_assert(newhead->freeword != FREEWORD);
@@ -421,7 +555,7 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
     BLI_mempool_chunk *first;
 
     first = pool->chunks;
-    mempool_chunk_free_all(first->next);
+    mempool_chunk_free_all(pool, first->next);
     first->next = NULL;
     pool->chunk_tail = first;
 
@@ -429,6 +563,13 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
     pool->totalloc = pool->pchunk;
 #endif
 
+    if (pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+      /* The bitmap is already cleared. */
+      pool->free = NULL;
+      pool->bump_chunk = NULL;
+      return;
+    }
+
     /* Temp alloc so valgrind doesn't complain when setting free'd blocks 'next'. */
 #ifdef WITH_MEM_VALGRIND
     VALGRIND_MEMPOOL_ALLOC(pool, CHUNK_DATA(first), pool->csize);
@@ -456,6 +597,18 @@ int BLI_mempool_len(BLI_mempool *pool)
   return (int)pool->totused;
 }
 
+/**
+ * Number of elements the allocated chunks can hold, including the ones in use.
+ */
+int BLI_mempool_capacity(BLI_mempool *pool)
+{
+  uint chunks_len = 0;
+  for (BLI_mempool_chunk *mpchunk = pool->chunks; mpchunk; mpchunk = mpchunk->next) {
+    chunks_len++;
+  }
+  return (int)(chunks_len * pool->pchunk);
+}
+
 void *BLI_mempool_findelem(BLI_mempool *pool, uint index)
 {
   BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_ITER);
@@ -639,6 +792,51 @@ void *BLI_mempool_iterstep(BLI_mempool_iter *iter)
 
 /* optimized version of code above */
 
+static void mempool_iter_chunk_next(BLI_mempool_iter *iter)
+{
+  if (iter->curchunk_threaded_shared) {
+    BLI_mempool_chunk *mpchunk;
+    for (mpchunk = *iter->curchunk_threaded_shared;
+         (mpchunk != NULL) && (atomic_cas_ptr((void **)iter->curchunk_threaded_shared,
+                                              mpchunk,
+                                              mpchunk->next) != mpchunk);
+         mpchunk = *iter->curchunk_threaded_shared) {
+      /* pass. */
+    }
+    iter->curchunk = mpchunk ? mpchunk->next : NULL;
+  }
+  else {
+    iter->curchunk = iter->curchunk->next;
+  }
+}
+
+/**
+ * Step over a #BLI_MEMPOOL_LARGE_CHUNKS pool, the bitmaps of the chunks are used to skip the
+ * unused elements without reading them.
+ */
+static void *mempool_large_iterstep(BLI_mempool_iter *iter)
+{
+  const BLI_mempool *pool = iter->pool;
+
+  while (iter->curchunk != NULL) {
+    const BLI_bitmap *used = CHUNK_USED_BITMAP(pool, iter->curchunk);
+    uint index = iter->curindex;
+    while (index < pool->pchunk) {
+      const BLI_bitmap word = used[index >> _BITMAP_POWER] >> (index & _BITMAP_MASK);
+      if (word != 0) {
+        index += bitscan_forward_uint(word);
+        iter->curindex = index + 1;
+        return POINTER_OFFSET(CHUNK_DATA(iter->curchunk), pool->esize * index);
+      }
+      index = (index | _BITMAP_MASK) + 1;
+    }
+    mempool_iter_chunk_next(iter);
+    iter->curindex = 0;
+  }
+
+  return NULL;
+}
+
 /**
  * Step over the iterator, returning the mempool item or NULL.
  */
@@ -648,6 +846,10 @@ void *BLI_mempool_iterstep(BLI_mempool_iter *iter)
     return NULL;
   }
 
+  if (iter->pool->flag & BLI_MEMPOOL_LARGE_CHUNKS) {
+    return mempool_large_iterstep(iter);
+  }
+
   const uint esize = iter->pool->esize;
   BLI_freenode *curnode = POINTER_OFFSET(CHUNK_DATA(iter->curchunk), (esize * iter->curindex));
   BLI_freenode *ret;
@@ -722,13 +924,14 @@ void BLI_mempool_clear_ex(BLI_mempool *pool, const int totelem_reserve)
 
     do {
       mpchunk_next = mpchunk->next;
-      mempool_chunk_free(mpchunk);
+      mempool_chunk_free(pool, mpchunk);
     } while ((mpchunk = mpchunk_next));
   }
 
   /* re-initialize */
   pool->free = NULL;
   pool->totused = 0;
+  pool->bump_chunk = NULL;
 #ifdef USE_TOTALLOC
   pool->totalloc = 0;
 #endif
@@ -756,7 +959,7 @@ void BLI_mempool_clear(BLI_mempool *pool)
  */
 void BLI_mempool_destroy(BLI_mempool *pool)
 {
-  mempool_chunk_free_all(pool->chunks);
+  mempool_chunk_free_all(pool, pool->chunks);
 
 #ifdef WITH_MEM_VALGRIND
   VALGRIND_DESTROY_MEMPOOL(pool);
@@ -0,0 +1,255 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * The arrays are split in chunks of a fixed size rather than one chunk per thread, so that the
+ * results are the same whatever the number of threads.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "BLI_array.hh"
+#include "BLI_array_parallel.h"
+#include "BLI_task.hh"
+
+#include "atomic_ops.h"
+
+using blender::Array;
+using blender::IndexRange;
+using blender::parallel_for;
+
+/** Arrays smaller than this are processed on the calling thread. */
+static constexpr int serial_threshold = 1 << 14;
+
+static constexpr int scan_chunk_size = 1 << 13;
+static constexpr int sort_chunk_size = 1 << 16;
+
+static constexpr int radix_bits = 8;
+static constexpr int radix_size = 1 << radix_bits;
+
+static int chunks_num_get(const int len, const int chunk_size)
+{
+  return (len + chunk_size - 1) / chunk_size;
+}
+
+static IndexRange chunk_range_get(const int len, const int chunk_size, const int chunk)
+{
+  const int start = chunk * chunk_size;
+  return IndexRange(start, std::min(chunk_size, len - start));
+}
+
+static int exclusive_scan_serial(int *data, const int data_len, int sum)
+{
+  for (int i = 0; i < data_len; i++) {
+    const int value = data[i];
+    data[i] = sum;
+    sum += value;
+  }
+  return sum;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Exclusive Scan
+ * \{ */
+
+int BLI_array_exclusive_scan_i(int *data, const int data_len)
+{
+  if (data_len < serial_threshold) {
+    return exclusive_scan_serial(data, data_len, 0);
+  }
+
+  const int chunks_num = chunks_num_get(data_len, scan_chunk_size);
+  Array<int> chunk_sums(chunks_num);
+
+  parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      int sum = 0;
+      for (const int i : chunk_range_get(data_len, scan_chunk_size, chunk)) {
+        sum += data[i];
+      }
+      chunk_sums[chunk] = sum;
+    }
+  });
+
+  const int sum = exclusive_scan_serial(chunk_sums.data(), chunks_num, 0);
+
+  parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      const IndexRange range = chunk_range_get(data_len, scan_chunk_size, chunk);
+      exclusive_scan_serial(data + range.start(), (int)range.size(), chunk_sums[chunk]);
+    }
+  });
+
+  return sum;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Group Indices by Key
+ * \{ */
+
+void BLI_array_group_indices_by_key(const int *keys,
+                                    const int keys_len,
+                                    const int groups_len,
+                                    int *r_offsets,
+                                    int *r_indices)
+{
+  std::fill(r_offsets, r_offsets + groups_len + 1, 0);
+
+  if (keys_len < serial_threshold) {
+    for (int i = 0; i < keys_len; i++) {
+      if (keys[i] >= 0) {
+        r_offsets[keys[i]]++;
+      }
+    }
+    exclusive_scan_serial(r_offsets, groups_len + 1, 0);
+
+    Array<int> cursors(blender::Span<int>(r_offsets, groups_len));
+    for (int i = 0; i < keys_len; i++) {
+      if (keys[i] >= 0) {
+        r_indices[cursors[keys[i]]++] = i;
+      }
+    }
+    return;
+  }
+
+  parallel_for(IndexRange(keys_len), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (keys[i] >= 0) {
+        atomic_add_and_fetch_int32(&r_offsets[keys[i]], 1);
+      }
+    }
+  });
+
+  BLI_array_exclusive_scan_i(r_offsets, groups_len + 1);
+
+  Array<int> cursors(blender::Span<int>(r_offsets, groups_len));
+  parallel_for(IndexRange(keys_len), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (keys[i] >= 0) {
+        r_indices[atomic_fetch_and_add_int32(&cursors[keys[i]], 1)] = i;
+      }
+    }
+  });
+
+  /* The order within the groups depends on the threads until here. Groups are usually small,
+   * sorting them is cheaper than counting per chunk of keys. */
+  parallel_for(IndexRange(groups_len), 4096, [&](const IndexRange range) {
+    for (const int group : range) {
+      std::sort(r_indices + r_offsets[group], r_indices + r_offsets[group + 1]);
+    }
+  });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Radix Sort
+ *
+ * Least significant digit first, every pass is a stable counting sort of the indices by one
+ * digit of their key. The histograms are per chunk, and the chunks of a digit are placed in
+ * order, which keeps the sort stable when the chunks are processed in parallel.
+ * \{ */
+
+void BLI_array_sort_indices_by_key_u64(const uint64_t *keys, const int keys_len, int *r_indices)
+{
+  for (int i = 0; i < keys_len; i++) {
+    r_indices[i] = i;
+  }
+
+  if (keys_len < serial_threshold) {
+    std::stable_sort(r_indices, r_indices + keys_len, [&](const int a, const int b) {
+      return keys[a] < keys[b];
+    });
+    return;
+  }
+
+  const int chunks_num = chunks_num_get(keys_len, sort_chunk_size);
+
+  /* Digits that are the same for all keys don't change the order, skip their pass. */
+  Array<uint64_t> chunk_bits_or(chunks_num);
+  Array<uint64_t> chunk_bits_and(chunks_num);
+  parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      uint64_t bits_or = 0, bits_and = UINT64_MAX;
+      for (const int i : chunk_range_get(keys_len, sort_chunk_size, chunk)) {
+        bits_or |= keys[i];
+        bits_and &= keys[i];
+      }
+      chunk_bits_or[chunk] = bits_or;
+      chunk_bits_and[chunk] = bits_and;
+    }
+  });
+  uint64_t bits_or = 0, bits_and = UINT64_MAX;
+  for (const int chunk : IndexRange(chunks_num)) {
+    bits_or |= chunk_bits_or[chunk];
+    bits_and &= chunk_bits_and[chunk];
+  }
+  const uint64_t varying_bits = bits_or ^ bits_and;
+
+  Array<int> buffer(keys_len);
+  Array<int> histograms(chunks_num * radix_size);
+  int *src = r_indices;
+  int *dst = buffer.data();
+
+  for (int shift = 0; shift < 64; shift += radix_bits) {
+    if (((varying_bits >> shift) & (radix_size - 1)) == 0) {
+      continue;
+    }
+
+    parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int chunk : chunks) {
+        int *histogram = &histograms[chunk * radix_size];
+        std::fill(histogram, histogram + radix_size, 0);
+        for (const int i : chunk_range_get(keys_len, sort_chunk_size, chunk)) {
+          histogram[(keys[src[i]] >> shift) & (radix_size - 1)]++;
+        }
+      }
+    });
+
+    /* Offset of every digit of every chunk, digit major. */
+    int offset = 0;
+    for (const int digit : IndexRange(radix_size)) {
+      for (const int chunk : IndexRange(chunks_num)) {
+        int &value = histograms[chunk * radix_size + digit];
+        const int count = value;
+        value = offset;
+        offset += count;
+      }
+    }
+
+    parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int chunk : chunks) {
+        int *cursors = &histograms[chunk * radix_size];
+        for (const int i : chunk_range_get(keys_len, sort_chunk_size, chunk)) {
+          dst[cursors[(keys[src[i]] >> shift) & (radix_size - 1)]++] = src[i];
+        }
+      }
+    });
+
+    std::swap(src, dst);
+  }
+
+  if (src != r_indices) {
+    memcpy(r_indices, src, sizeof(int) * (size_t)keys_len);
+  }
+}
+
+/** \} */
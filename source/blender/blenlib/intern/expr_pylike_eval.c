@@ -29,14 +29,17 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
- *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      abs, fabs, floor, ceil, trunc, round, int, float, bool,
+ *      sin, cos, tan, asin, acos, atan, atan2, hypot,
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log, log2, log10, log1p, sqrt, pow, fmod, copysign,
+ *      lerp, clamp, smoothstep
+ *  - Functions and constants of the math module can be prefixed with `math.`.
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -315,6 +318,23 @@ static double op_div(double a, double b)
   return a / b;
 }
 
+static double op_floordiv(double a, double b)
+{
+  return floor(a / b);
+}
+
+/* Python modulo, the result has the sign of the divisor. */
+static double op_mod(double a, double b)
+{
+  double result = fmod(a, b);
+
+  if (result != 0.0 && (result < 0.0) != (b < 0.0)) {
+    result += b;
+  }
+
+  return result;
+}
+
 static double op_add(double a, double b)
 {
   return a + b;
@@ -364,6 +384,16 @@ static double op_smoothstep(double a, double b, double x)
   return t * t * (3.0 - 2.0 * t);
 }
 
+static double op_identity(double a)
+{
+  return a;
+}
+
+static double op_bool(double a)
+{
+  return a ? 1.0 : 0.0;
+}
+
 static double op_not(double a)
 {
   return a ? 0.0 : 1.0;
@@ -402,15 +432,25 @@ static double op_ge(double a, double b)
 typedef struct BuiltinConstDef {
   const char *name;
   double value;
+  /* Also accessible with the `math.` prefix. */
+  bool in_math;
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI, true},
+    {"e", M_E, true},
+    {"tau", 2.0 * M_PI, true},
+    {"True", 1.0, false},
+    {"False", 0.0, false},
+    {NULL, 0.0, false},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
   eOpCode op;
   void *funcptr;
+  /* Also accessible with the `math.` prefix. */
+  bool in_math;
 } BuiltinOpDef;
 
 #ifdef _MSC_VER
@@ -421,33 +461,47 @@ typedef struct BuiltinOpDef {
 #endif
 
 static BuiltinOpDef builtin_ops[] = {
-    {"radians", OPCODE_FUNC1, op_radians},
-    {"degrees", OPCODE_FUNC1, op_degrees},
-    {"abs", OPCODE_FUNC1, fabs},
-    {"fabs", OPCODE_FUNC1, fabs},
-    {"floor", OPCODE_FUNC1, floor},
-    {"ceil", OPCODE_FUNC1, ceil},
-    {"trunc", OPCODE_FUNC1, trunc},
-    {"round", OPCODE_FUNC1, round},
-    {"int", OPCODE_FUNC1, trunc},
-    {"sin", OPCODE_FUNC1, sin},
-    {"cos", OPCODE_FUNC1, cos},
-    {"tan", OPCODE_FUNC1, tan},
-    {"asin", OPCODE_FUNC1, asin},
-    {"acos", OPCODE_FUNC1, acos},
-    {"atan", OPCODE_FUNC1, atan},
-    {"atan2", OPCODE_FUNC2, atan2},
-    {"exp", OPCODE_FUNC1, exp},
-    {"log", OPCODE_FUNC1, log},
-    {"log", OPCODE_FUNC2, op_log2},
-    {"sqrt", OPCODE_FUNC1, sqrt},
-    {"pow", OPCODE_FUNC2, pow},
-    {"fmod", OPCODE_FUNC2, fmod},
-    {"lerp", OPCODE_FUNC3, op_lerp},
-    {"clamp", OPCODE_FUNC1, op_clamp},
-    {"clamp", OPCODE_FUNC3, op_clamp3},
-    {"smoothstep", OPCODE_FUNC3, op_smoothstep},
-    {NULL, OPCODE_CONST, NULL},
+    {"radians", OPCODE_FUNC1, op_radians, true},
+    {"degrees", OPCODE_FUNC1, op_degrees, true},
+    {"abs", OPCODE_FUNC1, fabs, false},
+    {"fabs", OPCODE_FUNC1, fabs, true},
+    {"floor", OPCODE_FUNC1, floor, true},
+    {"ceil", OPCODE_FUNC1, ceil, true},
+    {"trunc", OPCODE_FUNC1, trunc, true},
+    {"round", OPCODE_FUNC1, round, false},
+    {"int", OPCODE_FUNC1, trunc, false},
+    {"float", OPCODE_FUNC1, op_identity, false},
+    {"bool", OPCODE_FUNC1, op_bool, false},
+    {"sin", OPCODE_FUNC1, sin, true},
+    {"cos", OPCODE_FUNC1, cos, true},
+    {"tan", OPCODE_FUNC1, tan, true},
+    {"asin", OPCODE_FUNC1, asin, true},
+    {"acos", OPCODE_FUNC1, acos, true},
+    {"atan", OPCODE_FUNC1, atan, true},
+    {"atan2", OPCODE_FUNC2, atan2, true},
+    {"hypot", OPCODE_FUNC2, hypot, true},
+    {"sinh", OPCODE_FUNC1, sinh, true},
+    {"cosh", OPCODE_FUNC1, cosh, true},
+    {"tanh", OPCODE_FUNC1, tanh, true},
+    {"asinh", OPCODE_FUNC1, asinh, true},
+    {"acosh", OPCODE_FUNC1, acosh, true},
+    {"atanh", OPCODE_FUNC1, atanh, true},
+    {"exp", OPCODE_FUNC1, exp, true},
+    {"expm1", OPCODE_FUNC1, expm1, true},
+    {"log", OPCODE_FUNC1, log, true},
+    {"log", OPCODE_FUNC2, op_log2, true},
+    {"log2", OPCODE_FUNC1, log2, true},
+    {"log10", OPCODE_FUNC1, log10, true},
+    {"log1p", OPCODE_FUNC1, log1p, true},
+    {"sqrt", OPCODE_FUNC1, sqrt, true},
+    {"pow", OPCODE_FUNC2, pow, true},
+    {"fmod", OPCODE_FUNC2, fmod, true},
+    {"copysign", OPCODE_FUNC2, copysign, true},
+    {"lerp", OPCODE_FUNC3, op_lerp, false},
+    {"clamp", OPCODE_FUNC1, op_clamp, false},
+    {"clamp", OPCODE_FUNC3, op_clamp3, false},
+    {"smoothstep", OPCODE_FUNC3, op_smoothstep, false},
+    {NULL, OPCODE_CONST, NULL, false},
 };
 
 /** \} */
@@ -472,6 +526,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_LE MAKE_CHAR2('<', '=')
 #define TOKEN_NE MAKE_CHAR2('!', '=')
 #define TOKEN_EQ MAKE_CHAR2('=', '=')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 #define TOKEN_AND MAKE_CHAR2('A', 'N')
 #define TOKEN_OR MAKE_CHAR2('O', 'R')
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
@@ -720,6 +776,13 @@ static bool parse_next_token(ExprParseState *state)
     return true;
   }
 
+  /* Double character operators. */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* Special characters (single character tokens) */
   if (strchr(token_characters, *state->cur)) {
     state->token = *state->cur++;
@@ -757,6 +820,7 @@ static bool parse_next_token(ExprParseState *state)
  * \{ */
 
 static bool parse_expr(ExprParseState *state);
+static bool parse_unary(ExprParseState *state);
 
 static int parse_function_args(ExprParseState *state)
 {
@@ -792,19 +856,72 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+/* Parse a call to one of the builtin functions, or look up a builtin constant. */
+static bool parse_builtin(ExprParseState *state, bool math_prefix)
 {
   int i;
 
-  switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
+  /* Ordinary builtin constants. */
+  for (i = 0; builtin_consts[i].name; i++) {
+    if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
+      CHECK_ERROR(builtin_consts[i].in_math || !math_prefix);
 
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
+      parse_add_op(state, OPCODE_CONST, 1)->arg.dval = builtin_consts[i].value;
+      return parse_next_token(state);
+    }
+  }
+
+  /* Ordinary builtin functions. */
+  for (i = 0; builtin_ops[i].name; i++) {
+    if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
+      CHECK_ERROR(builtin_ops[i].in_math || !math_prefix);
+
+      int args = parse_function_args(state);
+
+      /* Search for other arg count versions if necessary. */
+      if (args != opcode_arg_count(builtin_ops[i].op)) {
+        for (int j = i + 1; builtin_ops[j].name; j++) {
+          if (opcode_arg_count(builtin_ops[j].op) == args &&
+              STREQ(builtin_ops[j].name, builtin_ops[i].name)) {
+            i = j;
+            break;
+          }
+        }
+      }
+
+      return parse_add_func(state, builtin_ops[i].op, args, builtin_ops[i].funcptr);
+    }
+  }
+
+  /* Specially supported functions. */
+  if (math_prefix) {
+    return false;
+  }
+
+  if (STREQ(state->tokenbuf, "min")) {
+    int cnt = parse_function_args(state);
+    CHECK_ERROR(cnt > 0);
+
+    parse_add_op(state, OPCODE_MIN, 1 - cnt)->arg.ival = cnt;
+    return true;
+  }
+
+  if (STREQ(state->tokenbuf, "max")) {
+    int cnt = parse_function_args(state);
+    CHECK_ERROR(cnt > 0);
+
+    parse_add_op(state, OPCODE_MAX, 1 - cnt)->arg.ival = cnt;
+    return true;
+  }
+
+  return false;
+}
+
+static bool parse_primary(ExprParseState *state)
+{
+  int i;
 
+  switch (state->token) {
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -823,55 +940,48 @@ static bool parse_unary(ExprParseState *state)
         }
       }
 
-      /* Ordinary builtin constants. */
-      for (i = 0; builtin_consts[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
-          parse_add_op(state, OPCODE_CONST, 1)->arg.dval = builtin_consts[i].value;
-          return parse_next_token(state);
-        }
+      /* Qualified names from the math module, e.g. `math.sin(x)`. */
+      if (STREQ(state->tokenbuf, "math")) {
+        CHECK_ERROR(parse_next_token(state) && state->token == '.');
+        CHECK_ERROR(parse_next_token(state) && state->token == TOKEN_ID);
+
+        return parse_builtin(state, true);
       }
 
-      /* Ordinary builtin functions. */
-      for (i = 0; builtin_ops[i].name; i++) {
-        if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
-          int args = parse_function_args(state);
-
-          /* Search for other arg count versions if necessary. */
-          if (args != opcode_arg_count(builtin_ops[i].op)) {
-            for (int j = i + 1; builtin_ops[j].name; j++) {
-              if (opcode_arg_count(builtin_ops[j].op) == args &&
-                  STREQ(builtin_ops[j].name, builtin_ops[i].name)) {
-                i = j;
-                break;
-              }
-            }
-          }
+      return parse_builtin(state, false);
 
-          return parse_add_func(state, builtin_ops[i].op, args, builtin_ops[i].funcptr);
-        }
-      }
+    default:
+      return false;
+  }
+}
 
-      /* Specially supported functions. */
-      if (STREQ(state->tokenbuf, "min")) {
-        int cnt = parse_function_args(state);
-        CHECK_ERROR(cnt > 0);
+/* The power operator binds tighter than unary operators on its left,
+ * but not on its right: `-2 ** -2` is `-(2 ** (-2))`. */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
 
-        parse_add_op(state, OPCODE_MIN, 1 - cnt)->arg.ival = cnt;
-        return true;
-      }
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
 
-      if (STREQ(state->tokenbuf, "max")) {
-        int cnt = parse_function_args(state);
-        CHECK_ERROR(cnt > 0);
+  return true;
+}
 
-        parse_add_op(state, OPCODE_MAX, 1 - cnt)->arg.ival = cnt;
-        return true;
-      }
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
 
-      return false;
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
 
     default:
-      return false;
+      return parse_power(state);
   }
 }
 
@@ -891,6 +1001,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -145,19 +146,15 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Move the median node along \a axis to the middle of \a nodes,
+ * with the smaller nodes before it and the larger after it.
+ */
+static uint kdtree_balance_partition(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
   /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
@@ -190,6 +187,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_partition(nodes, nodes_len, axis);
+
   /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
@@ -201,6 +215,91 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Multi-Threaded Balance
+ *
+ * The first levels of the tree are balanced on the calling thread, the subtrees below them are
+ * independent and balanced in parallel. The resulting tree is the same as #kdtree_balance.
+ * \{ */
+
+/** Number of levels balanced before the subtrees, up to `1 << depth` subtrees. */
+#define KD_BALANCE_PARALLEL_DEPTH 6
+/** Trees with fewer nodes are balanced on the calling thread. */
+#define KD_BALANCE_PARALLEL_MIN 10000
+
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+} KDTreeBalanceTask;
+
+static uint kdtree_balance_split(KDTreeNode *nodes,
+                                 uint nodes_len,
+                                 uint axis,
+                                 const uint ofs,
+                                 const uint depth,
+                                 KDTreeBalanceTask *tasks,
+                                 uint *tasks_len)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (depth == 0 || nodes_len == 1) {
+    KDTreeBalanceTask *task = &tasks[(*tasks_len)++];
+    task->nodes = nodes;
+    task->nodes_len = nodes_len;
+    task->axis = axis;
+    task->ofs = ofs;
+    /* Known before balancing, the median is always the middle node. */
+    return nodes_len / 2 + ofs;
+  }
+
+  median = kdtree_balance_partition(nodes, nodes_len, axis);
+
+  node = &nodes[median];
+  node->d = axis;
+  axis = (axis + 1) % KD_DIMS;
+  node->left = kdtree_balance_split(nodes, median, axis, ofs, depth - 1, tasks, tasks_len);
+  node->right = kdtree_balance_split(nodes + median + 1,
+                                     (nodes_len - (median + 1)),
+                                     axis,
+                                     (median + 1) + ofs,
+                                     depth - 1,
+                                     tasks,
+                                     tasks_len);
+
+  return median + ofs;
+}
+
+static void kdtree_balance_task_cb(void *__restrict userdata,
+                                   const int task_index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBalanceTask *task = &((const KDTreeBalanceTask *)userdata)[task_index];
+  kdtree_balance(task->nodes, task->nodes_len, task->axis, task->ofs);
+}
+
+static uint kdtree_balance_parallel(KDTreeNode *nodes, uint nodes_len)
+{
+  KDTreeBalanceTask tasks[1 << KD_BALANCE_PARALLEL_DEPTH];
+  uint tasks_len = 0;
+  const uint root = kdtree_balance_split(
+      nodes, nodes_len, 0, 0, KD_BALANCE_PARALLEL_DEPTH, tasks, &tasks_len);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, (int)tasks_len, tasks, kdtree_balance_task_cb, &settings);
+
+  return root;
+}
+
+/** \} */
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +309,12 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_PARALLEL_MIN) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
+  else {
+    tree->root = kdtree_balance_parallel(tree->nodes, tree->nodes_len);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -806,6 +910,131 @@ finally:
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ *
+ * Run many searches at once, split over threads. Contiguous ranges of queries run on the same
+ * thread, so queries that are close to each other in the array share the cached nodes.
+ * \{ */
+
+/** Batches with fewer queries are searched on the calling thread. */
+#define KD_BATCH_PARALLEL_MIN 1000
+
+struct KDTreeFindNearestBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  int *r_index;
+  KDTreeNearest *r_nearest;
+};
+
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int co_index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct KDTreeFindNearestBatchData *data = userdata;
+  const int index = BLI_kdtree_nd_(find_nearest)(
+      data->tree, data->co[co_index], data->r_nearest ? &data->r_nearest[co_index] : NULL);
+  if (data->r_index) {
+    data->r_index[co_index] = index;
+  }
+}
+
+/**
+ * Run #BLI_kdtree_3d_find_nearest for every coordinate of \a co.
+ *
+ * \param r_index: When not NULL, the nearest index of every coordinate, -1 if not found.
+ * \param r_nearest: When not NULL, the nearest node of every coordinate.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest)
+{
+  struct KDTreeFindNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .r_index = r_index,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_BATCH_PARALLEL_MIN);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_cb, &settings);
+}
+
+struct KDTreeRangeSearchBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  float range;
+  bool (*search_cb)(
+      void *user_data, int co_index, int index, const float co[KD_DIMS], float dist_sq);
+  void *user_data;
+};
+
+/** Passes the index of the query to the callback of the batch. */
+struct KDTreeRangeSearchBatchQuery {
+  const struct KDTreeRangeSearchBatchData *data;
+  int co_index;
+};
+
+static bool kdtree_range_search_batch_query_cb(void *user_data,
+                                               int index,
+                                               const float co[KD_DIMS],
+                                               float dist_sq)
+{
+  const struct KDTreeRangeSearchBatchQuery *query = user_data;
+  return query->data->search_cb(query->data->user_data, query->co_index, index, co, dist_sq);
+}
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int co_index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct KDTreeRangeSearchBatchData *data = userdata;
+  struct KDTreeRangeSearchBatchQuery query = {
+      .data = data,
+      .co_index = co_index,
+  };
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, data->co[co_index], data->range, kdtree_range_search_batch_query_cb, &query);
+}
+
+/**
+ * Run #BLI_kdtree_3d_range_search_cb for every coordinate of \a co.
+ *
+ * \param search_cb: Called for every node in \a range of the coordinate at \a co_index,
+ * false return value ends the search of this coordinate.
+ *
+ * \note The callback runs on multiple threads, but never at the same time for the same
+ * \a co_index.
+ */
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    const uint co_len,
+    float range,
+    bool (*search_cb)(
+        void *user_data, int co_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data)
+{
+  struct KDTreeRangeSearchBatchData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .search_cb = search_cb,
+      .user_data = user_data,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_BATCH_PARALLEL_MIN);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
@@ -866,6 +1095,53 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/**
+ * Check if there is another node than \a search_node in range of its coordinates,
+ * uses the same bounds as #deduplicate_recursive.
+ */
+static bool deduplicate_has_neighbor_recursive(const KDTreeNode *nodes,
+                                               const float range,
+                                               const float range_sq,
+                                               const KDTreeNode *search_node,
+                                               uint i)
+{
+  const KDTreeNode *node = &nodes[i];
+  const float *search_co = search_node->co;
+  if (search_co[node->d] + range <= node->co[node->d]) {
+    return (node->left != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(nodes, range, range_sq, search_node, node->left);
+  }
+  if (search_co[node->d] - range >= node->co[node->d]) {
+    return (node->right != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(nodes, range, range_sq, search_node, node->right);
+  }
+  if ((node != search_node) && (len_squared_vnvn(node->co, search_co) <= range_sq)) {
+    return true;
+  }
+  return ((node->left != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(nodes, range, range_sq, search_node, node->left)) ||
+         ((node->right != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(nodes, range, range_sq, search_node, node->right));
+}
+
+struct DeDuplicateNeighborData {
+  const KDTree *tree;
+  float range;
+  float range_sq;
+  /* Indexed by node, not by #KDTreeNode.index. */
+  bool *has_neighbor;
+};
+
+static void deduplicate_has_neighbor_cb(void *__restrict userdata,
+                                        const int node_index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct DeDuplicateNeighborData *data = userdata;
+  const KDTreeNode *nodes = data->tree->nodes;
+  data->has_neighbor[node_index] = deduplicate_has_neighbor_recursive(
+      nodes, data->range, data->range_sq, &nodes[node_index], data->tree->root);
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -898,11 +1174,32 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
+  /* Searching for the duplicates depends on the previous searches, but most points usually
+   * have no duplicate at all. Find those in parallel first, they can be skipped since they are
+   * neither merged nor used as a target. */
+  bool *has_neighbor = MEM_mallocN(sizeof(*has_neighbor) * tree->nodes_len, __func__);
+  {
+    struct DeDuplicateNeighborData data = {
+        .tree = tree,
+        .range = range,
+        .range_sq = p.range_sq,
+        .has_neighbor = has_neighbor,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (tree->nodes_len > 10000);
+    BLI_task_parallel_range(
+        0, (int)tree->nodes_len, &data, deduplicate_has_neighbor_cb, &settings);
+  }
+
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = order[i];
       const int index = (int)i;
+      if (!has_neighbor[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -920,6 +1217,9 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = i;
       const int index = p.nodes[node_index].index;
+      if (!has_neighbor[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -932,6 +1232,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+  MEM_freeN(has_neighbor);
   return found;
 }
 
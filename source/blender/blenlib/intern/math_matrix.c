@@ -739,6 +739,41 @@ void mul_m4_v3(const float M[4][4], float r[3])
   r[2] = x * M[0][2] + y * M[1][2] + M[2][2] * r[2] + M[3][2];
 }
 
+void mul_m4_v3_array(const float M[4][4], float (*r_arr)[3], const int nbr)
+{
+  mul_m4_v3_array_stride(M, (float *)r_arr, nbr, sizeof(*r_arr));
+}
+
+/**
+ * Same as #mul_m4_v3 on \a nbr vectors separated by \a stride bytes, for example the
+ * coordinates of an array of structs. The results are exactly the same.
+ */
+void mul_m4_v3_array_stride(const float M[4][4], float *r_arr, const int nbr, const size_t stride)
+{
+  char *r_ptr = (char *)r_arr;
+#ifdef __SSE2__
+  const __m128 M0 = _mm_loadu_ps(M[0]);
+  const __m128 M1 = _mm_loadu_ps(M[1]);
+  const __m128 M2 = _mm_loadu_ps(M[2]);
+  const __m128 M3 = _mm_loadu_ps(M[3]);
+
+  for (int i = 0; i < nbr; i++, r_ptr += stride) {
+    float *r = (float *)r_ptr;
+    /* Same order of operations as the scalar version. */
+    const __m128 x = _mm_mul_ps(_mm_set1_ps(r[0]), M0);
+    const __m128 y = _mm_mul_ps(_mm_set1_ps(r[1]), M1);
+    const __m128 z = _mm_mul_ps(M2, _mm_set1_ps(r[2]));
+    const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(x, y), z), M3);
+    _mm_storel_pi((__m64 *)r, sum);
+    _mm_store_ss(r + 2, _mm_movehl_ps(sum, sum));
+  }
+#else
+  for (int i = 0; i < nbr; i++, r_ptr += stride) {
+    mul_m4_v3(M, (float *)r_ptr);
+  }
+#endif
+}
+
 void mul_v3_m4v3(float r[3], const float mat[4][4], const float vec[3])
 {
   const float x = vec[0];
@@ -1038,9 +1038,48 @@ void minmax_v2v2_v2(float min[2], float max[2], const float vec[2])
 
 void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)[3], int nbr)
 {
-  while (nbr--) {
-    minmax_v3v3_v3(r_min, r_max, *vec_arr++);
-  }
+  minmax_v3v3_v3_array_stride(r_min, r_max, (const float *)vec_arr, nbr, sizeof(*vec_arr));
+}
+
+#ifdef __SSE2__
+/* Load a 3D vector without reading past its end, the last component is zero. */
+BLI_INLINE __m128 load_v3_sse(const float v[3])
+{
+  return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)v), _mm_load_ss(v + 2));
+}
+
+BLI_INLINE void store_v3_sse(float r[3], const __m128 v)
+{
+  _mm_storel_pi((__m64 *)r, v);
+  _mm_store_ss(r + 2, _mm_movehl_ps(v, v));
+}
+#endif
+
+/**
+ * Same as #minmax_v3v3_v3_array, for vectors separated by \a stride bytes, for example the
+ * coordinates of an array of structs.
+ */
+void minmax_v3v3_v3_array_stride(
+    float r_min[3], float r_max[3], const float *vec_arr, int nbr, const size_t stride)
+{
+  const char *vec_ptr = (const char *)vec_arr;
+#ifdef __SSE2__
+  /* The current minimum is the second operand, so that NaN components are skipped like with
+   * #minmax_v3v3_v3. */
+  __m128 min = load_v3_sse(r_min);
+  __m128 max = load_v3_sse(r_max);
+  for (; nbr > 0; nbr--, vec_ptr += stride) {
+    const __m128 vec = load_v3_sse((const float *)vec_ptr);
+    min = _mm_min_ps(vec, min);
+    max = _mm_max_ps(vec, max);
+  }
+  store_v3_sse(r_min, min);
+  store_v3_sse(r_max, max);
+#else
+  for (; nbr > 0; nbr--, vec_ptr += stride) {
+    minmax_v3v3_v3(r_min, r_max, (const float *)vec_ptr);
+  }
+#endif
 }
 
 /** ensure \a v1 is \a dist from \a v2 */
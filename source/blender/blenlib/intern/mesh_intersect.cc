@@ -1255,14 +1255,57 @@ static inline mpq3 tti_interp(const mpq3 &a, const mpq3 &b, const mpq3 &c, const
 }
 
 /**
- * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
- * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
+ * Index of `dot(d - a, cross(b - a, c - a))` when the input coordinates have index 1:
+ * the differences have index 2, the cross product coordinates 6 and the dot product 11.
  */
-static inline int tti_above(const mpq3 &a, const mpq3 &b, const mpq3 &c, const mpq3 &ad)
+constexpr int index_tti_above = 11;
+
+/**
+ * Return the approximate sign of `dot(d - a, cross(b - a, c - a))`, or 0 if it can not be
+ * decided with double arithmetic. See #filter_plane_side.
+ */
+static int filter_tti_above(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
 {
-  mpq3 n = mpq3::cross(b - a, c - a);
-  return sgn(mpq3::dot(ad, n));
+  const double3 ba = b - a;
+  const double3 ca = c - a;
+  const double3 da = d - a;
+  const double det = double3::dot(da, double3::cross_high_precision(ba, ca));
+  if (det == 0.0) {
+    return 0;
+  }
+  const double3 abs_a = double3::abs(a);
+  const double3 abs_ba = abs_a + double3::abs(b);
+  const double3 abs_ca = abs_a + double3::abs(c);
+  const double3 abs_da = abs_a + double3::abs(d);
+  /* Cross product using absolute values and always using + instead of -. */
+  const double3 abs_n(abs_ba[1] * abs_ca[2] + abs_ba[2] * abs_ca[1],
+                      abs_ba[2] * abs_ca[0] + abs_ba[0] * abs_ca[2],
+                      abs_ba[0] * abs_ca[1] + abs_ba[1] * abs_ca[0]);
+  const double supremum = double3::dot(abs_da, abs_n);
+  const double err_bound = supremum * index_tti_above * DBL_EPSILON;
+  if (fabs(det) > err_bound) {
+    return det > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
+/**
+ * Return +1, 0, -1 as d is above, on, or below the oriented plane containing a, b, c in CCW
+ * order. This is the same as -oriented(a, b, c, d), but uses fewer arithmetic operations.
+ * Exact arithmetic is only used when the floating point filter can not decide.
+ */
+static inline int tti_above(const Vert *a, const Vert *b, const Vert *c, const Vert *d)
+{
+  const int filter_side = filter_tti_above(a->co, b->co, c->co, d->co);
+  if (filter_side != 0) {
+#  ifdef PERFDEBUG
+    incperfcount(5); /* Tri tri above tests decided by filter. */
+#  endif
+    return filter_side;
+  }
+  const mpq3 &a_exact = a->co_exact;
+  mpq3 n = mpq3::cross(b->co_exact - a_exact, c->co_exact - a_exact);
+  return sgn(mpq3::dot(d->co_exact - a_exact, n));
 }
 
 /**
@@ -1278,48 +1321,49 @@ static inline int tti_above(const mpq3 &a, const mpq3 &b, const mpq3 &c, const m
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
   constexpr int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "\ntri_tri_intersect_canon:\n";
-    std::cout << "p1=" << p1 << " q1=" << q1 << " r1=" << r1 << "\n";
-    std::cout << "p2=" << p2 << " q2=" << q2 << " r2=" << r2 << "\n";
+    std::cout << "p1=" << p1->co_exact << " q1=" << q1->co_exact << " r1=" << r1->co_exact
+              << "\n";
+    std::cout << "p2=" << p2->co_exact << " q2=" << q2->co_exact << " r2=" << r2->co_exact
+              << "\n";
     std::cout << "n1=" << n1 << " n2=" << n2 << "\n";
     std::cout << "approximate values:\n";
-    std::cout << "p1=(" << p1[0].get_d() << "," << p1[1].get_d() << "," << p1[2].get_d() << ")\n";
-    std::cout << "q1=(" << q1[0].get_d() << "," << q1[1].get_d() << "," << q1[2].get_d() << ")\n";
-    std::cout << "r1=(" << r1[0].get_d() << "," << r1[1].get_d() << "," << r1[2].get_d() << ")\n";
-    std::cout << "p2=(" << p2[0].get_d() << "," << p2[1].get_d() << "," << p2[2].get_d() << ")\n";
-    std::cout << "q2=(" << q2[0].get_d() << "," << q2[1].get_d() << "," << q2[2].get_d() << ")\n";
-    std::cout << "r2=(" << r2[0].get_d() << "," << r2[1].get_d() << "," << r2[2].get_d() << ")\n";
+    std::cout << "p1=(" << p1->co[0] << "," << p1->co[1] << "," << p1->co[2] << ")\n";
+    std::cout << "q1=(" << q1->co[0] << "," << q1->co[1] << "," << q1->co[2] << ")\n";
+    std::cout << "r1=(" << r1->co[0] << "," << r1->co[1] << "," << r1->co[2] << ")\n";
+    std::cout << "p2=(" << p2->co[0] << "," << p2->co[1] << "," << p2->co[2] << ")\n";
+    std::cout << "q2=(" << q2->co[0] << "," << q2->co[1] << "," << q2->co[2] << ")\n";
+    std::cout << "r2=(" << r2->co[0] << "," << r2->co[1] << "," << r2->co[2] << ")\n";
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
   mpq3 intersect_1;
   mpq3 intersect_2;
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2) > 0) {
+  if (tti_above(p1, q1, r2, p2) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2) <= 0) {
+    if (tti_above(p1, r1, r2, p2) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2) > 0) {
+      if (tti_above(p1, r1, q2, p2) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
         }
         /* i is intersect with p1r1. l is intersect with p2r2. */
-        intersect_1 = tti_interp(p1, r1, p2, n2);
-        intersect_2 = tti_interp(p2, r2, p1, n1);
+        intersect_1 = tti_interp(p1->co_exact, r1->co_exact, p2->co_exact, n2);
+        intersect_2 = tti_interp(p2->co_exact, r2->co_exact, p1->co_exact, n1);
       }
       else {
         /* Overlap is [i [k l] j]. */
@@ -1327,8 +1371,8 @@ static ITT_value itt_canon2(const mpq3 &p1,
           std::cout << "overlap [i [k l] j]\n";
         }
         /* k is intersect with p2q2. l is intersect is p2r2. */
-        intersect_1 = tti_interp(p2, q2, p1, n1);
-        intersect_2 = tti_interp(p2, r2, p1, n1);
+        intersect_1 = tti_interp(p2->co_exact, q2->co_exact, p1->co_exact, n1);
+        intersect_2 = tti_interp(p2->co_exact, r2->co_exact, p1->co_exact, n1);
       }
     }
     else {
@@ -1341,7 +1385,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2) < 0) {
+    if (tti_above(p1, q1, q2, p2) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1350,14 +1394,14 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2) >= 0) {
+      if (tti_above(p1, r1, q2, p2) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
         }
         /* i is intersect with p1r1. j is intersect with p1q1. */
-        intersect_1 = tti_interp(p1, r1, p2, n2);
-        intersect_2 = tti_interp(p1, q1, p2, n2);
+        intersect_1 = tti_interp(p1->co_exact, r1->co_exact, p2->co_exact, n2);
+        intersect_2 = tti_interp(p1->co_exact, q1->co_exact, p2->co_exact, n2);
       }
       else {
         /* Overlap is [i [k j] l]. */
@@ -1365,8 +1409,8 @@ static ITT_value itt_canon2(const mpq3 &p1,
           std::cout << "overlap [i [k j] l]\n";
         }
         /* k is intersect with p2q2. j is intersect with p1q1. */
-        intersect_1 = tti_interp(p2, q2, p1, n1);
-        intersect_2 = tti_interp(p1, q1, p2, n2);
+        intersect_1 = tti_interp(p2->co_exact, q2->co_exact, p1->co_exact, n1);
+        intersect_2 = tti_interp(p1->co_exact, q1->co_exact, p2->co_exact, n2);
       }
     }
   }
@@ -1387,12 +1431,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Args have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1581,49 +1625,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
@@ -2871,6 +2915,10 @@ static void perfdata_init(void)
   perfdata->count.append(0);
   perfdata->count_name.append("final non-NONE intersects");
 
+  /* count 5. */
+  perfdata->count.append(0);
+  perfdata->count_name.append("tri tri above tests decided by filter");
+
   /* max 0. */
   perfdata->max.append(0);
   perfdata->max_name.append("total faces");
@@ -20,14 +20,19 @@
  * Task parallel range functions.
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_concurrent_map.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "atomic_ops.h"
 
@@ -37,33 +42,139 @@
 #  include <tbb/tbb.h>
 #endif
 
+namespace blender::detail {
+
+/* All tuners, they are never freed. */
+static std::atomic<ParallelRangeTuner *> tuners_first{nullptr};
+
+ParallelRangeTuner::ParallelRangeTuner(const char *name, const void *func)
+    : name_(name), func_(func), next_(tuners_first.load())
+{
+  while (!tuners_first.compare_exchange_weak(next_, this)) {
+    /* `next_` was updated to the current first tuner, try again. */
+  }
+}
+
+int64_t ParallelRangeTuner::grain_size(const int64_t range_size) const
+{
+  /* Keep a few chunks per thread so that threads finishing early can steal work. */
+  const int64_t max_grain_size = range_size / (BLI_task_scheduler_num_threads() * 4);
+  return std::max<int64_t>(1, std::min(grain_size_.load(std::memory_order_relaxed),
+                                       max_grain_size));
+}
+
+void ParallelRangeTuner::add_call(const int64_t iterations_num,
+                                  const int64_t wall_ns,
+                                  const int64_t thread_ns)
+{
+  calls_num_.fetch_add(1, std::memory_order_relaxed);
+  iterations_num_.fetch_add(iterations_num, std::memory_order_relaxed);
+  wall_ns_.fetch_add(wall_ns, std::memory_order_relaxed);
+  if (thread_ns < 0) {
+    return;
+  }
+
+  measured_calls_num_.fetch_add(1, std::memory_order_relaxed);
+  measured_wall_ns_.fetch_add(wall_ns, std::memory_order_relaxed);
+  const int64_t total_iterations_num = measured_iterations_num_.fetch_add(iterations_num) +
+                                       iterations_num;
+  const int64_t total_thread_ns = measured_thread_ns_.fetch_add(thread_ns) + thread_ns;
+  const int64_t iteration_ns = std::max<int64_t>(1, total_thread_ns / total_iterations_num);
+  grain_size_.store(std::max<int64_t>(1, chunk_target_ns / iteration_ns),
+                    std::memory_order_relaxed);
+}
+
+void ParallelRangeTuner::print_stats()
+{
+  Vector<const ParallelRangeTuner *> tuners;
+  for (const ParallelRangeTuner *tuner = tuners_first.load(); tuner; tuner = tuner->next_) {
+    if (tuner->calls_num_ > 0) {
+      tuners.append(tuner);
+    }
+  }
+  if (tuners.is_empty()) {
+    return;
+  }
+  /* Most expensive loops first. */
+  std::sort(tuners.begin(), tuners.end(), [](const auto *a, const auto *b) {
+    return a->wall_ns_ > b->wall_ns_;
+  });
+
+  printf("Parallel ranges with a tuned grain size:\n");
+  for (const ParallelRangeTuner *tuner : tuners) {
+    const int64_t calls_num = tuner->calls_num_;
+    const int64_t measured_iterations_num = std::max<int64_t>(tuner->measured_iterations_num_, 1);
+    const int64_t measured_wall_ns = std::max<int64_t>(tuner->measured_wall_ns_, 1);
+    if (tuner->name_) {
+      printf("  %s:\n", tuner->name_);
+    }
+    else {
+      printf("  %p:\n", tuner->func_);
+    }
+    printf(
+        "    %lld calls, %.1f iterations per call, grain size %lld, %.1f ns per iteration, "
+        "%.2f threads busy, %.3f s in total\n",
+        (long long)calls_num,
+        (double)tuner->iterations_num_ / (double)calls_num,
+        (long long)tuner->grain_size_,
+        (double)tuner->measured_thread_ns_ / (double)measured_iterations_num,
+        (double)tuner->measured_thread_ns_ / (double)measured_wall_ns,
+        (double)tuner->wall_ns_ * 1e-9);
+  }
+}
+
+}  // namespace blender::detail
+
 #ifdef WITH_TBB
 
+/* Tuners of the ranges using automatic chunk sizes, by callback. They are looked up by every
+ * parallel range, which are often started from several threads at the same time. Tuners are
+ * never freed, like the ones of the C++ call sites. */
+static blender::detail::ParallelRangeTuner &range_tuner_get(TaskParallelRangeFunc func)
+{
+  static blender::ConcurrentMap<const void *, blender::detail::ParallelRangeTuner *> tuners;
+
+  return *tuners.lookup_or_add_cb((const void *)func, [&]() {
+    return new blender::detail::ParallelRangeTuner(nullptr, (const void *)func);
+  });
+}
+
 /* Functor for running TBB parallel_for and parallel_reduce. */
 struct RangeTask {
   TaskParallelRangeFunc func;
   void *userdata;
   const TaskParallelSettings *settings;
+  /* Time spent in the chunks, null when not measured. */
+  std::atomic<int64_t> *thread_ns;
 
   void *userdata_chunk;
 
   /* Root constructor. */
-  RangeTask(TaskParallelRangeFunc func, void *userdata, const TaskParallelSettings *settings)
-      : func(func), userdata(userdata), settings(settings)
+  RangeTask(TaskParallelRangeFunc func,
+            void *userdata,
+            const TaskParallelSettings *settings,
+            std::atomic<int64_t> *thread_ns)
+      : func(func), userdata(userdata), settings(settings), thread_ns(thread_ns)
   {
     init_chunk(settings->userdata_chunk);
   }
 
   /* Copy constructor. */
   RangeTask(const RangeTask &other)
-      : func(other.func), userdata(other.userdata), settings(other.settings)
+      : func(other.func),
+        userdata(other.userdata),
+        settings(other.settings),
+        thread_ns(other.thread_ns)
   {
     init_chunk(settings->userdata_chunk);
   }
 
   /* Splitting constructor for parallel reduce. */
   RangeTask(RangeTask &other, tbb::split /* unused */)
-      : func(other.func), userdata(other.userdata), settings(other.settings)
+      : func(other.func),
+        userdata(other.userdata),
+        settings(other.settings),
+        thread_ns(other.thread_ns)
   {
     init_chunk(settings->userdata_chunk);
   }
@@ -89,6 +200,7 @@ struct RangeTask {
 
   void operator()(const tbb::blocked_range<int> &r) const
   {
+    const int64_t start_ns = thread_ns ? blender::detail::ParallelRangeTuner::time_ns() : 0;
     tbb::this_task_arena::isolate([this, r] {
       TaskParallelTLS tls;
       tls.userdata_chunk = userdata_chunk;
@@ -96,6 +208,10 @@ struct RangeTask {
         func(userdata, i, &tls);
       }
     });
+    if (thread_ns) {
+      thread_ns->fetch_add(blender::detail::ParallelRangeTuner::time_ns() - start_ns,
+                           std::memory_order_relaxed);
+    }
   }
 
   void join(const RangeTask &other)
@@ -115,9 +231,20 @@ void BLI_task_parallel_range(const int start,
 #ifdef WITH_TBB
   /* Multithreading. */
   if (settings->use_threading && BLI_task_scheduler_num_threads() > 1) {
-    RangeTask task(func, userdata, settings);
-    const size_t grainsize = MAX2(settings->min_iter_per_thread, 1);
-    const tbb::blocked_range<int> range(start, stop, grainsize);
+    blender::detail::ParallelRangeTuner *tuner = nullptr;
+    std::atomic<int64_t> thread_ns{0};
+    bool is_measuring = false;
+    int64_t start_ns = 0;
+    size_t grainsize = (size_t)settings->min_iter_per_thread;
+    if (grainsize == 0 && stop > start) {
+      tuner = &range_tuner_get(func);
+      is_measuring = tuner->is_measuring();
+      grainsize = (size_t)tuner->grain_size(stop - start);
+      start_ns = blender::detail::ParallelRangeTuner::time_ns();
+    }
+
+    RangeTask task(func, userdata, settings, is_measuring ? &thread_ns : nullptr);
+    const tbb::blocked_range<int> range(start, stop, MAX2(grainsize, (size_t)1));
 
     if (settings->func_reduce) {
       parallel_reduce(range, task);
@@ -128,6 +255,12 @@ void BLI_task_parallel_range(const int start,
     else {
       parallel_for(range, task);
     }
+
+    if (tuner) {
+      tuner->add_call(stop - start,
+                      blender::detail::ParallelRangeTuner::time_ns() - start_ns,
+                      is_measuring ? thread_ns.load() : -1);
+    }
     return;
   }
 #endif
@@ -144,6 +277,11 @@ void BLI_task_parallel_range(const int start,
   }
 }
 
+void BLI_task_parallel_range_stats_print(void)
+{
+  blender::detail::ParallelRangeTuner::print_stats();
+}
+
 int BLI_task_parallel_thread_id(const TaskParallelTLS *UNUSED(tls))
 {
 #ifdef WITH_TBB
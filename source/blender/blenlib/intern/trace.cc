@@ -0,0 +1,211 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+#include "BLI_trace.h"
+#include "BLI_vector.hh"
+
+namespace blender::trace {
+
+struct Zone {
+  const char *category;
+  char name[56];
+  int64_t begin_ns;
+  int64_t end_ns;
+};
+
+/* Zones nested deeper are not recorded. */
+static constexpr int max_depth = 64;
+
+struct ThreadBuffer {
+  int thread_index;
+  /* Ring buffer of the last finished zones. */
+  Array<Zone> zones = Array<Zone>(BLI_TRACE_ZONES_PER_THREAD, NoInitialization());
+  int64_t zones_num = 0;
+  /* Zones which are not finished yet. */
+  Zone stack[max_depth];
+  int depth = 0;
+};
+
+static std::atomic<bool> is_enabled{false};
+/* Incremented by every #BLI_trace_init, to know when the buffer of a thread is outdated. */
+static std::atomic<int> generation{0};
+static std::mutex buffers_mutex;
+static Vector<std::unique_ptr<ThreadBuffer>> buffers;
+static std::string output_filepath;
+static int64_t start_ns = 0;
+
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+static thread_local int thread_generation = 0;
+
+static int64_t time_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static ThreadBuffer &thread_buffer_get()
+{
+  const int current_generation = generation.load(std::memory_order_relaxed);
+  if (thread_buffer == nullptr || thread_generation != current_generation) {
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock{buffers_mutex};
+    buffer->thread_index = (int)buffers.size();
+    thread_buffer = buffer.get();
+    thread_generation = current_generation;
+    buffers.append(std::move(buffer));
+  }
+  return *thread_buffer;
+}
+
+static void write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fprintf(file, "\\%c", *c);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(file, "\\u%04x", (unsigned int)*c);
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static bool write_trace(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+  bool is_first = true;
+  for (const std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    fprintf(file,
+            "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+            "\"args\": {\"name\": \"Thread %d\"}}",
+            is_first ? "" : ",",
+            buffer->thread_index,
+            buffer->thread_index);
+    is_first = false;
+
+    const int64_t zones_size = buffer->zones.size();
+    const int64_t first = std::max<int64_t>(buffer->zones_num - zones_size, 0);
+    for (int64_t i = first; i < buffer->zones_num; i++) {
+      const Zone &zone = buffer->zones[i % zones_size];
+      fprintf(file, ",\n{\"name\": ");
+      write_json_string(file, zone.name);
+      fprintf(file, ", \"cat\": ");
+      write_json_string(file, zone.category);
+      fprintf(file,
+              ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+              buffer->thread_index,
+              (double)(zone.begin_ns - start_ns) * 1e-3,
+              (double)(zone.end_ns - zone.begin_ns) * 1e-3);
+    }
+  }
+  fprintf(file, "\n]}\n");
+
+  return fclose(file) == 0;
+}
+
+}  // namespace blender::trace
+
+using namespace blender::trace;
+
+void BLI_trace_init(const char *filepath)
+{
+  std::lock_guard<std::mutex> lock{buffers_mutex};
+  output_filepath = filepath;
+  start_ns = time_ns();
+  generation++;
+  is_enabled = true;
+}
+
+void BLI_trace_exit(void)
+{
+  if (!is_enabled) {
+    return;
+  }
+  is_enabled = false;
+
+  std::lock_guard<std::mutex> lock{buffers_mutex};
+  if (write_trace(output_filepath.c_str())) {
+    printf("Trace written to '%s'\n", output_filepath.c_str());
+  }
+  else {
+    printf("Error: could not write trace to '%s'\n", output_filepath.c_str());
+  }
+  buffers.clear_and_make_inline();
+  output_filepath.clear();
+}
+
+bool BLI_trace_is_enabled(void)
+{
+  return is_enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_trace_begin(const char *category, const char *name)
+{
+  if (!is_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadBuffer &buffer = thread_buffer_get();
+  if (buffer.depth < max_depth) {
+    Zone &zone = buffer.stack[buffer.depth];
+    zone.category = category;
+    BLI_strncpy(zone.name, name, sizeof(zone.name));
+    zone.begin_ns = time_ns();
+  }
+  buffer.depth++;
+}
+
+void BLI_trace_end(void)
+{
+  if (!is_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadBuffer &buffer = thread_buffer_get();
+  if (buffer.depth == 0) {
+    /* The zone began before recording started. */
+    return;
+  }
+  buffer.depth--;
+  if (buffer.depth < max_depth) {
+    Zone &zone = buffer.zones[buffer.zones_num % buffer.zones.size()];
+    zone = buffer.stack[buffer.depth];
+    zone.end_ns = time_ns();
+    buffer.zones_num++;
+  }
+}
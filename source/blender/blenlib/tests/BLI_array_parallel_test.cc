@@ -0,0 +1,135 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_array_parallel.h"
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+/* Large enough to use the multi-threaded code paths. */
+static constexpr int large_size = 300000;
+
+TEST(array_parallel, ExclusiveScanSmall)
+{
+  int data[5] = {3, 0, 2, 1, 4};
+  const int sum = BLI_array_exclusive_scan_i(data, 5);
+  EXPECT_EQ(sum, 10);
+  EXPECT_EQ(data[0], 0);
+  EXPECT_EQ(data[1], 3);
+  EXPECT_EQ(data[2], 3);
+  EXPECT_EQ(data[3], 5);
+  EXPECT_EQ(data[4], 6);
+}
+
+TEST(array_parallel, ExclusiveScanEmpty)
+{
+  EXPECT_EQ(BLI_array_exclusive_scan_i(nullptr, 0), 0);
+}
+
+TEST(array_parallel, ExclusiveScanLarge)
+{
+  Array<int> data(large_size);
+  for (const int i : data.index_range()) {
+    data[i] = i % 7;
+  }
+  const int sum = BLI_array_exclusive_scan_i(data.data(), large_size);
+
+  int expected = 0;
+  for (const int i : data.index_range()) {
+    EXPECT_EQ(data[i], expected);
+    expected += i % 7;
+  }
+  EXPECT_EQ(sum, expected);
+}
+
+static void test_group_indices_by_key(const int keys_len, const int groups_len)
+{
+  RandomNumberGenerator rng(keys_len);
+  Array<int> keys(keys_len);
+  for (const int i : keys.index_range()) {
+    /* Some elements are not part of any group. */
+    keys[i] = rng.get_int32(groups_len + 1) - 1;
+  }
+
+  Array<int> offsets(groups_len + 1);
+  Array<int> indices(keys_len);
+  BLI_array_group_indices_by_key(
+      keys.data(), keys_len, groups_len, offsets.data(), indices.data());
+
+  int grouped_num = 0;
+  for (const int i : keys.index_range()) {
+    grouped_num += (keys[i] >= 0) ? 1 : 0;
+  }
+  EXPECT_EQ(offsets[groups_len], grouped_num);
+
+  for (const int group : IndexRange(groups_len)) {
+    EXPECT_LE(offsets[group], offsets[group + 1]);
+    for (int i = offsets[group]; i < offsets[group + 1]; i++) {
+      EXPECT_EQ(keys[indices[i]], group);
+      if (i > offsets[group]) {
+        EXPECT_LT(indices[i - 1], indices[i]);
+      }
+    }
+  }
+}
+
+TEST(array_parallel, GroupIndicesByKeySmall)
+{
+  test_group_indices_by_key(1000, 50);
+}
+
+TEST(array_parallel, GroupIndicesByKeyLarge)
+{
+  test_group_indices_by_key(large_size, 10000);
+}
+
+TEST(array_parallel, GroupIndicesByKeyFewGroups)
+{
+  test_group_indices_by_key(large_size, 3);
+}
+
+static void test_sort_indices_by_key(const int keys_len, const uint64_t key_mask)
+{
+  RandomNumberGenerator rng(keys_len);
+  Array<uint64_t> keys(keys_len);
+  for (const int i : keys.index_range()) {
+    keys[i] = (((uint64_t)rng.get_uint32() << 32) | rng.get_uint32()) & key_mask;
+  }
+
+  Array<int> indices(keys_len);
+  BLI_array_sort_indices_by_key_u64(keys.data(), keys_len, indices.data());
+
+  Array<int> expected(keys_len);
+  for (const int i : expected.index_range()) {
+    expected[i] = i;
+  }
+  std::stable_sort(expected.begin(), expected.end(), [&](const int a, const int b) {
+    return keys[a] < keys[b];
+  });
+
+  for (const int i : indices.index_range()) {
+    EXPECT_EQ(indices[i], expected[i]);
+  }
+}
+
+TEST(array_parallel, SortIndicesByKeySmall)
+{
+  test_sort_indices_by_key(1000, UINT64_MAX);
+}
+
+TEST(array_parallel, SortIndicesByKeyLarge)
+{
+  test_sort_indices_by_key(large_size, UINT64_MAX);
+}
+
+TEST(array_parallel, SortIndicesByKeyDuplicates)
+{
+  /* Many equal keys, and digits that are the same for all keys. */
+  test_sort_indices_by_key(large_size, 0x00ff00000000000full);
+}
+
+}  // namespace blender::tests
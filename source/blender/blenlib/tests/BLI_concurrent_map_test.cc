@@ -0,0 +1,88 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <atomic>
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_task.hh"
+
+namespace blender::tests {
+
+TEST(concurrent_map, DefaultConstructor)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(concurrent_map, AddLookupRemove)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_FALSE(map.add(2, 6.0f));
+  EXPECT_TRUE(map.add(3, 1.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_FALSE(map.contains(4));
+  EXPECT_EQ(map.lookup_default(2, 0.0f), 5.0f);
+  EXPECT_EQ(map.lookup_default(4, 0.0f), 0.0f);
+
+  EXPECT_FALSE(map.add_overwrite(2, 7.0f));
+  EXPECT_EQ(map.lookup_default(2, 0.0f), 7.0f);
+
+  EXPECT_TRUE(map.remove(2));
+  EXPECT_FALSE(map.remove(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 1);
+
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(concurrent_map, SingleShard)
+{
+  ConcurrentMap<int, int, 1> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i * 2);
+  }
+  EXPECT_EQ(map.size(), 100);
+  EXPECT_EQ(map.lookup_default(42, 0), 84);
+}
+
+TEST(concurrent_map, ForeachItem)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 1000; i++) {
+    map.add(i, i + 1);
+  }
+  int64_t key_sum = 0;
+  int64_t value_sum = 0;
+  map.foreach_item([&](const int key, const int value) {
+    key_sum += key;
+    value_sum += value;
+  });
+  EXPECT_EQ(key_sum, 999 * 1000 / 2);
+  EXPECT_EQ(value_sum, key_sum + 1000);
+}
+
+TEST(concurrent_map, LookupOrAddFromThreads)
+{
+  ConcurrentMap<int, int> map;
+  std::atomic<int> created_num = 0;
+  /* Every key is requested many times from different threads, but only created once. */
+  parallel_for(IndexRange(100000), 1000, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int key = (int)(i % 1000);
+      const int value = map.lookup_or_add_cb(key, [&]() {
+        created_num++;
+        return key * 3;
+      });
+      EXPECT_EQ(value, key * 3);
+    }
+  });
+  EXPECT_EQ(created_num, 1000);
+  EXPECT_EQ(map.size(), 1000);
+}
+
+}  // namespace blender::tests
@@ -66,8 +66,21 @@ static void optimal_check_callback(void *userdata,
  * Note that a small epsilon is added to the BVH nodes bounds, even if we pass in zero.
  * Use rounding to ensure very close nodes don't cause the wrong node to be found as nearest.
  */
-static void find_nearest_points_test(
-    int points_len, float scale, int round, int random_seed, bool optimal = false)
+static int points_leaf_coords_callback(void *userdata,
+                                       int index,
+                                       float r_co[BVH_LEAF_POINTS_MAX][3])
+{
+  const float(*points)[3] = (const float(*)[3])userdata;
+  copy_v3_v3(r_co[0], points[index]);
+  return 1;
+}
+
+static void find_nearest_points_test(int points_len,
+                                     float scale,
+                                     int round,
+                                     int random_seed,
+                                     bool optimal = false,
+                                     bool insert_many = false)
 {
   struct RNG *rng = BLI_rng_new(random_seed);
   BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
@@ -77,8 +90,14 @@ static void find_nearest_points_test(
 
   for (int i = 0; i < points_len; i++) {
     rng_v3_round(points[i], 3, rng, round, scale);
-    BLI_bvhtree_insert(tree, i, points[i], 1);
+    if (!insert_many) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+  }
+  if (insert_many) {
+    BLI_bvhtree_insert_many(tree, nullptr, points_len, points_leaf_coords_callback, points);
   }
+  EXPECT_EQ(BLI_bvhtree_get_len(tree), points_len);
   BLI_bvhtree_balance(tree);
 
   /* first find each point */
@@ -120,6 +139,16 @@ TEST(kdopbvh, FindNearest_500)
   find_nearest_points_test(500, 1.0, 1000, 12);
 }
 
+TEST(kdopbvh, InsertManyFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, true);
+}
+/* Enough leafs for the first branches to be computed from multiple threads. */
+TEST(kdopbvh, InsertManyFindNearest_70000)
+{
+  find_nearest_points_test(70000, 1.0, 100000, 123, false, true);
+}
+
 TEST(kdopbvh, OptimalFindNearest_1)
 {
   find_nearest_points_test(1, 1.0, 1000, 1234, true);
@@ -132,3 +161,51 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/**
+ * Move the points after building the tree, and check they are found at their new location
+ * once the tree is refitted.
+ */
+static void refit_points_test(int points_len, float scale, int round, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+
+  void *mem = MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  float(*points)[3] = (float(*)[3])mem;
+
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, round, scale);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  const float offset[3] = {10.0f, -5.0f, 2.0f};
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, round, scale);
+    add_v3_v3(points[i], offset);
+  }
+  BLI_bvhtree_refit(tree, points_leaf_coords_callback, points);
+  EXPECT_EQ(BLI_bvhtree_get_len(tree), points_len);
+
+  for (int i = 0; i < points_len; i++) {
+    const int j = BLI_bvhtree_find_nearest(tree, points[i], nullptr, nullptr, nullptr);
+    EXPECT_GE(j, 0);
+    EXPECT_LT(j, points_len);
+    if (j != i) {
+      EXPECT_EQ_ARRAY(points[i], points[j], 3);
+    }
+  }
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+}
+
+TEST(kdopbvh, Refit_1)
+{
+  refit_points_test(1, 1.0, 1000, 1234);
+}
+TEST(kdopbvh, Refit_500)
+{
+  refit_points_test(500, 1.0, 1000, 12);
+}
@@ -0,0 +1,157 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+
+#include <atomic>
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+/* Large enough to balance and search on multiple threads. */
+#define POINTS_NUM 50000
+
+static float (*random_points(const int points_num, const int seed))[3]
+{
+  RNG *rng = BLI_rng_new(seed);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(*points) * points_num, __func__);
+  for (int i = 0; i < points_num; i++) {
+    BLI_rng_get_float_unit_v3(rng, points[i]);
+    mul_v3_fl(points[i], BLI_rng_get_float(rng));
+  }
+  BLI_rng_free(rng);
+  return points;
+}
+
+static KDTree_3d *tree_from_points(const float (*points)[3], const int points_num)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_num);
+  for (int i = 0; i < points_num; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static float nearest_dist_sq_brute_force(const float (*points)[3],
+                                         const int points_num,
+                                         const float co[3])
+{
+  float dist_sq_min = FLT_MAX;
+  for (int i = 0; i < points_num; i++) {
+    dist_sq_min = min_ff(dist_sq_min, len_squared_v3v3(points[i], co));
+  }
+  return dist_sq_min;
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+TEST(kdtree, FindNearest)
+{
+  float(*points)[3] = random_points(POINTS_NUM, 1);
+  float(*queries)[3] = random_points(100, 2);
+  KDTree_3d *tree = tree_from_points(points, POINTS_NUM);
+
+  for (int i = 0; i < 100; i++) {
+    KDTreeNearest_3d nearest;
+    const int index = BLI_kdtree_3d_find_nearest(tree, queries[i], &nearest);
+    ASSERT_NE(index, -1);
+    EXPECT_EQ(index, nearest.index);
+    EXPECT_EQ(len_squared_v3v3(points[index], queries[i]),
+              nearest_dist_sq_brute_force(points, POINTS_NUM, queries[i]));
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+}
+
+TEST(kdtree, FindNearestBatch)
+{
+  const int queries_num = 5000;
+  float(*points)[3] = random_points(POINTS_NUM, 3);
+  float(*queries)[3] = random_points(queries_num, 4);
+  KDTree_3d *tree = tree_from_points(points, POINTS_NUM);
+
+  int *indices = (int *)MEM_mallocN(sizeof(int) * queries_num, __func__);
+  KDTreeNearest_3d *nearest = (KDTreeNearest_3d *)MEM_mallocN(
+      sizeof(KDTreeNearest_3d) * queries_num, __func__);
+  BLI_kdtree_3d_find_nearest_batch(tree, queries, queries_num, indices, nearest);
+
+  for (int i = 0; i < queries_num; i++) {
+    KDTreeNearest_3d expected;
+    EXPECT_EQ(indices[i], BLI_kdtree_3d_find_nearest(tree, queries[i], &expected));
+    EXPECT_EQ(nearest[i].index, expected.index);
+    EXPECT_EQ(nearest[i].dist, expected.dist);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(indices);
+  MEM_freeN(nearest);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+}
+
+struct RangeSearchBatchData {
+  const float (*points)[3];
+  const float (*queries)[3];
+  float range;
+  std::atomic<int> *found_num;
+  std::atomic<bool> is_valid;
+};
+
+static bool range_search_batch_cb(
+    void *user_data, int co_index, int index, const float co[3], float dist_sq)
+{
+  RangeSearchBatchData *data = (RangeSearchBatchData *)user_data;
+  if (!equals_v3v3(co, data->points[index]) ||
+      len_squared_v3v3(co, data->queries[co_index]) != dist_sq ||
+      dist_sq > data->range * data->range) {
+    data->is_valid = false;
+  }
+  data->found_num[co_index]++;
+  return true;
+}
+
+TEST(kdtree, RangeSearchBatch)
+{
+  const int queries_num = 2000;
+  const float range = 0.05f;
+  float(*points)[3] = random_points(POINTS_NUM, 5);
+  float(*queries)[3] = random_points(queries_num, 6);
+  KDTree_3d *tree = tree_from_points(points, POINTS_NUM);
+
+  std::atomic<int> *found_num = new std::atomic<int>[queries_num];
+  for (int i = 0; i < queries_num; i++) {
+    found_num[i] = 0;
+  }
+  RangeSearchBatchData data;
+  data.points = points;
+  data.queries = queries;
+  data.range = range;
+  data.found_num = found_num;
+  data.is_valid = true;
+  BLI_kdtree_3d_range_search_batch_cb(
+      tree, queries, queries_num, range, range_search_batch_cb, &data);
+  EXPECT_TRUE(data.is_valid);
+
+  for (int i = 0; i < queries_num; i++) {
+    KDTreeNearest_3d *nearest = nullptr;
+    const int expected_num = BLI_kdtree_3d_range_search(tree, queries[i], &nearest, range);
+    EXPECT_EQ(found_num[i], expected_num);
+    if (nearest) {
+      MEM_freeN(nearest);
+    }
+  }
+
+  delete[] found_num;
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+}
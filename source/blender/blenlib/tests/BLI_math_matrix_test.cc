@@ -3,6 +3,7 @@
 #include "testing/testing.h"
 
 #include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
 
 TEST(math_matrix, interp_m4_m4m4_regular)
 {
@@ -97,3 +98,50 @@ TEST(math_matrix, interp_m3_m3m3_singularity)
   EXPECT_NEAR(0.0f, determinant_m3_array(result), 1e-5);
   EXPECT_M3_NEAR(result, expect, 1e-5);
 }
+
+TEST(math_matrix, mul_m4_v3_array)
+{
+  float matrix[4][4];
+  const float loc[3] = {1.0f, -2.0f, 3.0f};
+  const float rot[3] = {0.3f, 0.5f, -0.1f};
+  const float size[3] = {2.0f, 1.5f, 0.5f};
+  loc_eul_size_to_mat4(matrix, loc, rot, size);
+
+  float vectors[5][3] = {
+      {0.0f, 0.0f, 0.0f},
+      {1.0f, 2.0f, 3.0f},
+      {-4.5f, 0.25f, 8.0f},
+      {1e6f, -1e-6f, 0.0f},
+      {0.1f, 0.2f, 0.3f},
+  };
+  float expect[5][3];
+  memcpy(expect, vectors, sizeof(vectors));
+  for (int i = 0; i < 5; i++) {
+    mul_m4_v3(matrix, expect[i]);
+  }
+
+  mul_m4_v3_array(matrix, vectors, 5);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_V3_NEAR(vectors[i], expect[i], 0.0f);
+  }
+}
+
+TEST(math_matrix, mul_m4_v3_array_stride)
+{
+  struct Point {
+    float co[3];
+    int flag;
+  };
+  Point points[3] = {{{1.0f, 2.0f, 3.0f}, 1}, {{4.0f, 5.0f, 6.0f}, 2}, {{7.0f, 8.0f, 9.0f}, 3}};
+  float matrix[4][4];
+  unit_m4(matrix);
+  mul_v3_fl(matrix[0], 2.0f);
+  copy_v3_fl3(matrix[3], 1.0f, 0.0f, -1.0f);
+
+  mul_m4_v3_array_stride(matrix, points[0].co, 3, sizeof(Point));
+  const float expect[3][3] = {{3.0f, 2.0f, 2.0f}, {9.0f, 5.0f, 5.0f}, {15.0f, 8.0f, 8.0f}};
+  for (int i = 0; i < 3; i++) {
+    EXPECT_V3_NEAR(points[i].co, expect[i], 0.0f);
+    EXPECT_EQ(points[i].flag, i + 1);
+  }
+}
@@ -45,3 +45,47 @@ TEST(math_vector, ClampVecWithVecs)
   EXPECT_FLOAT_EQ(1.0f, c[0]);
   EXPECT_FLOAT_EQ(3.0f, c[1]);
 }
+
+TEST(math_vector, minmax_v3v3_v3_array)
+{
+  const float vectors[4][3] = {
+      {1.0f, -2.0f, 3.0f},
+      {-1.0f, 5.0f, 0.5f},
+      {0.0f, 0.0f, 10.0f},
+      {2.0f, 1.0f, -3.0f},
+  };
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  minmax_v3v3_v3_array(min, max, vectors, 4);
+  EXPECT_FLOAT_EQ(min[0], -1.0f);
+  EXPECT_FLOAT_EQ(min[1], -2.0f);
+  EXPECT_FLOAT_EQ(min[2], -3.0f);
+  EXPECT_FLOAT_EQ(max[0], 2.0f);
+  EXPECT_FLOAT_EQ(max[1], 5.0f);
+  EXPECT_FLOAT_EQ(max[2], 10.0f);
+
+  /* Nothing changes without vectors. */
+  minmax_v3v3_v3_array(min, max, nullptr, 0);
+  EXPECT_FLOAT_EQ(min[0], -1.0f);
+  EXPECT_FLOAT_EQ(max[2], 10.0f);
+}
+
+TEST(math_vector, minmax_v3v3_v3_array_stride)
+{
+  /* Every second vector is skipped. */
+  const float vectors[4][3] = {
+      {1.0f, -2.0f, 3.0f},
+      {-100.0f, 100.0f, -100.0f},
+      {0.0f, 0.0f, 10.0f},
+      {100.0f, -100.0f, 100.0f},
+  };
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  minmax_v3v3_v3_array_stride(min, max, vectors[0], 2, sizeof(float[2][3]));
+  EXPECT_FLOAT_EQ(min[0], 0.0f);
+  EXPECT_FLOAT_EQ(min[1], -2.0f);
+  EXPECT_FLOAT_EQ(min[2], 3.0f);
+  EXPECT_FLOAT_EQ(max[0], 1.0f);
+  EXPECT_FLOAT_EQ(max[1], 0.0f);
+  EXPECT_FLOAT_EQ(max[2], 10.0f);
+}
@@ -0,0 +1,132 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_vector.hh"
+
+#include <atomic>
+
+namespace blender::tests {
+
+struct Elem {
+  int value;
+  int pad[3];
+};
+
+static Vector<int> mempool_values(BLI_mempool *pool)
+{
+  Vector<int> values;
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  while (Elem *elem = (Elem *)BLI_mempool_iterstep(&iter)) {
+    values.append(elem->value);
+  }
+  return values;
+}
+
+/* Free every third element, so that the iteration has to skip some. */
+static void mempool_fill(BLI_mempool *pool, const int elems_num)
+{
+  Vector<Elem *> elems;
+  for (int i = 0; i < elems_num; i++) {
+    Elem *elem = (Elem *)BLI_mempool_alloc(pool);
+    elem->value = i;
+    elems.append(elem);
+  }
+  for (int i = 0; i < elems_num; i += 3) {
+    BLI_mempool_free(pool, elems[i]);
+  }
+}
+
+TEST(mempool, LargeChunksIterSameAsDefault)
+{
+  const int elems_num = 400000;
+  BLI_mempool *pool_a = BLI_mempool_create(sizeof(Elem), 0, 512, BLI_MEMPOOL_ALLOW_ITER);
+  BLI_mempool *pool_b = BLI_mempool_create(
+      sizeof(Elem), 0, 512, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_LARGE_CHUNKS);
+  mempool_fill(pool_a, elems_num);
+  mempool_fill(pool_b, elems_num);
+
+  EXPECT_EQ(BLI_mempool_len(pool_a), BLI_mempool_len(pool_b));
+  const Vector<int> values = mempool_values(pool_b);
+  EXPECT_EQ(values.size(), BLI_mempool_len(pool_b));
+  for (const int i : values.index_range()) {
+    /* Two of three elements remain, in the order of allocation. */
+    EXPECT_EQ(values[i], (i / 2) * 3 + 1 + (i % 2));
+  }
+  const Vector<int> values_default = mempool_values(pool_a);
+  ASSERT_EQ(values_default.size(), values.size());
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(values_default[i], values[i]);
+  }
+
+  BLI_mempool_destroy(pool_a);
+  BLI_mempool_destroy(pool_b);
+}
+
+TEST(mempool, LargeChunksReuseFreed)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(Elem), 0, 512, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_LARGE_CHUNKS);
+  Elem *elem_a = (Elem *)BLI_mempool_alloc(pool);
+  Elem *elem_b = (Elem *)BLI_mempool_alloc(pool);
+  BLI_mempool_free(pool, elem_a);
+  EXPECT_EQ(BLI_mempool_alloc(pool), elem_a);
+  EXPECT_EQ(BLI_mempool_len(pool), 2);
+
+  BLI_mempool_free(pool, elem_a);
+  BLI_mempool_free(pool, elem_b);
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  EXPECT_EQ(mempool_values(pool).size(), 0);
+  BLI_mempool_destroy(pool);
+}
+
+TEST(mempool, LargeChunksClear)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(Elem), 0, 512, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_LARGE_CHUNKS);
+  mempool_fill(pool, 300000);
+  const int capacity = BLI_mempool_capacity(pool);
+
+  BLI_mempool_clear_ex(pool, capacity);
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  EXPECT_EQ(BLI_mempool_capacity(pool), capacity);
+  EXPECT_EQ(mempool_values(pool).size(), 0);
+
+  /* The kept chunks are used again. */
+  mempool_fill(pool, 300000);
+  EXPECT_EQ(BLI_mempool_capacity(pool), capacity);
+  EXPECT_EQ(mempool_values(pool).size(), 200000);
+
+  BLI_mempool_clear(pool);
+  EXPECT_EQ(mempool_values(pool).size(), 0);
+  BLI_mempool_destroy(pool);
+}
+
+static void mempool_sum_cb(void *userdata, MempoolIterData *item)
+{
+  ((std::atomic<int64_t> *)userdata)->fetch_add(((Elem *)item)->value);
+}
+
+TEST(mempool, LargeChunksParallelIter)
+{
+  const int elems_num = 400000;
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(Elem), 0, 512, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_LARGE_CHUNKS);
+  mempool_fill(pool, elems_num);
+
+  int64_t expected = 0;
+  for (const int value : mempool_values(pool)) {
+    expected += value;
+  }
+
+  std::atomic<int64_t> sum = 0;
+  BLI_task_parallel_mempool(pool, &sum, mempool_sum_cb, true);
+  EXPECT_EQ(sum, expected);
+
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
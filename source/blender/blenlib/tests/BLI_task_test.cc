@@ -9,9 +9,11 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #define NUM_ITEMS 10000
 
@@ -65,6 +67,51 @@ TEST(task, RangeIter)
   BLI_threadapi_exit();
 }
 
+TEST(task, RangeIterAutoGrainSize)
+{
+  BLI_threadapi_init();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.func_reduce = task_range_iter_reduce_func;
+
+  /* Tuned from the first calls, the result must not depend on it. */
+  for (int call = 0; call < 20; call++) {
+    int data[NUM_ITEMS] = {0};
+    int sum = 0;
+    settings.userdata_chunk = &sum;
+    settings.userdata_chunk_size = sizeof(sum);
+
+    BLI_task_parallel_range(0, NUM_ITEMS, data, task_range_iter_func, &settings);
+
+    int expected_sum = 0;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+      EXPECT_EQ(data[i], i);
+      expected_sum += i;
+    }
+    EXPECT_EQ(sum, expected_sum);
+  }
+
+  BLI_threadapi_exit();
+}
+
+TEST(task, ParallelForAutoGrainSize)
+{
+  for (const int64_t size : {0, 1, 10, 100000}) {
+    for (int call = 0; call < 20; call++) {
+      blender::Array<int> data(size, 0);
+      blender::parallel_for(blender::IndexRange(size), [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          data[i]++;
+        }
+      });
+      for (const int64_t i : data.index_range()) {
+        EXPECT_EQ(data[i], 1);
+      }
+    }
+  }
+}
+
 /* *** Parallel iterations over mempool items. *** */
 
 static void task_mempool_iter_func(void *userdata, MempoolIterData *item)
@@ -0,0 +1,63 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "BLI_fileops.h"
+#include "BLI_trace.h"
+
+namespace blender::tests {
+
+static std::string read_file(const std::string &filepath)
+{
+  std::ifstream file(filepath);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+TEST(trace, Disabled)
+{
+  EXPECT_FALSE(BLI_trace_is_enabled());
+  /* Does nothing. */
+  BLI_trace_begin("test", "zone");
+  BLI_trace_end();
+  BLI_trace_exit();
+}
+
+TEST(trace, WriteZones)
+{
+  const std::string filepath = testing::TempDir() + "blender_trace_test.json";
+  BLI_trace_init(filepath.c_str());
+  EXPECT_TRUE(BLI_trace_is_enabled());
+
+  {
+    SCOPED_TRACE_ZONE("test", "outer");
+    BLI_trace_begin("test", "inner \"quoted\"");
+    BLI_trace_end();
+  }
+  std::thread thread([]() { SCOPED_TRACE_ZONE("test", "other thread"); });
+  thread.join();
+  /* Unbalanced end of a zone which began before recording, ignored. */
+  BLI_trace_end();
+
+  BLI_trace_exit();
+  EXPECT_FALSE(BLI_trace_is_enabled());
+
+  const std::string json = read_file(filepath);
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [", 0), 0);
+  EXPECT_NE(json.find("\"name\": \"outer\", \"cat\": \"test\", \"ph\": \"X\", \"pid\": 1, "
+                      "\"tid\": 0"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\": \"inner \\\"quoted\\\"\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\": \"other thread\", \"cat\": \"test\", \"ph\": \"X\", \"pid\": 1, "
+                      "\"tid\": 1"),
+            std::string::npos);
+
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+}  // namespace blender::tests
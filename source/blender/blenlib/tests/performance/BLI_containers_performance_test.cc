@@ -0,0 +1,316 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_smallhash.h"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+#include "PIL_time.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <string>
+
+/* Compare the containers usable as hash tables, with the same keys, the same sizes and in the
+ * same order of operations. Each operation is timed over all keys, the time per key is printed
+ * so that the sizes can be compared as well. */
+
+namespace blender::tests {
+
+/* The best of several runs is printed, slower runs are mostly disturbed by other processes. */
+#define NUM_RUNS 5
+
+static const int64_t sizes[] = {100, 10000, 1000000};
+
+template<typename Fn>
+static void timeit(const char *container, const char *op, const int64_t size, const Fn &fn)
+{
+  double best = DBL_MAX;
+  for (int i = 0; i < NUM_RUNS; i++) {
+    const double start = PIL_check_seconds_timer();
+    fn();
+    best = std::min(best, PIL_check_seconds_timer() - start);
+  }
+  printf("\t%-12s %-10s %8d keys: %8.2f ns/key\n",
+         container,
+         op,
+         (int)size,
+         best * 1e9 / (double)size);
+}
+
+/** Keys, in a random order so that probing isn't helped by locality of the previous keys. */
+static Vector<int> random_int_keys(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  Vector<int> keys;
+  keys.reserve(size);
+  for (const int64_t i : IndexRange(size)) {
+    keys.append((int)(i * 7));
+  }
+  for (int64_t i = size - 1; i > 0; i--) {
+    std::swap(keys[i], keys[rng.get_int32((int)i + 1)]);
+  }
+  return keys;
+}
+
+static Vector<std::string> random_string_keys(const int64_t size)
+{
+  Vector<std::string> keys;
+  keys.reserve(size);
+  for (const int key : random_int_keys(size)) {
+    keys.append("Object." + std::to_string(key));
+  }
+  return keys;
+}
+
+static void int_keys_benchmark(const int64_t size)
+{
+  const Vector<int> keys = random_int_keys(size);
+  /* Keys which are not in the containers, for failed lookups. */
+  Vector<int> missing_keys = keys;
+  for (int &key : missing_keys) {
+    key += 1;
+  }
+
+  {
+    Map<int, int> map;
+    timeit("Map", "insert", size, [&]() {
+      map.clear();
+      for (const int key : keys) {
+        map.add(key, key);
+      }
+    });
+    int64_t sum = 0;
+    timeit("Map", "lookup", size, [&]() {
+      for (const int key : keys) {
+        sum += map.lookup(key);
+      }
+    });
+    timeit("Map", "missing", size, [&]() {
+      for (const int key : missing_keys) {
+        sum += map.contains(key);
+      }
+    });
+    timeit("Map", "iterate", size, [&]() {
+      for (const int value : map.values()) {
+        sum += value;
+      }
+    });
+    EXPECT_NE(sum, 0);
+  }
+
+  {
+    Set<int> set;
+    timeit("Set", "insert", size, [&]() {
+      set.clear();
+      for (const int key : keys) {
+        set.add(key);
+      }
+    });
+    int64_t found = 0;
+    timeit("Set", "lookup", size, [&]() {
+      for (const int key : keys) {
+        found += set.contains(key);
+      }
+    });
+    timeit("Set", "missing", size, [&]() {
+      for (const int key : missing_keys) {
+        found += set.contains(key);
+      }
+    });
+    timeit("Set", "iterate", size, [&]() {
+      for (const int key : set) {
+        found += key;
+      }
+    });
+    EXPECT_NE(found, 0);
+  }
+
+  {
+    VectorSet<int> vector_set;
+    timeit("VectorSet", "insert", size, [&]() {
+      vector_set = {};
+      for (const int key : keys) {
+        vector_set.add(key);
+      }
+    });
+    int64_t sum = 0;
+    timeit("VectorSet", "lookup", size, [&]() {
+      for (const int key : keys) {
+        sum += vector_set.index_of(key);
+      }
+    });
+    timeit("VectorSet", "missing", size, [&]() {
+      for (const int key : missing_keys) {
+        sum += vector_set.contains(key);
+      }
+    });
+    timeit("VectorSet", "iterate", size, [&]() {
+      for (const int key : vector_set) {
+        sum += key;
+      }
+    });
+    EXPECT_NE(sum, 0);
+  }
+
+  {
+    GHash *ghash = BLI_ghash_int_new_ex(__func__, (uint)size);
+    timeit("GHash", "insert", size, [&]() {
+      BLI_ghash_clear(ghash, nullptr, nullptr);
+      for (const int key : keys) {
+        BLI_ghash_insert(ghash, POINTER_FROM_INT(key), POINTER_FROM_INT(key));
+      }
+    });
+    int64_t sum = 0;
+    timeit("GHash", "lookup", size, [&]() {
+      for (const int key : keys) {
+        sum += POINTER_AS_INT(BLI_ghash_lookup(ghash, POINTER_FROM_INT(key)));
+      }
+    });
+    timeit("GHash", "missing", size, [&]() {
+      for (const int key : missing_keys) {
+        sum += BLI_ghash_haskey(ghash, POINTER_FROM_INT(key));
+      }
+    });
+    timeit("GHash", "iterate", size, [&]() {
+      GHASH_FOREACH_BEGIN (void *, value, ghash) {
+        sum += POINTER_AS_INT(value);
+      }
+      GHASH_FOREACH_END();
+    });
+    EXPECT_NE(sum, 0);
+    BLI_ghash_free(ghash, nullptr, nullptr);
+  }
+
+  {
+    SmallHash smallhash;
+    BLI_smallhash_init(&smallhash);
+    timeit("SmallHash", "insert", size, [&]() {
+      /* There is no clear, releasing and initializing is the cheapest way to start over. */
+      BLI_smallhash_release(&smallhash);
+      BLI_smallhash_init(&smallhash);
+      for (const int key : keys) {
+        BLI_smallhash_insert(&smallhash, (uintptr_t)key, POINTER_FROM_INT(key));
+      }
+    });
+    int64_t sum = 0;
+    timeit("SmallHash", "lookup", size, [&]() {
+      for (const int key : keys) {
+        sum += POINTER_AS_INT(BLI_smallhash_lookup(&smallhash, (uintptr_t)key));
+      }
+    });
+    timeit("SmallHash", "missing", size, [&]() {
+      for (const int key : missing_keys) {
+        sum += BLI_smallhash_haskey(&smallhash, (uintptr_t)key);
+      }
+    });
+    timeit("SmallHash", "iterate", size, [&]() {
+      SmallHashIter iter;
+      for (void *value = BLI_smallhash_iternew(&smallhash, &iter, nullptr); value;
+           value = BLI_smallhash_iternext(&iter, nullptr)) {
+        sum += POINTER_AS_INT(value);
+      }
+    });
+    EXPECT_NE(sum, 0);
+    BLI_smallhash_release(&smallhash);
+  }
+}
+
+static void string_keys_benchmark(const int64_t size)
+{
+  const Vector<std::string> keys = random_string_keys(size);
+
+  {
+    Map<std::string, int> map;
+    timeit("Map", "insert", size, [&]() {
+      map.clear();
+      for (const std::string &key : keys) {
+        map.add(key, 1);
+      }
+    });
+    int64_t sum = 0;
+    timeit("Map", "lookup", size, [&]() {
+      for (const std::string &key : keys) {
+        sum += map.lookup(key);
+      }
+    });
+    EXPECT_NE(sum, 0);
+  }
+
+  {
+    Set<StringRef> set;
+    timeit("Set", "insert", size, [&]() {
+      set.clear();
+      for (const std::string &key : keys) {
+        set.add(key);
+      }
+    });
+    int64_t found = 0;
+    timeit("Set", "lookup", size, [&]() {
+      for (const std::string &key : keys) {
+        found += set.contains(key);
+      }
+    });
+    EXPECT_NE(found, 0);
+  }
+
+  {
+    VectorSet<StringRef> vector_set;
+    timeit("VectorSet", "insert", size, [&]() {
+      vector_set = {};
+      for (const std::string &key : keys) {
+        vector_set.add(key);
+      }
+    });
+    int64_t sum = 0;
+    timeit("VectorSet", "lookup", size, [&]() {
+      for (const std::string &key : keys) {
+        sum += vector_set.index_of(key);
+      }
+    });
+    EXPECT_NE(sum, 0);
+  }
+
+  {
+    GHash *ghash = BLI_ghash_str_new_ex(__func__, (uint)size);
+    timeit("GHash", "insert", size, [&]() {
+      BLI_ghash_clear(ghash, nullptr, nullptr);
+      for (const std::string &key : keys) {
+        BLI_ghash_insert(ghash, (void *)key.c_str(), POINTER_FROM_INT(1));
+      }
+    });
+    int64_t sum = 0;
+    timeit("GHash", "lookup", size, [&]() {
+      for (const std::string &key : keys) {
+        sum += POINTER_AS_INT(BLI_ghash_lookup(ghash, key.c_str()));
+      }
+    });
+    EXPECT_NE(sum, 0);
+    BLI_ghash_free(ghash, nullptr, nullptr);
+  }
+}
+
+TEST(containers, IntKeys)
+{
+  for (const int64_t size : sizes) {
+    printf("\n========== Int keys, %d ==========\n", (int)size);
+    int_keys_benchmark(size);
+  }
+}
+
+TEST(containers, StringKeys)
+{
+  for (const int64_t size : sizes) {
+    printf("\n========== String keys, %d ==========\n", (int)size);
+    string_keys_benchmark(size);
+  }
+}
+
+}  // namespace blender::tests
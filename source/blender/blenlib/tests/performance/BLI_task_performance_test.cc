@@ -14,6 +14,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "PIL_time.h"
 
@@ -208,3 +209,114 @@ TEST(task, ListBaseIter100k)
 {
   task_listbase_test("ListBase parallel iteration - Threaded - 100000 items", 100000, true);
 }
+
+/* *** Overhead of the task primitives, for many small work items. *** */
+
+static void task_range_sum_func(void *__restrict userdata,
+                                const int index,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  uint *values = (uint *)userdata;
+  values[index] = gen_pseudo_random_number((uint)index);
+}
+
+static void task_pool_sum_func(TaskPool *__restrict pool, void *taskdata)
+{
+  uint *values = (uint *)BLI_task_pool_user_data(pool);
+  const int index = POINTER_AS_INT(taskdata);
+  values[index] = gen_pseudo_random_number((uint)index);
+}
+
+static void task_graph_sum_func(void *__restrict task_data)
+{
+  uint *value = (uint *)task_data;
+  *value = gen_pseudo_random_number(*value);
+}
+
+static void task_primitives_test(const char *id, const int nbr)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  BLI_threadapi_init();
+  uint *values = (uint *)MEM_calloc_arrayN(nbr, sizeof(*values), __func__);
+
+  double timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, nbr, values, task_range_sum_func, &settings);
+    timing += PIL_check_seconds_timer() - init_time;
+  }
+  printf("\tBLI_task_parallel_range: %fs on average over %d runs\n",
+         timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    blender::parallel_for(blender::IndexRange(nbr), 512, [&](blender::IndexRange range) {
+      for (const int64_t index : range) {
+        values[index] = gen_pseudo_random_number((uint)index);
+      }
+    });
+    timing += PIL_check_seconds_timer() - init_time;
+  }
+  printf("\tblender::parallel_for: %fs on average over %d runs\n",
+         timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  /* A task per item, the worst case of scheduling overhead. */
+  timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    TaskPool *pool = BLI_task_pool_create(values, TASK_PRIORITY_HIGH);
+    for (int index = 0; index < nbr; index++) {
+      BLI_task_pool_push(pool, task_pool_sum_func, POINTER_FROM_INT(index), false, nullptr);
+    }
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+    timing += PIL_check_seconds_timer() - init_time;
+  }
+  printf("\tBLI_task_pool (task per item): %fs on average over %d runs\n",
+         timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  /* Chains of 16 nodes depending on each other, like the evaluation of dependency graphs. */
+  timing = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const double init_time = PIL_check_seconds_timer();
+    TaskGraph *task_graph = BLI_task_graph_create();
+    TaskNode *root = BLI_task_graph_node_create(
+        task_graph, task_graph_sum_func, &values[0], nullptr);
+    TaskNode *prev = root;
+    for (int index = 1; index < nbr; index++) {
+      TaskNode *node = BLI_task_graph_node_create(
+          task_graph, task_graph_sum_func, &values[index], nullptr);
+      BLI_task_graph_edge_create((index % 16) ? prev : root, node);
+      prev = node;
+    }
+    BLI_task_graph_node_push_work(root);
+    BLI_task_graph_work_and_wait(task_graph);
+    BLI_task_graph_free(task_graph);
+    timing += PIL_check_seconds_timer() - init_time;
+  }
+  printf("\tBLI_task_graph (chains of 16 nodes): %fs on average over %d runs\n",
+         timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  MEM_freeN(values);
+  BLI_threadapi_exit();
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(task, Primitives10k)
+{
+  task_primitives_test("Task primitives - 10000 items", 10000);
+}
+
+TEST(task, Primitives1M)
+{
+  task_primitives_test("Task primitives - 1000000 items", 1000000);
+}
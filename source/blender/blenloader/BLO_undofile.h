@@ -84,3 +84,9 @@ extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                          struct Main *bmain,
                                          struct Scene **r_scene);
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
+
+typedef struct MemFileWriteState MemFileWriteState;
+extern bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                               const char *filename,
+                                               MemFileWriteState **r_state);
+extern void BLO_memfile_write_state_free(MemFileWriteState *state);
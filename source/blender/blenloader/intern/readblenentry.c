@@ -35,6 +35,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_genfile.h"
@@ -361,6 +362,7 @@ BlendFileData *BLO_read_from_file(const char *filepath,
   BlendFileData *bfd = NULL;
   FileData *fd;
 
+  BLI_trace_begin("io", filepath);
   fd = blo_filedata_from_file(filepath, reports);
   if (fd) {
     fd->reports = reports;
@@ -368,6 +370,7 @@ BlendFileData *BLO_read_from_file(const char *filepath,
     bfd = blo_read_file_internal(fd, filepath);
     blo_filedata_free(fd);
   }
+  BLI_trace_end();
 
   return bfd;
 }
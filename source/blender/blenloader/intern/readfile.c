@@ -69,6 +69,7 @@
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
@@ -177,6 +178,18 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Build the index of all #BHead's up-front for memory-mapped files and decode (endian switch and
+ * DNA reconstruct) the blocks that need it in parallel, before the data-blocks are read.
+ *
+ * \note Only used when #USE_BHEAD_READ_ON_DEMAND is enabled, since it relies on being able
+ * to access the data of each block from its file offset.
+ * Compressed files and undo memfiles keep reading sequentially.
+ */
+#ifdef USE_BHEAD_READ_ON_DEMAND
+#  define USE_BHEAD_PARALLEL_DECODE
+#endif
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
@@ -206,6 +219,10 @@ typedef struct BHeadN {
   off64_t file_offset;
   /** When set, the remainder of this allocation is the data, otherwise it needs to be read. */
   bool has_data;
+#endif
+#ifdef USE_BHEAD_PARALLEL_DECODE
+  /** Result of #read_struct computed ahead of time, ownership is passed on when it's read. */
+  void *decoded_data;
 #endif
   bool is_memchunk_identical;
   struct BHead bhead;
@@ -260,12 +277,22 @@ typedef struct OldNew {
   int nr;
 } OldNew;
 
+/**
+ * Slot of the hash table, the key is stored next to the index so that probing doesn't have to
+ * look into the `entries` array for every visited slot (which would be a cache miss each time).
+ */
+typedef struct OldNewSlot {
+  const void *oldp;
+  /* Index into the `entries` array or -1 when the slot is empty. */
+  int32_t index;
+} OldNewSlot;
+
 typedef struct OldNewMap {
   /* Array that stores the actual entries. */
   OldNew *entries;
   int nentries;
-  /* Hashmap that stores indices into the `entries` array. */
-  int32_t *map;
+  /* Open addressing hash table that stores keys and indices into the `entries` array. */
+  OldNewSlot *map;
 
   int capacity_exp;
 } OldNewMap;
@@ -277,21 +304,20 @@ typedef struct OldNewMap {
 #define PERTURB_SHIFT 5
 
 /* based on the probing algorithm used in Python dicts. */
-#define ITER_SLOTS(onm, KEY, SLOT_NAME, INDEX_NAME) \
+#define ITER_SLOTS(onm, KEY, SLOT_NAME) \
   uint32_t hash = BLI_ghashutil_ptrhash(KEY); \
   uint32_t mask = SLOT_MASK(onm); \
   uint perturb = hash; \
-  int SLOT_NAME = mask & hash; \
-  int INDEX_NAME = onm->map[SLOT_NAME]; \
-  for (;; SLOT_NAME = mask & ((5 * SLOT_NAME) + 1 + perturb), \
-          perturb >>= PERTURB_SHIFT, \
-          INDEX_NAME = onm->map[SLOT_NAME])
+  OldNewSlot *SLOT_NAME = &onm->map[mask & hash]; \
+  for (;; SLOT_NAME = &onm->map[mask & ((5 * (uint32_t)(SLOT_NAME - onm->map)) + 1 + perturb)], \
+          perturb >>= PERTURB_SHIFT)
 
 static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int index)
 {
-  ITER_SLOTS (onm, ptr, slot, stored_index) {
-    if (stored_index == -1) {
-      onm->map[slot] = index;
+  ITER_SLOTS (onm, ptr, slot) {
+    if (slot->index == -1) {
+      slot->oldp = ptr;
+      slot->index = index;
       break;
     }
   }
@@ -299,15 +325,16 @@ static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int i
 
 static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
 {
-  ITER_SLOTS (onm, entry.oldp, slot, index) {
-    if (index == -1) {
+  ITER_SLOTS (onm, entry.oldp, slot) {
+    if (slot->index == -1) {
       onm->entries[onm->nentries] = entry;
-      onm->map[slot] = onm->nentries;
+      slot->oldp = entry.oldp;
+      slot->index = onm->nentries;
       onm->nentries++;
       break;
     }
-    if (onm->entries[index].oldp == entry.oldp) {
-      onm->entries[index] = entry;
+    if (slot->oldp == entry.oldp) {
+      onm->entries[slot->index] = entry;
       break;
     }
   }
@@ -315,29 +342,32 @@ static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
 
 static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 {
-  ITER_SLOTS (onm, addr, slot, index) {
-    if (index >= 0) {
-      OldNew *entry = &onm->entries[index];
-      if (entry->oldp == addr) {
-        return entry;
-      }
-    }
-    else {
+  ITER_SLOTS (onm, addr, slot) {
+    if (slot->index == -1) {
       return NULL;
     }
+    if (slot->oldp == addr) {
+      return &onm->entries[slot->index];
+    }
   }
 }
 
 static void oldnewmap_clear_map(OldNewMap *onm)
 {
-  memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
+  OldNewSlot *slot = onm->map;
+  for (int64_t i = MAP_CAPACITY(onm); i--; slot++) {
+    slot->oldp = NULL;
+    slot->index = -1;
+  }
 }
 
 static void oldnewmap_increase_size(OldNewMap *onm)
 {
   onm->capacity_exp++;
   onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
-  onm->map = MEM_reallocN(onm->map, sizeof(*onm->map) * MAP_CAPACITY(onm));
+  /* The old slots are not needed to rebuild the table, avoid copying them. */
+  MEM_freeN(onm->map);
+  onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
   oldnewmap_clear_map(onm);
   for (int i = 0; i < onm->nentries; i++) {
     oldnewmap_insert_index_in_map(onm, onm->entries[i].oldp, i);
@@ -819,6 +849,9 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->next = new_bhead->prev = NULL;
           new_bhead->file_offset = fd->file_offset;
           new_bhead->has_data = false;
+#  ifdef USE_BHEAD_PARALLEL_DECODE
+          new_bhead->decoded_data = NULL;
+#  endif
           new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = bhead;
           off64_t seek_new = fd->seek(fd, bhead.len, SEEK_CUR);
@@ -841,6 +874,9 @@ static BHeadN *get_bhead(FileData *fd)
 #ifdef USE_BHEAD_READ_ON_DEMAND
           new_bhead->file_offset = 0; /* don't seek. */
           new_bhead->has_data = true;
+#endif
+#ifdef USE_BHEAD_PARALLEL_DECODE
+          new_bhead->decoded_data = NULL;
 #endif
           new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = bhead;
@@ -955,6 +991,9 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   new_bhead_data->file_offset = new_bhead->file_offset;
   new_bhead_data->has_data = true;
   new_bhead_data->is_memchunk_identical = false;
+#  ifdef USE_BHEAD_PARALLEL_DECODE
+  new_bhead_data->decoded_data = NULL;
+#  endif
   if (!blo_bhead_read_data(fd, thisblock, new_bhead_data + 1)) {
     MEM_freeN(new_bhead_data);
     return NULL;
@@ -1489,6 +1528,16 @@ static ssize_t fd_read_gzip_from_memory(FileData *filedata,
   /* Inflate another chunk. */
   err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
+  /* Compressed files may be made of multiple concatenated gzip members,
+   * see threaded compression in `writefile.c`. */
+  while (err == Z_STREAM_END && filedata->strm.avail_in != 0) {
+    if (inflateReset(&filedata->strm) != Z_OK) {
+      err = Z_STREAM_ERROR;
+      break;
+    }
+    err = (filedata->strm.avail_out != 0) ? inflate(&filedata->strm, Z_SYNC_FLUSH) : Z_OK;
+  }
+
   if (err == Z_STREAM_END) {
     return 0;
   }
@@ -1595,6 +1644,13 @@ void blo_filedata_free(FileData *fd)
       fd->mmap_file = NULL;
     }
 
+#ifdef USE_BHEAD_PARALLEL_DECODE
+    /* Blocks decoded ahead of time which were not used. */
+    LISTBASE_FOREACH (BHeadN *, new_bhead, &fd->bhead_list) {
+      MEM_SAFE_FREE(new_bhead->decoded_data);
+    }
+#endif
+
     /* Free all BHeadN data blocks */
 #ifndef NDEBUG
     BLI_freelistN(&fd->bhead_list);
@@ -1858,6 +1914,42 @@ static void change_link_placeholder_to_real_ID_pointer(ListBase *mainlist,
   }
 }
 
+/**
+ * Same as #change_link_placeholder_to_real_ID_pointer for all placeholders in
+ * \a placeholder_map (mapping placeholders to real ID's, which may be NULL).
+ * Looping over the library maps of all files only once, instead of once per placeholder,
+ * avoids quadratic cost when many libraries and linked ID's are involved.
+ */
+static void change_link_placeholders_to_real_ID_pointers(ListBase *mainlist,
+                                                         FileData *basefd,
+                                                         GHash *placeholder_map)
+{
+  if (BLI_ghash_len(placeholder_map) == 0) {
+    return;
+  }
+
+  LISTBASE_FOREACH (Main *, mainptr, mainlist) {
+    FileData *fd = mainptr->curlib ? mainptr->curlib->filedata : basefd;
+    if (fd == NULL) {
+      continue;
+    }
+
+    for (int i = 0; i < fd->libmap->nentries; i++) {
+      OldNew *entry = &fd->libmap->entries[i];
+      if (entry->nr != ID_LINK_PLACEHOLDER) {
+        continue;
+      }
+      void **new_p = BLI_ghash_lookup_p(placeholder_map, entry->newp);
+      if (new_p != NULL) {
+        entry->newp = *new_p;
+        if (entry->newp) {
+          entry->nr = GS(((ID *)entry->newp)->name);
+        }
+      }
+    }
+  }
+}
+
 /* lib linked proxy objects point to our local data, we need
  * to clear that pointer before reading the undo memfile since
  * the object might be removed, it is set again in reading
@@ -2134,12 +2226,10 @@ void blo_cache_storage_end(FileData *fd)
 /** \name DNA Struct Loading
  * \{ */
 
-static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
+static void switch_endian_structs_data(const struct SDNA *filesdna, BHead *bhead, char *data)
 {
   int blocksize, nblocks;
-  char *data;
 
-  data = (char *)(bhead + 1);
   blocksize = filesdna->types_size[filesdna->structs[bhead->SDNAnr]->type];
 
   nblocks = bhead->nr;
@@ -2150,10 +2240,26 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
+static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
+{
+  switch_endian_structs_data(filesdna, bhead, (char *)(bhead + 1));
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
 
+#ifdef USE_BHEAD_PARALLEL_DECODE
+  {
+    BHeadN *new_bhead = BHEADN_FROM_BHEAD(bh);
+    if (new_bhead->decoded_data != NULL) {
+      temp = new_bhead->decoded_data;
+      new_bhead->decoded_data = NULL;
+      return temp;
+    }
+  }
+#endif
+
   if (bh->len) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
     BHead *bh_orig = bh;
@@ -2218,6 +2324,135 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
   return temp;
 }
 
+#ifdef USE_BHEAD_PARALLEL_DECODE
+
+typedef struct BHeadDecodeData {
+  FileData *fd;
+  BHeadN **bheads;
+} BHeadDecodeData;
+
+/* Whether #read_struct would have to do more than a plain copy of the block's data. */
+static bool bhead_needs_decode(const FileData *fd, const BHead *bhead)
+{
+  if (ELEM(bhead->code, DNA1, TEST, REND, USER, ENDB) || bhead->len == 0) {
+    return false;
+  }
+  const char compflag = fd->compflags[bhead->SDNAnr];
+  if (compflag == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  if (compflag == SDNA_CMP_NOT_EQUAL) {
+    return true;
+  }
+  return (bhead->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN));
+}
+
+static void read_file_bhead_decode_cb(void *__restrict userdata,
+                                      const int index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BHeadDecodeData *data = userdata;
+  FileData *fd = data->fd;
+  BHeadN *new_bhead = data->bheads[index];
+  BHead *bhead = &new_bhead->bhead;
+  char *buf;
+
+  if (new_bhead->has_data) {
+    buf = (char *)(bhead + 1);
+  }
+  else {
+    /* Read from the mapped memory directly, the file offset of `fd` is not thread-safe.
+     * On failure the block is left to #read_struct which handles reporting the error. */
+    buf = MEM_mallocN((size_t)bhead->len, "BHead decoded data");
+    if (!BLI_mmap_read(fd->mmap_file, buf, (size_t)new_bhead->file_offset, (size_t)bhead->len)) {
+      MEM_freeN(buf);
+      return;
+    }
+  }
+
+  if (bhead->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs_data(fd->filesdna, bhead, buf);
+  }
+
+  if (fd->compflags[bhead->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    new_bhead->decoded_data = DNA_struct_reconstruct(
+        fd->reconstruct_info, bhead->SDNAnr, bhead->nr, buf);
+    if (!new_bhead->has_data) {
+      MEM_freeN(buf);
+    }
+  }
+  else if (new_bhead->has_data) {
+    new_bhead->decoded_data = MEM_mallocN((size_t)bhead->len, "BHead decoded data");
+    memcpy(new_bhead->decoded_data, buf, (size_t)bhead->len);
+  }
+  else {
+    new_bhead->decoded_data = buf;
+  }
+}
+
+/**
+ * Read all block headers of a memory-mapped file, then endian switch and reconstruct
+ * the blocks which don't match the current DNA using all threads.
+ * #read_struct then only has to hand over the result.
+ */
+static void read_file_bheads_decode_parallel(FileData *fd)
+{
+  if (fd->mmap_file == NULL || fd->memfile != NULL) {
+    return;
+  }
+
+  if ((fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0) {
+    bool is_dna_equal = true;
+    for (int i = 0; i < fd->filesdna->structs_len; i++) {
+      if (fd->compflags[i] == SDNA_CMP_NOT_EQUAL) {
+        is_dna_equal = false;
+        break;
+      }
+    }
+    if (is_dna_equal) {
+      /* Every block is a plain copy, it's cheaper to keep reading them on demand. */
+      return;
+    }
+  }
+
+  int bheads_len = 0;
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == ENDB) {
+      break;
+    }
+    if (bhead_needs_decode(fd, bhead)) {
+      bheads_len++;
+    }
+  }
+
+  if (bheads_len == 0) {
+    return;
+  }
+
+  BHeadN **bheads = MEM_malloc_arrayN((size_t)bheads_len, sizeof(*bheads), __func__);
+  int i = 0;
+  LISTBASE_FOREACH (BHeadN *, new_bhead, &fd->bhead_list) {
+    if (i < bheads_len && bhead_needs_decode(fd, &new_bhead->bhead)) {
+      bheads[i++] = new_bhead;
+    }
+  }
+  BLI_assert(i == bheads_len);
+
+  BHeadDecodeData data = {
+      .fd = fd,
+      .bheads = bheads,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, bheads_len, &data, read_file_bhead_decode_cb, &settings);
+
+  MEM_freeN(bheads);
+}
+
+#endif /* USE_BHEAD_PARALLEL_DECODE */
+
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
@@ -4044,6 +4279,15 @@ static BHead *read_userdef(BlendFileData *bfd, FileData *fd, BHead *bhead)
 /** \name Read File (Internal)
  * \{ */
 
+/**
+ * Data-blocks which are only used by the UI and editors, skipped with #BLO_READ_SKIP_UI.
+ * Pointers to them from other data-blocks are cleared when linking.
+ */
+static bool read_file_id_code_is_ui_only(const int code)
+{
+  return ELEM(code, ID_WM, ID_WS, ID_SCR, ID_BR, ID_PAL, ID_PC);
+}
+
 BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 {
   BHead *bhead = blo_bhead_first(fd);
@@ -4067,6 +4311,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     BLI_strncpy(bfd->main->name, filepath, sizeof(bfd->main->name));
   }
 
+#ifdef USE_BHEAD_PARALLEL_DECODE
+  if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    read_file_bheads_decode_parallel(fd);
+  }
+#endif
+
   if (G.background) {
     /* We only read & store .blend thumbnail in background mode
      * (because we cannot re-generate it, no OpenGL available).
@@ -4134,6 +4384,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         if (fd->skip_flags & BLO_READ_SKIP_DATA) {
           bhead = blo_bhead_next(fd, bhead);
         }
+        else if ((fd->skip_flags & BLO_READ_SKIP_UI) &&
+                 read_file_id_code_is_ui_only(bhead->code)) {
+          /* The DATA blocks following the ID are skipped too. */
+          bhead = blo_bhead_next(fd, bhead);
+        }
         else {
           bhead = read_libblock(fd, bfd->main, bhead, LIB_TAG_LOCAL, false, NULL);
         }
@@ -5271,6 +5526,7 @@ static void read_library_linked_ids(FileData *basefd,
                                     Main *mainvar)
 {
   GHash *loaded_ids = BLI_ghash_str_new(__func__);
+  GHash *placeholder_map = BLI_ghash_ptr_new(__func__);
 
   ListBase *lbarray[MAX_LIBARRAY];
   int a = set_listbasepointers(mainvar, lbarray);
@@ -5297,10 +5553,10 @@ static void read_library_linked_ids(FileData *basefd,
          * (known case: some directly linked shapekey from a missing lib...). */
         /* BLI_assert(*realid != NULL); */
 
-        /* Now that we have a real ID, replace all pointers to placeholders in
-         * fd->libmap with pointers to the real data-blocks. We do this for all
+        /* Now that we have a real ID, pointers to placeholders in fd->libmap have to be
+         * replaced with pointers to the real data-blocks. This is done for all
          * libraries since multiple might be referencing this ID. */
-        change_link_placeholder_to_real_ID_pointer(mainlist, basefd, id, *realid);
+        BLI_ghash_insert(placeholder_map, id, *realid);
 
         /* We cannot free old lib-ref placeholder ID here anymore, since we use
          * its name as key in loaded_ids hash. */
@@ -5309,34 +5565,48 @@ static void read_library_linked_ids(FileData *basefd,
       id = id_next;
     }
 
+    /* Replace placeholders of the current type, before they get freed. */
+    change_link_placeholders_to_real_ID_pointers(mainlist, basefd, placeholder_map);
+
     /* Clear GHash and free link placeholder IDs of the current type. */
     BLI_ghash_clear(loaded_ids, NULL, NULL);
+    BLI_ghash_clear(placeholder_map, NULL, NULL);
     BLI_freelistN(&pending_free_ids);
   }
 
   BLI_ghash_free(loaded_ids, NULL, NULL);
+  BLI_ghash_free(placeholder_map, NULL, NULL);
 }
 
 static void read_library_clear_weak_links(FileData *basefd, ListBase *mainlist, Main *mainvar)
 {
   /* Any remaining weak links at this point have been lost, silently drop
    * those by setting them to NULL pointers. */
+  GHash *placeholder_map = BLI_ghash_ptr_new(__func__);
   ListBase *lbarray[MAX_LIBARRAY];
   int a = set_listbasepointers(mainvar, lbarray);
 
   while (a--) {
     ID *id = lbarray[a]->first;
+    ListBase pending_free_ids = {NULL};
 
     while (id) {
       ID *id_next = id->next;
       if ((id->tag & LIB_TAG_ID_LINK_PLACEHOLDER) && (id->flag & LIB_INDIRECT_WEAK_LINK)) {
         /* printf("Dropping weak link to %s\n", id->name); */
-        change_link_placeholder_to_real_ID_pointer(mainlist, basefd, id, NULL);
-        BLI_freelinkN(lbarray[a], id);
+        BLI_ghash_insert(placeholder_map, id, NULL);
+        BLI_remlink(lbarray[a], id);
+        BLI_addtail(&pending_free_ids, id);
       }
       id = id_next;
     }
+
+    change_link_placeholders_to_real_ID_pointers(mainlist, basefd, placeholder_map);
+    BLI_ghash_clear(placeholder_map, NULL, NULL);
+    BLI_freelistN(&pending_free_ids);
   }
+
+  BLI_ghash_free(placeholder_map, NULL, NULL);
 }
 
 static FileData *read_library_file_data(FileData *basefd,
@@ -42,6 +42,8 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_hash_mm3.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -273,3 +275,173 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   }
   return true;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Incremental Memfile Saving
+ *
+ * Saving the same undo memfile again (auto-save) mostly writes data which is already on disk.
+ * The size and hash of every chunk written is kept, when saving over the same file again
+ * only the chunks that differ are written, as long as the chunks before them kept their size.
+ * \{ */
+
+typedef struct MemFileWriteChunk {
+  size_t size;
+  uint32_t hash[2];
+} MemFileWriteChunk;
+
+struct MemFileWriteState {
+  char filename[1024]; /* FILE_MAX */
+  /** File size and modification time after writing, to detect external changes. */
+  int64_t file_size;
+  int64_t file_mtime;
+  MemFileWriteChunk *chunks;
+  int chunks_len;
+};
+
+static void memfile_write_chunk_hash(const MemFileChunk *chunk, MemFileWriteChunk *r_chunk)
+{
+  r_chunk->size = chunk->size;
+  r_chunk->hash[0] = BLI_hash_mm2((const uchar *)chunk->buf, chunk->size, 0);
+  r_chunk->hash[1] = BLI_hash_mm3((const uchar *)chunk->buf, chunk->size, 0);
+}
+
+/* Check the file on disk still is the one written with this state. */
+static bool memfile_write_state_is_valid(const MemFileWriteState *state, const char *filename)
+{
+  BLI_stat_t st;
+  if (!STREQ(state->filename, filename) || BLI_stat(filename, &st) != 0) {
+    return false;
+  }
+  return ((int64_t)st.st_size == state->file_size) && ((int64_t)st.st_mtime == state->file_mtime);
+}
+
+void BLO_memfile_write_state_free(MemFileWriteState *state)
+{
+  MEM_SAFE_FREE(state->chunks);
+  MEM_freeN(state);
+}
+
+/**
+ * Saves .blend using undo buffer, only writing the chunks which differ from the previous
+ * save to the same file.
+ *
+ * \param r_state: State of the previous save, updated on success (freed on failure).
+ * \return success.
+ */
+bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                        const char *filename,
+                                        MemFileWriteState **r_state)
+{
+  MemFileWriteState *state = *r_state;
+  if (state != NULL && !memfile_write_state_is_valid(state, filename)) {
+    BLO_memfile_write_state_free(state);
+    *r_state = state = NULL;
+  }
+
+  int oflags = O_BINARY | O_WRONLY | O_CREAT;
+  if (state == NULL) {
+    oflags |= O_TRUNC;
+  }
+#ifdef O_NOFOLLOW
+  /* See #BLO_memfile_write_file. */
+  oflags |= O_NOFOLLOW;
+#endif
+  const int file = BLI_open(filename, oflags, 0666);
+
+  if (file == -1) {
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error opening file");
+    return false;
+  }
+
+  const int chunks_len = BLI_listbase_count(&memfile->chunks);
+  MemFileWriteChunk *chunks = MEM_malloc_arrayN(
+      (size_t)chunks_len, sizeof(*chunks), "MemFileWriteState.chunks");
+
+  /* While the chunks before have the same size, their offset in the file is unchanged. */
+  bool use_previous = (state != NULL);
+  bool is_seek_needed = false;
+  size_t offset = 0;
+  int i = 0;
+  MemFileChunk *chunk;
+  for (chunk = memfile->chunks.first; chunk; chunk = chunk->next, i++) {
+    memfile_write_chunk_hash(chunk, &chunks[i]);
+
+    if (use_previous) {
+      if (i < state->chunks_len && state->chunks[i].size == chunk->size) {
+        if (memcmp(state->chunks[i].hash, chunks[i].hash, sizeof(chunks[i].hash)) == 0) {
+          offset += chunk->size;
+          is_seek_needed = true;
+          continue;
+        }
+      }
+      else {
+        use_previous = false;
+      }
+    }
+
+    if (is_seek_needed) {
+      if (BLI_lseek(file, (int64_t)offset, SEEK_SET) == -1) {
+        break;
+      }
+      is_seek_needed = false;
+    }
+
+#ifdef _WIN32
+    if ((size_t)write(file, chunk->buf, (uint)chunk->size) != chunk->size)
+#else
+    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size)
+#endif
+    {
+      break;
+    }
+    offset += chunk->size;
+  }
+
+  bool ok = (chunk == NULL);
+  if (ok && state != NULL) {
+    /* The previous file may have been bigger. */
+#ifdef _WIN32
+    ok = (_chsize_s(file, (int64_t)offset) == 0);
+#else
+    ok = (ftruncate(file, (int64_t)offset) == 0);
+#endif
+  }
+
+  close(file);
+
+  if (state == NULL) {
+    state = MEM_callocN(sizeof(*state), __func__);
+    BLI_strncpy(state->filename, filename, sizeof(state->filename));
+  }
+  else {
+    MEM_freeN(state->chunks);
+  }
+  state->chunks = chunks;
+  state->chunks_len = chunks_len;
+
+  BLI_stat_t st;
+  if (ok && BLI_stat(filename, &st) == 0) {
+    state->file_size = (int64_t)st.st_size;
+    state->file_mtime = (int64_t)st.st_mtime;
+  }
+  else {
+    ok = false;
+  }
+
+  if (!ok) {
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error writing file");
+    BLO_memfile_write_state_free(state);
+    state = NULL;
+  }
+
+  *r_state = state;
+  return ok;
+}
+
+/** \} */
@@ -101,6 +101,8 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_trace.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -147,6 +149,7 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  WW_WRAP_ZLIB_THREADED,
 } eWriteWrapType;
 
 typedef struct WriteWrap WriteWrap;
@@ -163,6 +166,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct ZlibThreadedWrite *zlib_threaded;
   } _user_data;
 };
 
@@ -218,6 +222,176 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* zlib, compressed using multiple threads */
+
+/**
+ * The stream is split into frames which are compressed as independent gzip members on a task
+ * pool, while the next batch of frames is being filled.
+ * Concatenated gzip members are a valid gzip file, reading uses the regular zlib path.
+ */
+#define WW_ZLIB_FRAME_SIZE (1 << 20) /* 1mb */
+#define WW_ZLIB_FRAMES_MAX 16
+
+typedef struct ZlibFrame {
+  char *data_in;
+  size_t data_in_len;
+  char *data_out;
+  size_t data_out_len;
+  size_t data_out_alloc_len;
+  bool error;
+} ZlibFrame;
+
+typedef struct ZlibThreadedWrite {
+  int file_handle;
+  TaskPool *task_pool;
+  /** Frames written into, swapped with `frames_compress` once they are all full. */
+  ZlibFrame *frames_fill;
+  /** Frames being compressed (or already compressed) by the task pool. */
+  ZlibFrame *frames_compress;
+  int frames_len;
+  int frames_fill_index;
+  int frames_compress_len;
+  bool error;
+} ZlibThreadedWrite;
+
+#define ZLIB_THREADED(ww) (ww)->_user_data.zlib_threaded
+
+static void ww_zlib_threaded_compress_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ZlibFrame *frame = taskdata;
+  z_stream strm = {NULL};
+
+  /* Same compression level as #ww_open_zlib, `16` adds the gzip header. */
+  if (deflateInit2(&strm, 1, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    frame->error = true;
+    return;
+  }
+
+  const size_t data_out_len_max = deflateBound(&strm, (uLong)frame->data_in_len);
+  if (frame->data_out_alloc_len < data_out_len_max) {
+    MEM_SAFE_FREE(frame->data_out);
+    frame->data_out = MEM_mallocN(data_out_len_max, __func__);
+    frame->data_out_alloc_len = data_out_len_max;
+  }
+
+  strm.next_in = (Bytef *)frame->data_in;
+  strm.avail_in = (uInt)frame->data_in_len;
+  strm.next_out = (Bytef *)frame->data_out;
+  strm.avail_out = (uInt)frame->data_out_alloc_len;
+
+  frame->error = (deflate(&strm, Z_FINISH) != Z_STREAM_END);
+  frame->data_out_len = strm.total_out;
+  deflateEnd(&strm);
+}
+
+/* Wait for the frames being compressed and write them out in order. */
+static void ww_zlib_threaded_compress_finish(ZlibThreadedWrite *zt)
+{
+  if (zt->frames_compress_len == 0) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(zt->task_pool);
+
+  for (int i = 0; i < zt->frames_compress_len; i++) {
+    ZlibFrame *frame = &zt->frames_compress[i];
+    if (zt->error || frame->error ||
+        write(zt->file_handle, frame->data_out, frame->data_out_len) !=
+            (ssize_t)frame->data_out_len) {
+      zt->error = true;
+    }
+    frame->data_in_len = 0;
+  }
+  zt->frames_compress_len = 0;
+}
+
+/* Start compressing the frames that were filled, then continue with the other batch. */
+static void ww_zlib_threaded_compress_begin(ZlibThreadedWrite *zt)
+{
+  ww_zlib_threaded_compress_finish(zt);
+
+  SWAP(ZlibFrame *, zt->frames_fill, zt->frames_compress);
+  zt->frames_compress_len = zt->frames_fill_index;
+  if (zt->frames_fill_index < zt->frames_len &&
+      zt->frames_compress[zt->frames_fill_index].data_in_len != 0) {
+    zt->frames_compress_len++;
+  }
+  zt->frames_fill_index = 0;
+
+  for (int i = 0; i < zt->frames_compress_len; i++) {
+    BLI_task_pool_push(
+        zt->task_pool, ww_zlib_threaded_compress_task, &zt->frames_compress[i], false, NULL);
+  }
+}
+
+static bool ww_open_zlib_threaded(WriteWrap *ww, const char *filepath)
+{
+  int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+
+  if (file == -1) {
+    return false;
+  }
+
+  ZlibThreadedWrite *zt = MEM_callocN(sizeof(*zt), __func__);
+  zt->file_handle = file;
+  zt->frames_len = MIN2(BLI_task_scheduler_num_threads(), WW_ZLIB_FRAMES_MAX);
+  zt->frames_fill = MEM_calloc_arrayN(zt->frames_len, sizeof(ZlibFrame), __func__);
+  zt->frames_compress = MEM_calloc_arrayN(zt->frames_len, sizeof(ZlibFrame), __func__);
+  zt->task_pool = BLI_task_pool_create(zt, TASK_PRIORITY_HIGH);
+  ZLIB_THREADED(ww) = zt;
+  return true;
+}
+static bool ww_close_zlib_threaded(WriteWrap *ww)
+{
+  ZlibThreadedWrite *zt = ZLIB_THREADED(ww);
+
+  /* Compress the remaining (possibly partially filled) frames. */
+  ww_zlib_threaded_compress_begin(zt);
+  ww_zlib_threaded_compress_finish(zt);
+
+  BLI_task_pool_free(zt->task_pool);
+  for (int i = 0; i < zt->frames_len; i++) {
+    MEM_SAFE_FREE(zt->frames_fill[i].data_in);
+    MEM_SAFE_FREE(zt->frames_fill[i].data_out);
+    MEM_SAFE_FREE(zt->frames_compress[i].data_in);
+    MEM_SAFE_FREE(zt->frames_compress[i].data_out);
+  }
+  MEM_freeN(zt->frames_fill);
+  MEM_freeN(zt->frames_compress);
+
+  const bool ok = (zt->error == false) && (close(zt->file_handle) != -1);
+  MEM_freeN(zt);
+  return ok;
+}
+static size_t ww_write_zlib_threaded(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  ZlibThreadedWrite *zt = ZLIB_THREADED(ww);
+  size_t len_remaining = buf_len;
+
+  while (len_remaining != 0) {
+    ZlibFrame *frame = &zt->frames_fill[zt->frames_fill_index];
+    if (frame->data_in == NULL) {
+      frame->data_in = MEM_mallocN(WW_ZLIB_FRAME_SIZE, __func__);
+    }
+
+    const size_t len = MIN2(len_remaining, WW_ZLIB_FRAME_SIZE - frame->data_in_len);
+    memcpy(frame->data_in + frame->data_in_len, buf, len);
+    frame->data_in_len += len;
+    buf += len;
+    len_remaining -= len;
+
+    if (frame->data_in_len == WW_ZLIB_FRAME_SIZE) {
+      zt->frames_fill_index++;
+      if (zt->frames_fill_index == zt->frames_len) {
+        ww_zlib_threaded_compress_begin(zt);
+      }
+    }
+  }
+
+  return zt->error ? 0 : buf_len;
+}
+#undef ZLIB_THREADED
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -232,6 +406,14 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_ZLIB_THREADED: {
+      r_ww->open = ww_open_zlib_threaded;
+      r_ww->close = ww_close_zlib_threaded;
+      r_ww->write = ww_write_zlib_threaded;
+      /* Written data is already buffered into frames. */
+      r_ww->use_buf = false;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -1116,14 +1298,11 @@ static bool do_history(const char *name, ReportList *reports)
 /** \name File Writing (Public)
  * \{ */
 
-/**
- * \return Success.
- */
-bool BLO_write_file(Main *mainvar,
-                    const char *filepath,
-                    const int write_flags,
-                    const struct BlendFileWriteParams *params,
-                    ReportList *reports)
+static bool write_file(Main *mainvar,
+                       const char *filepath,
+                       const int write_flags,
+                       const struct BlendFileWriteParams *params,
+                       ReportList *reports)
 {
   char tempname[FILE_MAX + 1];
   eWriteWrapType ww_type;
@@ -1149,7 +1328,7 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
+    ww_type = (BLI_task_scheduler_num_threads() > 1) ? WW_WRAP_ZLIB_THREADED : WW_WRAP_ZLIB;
   }
   else {
     ww_type = WW_WRAP_NONE;
@@ -1264,6 +1443,21 @@ bool BLO_write_file(Main *mainvar,
   return 1;
 }
 
+/**
+ * \return Success.
+ */
+bool BLO_write_file(Main *mainvar,
+                    const char *filepath,
+                    const int write_flags,
+                    const struct BlendFileWriteParams *params,
+                    ReportList *reports)
+{
+  BLI_trace_begin("io", filepath);
+  const bool success = write_file(mainvar, filepath, write_flags, params, reports);
+  BLI_trace_end();
+  return success;
+}
+
 /**
  * \return Success.
  */
@@ -46,6 +46,20 @@
 const BMAllocTemplate bm_mesh_allocsize_default = {512, 1024, 2048, 512};
 const BMAllocTemplate bm_mesh_chunksize_default = {512, 1024, 2048, 512};
 
+/**
+ * Pools expected to hold this many bytes use large chunks,
+ * which spares TLB misses when looping over big meshes.
+ */
+#define BM_MEMPOOL_LARGE_CHUNKS_MIN (16 << 20)
+
+static uint bm_mempool_flag(const size_t elem_size, const int totelem, const uint flag)
+{
+  if ((size_t)totelem * elem_size >= BM_MEMPOOL_LARGE_CHUNKS_MIN) {
+    return flag | BLI_MEMPOOL_LARGE_CHUNKS;
+  }
+  return flag;
+}
+
 static void bm_mempool_init_ex(const BMAllocTemplate *allocsize,
                                const bool use_toolflags,
                                BLI_mempool **r_vpool,
@@ -69,20 +83,24 @@ static void bm_mempool_init_ex(const BMAllocTemplate *allocsize,
   }
 
   if (r_vpool) {
+    const uint flag = bm_mempool_flag(vert_size, allocsize->totvert, BLI_MEMPOOL_ALLOW_ITER);
     *r_vpool = BLI_mempool_create(
-        vert_size, allocsize->totvert, bm_mesh_chunksize_default.totvert, BLI_MEMPOOL_ALLOW_ITER);
+        vert_size, allocsize->totvert, bm_mesh_chunksize_default.totvert, flag);
   }
   if (r_epool) {
+    const uint flag = bm_mempool_flag(edge_size, allocsize->totedge, BLI_MEMPOOL_ALLOW_ITER);
     *r_epool = BLI_mempool_create(
-        edge_size, allocsize->totedge, bm_mesh_chunksize_default.totedge, BLI_MEMPOOL_ALLOW_ITER);
+        edge_size, allocsize->totedge, bm_mesh_chunksize_default.totedge, flag);
   }
   if (r_lpool) {
+    const uint flag = bm_mempool_flag(loop_size, allocsize->totloop, BLI_MEMPOOL_NOP);
     *r_lpool = BLI_mempool_create(
-        loop_size, allocsize->totloop, bm_mesh_chunksize_default.totloop, BLI_MEMPOOL_NOP);
+        loop_size, allocsize->totloop, bm_mesh_chunksize_default.totloop, flag);
   }
   if (r_fpool) {
+    const uint flag = bm_mempool_flag(face_size, allocsize->totface, BLI_MEMPOOL_ALLOW_ITER);
     *r_fpool = BLI_mempool_create(
-        face_size, allocsize->totface, bm_mesh_chunksize_default.totface, BLI_MEMPOOL_ALLOW_ITER);
+        face_size, allocsize->totface, bm_mesh_chunksize_default.totface, flag);
   }
 }
 
@@ -2757,7 +2775,7 @@ void BM_mesh_remap(BMesh *bm, const uint *vert_idx, const uint *edge_idx, const
  * Use new memory pools for this mesh.
  *
  * \note needed for re-sizing elements (adding/removing tool flags)
- * but could also be used for packing fragmented bmeshes.
+ * and for packing fragmented bmeshes, see #BM_mesh_compact.
  */
 void BM_mesh_rebuild(BMesh *bm,
                      const struct BMeshCreateParams *params,
@@ -2779,6 +2797,8 @@ void BM_mesh_rebuild(BMesh *bm,
                                             NULL;
 
   const bool use_toolflags = params->use_toolflags;
+  /* When packing a mesh which already has tool-flags, the flag layers are kept as they are. */
+  const bool keep_toolflags = use_toolflags && bm->use_toolflags;
 
   if (remap & BM_VERT) {
     BMIter iter;
@@ -2787,7 +2807,10 @@ void BM_mesh_rebuild(BMesh *bm,
     BM_ITER_MESH_INDEX (v_src, &iter, bm, BM_VERTS_OF_MESH, index) {
       BMVert *v_dst = BLI_mempool_alloc(vpool_dst);
       memcpy(v_dst, v_src, sizeof(BMVert));
-      if (use_toolflags) {
+      if (keep_toolflags) {
+        ((BMVert_OFlag *)v_dst)->oflags = ((BMVert_OFlag *)v_src)->oflags;
+      }
+      else if (use_toolflags) {
         ((BMVert_OFlag *)v_dst)->oflags = bm->vtoolflagpool ?
                                               BLI_mempool_calloc(bm->vtoolflagpool) :
                                               NULL;
@@ -2805,7 +2828,10 @@ void BM_mesh_rebuild(BMesh *bm,
     BM_ITER_MESH_INDEX (e_src, &iter, bm, BM_EDGES_OF_MESH, index) {
       BMEdge *e_dst = BLI_mempool_alloc(epool_dst);
       memcpy(e_dst, e_src, sizeof(BMEdge));
-      if (use_toolflags) {
+      if (keep_toolflags) {
+        ((BMEdge_OFlag *)e_dst)->oflags = ((BMEdge_OFlag *)e_src)->oflags;
+      }
+      else if (use_toolflags) {
         ((BMEdge_OFlag *)e_dst)->oflags = bm->etoolflagpool ?
                                               BLI_mempool_calloc(bm->etoolflagpool) :
                                               NULL;
@@ -2825,7 +2851,10 @@ void BM_mesh_rebuild(BMesh *bm,
       if (remap & BM_FACE) {
         BMFace *f_dst = BLI_mempool_alloc(fpool_dst);
         memcpy(f_dst, f_src, sizeof(BMFace));
-        if (use_toolflags) {
+        if (keep_toolflags) {
+          ((BMFace_OFlag *)f_dst)->oflags = ((BMFace_OFlag *)f_src)->oflags;
+        }
+        else if (use_toolflags) {
           ((BMFace_OFlag *)f_dst)->oflags = bm->ftoolflagpool ?
                                                 BLI_mempool_calloc(bm->ftoolflagpool) :
                                                 NULL;
@@ -3049,6 +3078,76 @@ void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags)
   bm->use_toolflags = use_toolflags;
 }
 
+/**
+ * Minimum number of unused elements in a memory pool for #BM_mesh_is_fragmented,
+ * so small meshes are never reallocated.
+ */
+#define BM_COMPACT_UNUSED_MIN 4096
+
+static bool bm_mempool_is_fragmented(BLI_mempool *pool)
+{
+  const int used = BLI_mempool_len(pool);
+  const int unused = BLI_mempool_capacity(pool) - used;
+  return (unused >= BM_COMPACT_UNUSED_MIN) && (unused > used);
+}
+
+/**
+ * Check if removed elements left more unused than used memory in the pools of \a bm.
+ */
+bool BM_mesh_is_fragmented(BMesh *bm)
+{
+  return (bm_mempool_is_fragmented(bm->vpool) || bm_mempool_is_fragmented(bm->epool) ||
+          bm_mempool_is_fragmented(bm->lpool) || bm_mempool_is_fragmented(bm->fpool));
+}
+
+/**
+ * Move all elements into new memory pools without any holes, so iterating over the mesh
+ * touches less memory. The order of the elements and so their indices are kept
+ * (which is why they are not re-ordered for locality, as this would change the order of the
+ * elements of the mesh when leaving edit-mode).
+ *
+ * \warning Pointers to elements held outside of the mesh become invalid.
+ * \return false when the mesh can't be compacted because elements are referenced from Python.
+ */
+bool BM_mesh_compact(BMesh *bm)
+{
+  if (CustomData_has_layer(&bm->vdata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->edata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->ldata, CD_BM_ELEM_PYPTR) ||
+      CustomData_has_layer(&bm->pdata, CD_BM_ELEM_PYPTR)) {
+    return false;
+  }
+
+  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+
+  BLI_mempool *vpool_dst = NULL;
+  BLI_mempool *epool_dst = NULL;
+  BLI_mempool *lpool_dst = NULL;
+  BLI_mempool *fpool_dst = NULL;
+
+  bm_mempool_init_ex(
+      &allocsize, bm->use_toolflags, &vpool_dst, &epool_dst, &lpool_dst, &fpool_dst);
+
+  BM_mesh_rebuild(bm,
+                  &((struct BMeshCreateParams){
+                      .use_toolflags = bm->use_toolflags,
+                  }),
+                  vpool_dst,
+                  epool_dst,
+                  lpool_dst,
+                  fpool_dst);
+
+  /* Custom normal spaces reference loops, they are calculated again when needed. */
+  if (bm->lnor_spacearr) {
+    BKE_lnor_spacearr_free(bm->lnor_spacearr);
+    MEM_freeN(bm->lnor_spacearr);
+    bm->lnor_spacearr = NULL;
+    bm->spacearr_dirty |= BM_SPACEARR_DIRTY_ALL;
+  }
+
+  return true;
+}
+
 /* -------------------------------------------------------------------- */
 /** \name BMesh Coordinate Access
  * \{ */
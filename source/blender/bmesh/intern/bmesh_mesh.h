@@ -136,6 +136,9 @@ void BM_mesh_rebuild(BMesh *bm,
                      struct BLI_mempool *lpool,
                      struct BLI_mempool *fpool);
 
+bool BM_mesh_is_fragmented(BMesh *bm);
+bool BM_mesh_compact(BMesh *bm);
+
 typedef struct BMAllocTemplate {
   int totvert, totedge, totloop, totface;
 } BMAllocTemplate;
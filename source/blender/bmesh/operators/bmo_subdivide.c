@@ -27,6 +27,7 @@
 #include "BLI_noise.h"
 #include "BLI_rand.h"
 #include "BLI_stack.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 
@@ -73,6 +74,25 @@ static void bmo_subd_init_shape_info(BMesh *bm, SubDParams *params)
   params->shape_info.totlayer = CustomData_number_of_layers(&bm->vdata, CD_SHAPEKEY);
 }
 
+/* Copy between the coordinates and the temporary shape-key layer of all vertices,
+ * these run over the whole mesh (not only the subdivided part) so are done in parallel. */
+
+static void bmo_subd_shape_store_cb(void *userdata, MempoolIterData *mp_v)
+{
+  const int cd_vert_shape_offset_tmp = *(const int *)userdata;
+  BMVert *v = (BMVert *)mp_v;
+  float *co = BM_ELEM_CD_GET_VOID_P(v, cd_vert_shape_offset_tmp);
+  copy_v3_v3(co, v->co);
+}
+
+static void bmo_subd_shape_restore_cb(void *userdata, MempoolIterData *mp_v)
+{
+  const int cd_vert_shape_offset_tmp = *(const int *)userdata;
+  BMVert *v = (BMVert *)mp_v;
+  const float *co = BM_ELEM_CD_GET_VOID_P(v, cd_vert_shape_offset_tmp);
+  copy_v3_v3(v->co, co);
+}
+
 typedef void (*subd_pattern_fill_fp)(BMesh *bm,
                                      BMFace *face,
                                      BMVert **verts,
@@ -917,8 +937,8 @@ void bmo_subdivide_edges_exec(BMesh *bm, BMOperator *op)
   const SubDPattern *pat;
   SubDParams params;
   BLI_Stack *facedata;
-  BMIter viter, fiter, liter;
-  BMVert *v, **verts = NULL;
+  BMIter fiter, liter;
+  BMVert **verts = NULL;
   BMEdge *edge;
   BMEdge **edges = NULL;
   BLI_array_declare(edges);
@@ -985,10 +1005,11 @@ void bmo_subdivide_edges_exec(BMesh *bm, BMOperator *op)
 
   bmo_subd_init_shape_info(bm, &params);
 
-  BM_ITER_MESH (v, &viter, bm, BM_VERTS_OF_MESH) {
-    float *co = BM_ELEM_CD_GET_VOID_P(v, params.shape_info.cd_vert_shape_offset_tmp);
-    copy_v3_v3(co, v->co);
-  }
+  BM_iter_parallel(bm,
+                   BM_VERTS_OF_MESH,
+                   bmo_subd_shape_store_cb,
+                   &params.shape_info.cd_vert_shape_offset_tmp,
+                   bm->totvert >= BM_OMP_LIMIT);
 
   /* first go through and tag edges */
   BMO_slot_buffer_from_enabled_flag(bm, op, op->slots_in, "edges", BM_EDGE, SUBD_SPLIT);
@@ -1156,10 +1177,11 @@ void bmo_subdivide_edges_exec(BMesh *bm, BMOperator *op)
   }
 
   /* copy original-geometry displacements to current coordinates */
-  BM_ITER_MESH (v, &viter, bm, BM_VERTS_OF_MESH) {
-    const float *co = BM_ELEM_CD_GET_VOID_P(v, params.shape_info.cd_vert_shape_offset_tmp);
-    copy_v3_v3(v->co, co);
-  }
+  BM_iter_parallel(bm,
+                   BM_VERTS_OF_MESH,
+                   bmo_subd_shape_restore_cb,
+                   &params.shape_info.cd_vert_shape_offset_tmp,
+                   bm->totvert >= BM_OMP_LIMIT);
 
   for (; !BLI_stack_is_empty(facedata); BLI_stack_discard(facedata)) {
     SubDFaceData *fd = BLI_stack_peek(facedata);
@@ -1300,10 +1322,11 @@ void bmo_subdivide_edges_exec(BMesh *bm, BMOperator *op)
   }
 
   /* copy original-geometry displacements to current coordinates */
-  BM_ITER_MESH (v, &viter, bm, BM_VERTS_OF_MESH) {
-    const float *co = BM_ELEM_CD_GET_VOID_P(v, params.shape_info.cd_vert_shape_offset_tmp);
-    copy_v3_v3(v->co, co);
-  }
+  BM_iter_parallel(bm,
+                   BM_VERTS_OF_MESH,
+                   bmo_subd_shape_restore_cb,
+                   &params.shape_info.cd_vert_shape_offset_tmp,
+                   bm->totvert >= BM_OMP_LIMIT);
 
   BM_data_layer_free_n(bm, &bm->vdata, CD_SHAPEKEY, params.shape_info.tmpkey);
 
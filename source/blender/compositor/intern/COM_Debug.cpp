@@ -88,6 +88,12 @@ void DebugInfo::execute_started(const ExecutionSystem *system)
   }
 }
 
+void DebugInfo::execute_finished(const ExecutionSystem *system)
+{
+  printf("Compositor: peak memory of buffers %.2f MB\n",
+         (double)system->m_buffers_peak_size / (1024.0 * 1024.0));
+}
+
 void DebugInfo::node_added(const Node *node)
 {
   m_node_names[node] = std::string(node->getbNode() ? node->getbNode()->name : "");
@@ -507,6 +513,9 @@ void DebugInfo::convert_started()
 void DebugInfo::execute_started(const ExecutionSystem * /*system*/)
 {
 }
+void DebugInfo::execute_finished(const ExecutionSystem * /*system*/)
+{
+}
 void DebugInfo::node_added(const Node * /*node*/)
 {
 }
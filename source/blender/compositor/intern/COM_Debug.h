@@ -41,6 +41,7 @@ class DebugInfo {
 
   static void convert_started();
   static void execute_started(const ExecutionSystem *system);
+  static void execute_finished(const ExecutionSystem *system);
 
   static void node_added(const Node *node);
   static void node_to_operations(const Node *node);
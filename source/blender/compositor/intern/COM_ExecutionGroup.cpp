@@ -525,6 +525,22 @@ bool ExecutionGroup::scheduleChunk(unsigned int chunkNumber)
   return false;
 }
 
+void ExecutionGroup::allocateBuffers(ExecutionSystem *graph)
+{
+  NodeOperation *operation = this->getOutputOperation();
+  if (operation->isWriteBufferOperation()) {
+    WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+    MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+    if (memoryProxy->getBuffer() == nullptr) {
+      writeOperation->allocateBuffer();
+      graph->bufferAllocated(memoryProxy->getBuffer());
+    }
+  }
+  for (NodeOperation *readOperation : this->m_cachedReadOperations) {
+    ((ReadBufferOperation *)readOperation)->updateMemoryBuffer();
+  }
+}
+
 bool ExecutionGroup::scheduleChunkWhenPossible(ExecutionSystem *graph, int xChunk, int yChunk)
 {
   if (xChunk < 0 || xChunk >= (int)this->m_numberOfXChunks) {
@@ -573,6 +589,7 @@ bool ExecutionGroup::scheduleChunkWhenPossible(ExecutionSystem *graph, int xChun
   }
 
   if (canBeExecuted) {
+    allocateBuffers(graph);
     scheduleChunk(chunkNumber);
   }
 
@@ -596,6 +613,16 @@ void ExecutionGroup::determineDependingMemoryProxies(vector<MemoryProxy *> *memo
   }
 }
 
+bool ExecutionGroup::isExecuted() const
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ExecutionGroup::isOpenCL()
 {
   return this->m_openCL;
@@ -240,6 +240,14 @@ class ExecutionGroup {
    */
   bool scheduleChunk(unsigned int chunkNumber);
 
+  /**
+   * \brief allocate the buffer written by this ExecutionGroup and connect the read operations
+   * to the buffers of their MemoryProxy.
+   * \note called before scheduling a chunk, when all its inputs are available.
+   * \param graph: the ExecutionSystem keeping track of the allocated memory
+   */
+  void allocateBuffers(ExecutionSystem *graph);
+
   /**
    * \brief determine the area of interest of a certain input area
    * \note This method only evaluates a single ReadBufferOperation
@@ -407,6 +415,12 @@ class ExecutionGroup {
    */
   void determineDependingMemoryProxies(vector<MemoryProxy *> *memoryProxies);
 
+  /**
+   * \brief are all chunks of this ExecutionGroup executed
+   * \note chunks that are not needed by any output are never executed.
+   */
+  bool isExecuted() const;
+
   /**
    * \brief Determine the rect (minx, maxx, miny, maxy) of a chunk.
    * \note Only gives useful results after the determination of the chunksize
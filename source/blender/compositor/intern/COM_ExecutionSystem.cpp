@@ -18,6 +18,9 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include <algorithm>
+#include <set>
+
 #include "BLI_utildefines.h"
 #include "PIL_time.h"
 
@@ -32,6 +35,7 @@
 #include "COM_NodeOperationBuilder.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_WorkScheduler.h"
+#include "COM_WriteBufferOperation.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
@@ -46,6 +50,9 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  const ColorManagedDisplaySettings *displaySettings,
                                  const char *viewName)
 {
+  this->m_buffers_size = 0;
+  this->m_buffers_peak_size = 0;
+
   this->m_context.setViewName(viewName);
   this->m_context.setScene(scene);
   this->m_context.setbNodeTree(editingtree);
@@ -147,7 +154,7 @@ void ExecutionSystem::execute()
   }
   unsigned int index;
 
-  // First allocale all write buffer
+  // First initialize all write buffers, their memory is allocated when first scheduled
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
     if (operation->isWriteBufferOperation()) {
@@ -155,14 +162,6 @@ void ExecutionSystem::execute()
       operation->initExecution();
     }
   }
-  // Connect read buffers to their write buffers
-  for (index = 0; index < this->m_operations.size(); index++) {
-    NodeOperation *operation = this->m_operations[index];
-    if (operation->isReadBufferOperation()) {
-      ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
-      readOperation->updateMemoryBuffer();
-    }
-  }
   // initialize other operations
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -188,6 +187,8 @@ void ExecutionSystem::execute()
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  DebugInfo::execute_finished(this);
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -208,6 +209,47 @@ void ExecutionSystem::executeGroups(CompositorPriority priority)
   for (index = 0; index < executionGroups.size(); index++) {
     ExecutionGroup *group = executionGroups[index];
     group->execute(this);
+    freeUnusedBuffers();
+  }
+}
+
+static size_t buffer_size(MemoryBuffer *buffer)
+{
+  return sizeof(float) * buffer->get_num_channels() * buffer->getWidth() * buffer->getHeight();
+}
+
+void ExecutionSystem::bufferAllocated(MemoryBuffer *buffer)
+{
+  this->m_buffers_size += buffer_size(buffer);
+  this->m_buffers_peak_size = std::max(this->m_buffers_peak_size, this->m_buffers_size);
+}
+
+void ExecutionSystem::freeUnusedBuffers()
+{
+  std::set<MemoryProxy *> usedProxies;
+  for (ExecutionGroup *group : this->m_groups) {
+    if (!group->isExecuted()) {
+      vector<MemoryProxy *> memoryProxies;
+      group->determineDependingMemoryProxies(&memoryProxies);
+      usedProxies.insert(memoryProxies.begin(), memoryProxies.end());
+    }
+  }
+
+  for (NodeOperation *operation : this->m_operations) {
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    MemoryProxy *memoryProxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+    MemoryBuffer *buffer = memoryProxy->getBuffer();
+    if (buffer == nullptr || usedProxies.count(memoryProxy)) {
+      continue;
+    }
+    ExecutionGroup *executor = memoryProxy->getExecutor();
+    if (executor != nullptr && !executor->isExecuted()) {
+      continue;
+    }
+    this->m_buffers_size -= buffer_size(buffer);
+    memoryProxy->free();
   }
 }
 
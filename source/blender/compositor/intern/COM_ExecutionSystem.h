@@ -133,6 +133,16 @@ class ExecutionSystem {
    */
   Groups m_groups;
 
+  /**
+   * \brief size in bytes of the write buffers that are currently allocated
+   */
+  size_t m_buffers_size;
+
+  /**
+   * \brief largest size in bytes of the allocated write buffers during the execution
+   */
+  size_t m_buffers_peak_size;
+
  private:  // methods
   /**
    * find all execution group with output nodes
@@ -185,9 +195,22 @@ class ExecutionSystem {
     return this->m_context;
   }
 
+  /**
+   * \brief keep track of the memory used by a newly allocated write buffer
+   */
+  void bufferAllocated(MemoryBuffer *buffer);
+
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief free the write buffers that will not be read anymore.
+   * A buffer is not needed anymore when the ExecutionGroup writing it and all ExecutionGroup's
+   * reading it have executed all their chunks. Buffers read by groups that only execute part
+   * of their chunks are kept until the end of the execution.
+   */
+  void freeUnusedBuffers();
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
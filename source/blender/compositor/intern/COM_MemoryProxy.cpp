@@ -22,6 +22,7 @@ MemoryProxy::MemoryProxy(DataType datatype)
 {
   this->m_writeBufferOperation = nullptr;
   this->m_executor = nullptr;
+  this->m_buffer = nullptr;
   this->m_datatype = datatype;
 }
 
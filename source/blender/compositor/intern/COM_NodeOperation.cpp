@@ -20,10 +20,23 @@
 #include <typeinfo>
 
 #include "COM_ExecutionSystem.h"
+#include "COM_ReadBufferOperation.h"
 #include "COM_defines.h"
 
 #include "COM_NodeOperation.h" /* own include */
 
+/*******************
+ **** AreaInput ****
+ *******************/
+
+const float *AreaInput::get_elem(int x, int y) const
+{
+  if (buffer == nullptr) {
+    return constant;
+  }
+  return buffer->getBuffer() + ((size_t)y * buffer->getWidth() + x) * elem_stride;
+}
+
 /*******************
  **** NodeOperation ****
  *******************/
@@ -36,6 +49,7 @@ NodeOperation::NodeOperation()
   this->m_height = 0;
   this->m_isResolutionSet = false;
   this->m_openCL = false;
+  this->m_areaExecution = false;
   this->m_btree = nullptr;
 }
 
@@ -101,6 +115,54 @@ void NodeOperation::determineResolution(unsigned int resolution[2],
     }
   }
 }
+bool NodeOperation::executeAreaFromInputs(MemoryBuffer *output, const rcti &area)
+{
+  if (!this->m_areaExecution) {
+    return false;
+  }
+
+  std::vector<AreaInput> inputs(m_inputs.size());
+  for (unsigned int index = 0; index < m_inputs.size(); index++) {
+    NodeOperation *operation = getInputOperation(index);
+    AreaInput &input = inputs[index];
+    input.buffer = nullptr;
+    zero_v4(input.constant);
+    input.elem_stride = 0;
+
+    if (operation == nullptr) {
+      return false;
+    }
+    if (operation->isSetOperation()) {
+      operation->readSampled(input.constant, 0.0f, 0.0f, COM_PS_NEAREST);
+    }
+    else if (operation->isReadBufferOperation()) {
+      ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+      MemoryBuffer *buffer = readOperation->getMemoryBuffer();
+      if (buffer == nullptr) {
+        return false;
+      }
+      if (readOperation->isSingleValue()) {
+        /* write buffer has a single value stored at (0,0) */
+        buffer->read(input.constant, 0, 0);
+      }
+      else if (buffer->getWidth() == (int)this->m_width &&
+               buffer->getHeight() == (int)this->m_height) {
+        input.buffer = buffer;
+        input.elem_stride = buffer->get_num_channels();
+      }
+      else {
+        return false;
+      }
+    }
+    else {
+      return false;
+    }
+  }
+
+  executeArea(output, area, inputs);
+  return true;
+}
+
 void NodeOperation::setResolutionInputSocketIndex(unsigned int index)
 {
   this->m_resolutionInputSocketIndex = index;
@@ -44,6 +44,33 @@ class WriteBufferOperation;
 class NodeOperationInput;
 class NodeOperationOutput;
 
+/**
+ * \brief Input of NodeOperation.executeArea
+ * Either the buffer of a buffered input or the value of a constant input.
+ * \ingroup Model
+ */
+struct AreaInput {
+  /**
+   * \brief buffer of the input, nullptr for constant inputs
+   */
+  MemoryBuffer *buffer;
+
+  /**
+   * \brief value of constant inputs
+   */
+  float constant[4];
+
+  /**
+   * \brief number of floats between two horizontally adjacent elements, 0 for constant inputs
+   */
+  int elem_stride;
+
+  /**
+   * \brief get the element at the given location, advance by elem_stride for the next one
+   */
+  const float *get_elem(int x, int y) const;
+};
+
 /**
  * \brief Resize modes of inputsockets
  * How are the input and working resolutions matched
@@ -102,6 +129,11 @@ class NodeOperation : public SocketReader {
    */
   bool m_openCL;
 
+  /**
+   * \brief can this operation calculate whole areas at once, see NodeOperation.executeArea
+   */
+  bool m_areaExecution;
+
   /**
    * \brief mutex reference for very special node initializations
    * \note only use when you really know what you are doing.
@@ -200,6 +232,26 @@ class NodeOperation : public SocketReader {
   {
   }
 
+  /**
+   * \brief calculate all pixels of an area at once instead of reading them one by one
+   * \note this method is only called when area execution is enabled, and all inputs are
+   * buffers or constants. \see NodeOperation.executeAreaFromInputs
+   * \param output: the buffer to write to, with the resolution of this operation
+   * \param area: the area to calculate
+   * \param inputs: the inputs in socket order
+   */
+  virtual void executeArea(MemoryBuffer * /*output*/,
+                           const rcti & /*area*/,
+                           const std::vector<AreaInput> & /*inputs*/)
+  {
+  }
+
+  /**
+   * \brief calculate the area with executeArea when the inputs allow it
+   * \return false when the pixels have to be read one by one instead
+   */
+  bool executeAreaFromInputs(MemoryBuffer *output, const rcti &area);
+
   /**
    * \brief when a chunk is executed by an OpenCLDevice, this method is called
    * \ingroup execution
@@ -420,6 +472,17 @@ class NodeOperation : public SocketReader {
     this->m_openCL = openCL;
   }
 
+  /**
+   * \brief set if this NodeOperation implements executeArea
+   *
+   * Only for operations where every output pixel depends on the input pixels at the same
+   * location.
+   */
+  void setAreaExecution(bool areaExecution)
+  {
+    this->m_areaExecution = areaExecution;
+  }
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
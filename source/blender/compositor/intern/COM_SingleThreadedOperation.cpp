@@ -17,6 +17,146 @@
  */
 
 #include "COM_SingleThreadedOperation.h"
+#include "COM_ReadBufferOperation.h"
+
+#include <cstring>
+#include <list>
+#include <typeinfo>
+
+/**
+ * Results of previous executions, most recently used first.
+ *
+ * Single threaded operations compute full frames and are typically expensive (denoise, glare),
+ * so their results are reused as long as their settings and inputs did not change, for example
+ * while tweaking nodes after them.
+ */
+#define RESULT_CACHE_MAX_BYTES ((size_t)1024 * 1024 * 1024)
+
+struct ResultCacheEntry {
+  uint64_t key;
+  MemoryBuffer *buffer;
+  size_t bytes;
+};
+
+static std::list<ResultCacheEntry> s_result_cache;
+static ThreadMutex s_result_cache_mutex = BLI_MUTEX_INITIALIZER;
+
+static MemoryBuffer *result_cache_lookup(const uint64_t key, const DataType datatype)
+{
+  MemoryBuffer *result = nullptr;
+
+  BLI_mutex_lock(&s_result_cache_mutex);
+  for (std::list<ResultCacheEntry>::iterator it = s_result_cache.begin();
+       it != s_result_cache.end();
+       ++it) {
+    if (it->key == key) {
+      result = new MemoryBuffer(datatype, it->buffer->getRect());
+      result->copyContentFrom(it->buffer);
+      s_result_cache.splice(s_result_cache.begin(), s_result_cache, it);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&s_result_cache_mutex);
+
+  return result;
+}
+
+static void result_cache_add(const uint64_t key, const DataType datatype, MemoryBuffer *buffer)
+{
+  ResultCacheEntry entry;
+  entry.key = key;
+  entry.buffer = new MemoryBuffer(datatype, buffer->getRect());
+  entry.buffer->copyContentFrom(buffer);
+  entry.bytes = sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+                buffer->get_num_channels();
+
+  BLI_mutex_lock(&s_result_cache_mutex);
+  s_result_cache.push_front(entry);
+
+  /* Keep at least the newest result. */
+  size_t total_bytes = 0;
+  for (std::list<ResultCacheEntry>::iterator it = s_result_cache.begin();
+       it != s_result_cache.end();) {
+    total_bytes += it->bytes;
+    if (it != s_result_cache.begin() && total_bytes > RESULT_CACHE_MAX_BYTES) {
+      delete it->buffer;
+      it = s_result_cache.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  BLI_mutex_unlock(&s_result_cache_mutex);
+}
+
+void SingleThreadedOperation::clearResultCache()
+{
+  BLI_mutex_lock(&s_result_cache_mutex);
+  for (ResultCacheEntry &entry : s_result_cache) {
+    delete entry.buffer;
+  }
+  s_result_cache.clear();
+  BLI_mutex_unlock(&s_result_cache_mutex);
+}
+
+uint64_t SingleThreadedOperation::hashBuffer(const void *data, size_t size, uint64_t hash)
+{
+  const char *bytes = (const char *)data;
+  const size_t words_num = size / sizeof(uint64_t);
+  for (size_t i = 0; i < words_num; i++) {
+    uint64_t word;
+    memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * 0x100000001b3ull;
+    hash ^= hash >> 29;
+  }
+  for (size_t i = words_num * sizeof(uint64_t); i < size; i++) {
+    hash = (hash ^ (uint64_t)bytes[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/* Key of the result from the operation type, its settings, resolution and the content of its
+ * inputs. Returns false when the result can not be reused. */
+bool SingleThreadedOperation::determineResultKey(uint64_t *r_key)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  if (!hashSettings(&hash)) {
+    return false;
+  }
+
+  const char *type_name = typeid(*this).name();
+  hash = hashBuffer(type_name, strlen(type_name), hash);
+  const unsigned int resolution[2] = {getWidth(), getHeight()};
+  hash = hashBuffer(resolution, sizeof(resolution), hash);
+
+  for (unsigned int index = 0; index < getNumberOfInputSockets(); index++) {
+    NodeOperation *operation = getInputOperation(index);
+    if (operation == nullptr) {
+      return false;
+    }
+    if (operation->isSetOperation()) {
+      float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+      hash = hashBuffer(value, sizeof(value), hash);
+    }
+    else if (operation->isReadBufferOperation()) {
+      MemoryBuffer *buffer = ((ReadBufferOperation *)operation)->getMemoryBuffer();
+      if (buffer == nullptr) {
+        return false;
+      }
+      const int size[3] = {
+          buffer->getWidth(), buffer->getHeight(), (int)buffer->get_num_channels()};
+      hash = hashBuffer(size, sizeof(size), hash);
+      hash = hashBuffer(buffer->getBuffer(), sizeof(float) * size[0] * size[1] * size[2], hash);
+    }
+    else {
+      return false;
+    }
+  }
+
+  *r_key = hash;
+  return true;
+}
 
 SingleThreadedOperation::SingleThreadedOperation()
 {
@@ -50,8 +190,18 @@ void *SingleThreadedOperation::initializeTileData(rcti *rect)
 
   lockMutex();
   if (this->m_cachedInstance == nullptr) {
-    //
-    this->m_cachedInstance = createMemoryBuffer(rect);
+    const DataType datatype = getOutputSocket()->getDataType();
+    uint64_t key;
+    const bool use_result_cache = determineResultKey(&key);
+    if (use_result_cache) {
+      this->m_cachedInstance = result_cache_lookup(key, datatype);
+    }
+    if (this->m_cachedInstance == nullptr) {
+      this->m_cachedInstance = createMemoryBuffer(rect);
+      if (use_result_cache && !isBraked()) {
+        result_cache_add(key, datatype, this->m_cachedInstance);
+      }
+    }
   }
   unlockMutex();
   return this->m_cachedInstance;
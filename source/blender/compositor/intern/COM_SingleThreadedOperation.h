@@ -24,12 +24,26 @@ class SingleThreadedOperation : public NodeOperation {
  private:
   MemoryBuffer *m_cachedInstance;
 
+  bool determineResultKey(uint64_t *r_key);
+
  protected:
   inline bool isCached()
   {
     return this->m_cachedInstance != NULL;
   }
 
+  /**
+   * Hash of the settings the result depends on besides the inputs, so the result can be reused
+   * by later executions with the same settings and inputs.
+   * Returns false when results can not be reused.
+   */
+  virtual bool hashSettings(uint64_t * /*r_hash*/)
+  {
+    return false;
+  }
+
+  static uint64_t hashBuffer(const void *data, size_t size, uint64_t hash);
+
  public:
   SingleThreadedOperation();
 
@@ -56,4 +70,9 @@ class SingleThreadedOperation : public NodeOperation {
   {
     return true;
   }
+
+  /**
+   * Free the results kept for later executions.
+   */
+  static void clearResultCache();
 };
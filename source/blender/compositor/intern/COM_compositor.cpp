@@ -25,6 +25,7 @@
 
 #include "COM_ExecutionSystem.h"
 #include "COM_MovieDistortionOperation.h"
+#include "COM_SingleThreadedOperation.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 #include "clew.h"
@@ -113,6 +114,7 @@ void COM_deinitialize()
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
+    SingleThreadedOperation::clearResultCache();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
     BLI_mutex_end(&s_compositorMutex);
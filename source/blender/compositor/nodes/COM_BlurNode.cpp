@@ -142,6 +142,7 @@ void BlurNode::convertToOperations(NodeConverter &converter,
 
     if (!connectedSizeSocket) {
       operation->setSize(size);
+      operation->checkOpenCL();
     }
 
     input_operation = operation;
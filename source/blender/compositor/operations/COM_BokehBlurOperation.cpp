@@ -20,8 +20,13 @@
 #include "BLI_math.h"
 #include "COM_OpenCLDevice.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "RE_pipeline.h"
 
+/* Largest radius for which the bokeh input is stored in a kernel, to bound memory usage. */
+#define MAX_BOKEH_KERNEL_RADIUS 256
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->addInputSocket(COM_DT_COLOR);
@@ -39,6 +44,8 @@ BokehBlurOperation::BokehBlurOperation()
   this->m_inputBoundingBoxReader = nullptr;
 
   this->m_extend_bounds = false;
+  this->m_bokehKernel = nullptr;
+  this->m_bokehKernelRadius = 0;
 }
 
 void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
@@ -47,11 +54,41 @@ void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
   if (!this->m_sizeavailable) {
     updateSize();
   }
+  if (this->m_bokehKernel == nullptr) {
+    const float max_dim = max(this->getWidth(), this->getHeight());
+    updateBokehKernel(this->m_size * max_dim / 100.0f);
+  }
   void *buffer = getInputOperation(0)->initializeTileData(nullptr);
   unlockMutex();
   return buffer;
 }
 
+/**
+ * Read the bokeh input once for every offset within the blur radius, instead of sampling it
+ * for every pixel of the kernel of every output pixel.
+ */
+void BokehBlurOperation::updateBokehKernel(int pixelSize)
+{
+  if (pixelSize < 2 || pixelSize > MAX_BOKEH_KERNEL_RADIUS) {
+    return;
+  }
+  const int kernel_size = 2 * pixelSize + 1;
+  float *kernel = (float *)MEM_mallocN(
+      sizeof(float) * COM_NUM_CHANNELS_COLOR * kernel_size * kernel_size, __func__);
+  const float m = this->m_bokehDimension / pixelSize;
+  for (int dy = -pixelSize; dy <= pixelSize; dy++) {
+    float *kernel_row = &kernel[(dy + pixelSize) * kernel_size * COM_NUM_CHANNELS_COLOR];
+    for (int dx = -pixelSize; dx <= pixelSize; dx++) {
+      const float u = this->m_bokehMidX - dx * m;
+      const float v = this->m_bokehMidY - dy * m;
+      this->m_inputBokehProgram->readSampled(
+          &kernel_row[(dx + pixelSize) * COM_NUM_CHANNELS_COLOR], u, v, COM_PS_NEAREST);
+    }
+  }
+  this->m_bokehKernelRadius = pixelSize;
+  this->m_bokehKernel = kernel;
+}
+
 void BokehBlurOperation::initExecution()
 {
   initMutex();
@@ -107,17 +144,35 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
     int step = getStep();
     int offsetadd = getOffsetAdd() * COM_NUM_CHANNELS_COLOR;
 
-    float m = this->m_bokehDimension / pixelSize;
-    for (int ny = miny; ny < maxy; ny += step) {
-      int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
-                        ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
-      for (int nx = minx; nx < maxx; nx += step) {
-        float u = this->m_bokehMidX - (nx - x) * m;
-        float v = this->m_bokehMidY - (ny - y) * m;
-        this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
-        madd_v4_v4v4(color_accum, bokeh, &buffer[bufferindex]);
-        add_v4_v4(multiplier_accum, bokeh);
-        bufferindex += offsetadd;
+    if (this->m_bokehKernel != nullptr && this->m_bokehKernelRadius == pixelSize) {
+      const int kernel_size = 2 * pixelSize + 1;
+      for (int ny = miny; ny < maxy; ny += step) {
+        int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
+                          ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
+        const float *weight = &this->m_bokehKernel[((ny - y + pixelSize) * kernel_size +
+                                                    (minx - x + pixelSize)) *
+                                                   COM_NUM_CHANNELS_COLOR];
+        for (int nx = minx; nx < maxx; nx += step) {
+          madd_v4_v4v4(color_accum, weight, &buffer[bufferindex]);
+          add_v4_v4(multiplier_accum, weight);
+          weight += step * COM_NUM_CHANNELS_COLOR;
+          bufferindex += offsetadd;
+        }
+      }
+    }
+    else {
+      float m = this->m_bokehDimension / pixelSize;
+      for (int ny = miny; ny < maxy; ny += step) {
+        int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
+                          ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
+        for (int nx = minx; nx < maxx; nx += step) {
+          float u = this->m_bokehMidX - (nx - x) * m;
+          float v = this->m_bokehMidY - (ny - y) * m;
+          this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
+          madd_v4_v4v4(color_accum, bokeh, &buffer[bufferindex]);
+          add_v4_v4(multiplier_accum, bokeh);
+          bufferindex += offsetadd;
+        }
       }
     }
     output[0] = color_accum[0] * (1.0f / multiplier_accum[0]);
@@ -133,6 +188,10 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 void BokehBlurOperation::deinitExecution()
 {
   deinitMutex();
+  if (this->m_bokehKernel) {
+    MEM_freeN(this->m_bokehKernel);
+    this->m_bokehKernel = nullptr;
+  }
   this->m_inputProgram = nullptr;
   this->m_inputBokehProgram = nullptr;
   this->m_inputBoundingBoxReader = nullptr;
@@ -33,6 +33,10 @@ class BokehBlurOperation : public NodeOperation, public QualityStepHelper {
   float m_bokehMidY;
   float m_bokehDimension;
   bool m_extend_bounds;
+  /** Weights of the bokeh input per offset from the center, see #updateBokehKernel. */
+  float *m_bokehKernel;
+  int m_bokehKernelRadius;
+  void updateBokehKernel(int pixelSize);
 
  public:
   BokehBlurOperation();
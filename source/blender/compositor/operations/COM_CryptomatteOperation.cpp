@@ -38,7 +38,7 @@ void CryptomatteOperation::initExecution()
 void CryptomatteOperation::addObjectIndex(float objectIndex)
 {
   if (objectIndex != 0.0f) {
-    m_objectIndex.push_back(objectIndex);
+    m_objectIndex.insert(objectIndex);
   }
 }
 
@@ -58,13 +58,11 @@ void CryptomatteOperation::executePixel(float output[4], int x, int y, void *dat
       output[1] = ((float)((m3hash << 8)) / (float)UINT32_MAX);
       output[2] = ((float)((m3hash << 16)) / (float)UINT32_MAX);
     }
-    for (size_t i = 0; i < m_objectIndex.size(); i++) {
-      if (m_objectIndex[i] == input[0]) {
-        output[3] += input[1];
-      }
-      if (m_objectIndex[i] == input[2]) {
-        output[3] += input[3];
-      }
+    if (m_objectIndex.count(input[0])) {
+      output[3] += input[1];
+    }
+    if (m_objectIndex.count(input[2])) {
+      output[3] += input[3];
     }
   }
 }
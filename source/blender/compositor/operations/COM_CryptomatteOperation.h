@@ -20,9 +20,12 @@
 
 #include "COM_NodeOperation.h"
 
+#include <unordered_set>
+
 class CryptomatteOperation : public NodeOperation {
  private:
-  std::vector<float> m_objectIndex;
+  /** Encoded hashes of the selected objects, looked up for every layer of every pixel. */
+  std::unordered_set<float> m_objectIndex;
 
  public:
   std::vector<SocketReader *> inputs;
@@ -66,6 +66,14 @@ MemoryBuffer *DenoiseOperation::createMemoryBuffer(rcti *rect2)
   return result;
 }
 
+bool DenoiseOperation::hashSettings(uint64_t *r_hash)
+{
+  if (this->m_settings) {
+    *r_hash = hashBuffer(this->m_settings, sizeof(NodeDenoise), *r_hash);
+  }
+  return true;
+}
+
 bool DenoiseOperation::determineDependingAreaOfInterest(rcti * /*input*/,
                                                         ReadBufferOperation *readOperation,
                                                         rcti *output)
@@ -62,5 +62,7 @@ class DenoiseOperation : public SingleThreadedOperation {
                        MemoryBuffer *inputTileAlbedo,
                        NodeDenoise *settings);
 
+  bool hashSettings(uint64_t *r_hash);
+
   MemoryBuffer *createMemoryBuffer(rcti *rect);
 };
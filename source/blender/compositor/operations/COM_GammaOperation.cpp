@@ -26,6 +26,7 @@ GammaOperation::GammaOperation()
   this->addOutputSocket(COM_DT_COLOR);
   this->m_inputProgram = nullptr;
   this->m_inputGammaProgram = nullptr;
+  this->setAreaExecution(true);
 }
 void GammaOperation::initExecution()
 {
@@ -49,6 +50,31 @@ void GammaOperation::executePixelSampled(float output[4], float x, float y, Pixe
   output[3] = inputValue[3];
 }
 
+void GammaOperation::executeArea(MemoryBuffer *output,
+                                 const rcti &area,
+                                 const std::vector<AreaInput> &inputs)
+{
+  const int num_channels = output->get_num_channels();
+  for (int y = area.ymin; y < area.ymax; y++) {
+    float *out = output->getBuffer() +
+                 ((size_t)y * output->getWidth() + area.xmin) * num_channels;
+    const float *in_value = inputs[0].get_elem(area.xmin, y);
+    const float *in_gamma = inputs[1].get_elem(area.xmin, y);
+    for (int x = area.xmin; x < area.xmax; x++) {
+      const float gamma = in_gamma[0];
+      /* check for negative to avoid nan's */
+      out[0] = in_value[0] > 0.0f ? powf(in_value[0], gamma) : in_value[0];
+      out[1] = in_value[1] > 0.0f ? powf(in_value[1], gamma) : in_value[1];
+      out[2] = in_value[2] > 0.0f ? powf(in_value[2], gamma) : in_value[2];
+      out[3] = in_value[3];
+
+      out += num_channels;
+      in_value += inputs[0].elem_stride;
+      in_gamma += inputs[1].elem_stride;
+    }
+  }
+}
+
 void GammaOperation::deinitExecution()
 {
   this->m_inputProgram = nullptr;
@@ -18,6 +18,7 @@
 
 #include "COM_GaussianBokehBlurOperation.h"
 #include "BLI_math.h"
+#include "COM_OpenCLDevice.h"
 #include "MEM_guardedalloc.h"
 
 #include "RE_pipeline.h"
@@ -150,6 +151,46 @@ void GaussianBokehBlurOperation::executePixel(float output[4], int x, int y, voi
   mul_v4_v4fl(output, tempColor, 1.0f / multiplier_accum);
 }
 
+void GaussianBokehBlurOperation::executeOpenCL(OpenCLDevice *device,
+                                               MemoryBuffer *outputMemoryBuffer,
+                                               cl_mem clOutputBuffer,
+                                               MemoryBuffer **inputMemoryBuffers,
+                                               list<cl_mem> *clMemToCleanUp,
+                                               list<cl_kernel> * /*clKernelsToCleanUp*/)
+{
+  lockMutex();
+  updateGauss();
+  unlockMutex();
+
+  cl_kernel gaussianBokehBlurOperationKernel = device->COM_clCreateKernel(
+      "gaussianBokehBlurOperationKernel", nullptr);
+  cl_int2 radius = {{this->m_radx, this->m_rady}};
+
+  cl_mem gausstab = clCreateBuffer(device->getContext(),
+                                   CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR,
+                                   sizeof(float) * (this->m_radx * 2 + 1) * (this->m_rady * 2 + 1),
+                                   this->m_gausstab,
+                                   nullptr);
+
+  device->COM_clAttachMemoryBufferToKernelParameter(gaussianBokehBlurOperationKernel,
+                                                    0,
+                                                    1,
+                                                    clMemToCleanUp,
+                                                    inputMemoryBuffers,
+                                                    this->m_inputProgram);
+  device->COM_clAttachOutputMemoryBufferToKernelParameter(
+      gaussianBokehBlurOperationKernel, 2, clOutputBuffer);
+  device->COM_clAttachMemoryBufferOffsetToKernelParameter(
+      gaussianBokehBlurOperationKernel, 3, outputMemoryBuffer);
+  clSetKernelArg(gaussianBokehBlurOperationKernel, 4, sizeof(cl_int2), &radius);
+  device->COM_clAttachSizeToKernelParameter(gaussianBokehBlurOperationKernel, 5, this);
+  clSetKernelArg(gaussianBokehBlurOperationKernel, 6, sizeof(cl_mem), &gausstab);
+
+  device->COM_clEnqueueRange(gaussianBokehBlurOperationKernel, outputMemoryBuffer, 7, this);
+
+  clReleaseMemObject(gausstab);
+}
+
 void GaussianBokehBlurOperation::deinitExecution()
 {
   BlurBaseOperation::deinitExecution();
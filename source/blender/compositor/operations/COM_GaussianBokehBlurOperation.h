@@ -37,6 +37,13 @@ class GaussianBokehBlurOperation : public BlurBaseOperation {
    */
   void executePixel(float output[4], int x, int y, void *data);
 
+  void executeOpenCL(OpenCLDevice *device,
+                     MemoryBuffer *outputMemoryBuffer,
+                     cl_mem clOutputBuffer,
+                     MemoryBuffer **inputMemoryBuffers,
+                     list<cl_mem> *clMemToCleanUp,
+                     list<cl_kernel> *clKernelsToCleanUp);
+
   /**
    * Deinitialize the execution
    */
@@ -45,6 +52,15 @@ class GaussianBokehBlurOperation : public BlurBaseOperation {
   bool determineDependingAreaOfInterest(rcti *input,
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
+
+  /**
+   * The filter covers the whole area of the radius, so it is worth running on the GPU for
+   * smaller sizes than the separable gaussian blur.
+   */
+  void checkOpenCL()
+  {
+    this->setOpenCL(this->m_data.sizex * this->m_data.sizey >= 32 * 32);
+  }
 };
 
 class GaussianBlurReferenceOperation : public BlurBaseOperation {
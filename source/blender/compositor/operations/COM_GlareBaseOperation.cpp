@@ -51,6 +51,12 @@ MemoryBuffer *GlareBaseOperation::createMemoryBuffer(rcti *rect2)
   return result;
 }
 
+bool GlareBaseOperation::hashSettings(uint64_t *r_hash)
+{
+  *r_hash = hashBuffer(this->m_settings, sizeof(NodeGlare), *r_hash);
+  return true;
+}
+
 bool GlareBaseOperation::determineDependingAreaOfInterest(rcti * /*input*/,
                                                           ReadBufferOperation *readOperation,
                                                           rcti *output)
@@ -71,5 +71,7 @@ class GlareBaseOperation : public SingleThreadedOperation {
 
   virtual void generateGlare(float *data, MemoryBuffer *inputTile, NodeGlare *settings) = 0;
 
+  bool hashSettings(uint64_t *r_hash);
+
   MemoryBuffer *createMemoryBuffer(rcti *rect);
 };
@@ -28,6 +28,7 @@ InvertOperation::InvertOperation()
   this->m_color = true;
   this->m_alpha = false;
   setResolutionInputSocketIndex(1);
+  this->setAreaExecution(true);
 }
 void InvertOperation::initExecution()
 {
@@ -62,6 +63,43 @@ void InvertOperation::executePixelSampled(float output[4], float x, float y, Pix
   }
 }
 
+void InvertOperation::executeArea(MemoryBuffer *output,
+                                  const rcti &area,
+                                  const std::vector<AreaInput> &inputs)
+{
+  const int num_channels = output->get_num_channels();
+  for (int y = area.ymin; y < area.ymax; y++) {
+    float *out = output->getBuffer() +
+                 ((size_t)y * output->getWidth() + area.xmin) * num_channels;
+    const float *inputValue = inputs[0].get_elem(area.xmin, y);
+    const float *inputColor = inputs[1].get_elem(area.xmin, y);
+    for (int x = area.xmin; x < area.xmax; x++) {
+      const float value = inputValue[0];
+      const float invertedValue = 1.0f - value;
+
+      if (this->m_color) {
+        out[0] = (1.0f - inputColor[0]) * value + inputColor[0] * invertedValue;
+        out[1] = (1.0f - inputColor[1]) * value + inputColor[1] * invertedValue;
+        out[2] = (1.0f - inputColor[2]) * value + inputColor[2] * invertedValue;
+      }
+      else {
+        copy_v3_v3(out, inputColor);
+      }
+
+      if (this->m_alpha) {
+        out[3] = (1.0f - inputColor[3]) * value + inputColor[3] * invertedValue;
+      }
+      else {
+        out[3] = inputColor[3];
+      }
+
+      out += num_channels;
+      inputValue += inputs[0].elem_stride;
+      inputColor += inputs[1].elem_stride;
+    }
+  }
+}
+
 void InvertOperation::deinitExecution()
 {
   this->m_inputValueProgram = nullptr;
@@ -39,6 +39,10 @@ class InvertOperation : public NodeOperation {
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 
+  void executeArea(MemoryBuffer *output,
+                   const rcti &area,
+                   const std::vector<AreaInput> &inputs);
+
   /**
    * Initialize the execution
    */
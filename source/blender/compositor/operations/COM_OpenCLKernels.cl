@@ -313,3 +313,41 @@ __kernel void gaussianYBlurOperationKernel(__read_only image2d_t inputImage,
 
 	write_imagef(output, coords, color);
 }
+
+__kernel void gaussianBokehBlurOperationKernel(__read_only image2d_t inputImage,
+                                               int2 offsetInput,
+                                               __write_only image2d_t output,
+                                               int2 offsetOutput,
+                                               int2 radius,
+                                               int2 dimension,
+                                               __global float *gausstab,
+                                               int2 offset)
+{
+	float4 color = {0.0f, 0.0f, 0.0f, 0.0f};
+	int2 coords = {get_global_id(0), get_global_id(1)};
+	coords += offset;
+	const int2 realCoordinate = coords + offsetOutput;
+	int2 inputCoordinate;
+	float weight = 0.0f;
+
+	int xmin = max(realCoordinate.x - radius.x,     0);
+	int xmax = min(realCoordinate.x + radius.x + 1, dimension.x);
+	int ymin = max(realCoordinate.y - radius.y,     0);
+	int ymax = min(realCoordinate.y + radius.y + 1, dimension.y);
+	const int filter_width = radius.x * 2 + 1;
+
+	for (int ny = ymin; ny < ymax; ++ny) {
+		int i = (ny - realCoordinate.y + radius.y) * filter_width + (xmin - realCoordinate.x + radius.x);
+		inputCoordinate.y = ny - offsetInput.y;
+		for (int nx = xmin; nx < xmax; ++nx, ++i) {
+			float w = gausstab[i];
+			inputCoordinate.x = nx - offsetInput.x;
+			color += read_imagef(inputImage, SAMPLER_NEAREST, inputCoordinate) * w;
+			weight += w;
+		}
+	}
+
+	color *= (1.0f / weight);
+
+	write_imagef(output, coords, color);
+}
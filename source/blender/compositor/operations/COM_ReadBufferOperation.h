@@ -69,6 +69,14 @@ class ReadBufferOperation : public NodeOperation {
   {
     return memoryBuffers[this->m_offset];
   }
+  MemoryBuffer *getMemoryBuffer()
+  {
+    return this->m_buffer;
+  }
+  bool isSingleValue() const
+  {
+    return this->m_single_value;
+  }
   void readResolutionFromWriteBuffer();
   void updateMemoryBuffer();
 };
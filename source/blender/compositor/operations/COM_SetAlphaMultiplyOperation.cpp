@@ -26,6 +26,7 @@ SetAlphaMultiplyOperation::SetAlphaMultiplyOperation()
 
   this->m_inputColor = nullptr;
   this->m_inputAlpha = nullptr;
+  this->setAreaExecution(true);
 }
 
 void SetAlphaMultiplyOperation::initExecution()
@@ -48,6 +49,26 @@ void SetAlphaMultiplyOperation::executePixelSampled(float output[4],
   mul_v4_v4fl(output, color_input, alpha_input[0]);
 }
 
+void SetAlphaMultiplyOperation::executeArea(MemoryBuffer *output,
+                                            const rcti &area,
+                                            const std::vector<AreaInput> &inputs)
+{
+  const int num_channels = output->get_num_channels();
+  for (int y = area.ymin; y < area.ymax; y++) {
+    float *out = output->getBuffer() +
+                 ((size_t)y * output->getWidth() + area.xmin) * num_channels;
+    const float *color_input = inputs[0].get_elem(area.xmin, y);
+    const float *alpha_input = inputs[1].get_elem(area.xmin, y);
+    for (int x = area.xmin; x < area.xmax; x++) {
+      mul_v4_v4fl(out, color_input, alpha_input[0]);
+
+      out += num_channels;
+      color_input += inputs[0].elem_stride;
+      alpha_input += inputs[1].elem_stride;
+    }
+  }
+}
+
 void SetAlphaMultiplyOperation::deinitExecution()
 {
   this->m_inputColor = nullptr;
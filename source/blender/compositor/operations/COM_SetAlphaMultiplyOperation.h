@@ -35,6 +35,10 @@ class SetAlphaMultiplyOperation : public NodeOperation {
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 
+  void executeArea(MemoryBuffer *output,
+                   const rcti &area,
+                   const std::vector<AreaInput> &inputs);
+
   void initExecution();
   void deinitExecution();
 };
@@ -47,7 +47,13 @@ void WriteBufferOperation::executePixelSampled(float output[4],
 void WriteBufferOperation::initExecution()
 {
   this->m_input = this->getInputOperation(0);
-  this->m_memoryProxy->allocate(this->m_width, this->m_height);
+}
+
+void WriteBufferOperation::allocateBuffer()
+{
+  if (this->m_memoryProxy->getBuffer() == nullptr) {
+    this->m_memoryProxy->allocate(this->m_width, this->m_height);
+  }
 }
 
 void WriteBufferOperation::deinitExecution()
@@ -61,7 +67,10 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
   MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
   float *buffer = memoryBuffer->getBuffer();
   const int num_channels = memoryBuffer->get_num_channels();
-  if (this->m_input->isComplex()) {
+  if (this->m_input->executeAreaFromInputs(memoryBuffer, *rect)) {
+    /* pass */
+  }
+  else if (this->m_input->isComplex()) {
     void *data = this->m_input->initializeTileData(rect);
     int x1 = rect->xmin;
     int y1 = rect->ymin;
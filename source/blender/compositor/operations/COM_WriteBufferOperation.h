@@ -50,6 +50,13 @@ class WriteBufferOperation : public NodeOperation {
   void executeRegion(rcti *rect, unsigned int tileNumber);
   void initExecution();
   void deinitExecution();
+  /**
+   * \brief allocate the memory buffer when it is not allocated yet
+   * \note called when the first chunk of the ExecutionGroup is scheduled,
+   * the buffer can be freed before the end of the execution.
+   * \see ExecutionSystem.freeUnusedBuffers
+   */
+  void allocateBuffer();
   void executeOpenCLRegion(OpenCLDevice *device,
                            rcti *rect,
                            unsigned int chunkNumber,
@@ -32,6 +32,7 @@
 #include "DNA_object_types.h"
 
 #include "BLI_stack.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_action.h"
@@ -160,14 +161,31 @@ void deg_graph_build_flush_visibility(Depsgraph *graph)
       comp_node->affects_directly_visible |= id_node->is_directly_visible;
     }
   }
+
+  /* Counting pending links only reads relations of each operation, do it in parallel for big
+   * graphs before the (inherently serial) flush. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0,
+      graph->operations.size(),
+      graph,
+      [](void *__restrict userdata, const int i, const TaskParallelTLS *__restrict /*tls*/) {
+        Depsgraph *graph = static_cast<Depsgraph *>(userdata);
+        OperationNode *op_node = graph->operations[i];
+        op_node->custom_flags = 0;
+        op_node->num_links_pending = 0;
+        for (Relation *rel : op_node->outlinks) {
+          if ((rel->from->type == NodeType::OPERATION) &&
+              (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+            ++op_node->num_links_pending;
+          }
+        }
+      },
+      &settings);
+
   for (OperationNode *op_node : graph->operations) {
-    op_node->custom_flags = 0;
-    op_node->num_links_pending = 0;
-    for (Relation *rel : op_node->outlinks) {
-      if ((rel->from->type == NodeType::OPERATION) && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
-        ++op_node->num_links_pending;
-      }
-    }
     if (op_node->num_links_pending == 0) {
       BLI_stack_push(stack, &op_node);
       op_node->custom_flags |= DEG_NODE_VISITED;
@@ -30,6 +30,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
@@ -169,6 +171,10 @@ void DepsgraphNodeBuilder::build_rig(Object *object, bool is_object_visible)
       BKE_pose_update_constraint_flags(object->pose);
     }
   }
+  if (BKE_pose_use_compiled_eval(object)) {
+    build_compiled_rig(object, is_object_visible);
+    return;
+  }
   /**
    * Pose Rig Graph
    * ==============
@@ -290,6 +296,67 @@ void DepsgraphNodeBuilder::build_rig(Object *object, bool is_object_visible)
   }
 }
 
+/* All bones are evaluated by a single operation, see BKE_pose_eval_compiled(). The operations of
+ * the bones are kept as no-ops, so that users of the bones are connected the same way as for a
+ * regular rig. */
+void DepsgraphNodeBuilder::build_compiled_rig(Object *object, bool is_object_visible)
+{
+  /* Changes with every build of the graph, to rebuild the evaluation order of the bones. */
+  static int compiled_rig_generation = 0;
+  const int generation = atomic_add_and_fetch_int32(&compiled_rig_generation, 1);
+  Scene *scene_cow = get_cow_datablock(scene_);
+  Object *object_cow = get_cow_datablock(object);
+  OperationNode *op_node;
+  op_node = add_operation_node(&object->id,
+                               NodeType::EVAL_POSE,
+                               OperationCode::POSE_INIT,
+                               function_bind(BKE_pose_eval_init, _1, scene_cow, object_cow));
+  op_node->set_as_entry();
+
+  add_operation_node(
+      &object->id,
+      NodeType::EVAL_POSE,
+      OperationCode::POSE_COMPILED,
+      function_bind(BKE_pose_eval_compiled, _1, scene_cow, object_cow, generation));
+
+  add_operation_node(&object->id,
+                     NodeType::EVAL_POSE,
+                     OperationCode::POSE_CLEANUP,
+                     function_bind(BKE_pose_eval_cleanup, _1, scene_cow, object_cow));
+
+  op_node = add_operation_node(&object->id,
+                               NodeType::EVAL_POSE,
+                               OperationCode::POSE_DONE,
+                               function_bind(BKE_pose_eval_done, _1, object_cow));
+  op_node->set_as_exit();
+
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+    op_node = add_operation_node(
+        &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
+    op_node->set_as_entry();
+    add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
+    op_node = add_operation_node(
+        &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    if (check_pchan_has_bbone(object, pchan)) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_SEGMENTS);
+    }
+    op_node->set_as_exit();
+
+    /* Custom properties. */
+    if (pchan->prop != nullptr) {
+      build_idproperties(pchan->prop);
+      add_operation_node(
+          &object->id, NodeType::PARAMETERS, OperationCode::PARAMETERS_EVAL, nullptr, pchan->name);
+    }
+    /* Custom shape. */
+    if (pchan->custom != nullptr) {
+      /* TODO(sergey): Use own visibility. */
+      build_object(-1, pchan->custom, DEG_ID_LINKED_INDIRECTLY, is_object_visible);
+    }
+  }
+}
+
 void DepsgraphNodeBuilder::build_proxy_rig(Object *object, bool is_object_visible)
 {
   bArmature *armature = (bArmature *)object->data;
@@ -272,6 +272,7 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                      const bPoseChannel *rootchan,
                                      const RootPChanMap *root_map);
   virtual void build_rig(Object *object);
+  virtual void build_compiled_rig(Object *object);
   virtual void build_proxy_rig(Object *object);
   virtual void build_shapekeys(Key *key);
   virtual void build_armature(bArmature *armature);
@@ -317,6 +318,7 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   virtual void build_copy_on_write_relations(IDNode *id_node);
   virtual void build_driver_relations();
   virtual void build_driver_relations(IDNode *id_node);
+  virtual void build_compiled_rig_inputs();
 
   template<typename KeyType> OperationNode *find_operation_node(const KeyType &key);
 
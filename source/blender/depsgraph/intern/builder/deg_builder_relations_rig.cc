@@ -53,6 +53,7 @@
 #include "intern/debug/deg_debug.h"
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_operation.h"
 
 #include "intern/depsgraph_relation.h"
@@ -284,6 +285,10 @@ void DepsgraphRelationBuilder::build_inter_ik_chains(Object *object,
 /* Pose/Armature Bones Graph */
 void DepsgraphRelationBuilder::build_rig(Object *object)
 {
+  if (BKE_pose_use_compiled_eval(object)) {
+    build_compiled_rig(object);
+    return;
+  }
   /* Armature-Data */
   bArmature *armature = (bArmature *)object->data;
   // TODO: selection status?
@@ -454,6 +459,95 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
   }
 }
 
+void DepsgraphRelationBuilder::build_compiled_rig(Object *object)
+{
+  bArmature *armature = (bArmature *)object->data;
+  ComponentKey local_transform(&object->id, NodeType::TRANSFORM);
+  OperationKey pose_init_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_INIT);
+  OperationKey pose_compiled_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_COMPILED);
+  OperationKey pose_cleanup_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_CLEANUP);
+  OperationKey pose_done_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_DONE);
+  add_relation(local_transform, pose_init_key, "Local Transform -> Pose Init");
+  /* Make sure pose is up-to-date with armature updates. */
+  build_armature(armature);
+  OperationKey armature_key(&armature->id, NodeType::ARMATURE, OperationCode::ARMATURE_EVAL);
+  add_relation(armature_key, pose_init_key, "Data dependency");
+  add_relation(pose_init_key, pose_compiled_key, "Pose Init -> Compiled Pose");
+  add_relation(pose_compiled_key, pose_done_key, "Compiled Pose -> Pose Done");
+  add_relation(pose_compiled_key, pose_cleanup_key, "Compiled Pose -> Pose Cleanup");
+  /* Dependencies between the bones are handled by the compiled pose itself, the bone operations
+   * only connect the inputs and the users of the bones. Inputs of the other bone operations than
+   * the local one are connected in build_compiled_rig_inputs(). */
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+    build_idproperties(pchan->prop);
+    OperationKey bone_local_key(
+        &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
+    OperationKey bone_ready_key(
+        &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
+    OperationKey bone_done_key(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    pchan->flag &= ~POSE_DONE;
+    add_relation(pose_init_key, bone_local_key, "Pose Init - Bone Local", RELATION_FLAG_GODMODE);
+    add_relation(bone_local_key, pose_compiled_key, "Bone Local -> Compiled Pose");
+    add_relation(pose_compiled_key, bone_ready_key, "Compiled Pose -> Bone Ready");
+    add_relation(bone_ready_key, bone_done_key, "Ready -> Done");
+    if (check_pchan_has_bbone(object, pchan)) {
+      OperationKey bone_segments_key(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_SEGMENTS);
+      add_relation(bone_done_key, bone_segments_key, "Done -> B-Bone Segments");
+      add_relation(
+          bone_segments_key, pose_done_key, "PoseEval Result-Bone Link", RELATION_FLAG_GODMODE);
+      add_relation(bone_segments_key, pose_cleanup_key, "Cleanup dependency");
+    }
+    else {
+      add_relation(bone_done_key, pose_done_key, "PoseEval Result-Bone Link");
+      add_relation(bone_done_key, pose_cleanup_key, "Done -> Cleanup");
+    }
+    /* Custom shape. */
+    if (pchan->custom != nullptr) {
+      build_object(pchan->custom);
+    }
+  }
+}
+
+/* Relations to the bones of a compiled rig which don't go to their entry operation, like drivers
+ * of the B-Bone properties, have to be evaluated before the compiled pose. This is done once all
+ * relations are known. */
+void DepsgraphRelationBuilder::build_compiled_rig_inputs()
+{
+  for (IDNode *id_node : graph_->id_nodes) {
+    ComponentNode *pose_node = id_node->find_component(NodeType::EVAL_POSE);
+    if (pose_node == nullptr) {
+      continue;
+    }
+    OperationNode *pose_compiled_node = pose_node->find_operation(OperationCode::POSE_COMPILED);
+    if (pose_compiled_node == nullptr) {
+      continue;
+    }
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      if (comp_node->type != NodeType::BONE) {
+        continue;
+      }
+      for (OperationNode *op_node : comp_node->operations_map->values()) {
+        if (op_node->opcode == OperationCode::BONE_LOCAL) {
+          continue;
+        }
+        for (Relation *rel : op_node->inlinks) {
+          if (rel->from->type != NodeType::OPERATION) {
+            continue;
+          }
+          OperationNode *op_from = (OperationNode *)rel->from;
+          if (op_from->owner->owner == id_node &&
+              ELEM(op_from->owner->type, NodeType::BONE, NodeType::EVAL_POSE)) {
+            continue;
+          }
+          graph_->add_new_relation(
+              op_from, pose_compiled_node, rel->name, RELATION_CHECK_BEFORE_ADD);
+        }
+      }
+    }
+  }
+}
+
 void DepsgraphRelationBuilder::build_proxy_rig(Object *object)
 {
   bArmature *armature = (bArmature *)object->data;
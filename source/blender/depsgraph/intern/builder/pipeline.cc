@@ -46,18 +46,30 @@ AbstractBuilderPipeline::~AbstractBuilderPipeline()
 
 void AbstractBuilderPipeline::build()
 {
-  double start_time = 0.0;
-  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+  const bool use_timing = (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) != 0;
+  double start_time = 0.0, nodes_time = 0.0, relations_time = 0.0;
+  if (use_timing) {
     start_time = PIL_check_seconds_timer();
   }
 
   build_step_sanity_check();
   build_step_nodes();
+  if (use_timing) {
+    nodes_time = PIL_check_seconds_timer();
+  }
   build_step_relations();
+  if (use_timing) {
+    relations_time = PIL_check_seconds_timer();
+  }
   build_step_finalize();
 
-  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
-    printf("Depsgraph built in %f seconds.\n", PIL_check_seconds_timer() - start_time);
+  if (use_timing) {
+    const double end_time = PIL_check_seconds_timer();
+    printf("Depsgraph built in %f seconds (nodes %f, relations %f, finalize %f).\n",
+           end_time - start_time,
+           nodes_time - start_time,
+           relations_time - nodes_time,
+           end_time - relations_time);
   }
 }
 
@@ -83,6 +95,7 @@ void AbstractBuilderPipeline::build_step_relations()
   unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
   relation_builder->begin_build();
   build_relations(*relation_builder);
+  relation_builder->build_compiled_rig_inputs();
   relation_builder->build_copy_on_write_relations();
   relation_builder->build_driver_relations();
 }
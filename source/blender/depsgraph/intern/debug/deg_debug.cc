@@ -35,7 +35,12 @@
 namespace blender::deg {
 
 DepsgraphDebug::DepsgraphDebug()
-    : flags(G.debug), is_ever_evaluated(false), graph_evaluation_start_time_(0)
+    : flags(G.debug),
+      is_ever_evaluated(false),
+      operations_time(0.0),
+      num_evaluated_operations(0),
+      num_skipped_time_updates(0),
+      graph_evaluation_start_time_(0)
 {
 }
 
@@ -66,8 +71,16 @@ void DepsgraphDebug::end_graph_evaluation()
   }
 
   const double graph_eval_end_time = PIL_check_seconds_timer();
-  printf("Depsgraph updated in %f seconds.\n", graph_eval_end_time - graph_evaluation_start_time_);
+  const double graph_eval_time = graph_eval_end_time - graph_evaluation_start_time_;
+  printf("Depsgraph updated in %f seconds.\n", graph_eval_time);
   printf("Depsgraph evaluation FPS: %f\n", 1.0f / fps_samples_.get_averaged());
+  if (graph_eval_time > 0.0) {
+    printf("Depsgraph evaluation parallelism: %f\n", operations_time / graph_eval_time);
+  }
+  printf("Depsgraph evaluated %d operations, skipped %d unchanged animation updates.\n",
+         num_evaluated_operations,
+         num_skipped_time_updates);
+  num_skipped_time_updates = 0;
 
   is_ever_evaluated = true;
 }
@@ -53,6 +53,15 @@ class DepsgraphDebug {
    * This is NOT an indication that depsgraph is at its evaluated state. */
   bool is_ever_evaluated;
 
+  /* Sum of the time spent in all operations during the last evaluation, compared against the
+   * wall-clock time of the evaluation to report achieved parallelism. */
+  double operations_time;
+
+  /* Number of operations evaluated during the last evaluation, and number of time source
+   * updates skipped because the animation values did not change since the previous frame. */
+  int num_evaluated_operations;
+  int num_skipped_time_updates;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
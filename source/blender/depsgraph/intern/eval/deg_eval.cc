@@ -25,11 +25,15 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
+#include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -104,14 +108,44 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
+  if (BLI_trace_is_enabled()) {
+    char trace_name[64];
+    BLI_snprintf(trace_name,
+                 sizeof(trace_name),
+                 "%s %s",
+                 operation_node->owner->owner->name.c_str(),
+                 operationCodeAsString(operation_node->opcode));
+    BLI_trace_begin("depsgraph", trace_name);
+  }
+  const double start_time = PIL_check_seconds_timer();
+  MEM_scope_push("Depsgraph evaluation");
+  operation_node->evaluate(depsgraph);
+  MEM_scope_pop();
+  BLI_trace_end();
+  const double evaluation_time = PIL_check_seconds_timer() - start_time;
+  operation_node->last_evaluation_time = (float)evaluation_time;
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += evaluation_time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+}
+
+/* Push all but one of the children which became ready to the pool. The one which took longest
+ * to evaluate last time is kept in `r_next_node` and evaluated by the current task right away,
+ * so that long chains of operations (rigs for example) don't wait in the pool behind
+ * independent operations and end up being the tail of the evaluation. */
+void schedule_node_to_pool_or_next(OperationNode *node,
+                                   const int thread_id,
+                                   TaskPool *pool,
+                                   OperationNode **r_next_node)
+{
+  if (*r_next_node == nullptr) {
+    *r_next_node = node;
+    return;
+  }
+  if (node->last_evaluation_time > (*r_next_node)->last_evaluation_time) {
+    std::swap(node, *r_next_node);
   }
+  schedule_node_to_pool(node, thread_id, pool);
 }
 
 void deg_task_run_func(TaskPool *pool, void *taskdata)
@@ -119,12 +153,16 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children, continuing with one of them in this task. */
+    OperationNode *next_node = nullptr;
+    schedule_children(state, operation_node, schedule_node_to_pool_or_next, pool, &next_node);
+    operation_node = next_node;
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
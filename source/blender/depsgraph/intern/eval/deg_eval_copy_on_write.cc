@@ -41,11 +41,13 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_curve.h"
+#include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_gpencil.h"
 #include "BKE_idprop.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
+#include "BKE_mesh.h"
 #include "BKE_scene.h"
 
 #include "DEG_depsgraph.h"
@@ -315,6 +317,31 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   return result;
 }
 
+/* Similar to id_copy_inplace_no_main() but custom data layers of the copy reference the ones of
+ * the original mesh instead of duplicating them, so that the geometry of big meshes is not resident
+ * twice. Evaluation duplicates referenced layers before modifying them (see
+ * CustomData_duplicate_referenced_layer()), and the copy is re-created whenever the original
+ * geometry changes. */
+bool mesh_copy_inplace_no_main(const Mesh *mesh, Mesh *new_mesh)
+{
+  bool result = (BKE_id_copy_ex(nullptr,
+                                &mesh->id,
+                                (ID **)&new_mesh,
+                                LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE |
+                                    LIB_ID_COPY_CD_REFERENCE) != nullptr);
+  if (!result) {
+    return false;
+  }
+
+  /* Vertex normals are written in-place while evaluating, and deform-verts own nested weight
+   * arrays which are re-allocated by painting, so those layers are never shared. */
+  CustomData_duplicate_referenced_layer(&new_mesh->vdata, CD_MVERT, new_mesh->totvert);
+  CustomData_duplicate_referenced_layer(&new_mesh->vdata, CD_MDEFORMVERT, new_mesh->totvert);
+  BKE_mesh_update_customdata_pointers(new_mesh, false);
+
+  return true;
+}
+
 /* Similar to BKE_scene_copy() but does not require main and assumes pointer
  * is already allocated. */
 bool scene_copy_inplace_no_main(const Scene *scene, Scene *new_scene)
@@ -888,8 +915,7 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      done = mesh_copy_inplace_no_main((const Mesh *)id_orig, (Mesh *)id_cow);
       break;
     }
     default:
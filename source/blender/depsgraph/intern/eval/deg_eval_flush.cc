@@ -382,6 +382,11 @@ void deg_graph_flush_updates(Depsgraph *graph)
       /* Inform corresponding ID and component nodes about the change. */
       ComponentNode *comp_node = op_node->owner;
       IDNode *id_node = comp_node->owner;
+      /* Values of F-Curves are only known for updates caused by time change. Make sure an action
+       * modified by any other update is re-evaluated on the next frame. */
+      if (!graph->time_source->tagged_for_update && comp_node->type == NodeType::ANIMATION) {
+        graph->time_source->action_fcurve_values.remove(id_node);
+      }
       flush_handle_id_node(id_node);
       flush_handle_component_node(id_node, comp_node, &queue);
       /* Flush to nodes along links. */
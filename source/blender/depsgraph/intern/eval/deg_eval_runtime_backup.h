@@ -26,6 +26,7 @@
 #include "DNA_ID.h"
 
 #include "intern/eval/deg_eval_runtime_backup_animation.h"
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
 #include "intern/eval/deg_eval_runtime_backup_movieclip.h"
 #include "intern/eval/deg_eval_runtime_backup_object.h"
 #include "intern/eval/deg_eval_runtime_backup_scene.h"
@@ -66,6 +67,7 @@ class RuntimeBackup {
   DrawDataList *drawdata_ptr;
   MovieClipBackup movieclip_backup;
   VolumeBackup volume_backup;
+  MeshBackup mesh_backup;
 };
 
 }  // namespace deg
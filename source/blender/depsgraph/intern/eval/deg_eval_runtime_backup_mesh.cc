@@ -0,0 +1,64 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
+
+#include "BLI_utildefines.h"
+
+#include "DNA_mesh_types.h"
+
+#include "BKE_editmesh.h"
+#include "BKE_mesh.h"
+
+namespace blender::deg {
+
+MeshBackup::MeshBackup(const Depsgraph * /*depsgraph*/) : batch_cache(nullptr)
+{
+}
+
+void MeshBackup::init_from_mesh(Mesh *mesh)
+{
+  if (mesh->edit_mesh == nullptr) {
+    return;
+  }
+  batch_cache = mesh->runtime.batch_cache;
+  mesh->runtime.batch_cache = nullptr;
+}
+
+void MeshBackup::restore_to_mesh(Mesh *mesh)
+{
+  if (batch_cache == nullptr) {
+    return;
+  }
+  BLI_assert(mesh->runtime.batch_cache == nullptr);
+  mesh->runtime.batch_cache = batch_cache;
+  batch_cache = nullptr;
+  /* The copy might have been updated for any reason, only keep buffers when it is known that the
+   * topology did not change. */
+  const bool is_deform_only_update = (mesh->edit_mesh != nullptr &&
+                                      mesh->edit_mesh->is_deform_only_update);
+  BKE_mesh_batch_cache_dirty_tag(
+      mesh, is_deform_only_update ? BKE_MESH_BATCH_DIRTY_DEFORM : BKE_MESH_BATCH_DIRTY_ALL);
+}
+
+}  // namespace blender::deg
@@ -46,12 +46,20 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
     id_node->stats.reset_current();
   }
   /* Now accumulate operation timings to components and IDs. */
+  double operations_time = 0.0;
+  int num_evaluated_operations = 0;
   for (OperationNode *op_node : graph->operations) {
+    if (op_node->scheduled && !op_node->is_noop()) {
+      num_evaluated_operations++;
+    }
     ComponentNode *comp_node = op_node->owner;
     IDNode *id_node = comp_node->owner;
     id_node->stats.current_time += op_node->stats.current_time;
     comp_node->stats.current_time += op_node->stats.current_time;
+    operations_time += op_node->stats.current_time;
   }
+  graph->debug.operations_time = operations_time;
+  graph->debug.num_evaluated_operations = num_evaluated_operations;
 }
 
 }  // namespace blender::deg
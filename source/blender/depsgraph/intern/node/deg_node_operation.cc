@@ -126,6 +126,8 @@ const char *operationCodeAsString(OperationCode opcode)
       return "POSE_IK_SOLVER";
     case OperationCode::POSE_SPLINE_IK_SOLVER:
       return "POSE_SPLINE_IK_SOLVER";
+    case OperationCode::POSE_COMPILED:
+      return "POSE_COMPILED";
     /* Bone. */
     case OperationCode::BONE_LOCAL:
       return "BONE_LOCAL";
@@ -209,7 +211,7 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0)
+OperationNode::OperationNode() : last_evaluation_time(0.0f), name_tag(-1), flag(0)
 {
 }
 
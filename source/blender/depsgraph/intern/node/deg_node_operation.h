@@ -126,6 +126,8 @@ enum class OperationCode {
   /* IK/Spline Solvers */
   POSE_IK_SOLVER,
   POSE_SPLINE_IK_SOLVER,
+  /* Evaluation of all bones, when the bone operations are no-ops. */
+  POSE_COMPILED,
 
   /* Bone. ---------------------------------------------------------------- */
   /* Bone local transforms - entry point */
@@ -266,6 +268,10 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time spent on the last evaluation of this operation, in seconds.
+   * Used as a hint to evaluate longer operations first. */
+  float last_evaluation_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -23,13 +23,84 @@
 
 #include "intern/node/deg_node_time.h"
 
+#include <cstring>
+
+#include "BLI_listbase.h"
+
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_anim_data.h"
+#include "BKE_fcurve.h"
 
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
 
 namespace blender::deg {
 
+namespace {
+
+/* Check whether the action is only used as an active action of animation data without NLA, in
+ * which case values of its F-Curves at the current frame fully define the evaluated result. */
+bool action_is_evaluated_at_scene_time(const ComponentNode *action_component)
+{
+  const bAction *action = reinterpret_cast<const bAction *>(action_component->owner->id_orig);
+  for (const OperationNode *op_node : action_component->operations) {
+    for (const Relation *rel : op_node->outlinks) {
+      if (rel->to->type != NodeType::OPERATION) {
+        return false;
+      }
+      const ComponentNode *to_component = reinterpret_cast<const OperationNode *>(rel->to)->owner;
+      if (to_component->type != NodeType::ANIMATION) {
+        return false;
+      }
+      const AnimData *adt = BKE_animdata_from_id(to_component->owner->id_orig);
+      if (adt == nullptr || adt->action != action || !BLI_listbase_is_empty(&adt->nla_tracks)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* Returns true when the time source update of the given node can be skipped, because it is an
+ * action which evaluates to bit-identical values as on the previous time source update. */
+bool check_action_unchanged_since_last_update(Depsgraph *graph, Node *node)
+{
+  TimeSourceNode *time_source = graph->time_source;
+  if (!(U.experimental.use_depsgraph_animation_cache)) {
+    time_source->action_fcurve_values.clear();
+    return false;
+  }
+  if (node->get_class() != NodeClass::COMPONENT || node->type != NodeType::ANIMATION) {
+    return false;
+  }
+  const ComponentNode *component_node = reinterpret_cast<const ComponentNode *>(node);
+  const IDNode *id_node = component_node->owner;
+  if (id_node->id_type != ID_AC || !action_is_evaluated_at_scene_time(component_node)) {
+    return false;
+  }
+  bAction *action = reinterpret_cast<bAction *>(id_node->id_orig);
+  Vector<float> values;
+  LISTBASE_FOREACH (FCurve *, fcu, &action->curves) {
+    values.append(evaluate_fcurve(fcu, graph->ctime));
+  }
+  Vector<float> *last_values = time_source->action_fcurve_values.lookup_ptr(id_node);
+  if (last_values != nullptr && last_values->size() == values.size() &&
+      memcmp(last_values->data(), values.data(), sizeof(float) * values.size()) == 0) {
+    return true;
+  }
+  time_source->action_fcurve_values.add_overwrite(id_node, std::move(values));
+  return false;
+}
+
+}  // namespace
+
 void TimeSourceNode::tag_update(Depsgraph * /*graph*/, eUpdateSource /*source*/)
 {
   tagged_for_update = true;
@@ -40,8 +111,13 @@ void TimeSourceNode::flush_update_tag(Depsgraph *graph)
   if (!tagged_for_update) {
     return;
   }
+  graph->debug.num_skipped_time_updates = 0;
   for (Relation *rel : outlinks) {
     Node *node = rel->to;
+    if (check_action_unchanged_since_last_update(graph, node)) {
+      graph->debug.num_skipped_time_updates++;
+      continue;
+    }
     node->tag_update(graph, DEG_UPDATE_SOURCE_TIME);
   }
 }
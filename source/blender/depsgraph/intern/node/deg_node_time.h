@@ -23,15 +23,25 @@
 
 #pragma once
 
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
 #include "intern/node/deg_node.h"
 
 namespace blender {
 namespace deg {
 
+struct IDNode;
+
 /* Time Source Node. */
 struct TimeSourceNode : public Node {
   bool tagged_for_update = false;
 
+  /* Values of F-Curves of actions at the last time source update. Actions which evaluate to
+   * exactly the same values on the new frame are not tagged for update.
+   * Only used when #UserDef_Experimental.use_depsgraph_animation_cache is enabled. */
+  Map<const IDNode *, Vector<float>> action_fcurve_values;
+
   // TODO: evaluate() operation needed
 
   virtual void tag_update(Depsgraph *graph, eUpdateSource source) override;
@@ -214,11 +214,15 @@ void EEVEE_view_layer_data_free(void *storage)
   DRW_UBO_FREE_SAFE(sldata->light_ubo);
   DRW_UBO_FREE_SAFE(sldata->shadow_ubo);
   GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_fb);
+  GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_static_fb);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+  DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cascade_pool);
   for (int i = 0; i < 2; i++) {
     MEM_SAFE_FREE(sldata->shcasters_buffers[i].bbox);
     MEM_SAFE_FREE(sldata->shcasters_buffers[i].update);
+    MEM_SAFE_FREE(sldata->shcasters_buffers[i].dynamic);
+    MEM_SAFE_FREE(sldata->shcasters_buffers[i].static_update);
   }
 
   if (sldata->fallback_lightcache) {
@@ -111,11 +111,14 @@ static void eevee_cache_init(void *vedata)
 void EEVEE_cache_populate(void *vedata, Object *ob)
 {
   EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
+  EEVEE_PrivateData *g_data = ((EEVEE_Data *)vedata)->stl->g_data;
 
   const DRWContextState *draw_ctx = DRW_context_state_get();
   const int ob_visibility = DRW_object_visibility_in_active_context(ob);
   bool cast_shadow = false;
 
+  g_data->shadow_caster_dynamic = EEVEE_shadows_caster_is_dynamic(ob);
+
   if (ob_visibility & OB_VISIBLE_PARTICLES) {
     EEVEE_particle_hair_cache_populate(vedata, sldata, ob, &cast_shadow);
   }
@@ -147,7 +150,7 @@ void EEVEE_cache_populate(void *vedata, Object *ob)
   }
 
   if (cast_shadow) {
-    EEVEE_shadows_caster_register(sldata, ob);
+    EEVEE_shadows_caster_register(sldata, ob, g_data->shadow_caster_dynamic);
   }
 }
 
@@ -285,6 +288,12 @@ static void eevee_draw_scene(void *vedata)
     EEVEE_create_minmax_buffer(vedata, dtxl->depth, -1);
     DRW_stats_group_end();
 
+    /* Planar reflections can show objects hidden from the main view. */
+    const Scene *scene = DRW_context_state_get()->scene;
+    if ((scene->eevee.flag & SCE_EEVEE_OCCLUSION_CULLING) && (sldata->probes->num_planar == 0)) {
+      DRW_occlusion_culling_capture();
+    }
+
     EEVEE_occlusion_compute(sldata, vedata, dtxl->depth, -1);
     EEVEE_volumes_compute(sldata, vedata);
 
@@ -69,6 +69,9 @@
 #endif
 
 /* OpenGL 3.3 core requirement, can be extended but it's already very big */
+/** Max time (in seconds) spent rendering irradiance samples while holding the draw context. */
+#define LIGHTBAKE_BATCH_TIME_MAX 0.05
+
 #define IRRADIANCE_MAX_POOL_LAYER 256
 #define IRRADIANCE_MAX_POOL_SIZE 1024
 #define MAX_IRRADIANCE_SAMPLES \
@@ -157,6 +160,12 @@ typedef struct EEVEE_LightBake {
   struct GPUTexture *dummy_layer_color;
 
   int total, done; /* to compute progress */
+  /** Samples rendered and time spent for irradiance and reflection samples, to estimate the
+   * remaining time. The world sample is counted as a reflection sample. */
+  int grid_done, cube_done;
+  double grid_time, cube_time;
+  /** True once the scene was cached in the current draw manager pipeline. */
+  bool cache_created;
   short *stop, *do_update;
   float *progress;
 
@@ -1005,6 +1014,8 @@ static void eevee_lightbake_render_world_sample(void *ved, void *user_data)
   /* TODO do this once for the whole bake when we have independent DRWManagers. */
   eevee_lightbake_cache_create(vedata, lbake);
 
+  lbake->cube_done += 1;
+
   sldata->common_data.ray_type = EEVEE_RAY_GLOSSY;
   sldata->common_data.ray_depth = 1;
   GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
@@ -1127,7 +1138,12 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
 
   /* TODO do this once for the whole bake when we have independent DRWManagers.
    * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
+  if (!lbake->cache_created) {
+    /* Samples of the same grid and bounce render the same scene, see
+     * #eevee_lightbake_render_grid_samples. */
+    eevee_lightbake_cache_create(vedata, lbake);
+    lbake->cache_created = true;
+  }
 
   /* Compute sample position */
   compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
@@ -1187,6 +1203,27 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
       (lbake->grid_sample == lbake->grid_sample_len - 1)) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
   }
+
+  lbake->grid_done += 1;
+}
+
+/**
+ * Render the following samples of the current grid in the same draw manager pipeline,
+ * so the scene is only cached once for all of them. The draw context is locked while
+ * rendering, give it back to the viewport after #LIGHTBAKE_BATCH_TIME_MAX.
+ */
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
+{
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  const double time_start = PIL_check_seconds_timer();
+
+  lbake->cache_created = false;
+  do {
+    eevee_lightbake_render_grid_sample(ved, user_data);
+    lbake->grid_sample++;
+  } while ((lbake->grid_sample < lbake->grid_sample_len) && !(G.is_break || *lbake->stop) &&
+           ((lbake->gl_context == NULL) ||
+            (PIL_check_seconds_timer() - time_start < LIGHTBAKE_BATCH_TIME_MAX)));
 }
 
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
@@ -1227,6 +1264,7 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
                                 clamp);
 
   lcache->cube_len += 1;
+  lbake->cube_done += 1;
 
   /* If it's the last probe. */
   if (lbake->cube_offset == lbake->cube_len - 1) {
@@ -1323,6 +1361,46 @@ static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
 
   lbake->total = lbake->total_irr_samples * lbake->bounce_len + lbake->cube_len;
   lbake->done = 0;
+  lbake->grid_done = lbake->cube_done = 0;
+  lbake->grid_time = lbake->cube_time = 0.0;
+}
+
+/**
+ * Progress from the time spent so far and the estimated remaining time, so the remaining time
+ * displayed for the job is meaningful: reflection samples are much slower than irradiance ones.
+ */
+static float eevee_lightbake_progress_get(EEVEE_LightBake *lbake)
+{
+  const int grid_todo = ((lbake->lcache->flag & LIGHTCACHE_UPDATE_GRID) ?
+                             (lbake->total_irr_samples - 1) * lbake->bounce_len :
+                             0) -
+                        lbake->grid_done;
+  const int cube_todo = lbake->cube_len - lbake->cube_done -
+                        ((lbake->lcache->flag & LIGHTCACHE_UPDATE_CUBE) ? 0 : lbake->cube_len - 1);
+
+  /* Before a sample of each kind is rendered, guess from the amount of pixels to render. */
+  const float res_ratio = square_f((float)lbake->ref_cube_res / (float)lbake->irr_cube_res);
+  double grid_sample_time = 0.0, cube_sample_time = 0.0;
+  if (lbake->grid_done > 0) {
+    grid_sample_time = lbake->grid_time / lbake->grid_done;
+  }
+  if (lbake->cube_done > 0) {
+    cube_sample_time = lbake->cube_time / lbake->cube_done;
+  }
+  if (lbake->grid_done == 0) {
+    grid_sample_time = cube_sample_time / res_ratio;
+  }
+  if (lbake->cube_done == 0) {
+    cube_sample_time = grid_sample_time * res_ratio;
+  }
+
+  const double time_done = lbake->grid_time + lbake->cube_time;
+  const double time_todo = max_ii(grid_todo, 0) * grid_sample_time +
+                           max_ii(cube_todo, 0) * cube_sample_time;
+  if (time_done + time_todo <= 0.0) {
+    return lbake->done / (float)lbake->total;
+  }
+  return (float)(time_done / (time_done + time_todo));
 }
 
 void EEVEE_lightbake_update(void *custom_data)
@@ -1355,9 +1433,20 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
 
   /* TODO: make DRW manager instanciable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
+  const int grid_done = lbake->grid_done;
+  const double time_start = PIL_check_seconds_timer();
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
-  *lbake->progress = lbake->done / (float)lbake->total;
+  const double time = PIL_check_seconds_timer() - time_start;
+  if (lbake->grid_done != grid_done) {
+    lbake->done += lbake->grid_done - grid_done;
+    lbake->grid_time += time;
+  }
+  else {
+    lbake->done += 1;
+    lbake->cube_time += time;
+  }
+  /* Never go back, the estimation changes as samples are rendered. */
+  *lbake->progress = max_ff(*lbake->progress, eevee_lightbake_progress_get(lbake));
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
 
@@ -1434,9 +1523,12 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
-        for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+        /* Samples are advanced by batches, see #eevee_lightbake_render_grid_samples. */
+        lbake->grid_sample = 0;
+        while (lbake->grid_sample < lbake->grid_sample_len) {
+          if (!lightbake_do_sample(lbake, eevee_lightbake_render_grid_samples)) {
+            break;
+          }
         }
       }
     }
@@ -60,12 +60,17 @@ typedef struct EeveeMaterialCache {
   struct DRWShadingGroup *depth_grp;
   struct DRWShadingGroup *shading_grp;
   struct DRWShadingGroup *shadow_grp;
+  /* Created on demand, for the casters of the dynamic shadow pass. */
+  struct DRWShadingGroup *shadow_dynamic_grp;
   struct GPUMaterial *shading_gpumat;
+  struct GPUMaterial *shadow_gpumat;
+  int shadow_option;
   /* Meh, Used by hair to ensure draw order when calling DRW_shgroup_create_sub.
    * Pointers to ghash values. */
   struct DRWShadingGroup **depth_grp_p;
   struct DRWShadingGroup **shading_grp_p;
   struct DRWShadingGroup **shadow_grp_p;
+  struct DRWShadingGroup **shadow_dynamic_grp_p;
 } EeveeMaterialCache;
 
 /* *********** FUNCTIONS *********** */
@@ -452,13 +457,42 @@ void EEVEE_materials_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 }
 
+static DRWShadingGroup *material_shadow_grp_create(EEVEE_Data *vedata,
+                                                   EEVEE_ViewLayerData *sldata,
+                                                   GPUMaterial *gpumat,
+                                                   int option,
+                                                   DRWPass *pass,
+                                                   DRWShadingGroup ***r_grp_p)
+{
+  EEVEE_PrivateData *pd = vedata->stl->g_data;
+
+  /* Search for the same shaders usage in the pass. */
+  struct GPUShader *sh = GPU_material_get_shader(gpumat);
+  void *cache_key = (char *)sh + option;
+  DRWShadingGroup *grp, **grp_p;
+
+  if (BLI_ghash_ensure_p(pd->material_hash, cache_key, (void ***)&grp_p)) {
+    /* This GPUShader has already been used by another material.
+     * Add new shading group just after to avoid shader switching cost. */
+    grp = DRW_shgroup_create_sub(*grp_p);
+  }
+  else {
+    *grp_p = grp = DRW_shgroup_create(sh, pass);
+    EEVEE_material_bind_resources(grp, gpumat, sldata, vedata, NULL, NULL, false, false);
+  }
+
+  DRW_shgroup_add_material_resources(grp, gpumat);
+
+  *r_grp_p = grp_p;
+  return grp;
+}
+
 BLI_INLINE void material_shadow(EEVEE_Data *vedata,
                                 EEVEE_ViewLayerData *sldata,
                                 Material *ma,
                                 bool is_hair,
                                 EeveeMaterialCache *emc)
 {
-  EEVEE_PrivateData *pd = vedata->stl->g_data;
   EEVEE_PassList *psl = vedata->psl;
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
@@ -478,30 +512,35 @@ BLI_INLINE void material_shadow(EEVEE_Data *vedata,
     int option = KEY_SHADOW;
     SET_FLAG_FROM_TEST(option, is_hair, KEY_HAIR);
 
-    /* Search for the same shaders usage in the pass. */
-    struct GPUShader *sh = GPU_material_get_shader(gpumat);
-    void *cache_key = (char *)sh + option;
-    DRWShadingGroup *grp, **grp_p;
-
-    if (BLI_ghash_ensure_p(pd->material_hash, cache_key, (void ***)&grp_p)) {
-      /* This GPUShader has already been used by another material.
-       * Add new shading group just after to avoid shader switching cost. */
-      grp = DRW_shgroup_create_sub(*grp_p);
-    }
-    else {
-      *grp_p = grp = DRW_shgroup_create(sh, psl->shadow_pass);
-      EEVEE_material_bind_resources(grp, gpumat, sldata, vedata, NULL, NULL, false, false);
-    }
-
-    DRW_shgroup_add_material_resources(grp, gpumat);
-
-    emc->shadow_grp = grp;
-    emc->shadow_grp_p = grp_p;
+    emc->shadow_grp = material_shadow_grp_create(
+        vedata, sldata, gpumat, option, psl->shadow_pass, &emc->shadow_grp_p);
+    emc->shadow_gpumat = gpumat;
+    emc->shadow_option = option;
   }
   else {
     emc->shadow_grp = NULL;
     emc->shadow_grp_p = NULL;
+    emc->shadow_gpumat = NULL;
+  }
+  emc->shadow_dynamic_grp = NULL;
+  emc->shadow_dynamic_grp_p = NULL;
+}
+
+/* Shadow group of the dynamic shadow pass, when the object being populated uses it. */
+BLI_INLINE void material_shadow_dynamic_ensure(EEVEE_Data *vedata,
+                                               EEVEE_ViewLayerData *sldata,
+                                               EeveeMaterialCache *emc)
+{
+  EEVEE_PrivateData *pd = vedata->stl->g_data;
+  if (!pd->shadow_caster_dynamic || emc->shadow_gpumat == NULL || emc->shadow_dynamic_grp) {
+    return;
   }
+  emc->shadow_dynamic_grp = material_shadow_grp_create(vedata,
+                                                       sldata,
+                                                       emc->shadow_gpumat,
+                                                       emc->shadow_option | KEY_SHADOW_DYNAMIC,
+                                                       vedata->psl->shadow_dynamic_pass,
+                                                       &emc->shadow_dynamic_grp_p);
 }
 
 static EeveeMaterialCache material_opaque(EEVEE_Data *vedata,
@@ -527,12 +566,14 @@ static EeveeMaterialCache material_opaque(EEVEE_Data *vedata,
   /* Search for other material instances (sharing the same Material data-block). */
   EeveeMaterialCache **emc_p, *emc;
   if (BLI_ghash_ensure_p(pd->material_hash, key, (void ***)&emc_p)) {
+    material_shadow_dynamic_ensure(vedata, sldata, *emc_p);
     return **emc_p;
   }
 
   *emc_p = emc = BLI_memblock_alloc(sldata->material_cache);
 
   material_shadow(vedata, sldata, ma, is_hair, emc);
+  material_shadow_dynamic_ensure(vedata, sldata, emc);
 
   {
     /* Depth Pass */
@@ -650,6 +691,7 @@ static EeveeMaterialCache material_transparent(EEVEE_Data *vedata,
                         DRW_STATE_BLEND_CUSTOM);
 
   material_shadow(vedata, sldata, ma, false, &emc);
+  material_shadow_dynamic_ensure(vedata, sldata, &emc);
 
   if (use_prepass) {
     /* Depth prepass */
@@ -736,6 +778,10 @@ BLI_INLINE EeveeMaterialCache eevee_material_cache_get(
       matcache = material_opaque(vedata, sldata, ma, is_hair);
       break;
   }
+  if (vedata->stl->g_data->shadow_caster_dynamic) {
+    matcache.shadow_grp = matcache.shadow_dynamic_grp;
+    matcache.shadow_grp_p = matcache.shadow_dynamic_grp_p;
+  }
   return matcache;
 }
 
@@ -811,8 +857,20 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata,
      */
     bool use_volume_material = (matcache[0].shading_gpumat &&
                                 GPU_material_has_volume_output(matcache[0].shading_gpumat));
+    /* Objects hidden behind others are only needed for the shadows they cast. */
+    const bool is_occluded = !use_sculpt_pbvh &&
+                             (scene->eevee.flag & SCE_EEVEE_OCCLUSION_CULLING) &&
+                             DRW_object_is_occluded(ob);
+    bool cast_shadow_any = false;
+    for (int i = 0; i < materials_len; i++) {
+      cast_shadow_any |= (matcache[i].shadow_grp != NULL);
+    }
+
     if ((ob->dt >= OB_SOLID) || DRW_state_is_scene_render()) {
-      if (use_sculpt_pbvh) {
+      if (is_occluded && !cast_shadow_any) {
+        /* Nothing to draw, skip the batch extraction. */
+      }
+      else if (use_sculpt_pbvh) {
         struct DRWShadingGroup **shgrps_array = BLI_array_alloca(shgrps_array, materials_len);
 
         MATCACHE_AS_ARRAY(matcache, shading_grp, materials_len, shgrps_array);
@@ -853,8 +911,10 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata,
               oedata->test_data = &sldata->probes->vis_data;
             }
 
-            ADD_SHGROUP_CALL(matcache[i].shading_grp, ob, mat_geom[i], oedata);
-            ADD_SHGROUP_CALL_SAFE(matcache[i].depth_grp, ob, mat_geom[i], oedata);
+            if (!is_occluded) {
+              ADD_SHGROUP_CALL(matcache[i].shading_grp, ob, mat_geom[i], oedata);
+              ADD_SHGROUP_CALL_SAFE(matcache[i].depth_grp, ob, mat_geom[i], oedata);
+            }
             ADD_SHGROUP_CALL_SAFE(matcache[i].shadow_grp, ob, mat_geom[i], oedata);
             *cast_shadow = *cast_shadow || (matcache[i].shadow_grp != NULL);
           }
@@ -196,6 +196,7 @@ enum {
   KEY_REFRACT = (1 << 1),
   KEY_HAIR = (1 << 2),
   KEY_SHADOW = (1 << 3),
+  KEY_SHADOW_DYNAMIC = (1 << 4),
 };
 
 /* SSR shader variations */
@@ -234,6 +235,8 @@ typedef struct EEVEE_BoundBox {
 typedef struct EEVEE_PassList {
   /* Shadows */
   struct DRWPass *shadow_pass;
+  /** Casters updated since the last redraw, see #EEVEE_shadows_caster_is_dynamic. */
+  struct DRWPass *shadow_dynamic_pass;
   struct DRWPass *shadow_accum_pass;
 
   /* Probes */
@@ -501,8 +504,13 @@ BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
 typedef struct EEVEE_ShadowCasterBuffer {
   struct EEVEE_BoundBox *bbox;
   BLI_bitmap *update;
+  /** Casters drawn in the dynamic shadow pass. */
+  BLI_bitmap *dynamic;
+  /** Static casters that were not in the static shadow layers. */
+  BLI_bitmap *static_update;
   uint alloc_count;
   uint count;
+  uint dynamic_count;
 } EEVEE_ShadowCasterBuffer;
 
 /* ************ LIGHT DATA ************* */
@@ -525,6 +533,8 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Cube shadows whose static casters layers needs to be rendered again. */
+  BLI_bitmap sh_cube_static_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
   /* List of bbox and update bitmap. Double buffered. */
@@ -848,8 +858,11 @@ typedef struct EEVEE_ViewLayerData {
   struct GPUUniformBuf *shadow_samples_ubo;
 
   struct GPUFrameBuffer *shadow_fb;
+  struct GPUFrameBuffer *shadow_static_fb;
 
   struct GPUTexture *shadow_cube_pool;
+  /** Cube shadows of the static casters only, copied before rendering the dynamic casters. */
+  struct GPUTexture *shadow_cube_static_pool;
   struct GPUTexture *shadow_cascade_pool;
 
   struct EEVEE_ShadowCasterBuffer shcasters_buffers[2];
@@ -933,6 +946,8 @@ typedef struct EEVEE_Data {
 
 typedef struct EEVEE_PrivateData {
   struct DRWShadingGroup *shadow_shgrp;
+  /** The object being populated casts shadows in the dynamic shadow pass. */
+  bool shadow_caster_dynamic;
   struct DRWShadingGroup *shadow_accum_shgrp;
   struct DRWCallBuffer *planar_display_shgrp;
   struct GHash *material_hash;
@@ -1072,7 +1087,10 @@ void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh);
 void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata);
 void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
-void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, struct Object *ob);
+bool EEVEE_shadows_caster_is_dynamic(struct Object *ob);
+void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata,
+                                   struct Object *ob,
+                                   bool is_dynamic);
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
@@ -210,6 +210,9 @@ void EEVEE_render_cache(void *vedata,
   const bool do_cryptomatte = (engine != NULL) &&
                               ((g_data->render_passes & EEVEE_RENDER_PASS_CRYPTOMATTE) != 0);
 
+  /* With persistent data the depsgraph and the engine data of its objects are kept between the
+   * frames of an animation, so only the objects that changed since are tagged for update, and
+   * the other ones reuse their batches and static shadows. */
   eevee_id_update(vedata, &ob->id);
 
   if (pinfo->vis_data.collection) {
@@ -231,6 +234,8 @@ void EEVEE_render_cache(void *vedata,
     RE_engine_update_stats(engine, NULL, info);
   }
 
+  g_data->shadow_caster_dynamic = EEVEE_shadows_caster_is_dynamic(ob);
+
   const int ob_visibility = DRW_object_visibility_in_active_context(ob);
   if (ob_visibility & OB_VISIBLE_PARTICLES) {
     EEVEE_particle_hair_cache_populate(vedata, sldata, ob, &cast_shadow);
@@ -265,7 +270,7 @@ void EEVEE_render_cache(void *vedata,
   }
 
   if (cast_shadow) {
-    EEVEE_shadows_caster_register(sldata, ob);
+    EEVEE_shadows_caster_register(sldata, ob, g_data->shadow_caster_dynamic);
   }
 }
 
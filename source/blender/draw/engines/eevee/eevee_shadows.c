@@ -56,6 +56,9 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       sldata->shcasters_buffers[i].bbox = MEM_callocN(
           sizeof(EEVEE_BoundBox) * SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].dynamic = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].static_update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK,
+                                                                  __func__);
       sldata->shcasters_buffers[i].alloc_count = SH_CASTER_ALLOC_CHUNK;
       sldata->shcasters_buffers[i].count = 0;
     }
@@ -78,6 +81,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       (linfo->shadow_high_bitdepth != sh_high_bitdepth)) {
     BLI_assert((sh_cube_size > 0) && (sh_cube_size <= 4096));
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     CLAMP(sh_cube_size, 1, 4096);
   }
 
@@ -103,6 +107,7 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   EEVEE_ShadowCasterBuffer *frontbuffer = linfo->shcaster_frontbuffer;
 
   frontbuffer->count = 0;
+  frontbuffer->dynamic_count = 0;
   linfo->num_cube_layer = 0;
   linfo->num_cascade_layer = 0;
   linfo->cube_len = linfo->cascade_len = linfo->shadow_len = 0;
@@ -111,6 +116,8 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   BLI_bitmap_set_all(backbuffer->update, true, backbuffer->alloc_count);
   /* Is this one needed? */
   BLI_bitmap_set_all(frontbuffer->update, false, frontbuffer->alloc_count);
+  BLI_bitmap_set_all(frontbuffer->dynamic, false, frontbuffer->alloc_count);
+  BLI_bitmap_set_all(frontbuffer->static_update, false, frontbuffer->alloc_count);
 
   INIT_MINMAX(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max);
 
@@ -120,11 +127,28 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
     stl->g_data->shadow_shgrp = DRW_shgroup_create(EEVEE_shaders_shadow_sh_get(),
                                                    psl->shadow_pass);
+
+    DRW_PASS_CREATE(psl->shadow_dynamic_pass, state);
+  }
+}
+
+/**
+ * Casters updated since the last redraw are drawn separately from the others (the static
+ * casters), so cube shadows only need to render the static casters again when one of them
+ * changes. Must be tested before populating the object, which clears its update flag.
+ */
+bool EEVEE_shadows_caster_is_dynamic(Object *ob)
+{
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    /* Duplis are always updated, see #EEVEE_shadows_caster_register. */
+    return true;
   }
+  EEVEE_ObjectEngineData *oedata = EEVEE_object_data_get(ob);
+  return (oedata == NULL) || oedata->need_update;
 }
 
 /* Make that object update shadow casting lights inside its influence bounding box. */
-void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
+void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob, bool is_dynamic)
 {
   EEVEE_LightsInfo *linfo = sldata->lights;
   EEVEE_ShadowCasterBuffer *backbuffer = linfo->shcaster_backbuffer;
@@ -138,8 +162,13 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->static_update, frontbuffer->alloc_count);
   }
 
+  /* Static casters new to the static layers, which must be rendered again. */
+  bool static_update = !is_dynamic;
+
   if (ob->base_flag & BASE_FROM_DUPLI) {
     /* Duplis will always refresh the shadowmaps as if they were deleted each frame. */
     /* TODO(fclem): fix this. */
@@ -152,6 +181,7 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     /* Update flags in backbuffer. */
     if (past_id > -1 && past_id < backbuffer->count) {
       BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update);
+      static_update = static_update && BLI_BITMAP_TEST(backbuffer->dynamic, past_id);
     }
     update = oedata->need_update;
     oedata->need_update = false;
@@ -160,6 +190,13 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
   if (update) {
     BLI_BITMAP_ENABLE(frontbuffer->update, id);
   }
+  if (is_dynamic) {
+    BLI_BITMAP_ENABLE(frontbuffer->dynamic, id);
+    frontbuffer->dynamic_count++;
+  }
+  if (static_update) {
+    BLI_BITMAP_ENABLE(frontbuffer->static_update, id);
+  }
 
   /* Update World AABB in frontbuffer. */
   BoundBox *bb = BKE_object_boundbox_get(ob);
@@ -213,6 +250,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Free textures if number mismatch. */
   if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
@@ -241,9 +279,29 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                               NULL);
   }
 
+  /* Only keep static layers when there are casters of both kinds. */
+  const bool use_static_layers = (frontbuffer->dynamic_count > 0) &&
+                                 (frontbuffer->dynamic_count < frontbuffer->count);
+  if (use_static_layers && !sldata->shadow_cube_static_pool) {
+    sldata->shadow_cube_static_pool = DRW_texture_create_2d_array(
+        linfo->shadow_cube_size,
+        linfo->shadow_cube_size,
+        max_ii(1, linfo->num_cube_layer * 6),
+        shadow_pool_format,
+        DRW_TEX_FILTER | DRW_TEX_COMPARE,
+        NULL);
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
+  }
+  else if (!use_static_layers) {
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
+  }
+
   if (sldata->shadow_fb == NULL) {
     sldata->shadow_fb = GPU_framebuffer_create("shadow_fb");
   }
+  if (sldata->shadow_static_fb == NULL) {
+    sldata->shadow_static_fb = GPU_framebuffer_create("shadow_static_fb");
+  }
 
   /* Gather all light own update bits. to avoid costly intersection check.  */
   for (int j = 0; j < linfo->cube_len; j++) {
@@ -252,6 +310,10 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     if (EEVEE_shadows_cube_setup(linfo, evli, effects->taa_current_sample - 1)) {
       BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
     }
+    /* The light itself changed, its static layers are outdated too. */
+    if (BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
+    }
   }
 
   /* TODO(fclem): This part can be slow, optimize it. */
@@ -261,10 +323,16 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      /* A static caster is also in the static layers. */
+      const bool is_static = !BLI_BITMAP_TEST(backbuffer->dynamic, i);
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j) ||
+            (is_static && !BLI_BITMAP_TEST(&linfo->sh_cube_static_update[0], j))) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
             BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            if (is_static) {
+              BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
+            }
           }
         }
       }
@@ -273,12 +341,17 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Search for updates in current shadow casters. */
   bbox = frontbuffer->bbox;
   for (int i = 0; i < frontbuffer->count; i++) {
-    /* If the shadowcaster has been updated. */
-    if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+    /* If the shadowcaster has been updated or was not part of the static layers. */
+    const bool static_update = BLI_BITMAP_TEST(frontbuffer->static_update, i);
+    if (BLI_BITMAP_TEST(frontbuffer->update, i) || static_update) {
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j) ||
+            (static_update && !BLI_BITMAP_TEST(&linfo->sh_cube_static_update[0], j))) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
             BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            if (static_update) {
+              BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
+            }
           }
         }
       }
@@ -295,6 +368,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->dynamic, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->static_update, frontbuffer->alloc_count);
   }
 }
 
@@ -195,6 +195,11 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
                           cube_data->shadowmat,
                           g_data->cube_views);
 
+  /* Static casters are rendered to their own layers, only copied when they didn't change. */
+  const bool use_static_layers = (sldata->shadow_cube_static_pool != NULL);
+  const bool static_update = !use_static_layers ||
+                             BLI_BITMAP_TEST(&linfo->sh_cube_static_update[0], cube_index);
+
   /* Render shadow cube */
   /* Render 6 faces separately: seems to be faster for the general case.
    * The only time it's more beneficial is when the CPU culling overhead
@@ -216,10 +221,27 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
     GPU_framebuffer_texture_layer_attach(sldata->shadow_fb, sldata->shadow_cube_pool, 0, layer, 0);
-    GPU_framebuffer_bind(sldata->shadow_fb);
-    GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
-    DRW_draw_pass(psl->shadow_pass);
+
+    if (use_static_layers) {
+      GPU_framebuffer_texture_layer_attach(
+          sldata->shadow_static_fb, sldata->shadow_cube_static_pool, 0, layer, 0);
+      if (static_update) {
+        GPU_framebuffer_bind(sldata->shadow_static_fb);
+        GPU_framebuffer_clear_depth(sldata->shadow_static_fb, 1.0f);
+        DRW_draw_pass(psl->shadow_pass);
+      }
+      GPU_framebuffer_blit(sldata->shadow_static_fb, 0, sldata->shadow_fb, 0, GPU_DEPTH_BIT);
+      GPU_framebuffer_bind(sldata->shadow_fb);
+    }
+    else {
+      GPU_framebuffer_bind(sldata->shadow_fb);
+      GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
+      DRW_draw_pass(psl->shadow_pass);
+    }
+    DRW_draw_pass(psl->shadow_dynamic_pass);
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  /* Without static layers, they will need to be rendered when used again. */
+  BLI_BITMAP_SET(&linfo->sh_cube_static_update[0], cube_index, !use_static_layers);
 }
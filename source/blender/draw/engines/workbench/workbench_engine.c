@@ -169,15 +169,64 @@ static void workbench_cache_texpaint_populate(WORKBENCH_PrivateData *wpd, Object
   }
 }
 
+/* Draw calls of the first instance of a dupli source. They are re-used by the following
+ * instances, which share the same geometry and materials, as long as the shading groups do not
+ * depend on the object itself. Stored in a single allocation, as expected by the draw manager. */
+typedef struct WORKBENCH_DupliCall {
+  DRWShadingGroup *grp;
+  struct GPUBatch *geom;
+} WORKBENCH_DupliCall;
+
+typedef struct WORKBENCH_DupliData {
+  eV3DShadingColorType color_type;
+  bool has_transp_mat;
+  int calls_len;
+  /* Points right after this struct. */
+  WORKBENCH_DupliCall *calls;
+} WORKBENCH_DupliData;
+
+static void workbench_dupli_data_store(WORKBENCH_DupliData **dupli_data,
+                                       eV3DShadingColorType color_type,
+                                       bool has_transp_mat,
+                                       const WORKBENCH_DupliCall *calls,
+                                       int calls_len)
+{
+  MEM_SAFE_FREE(*dupli_data);
+  WORKBENCH_DupliData *data = MEM_mallocN(sizeof(*data) + sizeof(*calls) * calls_len, __func__);
+  data->color_type = color_type;
+  data->has_transp_mat = has_transp_mat;
+  data->calls_len = calls_len;
+  data->calls = (WORKBENCH_DupliCall *)(data + 1);
+  memcpy(data->calls, calls, sizeof(*calls) * calls_len);
+  *dupli_data = data;
+}
+
 static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
                                             Object *ob,
                                             eV3DShadingColorType color_type,
+                                            WORKBENCH_DupliData **dupli_data,
                                             bool *r_transp)
 {
   const bool use_tex = ELEM(color_type, V3D_SHADING_TEXTURE_COLOR);
   const bool use_vcol = ELEM(color_type, V3D_SHADING_VERTEX_COLOR);
   const bool use_single_drawcall = !ELEM(
       color_type, V3D_SHADING_MATERIAL_COLOR, V3D_SHADING_TEXTURE_COLOR);
+  /* Object, random and single colors use per object material data. */
+  const bool use_dupli_data = (dupli_data != NULL) && (use_vcol || !use_single_drawcall);
+
+  if (use_dupli_data && *dupli_data != NULL && (*dupli_data)->color_type == color_type) {
+    const WORKBENCH_DupliData *data = *dupli_data;
+    for (int i = 0; i < data->calls_len; i++) {
+      workbench_object_drawcall(data->calls[i].grp, data->calls[i].geom, ob);
+    }
+    if (data->has_transp_mat) {
+      *r_transp = true;
+    }
+    return;
+  }
+
+  WORKBENCH_DupliCall *calls = NULL;
+  int calls_len = 0;
 
   if (use_single_drawcall) {
     struct GPUBatch *geom;
@@ -201,6 +250,8 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
     if (geom) {
       DRWShadingGroup *grp = workbench_material_setup(wpd, ob, 0, color_type, r_transp);
       workbench_object_drawcall(grp, geom, ob);
+      calls = BLI_array_alloca(calls, 1);
+      calls[calls_len++] = (WORKBENCH_DupliCall){grp, geom};
     }
   }
   else {
@@ -208,15 +259,42 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
                                           workbench_object_surface_material_get(ob);
     if (geoms) {
       const int materials_len = DRW_cache_object_material_count_get(ob);
+      calls = BLI_array_alloca(calls, materials_len);
       for (int i = 0; i < materials_len; i++) {
         if (geoms[i] == NULL) {
           continue;
         }
         DRWShadingGroup *grp = workbench_material_setup(wpd, ob, i + 1, color_type, r_transp);
         workbench_object_drawcall(grp, geoms[i], ob);
+        calls[calls_len++] = (WORKBENCH_DupliCall){grp, geoms[i]};
       }
     }
   }
+
+  if (use_dupli_data) {
+    workbench_dupli_data_store(dupli_data, color_type, *r_transp, calls, calls_len);
+  }
+}
+
+/* Object too small on screen to need its real surface, see #DRW_cache_object_surface_proxy_get.
+ * The proxy has no attributes other than position and normal, so draw it with the color of the
+ * first material. */
+static void workbench_cache_proxy_populate(WORKBENCH_PrivateData *wpd,
+                                           Object *ob,
+                                           struct GPUBatch *geom,
+                                           eV3DShadingColorType color_type,
+                                           bool *r_transp)
+{
+  int mat_nr = 0;
+  if (ELEM(color_type, V3D_SHADING_MATERIAL_COLOR, V3D_SHADING_TEXTURE_COLOR)) {
+    color_type = V3D_SHADING_MATERIAL_COLOR;
+    mat_nr = 1;
+  }
+  else if (color_type == V3D_SHADING_VERTEX_COLOR) {
+    color_type = V3D_SHADING_SINGLE_COLOR;
+  }
+  DRWShadingGroup *grp = workbench_material_setup(wpd, ob, mat_nr, color_type, r_transp);
+  workbench_object_drawcall(grp, geom, ob);
 }
 
 static void workbench_cache_hair_populate(WORKBENCH_PrivateData *wpd,
@@ -381,17 +459,30 @@ void workbench_cache_populate(void *ved, Object *ob)
 
   if (ELEM(ob->type, OB_MESH, OB_CURVE, OB_SURF, OB_FONT, OB_MBALL, OB_POINTCLOUD)) {
     bool use_sculpt_pbvh, use_texpaint_mode, draw_shadow, has_transp_mat = false;
+    struct GPUBatch *proxy;
     eV3DShadingColorType color_type = workbench_color_type_get(
         wpd, ob, &use_sculpt_pbvh, &use_texpaint_mode, &draw_shadow);
 
+    if (!use_sculpt_pbvh && !draw_shadow &&
+        (wpd->shading.flag & V3D_SHADING_OCCLUSION_CULLING) && DRW_object_is_occluded(ob)) {
+      /* Hidden behind other objects: skip its batch extraction. */
+      return;
+    }
+
     if (use_sculpt_pbvh) {
       workbench_cache_sculpt_populate(wpd, ob, color_type);
     }
     else if (use_texpaint_mode) {
       workbench_cache_texpaint_populate(wpd, ob);
     }
+    else if ((proxy = DRW_cache_object_surface_proxy_get(ob))) {
+      workbench_cache_proxy_populate(wpd, ob, proxy, color_type, &has_transp_mat);
+      /* Not noticeable at this size. */
+      draw_shadow = false;
+    }
     else {
-      workbench_cache_common_populate(wpd, ob, color_type, &has_transp_mat);
+      WORKBENCH_DupliData **dupli_data = (WORKBENCH_DupliData **)DRW_duplidata_get(vedata);
+      workbench_cache_common_populate(wpd, ob, color_type, dupli_data, &has_transp_mat);
     }
 
     if (draw_shadow) {
@@ -532,6 +623,11 @@ void workbench_draw_sample(void *ved)
       }
     }
 
+    if (wpd->shading.flag & V3D_SHADING_OCCLUSION_CULLING) {
+      /* Only opaque surfaces can hide other objects. */
+      DRW_occlusion_culling_capture();
+    }
+
     workbench_volume_draw_pass(vedata);
 
     if (xray_is_visible) {
@@ -565,6 +661,10 @@ void workbench_draw_sample(void *ved)
 
     workbench_dof_draw_pass(vedata);
   }
+  else if (wpd->shading.flag & V3D_SHADING_OCCLUSION_CULLING) {
+    /* Nothing was redrawn, keep the depth captured by the previous samples. */
+    DRW_occlusion_culling_capture();
+  }
 
   workbench_antialiasing_draw_pass(vedata);
 }
@@ -654,6 +654,9 @@ struct DefaultTextureList *DRW_viewport_texture_list_get(void);
 
 void DRW_viewport_request_redraw(void);
 
+void DRW_occlusion_culling_capture(void);
+bool DRW_object_is_occluded(struct Object *ob);
+
 void DRW_render_to_image(struct RenderEngine *engine, struct Depsgraph *depsgraph);
 void DRW_render_object_iter(void *vedata,
                             struct RenderEngine *engine,
@@ -28,6 +28,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_volume_types.h"
 
 #include "UI_resources.h"
@@ -907,6 +908,61 @@ GPUBatch *DRW_cache_object_surface_get(Object *ob)
   }
 }
 
+/* Maximum size in pixels of the objects drawn using their bounding box proxy. */
+#define SURFACE_PROXY_MAX_SIZE 6.0f
+
+static bool drw_object_use_surface_proxy(Object *ob)
+{
+  if (!U.experimental.use_viewport_lod) {
+    return false;
+  }
+  if (DRW_state_is_image_render() || DRW_state_is_select() || DRW_state_is_depth()) {
+    return false;
+  }
+  if (ob->mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+
+  /* Bounding sphere of the object. */
+  float center[4], radius;
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  radius = len_v3v3(bb->vec[0], bb->vec[6]) * 0.5f * mat4_to_scale(ob->obmat);
+  mul_m4_v3(ob->obmat, center);
+  center[3] = 1.0f;
+
+  float persmat[4][4], winmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  DRW_view_winmat_get(NULL, winmat, false);
+  mul_m4_v4(persmat, center);
+  if (center[3] <= radius) {
+    /* Too close to the camera, or orthographic view with a huge object. */
+    return false;
+  }
+
+  const float *viewport_size = DRW_viewport_size_get();
+  const float size_px = 2.0f * radius / center[3] *
+                        max_ff(winmat[0][0] * viewport_size[0], winmat[1][1] * viewport_size[1]) *
+                        0.5f;
+  return size_px < SURFACE_PROXY_MAX_SIZE;
+}
+
+/**
+ * Return a bounding box proxy of the object surface if the object is too small on screen to need
+ * its real surface, NULL otherwise. The full batches of such objects are only extracted once they
+ * get large enough, which makes opening big scenes interactive faster.
+ */
+GPUBatch *DRW_cache_object_surface_proxy_get(Object *ob)
+{
+  if (ob->type != OB_MESH || !drw_object_use_surface_proxy(ob)) {
+    return NULL;
+  }
+  return DRW_mesh_batch_cache_get_surface_proxy(ob->data);
+}
+
 /* Returns the vertbuf used by shaded surface batch. */
 GPUVertBuf *DRW_cache_object_pos_vertbuf_get(Object *ob)
 {
@@ -64,6 +64,7 @@ struct GPUBatch *DRW_gpencil_dummy_buffer_get(void);
 struct GPUBatch *DRW_cache_object_all_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_object_edge_detection_get(struct Object *ob, bool *r_is_manifold);
 struct GPUBatch *DRW_cache_object_surface_get(struct Object *ob);
+struct GPUBatch *DRW_cache_object_surface_proxy_get(struct Object *ob);
 struct GPUBatch *DRW_cache_object_loose_edges_get(struct Object *ob);
 struct GPUBatch **DRW_cache_object_surface_material_get(struct Object *ob,
                                                         struct GPUMaterial **gpumat_array,
@@ -195,6 +195,8 @@ typedef struct MeshBatchCache {
     /* Surfaces / Render */
     GPUBatch *surface;
     GPUBatch *surface_weights;
+    /* Bounding box used in place of the surface when it is too small on screen. */
+    GPUBatch *surface_proxy;
     /* Edit mode */
     GPUBatch *edit_triangles;
     GPUBatch *edit_vertices;
@@ -5816,26 +5816,93 @@ static struct TaskNode *user_data_init_task_node_create(struct TaskGraph *task_g
 /** \name Extract Loop
  * \{ */
 
-static void extract_range_task_create(struct TaskGraph *task_graph,
-                                      struct TaskNode *task_node_user_data_init,
-                                      ExtractTaskData *taskdata,
-                                      const eMRIterType type,
-                                      int start,
-                                      int length)
-{
-  taskdata = MEM_dupallocN(taskdata);
-  atomic_add_and_fetch_int32(taskdata->task_counter, 1);
-  taskdata->iter_type = type;
-  taskdata->start = start;
-  taskdata->end = start + length;
-  struct TaskNode *task_node = BLI_task_graph_node_create(
-      task_graph, extract_run, taskdata, MEM_freeN);
-  BLI_task_graph_edge_create(task_node_user_data_init, task_node);
+/* A range of elements of one iteration type, which is extracted for all threaded extractors
+ * by a single task. */
+typedef struct ExtractRangeTaskData {
+  const MeshRenderData *mr;
+  /** #ExtractTaskData of all threaded extractors, owned by the user-data init task. */
+  const ListBase *task_datas;
+  eMRIterType iter_type;
+  int start, end;
+} ExtractRangeTaskData;
+
+static void extract_range_run(void *__restrict taskdata)
+{
+  const ExtractRangeTaskData *data = (const ExtractRangeTaskData *)taskdata;
+  LISTBASE_FOREACH (ExtractTaskData *, td, data->task_datas) {
+    if ((td->iter_type & data->iter_type) == 0) {
+      continue;
+    }
+    mesh_extract_iter(
+        data->mr, data->iter_type, data->start, data->end, td->extract, td->user_data->user_data);
+
+    /* If this is the last range of the extractor, we do the finish function. */
+    int remainin_tasks = atomic_sub_and_fetch_int32(td->task_counter, 1);
+    if (remainin_tasks == 0 && td->extract->finish != NULL) {
+      td->extract->finish(td->mr, td->cache, td->buf, td->user_data->user_data);
+    }
+  }
+}
+
+static int extract_range_chunk_size(const int len)
+{
+  /* Aim for a few chunks per thread so the work can be balanced, without making chunks so small
+   * that the scheduling overhead dominates. */
+  const int num_threads = BLI_task_scheduler_num_threads();
+  return clamp_i(len / (num_threads * 4), 1024, 8192);
+}
+
+/* Create one task per range of elements, running all threaded extractors over that range.
+ * The source data of a range is then read once while it is still in cache, instead of each
+ * extractor walking the whole mesh on its own, and much fewer tasks are scheduled. */
+static void extract_range_tasks_create(struct TaskGraph *task_graph,
+                                       struct TaskNode *task_node_user_data_init,
+                                       const MeshRenderData *mr,
+                                       const ListBase *task_datas)
+{
+  eMRIterType iter_type_all = 0;
+  LISTBASE_FOREACH (ExtractTaskData *, td, task_datas) {
+    iter_type_all |= td->iter_type;
+  }
+
+  const struct {
+    eMRIterType iter_type;
+    int len;
+  } ranges[] = {
+      {MR_ITER_LOOPTRI, mr->tri_len},
+      {MR_ITER_POLY, mr->poly_len},
+      {MR_ITER_LEDGE, mr->edge_loose_len},
+      {MR_ITER_LVERT, mr->vert_loose_len},
+  };
+
+  for (int i = 0; i < ARRAY_SIZE(ranges); i++) {
+    const eMRIterType iter_type = ranges[i].iter_type;
+    const int len = ranges[i].len;
+    if ((iter_type_all & iter_type) == 0) {
+      continue;
+    }
+    const int chunk_size = extract_range_chunk_size(len);
+    for (int start = 0; start < len; start += chunk_size) {
+      LISTBASE_FOREACH (ExtractTaskData *, td, task_datas) {
+        if (td->iter_type & iter_type) {
+          atomic_add_and_fetch_int32(td->task_counter, 1);
+        }
+      }
+      ExtractRangeTaskData *range_data = MEM_mallocN(sizeof(*range_data), __func__);
+      range_data->mr = mr;
+      range_data->task_datas = task_datas;
+      range_data->iter_type = iter_type;
+      range_data->start = start;
+      range_data->end = start + chunk_size;
+      struct TaskNode *task_node = BLI_task_graph_node_create(
+          task_graph, extract_range_run, range_data, MEM_freeN);
+      BLI_task_graph_edge_create(task_node_user_data_init, task_node);
+    }
+  }
 }
 
 static void extract_task_create(struct TaskGraph *task_graph,
                                 struct TaskNode *task_node_mesh_render_data,
-                                struct TaskNode *task_node_user_data_init,
                                 ListBase *single_threaded_task_datas,
                                 ListBase *user_data_init_task_datas,
                                 const Scene *scene,
@@ -5871,32 +5938,7 @@ static void extract_task_create(struct TaskGraph *task_graph,
   const int chunk_size = 8192;
   const bool use_thread = (mr->loop_len + mr->loop_loose_len) > chunk_size;
   if (use_thread && extract->use_threading) {
-
-    /* Divide task into sensible chunks. */
-    if (taskdata->iter_type & MR_ITER_LOOPTRI) {
-      for (int i = 0; i < mr->tri_len; i += chunk_size) {
-        extract_range_task_create(
-            task_graph, task_node_user_data_init, taskdata, MR_ITER_LOOPTRI, i, chunk_size);
-      }
-    }
-    if (taskdata->iter_type & MR_ITER_POLY) {
-      for (int i = 0; i < mr->poly_len; i += chunk_size) {
-        extract_range_task_create(
-            task_graph, task_node_user_data_init, taskdata, MR_ITER_POLY, i, chunk_size);
-      }
-    }
-    if (taskdata->iter_type & MR_ITER_LEDGE) {
-      for (int i = 0; i < mr->edge_loose_len; i += chunk_size) {
-        extract_range_task_create(
-            task_graph, task_node_user_data_init, taskdata, MR_ITER_LEDGE, i, chunk_size);
-      }
-    }
-    if (taskdata->iter_type & MR_ITER_LVERT) {
-      for (int i = 0; i < mr->vert_loose_len; i += chunk_size) {
-        extract_range_task_create(
-            task_graph, task_node_user_data_init, taskdata, MR_ITER_LVERT, i, chunk_size);
-      }
-    }
+    /* Ranges are created for all threaded extractors at once, see #extract_range_tasks_create. */
     BLI_addtail(user_data_init_task_datas, taskdata);
   }
   else if (use_thread) {
@@ -5937,27 +5979,29 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
    * Small extractions and extractions that can't be multi-threaded are grouped in a single
    * `extract_single_threaded_task_node`.
    *
-   * Other extractions will create a node for each loop exceeding 8192 items. these nodes are
-   * linked to the `user_data_init_task_node`. the `user_data_init_task_node` prepares the
-   * user_data needed for the extraction based on the data extracted from the mesh.
-   * counters are used to check if the finalize of a task has to be called.
+   * Other extractions are split into ranges of elements (at most 8192 items per range). A node
+   * is created for each range, which runs all of these extractors over the same range, so the
+   * mesh data of a range is only loaded once. These nodes are linked to the
+   * `user_data_init_task_node`. the `user_data_init_task_node` prepares the user_data needed for
+   * the extraction based on the data extracted from the mesh. counters are used to check if the
+   * finalize of a task has to be called.
    *
    *                           Mesh extraction sub graph
    *
    *                                                       +----------------------+
-   *                                               +-----> | extract_task1_loop_1 |
+   *                                               +-----> | extract_range_tri_1  |
    *                                               |       +----------------------+
    * +------------------+     +----------------------+     +----------------------+
-   * | mesh_render_data | --> |                      | --> | extract_task1_loop_2 |
+   * | mesh_render_data | --> |                      | --> | extract_range_tri_2  |
    * +------------------+     |                      |     +----------------------+
    *   |                      |                      |     +----------------------+
-   *   |                      |    user_data_init    | --> | extract_task2_loop_1 |
+   *   |                      |    user_data_init    | --> | extract_range_poly_1 |
    *   v                      |                      |     +----------------------+
    * +------------------+     |                      |     +----------------------+
-   * | single_threaded  |     |                      | --> | extract_task2_loop_2 |
+   * | single_threaded  |     |                      | --> | extract_range_poly_2 |
    * +------------------+     +----------------------+     +----------------------+
    *                                               |       +----------------------+
-   *                                               +-----> | extract_task2_loop_3 |
+   *                                               +-----> | extract_range_poly_3 |
    *                                                       +----------------------+
    */
   eMRIterType iter_flag = 0;
@@ -6055,7 +6099,6 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   if (mbc.buf.name) { \
     extract_task_create(task_graph, \
                         task_node_mesh_render_data, \
-                        task_node_user_data_init, \
                         &single_threaded_task_data->task_datas, \
                         &user_data_init_task_data->task_datas, \
                         scene, \
@@ -6100,7 +6143,6 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
                                              &extract_lines;
     extract_task_create(task_graph,
                         task_node_mesh_render_data,
-                        task_node_user_data_init,
                         &single_threaded_task_data->task_datas,
                         &user_data_init_task_data->task_datas,
                         scene,
@@ -6129,6 +6171,8 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
    * The task is still part of the graph so the task_data will be freed when the graph is freed.
    */
   if (!BLI_listbase_is_empty(&user_data_init_task_data->task_datas)) {
+    extract_range_tasks_create(
+        task_graph, task_node_user_data_init, mr, &user_data_init_task_data->task_datas);
     BLI_task_graph_edge_create(task_node_mesh_render_data, task_node_user_data_init);
   }
 
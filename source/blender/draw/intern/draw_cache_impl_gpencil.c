@@ -72,27 +72,93 @@ typedef struct GpencilBatchCache {
   bool is_dirty;
   /** Last cache frame */
   int cache_frame;
+  /**
+   * Frames the batches were built from, in drawing order. They stay valid on other scene frames
+   * as long as the same frames are displayed, e.g. during playback between two keyframes.
+   */
+  bGPDframe **frames;
+  int frames_len;
 } GpencilBatchCache;
 
-static bool gpencil_batch_cache_valid(GpencilBatchCache *cache, bGPdata *gpd, int cfra)
+typedef struct gpFramesIterData {
+  bGPdata *gpd;
+  bGPDframe **frames;
+  int frames_len;
+  int frames_alloc;
+  int cfra;
+} gpFramesIterData;
+
+static void gpencil_visible_frames_cb(bGPDlayer *gpl,
+                                      bGPDframe *gpf,
+                                      bGPDstroke *UNUSED(gps),
+                                      void *thunk)
+{
+  gpFramesIterData *iter = (gpFramesIterData *)thunk;
+
+  if (gpf == NULL) {
+    return;
+  }
+  /* Strokes of the active frame are skipped in solo mode, see
+   * #BKE_gpencil_visible_stroke_iter. */
+  if ((gpf == gpl->actframe) && GPENCIL_PAINT_MODE(iter->gpd) &&
+      (gpl->flag & GP_LAYER_SOLO_MODE) && (gpf->framenum != iter->cfra)) {
+    gpf = NULL;
+  }
+
+  if (iter->frames_len == iter->frames_alloc) {
+    iter->frames_alloc = max_ii(16, iter->frames_alloc * 2);
+    iter->frames = MEM_reallocN(iter->frames, sizeof(*iter->frames) * iter->frames_alloc);
+  }
+  iter->frames[iter->frames_len++] = gpf;
+}
+
+/* Frames whose strokes are drawn at this scene frame. */
+static bGPDframe **gpencil_visible_frames_get(Object *ob, int cfra, int *r_frames_len)
 {
-  bool valid = true;
+  gpFramesIterData iter = {
+      .gpd = (bGPdata *)ob->data,
+      .cfra = cfra,
+  };
+  /* IMPORTANT: Keep in sync with gpencil_batches_ensure() */
+  bool do_onion = true;
+  BKE_gpencil_visible_stroke_iter(
+      NULL, ob, gpencil_visible_frames_cb, NULL, &iter, do_onion, cfra);
+
+  *r_frames_len = iter.frames_len;
+  return iter.frames;
+}
+
+static bool gpencil_batch_cache_valid(GpencilBatchCache *cache, Object *ob, int cfra)
+{
+  bGPdata *gpd = (bGPdata *)ob->data;
 
   if (cache == NULL) {
     return false;
   }
 
-  if (cfra != cache->cache_frame) {
-    valid = false;
+  if (gpd->flag & GP_DATA_CACHE_IS_DIRTY) {
+    return false;
   }
-  else if (gpd->flag & GP_DATA_CACHE_IS_DIRTY) {
-    valid = false;
+  if (cache->is_dirty) {
+    return false;
   }
-  else if (cache->is_dirty) {
-    valid = false;
+
+  if (cfra != cache->cache_frame) {
+    /* Only the displayed frames matter, not the scene frame itself. */
+    int frames_len;
+    bGPDframe **frames = gpencil_visible_frames_get(ob, cfra, &frames_len);
+    const bool same_frames = (frames_len == cache->frames_len) &&
+                             (frames_len == 0 ||
+                              memcmp(frames, cache->frames, sizeof(*frames) * frames_len) == 0);
+    MEM_SAFE_FREE(frames);
+
+    if (!same_frames) {
+      return false;
+    }
+    cache->cache_frame = cfra;
   }
 
-  return valid;
+  return true;
 }
 
 static GpencilBatchCache *gpencil_batch_cache_init(Object *ob, int cfra)
@@ -110,6 +176,7 @@ static GpencilBatchCache *gpencil_batch_cache_init(Object *ob, int cfra)
 
   cache->is_dirty = true;
   cache->cache_frame = cfra;
+  cache->frames = gpencil_visible_frames_get(ob, cfra, &cache->frames_len);
 
   return cache;
 }
@@ -135,6 +202,9 @@ static void gpencil_batch_cache_clear(GpencilBatchCache *cache)
   GPU_BATCH_DISCARD_SAFE(cache->edit_curve_points_batch);
   GPU_VERTBUF_DISCARD_SAFE(cache->edit_curve_vbo);
 
+  MEM_SAFE_FREE(cache->frames);
+  cache->frames_len = 0;
+
   cache->is_dirty = true;
 }
 
@@ -143,7 +213,7 @@ static GpencilBatchCache *gpencil_batch_cache_get(Object *ob, int cfra)
   bGPdata *gpd = (bGPdata *)ob->data;
 
   GpencilBatchCache *cache = gpd->runtime.gpencil_cache;
-  if (!gpencil_batch_cache_valid(cache, gpd, cfra)) {
+  if (!gpencil_batch_cache_valid(cache, ob, cfra)) {
     gpencil_batch_cache_clear(cache);
     return gpencil_batch_cache_init(ob, cfra);
   }
@@ -49,6 +49,7 @@
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_mesh_tangent.h"
+#include "BKE_mesh_wrapper.h"
 #include "BKE_modifier.h"
 #include "BKE_object_deform.h"
 #include "BKE_paint.h"
@@ -489,11 +490,19 @@ static void mesh_batch_cache_init(Mesh *me)
 
   cache->is_editmode = me->edit_mesh != NULL;
 
-  if (cache->is_editmode == false) {
-    // cache->edge_len = mesh_render_edges_len_get(me);
-    // cache->tri_len = mesh_render_looptri_len_get(me);
-    // cache->poly_len = mesh_render_polys_len_get(me);
-    // cache->vert_len = mesh_render_verts_len_get(me);
+  /* Used to validate deform-only updates, see #mesh_batch_cache_topology_match. */
+  if (cache->is_editmode) {
+    const BMesh *bm = me->edit_mesh->bm;
+    cache->edge_len = bm->totedge;
+    cache->tri_len = me->edit_mesh->tottri;
+    cache->poly_len = bm->totface;
+    cache->vert_len = bm->totvert;
+  }
+  else {
+    cache->edge_len = me->totedge;
+    cache->tri_len = poly_to_tri_count(me->totpoly, me->totloop);
+    cache->poly_len = me->totpoly;
+    cache->vert_len = me->totvert;
   }
 
   cache->mat_len = mesh_render_mat_len_get(me);
@@ -622,6 +631,64 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   cache->batch_ready &= ~MBC_EDITUV;
 }
 
+/* Check whether the mesh still has the same amount of elements as when the cache has been
+ * created, as a safety check before keeping buffers which only depend on the topology. */
+static bool mesh_batch_cache_topology_match(const Mesh *me, const MeshBatchCache *cache)
+{
+  const BMEditMesh *em = me->edit_mesh;
+  if ((em != NULL) != cache->is_editmode) {
+    return false;
+  }
+  if (em != NULL) {
+    const BMesh *bm = em->bm;
+    return (cache->edge_len == bm->totedge) && (cache->tri_len == em->tottri) &&
+           (cache->poly_len == bm->totface) && (cache->vert_len == bm->totvert);
+  }
+  return (cache->edge_len == me->totedge) &&
+         (cache->tri_len == poly_to_tri_count(me->totpoly, me->totloop)) &&
+         (cache->poly_len == me->totpoly) && (cache->vert_len == me->totvert);
+}
+
+/* Discard buffers which depend on vertex coordinates, keeping the ones which only depend on the
+ * topology and attributes (edges, points, selection, UVs...).
+ * Triangles (and the adjacency built from them) are discarded as well since the tessellation
+ * depends on coordinates. */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbufcache) {
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.orco);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.skin_roots);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.edituv_tris);
+  }
+  for (int i = 0; i < cache->mat_len; i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache->final.tris_per_mat[i]);
+  }
+
+  /* Batches are cheap to re-create, discard all of them instead of tracking which buffers they
+   * use. Kept buffers are not extracted again when requested. */
+  for (int i = 0; i < sizeof(cache->batch) / sizeof(void *); i++) {
+    GPUBatch **batch = (GPUBatch **)&cache->batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_surface_batches(cache);
+
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+
+  cache->batch_ready = 0;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
   MeshBatchCache *cache = me->runtime.batch_cache;
@@ -687,6 +754,16 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
       GPU_BATCH_DISCARD_SAFE(cache->batch.edituv_fdots);
       cache->batch_ready &= ~MBC_EDITUV;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      if (cache->is_dirty) {
+        break;
+      }
+      if (!mesh_batch_cache_topology_match(me, cache)) {
+        cache->is_dirty = true;
+        break;
+      }
+      mesh_batch_cache_discard_deform(cache);
+      break;
     default:
       BLI_assert(0);
   }
@@ -798,6 +875,66 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return cache->batch.surface;
 }
 
+static GPUBatch *mesh_batch_surface_proxy_create(const float min[3], const float max[3])
+{
+  static GPUVertFormat format = {0};
+  static struct {
+    uint pos, nor;
+  } attr_id;
+  if (format.attr_len == 0) {
+    attr_id.pos = GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    attr_id.nor = GPU_vertformat_attr_add(&format, "nor", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+  }
+
+  GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
+  GPU_vertbuf_data_alloc(vbo, 6 * 6);
+
+  /* Quad corners in the plane of each face, counter-clockwise. */
+  const int quad[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  const int quad_tris[6] = {0, 1, 2, 0, 2, 3};
+  const float *bounds[2] = {min, max};
+  int v = 0;
+  for (int axis = 0; axis < 3; axis++) {
+    const int axis_u = (axis + 1) % 3;
+    const int axis_v = (axis + 2) % 3;
+    for (int side = 0; side < 2; side++) {
+      float nor[3] = {0.0f, 0.0f, 0.0f};
+      nor[axis] = side ? 1.0f : -1.0f;
+      for (int i = 0; i < 6; i++) {
+        /* Reverse the winding of the faces looking toward the negative axis. */
+        const int *corner = quad[side ? quad_tris[i] : quad_tris[5 - i]];
+        float co[3];
+        co[axis] = bounds[side][axis];
+        co[axis_u] = bounds[corner[0]][axis_u];
+        co[axis_v] = bounds[corner[1]][axis_v];
+        GPU_vertbuf_attr_set(vbo, attr_id.pos, v, co);
+        GPU_vertbuf_attr_set(vbo, attr_id.nor, v, nor);
+        v++;
+      }
+    }
+  }
+
+  return GPU_batch_create_ex(GPU_PRIM_TRIS, vbo, NULL, GPU_BATCH_OWNS_VBO);
+}
+
+/**
+ * Bounding box of the mesh with flat normals. It does not need any extraction, so it can be drawn
+ * in place of the surface of objects too small on screen to need it.
+ */
+GPUBatch *DRW_mesh_batch_cache_get_surface_proxy(Mesh *me)
+{
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  if (cache->batch.surface_proxy == NULL) {
+    float min[3], max[3];
+    INIT_MINMAX(min, max);
+    if (!BKE_mesh_wrapper_minmax(me, min, max)) {
+      return NULL;
+    }
+    cache->batch.surface_proxy = mesh_batch_surface_proxy_create(min, max);
+  }
+  return cache->batch.surface_proxy;
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -284,6 +284,10 @@ GPUBatch *DRW_volume_batch_cache_get_selection_surface(Volume *volume)
   return cache->selection_surface;
 }
 
+/* Past this many voxels, the dense array and the texture of a grid would take several gigabytes,
+ * so it is displayed at a lower resolution instead. */
+#define VOLUME_TEXTURE_MAX_VOXELS (512 * 1024 * 1024)
+
 static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
                                             VolumeGrid *grid,
                                             VolumeBatchCache *cache)
@@ -317,8 +321,10 @@ static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
    * created. */
   const bool was_loaded = BKE_volume_grid_is_loaded(grid);
 
+  /* Grids too large for a 3D texture are displayed at a lower resolution. */
   DenseFloatVolumeGrid dense_grid;
-  if (BKE_volume_grid_dense_floats(volume, grid, &dense_grid)) {
+  if (BKE_volume_grid_dense_floats(
+          volume, grid, GPU_max_texture_3d_size(), VOLUME_TEXTURE_MAX_VOXELS, &dense_grid)) {
     copy_m4_m4(cache_grid->texture_to_object, dense_grid.texture_to_object);
     invert_m4_m4(cache_grid->object_to_texture, dense_grid.texture_to_object);
 
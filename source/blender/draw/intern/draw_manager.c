@@ -1355,6 +1355,9 @@ void DRW_notify_view_update(const DRWUpdateContext *update_ctx)
         .object_mode = OB_MODE_OBJECT,
     };
 
+    /* The depth of the previous redraw does not match the scene anymore. */
+    drw_occlusion_culling_tag_dirty(viewport);
+
     drw_engines_enable(view_layer, engine_type, gpencil_engine_needed);
     drw_engines_data_validate();
 
@@ -1508,6 +1511,7 @@ void DRW_draw_view(const bContext *C)
     DST.options.draw_background = (scene->r.alphamode == R_ADDSKY) ||
                                   (v3d->shading.type != OB_RENDER);
     DST.options.do_color_management = true;
+    DST.options.use_occlusion_culling = true;
     DRW_draw_render_loop_ex(depsgraph, engine_type, region, v3d, viewport, C);
   }
   else {
@@ -1582,6 +1586,8 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* Init engines */
   drw_engines_init();
 
+  drw_occlusion_culling_init();
+
   /* Cache filling */
   {
     PROFILE_START(stime);
@@ -1634,6 +1640,8 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   drw_engines_draw_scene();
 
+  drw_occlusion_culling_finish();
+
   /* Fix 3D view being "laggy" on macos and win+nvidia. (See T56996, T61474) */
   GPU_flush();
 
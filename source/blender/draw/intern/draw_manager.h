@@ -533,6 +533,7 @@ typedef struct DRWManager {
     uint do_color_management : 1;
     uint draw_background : 1;
     uint draw_text : 1;
+    uint use_occlusion_culling : 1;
   } options;
 
   /* Current rendering context */
@@ -563,6 +564,9 @@ typedef struct DRWManager {
   /* Contains list of objects that needs to be extracted from other objects. */
   struct GSet *delayed_extraction;
 
+  /** Occlusion buffer of the active viewport view. NULL if occlusion culling is not used. */
+  struct DRWOcclusionBuffer *occlusion;
+
   /* ---------- Nothing after this point is cleared after use ----------- */
 
   /* gl_context serves as the offset for clearing only
@@ -598,6 +602,10 @@ void drw_debug_init(void);
 eDRWCommandType command_type_get(const uint64_t *command_type_bits, int index);
 
 void drw_batch_cache_validate(Object *ob);
+
+void drw_occlusion_culling_init(void);
+void drw_occlusion_culling_finish(void);
+void drw_occlusion_culling_tag_dirty(struct GPUViewport *viewport);
 void drw_batch_cache_generate_requested(struct Object *ob);
 void drw_batch_cache_generate_requested_delayed(Object *ob);
 
@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_trace.h"
 
 #include "BKE_global.h"
 
@@ -905,45 +906,144 @@ static void draw_call_batching_finish(DRWShadingGroup *shgroup, DRWCommandsState
   }
 }
 
-static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
+static bool draw_uniform_equal(const DRWUniform *a, const DRWUniform *b)
+{
+  if ((a->type != b->type) || (a->location != b->location) || (a->length != b->length) ||
+      (a->arraysize != b->arraysize)) {
+    return false;
+  }
+  switch (a->type) {
+    case DRW_UNIFORM_INT_COPY:
+      return memcmp(a->ivalue, b->ivalue, sizeof(int) * a->length) == 0;
+    case DRW_UNIFORM_FLOAT_COPY:
+      return memcmp(a->fvalue, b->fvalue, sizeof(float) * a->length) == 0;
+    case DRW_UNIFORM_TEXTURE:
+    case DRW_UNIFORM_TEXTURE_REF:
+    case DRW_UNIFORM_IMAGE:
+    case DRW_UNIFORM_IMAGE_REF:
+      return (a->texture == b->texture) && (a->sampler_state == b->sampler_state);
+    case DRW_UNIFORM_BLOCK:
+    case DRW_UNIFORM_BLOCK_REF:
+      return a->block == b->block;
+    case DRW_UNIFORM_BLOCK_OBATTRS:
+      return a->uniform_attrs == b->uniform_attrs;
+    case DRW_UNIFORM_TFEEDBACK_TARGET:
+      /* Transform feedback needs to be disabled between shading groups. */
+      return false;
+    default:
+      return a->pvalue == b->pvalue;
+  }
+}
+
+static bool draw_uniform_find(const DRWShadingGroup *shgroup, const DRWUniform *uni)
+{
+  for (DRWUniformChunk *unichunk = shgroup->uniforms; unichunk; unichunk = unichunk->next) {
+    for (int i = 0; i < unichunk->uniform_used; i++) {
+      if (draw_uniform_equal(&unichunk->uniforms[i], uni)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Return true if the pending draw-calls of `shgroup` can be kept open and merged with the ones of
+ * `shgroup_next`. This is the case if binding `shgroup_next` would not change any GPU state:
+ * same shader, no local state change and all of its uniforms already bound by `shgroup`.
+ * Sub-groups created by #DRW_shgroup_create_sub are the most common case.
+ */
+static bool draw_shgroup_batching_can_continue(const DRWShadingGroup *shgroup,
+                                               const DRWShadingGroup *shgroup_next,
+                                               const DRWCommandsState *state)
+{
+  if (!USE_BATCHING || (G.f & G_FLAG_PICKSEL)) {
+    return false;
+  }
+  if (shgroup_next->shader != shgroup->shader) {
+    return false;
+  }
+  /* Local state changes are reset at the start of each shading group. */
+  if (state->drw_state_enabled != 0 || state->drw_state_disabled != 0) {
+    return false;
+  }
+  if (shgroup_next->uniforms == shgroup->uniforms) {
+    return true;
+  }
+  for (DRWUniformChunk *unichunk = shgroup_next->uniforms; unichunk; unichunk = unichunk->next) {
+    for (int i = 0; i < unichunk->uniform_used; i++) {
+      if (!draw_uniform_find(shgroup, &unichunk->uniforms[i])) {
+        return false;
+      }
+    }
+  }
+  /* Per draw-call resources must match both ways so the batching state stays valid. */
+  for (DRWUniformChunk *unichunk = shgroup->uniforms; unichunk; unichunk = unichunk->next) {
+    for (int i = 0; i < unichunk->uniform_used; i++) {
+      const DRWUniform *uni = &unichunk->uniforms[i];
+      if (uni->type >= DRW_UNIFORM_BLOCK_OBMATS && !draw_uniform_find(shgroup_next, uni)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Draw all commands of a shading group.
+ * If `is_continued` is true, the previous shading group left its pending draw-calls and
+ * bindings in `state` for this one to extend.
+ * Return true if this shading group did the same for `shgroup_next`.
+ */
+static bool draw_shgroup(DRWShadingGroup *shgroup,
+                         DRWShadingGroup *shgroup_next,
+                         DRWState pass_state,
+                         DRWCommandsState *state,
+                         bool is_continued)
 {
   BLI_assert(shgroup->shader);
 
-  DRWCommandsState state = {
-      .obmats_loc = -1,
-      .obinfos_loc = -1,
-      .obattrs_loc = -1,
-      .baseinst_loc = -1,
-      .chunkid_loc = -1,
-      .resourceid_loc = -1,
-      .obmat_loc = -1,
-      .obinv_loc = -1,
-      .obattrs_ubo = NULL,
-      .drw_state_enabled = 0,
-      .drw_state_disabled = 0,
-  };
-
-  const bool shader_changed = (DST.shader != shgroup->shader);
   bool use_tfeedback = false;
 
-  if (shader_changed) {
-    if (DST.shader) {
-      GPU_shader_unbind();
-
-      /* Unbinding can be costly. Skip in normal condition. */
-      if (G.debug & G_DEBUG_GPU) {
-        GPU_texture_unbind_all();
-        GPU_uniformbuf_unbind_all();
+  if (!is_continued) {
+    *state = (DRWCommandsState){
+        .obmats_loc = -1,
+        .obinfos_loc = -1,
+        .obattrs_loc = -1,
+        .baseinst_loc = -1,
+        .chunkid_loc = -1,
+        .resourceid_loc = -1,
+        .obmat_loc = -1,
+        .obinv_loc = -1,
+        .obattrs_ubo = NULL,
+        .drw_state_enabled = 0,
+        .drw_state_disabled = 0,
+    };
+
+    const bool shader_changed = (DST.shader != shgroup->shader);
+
+    if (shader_changed) {
+      if (DST.shader) {
+        GPU_shader_unbind();
+
+        /* Unbinding can be costly. Skip in normal condition. */
+        if (G.debug & G_DEBUG_GPU) {
+          GPU_texture_unbind_all();
+          GPU_uniformbuf_unbind_all();
+        }
       }
+      GPU_shader_bind(shgroup->shader);
+      DST.shader = shgroup->shader;
+      DST.batch = NULL;
     }
-    GPU_shader_bind(shgroup->shader);
-    DST.shader = shgroup->shader;
-    DST.batch = NULL;
-  }
 
-  draw_update_uniforms(shgroup, &state, &use_tfeedback);
+    draw_update_uniforms(shgroup, state, &use_tfeedback);
 
-  drw_state_set(pass_state);
+    drw_state_set(pass_state);
+  }
+  else {
+    BLI_assert(DST.shader == shgroup->shader);
+  }
 
   /* Rendering Calls */
   {
@@ -953,14 +1053,17 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
 
     draw_command_iter_begin(&iter, shgroup);
 
-    draw_call_batching_start(&state);
+    if (!is_continued) {
+      draw_call_batching_start(state);
+    }
 
     while ((cmd = draw_command_iter_step(&iter, &cmd_type))) {
 
       switch (cmd_type) {
+        case DRW_CMD_CLEAR:
         case DRW_CMD_DRWSTATE:
         case DRW_CMD_STENCIL:
-          draw_call_batching_flush(shgroup, &state);
+          draw_call_batching_flush(shgroup, state);
           break;
         case DRW_CMD_DRAW:
         case DRW_CMD_DRAW_PROCEDURAL:
@@ -985,30 +1088,30 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
                                 cmd->clear.stencil);
           break;
         case DRW_CMD_DRWSTATE:
-          state.drw_state_enabled |= cmd->state.enable;
-          state.drw_state_disabled |= cmd->state.disable;
-          drw_state_set((pass_state & ~state.drw_state_disabled) | state.drw_state_enabled);
+          state->drw_state_enabled |= cmd->state.enable;
+          state->drw_state_disabled |= cmd->state.disable;
+          drw_state_set((pass_state & ~state->drw_state_disabled) | state->drw_state_enabled);
           break;
         case DRW_CMD_STENCIL:
           drw_stencil_state_set(cmd->stencil.write_mask, cmd->stencil.ref, cmd->stencil.comp_mask);
           break;
         case DRW_CMD_SELECTID:
-          state.select_id = cmd->select_id.select_id;
-          state.select_buf = cmd->select_id.select_buf;
+          state->select_id = cmd->select_id.select_id;
+          state->select_buf = cmd->select_id.select_buf;
           break;
         case DRW_CMD_DRAW:
-          if (!USE_BATCHING || state.obmats_loc == -1 || (G.f & G_FLAG_PICKSEL) ||
+          if (!USE_BATCHING || state->obmats_loc == -1 || (G.f & G_FLAG_PICKSEL) ||
               cmd->draw.batch->inst[0]) {
             draw_call_single_do(
-                shgroup, &state, cmd->draw.batch, cmd->draw.handle, 0, 0, 0, 0, true);
+                shgroup, state, cmd->draw.batch, cmd->draw.handle, 0, 0, 0, 0, true);
           }
           else {
-            draw_call_batching_do(shgroup, &state, &cmd->draw);
+            draw_call_batching_do(shgroup, state, &cmd->draw);
           }
           break;
         case DRW_CMD_DRAW_PROCEDURAL:
           draw_call_single_do(shgroup,
-                              &state,
+                              state,
                               cmd->procedural.batch,
                               cmd->procedural.handle,
                               0,
@@ -1019,7 +1122,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           break;
         case DRW_CMD_DRAW_INSTANCE:
           draw_call_single_do(shgroup,
-                              &state,
+                              state,
                               cmd->instance.batch,
                               cmd->instance.handle,
                               0,
@@ -1030,7 +1133,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           break;
         case DRW_CMD_DRAW_RANGE:
           draw_call_single_do(shgroup,
-                              &state,
+                              state,
                               cmd->range.batch,
                               cmd->range.handle,
                               cmd->range.vert_first,
@@ -1041,7 +1144,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           break;
         case DRW_CMD_DRAW_INSTANCE_RANGE:
           draw_call_single_do(shgroup,
-                              &state,
+                              state,
                               cmd->instance_range.batch,
                               cmd->instance_range.handle,
                               0,
@@ -1053,12 +1156,19 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
       }
     }
 
-    draw_call_batching_finish(shgroup, &state);
+    if (!use_tfeedback && shgroup_next &&
+        draw_shgroup_batching_can_continue(shgroup, shgroup_next, state)) {
+      /* Keep pending draw-calls (and the draw list) open for the next shading group. */
+      return true;
+    }
+
+    draw_call_batching_finish(shgroup, state);
   }
 
   if (use_tfeedback) {
     GPU_shader_transform_feedback_disable(shgroup->shader);
   }
+  return false;
 }
 
 static void drw_update_view(void)
@@ -1108,9 +1218,14 @@ static void drw_draw_pass_ex(DRWPass *pass,
   }
 
   DRW_stats_query_start(pass->name);
+  /* Only the time spent submitting the pass, the GPU executes it asynchronously. */
+  BLI_trace_begin("draw", pass->name);
 
+  DRWCommandsState state;
+  bool is_continued = false;
   for (DRWShadingGroup *shgroup = start_group; shgroup; shgroup = shgroup->next) {
-    draw_shgroup(shgroup, pass->state);
+    DRWShadingGroup *shgroup_next = (shgroup != end_group) ? shgroup->next : NULL;
+    is_continued = draw_shgroup(shgroup, shgroup_next, pass->state, &state, is_continued);
     /* break if upper limit */
     if (shgroup == end_group) {
       break;
@@ -1144,6 +1259,7 @@ static void drw_draw_pass_ex(DRWPass *pass,
     GPU_front_facing(false);
   }
 
+  BLI_trace_end();
   DRW_stats_query_end();
 }
 
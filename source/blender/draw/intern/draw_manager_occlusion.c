@@ -0,0 +1,290 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+/** \file
+ * \ingroup draw
+ *
+ * Occlusion culling using the depth buffer of the previous redraw.
+ *
+ * Engines supporting it capture their opaque depth buffer while drawing. It is reduced to a
+ * coarse grid of tiles, each one storing the farthest depth it contains. During the next cache
+ * populate, an object whose bounding box is behind every tile it covers is reported as occluded,
+ * and the engine can skip both its batch extraction and its drawing.
+ *
+ * The depth is always one redraw late. If it did not match the current view or scene, another
+ * redraw is requested so that objects that were wrongly culled do not stay hidden.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math.h"
+#include "BLI_task.h"
+
+#include "BKE_object.h"
+
+#include "DNA_object_types.h"
+#include "DNA_view3d_types.h"
+
+#include "GPU_framebuffer.h"
+#include "GPU_viewport.h"
+
+#include "draw_manager.h"
+
+/** Size in pixels of the square tiles of the occlusion buffer. */
+#define OCCLUSION_TILE_SIZE 16
+/** Avoid culling objects lying right on top of the occluder surface. */
+#define OCCLUSION_DEPTH_BIAS 1e-5f
+
+typedef struct DRWOcclusionBuffer {
+  /** Farthest window space depth of each tile. */
+  float *tiles;
+  int tiles_len[2];
+  /** Size in pixels of the captured depth buffer. */
+  int size[2];
+  /** View projection matrix used to render the captured depth. */
+  float persmat[4][4];
+  /** The scene changed since the depth was captured. */
+  bool is_dirty;
+
+  /* Per redraw state. */
+  /** The captured depth matches the current view and scene. */
+  bool is_valid;
+  /** The depth was captured again during this redraw. */
+  bool is_captured;
+  /** Number of objects reported as occluded during this redraw. */
+  int culled_len;
+} DRWOcclusionBuffer;
+
+/* -------------------------------------------------------------------- */
+/** \name Internal API
+ * \{ */
+
+void drw_occlusion_culling_init(void)
+{
+  DST.occlusion = NULL;
+
+  if (!DST.options.use_occlusion_culling || DST.draw_ctx.rv3d == NULL) {
+    return;
+  }
+
+  const int view = max_ii(0, GPU_viewport_active_view_get(DST.viewport));
+  DRWOcclusionBuffer **buffer_p = &DST.vmempool->occlusion[view];
+  if (*buffer_p == NULL) {
+    *buffer_p = MEM_callocN(sizeof(DRWOcclusionBuffer), __func__);
+  }
+
+  DRWOcclusionBuffer *buffer = *buffer_p;
+  buffer->is_valid = !buffer->is_dirty && equals_m4m4(buffer->persmat, DST.draw_ctx.rv3d->persmat);
+  buffer->is_captured = false;
+  buffer->culled_len = 0;
+
+  DST.occlusion = buffer;
+}
+
+void drw_occlusion_culling_finish(void)
+{
+  DRWOcclusionBuffer *buffer = DST.occlusion;
+  if (buffer == NULL) {
+    return;
+  }
+
+  if (buffer->culled_len > 0 && !(buffer->is_valid && buffer->is_captured)) {
+    /* Objects might have been culled using an outdated depth buffer, redraw using the one
+     * captured by this redraw. */
+    DRW_viewport_request_redraw();
+  }
+  if (!buffer->is_captured) {
+    /* None of the engines can use it anymore. */
+    MEM_SAFE_FREE(buffer->tiles);
+  }
+
+  DST.occlusion = NULL;
+}
+
+/* Can be called from another thread, see #DRW_notify_view_update. */
+void drw_occlusion_culling_tag_dirty(GPUViewport *viewport)
+{
+  ViewportMemoryPool *vmempool = GPU_viewport_mempool_get(viewport);
+  for (int i = 0; i < ARRAY_SIZE(vmempool->occlusion); i++) {
+    if (vmempool->occlusion[i]) {
+      vmempool->occlusion[i]->is_dirty = true;
+    }
+  }
+}
+
+void DRW_occlusion_buffer_free(DRWOcclusionBuffer *buffer)
+{
+  if (buffer) {
+    MEM_SAFE_FREE(buffer->tiles);
+    MEM_freeN(buffer);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Capture
+ * \{ */
+
+typedef struct OcclusionReduceData {
+  const float *depth;
+  DRWOcclusionBuffer *buffer;
+} OcclusionReduceData;
+
+static void occlusion_reduce_tile_row(void *__restrict userdata,
+                                      const int tile_y,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const OcclusionReduceData *data = userdata;
+  DRWOcclusionBuffer *buffer = data->buffer;
+  float *tiles = buffer->tiles + tile_y * buffer->tiles_len[0];
+
+  for (int x = 0; x < buffer->tiles_len[0]; x++) {
+    tiles[x] = 0.0f;
+  }
+
+  const int y_end = min_ii((tile_y + 1) * OCCLUSION_TILE_SIZE, buffer->size[1]);
+  for (int y = tile_y * OCCLUSION_TILE_SIZE; y < y_end; y++) {
+    const float *depth = data->depth + y * buffer->size[0];
+    for (int x = 0; x < buffer->size[0]; x++) {
+      float *tile = &tiles[x / OCCLUSION_TILE_SIZE];
+      *tile = max_ff(*tile, depth[x]);
+    }
+  }
+}
+
+/**
+ * Capture the depth of the default frame-buffer for the occlusion culling of the next redraw.
+ * Must be called by the engine when it contains the depth of all opaque surfaces, and only
+ * them.
+ */
+void DRW_occlusion_culling_capture(void)
+{
+  DRWOcclusionBuffer *buffer = DST.occlusion;
+  if (buffer == NULL) {
+    return;
+  }
+
+  buffer->is_captured = true;
+
+  if (buffer->is_valid && buffer->tiles != NULL) {
+    /* Nothing changed since the last capture (i.e: temporal anti-aliasing samples). */
+    return;
+  }
+
+  const int size[2] = {(int)DST.size[0], (int)DST.size[1]};
+  const int tiles_len[2] = {divide_ceil_u(size[0], OCCLUSION_TILE_SIZE),
+                            divide_ceil_u(size[1], OCCLUSION_TILE_SIZE)};
+
+  if (buffer->tiles == NULL || !equals_v2v2_int(buffer->tiles_len, tiles_len)) {
+    MEM_SAFE_FREE(buffer->tiles);
+    buffer->tiles = MEM_mallocN(sizeof(float) * tiles_len[0] * tiles_len[1], __func__);
+  }
+  copy_v2_v2_int(buffer->tiles_len, tiles_len);
+  copy_v2_v2_int(buffer->size, size);
+
+  float *depth = MEM_mallocN(sizeof(float) * size[0] * size[1], __func__);
+  DefaultFramebufferList *dfbl = DRW_viewport_framebuffer_list_get();
+  GPU_framebuffer_read_depth(dfbl->default_fb, 0, 0, size[0], size[1], GPU_DATA_FLOAT, depth);
+
+  OcclusionReduceData data = {
+      .depth = depth,
+      .buffer = buffer,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+  BLI_task_parallel_range(0, tiles_len[1], &data, occlusion_reduce_tile_row, &settings);
+
+  MEM_freeN(depth);
+
+  copy_m4_m4(buffer->persmat, DST.draw_ctx.rv3d->persmat);
+  buffer->is_dirty = false;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Culling Test
+ * \{ */
+
+/**
+ * Return true if the object bounding box is hidden behind the depth captured by the previous
+ * redraw. Always false if no engine captured one.
+ */
+bool DRW_object_is_occluded(Object *ob)
+{
+  DRWOcclusionBuffer *buffer = DST.occlusion;
+  if (buffer == NULL || buffer->tiles == NULL) {
+    return false;
+  }
+  /* Drawn on top of everything else. */
+  if (ob->dtx & OB_DRAW_IN_FRONT) {
+    return false;
+  }
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+
+  float rect_min[2] = {FLT_MAX, FLT_MAX};
+  float rect_max[2] = {-FLT_MAX, -FLT_MAX};
+  float depth_min = FLT_MAX;
+  for (int i = 0; i < 8; i++) {
+    float co[4];
+    mul_v3_m4v3(co, ob->obmat, bb->vec[i]);
+    co[3] = 1.0f;
+    mul_m4_v4(buffer->persmat, co);
+    if (co[3] <= FLT_EPSILON) {
+      /* Crosses the camera plane. */
+      return false;
+    }
+    mul_v3_fl(co, 1.0f / co[3]);
+    minmax_v2v2_v2(rect_min, rect_max, co);
+    depth_min = min_ff(depth_min, co[2]);
+  }
+
+  if (rect_max[0] < -1.0f || rect_max[1] < -1.0f || rect_min[0] > 1.0f || rect_min[1] > 1.0f) {
+    /* Left to the frustum culling. */
+    return false;
+  }
+
+  /* NDC to window space. */
+  depth_min = depth_min * 0.5f + 0.5f;
+
+  int tile_min[2], tile_max[2];
+  for (int i = 0; i < 2; i++) {
+    const float scale = 0.5f * buffer->size[i] / OCCLUSION_TILE_SIZE;
+    tile_min[i] = clamp_i((int)((rect_min[i] + 1.0f) * scale), 0, buffer->tiles_len[i] - 1);
+    tile_max[i] = clamp_i((int)((rect_max[i] + 1.0f) * scale), 0, buffer->tiles_len[i] - 1);
+  }
+
+  for (int y = tile_min[1]; y <= tile_max[1]; y++) {
+    const float *tiles = buffer->tiles + y * buffer->tiles_len[0];
+    for (int x = tile_min[0]; x <= tile_max[0]; x++) {
+      if (depth_min <= tiles[x] + OCCLUSION_DEPTH_BIAS) {
+        return false;
+      }
+    }
+  }
+
+  buffer->culled_len++;
+  return true;
+}
+
+/** \} */
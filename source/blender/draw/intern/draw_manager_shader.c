@@ -284,6 +284,42 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
   WM_jobs_start(wm, wm_job);
 }
 
+/**
+ * Move a material which is still waiting for compilation to the end of the queue so that it is
+ * compiled next. Used for materials requested again by the current redraw, this way materials in
+ * view are compiled before the ones which went out of view since they were queued.
+ */
+static void drw_deferred_shader_prioritize(GPUMaterial *mat)
+{
+  if (DST.draw_ctx.evil_C == NULL) {
+    return;
+  }
+  wmWindowManager *wm = CTX_wm_manager(DST.draw_ctx.evil_C);
+  wmWindow *win = CTX_wm_window(DST.draw_ctx.evil_C);
+  Scene *scene = (Scene *)DEG_get_original_id(&DST.draw_ctx.scene->id);
+
+  if (WM_jobs_test(wm, scene, WM_JOB_TYPE_SHADER_COMPILATION) == false) {
+    /* No job running, do not create a new one by calling WM_jobs_get. */
+    return;
+  }
+  wmJob *wm_job = WM_jobs_get(
+      wm, win, scene, "Shaders Compilation", WM_JOB_PROGRESS, WM_JOB_TYPE_SHADER_COMPILATION);
+
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)WM_jobs_customdata_get(wm_job);
+  if (comp == NULL) {
+    return;
+  }
+  BLI_spin_lock(&comp->list_lock);
+  DRWDeferredShader *dsh = (DRWDeferredShader *)BLI_findptr(
+      &comp->queue, mat, offsetof(DRWDeferredShader, mat));
+  /* The queue is consumed from its tail, see #drw_deferred_shader_compilation_exec. */
+  if (dsh != NULL && dsh != comp->queue.last) {
+    BLI_remlink(&comp->queue, dsh);
+    BLI_addtail(&comp->queue, dsh);
+  }
+  BLI_spin_unlock(&comp->list_lock);
+}
+
 void DRW_deferred_shader_remove(GPUMaterial *mat)
 {
   Scene *scene = GPU_material_scene(mat);
@@ -438,6 +474,9 @@ GPUMaterial *DRW_shader_find_from_world(World *wo,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
@@ -454,6 +493,9 @@ GPUMaterial *DRW_shader_find_from_material(Material *ma,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
@@ -38,6 +38,8 @@ typedef struct ScreenAnimData {
   int nextfra;                /* next frame to go to (when ANIMPLAY_FLAG_USE_NEXT_FRAME is set) */
   double lagging_frame_count; /* used for frame dropping */
   bool from_anim_edit;        /* playback was invoked from animation editor */
+  /* Steps the secondary regions weren't redrawn for, while playback couldn't keep up. */
+  int deferred_redraw_steps;
 } ScreenAnimData;
 
 /* for animplayer */
@@ -74,6 +74,16 @@ struct SnapObjectParams {
   unsigned int use_backface_culling : 1;
 };
 
+/** Flags for #ED_transform_snap_object_context_create. */
+enum {
+  /**
+   * Keep a tree of the bounds of the objects that aren't transformed, so each query only tests
+   * the objects near the ray or the cursor. Only valid while these objects don't change,
+   * as is the case during an object mode transform.
+   */
+  SNAP_OBJECT_USE_BOUNDS_TREE = (1 << 0),
+};
+
 typedef struct SnapObjectContext SnapObjectContext;
 SnapObjectContext *ED_transform_snap_object_context_create(struct Scene *scene, int flag);
 SnapObjectContext *ED_transform_snap_object_context_create_view3d(struct Scene *scene,
@@ -201,6 +201,11 @@ void mesh_foreachScreenVert(
     void (*func)(void *userData, struct BMVert *eve, const float screen_co[2], int index),
     void *userData,
     const eV3DProjTest clip_flag);
+void mesh_foreachScreenVert_parallel(
+    struct ViewContext *vc,
+    void (*func)(void *userData, struct BMVert *eve, const float screen_co[2], int index),
+    void *userData,
+    const eV3DProjTest clip_flag);
 void mesh_foreachScreenEdge(struct ViewContext *vc,
                             void (*func)(void *userData,
                                          struct BMEdge *eed,
@@ -224,6 +229,11 @@ void mesh_foreachScreenFace(
     void (*func)(void *userData, struct BMFace *efa, const float screen_co[2], int index),
     void *userData,
     const eV3DProjTest clip_flag);
+void mesh_foreachScreenFace_parallel(
+    struct ViewContext *vc,
+    void (*func)(void *userData, struct BMFace *efa, const float screen_co[2], int index),
+    void *userData,
+    const eV3DProjTest clip_flag);
 void nurbs_foreachScreenVert(struct ViewContext *vc,
                              void (*func)(void *userData,
                                           struct Nurb *nu,
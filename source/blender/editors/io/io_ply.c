@@ -0,0 +1,261 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup editor/io
+ */
+
+#ifdef WITH_IO_PLY
+#  include "DNA_object_types.h"
+#  include "DNA_space_types.h"
+
+#  include "BKE_context.h"
+#  include "BKE_main.h"
+#  include "BKE_report.h"
+
+#  include "BLI_path_util.h"
+#  include "BLI_string.h"
+#  include "BLI_utildefines.h"
+
+#  include "RNA_access.h"
+#  include "RNA_define.h"
+
+#  include "UI_interface.h"
+#  include "UI_resources.h"
+
+#  include "WM_api.h"
+#  include "WM_types.h"
+
+#  include "ED_object.h"
+
+#  include "IO_ply.h"
+#  include "io_ply.h"
+
+static int wm_ply_export_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSED(event))
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    Main *bmain = CTX_data_main(C);
+    char filepath[FILE_MAX];
+    const char *main_blendfile_path = BKE_main_blendfile_path(bmain);
+
+    if (main_blendfile_path[0] == '\0') {
+      BLI_strncpy(filepath, "untitled", sizeof(filepath));
+    }
+    else {
+      BLI_strncpy(filepath, main_blendfile_path, sizeof(filepath));
+    }
+
+    BLI_path_extension_replace(filepath, sizeof(filepath), ".ply");
+    RNA_string_set(op->ptr, "filepath", filepath);
+  }
+
+  WM_event_add_fileselect(C, op);
+
+  return OPERATOR_RUNNING_MODAL;
+}
+
+static int wm_ply_export_exec(bContext *C, wmOperator *op)
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filename[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filename);
+
+  struct PLYExportParams params = {
+      RNA_float_get(op->ptr, "global_scale"),
+      RNA_boolean_get(op->ptr, "selected_objects_only"),
+      RNA_boolean_get(op->ptr, "ascii"),
+      RNA_boolean_get(op->ptr, "export_normals"),
+      RNA_boolean_get(op->ptr, "export_colors"),
+  };
+
+  if (!PLY_export(C, filename, &params)) {
+    BKE_reportf(op->reports, RPT_ERROR, "Unable to write '%s'", filename);
+    return OPERATOR_CANCELLED;
+  }
+  return OPERATOR_FINISHED;
+}
+
+static void wm_ply_export_draw(bContext *UNUSED(C), wmOperator *op)
+{
+  uiLayout *layout = op->layout;
+  uiLayout *col;
+  struct PointerRNA *ptr = op->ptr;
+
+  uiLayoutSetPropSep(layout, true);
+
+  uiLayout *box = uiLayoutBox(layout);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "selected_objects_only", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "global_scale", 0, NULL, ICON_NONE);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "ascii", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "export_normals", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "export_colors", 0, NULL, ICON_NONE);
+}
+
+void WM_OT_ply_export(struct wmOperatorType *ot)
+{
+  ot->name = "Export Stanford PLY";
+  ot->description = "Save the meshes of the scene to a Stanford PLY file";
+  ot->idname = "WM_OT_ply_export";
+
+  ot->invoke = wm_ply_export_invoke;
+  ot->exec = wm_ply_export_exec;
+  ot->poll = WM_operator_winactive;
+  ot->ui = wm_ply_export_draw;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_OBJECT_IO,
+                                 FILE_BLENDER,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  PropertyRNA *prop = RNA_def_string(ot->srna, "filter_glob", "*.ply", 0, "", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+
+  RNA_def_float(
+      ot->srna,
+      "global_scale",
+      1.0f,
+      0.0001f,
+      1000.0f,
+      "Scale",
+      "Value by which to enlarge or shrink the objects with respect to the world's origin",
+      0.0001f,
+      1000.0f);
+  RNA_def_boolean(ot->srna,
+                  "selected_objects_only",
+                  false,
+                  "Selection Only",
+                  "Only the meshes of the selected objects are exported");
+  RNA_def_boolean(ot->srna,
+                  "ascii",
+                  false,
+                  "ASCII",
+                  "Write the text format, which is larger and slower to read than the binary one");
+  RNA_def_boolean(ot->srna,
+                  "export_normals",
+                  true,
+                  "Normals",
+                  "When checked, the normals of the vertices are exported");
+  RNA_def_boolean(ot->srna,
+                  "export_colors",
+                  true,
+                  "Vertex Colors",
+                  "When checked, the first vertex color layer of the meshes is exported");
+}
+
+/* ************************************************************************** */
+
+static int wm_ply_import_exec(bContext *C, wmOperator *op)
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filename[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filename);
+
+  struct PLYImportParams params = {
+      RNA_float_get(op->ptr, "global_scale"),
+      RNA_boolean_get(op->ptr, "validate_meshes"),
+  };
+
+  /* Switch out of edit mode to avoid being stuck in it (T54326). */
+  Object *obedit = CTX_data_edit_object(C);
+  if (obedit) {
+    ED_object_mode_set(C, OB_MODE_OBJECT);
+  }
+
+  if (!PLY_import(C, filename, &params)) {
+    BKE_reportf(op->reports, RPT_ERROR, "Unable to read '%s'", filename);
+    return OPERATOR_CANCELLED;
+  }
+
+  WM_main_add_notifier(NC_SCENE | ND_OB_ACTIVE, CTX_data_scene(C));
+  return OPERATOR_FINISHED;
+}
+
+static void wm_ply_import_draw(bContext *UNUSED(C), wmOperator *op)
+{
+  uiLayout *layout = op->layout;
+  uiLayout *col;
+  struct PointerRNA *ptr = op->ptr;
+
+  uiLayoutSetPropSep(layout, true);
+
+  uiLayout *box = uiLayoutBox(layout);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "global_scale", 0, NULL, ICON_NONE);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "validate_meshes", 0, NULL, ICON_NONE);
+}
+
+void WM_OT_ply_import(struct wmOperatorType *ot)
+{
+  ot->name = "Import Stanford PLY";
+  ot->description = "Load a Stanford PLY file";
+  ot->idname = "WM_OT_ply_import";
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+
+  ot->invoke = WM_operator_filesel;
+  ot->exec = wm_ply_import_exec;
+  ot->poll = WM_operator_winactive;
+  ot->ui = wm_ply_import_draw;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_OBJECT_IO,
+                                 FILE_BLENDER,
+                                 FILE_OPENFILE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  PropertyRNA *prop = RNA_def_string(ot->srna, "filter_glob", "*.ply", 0, "", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+
+  RNA_def_float(
+      ot->srna,
+      "global_scale",
+      1.0f,
+      0.0001f,
+      1000.0f,
+      "Scale",
+      "Value by which to enlarge or shrink the objects with respect to the world's origin",
+      0.0001f,
+      1000.0f);
+  RNA_def_boolean(ot->srna,
+                  "validate_meshes",
+                  false,
+                  "Validate Meshes",
+                  "Check imported mesh objects for invalid data (slow)");
+}
+
+#endif /* WITH_IO_PLY */
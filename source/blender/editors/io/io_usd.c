@@ -22,6 +22,7 @@
  */
 
 #ifdef WITH_USD
+#  include "DNA_object_types.h"
 #  include "DNA_space_types.h"
 
 #  include "BKE_context.h"
@@ -47,6 +48,8 @@
 
 #  include "DEG_depsgraph.h"
 
+#  include "ED_object.h"
+
 #  include "io_usd.h"
 #  include "usd.h"
 
@@ -242,4 +245,137 @@ void WM_OT_usd_export(struct wmOperatorType *ot)
                "are different settings for viewport and rendering");
 }
 
+/* ************************************************************************** */
+
+static int wm_usd_import_invoke(bContext *C, wmOperator *op, const wmEvent *event)
+{
+  eUSDOperatorOptions *options = MEM_callocN(sizeof(eUSDOperatorOptions), "eUSDOperatorOptions");
+  options->as_background_job = true;
+  op->customdata = options;
+
+  return WM_operator_filesel(C, op, event);
+}
+
+static int wm_usd_import_exec(bContext *C, wmOperator *op)
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filename[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filename);
+
+  eUSDOperatorOptions *options = (eUSDOperatorOptions *)op->customdata;
+  const bool as_background_job = (options != NULL && options->as_background_job);
+  MEM_SAFE_FREE(op->customdata);
+
+  const float scale = RNA_float_get(op->ptr, "scale");
+  const bool set_frame_range = RNA_boolean_get(op->ptr, "set_frame_range");
+  const bool validate_meshes = RNA_boolean_get(op->ptr, "validate_meshes");
+  const bool use_instancing = RNA_boolean_get(op->ptr, "use_instancing");
+  const bool defer_mesh_loading = RNA_boolean_get(op->ptr, "defer_mesh_loading");
+
+  struct USDImportParams params = {
+      scale,
+      set_frame_range,
+      validate_meshes,
+      use_instancing,
+      defer_mesh_loading,
+  };
+
+  /* Switch out of edit mode to avoid being stuck in it (T54326). */
+  Object *obedit = CTX_data_edit_object(C);
+  if (obedit) {
+    ED_object_mode_set(C, OB_MODE_OBJECT);
+  }
+
+  bool ok = USD_import(C, filename, &params, as_background_job);
+
+  return as_background_job || ok ? OPERATOR_FINISHED : OPERATOR_CANCELLED;
+}
+
+static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
+{
+  uiLayout *layout = op->layout;
+  uiLayout *col;
+  struct PointerRNA *ptr = op->ptr;
+
+  uiLayoutSetPropSep(layout, true);
+
+  uiLayout *box = uiLayoutBox(layout);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "scale", 0, NULL, ICON_NONE);
+
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "relative_path", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "set_frame_range", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "validate_meshes", 0, NULL, ICON_NONE);
+
+  box = uiLayoutBox(layout);
+  uiItemL(box, IFACE_("Experimental"), ICON_NONE);
+  uiItemR(box, ptr, "use_instancing", 0, NULL, ICON_NONE);
+  uiItemR(box, ptr, "defer_mesh_loading", 0, NULL, ICON_NONE);
+}
+
+void WM_OT_usd_import(struct wmOperatorType *ot)
+{
+  ot->name = "Import USD";
+  ot->description = "Load a USD file";
+  ot->idname = "WM_OT_usd_import";
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+
+  ot->invoke = wm_usd_import_invoke;
+  ot->exec = wm_usd_import_exec;
+  ot->poll = WM_operator_winactive;
+  ot->ui = wm_usd_import_draw;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_USD,
+                                 FILE_BLENDER,
+                                 FILE_OPENFILE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_RELPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  RNA_def_float(
+      ot->srna,
+      "scale",
+      1.0f,
+      0.0001f,
+      1000.0f,
+      "Scale",
+      "Value by which to enlarge or shrink the objects with respect to the world's origin",
+      0.0001f,
+      1000.0f);
+
+  RNA_def_boolean(
+      ot->srna,
+      "set_frame_range",
+      true,
+      "Set Frame Range",
+      "If checked, update scene's start and end frame to match those of the USD stage");
+
+  RNA_def_boolean(ot->srna,
+                  "validate_meshes",
+                  false,
+                  "Validate Meshes",
+                  "Check imported mesh objects for invalid data (slow)");
+
+  RNA_def_boolean(ot->srna,
+                  "use_instancing",
+                  false,
+                  "Instancing",
+                  "When checked, instanced prims are imported as instances of a collection per "
+                  "prototype. When unchecked, they are imported as real objects");
+
+  RNA_def_boolean(ot->srna,
+                  "defer_mesh_loading",
+                  false,
+                  "Load Meshes on Demand",
+                  "When checked, the meshes are not read by the import, but by a Mesh Sequence "
+                  "Cache modifier when the objects are evaluated");
+}
+
 #endif /* WITH_USD */
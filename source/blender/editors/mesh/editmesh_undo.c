@@ -114,6 +114,7 @@ typedef struct UndoMesh {
   } store;
 #endif /* USE_ARRAY_STORE */
 
+  /** Memory added to the array store by this state, the rest is shared with other states. */
   size_t undo_size;
 } UndoMesh;
 
@@ -353,13 +354,16 @@ static void um_arraystore_compact(UndoMesh *um, const UndoMesh *um_ref)
   um_arraystore_compact_ex(um, um_ref, true);
 }
 
-static void um_arraystore_compact_with_info(UndoMesh *um, const UndoMesh *um_ref)
+/**
+ * Compact \a um and add the memory it uses to \a r_step_data_size.
+ */
+static void um_arraystore_compact_with_info(UndoMesh *um,
+                                            const UndoMesh *um_ref,
+                                            size_t *r_step_data_size)
 {
-#  ifdef DEBUG_PRINT
   size_t size_expanded_prev, size_compacted_prev;
   BLI_array_store_at_size_calc_memory_usage(
       &um_arraystore.bs_stride, &size_expanded_prev, &size_compacted_prev);
-#  endif
 
 #  ifdef DEBUG_TIME
   TIMEIT_START(mesh_undo_compact);
@@ -371,12 +375,18 @@ static void um_arraystore_compact_with_info(UndoMesh *um, const UndoMesh *um_ref
   TIMEIT_END(mesh_undo_compact);
 #  endif
 
+  size_t size_expanded, size_compacted;
+  BLI_array_store_at_size_calc_memory_usage(
+      &um_arraystore.bs_stride, &size_expanded, &size_compacted);
+
+  /* Only count the chunks that are not shared with the previous states. */
+  um->undo_size = sizeof(*um) + ((size_compacted > size_compacted_prev) ?
+                                     size_compacted - size_compacted_prev :
+                                     0);
+  *r_step_data_size += um->undo_size;
+
 #  ifdef DEBUG_PRINT
   {
-    size_t size_expanded, size_compacted;
-    BLI_array_store_at_size_calc_memory_usage(
-        &um_arraystore.bs_stride, &size_expanded, &size_compacted);
-
     const double percent_total = size_expanded ?
                                      (((double)size_compacted / (double)size_expanded) * 100.0) :
                                      -1.0;
@@ -399,11 +409,13 @@ static void um_arraystore_compact_with_info(UndoMesh *um, const UndoMesh *um_ref
 struct UMArrayData {
   UndoMesh *um;
   const UndoMesh *um_ref; /* can be NULL */
+  /* Size of the undo step, only written by the (single) background thread. */
+  size_t *step_data_size;
 };
 static void um_arraystore_compact_cb(TaskPool *__restrict UNUSED(pool), void *taskdata)
 {
   struct UMArrayData *um_data = taskdata;
-  um_arraystore_compact_with_info(um_data->um, um_data->um_ref);
+  um_arraystore_compact_with_info(um_data->um, um_data->um_ref, um_data->step_data_size);
 }
 
 #  endif /* USE_ARRAY_STORE_THREAD */
@@ -501,7 +513,14 @@ static void um_arraystore_free(UndoMesh *um)
 
 /* for callbacks */
 /* undo simply makes copies of a bmesh */
-static void *undomesh_from_editmesh(UndoMesh *um, BMEditMesh *em, Key *key)
+/**
+ * \param r_step_data_size: The memory used by \a um is added to it,
+ * possibly later when compacting the arrays in the background.
+ */
+static void *undomesh_from_editmesh(UndoMesh *um,
+                                    BMEditMesh *em,
+                                    Key *key,
+                                    size_t *r_step_data_size)
 {
   BLI_assert(BLI_array_is_zeroed(um, 1));
 #ifdef USE_ARRAY_STORE_THREAD
@@ -554,12 +573,15 @@ static void *undomesh_from_editmesh(UndoMesh *um, BMEditMesh *em, Key *key)
     struct UMArrayData *um_data = MEM_mallocN(sizeof(*um_data), __func__);
     um_data->um = um;
     um_data->um_ref = um_ref;
+    um_data->step_data_size = r_step_data_size;
 
     BLI_task_pool_push(um_arraystore.task_pool, um_arraystore_compact_cb, um_data, true, NULL);
 #  else
-    um_arraystore_compact_with_info(um, um_ref);
+    um_arraystore_compact_with_info(um, um_ref, r_step_data_size);
 #  endif
   }
+#else
+  UNUSED_VARS(r_step_data_size);
 #endif
 
   return um;
@@ -733,9 +755,8 @@ static bool mesh_undosys_step_encode(struct bContext *C, struct Main *bmain, Und
     elem->obedit_ref.ptr = ob;
     Mesh *me = elem->obedit_ref.ptr->data;
     BMEditMesh *em = me->edit_mesh;
-    undomesh_from_editmesh(&elem->data, me->edit_mesh, me->key);
+    undomesh_from_editmesh(&elem->data, me->edit_mesh, me->key, &us->step.data_size);
     em->needs_flush_to_id = 1;
-    us->step.data_size += elem->data.undo_size;
   }
   MEM_freeN(objects);
 
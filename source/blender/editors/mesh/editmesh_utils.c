@@ -1087,6 +1087,10 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
   KDTree_3d *tree = NULL;
   MirrTopoStore_t mesh_topo_store = {NULL, -1, -1, -1};
 
+  /* Nearest vertex to the mirrored coordinates, in the order of the vertices looped over. */
+  int *tree_mirr_index = NULL;
+  int tree_mirr_len = 0;
+
   BM_mesh_elem_table_ensure(bm, BM_VERT);
 
   if (r_index == NULL) {
@@ -1120,6 +1124,25 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
       BLI_kdtree_3d_insert(tree, i, v->co);
     }
     BLI_kdtree_3d_balance(tree);
+
+    /* Search all vertices at once, the filter matches the loop below. */
+    float(*tree_mirr_co)[3] = MEM_mallocN(sizeof(*tree_mirr_co) * (size_t)bm->totvert, __func__);
+    BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+      if (respecthide && BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
+        continue;
+      }
+      if (use_select && !BM_elem_flag_test(v, BM_ELEM_SELECT)) {
+        continue;
+      }
+      copy_v3_v3(tree_mirr_co[tree_mirr_len], v->co);
+      tree_mirr_co[tree_mirr_len][axis] *= -1.0f;
+      tree_mirr_len++;
+    }
+    tree_mirr_index = MEM_mallocN(sizeof(*tree_mirr_index) * (size_t)tree_mirr_len, __func__);
+    BLI_kdtree_3d_find_nearest_batch(
+        tree, tree_mirr_co, (uint)tree_mirr_len, tree_mirr_index, NULL);
+    MEM_freeN(tree_mirr_co);
+    tree_mirr_len = 0;
   }
 
 #define VERT_INTPTR(_v, _i) (r_index ? &r_index[_i] : BM_ELEM_CD_GET_VOID_P(_v, cd_vmirr_offset))
@@ -1152,7 +1175,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
       co[axis] *= -1.0f;
 
       v_mirr = NULL;
-      i_mirr = BLI_kdtree_3d_find_nearest(tree, co, NULL);
+      i_mirr = tree_mirr_index[tree_mirr_len++];
       if (i_mirr != -1) {
         BMVert *v_test = BM_vert_at_index(bm, i_mirr);
         if (len_squared_v3v3(co, v_test->co) < maxdist_sq) {
@@ -1179,6 +1202,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
   }
   else {
     BLI_kdtree_3d_free(tree);
+    MEM_freeN(tree_mirr_index);
   }
 }
 
@@ -1444,10 +1468,20 @@ void EDBM_stats_update(BMEditMesh *em)
 void EDBM_update_generic(Mesh *mesh, const bool do_tessellation, const bool is_destructive)
 {
   BMEditMesh *em = mesh->edit_mesh;
+  /* Any operator may change topology, the draw cache has to be fully re-created. */
+  em->is_deform_only_update = false;
   /* Order of calling isn't important. */
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
+  if (do_tessellation && is_destructive) {
+    /* Large topology changes can leave the memory pools mostly empty, pack them before
+     * the tessellation which references the elements. */
+    if (BM_mesh_is_fragmented(em->bm)) {
+      BM_mesh_compact(em->bm);
+    }
+  }
+
   if (do_tessellation) {
     BKE_editmesh_looptri_calc(em);
   }
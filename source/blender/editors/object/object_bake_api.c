@@ -36,6 +36,8 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 
+#include "PIL_time.h"
+
 #include "BKE_context.h"
 #include "BKE_global.h"
 #include "BKE_image.h"
@@ -1157,7 +1159,21 @@ static void bake_targets_free(BakeTargets *targets)
 
 /* Main Bake Logic */
 
+static Depsgraph *bake_depsgraph_new(const BakeAPIRender *bkr)
+{
+  /* We build a depsgraph for the baking,
+   * so we don't need to change the original data to adjust visibility and modifiers. */
+  Depsgraph *depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(depsgraph);
+  return depsgraph;
+}
+
+/**
+ * \param depsgraph: Built by #bake_depsgraph_new, shared by all the objects baked separately
+ * so that the render engine can keep the synced scene between them.
+ */
 static int bake(const BakeAPIRender *bkr,
+                Depsgraph *depsgraph,
                 Object *ob_low,
                 const ListBase *selected_objects,
                 ReportList *reports)
@@ -1165,12 +1181,7 @@ static int bake(const BakeAPIRender *bkr,
   Render *re = bkr->render;
   Main *bmain = bkr->main;
   Scene *scene = bkr->scene;
-  ViewLayer *view_layer = bkr->view_layer;
-
-  /* We build a depsgraph for the baking,
-   * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
+  const double start_time = PIL_check_seconds_timer();
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1255,6 +1266,8 @@ static int bake(const BakeAPIRender *bkr,
     if (mmd_low) {
       mmd_flags_low = mmd_low->flags;
       mmd_low->uv_smooth = SUBSURF_UV_SMOOTH_NONE;
+      /* The depsgraph might already have been evaluated for a previous object. */
+      DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
     }
   }
 
@@ -1479,6 +1492,9 @@ static int bake(const BakeAPIRender *bkr,
           if (md) {
             md->mode = mode;
           }
+
+          /* Evaluated data was freed, evaluate it again for the next object. */
+          DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
         }
         break;
       }
@@ -1496,6 +1512,11 @@ static int bake(const BakeAPIRender *bkr,
     if (bake_targets_output(
             bkr, &targets, ob_low, ob_low_eval, me_low, pixel_array_low, reports)) {
       op_result = OPERATOR_FINISHED;
+      BKE_reportf(reports,
+                  RPT_INFO,
+                  "Baked object \"%s\" in %.2f seconds",
+                  ob_low->id.name + 2,
+                  PIL_check_seconds_timer() - start_time);
     }
     else {
       op_result = OPERATOR_CANCELLED;
@@ -1517,6 +1538,7 @@ cleanup:
 
   if (mmd_low) {
     mmd_low->flags = mmd_flags_low;
+    DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
   }
 
   if (pixel_array_low) {
@@ -1537,8 +1559,6 @@ cleanup:
     BKE_id_free(NULL, &me_cage->id);
   }
 
-  DEG_graph_free(depsgraph);
-
   return op_result;
 }
 
@@ -1645,15 +1665,22 @@ static int bake_exec(bContext *C, wmOperator *op)
   RE_SetReports(re, bkr.reports);
 
   if (bkr.is_selected_to_active) {
-    result = bake(&bkr, bkr.ob, &bkr.selected_objects, bkr.reports);
+    Depsgraph *depsgraph = bake_depsgraph_new(&bkr);
+    result = bake(&bkr, depsgraph, bkr.ob, &bkr.selected_objects, bkr.reports);
+    DEG_graph_free(depsgraph);
   }
   else {
     CollectionPointerLink *link;
     bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
+
+    Depsgraph *depsgraph = bake_depsgraph_new(&bkr);
+    RE_bake_engine_batch_begin(re);
     for (link = bkr.selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      result = bake(&bkr, ob_iter, NULL, bkr.reports);
+      result = bake(&bkr, depsgraph, ob_iter, NULL, bkr.reports);
     }
+    RE_bake_engine_batch_end(re);
+    DEG_graph_free(depsgraph);
   }
 
   RE_SetReports(re, NULL);
@@ -1697,19 +1724,30 @@ static void bake_startjob(void *bkv, short *UNUSED(stop), short *do_update, floa
   }
 
   if (bkr->is_selected_to_active) {
-    bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, bkr->reports);
+    Depsgraph *depsgraph = bake_depsgraph_new(bkr);
+    bkr->result = bake(bkr, depsgraph, bkr->ob, &bkr->selected_objects, bkr->reports);
+    DEG_graph_free(depsgraph);
   }
   else {
     CollectionPointerLink *link;
     bkr->is_clear = bkr->is_clear && BLI_listbase_is_single(&bkr->selected_objects);
+
+    Depsgraph *depsgraph = bake_depsgraph_new(bkr);
+    RE_bake_engine_batch_begin(bkr->render);
     for (link = bkr->selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      bkr->result = bake(bkr, ob_iter, NULL, bkr->reports);
+      bkr->result = bake(bkr, depsgraph, ob_iter, NULL, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
-        return;
+        break;
       }
     }
+    RE_bake_engine_batch_end(bkr->render);
+    DEG_graph_free(depsgraph);
+
+    if (bkr->result == OPERATOR_CANCELLED) {
+      return;
+    }
   }
 
   RE_SetReports(bkr->render, NULL);
@@ -4381,6 +4381,23 @@ static void screen_animation_region_tag_redraw(ScrArea *area,
 
 //#define PROFILE_AUDIO_SYNCH
 
+/**
+ * While playback can't keep up with the frame rate, regions other than the 3D viewports
+ * (and the region playback was started from) are only redrawn every few steps,
+ * leaving more of the frame time for the viewports.
+ */
+#define ANIMPLAY_DEFERRED_REDRAW_STEPS_MAX 2
+
+static bool screen_animation_region_is_primary(const ScreenAnimData *sad,
+                                               const ScrArea *area,
+                                               const ARegion *region)
+{
+  if (region == sad->region) {
+    return true;
+  }
+  return (area->spacetype == SPACE_VIEW3D) && (region->regiontype == RGN_TYPE_WINDOW);
+}
+
 static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), const wmEvent *event)
 {
   bScreen *screen = CTX_wm_screen(C);
@@ -4547,16 +4564,30 @@ static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), con
     ED_update_for_newframe(bmain, depsgraph);
   }
 
+  /* The timer fired later than the frame-rate requires, the previous step took too long. */
+  const bool is_lagging = (wt->delta > 1.5 / FPS);
+  bool redraw_secondary = true;
+  if (is_lagging && (sad->deferred_redraw_steps < ANIMPLAY_DEFERRED_REDRAW_STEPS_MAX)) {
+    redraw_secondary = false;
+    sad->deferred_redraw_steps++;
+  }
+  else {
+    sad->deferred_redraw_steps = 0;
+  }
+
   LISTBASE_FOREACH (wmWindow *, window, &wm->windows) {
     const bScreen *win_screen = WM_window_get_active_screen(window);
 
     LISTBASE_FOREACH (ScrArea *, area, &win_screen->areabase) {
       LISTBASE_FOREACH (ARegion *, region, &area->regionbase) {
         bool redraw = false;
-        if (region == sad->region) {
-          redraw = true;
+        if (screen_animation_region_is_primary(sad, area, region)) {
+          redraw = (region == sad->region) ||
+                   match_region_with_redraws(
+                       area, region->regiontype, sad->redraws, sad->from_anim_edit);
         }
-        else if (match_region_with_redraws(
+        else if (redraw_secondary &&
+                 match_region_with_redraws(
                      area, region->regiontype, sad->redraws, sad->from_anim_edit)) {
           redraw = true;
         }
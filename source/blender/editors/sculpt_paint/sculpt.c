@@ -24,6 +24,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "CLG_log.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_dial_2d.h"
 #include "BLI_ghash.h"
@@ -107,6 +109,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Brush stroke statistics, see #sculpt_stroke_stats_log. */
+static CLG_LogRef LOG = {"ed.sculpt.stroke"};
+
 /* Sculpt PBVH abstraction API
  *
  * This is read-only, for writing use PBVH vertex iterators. There vd.index matches
@@ -5917,6 +5922,14 @@ static void do_brush_action(Sculpt *sd, Object *ob, Brush *brush, UnifiedPaintSe
   if (totnode) {
     float location[3];
 
+    ss->cache->stats.tot_node += totnode;
+    for (int n = 0; n < totnode; n++) {
+      int unique_verts;
+      BKE_pbvh_node_num_verts(ss->pbvh, nodes[n], &unique_verts, NULL);
+      ss->cache->stats.tot_vert += unique_verts;
+      ss->cache->stats.node_vert_max = max_ii(ss->cache->stats.node_vert_max, unique_verts);
+    }
+
     SculptThreadedTaskData task_data = {
         .sd = sd,
         .ob = ob,
@@ -7841,6 +7854,7 @@ static void sculpt_stroke_update_step(bContext *C,
   Object *ob = CTX_data_active_object(C);
   SculptSession *ss = ob->sculpt;
   const Brush *brush = BKE_paint_brush(&sd->paint);
+  const double time_start = PIL_check_seconds_timer();
 
   SCULPT_stroke_modifiers_check(C, ob, brush);
   sculpt_update_cache_variants(C, sd, ob, itemptr);
@@ -7899,6 +7913,32 @@ static void sculpt_stroke_update_step(bContext *C,
   else {
     SCULPT_flush_update_step(C, SCULPT_UPDATE_COORDS);
   }
+
+  ss->cache->stats.tot_dab++;
+  ss->cache->stats.time += PIL_check_seconds_timer() - time_start;
+}
+
+/**
+ * Log the amount of work done by the stroke, to evaluate the brush throughput.
+ * Enabled with `--log "ed.sculpt.stroke"`.
+ */
+static void sculpt_stroke_stats_log(const StrokeCache *cache)
+{
+  if (cache->stats.tot_dab == 0) {
+    return;
+  }
+  const double time_ms = cache->stats.time * 1000.0;
+  CLOG_INFO(&LOG,
+            1,
+            "brush='%s', dabs=%d, nodes=%" PRId64 ", verts=%" PRId64
+            ", largest node=%d verts, %.3f ms per dab, %.1f verts per ms",
+            cache->brush->id.name + 2,
+            cache->stats.tot_dab,
+            cache->stats.tot_node,
+            cache->stats.tot_vert,
+            cache->stats.node_vert_max,
+            time_ms / cache->stats.tot_dab,
+            (time_ms > 0.0) ? cache->stats.tot_vert / time_ms : 0.0);
 }
 
 static void sculpt_brush_exit_tex(Sculpt *sd)
@@ -7953,6 +7993,8 @@ static void sculpt_stroke_done(const bContext *C, struct PaintStroke *UNUSED(str
       SCULPT_automasking_cache_free(ss->cache->automasking);
     }
 
+    sculpt_stroke_stats_log(ss->cache);
+
     BKE_pbvh_node_color_buffer_free(ss->pbvh);
     SCULPT_cache_free(ss->cache);
     ss->cache = NULL;
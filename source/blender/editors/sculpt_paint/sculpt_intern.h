@@ -600,6 +600,14 @@ typedef struct SculptUndoNodeGeometry {
   int totpoly;
 } SculptUndoNodeGeometry;
 
+/* Array of an undo node stored compressed while its undo step is not being applied. */
+typedef struct SculptUndoCompressedArray {
+  void *data;
+  size_t size;
+  /* Size of the array once decompressed. */
+  size_t raw_size;
+} SculptUndoCompressedArray;
+
 typedef struct SculptUndoNode {
   struct SculptUndoNode *next, *prev;
 
@@ -654,6 +662,12 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* Compressed #co, #orig_co, #mask and #col, these are NULL while compressed. */
+  SculptUndoCompressedArray co_compressed;
+  SculptUndoCompressedArray orig_co_compressed;
+  SculptUndoCompressedArray mask_compressed;
+  SculptUndoCompressedArray col_compressed;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -1045,6 +1059,17 @@ typedef struct StrokeCache {
   rcti previous_r; /* previous redraw rectangle */
   rcti current_r;  /* current redraw rectangle */
 
+  /* Work done by the stroke, logged when it is done. */
+  struct {
+    int tot_dab;
+    int64_t tot_node;
+    int64_t tot_vert;
+    /* Unique vertices of the largest node, a brush can't be faster than processing it. */
+    int node_vert_max;
+    /* Time spent in the stroke steps, in seconds. */
+    double time;
+  } stats;
+
 } StrokeCache;
 
 /* Sculpt Filters */
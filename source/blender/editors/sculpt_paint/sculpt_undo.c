@@ -26,6 +26,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
@@ -70,6 +72,8 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+#include "zlib.h"
+
 /* Implementation of undo system for objects in sculpt mode.
  *
  * Each undo step in sculpt mode consists of list of nodes, each node contains:
@@ -898,6 +902,11 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    MEM_SAFE_FREE(unode->co_compressed.data);
+    MEM_SAFE_FREE(unode->orig_co_compressed.data);
+    MEM_SAFE_FREE(unode->mask_compressed.data);
+    MEM_SAFE_FREE(unode->col_compressed.data);
+
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1433,6 +1442,167 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Once an undo step is pushed, the coordinates, masks and colors of its nodes are only used to
+ * undo or redo it, they are kept compressed until then.
+ *
+ * Each float is XOR-ed with the same component of the previous element, which clears the high
+ * bytes for nearby values. The bytes are then grouped by their position in the floats, and the
+ * result is compressed with zlib at its fastest level.
+ * \{ */
+
+static void sculpt_undo_array_compress(UndoSculpt *usculpt,
+                                       void **array,
+                                       SculptUndoCompressedArray *compressed,
+                                       const int stride)
+{
+  if (*array == NULL) {
+    return;
+  }
+  BLI_assert(compressed->data == NULL);
+
+  const size_t raw_size = MEM_allocN_len(*array);
+  const size_t words_num = raw_size / sizeof(uint32_t);
+  const uint32_t *words = *array;
+  BLI_assert(raw_size % sizeof(uint32_t) == 0);
+
+  uchar *encoded = MEM_mallocN(raw_size, __func__);
+  for (size_t i = 0; i < words_num; i++) {
+    const uint32_t word = (i >= (size_t)stride) ? words[i] ^ words[i - stride] : words[i];
+    for (int b = 0; b < 4; b++) {
+      encoded[b * words_num + i] = (uchar)(word >> (b * 8));
+    }
+  }
+
+  uLongf size = compressBound((uLong)raw_size);
+  Bytef *data = MEM_mallocN(size, __func__);
+  const int result = compress2(data, &size, encoded, (uLong)raw_size, Z_BEST_SPEED);
+  MEM_freeN(encoded);
+
+  if (result != Z_OK || size >= raw_size) {
+    /* Keep the arrays which do not compress as they are. */
+    MEM_freeN(data);
+    return;
+  }
+
+  compressed->data = MEM_reallocN(data, size);
+  compressed->size = size;
+  compressed->raw_size = raw_size;
+
+  MEM_freeN(*array);
+  *array = NULL;
+
+  atomic_sub_and_fetch_z(&usculpt->undo_size, raw_size - size);
+}
+
+static void sculpt_undo_array_decompress(UndoSculpt *usculpt,
+                                         void **array,
+                                         SculptUndoCompressedArray *compressed,
+                                         const int stride)
+{
+  if (compressed->data == NULL) {
+    return;
+  }
+  BLI_assert(*array == NULL);
+
+  const size_t raw_size = compressed->raw_size;
+  const size_t words_num = raw_size / sizeof(uint32_t);
+
+  uchar *encoded = MEM_mallocN(raw_size, __func__);
+  uLongf size = (uLongf)raw_size;
+  const int result = uncompress(encoded, &size, compressed->data, (uLong)compressed->size);
+  BLI_assert(result == Z_OK && size == raw_size);
+  UNUSED_VARS_NDEBUG(result);
+
+  uint32_t *words = MEM_mallocN(raw_size, "SculptUndoNode array");
+  for (size_t i = 0; i < words_num; i++) {
+    uint32_t word = 0;
+    for (int b = 0; b < 4; b++) {
+      word |= (uint32_t)encoded[b * words_num + i] << (b * 8);
+    }
+    words[i] = (i >= (size_t)stride) ? word ^ words[i - stride] : word;
+  }
+  MEM_freeN(encoded);
+
+  atomic_add_and_fetch_z(&usculpt->undo_size, raw_size - compressed->size);
+
+  MEM_freeN(compressed->data);
+  compressed->data = NULL;
+  compressed->size = 0;
+  compressed->raw_size = 0;
+
+  *array = words;
+}
+
+typedef struct SculptUndoCompressData {
+  UndoSculpt *usculpt;
+  SculptUndoNode **nodes;
+  bool compress;
+} SculptUndoCompressData;
+
+static void sculpt_undo_node_compress_task_cb(void *__restrict userdata,
+                                              const int n,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptUndoCompressData *data = userdata;
+  UndoSculpt *usculpt = data->usculpt;
+  SculptUndoNode *unode = data->nodes[n];
+
+  if (data->compress) {
+    sculpt_undo_array_compress(usculpt, (void **)&unode->co, &unode->co_compressed, 3);
+    sculpt_undo_array_compress(usculpt, (void **)&unode->orig_co, &unode->orig_co_compressed, 3);
+    sculpt_undo_array_compress(usculpt, (void **)&unode->mask, &unode->mask_compressed, 1);
+    sculpt_undo_array_compress(usculpt, (void **)&unode->col, &unode->col_compressed, 4);
+  }
+  else {
+    sculpt_undo_array_decompress(usculpt, (void **)&unode->co, &unode->co_compressed, 3);
+    sculpt_undo_array_decompress(
+        usculpt, (void **)&unode->orig_co, &unode->orig_co_compressed, 3);
+    sculpt_undo_array_decompress(usculpt, (void **)&unode->mask, &unode->mask_compressed, 1);
+    sculpt_undo_array_decompress(usculpt, (void **)&unode->col, &unode->col_compressed, 4);
+  }
+}
+
+static void sculpt_undo_nodes_compress_ex(UndoSculpt *usculpt, const bool compress)
+{
+  const int totnode = BLI_listbase_count(&usculpt->nodes);
+  if (totnode == 0) {
+    return;
+  }
+
+  SculptUndoNode **nodes = MEM_mallocN(sizeof(*nodes) * totnode, __func__);
+  int n = 0;
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    nodes[n++] = unode;
+  }
+
+  SculptUndoCompressData data = {
+      .usculpt = usculpt,
+      .nodes = nodes,
+      .compress = compress,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, totnode, &data, sculpt_undo_node_compress_task_cb, &settings);
+
+  MEM_freeN(nodes);
+}
+
+static void sculpt_undo_nodes_compress(UndoSculpt *usculpt)
+{
+  sculpt_undo_nodes_compress_ex(usculpt, true);
+}
+
+static void sculpt_undo_nodes_decompress(UndoSculpt *usculpt)
+{
+  sculpt_undo_nodes_compress_ex(usculpt, false);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1457,6 +1627,7 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_nodes_compress(&us->data);
   us->step.data_size = us->data.undo_size;
 
   SculptUndoNode *unode = us->data.nodes.last;
@@ -1477,7 +1648,10 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_nodes_decompress(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_nodes_compress(&us->data);
+  us->step.data_size = us->data.undo_size;
   us->step.is_applied = false;
 }
 
@@ -1486,7 +1660,10 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_nodes_decompress(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_nodes_compress(&us->data);
+  us->step.data_size = us->data.undo_size;
   us->step.is_applied = true;
 }
 
@@ -1999,6 +1999,10 @@ static int outliner_id_operation_exec(bContext *C, wmOperator *op)
       break;
     }
     case OUTLINER_IDOP_OVERRIDE_LIBRARY_RESYNC_HIERARCHY: {
+      /* Share the relations between the resync of all selected hierarchies, they are only
+       * invalidated when one of them actually has to be re-created. */
+      Main *bmain = CTX_data_main(C);
+      BKE_main_relations_create(bmain, 0);
       outliner_do_libdata_operation(C,
                                     op->reports,
                                     scene,
@@ -2006,6 +2010,7 @@ static int outliner_id_operation_exec(bContext *C, wmOperator *op)
                                     &space_outliner->tree,
                                     id_override_library_resync_fn,
                                     &(OutlinerLibOverrideData){.do_hierarchy = true});
+      BKE_main_relations_free(bmain);
       ED_undo_push(C, "Resync Overridden Data Hierarchy");
       break;
     }
@@ -158,6 +158,16 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
     case NC_OBJECT:
       switch (wmn->data) {
         case ND_TRANSFORM:
+        case ND_POSE:
+          /* Interactive transform changes values shown in the tree, never its hierarchy.
+           * Rebuilding the tree on every step is too slow for scenes with many objects. */
+          if (wmn->action == NA_EDITED) {
+            ED_region_tag_redraw_no_rebuild(region);
+          }
+          else {
+            ED_region_tag_redraw(region);
+          }
+          break;
         case ND_BONE_ACTIVE:
         case ND_BONE_SELECT:
         case ND_DRAW:
@@ -71,22 +71,55 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+static void proxy_task_rebuild(
+    void *userdata, int index, short *stop, short *do_update, float *progress)
+{
+  struct SeqIndexBuildContext **contexts = userdata;
+  SEQ_proxy_rebuild(contexts[index], stop, do_update, progress);
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
-  LinkData *link;
+  LinkData *link_first = pj->queue.first;
+
+  /* Strips can be added to the queue while the job runs, loop until there are no new ones. */
+  while (link_first) {
+    int contexts_len = 0;
+    LinkData *link_last = NULL;
+    for (LinkData *link = link_first; link; link = link->next) {
+      contexts_len++;
+      link_last = link;
+    }
 
-  for (link = pj->queue.first; link; link = link->next) {
-    struct SeqIndexBuildContext *context = link->data;
+    struct SeqIndexBuildContext **contexts = MEM_mallocN(sizeof(*contexts) * contexts_len,
+                                                         __func__);
+    int threaded_len = 0;
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+    /* Image proxies are rendered one after the other, movies share the task scheduler. */
+    for (LinkData *link = link_first; link != link_last->next; link = link->next) {
+      struct SeqIndexBuildContext *context = link->data;
+      if (SEQ_proxy_rebuild_is_threadsafe(context)) {
+        contexts[threaded_len++] = context;
+      }
+      else if (!*stop) {
+        SEQ_proxy_rebuild(context, stop, do_update, progress);
+      }
+    }
+
+    if (!*stop) {
+      WM_jobs_tasks_run(threaded_len, proxy_task_rebuild, contexts, stop, do_update, progress);
+    }
+    MEM_freeN(contexts);
 
     if (*stop) {
       pj->stop = 1;
       fprintf(stderr, "Canceling proxy rebuild on users request...\n");
       break;
     }
+
+    link_first = link_last->next;
   }
 }
 
@@ -29,6 +29,7 @@
 
 #include "BLI_math_geom.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -37,6 +38,7 @@
 #include "BKE_curve.h"
 #include "BKE_displist.h"
 #include "BKE_editmesh.h"
+#include "BKE_editmesh_cache.h"
 #include "BKE_mesh_iterators.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_modifier.h"
@@ -189,6 +191,80 @@ void mesh_foreachScreenVert(
   BKE_mesh_foreach_mapped_vert(me, mesh_foreachScreenVert__mapFunc, &data, MESH_FOREACH_NOP);
 }
 
+typedef struct foreachScreenVertParallel_userData {
+  foreachScreenVert_userData data;
+  BMVert **vtable;
+  /** Deformed coordinates of the cage, NULL when the BMesh coordinates are used. */
+  const float (*vert_coords)[3];
+} foreachScreenVertParallel_userData;
+
+static void mesh_foreachScreenVert_parallel__fn(void *__restrict userdata,
+                                                const int index,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const foreachScreenVertParallel_userData *data_parallel = userdata;
+  const foreachScreenVert_userData *data = &data_parallel->data;
+  BMVert *eve = data_parallel->vtable[index];
+
+  if (!BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
+    const float *co = data_parallel->vert_coords ? data_parallel->vert_coords[index] : eve->co;
+    float screen_co[2];
+
+    if (ED_view3d_project_float_object(data->vc.region, co, screen_co, data->clip_flag) !=
+        V3D_PROJ_RET_OK) {
+      return;
+    }
+
+    data->func(data->userData, eve, screen_co, index);
+  }
+}
+
+/**
+ * Multi-threaded #mesh_foreachScreenVert, \a func must be thread-safe
+ * (it's never called twice for the same vertex).
+ */
+void mesh_foreachScreenVert_parallel(
+    ViewContext *vc,
+    void (*func)(void *userData, BMVert *eve, const float screen_co[2], int index),
+    void *userData,
+    eV3DProjTest clip_flag)
+{
+  Mesh *me = editbmesh_get_eval_cage_from_orig(
+      vc->depsgraph, vc->scene, vc->obedit, &CD_MASK_BAREMESH);
+
+  if (me->edit_mesh == NULL) {
+    /* Modifiers on the cage can map multiple vertices to the same original vertex. */
+    mesh_foreachScreenVert(vc, func, userData, clip_flag);
+    return;
+  }
+
+  ED_view3d_check_mats_rv3d(vc->rv3d);
+
+  foreachScreenVertParallel_userData data = {
+      .data =
+          {
+              .func = func,
+              .userData = userData,
+              .vc = *vc,
+              .clip_flag = clip_flag,
+          },
+      .vert_coords = me->runtime.edit_data->vertexCos,
+  };
+
+  if (clip_flag & V3D_PROJ_TEST_CLIP_BB) {
+    ED_view3d_clipping_local(vc->rv3d, vc->obedit->obmat); /* for local clipping lookups */
+  }
+
+  BMesh *bm = vc->em->bm;
+  BM_mesh_elem_table_ensure(bm, BM_VERT);
+  data.vtable = bm->vtable;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, bm->totvert, &data, mesh_foreachScreenVert_parallel__fn, &settings);
+}
+
 /* ------------------------------------------------------------------------ */
 
 static void mesh_foreachScreenEdge__mapFunc(void *userData,
@@ -398,6 +474,73 @@ void mesh_foreachScreenFace(
   }
 }
 
+typedef struct foreachScreenFaceParallel_userData {
+  foreachScreenFace_userData data;
+  BMFace **ftable;
+  const float (*face_centers)[3];
+} foreachScreenFaceParallel_userData;
+
+static void mesh_foreachScreenFace_parallel__fn(void *__restrict userdata,
+                                                const int index,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const foreachScreenFaceParallel_userData *data_parallel = userdata;
+  const foreachScreenFace_userData *data = &data_parallel->data;
+  BMFace *efa = data_parallel->ftable[index];
+
+  if (!BM_elem_flag_test(efa, BM_ELEM_HIDDEN)) {
+    float screen_co[2];
+    if (ED_view3d_project_float_object(
+            data->vc.region, data_parallel->face_centers[index], screen_co, data->clip_flag) ==
+        V3D_PROJ_RET_OK) {
+      data->func(data->userData, efa, screen_co, index);
+    }
+  }
+}
+
+/**
+ * Multi-threaded #mesh_foreachScreenFace, \a func must be thread-safe
+ * (it's never called twice for the same face).
+ */
+void mesh_foreachScreenFace_parallel(
+    ViewContext *vc,
+    void (*func)(void *userData, BMFace *efa, const float screen_co_b[2], int index),
+    void *userData,
+    const eV3DProjTest clip_flag)
+{
+  Mesh *me = editbmesh_get_eval_cage_from_orig(
+      vc->depsgraph, vc->scene, vc->obedit, &CD_MASK_BAREMESH);
+
+  if ((me->edit_mesh == NULL) || BKE_modifiers_uses_subsurf_facedots(vc->scene, vc->obedit)) {
+    mesh_foreachScreenFace(vc, func, userData, clip_flag);
+    return;
+  }
+
+  ED_view3d_check_mats_rv3d(vc->rv3d);
+
+  BKE_editmesh_cache_ensure_poly_centers(me->edit_mesh, me->runtime.edit_data);
+
+  foreachScreenFaceParallel_userData data = {
+      .data =
+          {
+              .func = func,
+              .userData = userData,
+              .vc = *vc,
+              .clip_flag = clip_flag,
+          },
+      .face_centers = me->runtime.edit_data->polyCos,
+  };
+
+  BMesh *bm = vc->em->bm;
+  BM_mesh_elem_table_ensure(bm, BM_FACE);
+  data.ftable = bm->ftable;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, bm->totface, &data, mesh_foreachScreenFace_parallel__fn, &settings);
+}
+
 /* ------------------------------------------------------------------------ */
 
 void nurbs_foreachScreenVert(ViewContext *vc,
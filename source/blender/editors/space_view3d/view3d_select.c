@@ -342,6 +342,63 @@ static bool edbm_backbuf_check_and_select_faces(struct EditSelectBuf_Cache *esel
   return changed;
 }
 
+/**
+ * Result of the screen space tests of edit-mesh elements, done from multiple threads
+ * with #mesh_foreachScreenVert_parallel & #mesh_foreachScreenFace_parallel,
+ * elements that aren't tested (hidden or clipped) are left unchanged.
+ */
+enum {
+  EDBM_ELEM_TEST_NONE = 0,
+  EDBM_ELEM_TEST_OUTSIDE = 1,
+  EDBM_ELEM_TEST_INSIDE = 2,
+};
+
+static bool edbm_elem_test_check_and_select_verts(BMEditMesh *em,
+                                                  const char *elem_test,
+                                                  const eSelectOp sel_op)
+{
+  BMVert *eve;
+  BMIter iter;
+  int index;
+  bool changed = false;
+
+  BM_ITER_MESH_INDEX (eve, &iter, em->bm, BM_VERTS_OF_MESH, index) {
+    if (elem_test[index] != EDBM_ELEM_TEST_NONE) {
+      const bool is_select = BM_elem_flag_test(eve, BM_ELEM_SELECT);
+      const bool is_inside = (elem_test[index] == EDBM_ELEM_TEST_INSIDE);
+      const int sel_op_result = ED_select_op_action_deselected(sel_op, is_select, is_inside);
+      if (sel_op_result != -1) {
+        BM_vert_select_set(em->bm, eve, sel_op_result);
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+static bool edbm_elem_test_check_and_select_faces(BMEditMesh *em,
+                                                  const char *elem_test,
+                                                  const eSelectOp sel_op)
+{
+  BMFace *efa;
+  BMIter iter;
+  int index;
+  bool changed = false;
+
+  BM_ITER_MESH_INDEX (efa, &iter, em->bm, BM_FACES_OF_MESH, index) {
+    if (elem_test[index] != EDBM_ELEM_TEST_NONE) {
+      const bool is_select = BM_elem_flag_test(efa, BM_ELEM_SELECT);
+      const bool is_inside = (elem_test[index] == EDBM_ELEM_TEST_INSIDE);
+      const int sel_op_result = ED_select_op_action_deselected(sel_op, is_select, is_inside);
+      if (sel_op_result != -1) {
+        BM_face_select_set(em->bm, efa, sel_op_result);
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
 /* object mode, edbm_ prefix is confusing here, rename? */
 static bool edbm_backbuf_check_and_select_verts_obmode(Mesh *me,
                                                        struct EditSelectBuf_Cache *esel,
@@ -416,6 +473,8 @@ typedef struct LassoSelectUserData {
   int pass;
   bool is_done;
   bool is_changed;
+  /** Per element #EDBM_ELEM_TEST_INSIDE etc, for the threaded edit-mesh tests. */
+  char *elem_test;
 } LassoSelectUserData;
 
 static void view3d_userdata_lassoselect_init(LassoSelectUserData *r_data,
@@ -441,6 +500,7 @@ static void view3d_userdata_lassoselect_init(LassoSelectUserData *r_data,
   r_data->pass = 0;
   r_data->is_done = false;
   r_data->is_changed = false;
+  r_data->elem_test = NULL;
 }
 
 static bool view3d_selectable_data(bContext *C)
@@ -717,22 +777,22 @@ static bool do_lasso_select_pose(ViewContext *vc,
   return changed_multi;
 }
 
-static void do_lasso_select_mesh__doSelectVert(void *userData,
-                                               BMVert *eve,
-                                               const float screen_co[2],
-                                               int UNUSED(index))
+static bool do_lasso_select_mesh__is_point_inside(const LassoSelectUserData *data,
+                                                  const float screen_co[2])
 {
-  LassoSelectUserData *data = userData;
-  const bool is_select = BM_elem_flag_test(eve, BM_ELEM_SELECT);
-  const bool is_inside =
-      (BLI_rctf_isect_pt_v(data->rect_fl, screen_co) &&
-       BLI_lasso_is_point_inside(
-           data->mcoords, data->mcoords_len, screen_co[0], screen_co[1], IS_CLIPPED));
-  const int sel_op_result = ED_select_op_action_deselected(data->sel_op, is_select, is_inside);
-  if (sel_op_result != -1) {
-    BM_vert_select_set(data->vc->em->bm, eve, sel_op_result);
-    data->is_changed = true;
-  }
+  return (BLI_rctf_isect_pt_v(data->rect_fl, screen_co) &&
+          BLI_lasso_is_point_inside(
+              data->mcoords, data->mcoords_len, screen_co[0], screen_co[1], IS_CLIPPED));
+}
+static void do_lasso_select_mesh__testVert(void *userData,
+                                           BMVert *UNUSED(eve),
+                                           const float screen_co[2],
+                                           int index)
+{
+  const LassoSelectUserData *data = userData;
+  data->elem_test[index] = do_lasso_select_mesh__is_point_inside(data, screen_co) ?
+                               EDBM_ELEM_TEST_INSIDE :
+                               EDBM_ELEM_TEST_OUTSIDE;
 }
 struct LassoSelectUserData_ForMeshEdge {
   LassoSelectUserData *data;
@@ -794,22 +854,15 @@ static void do_lasso_select_mesh__doSelectEdge_pass1(void *user_data,
   }
 }
 
-static void do_lasso_select_mesh__doSelectFace(void *userData,
-                                               BMFace *efa,
-                                               const float screen_co[2],
-                                               int UNUSED(index))
+static void do_lasso_select_mesh__testFace(void *userData,
+                                           BMFace *UNUSED(efa),
+                                           const float screen_co[2],
+                                           int index)
 {
-  LassoSelectUserData *data = userData;
-  const bool is_select = BM_elem_flag_test(efa, BM_ELEM_SELECT);
-  const bool is_inside =
-      (BLI_rctf_isect_pt_v(data->rect_fl, screen_co) &&
-       BLI_lasso_is_point_inside(
-           data->mcoords, data->mcoords_len, screen_co[0], screen_co[1], IS_CLIPPED));
-  const int sel_op_result = ED_select_op_action_deselected(data->sel_op, is_select, is_inside);
-  if (sel_op_result != -1) {
-    BM_face_select_set(data->vc->em->bm, efa, sel_op_result);
-    data->is_changed = true;
-  }
+  const LassoSelectUserData *data = userData;
+  data->elem_test[index] = do_lasso_select_mesh__is_point_inside(data, screen_co) ?
+                               EDBM_ELEM_TEST_INSIDE :
+                               EDBM_ELEM_TEST_OUTSIDE;
 }
 
 static bool do_lasso_select_mesh(ViewContext *vc,
@@ -859,8 +912,11 @@ static bool do_lasso_select_mesh(ViewContext *vc,
           esel, vc->depsgraph, vc->obedit, vc->em, sel_op);
     }
     else {
-      mesh_foreachScreenVert(
-          vc, do_lasso_select_mesh__doSelectVert, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.elem_test = MEM_callocN(sizeof(*data.elem_test) * vc->em->bm->totvert, __func__);
+      mesh_foreachScreenVert_parallel(
+          vc, do_lasso_select_mesh__testVert, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.is_changed |= edbm_elem_test_check_and_select_verts(vc->em, data.elem_test, sel_op);
+      MEM_SAFE_FREE(data.elem_test);
     }
   }
   if (ts->selectmode & SCE_SELECT_EDGE) {
@@ -889,8 +945,11 @@ static bool do_lasso_select_mesh(ViewContext *vc,
           esel, vc->depsgraph, vc->obedit, vc->em, sel_op);
     }
     else {
-      mesh_foreachScreenFace(
-          vc, do_lasso_select_mesh__doSelectFace, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.elem_test = MEM_callocN(sizeof(*data.elem_test) * vc->em->bm->totface, __func__);
+      mesh_foreachScreenFace_parallel(
+          vc, do_lasso_select_mesh__testFace, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.is_changed |= edbm_elem_test_check_and_select_faces(vc->em, data.elem_test, sel_op);
+      MEM_SAFE_FREE(data.elem_test);
     }
   }
 
@@ -2572,6 +2631,8 @@ typedef struct BoxSelectUserData {
   /* runtime */
   bool is_done;
   bool is_changed;
+  /** Per element #EDBM_ELEM_TEST_INSIDE etc, for the threaded edit-mesh tests. */
+  char *elem_test;
 } BoxSelectUserData;
 
 static void view3d_userdata_boxselect_init(BoxSelectUserData *r_data,
@@ -2592,6 +2653,7 @@ static void view3d_userdata_boxselect_init(BoxSelectUserData *r_data,
   /* runtime */
   r_data->is_done = false;
   r_data->is_changed = false;
+  r_data->elem_test = NULL;
 }
 
 bool edge_inside_circle(const float cent[2],
@@ -2811,19 +2873,15 @@ static bool do_lattice_box_select(ViewContext *vc, rcti *rect, const eSelectOp s
   return data.is_changed;
 }
 
-static void do_mesh_box_select__doSelectVert(void *userData,
-                                             BMVert *eve,
-                                             const float screen_co[2],
-                                             int UNUSED(index))
+static void do_mesh_box_select__testVert(void *userData,
+                                         BMVert *UNUSED(eve),
+                                         const float screen_co[2],
+                                         int index)
 {
-  BoxSelectUserData *data = userData;
-  const bool is_select = BM_elem_flag_test(eve, BM_ELEM_SELECT);
-  const bool is_inside = BLI_rctf_isect_pt_v(data->rect_fl, screen_co);
-  const int sel_op_result = ED_select_op_action_deselected(data->sel_op, is_select, is_inside);
-  if (sel_op_result != -1) {
-    BM_vert_select_set(data->vc->em->bm, eve, sel_op_result);
-    data->is_changed = true;
-  }
+  const BoxSelectUserData *data = userData;
+  data->elem_test[index] = BLI_rctf_isect_pt_v(data->rect_fl, screen_co) ?
+                               EDBM_ELEM_TEST_INSIDE :
+                               EDBM_ELEM_TEST_OUTSIDE;
 }
 struct BoxSelectUserData_ForMeshEdge {
   BoxSelectUserData *data;
@@ -2870,19 +2928,15 @@ static void do_mesh_box_select__doSelectEdge_pass1(
     data->is_changed = true;
   }
 }
-static void do_mesh_box_select__doSelectFace(void *userData,
-                                             BMFace *efa,
-                                             const float screen_co[2],
-                                             int UNUSED(index))
+static void do_mesh_box_select__testFace(void *userData,
+                                         BMFace *UNUSED(efa),
+                                         const float screen_co[2],
+                                         int index)
 {
-  BoxSelectUserData *data = userData;
-  const bool is_select = BM_elem_flag_test(efa, BM_ELEM_SELECT);
-  const bool is_inside = BLI_rctf_isect_pt_v(data->rect_fl, screen_co);
-  const int sel_op_result = ED_select_op_action_deselected(data->sel_op, is_select, is_inside);
-  if (sel_op_result != -1) {
-    BM_face_select_set(data->vc->em->bm, efa, sel_op_result);
-    data->is_changed = true;
-  }
+  const BoxSelectUserData *data = userData;
+  data->elem_test[index] = BLI_rctf_isect_pt_v(data->rect_fl, screen_co) ?
+                               EDBM_ELEM_TEST_INSIDE :
+                               EDBM_ELEM_TEST_OUTSIDE;
 }
 static bool do_mesh_box_select(ViewContext *vc,
                                wmGenericUserData *wm_userdata,
@@ -2924,8 +2978,11 @@ static bool do_mesh_box_select(ViewContext *vc,
           esel, vc->depsgraph, vc->obedit, vc->em, sel_op);
     }
     else {
-      mesh_foreachScreenVert(
-          vc, do_mesh_box_select__doSelectVert, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.elem_test = MEM_callocN(sizeof(*data.elem_test) * vc->em->bm->totvert, __func__);
+      mesh_foreachScreenVert_parallel(
+          vc, do_mesh_box_select__testVert, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.is_changed |= edbm_elem_test_check_and_select_verts(vc->em, data.elem_test, sel_op);
+      MEM_SAFE_FREE(data.elem_test);
     }
   }
   if (ts->selectmode & SCE_SELECT_EDGE) {
@@ -2954,8 +3011,11 @@ static bool do_mesh_box_select(ViewContext *vc,
           esel, vc->depsgraph, vc->obedit, vc->em, sel_op);
     }
     else {
-      mesh_foreachScreenFace(
-          vc, do_mesh_box_select__doSelectFace, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.elem_test = MEM_callocN(sizeof(*data.elem_test) * vc->em->bm->totface, __func__);
+      mesh_foreachScreenFace_parallel(
+          vc, do_mesh_box_select__testFace, &data, V3D_PROJ_TEST_CLIP_DEFAULT);
+      data.is_changed |= edbm_elem_test_check_and_select_faces(vc->em, data.elem_test, sel_op);
+      MEM_SAFE_FREE(data.elem_test);
     }
   }
 
@@ -439,12 +439,13 @@ static void viewRedrawForce(const bContext *C, TransInfo *t)
       WM_paint_cursor_tag_redraw(window, t->region);
     }
     else {
-      /* Do we need more refined tags? */
+      /* Do we need more refined tags?
+       * #NA_EDITED tells listeners only values change (the outliner doesn't rebuild its tree). */
       if (t->flag & T_POSE) {
-        WM_event_add_notifier(C, NC_OBJECT | ND_POSE, NULL);
+        WM_event_add_notifier(C, NC_OBJECT | ND_POSE | NA_EDITED, NULL);
       }
       else {
-        WM_event_add_notifier(C, NC_OBJECT | ND_TRANSFORM, NULL);
+        WM_event_add_notifier(C, NC_OBJECT | ND_TRANSFORM | NA_EDITED, NULL);
       }
 
       /* For real-time animation record - send notifiers recognized by animation editors */
@@ -27,9 +27,11 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_bitmap.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -775,6 +777,90 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+typedef struct TransEditVertsData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  /** Only used for #TFM_SHRINKFATTEN. */
+  TransDataExtension *data_ext;
+  BMEditMesh *em;
+  const int *td_vert_indices;
+  const struct TransIslandData *island_data;
+  const struct TransMeshDataCrazySpace *crazyspace_data;
+  const float *dists;
+  const int *dists_index;
+  float (*mtx)[3];
+  float (*smtx)[3];
+  int cd_vert_bweight_offset;
+  int prop_mode;
+} TransEditVertsData;
+
+static void trans_edit_verts_create_fn(void *__restrict userdata,
+                                       const int td_index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TransEditVertsData *data = userdata;
+  TransDataContainer *tc = data->tc;
+  const struct TransIslandData *island_data = data->island_data;
+  const struct TransMeshDataCrazySpace *crazyspace_data = data->crazyspace_data;
+  const int prop_mode = data->prop_mode;
+  const int a = data->td_vert_indices[td_index];
+  BMVert *eve = BM_vert_at_index(data->em->bm, a);
+  TransData *tob = &tc->data[td_index];
+  TransDataExtension *tx = data->data_ext ? &data->data_ext[td_index] : NULL;
+
+  int island_index = -1;
+  if (island_data->island_vert_map) {
+    const int connected_index = (data->dists_index && data->dists_index[a] != -1) ?
+                                    data->dists_index[a] :
+                                    a;
+    island_index = island_data->island_vert_map[connected_index];
+  }
+
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                       NULL;
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(data->t, tob, tx, data->em, eve, bweight, island_data, island_index);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (prop_mode) {
+    if (prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  transform_convert_mesh_crazyspace_transdata_set(
+      data->mtx,
+      data->smtx,
+      crazyspace_data->defmats ? crazyspace_data->defmats[a] : NULL,
+      crazyspace_data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ? crazyspace_data->quats[a] :
+                                                                       NULL,
+      tob);
+
+  if (tc->use_mirror_axis_any) {
+    if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
@@ -911,20 +997,23 @@ void createTransEditVerts(TransInfo *t)
       cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
     }
 
-    TransData *tob = tc->data;
+    /* Vertex index of every #TransData, they are filled in parallel below. */
+    int *td_vert_indices = MEM_malloc_arrayN(data_len, sizeof(*td_vert_indices), __func__);
+    int td_index = 0;
+
     TransDataMirror *td_mirror = tc->data_mirror;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
 
-      int island_index = -1;
-      if (island_data.island_vert_map) {
-        const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-        island_index = island_data.island_vert_map[connected_index];
-      }
-
       if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
+        int island_index = -1;
+        if (island_data.island_vert_map) {
+          const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
+          island_index = island_data.island_vert_map[connected_index];
+        }
+
         int elem_index = mirror_data.vert_map[a].index;
         BMVert *v_src = BM_vert_at_index(bm, elem_index);
 
@@ -942,57 +1031,34 @@ void createTransEditVerts(TransInfo *t)
         td_mirror++;
       }
       else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        float *bweight = (cd_vert_bweight_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                             NULL;
-
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, bweight, &island_data, island_index);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        transform_convert_mesh_crazyspace_transdata_set(
-            mtx,
-            smtx,
-            crazyspace_data.defmats ? crazyspace_data.defmats[a] : NULL,
-            crazyspace_data.quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ?
-                crazyspace_data.quats[a] :
-                NULL,
-            tob);
-
-        if (tc->use_mirror_axis_any) {
-          if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
+        td_vert_indices[td_index++] = a;
       }
     }
+    BLI_assert(td_index == data_len);
+
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+
+    TransEditVertsData data = {
+        .t = t,
+        .tc = tc,
+        .data_ext = tx,
+        .em = em,
+        .td_vert_indices = td_vert_indices,
+        .island_data = &island_data,
+        .crazyspace_data = &crazyspace_data,
+        .dists = dists,
+        .dists_index = dists_index,
+        .mtx = mtx,
+        .smtx = smtx,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+        .prop_mode = prop_mode,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, data_len, &data, trans_edit_verts_create_fn, &settings);
+
+    MEM_freeN(td_vert_indices);
 
     transform_convert_mesh_islanddata_free(&island_data);
     transform_convert_mesh_mirrordata_free(&mirror_data);
@@ -1008,6 +1074,58 @@ void createTransEditVerts(TransInfo *t)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Edit Mesh Custom Data
+ *
+ * Data of the mesh conversion stored in #TransDataContainer.custom.type.
+ * \{ */
+
+struct TransCustomDataLayer;
+struct TransMeshPartialUpdate;
+
+struct TransCustomDataMesh {
+  /** Optional, see #mesh_customdatacorrect_init. */
+  struct TransCustomDataLayer *cd_layer_correct;
+  /** Optional, see #mesh_partial_update_ensure. */
+  struct TransMeshPartialUpdate *partial_update;
+};
+
+static void mesh_customdatacorrect_free(struct TransCustomDataLayer *tcld);
+static void mesh_partial_update_free(struct TransMeshPartialUpdate *partial_update);
+
+static void mesh_customdata_free_cb(struct TransInfo *UNUSED(t),
+                                    struct TransDataContainer *UNUSED(tc),
+                                    struct TransCustomData *custom_data)
+{
+  struct TransCustomDataMesh *tcmd = custom_data->data;
+  if (tcmd->cd_layer_correct) {
+    mesh_customdatacorrect_free(tcmd->cd_layer_correct);
+  }
+  if (tcmd->partial_update) {
+    mesh_partial_update_free(tcmd->partial_update);
+  }
+  MEM_freeN(tcmd);
+  custom_data->data = NULL;
+}
+
+static struct TransCustomDataMesh *mesh_customdata_ensure(TransDataContainer *tc)
+{
+  BLI_assert(tc->custom.type.data == NULL || tc->custom.type.free_cb == mesh_customdata_free_cb);
+  if (tc->custom.type.data == NULL) {
+    tc->custom.type.data = MEM_callocN(sizeof(struct TransCustomDataMesh), __func__);
+    tc->custom.type.free_cb = mesh_customdata_free_cb;
+  }
+  return tc->custom.type.data;
+}
+
+static struct TransCustomDataLayer *mesh_customdatacorrect_get(TransDataContainer *tc)
+{
+  struct TransCustomDataMesh *tcmd = tc->custom.type.data;
+  return tcmd ? tcmd->cd_layer_correct : NULL;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name CustomData Layer Correction
  *
@@ -1044,11 +1162,8 @@ struct TransCustomDataLayer {
   bool use_merge_group;
 };
 
-static void mesh_customdatacorrect_free_cb(struct TransInfo *UNUSED(t),
-                                           struct TransDataContainer *UNUSED(tc),
-                                           struct TransCustomData *custom_data)
+static void mesh_customdatacorrect_free(struct TransCustomDataLayer *tcld)
 {
-  struct TransCustomDataLayer *tcld = custom_data->data;
   bmesh_edit_end(tcld->bm, BMO_OPTYPE_FLAG_UNTAN_MULTIRES);
 
   if (tcld->bm_origfaces) {
@@ -1068,7 +1183,6 @@ static void mesh_customdatacorrect_free_cb(struct TransInfo *UNUSED(t),
   }
 
   MEM_freeN(tcld);
-  custom_data->data = NULL;
 }
 
 #ifdef USE_FACE_SUBSTITUTE
@@ -1256,10 +1370,12 @@ static void mesh_customdatacorrect_init_container_merge_group(TransDataContainer
 static void mesh_customdatacorrect_init_container(TransDataContainer *tc,
                                                   const bool use_merge_group)
 {
-  if (tc->custom.type.data) {
+  struct TransCustomDataMesh *tcmd = tc->custom.type.data;
+  if (tcmd && tcmd->cd_layer_correct) {
     /* The custom-data correction has been initiated before.
      * Free since some modes have different settings. */
-    mesh_customdatacorrect_free_cb(NULL, tc, &tc->custom.type);
+    mesh_customdatacorrect_free(tcmd->cd_layer_correct);
+    tcmd->cd_layer_correct = NULL;
   }
 
   BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
@@ -1305,8 +1421,7 @@ static void mesh_customdatacorrect_init_container(TransDataContainer *tc,
     }
   }
 
-  tc->custom.type.data = tcld;
-  tc->custom.type.free_cb = mesh_customdatacorrect_free_cb;
+  mesh_customdata_ensure(tc)->cd_layer_correct = tcld;
 }
 
 void mesh_customdatacorrect_init(TransInfo *t)
@@ -1500,10 +1615,10 @@ static void mesh_customdatacorrect_apply_vert(struct TransCustomDataLayer *tcld,
 static void mesh_customdatacorrect_apply(TransInfo *t, bool is_final)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    if (!tc->custom.type.data) {
+    struct TransCustomDataLayer *tcld = mesh_customdatacorrect_get(tc);
+    if (!tcld) {
       continue;
     }
-    struct TransCustomDataLayer *tcld = tc->custom.type.data;
     const bool use_merge_group = tcld->use_merge_group;
 
     struct TransCustomDataMergeGroup *merge_data = tcld->merge_group.data;
@@ -1530,7 +1645,7 @@ static void mesh_customdatacorrect_apply(TransInfo *t, bool is_final)
 static void mesh_customdatacorrect_restore(struct TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    struct TransCustomDataLayer *tcld = tc->custom.type.data;
+    struct TransCustomDataLayer *tcld = mesh_customdatacorrect_get(tc);
     if (!tcld) {
       continue;
     }
@@ -1558,6 +1673,154 @@ static void mesh_customdatacorrect_restore(struct TransInfo *t)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Partial Normals Update
+ *
+ * Only update the normals of the faces around the moving vertices.
+ * \{ */
+
+struct TransMeshPartialUpdate {
+  BMFace **faces;
+  int faces_len;
+  /** The vertices of #faces. */
+  BMVert **verts;
+  int verts_len;
+  /**
+   * Proportional size the moving vertices were gathered for. Vertices outside of a smaller size
+   * are restored to their original location, which changes their normals too, so the data is
+   * only gathered again when the size grows.
+   */
+  float prop_size;
+};
+
+static void mesh_partial_update_free(struct TransMeshPartialUpdate *partial_update)
+{
+  MEM_SAFE_FREE(partial_update->faces);
+  MEM_SAFE_FREE(partial_update->verts);
+  MEM_freeN(partial_update);
+}
+
+static void mesh_partial_update_vert_add(BMVert *v,
+                                         struct TransMeshPartialUpdate *partial_update,
+                                         BLI_bitmap *faces_tag,
+                                         BLI_bitmap *verts_tag)
+{
+  BMIter iter;
+  BMFace *f;
+  BM_ITER_ELEM (f, &iter, v, BM_FACES_OF_VERT) {
+    const int f_index = BM_elem_index_get(f);
+    if (BLI_BITMAP_TEST(faces_tag, f_index)) {
+      continue;
+    }
+    BLI_BITMAP_ENABLE(faces_tag, f_index);
+    partial_update->faces[partial_update->faces_len++] = f;
+
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      const int v_index = BM_elem_index_get(l_iter->v);
+      if (!BLI_BITMAP_TEST(verts_tag, v_index)) {
+        BLI_BITMAP_ENABLE(verts_tag, v_index);
+        partial_update->verts[partial_update->verts_len++] = l_iter->v;
+      }
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+}
+
+/**
+ * Return the faces and vertices of which the normals change when transforming, or NULL when most
+ * of the mesh moves and updating all normals is faster.
+ */
+static struct TransMeshPartialUpdate *mesh_partial_update_ensure(TransInfo *t,
+                                                                 TransDataContainer *tc,
+                                                                 BMesh *bm)
+{
+  /* Without proportional editing all vertices move, see #calculatePropRatio. */
+  const float prop_size = (t->flag & T_PROP_EDIT) ? t->prop_size : FLT_MAX;
+
+  struct TransCustomDataMesh *tcmd = mesh_customdata_ensure(tc);
+  struct TransMeshPartialUpdate *partial_update = tcmd->partial_update;
+  if (partial_update != NULL) {
+    if (prop_size <= partial_update->prop_size) {
+      return partial_update->faces ? partial_update : NULL;
+    }
+    mesh_partial_update_free(partial_update);
+  }
+
+  partial_update = MEM_callocN(sizeof(*partial_update), __func__);
+  partial_update->prop_size = prop_size;
+  tcmd->partial_update = partial_update;
+
+  /* Count the faces around the moving vertices, updating all normals is faster when these are
+   * a large part of the mesh. */
+  int faces_len_max = 0;
+  TransData *td = tc->data;
+  for (int i = 0; i < tc->data_len; i++, td++) {
+    if ((td->flag & TD_SELECTED) || td->factor != 0.0f) {
+      faces_len_max += BM_vert_face_count((BMVert *)td->extra);
+    }
+  }
+  TransDataMirror *td_mirror = tc->data_mirror;
+  for (int i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
+    faces_len_max += BM_vert_face_count((BMVert *)td_mirror->extra);
+  }
+  if (faces_len_max >= bm->totface / 2) {
+    return NULL;
+  }
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_FACE);
+  BLI_bitmap *faces_tag = BLI_BITMAP_NEW(bm->totface, __func__);
+  BLI_bitmap *verts_tag = BLI_BITMAP_NEW(bm->totvert, __func__);
+  partial_update->faces = MEM_malloc_arrayN(
+      max_ii(faces_len_max, 1), sizeof(*partial_update->faces), __func__);
+  partial_update->verts = MEM_malloc_arrayN(bm->totvert, sizeof(*partial_update->verts), __func__);
+
+  td = tc->data;
+  for (int i = 0; i < tc->data_len; i++, td++) {
+    if ((td->flag & TD_SELECTED) || td->factor != 0.0f) {
+      mesh_partial_update_vert_add(td->extra, partial_update, faces_tag, verts_tag);
+    }
+  }
+  td_mirror = tc->data_mirror;
+  for (int i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
+    mesh_partial_update_vert_add(td_mirror->extra, partial_update, faces_tag, verts_tag);
+  }
+
+  MEM_freeN(faces_tag);
+  MEM_freeN(verts_tag);
+
+  return partial_update;
+}
+
+static void mesh_partial_update_faces_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct TransMeshPartialUpdate *partial_update = userdata;
+  BM_face_normal_update(partial_update->faces[i]);
+}
+
+static void mesh_partial_update_verts_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct TransMeshPartialUpdate *partial_update = userdata;
+  BM_vert_normal_update(partial_update->verts[i]);
+}
+
+static void mesh_partial_update_normals(struct TransMeshPartialUpdate *partial_update)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, partial_update->faces_len, partial_update, mesh_partial_update_faces_fn, &settings);
+  BLI_task_parallel_range(
+      0, partial_update->verts_len, partial_update, mesh_partial_update_verts_fn, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Recalc Mesh Data
  *
@@ -1620,9 +1883,21 @@ void recalcData_mesh(TransInfo *t)
   }
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
-    EDBM_mesh_normals_update(em);
+    /* Face attributes are modified when correcting custom-data, otherwise only coordinates. */
+    em->is_deform_only_update = (mesh_customdatacorrect_get(tc) == NULL);
+    DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
+
+    struct TransMeshPartialUpdate *partial_update = NULL;
+    if (t->data_type == TC_MESH_VERTS) {
+      partial_update = mesh_partial_update_ensure(t, tc, em->bm);
+    }
+    if (partial_update) {
+      mesh_partial_update_normals(partial_update);
+    }
+    else {
+      EDBM_mesh_normals_update(em);
+    }
     BKE_editmesh_looptri_calc(em);
   }
 }
@@ -1637,6 +1912,11 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
   const bool is_canceling = (t->state == TRANS_CANCEL);
   const bool use_automerge = !is_canceling && (t->flag & (T_AUTOMERGE | T_AUTOSPLIT)) != 0;
 
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+    em->is_deform_only_update = false;
+  }
+
   if (!is_canceling && ELEM(t->mode, TFM_EDGE_SLIDE, TFM_VERT_SLIDE)) {
     /* NOTE(joeedh): Handle multi-res re-projection,
      * done on transform completion since it's really slow. */
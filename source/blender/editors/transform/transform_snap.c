@@ -630,8 +630,14 @@ static void initSnappingMode(TransInfo *t)
   if (t->spacetype == SPACE_VIEW3D) {
     if (t->tsnap.object_context == NULL) {
       t->tsnap.use_backface_culling = snap_use_backface_culling(t);
+      /* Only objects that depend on the transformed objects change in object mode,
+       * these are excluded from snapping (unless they're locked in place). */
+      const int snap_context_flag = ((t->data_type == TC_OBJECT) &&
+                                     (t->options & CTX_OBMODE_XFORM_OBDATA) == 0) ?
+                                        SNAP_OBJECT_USE_BOUNDS_TREE :
+                                        0;
       t->tsnap.object_context = ED_transform_snap_object_context_create_view3d(
-          t->scene, 0, t->region, t->view);
+          t->scene, snap_context_flag, t->region, t->view);
 
       if (t->data_type == TC_MESH_VERTS) {
         /* Ignore elements being transformed. */
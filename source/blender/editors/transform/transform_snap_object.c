@@ -22,6 +22,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_ghash.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_listbase.h"
@@ -127,6 +128,21 @@ struct SnapObjectContext {
     MemArena *mem_arena;
   } cache;
 
+  /* Bounds of the objects that don't change while snapping,
+   * see #SNAP_OBJECT_USE_BOUNDS_TREE. */
+  struct {
+    /** The view-layer the bases were gathered from. */
+    const struct ViewLayer *view_layer;
+    /** All bases of the view-layer in order. */
+    struct SnapObjectBase *bases;
+    int bases_len;
+    /** World space bounds of the static objects, NULL when there are too few of them. */
+    BVHTree *tree;
+    /** One bit per tree leaf, set for the leaves near the current query. */
+    BLI_bitmap *leaves_tag;
+    int leaves_len;
+  } bounds;
+
   /* Filter data, returns true to check this value */
   struct {
     struct {
@@ -362,6 +378,172 @@ static SnapObjectData *snap_object_data_editmesh_get(SnapObjectContext *sctx,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Object Bounds Tree
+ *
+ * Large scenes spend most of the snapping time testing the bounds of objects far away
+ * from the ray or the cursor. Objects that don't change while snapping are added to a tree
+ * once, so each query only visits the objects whose bounds pass the query test.
+ * \{ */
+
+/* Below this number of static objects, testing every object is fast enough. */
+#define SNAP_OBJECT_BOUNDS_TREE_MIN 64
+
+struct SnapObjectBase {
+  Base *base;
+  /** Leaf of the bounds tree, -1 when the object is tested on every query. */
+  int leaf_index;
+};
+
+/**
+ * Objects that are transformed, depend on the transformed data or have data that can change
+ * (edit-mode, instancing) are tested on every query.
+ */
+static bool snap_object_base_is_static(const Base *base, const Object *obj_eval)
+{
+  if (base->flag & BASE_SELECTED) {
+    return false;
+  }
+  if (base->flag_legacy & (BA_WAS_SEL | BA_SNAP_FIX_DEPS_FIASCO | BA_TRANSFORM_LOCKED_IN_PLACE |
+                           BA_TRANSFORM_CHILD | BA_TRANSFORM_PARENT)) {
+    return false;
+  }
+  if (obj_eval->type != OB_MESH) {
+    return false;
+  }
+  if ((obj_eval->transflag & OB_DUPLI) || BKE_object_is_in_editmode(obj_eval)) {
+    return false;
+  }
+  return true;
+}
+
+static void snap_object_bounds_free(SnapObjectContext *sctx)
+{
+  MEM_SAFE_FREE(sctx->bounds.bases);
+  MEM_SAFE_FREE(sctx->bounds.leaves_tag);
+  if (sctx->bounds.tree) {
+    BLI_bvhtree_free(sctx->bounds.tree);
+  }
+  memset(&sctx->bounds, 0x0, sizeof(sctx->bounds));
+}
+
+static void snap_object_bounds_init(SnapObjectContext *sctx, Depsgraph *depsgraph)
+{
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  const int bases_len = BLI_listbase_count(&view_layer->object_bases);
+
+  snap_object_bounds_free(sctx);
+  sctx->bounds.view_layer = view_layer;
+  sctx->bounds.bases = MEM_mallocN(sizeof(*sctx->bounds.bases) * (size_t)max_ii(bases_len, 1),
+                                   __func__);
+  sctx->bounds.bases_len = bases_len;
+
+  float(*leaves_co)[8][3] = MEM_mallocN(sizeof(*leaves_co) * (size_t)max_ii(bases_len, 1),
+                                        __func__);
+  int leaves_len = 0;
+
+  int i = 0;
+  LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+    struct SnapObjectBase *sob = &sctx->bounds.bases[i++];
+    sob->base = base;
+    sob->leaf_index = -1;
+
+    Object *obj_eval = DEG_get_evaluated_object(depsgraph, base->object);
+    if (!snap_object_base_is_static(base, obj_eval)) {
+      continue;
+    }
+    const BoundBox *bb = BKE_mesh_boundbox_get(obj_eval);
+    if (bb == NULL) {
+      continue;
+    }
+    for (int j = 0; j < 8; j++) {
+      mul_v3_m4v3(leaves_co[leaves_len][j], obj_eval->obmat, bb->vec[j]);
+    }
+    sob->leaf_index = leaves_len++;
+  }
+
+  if (leaves_len >= SNAP_OBJECT_BOUNDS_TREE_MIN) {
+    sctx->bounds.tree = BLI_bvhtree_new(leaves_len, 0.0f, 4, 6);
+    for (int leaf = 0; leaf < leaves_len; leaf++) {
+      BLI_bvhtree_insert(sctx->bounds.tree, leaf, &leaves_co[leaf][0][0], 8);
+    }
+    BLI_bvhtree_balance(sctx->bounds.tree);
+    sctx->bounds.leaves_tag = BLI_BITMAP_NEW(leaves_len, __func__);
+    sctx->bounds.leaves_len = leaves_len;
+  }
+
+  MEM_freeN(leaves_co);
+}
+
+typedef bool (*SnapObjectBoundsTestFn)(const float min[3], const float max[3], void *test_data);
+
+struct SnapObjectBoundsWalkData {
+  SnapObjectBoundsTestFn test_fn;
+  void *test_data;
+  BLI_bitmap *leaves_tag;
+};
+
+static bool snap_object_bounds_walk_parent_cb(const BVHTreeAxisRange *bounds, void *userdata)
+{
+  struct SnapObjectBoundsWalkData *data = userdata;
+  const float min[3] = {bounds[0].min, bounds[1].min, bounds[2].min};
+  const float max[3] = {bounds[0].max, bounds[1].max, bounds[2].max};
+  return data->test_fn(min, max, data->test_data);
+}
+
+static bool snap_object_bounds_walk_leaf_cb(const BVHTreeAxisRange *UNUSED(bounds),
+                                            int index,
+                                            void *userdata)
+{
+  /* Leaves are only reached when they passed #snap_object_bounds_walk_parent_cb. */
+  struct SnapObjectBoundsWalkData *data = userdata;
+  BLI_BITMAP_ENABLE(data->leaves_tag, index);
+  return true;
+}
+
+static bool snap_object_bounds_walk_order_cb(const BVHTreeAxisRange *UNUSED(bounds),
+                                             char UNUSED(axis),
+                                             void *UNUSED(userdata))
+{
+  return true;
+}
+
+/**
+ * Tag the leaves of the tree whose bounds pass \a test_fn.
+ *
+ * \return The tagged leaves or NULL when there is no tree and every object must be tested.
+ */
+static const BLI_bitmap *snap_object_bounds_query(SnapObjectContext *sctx,
+                                                  Depsgraph *depsgraph,
+                                                  SnapObjectBoundsTestFn test_fn,
+                                                  void *test_data)
+{
+  if ((sctx->flag & SNAP_OBJECT_USE_BOUNDS_TREE) == 0) {
+    return NULL;
+  }
+  if (sctx->bounds.view_layer != DEG_get_input_view_layer(depsgraph)) {
+    snap_object_bounds_init(sctx, depsgraph);
+  }
+  if (sctx->bounds.tree == NULL) {
+    return NULL;
+  }
+
+  struct SnapObjectBoundsWalkData data = {
+      .test_fn = test_fn,
+      .test_data = test_data,
+      .leaves_tag = sctx->bounds.leaves_tag,
+  };
+  BLI_bitmap_set_all(data.leaves_tag, false, (size_t)sctx->bounds.leaves_len);
+  BLI_bvhtree_walk_dfs(sctx->bounds.tree,
+                       snap_object_bounds_walk_parent_cb,
+                       snap_object_bounds_walk_leaf_cb,
+                       snap_object_bounds_walk_order_cb,
+                       &data);
+  return data.leaves_tag;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Iterator
  * \{ */
@@ -374,69 +556,102 @@ typedef void (*IterSnapObjsCallback)(SnapObjectContext *sctx,
                                      bool is_object_active,
                                      void *data);
 
+static void iter_snap_objects_base(SnapObjectContext *sctx,
+                                   Depsgraph *depsgraph,
+                                   const struct SnapObjectParams *params,
+                                   Base *base,
+                                   const Base *base_act,
+                                   IterSnapObjsCallback sob_callback,
+                                   void *data)
+{
+  const View3D *v3d = sctx->v3d_data.v3d;
+  const eSnapSelect snap_select = params->snap_select;
+  const bool use_object_edit_cage = params->use_object_edit_cage;
+  const bool use_backface_culling = params->use_backface_culling;
+
+  if (!BASE_VISIBLE(v3d, base)) {
+    return;
+  }
+
+  if (base->flag_legacy & BA_TRANSFORM_LOCKED_IN_PLACE) {
+    /* pass */
+  }
+  else if (base->flag_legacy & BA_SNAP_FIX_DEPS_FIASCO) {
+    return;
+  }
+
+  const bool is_object_active = (base == base_act);
+  if (snap_select == SNAP_NOT_SELECTED) {
+    if ((base->flag & BASE_SELECTED) || (base->flag_legacy & BA_WAS_SEL)) {
+      return;
+    }
+  }
+  else if (snap_select == SNAP_NOT_ACTIVE) {
+    if (is_object_active) {
+      return;
+    }
+  }
+
+  Object *obj_eval = DEG_get_evaluated_object(depsgraph, base->object);
+  if (obj_eval->transflag & OB_DUPLI) {
+    DupliObject *dupli_ob;
+    ListBase *lb = object_duplilist(depsgraph, sctx->scene, obj_eval);
+    for (dupli_ob = lb->first; dupli_ob; dupli_ob = dupli_ob->next) {
+      sob_callback(sctx,
+                   dupli_ob->ob,
+                   dupli_ob->mat,
+                   use_object_edit_cage,
+                   use_backface_culling,
+                   is_object_active,
+                   data);
+    }
+    free_object_duplilist(lb);
+  }
+
+  sob_callback(sctx,
+               obj_eval,
+               obj_eval->obmat,
+               use_object_edit_cage,
+               use_backface_culling,
+               is_object_active,
+               data);
+}
+
 /**
  * Walks through all objects in the scene to create the list of objects to snap.
+ *
+ * \param bounds_test_fn: Optionally skip the objects of the bounds tree
+ * whose world space bounds fail this test.
  */
 static void iter_snap_objects(SnapObjectContext *sctx,
                               Depsgraph *depsgraph,
                               const struct SnapObjectParams *params,
+                              SnapObjectBoundsTestFn bounds_test_fn,
+                              void *bounds_test_data,
                               IterSnapObjsCallback sob_callback,
                               void *data)
 {
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  const View3D *v3d = sctx->v3d_data.v3d;
-  const eSnapSelect snap_select = params->snap_select;
-  const bool use_object_edit_cage = params->use_object_edit_cage;
-  const bool use_backface_culling = params->use_backface_culling;
-
-  Base *base_act = view_layer->basact;
-  for (Base *base = view_layer->object_bases.first; base != NULL; base = base->next) {
-    if (!BASE_VISIBLE(v3d, base)) {
-      continue;
-    }
+  const Base *base_act = view_layer->basact;
 
-    if (base->flag_legacy & BA_TRANSFORM_LOCKED_IN_PLACE) {
-      /* pass */
-    }
-    else if (base->flag_legacy & BA_SNAP_FIX_DEPS_FIASCO) {
-      continue;
-    }
+  const BLI_bitmap *leaves_tag = NULL;
+  if (bounds_test_fn != NULL) {
+    leaves_tag = snap_object_bounds_query(sctx, depsgraph, bounds_test_fn, bounds_test_data);
+  }
 
-    const bool is_object_active = (base == base_act);
-    if (snap_select == SNAP_NOT_SELECTED) {
-      if ((base->flag & BASE_SELECTED) || (base->flag_legacy & BA_WAS_SEL)) {
-        continue;
-      }
-    }
-    else if (snap_select == SNAP_NOT_ACTIVE) {
-      if (is_object_active) {
-        continue;
-      }
+  if (leaves_tag == NULL) {
+    LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+      iter_snap_objects_base(sctx, depsgraph, params, base, base_act, sob_callback, data);
     }
+    return;
+  }
 
-    Object *obj_eval = DEG_get_evaluated_object(depsgraph, base->object);
-    if (obj_eval->transflag & OB_DUPLI) {
-      DupliObject *dupli_ob;
-      ListBase *lb = object_duplilist(depsgraph, sctx->scene, obj_eval);
-      for (dupli_ob = lb->first; dupli_ob; dupli_ob = dupli_ob->next) {
-        sob_callback(sctx,
-                     dupli_ob->ob,
-                     dupli_ob->mat,
-                     use_object_edit_cage,
-                     use_backface_culling,
-                     is_object_active,
-                     data);
-      }
-      free_object_duplilist(lb);
+  for (int i = 0; i < sctx->bounds.bases_len; i++) {
+    const struct SnapObjectBase *sob = &sctx->bounds.bases[i];
+    if ((sob->leaf_index != -1) && !BLI_BITMAP_TEST(leaves_tag, sob->leaf_index)) {
+      continue;
     }
-
-    sob_callback(sctx,
-                 obj_eval,
-                 obj_eval->obmat,
-                 use_object_edit_cage,
-                 use_backface_culling,
-                 is_object_active,
-                 data);
+    iter_snap_objects_base(sctx, depsgraph, params, sob->base, base_act, sob_callback, data);
   }
 }
 
@@ -1074,6 +1289,17 @@ static void raycast_obj_fn(SnapObjectContext *sctx,
   }
 }
 
+struct SnapObjectBoundsRayData {
+  const float *ray_start;
+  const float *ray_dir;
+};
+
+static bool snap_object_bounds_ray_test(const float min[3], const float max[3], void *test_data)
+{
+  const struct SnapObjectBoundsRayData *data = test_data;
+  return isect_ray_aabb_v3_simple(data->ray_start, data->ray_dir, min, max, NULL, NULL);
+}
+
 /**
  * Main RayCast Function
  * ======================
@@ -1132,7 +1358,18 @@ static bool raycastObjects(SnapObjectContext *sctx,
       .ret = false,
   };
 
-  iter_snap_objects(sctx, depsgraph, params, raycast_obj_fn, &data);
+  struct SnapObjectBoundsRayData bounds_data = {
+      .ray_start = ray_start,
+      .ray_dir = ray_dir,
+  };
+
+  iter_snap_objects(sctx,
+                    depsgraph,
+                    params,
+                    snap_object_bounds_ray_test,
+                    &bounds_data,
+                    raycast_obj_fn,
+                    &data);
 
   return data.ret;
 }
@@ -2761,6 +2998,20 @@ static void snap_obj_fn(SnapObjectContext *sctx,
   }
 }
 
+struct SnapObjectBoundsProjectedData {
+  struct DistProjectedAABBPrecalc precalc;
+  float dist_px_sq;
+};
+
+static bool snap_object_bounds_projected_test(const float min[3],
+                                              const float max[3],
+                                              void *test_data)
+{
+  struct SnapObjectBoundsProjectedData *data = test_data;
+  bool dummy[3];
+  return dist_squared_to_projected_aabb(&data->precalc, min, max, dummy) <= data->dist_px_sq;
+}
+
 /**
  * Main Snapping Function
  * ======================
@@ -2812,7 +3063,19 @@ static short snapObjectsRay(SnapObjectContext *sctx,
       .ret = 0,
   };
 
-  iter_snap_objects(sctx, depsgraph, params, snap_obj_fn, &data);
+  /* The distance only shrinks while snapping, so objects further away can be skipped. */
+  struct SnapObjectBoundsProjectedData bounds_data;
+  dist_squared_to_projected_aabb_precalc(
+      &bounds_data.precalc, snapdata->pmat, snapdata->win_size, snapdata->mval);
+  bounds_data.dist_px_sq = square_f(*dist_px);
+
+  iter_snap_objects(sctx,
+                    depsgraph,
+                    params,
+                    snap_object_bounds_projected_test,
+                    &bounds_data,
+                    snap_obj_fn,
+                    &data);
 
   return data.ret;
 }
@@ -2867,6 +3130,7 @@ void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx)
     BLI_ghash_free(sctx->cache.data_to_object_map, NULL, NULL);
   }
   BLI_memarena_free(sctx->cache.mem_arena);
+  snap_object_bounds_free(sctx);
 
   MEM_freeN(sctx);
 }
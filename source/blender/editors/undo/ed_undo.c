@@ -31,6 +31,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_string.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -784,6 +785,7 @@ static int undo_history_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSE
     const EnumPropertyItem *item = rna_undo_itemf(C, &totitem);
 
     if (totitem > 0) {
+      wmWindowManager *wm = CTX_wm_manager(C);
       uiPopupMenu *pup = UI_popup_menu_begin(
           C, WM_operatortype_name(op->type, op->ptr), ICON_NONE);
       uiLayout *layout = UI_popup_menu_layout(pup);
@@ -799,7 +801,19 @@ static int undo_history_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSE
           add_col = false;
         }
         if (item[i].identifier) {
-          uiItemIntO(column, item[i].name, item[i].icon, op->type->idname, "item", item[i].value);
+          /* Show the memory used by each step, steps sharing their data with others only count
+           * what they added. */
+          const UndoStep *us = BLI_findlink(&wm->undo_stack->steps, item[i].value);
+          char name[UI_MAX_NAME_STR];
+          if (us && us->data_size) {
+            char size_str[15];
+            BLI_str_format_byte_unit(size_str, (long long int)us->data_size, false);
+            BLI_snprintf(name, sizeof(name), "%s (%s)", item[i].name, size_str);
+          }
+          else {
+            BLI_strncpy(name, item[i].name, sizeof(name));
+          }
+          uiItemIntO(column, name, item[i].icon, op->type->idname, "item", item[i].value);
           c++;
           add_col = true;
         }
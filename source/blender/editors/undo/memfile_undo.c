@@ -26,6 +26,8 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 
+#include "CLG_log.h"
+
 #include "DNA_ID.h"
 #include "DNA_collection_types.h"
 #include "DNA_node_types.h"
@@ -42,6 +44,8 @@
 #include "BKE_scene.h"
 #include "BKE_undo_system.h"
 
+#include "PIL_time.h"
+
 #include "../depsgraph/DEG_depsgraph.h"
 
 #include "WM_api.h"
@@ -57,6 +61,8 @@
 
 #include <stdio.h>
 
+static CLG_LogRef LOG = {"ed.undo.memfile"};
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -182,6 +188,8 @@ static void memfile_undosys_step_decode(struct bContext *C,
     }
   }
 
+  const double time_start = PIL_check_seconds_timer();
+
   /* Extract depsgraphs from current bmain (which may be freed during undo step reading),
    * and store them for re-use. */
   GHash *depsgraphs = NULL;
@@ -191,9 +199,13 @@ static void memfile_undosys_step_decode(struct bContext *C,
 
   ED_editors_exit(bmain, false);
 
+  const double time_read_start = PIL_check_seconds_timer();
+
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
+  const double time_read_end = PIL_check_seconds_timer();
+
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
       continue;
@@ -211,6 +223,8 @@ static void memfile_undosys_step_decode(struct bContext *C,
   bmain = CTX_data_main(C);
   ED_editors_init_for_undo(bmain);
 
+  int ids_len = 0, ids_reused_len = 0;
+
   if (use_old_bmain_data) {
     /* Restore previous depsgraphs into current bmain. */
     BKE_scene_undo_depsgraphs_restore(bmain, depsgraphs);
@@ -219,7 +233,9 @@ static void memfile_undosys_step_decode(struct bContext *C,
      * data-blocks, at least COW evaluated copies need to be updated... */
     ID *id = NULL;
     FOREACH_MAIN_ID_BEGIN (bmain, id) {
+      ids_len++;
       if (id->tag & LIB_TAG_UNDO_OLD_ID_REUSED) {
+        ids_reused_len++;
         BKE_library_foreach_ID_link(
             bmain, id, memfile_undosys_step_id_reused_cb, NULL, IDWALK_READONLY);
       }
@@ -255,6 +271,21 @@ static void memfile_undosys_step_decode(struct bContext *C,
   }
 
   WM_event_add_notifier(C, NC_SCENE | ND_LAYER_CONTENT, CTX_data_scene(C));
+
+  if (CLOG_CHECK(&LOG, 1)) {
+    const double time_end = PIL_check_seconds_timer();
+    CLOG_INFO(&LOG,
+              1,
+              "'%s' decoded in %.3fs (prepare %.3fs, read %.3fs, restore %.3fs), "
+              "%d of %d data-blocks re-used",
+              us_p->name,
+              time_end - time_start,
+              time_read_start - time_start,
+              time_read_end - time_read_start,
+              time_end - time_read_end,
+              ids_reused_len,
+              ids_len);
+  }
 }
 
 static void memfile_undosys_step_free(UndoStep *us_p)
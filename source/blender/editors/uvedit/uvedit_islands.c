@@ -35,6 +35,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "BKE_editmesh.h"
 
@@ -355,6 +356,35 @@ static int bm_mesh_calc_uv_islands(const Scene *scene,
  * \note This behavior follows #param_pack.
  * \{ */
 
+struct PackIslandsApplyData {
+  struct FaceIsland **island_array;
+  const BoxPack *boxarray;
+  float scale[2];
+};
+
+/* Islands don't share faces, so their loops can be transformed in parallel. */
+static void pack_islands_apply_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct PackIslandsApplyData *data = userdata;
+  const BoxPack *box = &data->boxarray[i];
+  struct FaceIsland *island = data->island_array[box->index];
+  const float pivot[2] = {
+      island->bounds_rect.xmin,
+      island->bounds_rect.ymin,
+  };
+  const float offset[2] = {
+      (box->x * data->scale[0]) - island->bounds_rect.xmin,
+      (box->y * data->scale[1]) - island->bounds_rect.ymin,
+  };
+  for (int j = 0; j < island->faces_len; j++) {
+    BMFace *efa = island->faces[j];
+    bm_face_uv_translate_and_scale_around_pivot(
+        efa, offset, data->scale, pivot, island->cd_loop_uv_offset);
+  }
+}
+
 void ED_uvedit_pack_islands_multi(const Scene *scene,
                                   Object **objects,
                                   const uint objects_len,
@@ -461,24 +491,15 @@ void ED_uvedit_pack_islands_multi(const Scene *scene,
   /* Don't change the aspect when scaling. */
   boxarray_size[0] = boxarray_size[1] = max_ff(boxarray_size[0], boxarray_size[1]);
 
-  const float scale[2] = {1.0f / boxarray_size[0], 1.0f / boxarray_size[1]};
-
-  for (int i = 0; i < island_list_len; i++) {
-    struct FaceIsland *island = island_array[boxarray[i].index];
-    const float pivot[2] = {
-        island->bounds_rect.xmin,
-        island->bounds_rect.ymin,
-    };
-    const float offset[2] = {
-        (boxarray[i].x * scale[0]) - island->bounds_rect.xmin,
-        (boxarray[i].y * scale[1]) - island->bounds_rect.ymin,
-    };
-    for (int j = 0; j < island->faces_len; j++) {
-      BMFace *efa = island->faces[j];
-      bm_face_uv_translate_and_scale_around_pivot(
-          efa, offset, scale, pivot, island->cd_loop_uv_offset);
-    }
-  }
+  struct PackIslandsApplyData data = {
+      .island_array = island_array,
+      .boxarray = boxarray,
+      .scale = {1.0f / boxarray_size[0], 1.0f / boxarray_size[1]},
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, island_list_len, &data, pack_islands_apply_cb, &settings);
 
   for (uint ob_index = 0; ob_index < objects_len; ob_index++) {
     Object *obedit = objects[ob_index];
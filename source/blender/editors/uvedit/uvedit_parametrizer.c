@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -177,6 +178,8 @@ typedef struct PChart {
       PVert *single_pin;
       float single_pin_area;
       float single_pin_uv[2];
+      /** The matrix was factorized by a previous solve and is reused, only pins changed. */
+      bool matrix_factorized;
     } lscm;
     struct PChartPack {
       float rescale, area;
@@ -3177,6 +3180,8 @@ static void p_chart_lscm_begin(PChart *chart, PBool live, PBool abf)
     }
   }
 
+  chart->u.lscm.matrix_factorized = false;
+
   if ((live && (!select || !deselect))) {
     chart->u.lscm.context = NULL;
   }
@@ -3275,92 +3280,98 @@ static PBool p_chart_lscm_solve(PHandle *handle, PChart *chart)
     }
   }
 
-  /* detect up direction based on pinned vertices */
-  area_pinned_up = 0.0f;
-  area_pinned_down = 0.0f;
+  /* When solving again for live unwrap the solver keeps the factorization (only the locked
+   * pins change), there is no need to compute the matrix coefficients again. */
+  if (!chart->u.lscm.matrix_factorized) {
+    /* detect up direction based on pinned vertices */
+    area_pinned_up = 0.0f;
+    area_pinned_down = 0.0f;
 
-  for (f = chart->faces; f; f = f->nextlink) {
-    PEdge *e1 = f->edge, *e2 = e1->next, *e3 = e2->next;
-    PVert *v1 = e1->vert, *v2 = e2->vert, *v3 = e3->vert;
+    for (f = chart->faces; f; f = f->nextlink) {
+      PEdge *e1 = f->edge, *e2 = e1->next, *e3 = e2->next;
+      PVert *v1 = e1->vert, *v2 = e2->vert, *v3 = e3->vert;
 
-    if ((v1->flag & PVERT_PIN) && (v2->flag & PVERT_PIN) && (v3->flag & PVERT_PIN)) {
-      float area = p_face_uv_area_signed(f);
+      if ((v1->flag & PVERT_PIN) && (v2->flag & PVERT_PIN) && (v3->flag & PVERT_PIN)) {
+        float area = p_face_uv_area_signed(f);
 
-      if (area > 0.0f) {
-        area_pinned_up += area;
-      }
-      else {
-        area_pinned_down -= area;
+        if (area > 0.0f) {
+          area_pinned_up += area;
+        }
+        else {
+          area_pinned_down -= area;
+        }
       }
     }
-  }
-
-  flip_faces = (area_pinned_down > area_pinned_up);
-
-  /* construct matrix */
 
-  row = 0;
-  for (f = chart->faces; f; f = f->nextlink) {
-    PEdge *e1 = f->edge, *e2 = e1->next, *e3 = e2->next;
-    PVert *v1 = e1->vert, *v2 = e2->vert, *v3 = e3->vert;
-    float a1, a2, a3, ratio, cosine, sine;
-    float sina1, sina2, sina3, sinmax;
+    flip_faces = (area_pinned_down > area_pinned_up);
 
-    if (alpha) {
-      /* use abf angles if passed on */
-      a1 = *(alpha++);
-      a2 = *(alpha++);
-      a3 = *(alpha++);
-    }
-    else {
-      p_face_angles(f, &a1, &a2, &a3);
-    }
+    /* construct matrix */
 
-    if (flip_faces) {
-      SWAP(float, a2, a3);
-      SWAP(PEdge *, e2, e3);
-      SWAP(PVert *, v2, v3);
-    }
+    row = 0;
+    for (f = chart->faces; f; f = f->nextlink) {
+      PEdge *e1 = f->edge, *e2 = e1->next, *e3 = e2->next;
+      PVert *v1 = e1->vert, *v2 = e2->vert, *v3 = e3->vert;
+      float a1, a2, a3, ratio, cosine, sine;
+      float sina1, sina2, sina3, sinmax;
+
+      if (alpha) {
+        /* use abf angles if passed on */
+        a1 = *(alpha++);
+        a2 = *(alpha++);
+        a3 = *(alpha++);
+      }
+      else {
+        p_face_angles(f, &a1, &a2, &a3);
+      }
 
-    sina1 = sinf(a1);
-    sina2 = sinf(a2);
-    sina3 = sinf(a3);
+      if (flip_faces) {
+        SWAP(float, a2, a3);
+        SWAP(PEdge *, e2, e3);
+        SWAP(PVert *, v2, v3);
+      }
 
-    sinmax = max_fff(sina1, sina2, sina3);
+      sina1 = sinf(a1);
+      sina2 = sinf(a2);
+      sina3 = sinf(a3);
 
-    /* shift vertices to find most stable order */
-    if (sina3 != sinmax) {
-      SHIFT3(PVert *, v1, v2, v3);
-      SHIFT3(float, a1, a2, a3);
-      SHIFT3(float, sina1, sina2, sina3);
+      sinmax = max_fff(sina1, sina2, sina3);
 
-      if (sina2 == sinmax) {
+      /* shift vertices to find most stable order */
+      if (sina3 != sinmax) {
         SHIFT3(PVert *, v1, v2, v3);
         SHIFT3(float, a1, a2, a3);
         SHIFT3(float, sina1, sina2, sina3);
+
+        if (sina2 == sinmax) {
+          SHIFT3(PVert *, v1, v2, v3);
+          SHIFT3(float, a1, a2, a3);
+          SHIFT3(float, sina1, sina2, sina3);
+        }
       }
-    }
 
-    /* angle based lscm formulation */
-    ratio = (sina3 == 0.0f) ? 1.0f : sina2 / sina3;
-    cosine = cosf(a1) * ratio;
-    sine = sina1 * ratio;
+      /* angle based lscm formulation */
+      ratio = (sina3 == 0.0f) ? 1.0f : sina2 / sina3;
+      cosine = cosf(a1) * ratio;
+      sine = sina1 * ratio;
 
-    EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id, cosine - 1.0f);
-    EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id + 1, -sine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id, -cosine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id + 1, sine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v3->u.id, 1.0);
-    row++;
+      EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id, cosine - 1.0f);
+      EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id + 1, -sine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id, -cosine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id + 1, sine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v3->u.id, 1.0);
+      row++;
 
-    EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id, sine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id + 1, cosine - 1.0f);
-    EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id, -sine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id + 1, -cosine);
-    EIG_linear_solver_matrix_add(context, row, 2 * v3->u.id + 1, 1.0);
-    row++;
+      EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id, sine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v1->u.id + 1, cosine - 1.0f);
+      EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id, -sine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v2->u.id + 1, -cosine);
+      EIG_linear_solver_matrix_add(context, row, 2 * v3->u.id + 1, 1.0);
+      row++;
+    }
   }
 
+  chart->u.lscm.matrix_factorized = true;
+
   if (EIG_linear_solver_solve(context)) {
     p_chart_lscm_load_solution(chart);
     return P_TRUE;
@@ -3409,6 +3420,7 @@ static void p_chart_lscm_end(PChart *chart)
   chart->u.lscm.pin2 = NULL;
   chart->u.lscm.single_pin = NULL;
   chart->u.lscm.single_pin_area = 0.0f;
+  chart->u.lscm.matrix_factorized = false;
 }
 
 /* Stretch */
@@ -4594,51 +4606,88 @@ void param_construct_end(ParamHandle *handle, ParamBool fill, ParamBool topology
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
-void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
+/* Charts don't share any data once split, so they are solved in parallel. */
+
+typedef struct PChartsLscmData {
+  PHandle *handle;
+  PBool live, abf;
+} PChartsLscmData;
+
+static void p_charts_lscm_begin_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  PHandle *phandle = (PHandle *)handle;
+  const PChartsLscmData *data = userdata;
+  PChart *chart = data->handle->charts[i];
   PFace *f;
-  int i;
 
-  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
-  phandle->state = PHANDLE_STATE_LSCM;
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
+static void p_charts_lscm_solve_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PChartsLscmData *data = userdata;
+  PChart *chart = data->handle->charts[i];
+  PBool result;
+
+  if (chart->u.lscm.context) {
+    result = p_chart_lscm_solve(data->handle, chart);
+
+    if (result && !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_rotate_minimum_area(chart);
+    }
+    else if (result && chart->u.lscm.single_pin) {
+      p_chart_rotate_fit_aabb(chart);
+      p_chart_lscm_transform_single_pin(chart);
+    }
+
+    if (!result || !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_lscm_end(chart);
     }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
   }
 }
 
-void param_lscm_solve(ParamHandle *handle)
+static void p_charts_parallel_settings(TaskParallelSettings *settings)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  /* Most charts are small, avoid scheduling a task for each of them. */
+  settings->min_iter_per_thread = 8;
+}
+
+void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
-  PBool result;
 
-  param_assert(phandle->state == PHANDLE_STATE_LSCM);
+  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
+  phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
+  PChartsLscmData data = {
+      .handle = phandle,
+      .live = (PBool)live,
+      .abf = (PBool)abf,
+  };
+  TaskParallelSettings settings;
+  p_charts_parallel_settings(&settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_charts_lscm_begin_cb, &settings);
+}
 
-    if (chart->u.lscm.context) {
-      result = p_chart_lscm_solve(phandle, chart);
+void param_lscm_solve(ParamHandle *handle)
+{
+  PHandle *phandle = (PHandle *)handle;
 
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
+  param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-      if (!result || !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_lscm_end(chart);
-      }
-    }
-  }
+  PChartsLscmData data = {
+      .handle = phandle,
+  };
+  TaskParallelSettings settings;
+  p_charts_parallel_settings(&settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_charts_lscm_solve_cb, &settings);
 }
 
 void param_lscm_end(ParamHandle *handle)
@@ -4740,23 +4789,37 @@ void param_smooth_area(ParamHandle *handle)
   }
 }
 
-/* don't pack, just rotate (used for better packing) */
-static void param_pack_rotate(ParamHandle *handle, bool ignore_pinned)
+typedef struct PChartsPackRotateData {
+  PHandle *handle;
+  bool ignore_pinned;
+} PChartsPackRotateData;
+
+static void p_charts_pack_rotate_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  PChart *chart;
-  int i;
+  const PChartsPackRotateData *data = userdata;
+  PChart *chart = data->handle->charts[i];
 
-  PHandle *phandle = (PHandle *)handle;
+  if (data->ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
+    return;
+  }
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
+  p_chart_rotate_fit_aabb(chart);
+}
 
-    if (ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
-      continue;
-    }
+/* don't pack, just rotate (used for better packing) */
+static void param_pack_rotate(ParamHandle *handle, bool ignore_pinned)
+{
+  PHandle *phandle = (PHandle *)handle;
 
-    p_chart_rotate_fit_aabb(chart);
-  }
+  PChartsPackRotateData data = {
+      .handle = phandle,
+      .ignore_pinned = ignore_pinned,
+  };
+  TaskParallelSettings settings;
+  p_charts_parallel_settings(&settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, p_charts_pack_rotate_cb, &settings);
 }
 
 void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned)
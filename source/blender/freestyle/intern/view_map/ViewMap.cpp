@@ -89,7 +89,9 @@ void ViewMap::Clean()
 
 ViewShape *ViewMap::viewShape(unsigned id)
 {
-  int index = _shapeIdToIndex[id];
+  // Use find() rather than operator[], this gets called from the visibility threads.
+  id_to_index_map::const_iterator it = _shapeIdToIndex.find(id);
+  int index = (it != _shapeIdToIndex.end()) ? it->second : 0;
   return _VShapes[index];
 }
 
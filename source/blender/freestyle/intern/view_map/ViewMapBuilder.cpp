@@ -38,6 +38,8 @@
 
 #include "../winged_edge/WFillGrid.h"
 
+#include "BLI_task.h"
+
 #include "BKE_global.h"
 
 namespace Freestyle {
@@ -433,211 +435,248 @@ static int computeVisibility(ViewMap *viewMap,
 // QI <= 22.
 
 template<typename G, typename I>
-static void computeCumulativeVisibility(ViewMap *ioViewMap,
-                                        G &grid,
-                                        real epsilon,
-                                        RenderMonitor *iRenderMonitor)
+static void computeCumulativeVisibility(ViewMap *ioViewMap, ViewEdge *ve, G &grid, real epsilon)
 {
-  vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
-
   FEdge *fe, *festart;
   int nSamples = 0;
   vector<WFace *> wFaces;
   WFace *wFace = nullptr;
-  unsigned cnt = 0;
-  unsigned cntStep = (unsigned)ceil(0.01f * vedges.size());
   unsigned tmpQI = 0;
   unsigned qiClasses[256];
   unsigned maxIndex, maxCard;
   unsigned qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor) {
-      if (iRenderMonitor->testBreak()) {
-        break;
-      }
-      if (cnt % cntStep == 0) {
-        stringstream ss;
-        ss << "Freestyle: Visibility computations " << (100 * cnt / vedges.size()) << "%";
-        iRenderMonitor->setInfo(ss.str());
-        iRenderMonitor->progress((float)cnt / vedges.size());
-      }
-      cnt++;
-    }
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "Processing ViewEdge " << ve->getId() << endl;
+  }
 #endif
-    // Find an edge to test
-    if (!(*ve)->isInImage()) {
-      // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+  // Find an edge to test
+  if (!ve->isInImage()) {
+    // This view edge has been proscenium culled
+    ve->setQI(255);
+    ve->setaShape(nullptr);
 #if LOGGING
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "\tCulled." << endl;
-      }
-#endif
-      continue;
+    if (_global.debug & G_DEBUG_FREESTYLE) {
+      cout << "\tCulled." << endl;
     }
+#endif
+    return;
+  }
 
-    // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
-    qiMajority = 0;
-    do {
-      if (fe != nullptr && fe->isInImage()) {
-        qiMajority++;
-      }
-      fe = fe->nextEdge();
-    } while (fe && fe != festart);
-
-    if (qiMajority == 0) {
-      // There are no occludable FEdges on this ViewEdge
-      // This should be impossible.
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
-      }
-      // We can recover from this error:
-      // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
+  // Test edge
+  festart = ve->fedgeA();
+  fe = ve->fedgeA();
+  qiMajority = 0;
+  do {
+    if (fe != nullptr && fe->isInImage()) {
+      qiMajority++;
     }
+    fe = fe->nextEdge();
+  } while (fe && fe != festart);
 
-    ++qiMajority;
-    qiMajority >>= 1;
-
-#if LOGGING
+  if (qiMajority == 0) {
+    // There are no occludable FEdges on this ViewEdge
+    // This should be impossible.
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tqiMajority: " << qiMajority << endl;
+      cout << "View Edge in viewport without occludable FEdges: " << ve->getId() << endl;
     }
-#endif
+    // We can recover from this error:
+    // Treat this edge as fully visible with no occludee
+    ve->setQI(0);
+    ve->setaShape(nullptr);
+    return;
+  }
 
-    tmpQI = 0;
-    maxIndex = 0;
-    maxCard = 0;
-    nSamples = 0;
-    memset(qiClasses, 0, 256 * sizeof(*qiClasses));
-    set<ViewShape *> foundOccluders;
+  ++qiMajority;
+  qiMajority >>= 1;
 
-    fe = (*ve)->fedgeA();
-    do {
-      if (!fe || !fe->isInImage()) {
-        fe = fe->nextEdge();
-        continue;
-      }
-      if ((maxCard < qiMajority)) {
-        // ARB: change &wFace to wFace and use reference in called function
-        tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: visibility " << tmpQI << endl;
-        }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tqiMajority: " << qiMajority << endl;
+  }
 #endif
 
-        // ARB: This is an error condition, not an alert condition.
-        // Some sort of recovery or abort is necessary.
-        if (tmpQI >= 256) {
-          cerr << "Warning: too many occluding levels" << endl;
-          // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
-          tmpQI = 255;
-        }
+  tmpQI = 0;
+  maxIndex = 0;
+  maxCard = 0;
+  nSamples = 0;
+  memset(qiClasses, 0, 256 * sizeof(*qiClasses));
+  set<ViewShape *> foundOccluders;
 
-        if (++qiClasses[tmpQI] > maxCard) {
-          maxCard = qiClasses[tmpQI];
-          maxIndex = tmpQI;
-        }
-      }
-      else {
-        // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
-        // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+  fe = ve->fedgeA();
+  do {
+    if (!fe || !fe->isInImage()) {
+      fe = fe->nextEdge();
+      continue;
+    }
+    if ((maxCard < qiMajority)) {
+      // ARB: change &wFace to wFace and use reference in called function
+      tmpQI = computeVisibility<G, I>(ioViewMap, fe, grid, epsilon, ve, &wFace, &foundOccluders);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
-               << endl;
-        }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFEdge: visibility " << tmpQI << endl;
+      }
 #endif
+
+      // ARB: This is an error condition, not an alert condition.
+      // Some sort of recovery or abort is necessary.
+      if (tmpQI >= 256) {
+        cerr << "Warning: too many occluding levels" << endl;
+        // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
+        tmpQI = 255;
       }
 
-      // Store test results
-      if (wFace) {
-        vector<Vec3r> vertices;
-        for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
-          vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
-        }
-        Polygon3r poly(vertices, wFace->GetNormal());
-        poly.userdata = (void *)wFace;
-        fe->setaFace(poly);
-        wFaces.push_back(wFace);
-        fe->setOccludeeEmpty(false);
+      if (++qiClasses[tmpQI] > maxCard) {
+        maxCard = qiClasses[tmpQI];
+        maxIndex = tmpQI;
+      }
+    }
+    else {
+      // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
+      // ARB: change &wFace to wFace and use reference in called function
+      findOccludee<G, I>(fe, grid, epsilon, ve, &wFace);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFound occludee" << endl;
-        }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
+             << endl;
+      }
 #endif
+    }
+
+    // Store test results
+    if (wFace) {
+      vector<Vec3r> vertices;
+      for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
+        vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
       }
-      else {
-        fe->setOccludeeEmpty(true);
+      Polygon3r poly(vertices, wFace->GetNormal());
+      poly.userdata = (void *)wFace;
+      fe->setaFace(poly);
+      wFaces.push_back(wFace);
+      fe->setOccludeeEmpty(false);
+#if LOGGING
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFound occludee" << endl;
       }
+#endif
+    }
+    else {
+      fe->setOccludeeEmpty(true);
+    }
 
-      ++nSamples;
-      fe = fe->nextEdge();
-    } while ((maxCard < qiMajority) && (fe) && (fe != festart));
+    ++nSamples;
+    fe = fe->nextEdge();
+  } while ((maxCard < qiMajority) && (fe) && (fe != festart));
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
+  }
 #endif
 
-    // ViewEdge
-    // qi --
-    // Find the minimum value that is >= the majority of the QI
-    for (unsigned count = 0, i = 0; i < 256; ++i) {
-      count += qiClasses[i];
-      if (count >= qiMajority) {
-        (*ve)->setQI(i);
-        break;
-      }
-    }
-    // occluders --
-    // I would rather not have to go through the effort of creating this set and then copying out
-    // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
-    for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
-         o != oend;
-         ++o) {
-      (*ve)->AddOccluder((*o));
+  // ViewEdge
+  // qi --
+  // Find the minimum value that is >= the majority of the QI
+  for (unsigned count = 0, i = 0; i < 256; ++i) {
+    count += qiClasses[i];
+    if (count >= qiMajority) {
+      ve->setQI(i);
+      break;
     }
+  }
+  // occluders --
+  // I would rather not have to go through the effort of creating this set and then copying out
+  // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
+  for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
+       o != oend;
+       ++o) {
+    ve->AddOccluder((*o));
+  }
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
-           << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tConclusion: QI = " << maxIndex << ", " << ve->occluders_size() << " occluders."
+         << endl;
+  }
 #else
-    (void)maxIndex;
+  (void)maxIndex;
 #endif
-    // occludee --
-    if (!wFaces.empty()) {
-      if (wFaces.size() <= (float)nSamples / 2.0f) {
-        (*ve)->setaShape(nullptr);
-      }
-      else {
-        ViewShape *vshape = ioViewMap->viewShape(
-            (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
-      }
+  // occludee --
+  if (!wFaces.empty()) {
+    if (wFaces.size() <= (float)nSamples / 2.0f) {
+      ve->setaShape(nullptr);
+    }
+    else {
+      ViewShape *vshape = ioViewMap->viewShape((*wFaces.begin())->GetVertex(0)->shape()->GetId());
+      ve->setaShape(vshape);
     }
+  }
+}
 
-    wFaces.clear();
+template<typename G>
+struct CumulativeVisibilityData {
+  ViewMap *viewMap;
+  vector<ViewEdge *> *viewEdges;
+  G *grid;
+  real epsilon;
+};
+
+template<typename G, typename I>
+static void computeCumulativeVisibilityTask(void *__restrict userdata,
+                                            const int index,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  CumulativeVisibilityData<G> *data = static_cast<CumulativeVisibilityData<G> *>(userdata);
+  computeCumulativeVisibility<G, I>(
+      data->viewMap, (*data->viewEdges)[index], *data->grid, data->epsilon);
+}
+
+// The view edges are independent of each other: the grid is only read and each task only writes
+// to its own view edge and the FEdges of it. The only shared write is the lazily computed
+// boundary flag of winged edge vertices, which always gets the same value.
+//
+// The edges are processed in chunks so that the progress and the break test keep being handled
+// from the calling thread.
+template<typename G, typename I>
+static void computeCumulativeVisibility(ViewMap *ioViewMap,
+                                        G &grid,
+                                        real epsilon,
+                                        RenderMonitor *iRenderMonitor)
+{
+  vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
+  const unsigned vedges_size = vedges.size();
+
+  CumulativeVisibilityData<G> data;
+  data.viewMap = ioViewMap;
+  data.viewEdges = &vedges;
+  data.grid = &grid;
+  data.epsilon = epsilon;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  const unsigned cntStep = (unsigned)ceil(0.01f * vedges_size);
+  const unsigned chunkSize = (iRenderMonitor) ? max(cntStep, 64u) : vedges_size;
+  unsigned cnt = 0;
+  while (cnt < vedges_size) {
+    if (iRenderMonitor) {
+      if (iRenderMonitor->testBreak()) {
+        break;
+      }
+      stringstream ss;
+      ss << "Freestyle: Visibility computations " << (100 * cnt / vedges_size) << "%";
+      iRenderMonitor->setInfo(ss.str());
+      iRenderMonitor->progress((float)cnt / vedges_size);
+    }
+    const unsigned chunkEnd = min(cnt + chunkSize, vedges_size);
+    BLI_task_parallel_range(
+        (int)cnt, (int)chunkEnd, &data, computeCumulativeVisibilityTask<G, I>, &settings);
+    cnt = chunkEnd;
   }
   if (iRenderMonitor && !vedges.empty()) {
     stringstream ss;
-    ss << "Freestyle: Visibility computations " << (100 * cnt / vedges.size()) << "%";
+    ss << "Freestyle: Visibility computations " << (100 * cnt / vedges_size) << "%";
     iRenderMonitor->setInfo(ss.str());
-    iRenderMonitor->progress((float)cnt / vedges.size());
+    iRenderMonitor->progress((float)cnt / vedges_size);
   }
 }
 
@@ -25,8 +25,13 @@
 namespace blender::fn {
 
 class MFNetworkEvaluationStorage;
+class MFBufferPool;
 
 class MFNetworkEvaluator : public MultiFunction {
+ public:
+  /** Masks larger than this are evaluated in chunks of this size. */
+  static constexpr int64_t chunk_size = 4096;
+
  private:
   Vector<const MFOutputSocket *> inputs_;
   Vector<const MFInputSocket *> outputs_;
@@ -39,6 +44,17 @@ class MFNetworkEvaluator : public MultiFunction {
  private:
   using Storage = MFNetworkEvaluationStorage;
 
+  bool can_evaluate_in_chunks() const;
+  void evaluate_chunk(IndexMask mask,
+                      int64_t chunk_index,
+                      MFParams params,
+                      MFContext context,
+                      MFBufferPool &buffer_pool) const;
+  void evaluate_network(IndexMask mask,
+                        MFParams params,
+                        MFContext context,
+                        MFBufferPool *buffer_pool) const;
+
   void copy_inputs_to_storage(MFParams params, Storage &storage) const;
   void copy_outputs_to_storage(
       MFParams params,
@@ -25,5 +25,6 @@ namespace blender::fn::mf_network_optimization {
 void dead_node_removal(MFNetwork &network);
 void constant_folding(MFNetwork &network, ResourceCollector &resources);
 void common_subnetwork_elimination(MFNetwork &network);
+void element_wise_fusion(MFNetwork &network, ResourceCollector &resources);
 
 }  // namespace blender::fn::mf_network_optimization
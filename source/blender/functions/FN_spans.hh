@@ -103,6 +103,13 @@ class GSpan {
     BLI_assert(type_->is<T>());
     return Span<T>(static_cast<const T *>(data_), size_);
   }
+
+  GSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0 && size >= 0);
+    BLI_assert(start + size <= size_);
+    return GSpan(*type_, POINTER_OFFSET(data_, type_->size() * start), size);
+  }
 };
 
 /**
@@ -178,6 +185,13 @@ class GMutableSpan {
     BLI_assert(type_->is<T>());
     return MutableSpan<T>(static_cast<T *>(data_), size_);
   }
+
+  GMutableSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0 && size >= 0);
+    BLI_assert(start + size <= size_);
+    return GMutableSpan(*type_, POINTER_OFFSET(data_, type_->size() * start), size);
+  }
 };
 
 enum class VSpanCategory {
@@ -433,6 +447,24 @@ class GVSpan : public VSpanBase<void> {
     return (*this)[0];
   }
 
+  GVSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0 && size >= 0);
+    BLI_assert(start + size <= this->virtual_size_);
+    switch (this->category_) {
+      case VSpanCategory::Single:
+        return GVSpan::FromSingle(*this->type_, this->data_.single.data, size);
+      case VSpanCategory::FullArray:
+        return GVSpan(GSpan(*this->type_, this->data_.full_array.data, this->virtual_size_)
+                          .slice(start, size));
+      case VSpanCategory::FullPointerArray:
+        return GVSpan::FromFullPointerArray(
+            *this->type_, this->data_.full_pointer_array.data + start, size);
+    }
+    BLI_assert(false);
+    return GVSpan(*this->type_);
+  }
+
   GSpan as_full_array() const
   {
     BLI_assert(this->is_full_array());
@@ -28,21 +28,66 @@
  * - Avoids data copies in many cases.
  * - Every node is executed at most once.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ * - Large masks are split into chunks that are evaluated through the entire network in parallel.
+ *   That keeps the temporary buffers small, and they are reused by the following chunks.
  *
  * Possible improvements:
- * - Cache and reuse buffers.
  * - Use "deepest depth first" heuristic to decide which order the inputs of a node should be
  *   computed. This reduces the number of required temporary buffers when they are reused.
  */
 
 #include "FN_multi_function_network_evaluation.hh"
 
+#include "BLI_map.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 
 namespace blender::fn {
 
 struct Value;
 
+/**
+ * Keeps the temporary buffers that are not used anymore, so that they can be used again by the
+ * chunks evaluated after the current one. Every task evaluating chunks has its own pool.
+ */
+class MFBufferPool {
+ private:
+  /* All buffers are allocated with this alignment, so that only their size has to match. */
+  static constexpr int64_t alignment = 64;
+
+  Map<int64_t, Vector<void *>> buffers_by_size_;
+
+ public:
+  MFBufferPool() = default;
+  MFBufferPool(const MFBufferPool &other) = delete;
+  MFBufferPool &operator=(const MFBufferPool &other) = delete;
+
+  ~MFBufferPool()
+  {
+    for (Vector<void *> &buffers : buffers_by_size_.values()) {
+      for (void *buffer : buffers) {
+        MEM_freeN(buffer);
+      }
+    }
+  }
+
+  void *allocate(const int64_t size, const int64_t type_alignment)
+  {
+    BLI_assert(type_alignment <= alignment);
+    UNUSED_VARS_NDEBUG(type_alignment);
+    Vector<void *> *buffers = buffers_by_size_.lookup_ptr(size);
+    if (buffers != nullptr && !buffers->is_empty()) {
+      return buffers->pop_last();
+    }
+    return MEM_mallocN_aligned(size, alignment, AT);
+  }
+
+  void deallocate(void *buffer, const int64_t size)
+  {
+    buffers_by_size_.lookup_or_add_default(size).append(buffer);
+  }
+};
+
 /**
  * This keeps track of all the values that flow through the multi-function network. Therefore it
  * maintains a mapping between output sockets and their corresponding values. Every `value`
@@ -56,9 +101,11 @@ class MFNetworkEvaluationStorage {
   IndexMask mask_;
   Array<Value *> value_per_output_id_;
   int64_t min_array_size_;
+  /* Optional, buffers are freed directly without it. */
+  MFBufferPool *buffer_pool_;
 
  public:
-  MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount);
+  MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount, MFBufferPool *buffer_pool);
   ~MFNetworkEvaluationStorage();
 
   /* Add the values that have been provided by the caller of the multi-function network. */
@@ -97,6 +144,10 @@ class MFNetworkEvaluationStorage {
   bool socket_is_computed(const MFOutputSocket &socket);
   bool is_same_value_for_every_index(const MFOutputSocket &socket);
   bool socket_has_buffer_for_output(const MFOutputSocket &socket);
+
+ private:
+  void *allocate_full_buffer(const CPPType &type);
+  void free_full_buffer(GMutableSpan span);
 };
 
 MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
@@ -141,8 +192,87 @@ void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context
     return;
   }
 
+  if (mask.size() <= chunk_size || !this->can_evaluate_in_chunks()) {
+    this->evaluate_network(mask, params, context, nullptr);
+    return;
+  }
+
+  const int64_t chunk_amount = (mask.size() + chunk_size - 1) / chunk_size;
+  parallel_for(IndexRange(chunk_amount), 1, [&](IndexRange chunk_range) {
+    MFBufferPool buffer_pool;
+    for (const int64_t chunk_index : chunk_range) {
+      this->evaluate_chunk(mask, chunk_index, params, context, buffer_pool);
+    }
+  });
+}
+
+/**
+ * Chunks are only used when all parameters are single values, because vector arrays can not be
+ * sliced.
+ */
+bool MFNetworkEvaluator::can_evaluate_in_chunks() const
+{
+  for (const MFOutputSocket *socket : inputs_) {
+    if (socket->data_type().category() != MFDataType::Single) {
+      return false;
+    }
+  }
+  for (const MFInputSocket *socket : outputs_) {
+    if (socket->data_type().category() != MFDataType::Single) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Evaluate the network on a part of the mask. The indices within the chunk are relative to its
+ * first index, so that the temporary buffers only have to be as large as the chunk.
+ */
+void MFNetworkEvaluator::evaluate_chunk(IndexMask mask,
+                                        const int64_t chunk_index,
+                                        MFParams params,
+                                        MFContext context,
+                                        MFBufferPool &buffer_pool) const
+{
+  const int64_t chunk_start = chunk_index * chunk_size;
+  const IndexMask chunk_mask = mask.indices().slice(
+      chunk_start, std::min(chunk_size, mask.size() - chunk_start));
+  const int64_t offset = chunk_mask[0];
+  const int64_t local_size = chunk_mask.last() - offset + 1;
+
+  Vector<int64_t> local_indices;
+  IndexMask local_mask = IndexRange(local_size);
+  if (!chunk_mask.is_range()) {
+    local_indices.reserve(chunk_mask.size());
+    for (const int64_t i : chunk_mask) {
+      local_indices.append(i - offset);
+    }
+    local_mask = local_indices.as_span();
+  }
+
+  MFParamsBuilder chunk_params{*this, local_size};
+  for (const int param_index : this->param_indices()) {
+    if (this->param_type(param_index).interface_type() == MFParamType::Input) {
+      chunk_params.add_readonly_single_input(
+          params.readonly_single_input(param_index).slice(offset, local_size));
+    }
+    else {
+      chunk_params.add_uninitialized_single_output(
+          params.uninitialized_single_output(param_index).slice(offset, local_size));
+    }
+  }
+
+  this->evaluate_network(local_mask, chunk_params, context, &buffer_pool);
+}
+
+void MFNetworkEvaluator::evaluate_network(IndexMask mask,
+                                          MFParams params,
+                                          MFContext context,
+                                          MFBufferPool *buffer_pool) const
+{
   const MFNetwork &network = outputs_[0]->node().network();
-  Storage storage(mask, network.socket_id_amount());
+  Storage storage(mask, network.socket_id_amount(), buffer_pool);
 
   Vector<const MFInputSocket *> outputs_to_initialize_in_the_end;
 
@@ -506,10 +636,13 @@ struct OwnVectorValue : public Value {
 /** \name Storage methods
  * \{ */
 
-MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount)
+MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(IndexMask mask,
+                                                       int socket_id_amount,
+                                                       MFBufferPool *buffer_pool)
     : mask_(mask),
       value_per_output_id_(socket_id_amount, nullptr),
-      min_array_size_(mask.min_array_size())
+      min_array_size_(mask.min_array_size()),
+      buffer_pool_(buffer_pool)
 {
 }
 
@@ -528,7 +661,7 @@ MFNetworkEvaluationStorage::~MFNetworkEvaluationStorage()
       }
       else {
         type.destruct_indices(span.data(), mask_);
-        MEM_freeN(span.data());
+        this->free_full_buffer(span);
       }
     }
     else if (any_value->type == ValueType::OwnVector) {
@@ -538,6 +671,24 @@ MFNetworkEvaluationStorage::~MFNetworkEvaluationStorage()
   }
 }
 
+void *MFNetworkEvaluationStorage::allocate_full_buffer(const CPPType &type)
+{
+  if (buffer_pool_ != nullptr) {
+    return buffer_pool_->allocate(min_array_size_ * type.size(), type.alignment());
+  }
+  return MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
+}
+
+void MFNetworkEvaluationStorage::free_full_buffer(GMutableSpan span)
+{
+  if (buffer_pool_ != nullptr) {
+    buffer_pool_->deallocate(span.data(), span.size() * span.type().size());
+  }
+  else {
+    MEM_freeN(span.data());
+  }
+}
+
 IndexMask MFNetworkEvaluationStorage::mask() const
 {
   return mask_;
@@ -638,7 +789,7 @@ void MFNetworkEvaluationStorage::finish_input_socket(const MFInputSocket &socket
         }
         else {
           type.destruct_indices(span.data(), mask_);
-          MEM_freeN(span.data());
+          this->free_full_buffer(span);
         }
         value_per_output_id_[origin.id()] = nullptr;
       }
@@ -702,7 +853,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_single_output__full(const MFOutputS
   Value *any_value = value_per_output_id_[socket.id()];
   if (any_value == nullptr) {
     const CPPType &type = socket.data_type().single_type();
-    void *buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
+    void *buffer = this->allocate_full_buffer(type);
     GMutableSpan span(type, buffer, min_array_size_);
 
     auto *value = allocator_.construct<OwnSingleValue>(span, socket.targets().size(), false);
@@ -802,7 +953,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_mutable_single__full(const MFInputS
   }
 
   GVSpan virtual_span = this->get_single_input__full(input);
-  void *new_buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
+  void *new_buffer = this->allocate_full_buffer(type);
   GMutableSpan new_array_ref(type, new_buffer, min_array_size_);
   virtual_span.materialize_to_uninitialized(mask_, new_array_ref.data());
 
@@ -505,4 +505,332 @@ void common_subnetwork_elimination(MFNetwork &network)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Element-wise Fusion
+ *
+ * \{ */
+
+/**
+ * Evaluates a sequence of element-wise functions on chunks of the mask. The intermediate values
+ * of a chunk are stored in small buffers that stay in the CPU cache, instead of arrays as large as
+ * the mask that are written by one function and read again by the next.
+ */
+class FusedElementWiseFunction : public MultiFunction {
+ public:
+  /* Amount of indices that are processed by all functions before the next chunk. */
+  static constexpr int64_t chunk_size = 1024;
+
+  struct Step {
+    const MultiFunction *fn;
+    /* Variable passed to every parameter of the function. The parameters of the fused function
+     * come first, followed by the temporary buffers. */
+    Vector<int> variables;
+  };
+
+ private:
+  Vector<Step> steps_;
+  Vector<const CPPType *> temporary_types_;
+
+ public:
+  /**
+   * \param second_inputs_from_first: For every input of the second function, the index of the
+   * output of the first function it is computed from, or -1 when it is an input of the fused
+   * function.
+   */
+  FusedElementWiseFunction(const MultiFunction &first_fn,
+                           const MultiFunction &second_fn,
+                           Span<int> second_inputs_from_first)
+  {
+    MFSignatureBuilder signature = this->get_builder(std::string(first_fn.name()) + ", " +
+                                                     second_fn.name());
+
+    Vector<Step> first_steps, second_steps;
+    Vector<const CPPType *> first_temporary_types, second_temporary_types;
+    get_steps(first_fn, first_steps, first_temporary_types);
+    get_steps(second_fn, second_steps, second_temporary_types);
+
+    /* Map the variables of both functions to the variables of the fused function. Inputs of the
+     * first function come first, then the unlinked inputs and the outputs of the second one. */
+    Array<int> first_variables(first_fn.param_amount() + first_temporary_types.size(), -1);
+    Array<int> second_variables(second_fn.param_amount() + second_temporary_types.size(), -1);
+    int params_amount = 0;
+    Vector<int> first_output_params;
+    for (const int param_index : first_fn.param_indices()) {
+      const MFParamType param_type = first_fn.param_type(param_index);
+      if (param_type.interface_type() == MFParamType::Input) {
+        signature.single_input(first_fn.param_name(param_index),
+                               param_type.data_type().single_type());
+        first_variables[param_index] = params_amount++;
+      }
+      else {
+        first_output_params.append(param_index);
+      }
+    }
+    Vector<int> second_linked_params;
+    int input_index = 0;
+    for (const int param_index : second_fn.param_indices()) {
+      const MFParamType param_type = second_fn.param_type(param_index);
+      if (param_type.interface_type() == MFParamType::Input) {
+        if (second_inputs_from_first[input_index] == -1) {
+          signature.single_input(second_fn.param_name(param_index),
+                                 param_type.data_type().single_type());
+          second_variables[param_index] = params_amount++;
+        }
+        else {
+          second_linked_params.append(param_index);
+        }
+        input_index++;
+      }
+    }
+    for (const int param_index : second_fn.param_indices()) {
+      const MFParamType param_type = second_fn.param_type(param_index);
+      if (param_type.interface_type() == MFParamType::Output) {
+        signature.single_output(second_fn.param_name(param_index),
+                                param_type.data_type().single_type());
+        second_variables[param_index] = params_amount++;
+      }
+    }
+
+    auto add_temporary = [&](const CPPType &type) {
+      temporary_types_.append(&type);
+      return params_amount + (int)temporary_types_.size() - 1;
+    };
+    for (const int param_index : first_output_params) {
+      first_variables[param_index] = add_temporary(
+          first_fn.param_type(param_index).data_type().single_type());
+    }
+    input_index = 0;
+    for (const int param_index : second_fn.param_indices()) {
+      if (second_fn.param_type(param_index).interface_type() == MFParamType::Input) {
+        const int first_output_index = second_inputs_from_first[input_index];
+        if (first_output_index != -1) {
+          second_variables[param_index] =
+              first_variables[first_output_params[first_output_index]];
+        }
+        input_index++;
+      }
+    }
+    for (const int i : first_temporary_types.index_range()) {
+      first_variables[first_fn.param_amount() + i] = add_temporary(*first_temporary_types[i]);
+    }
+    for (const int i : second_temporary_types.index_range()) {
+      second_variables[second_fn.param_amount() + i] = add_temporary(*second_temporary_types[i]);
+    }
+
+    for (const Step &step : first_steps) {
+      this->add_step(step, first_variables);
+    }
+    for (const Step &step : second_steps) {
+      this->add_step(step, second_variables);
+    }
+  }
+
+  void call(IndexMask mask, MFParams params, MFContext context) const override
+  {
+    const int params_amount = this->param_amount();
+    Array<void *> buffers(temporary_types_.size(), nullptr);
+    int64_t buffers_capacity = 0;
+
+    for (int64_t chunk_start = 0; chunk_start < mask.size(); chunk_start += chunk_size) {
+      const IndexMask chunk_mask = mask.indices().slice(
+          chunk_start, std::min(chunk_size, mask.size() - chunk_start));
+
+      /* The functions are called with indices relative to the first index of the chunk, so that
+       * the temporary buffers only have to be as large as the chunk. */
+      const int64_t offset = chunk_mask[0];
+      const int64_t local_size = chunk_mask.last() - offset + 1;
+      Vector<int64_t> local_indices;
+      IndexMask local_mask = IndexRange(local_size);
+      if (!chunk_mask.is_range()) {
+        for (const int64_t i : chunk_mask) {
+          local_indices.append(i - offset);
+        }
+        local_mask = local_indices.as_span();
+      }
+
+      if (local_size > buffers_capacity) {
+        buffers_capacity = std::max(local_size, chunk_size);
+        for (const int i : buffers.index_range()) {
+          const CPPType &type = *temporary_types_[i];
+          MEM_SAFE_FREE(buffers[i]);
+          buffers[i] = MEM_mallocN_aligned(
+              type.size() * buffers_capacity, type.alignment(), __func__);
+        }
+      }
+
+      for (const Step &step : steps_) {
+        MFParamsBuilder step_params{*step.fn, local_size};
+        for (const int param_index : step.fn->param_indices()) {
+          const MFParamType param_type = step.fn->param_type(param_index);
+          const CPPType &type = param_type.data_type().single_type();
+          const int variable = step.variables[param_index];
+          const bool is_temporary = variable >= params_amount;
+          if (param_type.interface_type() == MFParamType::Input) {
+            if (is_temporary) {
+              step_params.add_readonly_single_input(
+                  GSpan(type, buffers[variable - params_amount], local_size));
+            }
+            else {
+              step_params.add_readonly_single_input(
+                  params.readonly_single_input(variable).slice(offset, local_size));
+            }
+          }
+          else {
+            if (is_temporary) {
+              step_params.add_uninitialized_single_output(
+                  GMutableSpan(type, buffers[variable - params_amount], local_size));
+            }
+            else {
+              step_params.add_uninitialized_single_output(
+                  params.uninitialized_single_output(variable).slice(offset, local_size));
+            }
+          }
+        }
+        step.fn->call(local_mask, step_params, context);
+      }
+
+      for (const int i : buffers.index_range()) {
+        temporary_types_[i]->destruct_indices(buffers[i], local_mask);
+      }
+    }
+
+    for (void *buffer : buffers) {
+      MEM_SAFE_FREE(buffer);
+    }
+  }
+
+ private:
+  static void get_steps(const MultiFunction &fn,
+                        Vector<Step> &r_steps,
+                        Vector<const CPPType *> &r_temporary_types)
+  {
+    if (const FusedElementWiseFunction *fused_fn = dynamic_cast<const FusedElementWiseFunction *>(
+            &fn)) {
+      r_steps = fused_fn->steps_;
+      r_temporary_types = fused_fn->temporary_types_;
+      return;
+    }
+    Step step;
+    step.fn = &fn;
+    for (const int param_index : fn.param_indices()) {
+      step.variables.append(param_index);
+    }
+    r_steps.append(std::move(step));
+  }
+
+  void add_step(const Step &step, Span<int> variables_map)
+  {
+    Step new_step;
+    new_step.fn = step.fn;
+    for (const int variable : step.variables) {
+      BLI_assert(variables_map[variable] != -1);
+      new_step.variables.append(variables_map[variable]);
+    }
+    steps_.append(std::move(new_step));
+  }
+};
+
+static bool function_is_element_wise(const MultiFunction &fn)
+{
+  if (fn.depends_on_context()) {
+    return false;
+  }
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType::Category category = fn.param_type(param_index).category();
+    if (!ELEM(category, MFParamType::SingleInput, MFParamType::SingleOutput)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Returns the node that all outputs of the given node are linked to, when both nodes can be
+ * fused into a single function.
+ */
+static MFFunctionNode *find_node_to_fuse_into(MFFunctionNode &node)
+{
+  if (!function_is_element_wise(node.function())) {
+    return nullptr;
+  }
+  MFFunctionNode *target_node = nullptr;
+  for (MFOutputSocket *output_socket : node.outputs()) {
+    for (MFInputSocket *target_socket : output_socket->targets()) {
+      MFNode &node = target_socket->node();
+      if (node.is_dummy()) {
+        return nullptr;
+      }
+      if (target_node != nullptr && target_node != &node) {
+        return nullptr;
+      }
+      target_node = &node.as_function();
+    }
+  }
+  if (target_node == nullptr || !function_is_element_wise(target_node->function())) {
+    return nullptr;
+  }
+  return target_node;
+}
+
+static void fuse_nodes(MFNetwork &network,
+                       ResourceCollector &resources,
+                       MFFunctionNode &first_node,
+                       MFFunctionNode &second_node)
+{
+  Vector<int> second_inputs_from_first;
+  for (MFInputSocket *input_socket : second_node.inputs()) {
+    MFOutputSocket *origin = input_socket->origin();
+    const bool is_from_first = origin != nullptr && &origin->node() == &first_node;
+    second_inputs_from_first.append(is_from_first ? origin->index() : -1);
+  }
+
+  const MultiFunction &fused_fn = resources.construct<FusedElementWiseFunction>(
+      AT, first_node.function(), second_node.function(), second_inputs_from_first);
+  MFFunctionNode &fused_node = network.add_function(fused_fn);
+
+  int fused_input_index = 0;
+  for (MFInputSocket *input_socket : first_node.inputs()) {
+    if (MFOutputSocket *origin = input_socket->origin()) {
+      network.add_link(*origin, fused_node.input(fused_input_index));
+    }
+    fused_input_index++;
+  }
+  for (const int i : second_node.inputs().index_range()) {
+    if (second_inputs_from_first[i] == -1) {
+      if (MFOutputSocket *origin = second_node.input(i).origin()) {
+        network.add_link(*origin, fused_node.input(fused_input_index));
+      }
+      fused_input_index++;
+    }
+  }
+  for (const int i : second_node.outputs().index_range()) {
+    network.relink(second_node.output(i), fused_node.output(i));
+  }
+
+  network.remove({&first_node, &second_node});
+}
+
+/**
+ * Replace chains of element-wise functions, whose intermediate values are not used elsewhere, by
+ * single functions that evaluate the chain on small chunks, see #FusedElementWiseFunction.
+ */
+void element_wise_fusion(MFNetwork &network, ResourceCollector &resources)
+{
+  bool has_fused_nodes = true;
+  while (has_fused_nodes) {
+    has_fused_nodes = false;
+    for (MFFunctionNode *node : network.function_nodes()) {
+      MFFunctionNode *target_node = find_node_to_fuse_into(*node);
+      if (target_node != nullptr) {
+        /* The nodes of the network change, so the loop starts again. */
+        fuse_nodes(network, resources, *node, *target_node);
+        has_fused_nodes = true;
+        break;
+      }
+    }
+  }
+}
+
+/** \} */
+
 }  // namespace blender::fn::mf_network_optimization
@@ -5,6 +5,7 @@
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_network.hh"
 #include "FN_multi_function_network_evaluation.hh"
+#include "FN_multi_function_network_optimization.hh"
 
 namespace blender::fn::tests {
 namespace {
@@ -251,5 +252,117 @@ TEST(multi_function_network, Test2)
   }
 }
 
+TEST(multi_function_network, ChunkedEvaluation)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_10_fn);
+  MFNode &node2 = network.add_function(multiply_fn);
+  MFOutputSocket &input_socket = network.add_input("Input", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket1 = network.add_output("Output 1", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket2 = network.add_output("Output 2", MFDataType::ForSingle<int>());
+  network.add_link(input_socket, node1.input(0));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(node1.output(0), node2.input(1));
+  network.add_link(node2.output(0), output_socket1);
+  network.add_link(input_socket, output_socket2);
+
+  MFNetworkEvaluator network_fn{{&input_socket}, {&output_socket1, &output_socket2}};
+
+  /* Spans multiple chunks, with the last one being smaller. */
+  const int size = MFNetworkEvaluator::chunk_size * 3 + 100;
+  Array<int> values(size);
+  Vector<int64_t> indices;
+  for (const int i : IndexRange(size)) {
+    values[i] = i % 100;
+    if (i % 5 != 0) {
+      indices.append(i);
+    }
+  }
+  Array<int> results1(size, -1);
+  Array<int> results2(size, -1);
+
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values.as_span());
+  params.add_uninitialized_single_output(results1.as_mutable_span());
+  params.add_uninitialized_single_output(results2.as_mutable_span());
+
+  MFContextBuilder context;
+
+  network_fn.call(indices.as_span(), params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 5 != 0) {
+      EXPECT_EQ(results1[i], (i % 100 + 10) * (i % 100 + 10));
+      EXPECT_EQ(results2[i], i % 100);
+    }
+    else {
+      EXPECT_EQ(results1[i], -1);
+      EXPECT_EQ(results2[i], -1);
+    }
+  }
+}
+
+TEST(multi_function_network, ElementWiseFusion)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_10_fn);
+  MFNode &node2 = network.add_function(multiply_fn);
+  MFNode &node3 = network.add_function(add_10_fn);
+  MFOutputSocket &input_socket1 = network.add_input("Input 1", MFDataType::ForSingle<int>());
+  MFOutputSocket &input_socket2 = network.add_input("Input 2", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_socket1, node1.input(0));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(input_socket2, node2.input(1));
+  network.add_link(node2.output(0), node3.input(0));
+  network.add_link(node3.output(0), output_socket);
+
+  ResourceCollector resources;
+  mf_network_optimization::element_wise_fusion(network, resources);
+  EXPECT_EQ(network.function_nodes().size(), 1);
+
+  MFNetworkEvaluator network_fn{{&input_socket1, &input_socket2}, {&output_socket}};
+
+  /* Larger than a chunk, with every third index masked out. */
+  const int size = 3000;
+  Array<int> values1(size);
+  Array<int> values2(size);
+  Vector<int64_t> indices;
+  for (const int i : IndexRange(size)) {
+    values1[i] = i;
+    values2[i] = i % 7;
+    if (i % 3 != 0) {
+      indices.append(i);
+    }
+  }
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values1.as_span());
+  params.add_readonly_single_input(values2.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+
+  network_fn.call(indices.as_span(), params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 != 0) {
+      EXPECT_EQ(results[i], (i + 10) * (i % 7) + 10);
+    }
+    else {
+      EXPECT_EQ(results[i], -1);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace blender::fn::tests
@@ -45,6 +45,11 @@ GPUShader *GPU_shader_create(const char *vertcode,
                              const char *libcode,
                              const char *defines,
                              const char *shname);
+GPUShader *GPU_shader_create_cached(const char *vertcode,
+                                    const char *fragcode,
+                                    const char *geomcode,
+                                    const char *defines,
+                                    const char *shname);
 GPUShader *GPU_shader_create_from_python(const char *vertcode,
                                          const char *fragcode,
                                          const char *geomcode,
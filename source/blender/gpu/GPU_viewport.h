@@ -60,6 +60,8 @@ typedef struct ViewportMemoryPool {
   struct GPUUniformBuf **obinfos_ubo;
   struct GHash *obattrs_ubo_pool;
   uint ubo_len;
+  /** Depth of the previous redraw used for occlusion culling, one for each stereo view. */
+  struct DRWOcclusionBuffer *occlusion[2];
 } ViewportMemoryPool;
 
 /* All FramebufferLists are just the same pointers with different names */
@@ -140,6 +142,7 @@ void *GPU_viewport_texture_list_get(GPUViewport *viewport);
 void GPU_viewport_size_get(const GPUViewport *viewport, int size[2]);
 void GPU_viewport_size_set(GPUViewport *viewport, const int size[2]);
 void GPU_viewport_active_view_set(GPUViewport *viewport, int view);
+int GPU_viewport_active_view_get(GPUViewport *viewport);
 
 /* Profiling */
 double *GPU_viewport_cache_time_get(GPUViewport *viewport);
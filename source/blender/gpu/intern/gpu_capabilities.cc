@@ -61,6 +61,11 @@ int GPU_max_texture_layers(void)
   return GCaps.max_texture_layers;
 }
 
+int GPU_max_texture_3d_size(void)
+{
+  return GCaps.max_texture_3d_size;
+}
+
 int GPU_max_textures_vert(void)
 {
   return GCaps.max_textures_vert;
@@ -37,12 +37,14 @@ namespace blender::gpu {
 struct GPUCapabilities {
   int max_texture_size = 0;
   int max_texture_layers = 0;
+  int max_texture_3d_size = 0;
   int max_textures = 0;
   int max_textures_vert = 0;
   int max_textures_geom = 0;
   int max_textures_frag = 0;
   bool mem_stats_support = false;
   bool shader_image_load_store_support = false;
+  bool shader_binary_support = false;
   /* OpenGL related workarounds. */
   bool mip_render_workaround = false;
   bool depth_blitting_workaround = false;
@@ -27,6 +27,7 @@
 
 #include "DNA_customdata_types.h"
 #include "DNA_image_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
@@ -1026,8 +1027,18 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
-        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    GPUShader *shader = (U.experimental.use_gpu_shader_cache) ?
+                            GPU_shader_create_cached(pass->vertexcode,
+                                                     pass->fragmentcode,
+                                                     pass->geometrycode,
+                                                     pass->defines,
+                                                     shname) :
+                            GPU_shader_create(pass->vertexcode,
+                                              pass->fragmentcode,
+                                              pass->geometrycode,
+                                              NULL,
+                                              pass->defines,
+                                              shname);
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
      * We need to make sure to count active samplers to avoid undefined behavior. */
@@ -51,6 +51,7 @@ void GPU_init(void)
 
   gpu_codegen_init();
   gpu_material_library_init();
+  gpu_shader_binary_cache_init();
 
   gpu_batch_init();
 
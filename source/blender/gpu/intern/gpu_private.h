@@ -28,6 +28,9 @@ extern "C" {
 void gpu_pbvh_init(void);
 void gpu_pbvh_exit(void);
 
+/* gpu_shader.cc */
+void gpu_shader_binary_cache_init(void);
+
 #ifdef __cplusplus
 }
 #endif
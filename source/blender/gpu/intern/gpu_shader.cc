@@ -24,6 +24,8 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_dynstr.h"
+#include "BLI_fileops.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
 #include "BLI_path_util.h"
@@ -45,7 +47,9 @@
 #include "GPU_uniform_buffer.h"
 
 #include "gpu_backend.hh"
+#include "gpu_capabilities_private.hh"
 #include "gpu_context_private.hh"
+#include "gpu_private.h"
 #include "gpu_shader_private.hh"
 
 #include "CLG_log.h"
@@ -280,20 +284,22 @@ static void standard_defines(Vector<const char *> &sources)
   }
 }
 
-GPUShader *GPU_shader_create_ex(const char *vertcode,
-                                const char *fragcode,
-                                const char *geomcode,
-                                const char *libcode,
-                                const char *defines,
-                                const eGPUShaderTFBType tf_type,
-                                const char **tf_names,
-                                const int tf_count,
-                                const char *shname)
+static GPUShader *shader_create_ex(const char *vertcode,
+                                   const char *fragcode,
+                                   const char *geomcode,
+                                   const char *libcode,
+                                   const char *defines,
+                                   const eGPUShaderTFBType tf_type,
+                                   const char **tf_names,
+                                   const int tf_count,
+                                   const char *shname,
+                                   const bool binary_retrievable)
 {
   /* At least a vertex shader and a fragment shader are required. */
   BLI_assert((fragcode != nullptr) && (vertcode != nullptr));
 
   Shader *shader = GPUBackend::get()->shader_alloc(shname);
+  shader->binary_retrievable = binary_retrievable;
 
   if (vertcode) {
     Vector<const char *> sources;
@@ -355,6 +361,20 @@ GPUShader *GPU_shader_create_ex(const char *vertcode,
   return wrap(shader);
 }
 
+GPUShader *GPU_shader_create_ex(const char *vertcode,
+                                const char *fragcode,
+                                const char *geomcode,
+                                const char *libcode,
+                                const char *defines,
+                                const eGPUShaderTFBType tf_type,
+                                const char **tf_names,
+                                const int tf_count,
+                                const char *shname)
+{
+  return shader_create_ex(
+      vertcode, fragcode, geomcode, libcode, defines, tf_type, tf_names, tf_count, shname, false);
+}
+
 void GPU_shader_free(GPUShader *shader)
 {
   delete unwrap(shader);
@@ -362,6 +382,151 @@ void GPU_shader_free(GPUShader *shader)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are stored on disk, keyed by a hash of their sources and of the GPU and driver
+ * identification. Following sessions then skip the compilation of shaders they have already seen.
+ * \{ */
+
+#define SHADER_BINARY_CACHE_VERSION 1
+
+struct ShaderBinaryCacheHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t format;
+  uint32_t binary_len;
+};
+
+/* Resolved once on the main thread, the #BKE_appdir functions use static buffers. */
+static char shader_binary_cache_dir[FILE_MAX] = "";
+
+void gpu_shader_binary_cache_init(void)
+{
+  const char *dir = BKE_appdir_folder_id_user_notest(BLENDER_USER_DATAFILES, "gpu_shader_cache");
+  BLI_strncpy(shader_binary_cache_dir, dir ? dir : "", sizeof(shader_binary_cache_dir));
+}
+
+static bool shader_binary_cache_filepath(const char *vertcode,
+                                         const char *fragcode,
+                                         const char *geomcode,
+                                         const char *defines,
+                                         char r_filepath[FILE_MAX])
+{
+  if (!GCaps.shader_binary_support || shader_binary_cache_dir[0] == '\0') {
+    return false;
+  }
+  /* The platform key contains the vendor, renderer and driver version. */
+  const char *strings[] = {GPU_platform_support_level_key(), vertcode, geomcode, fragcode, defines};
+  /* Two hashes with different seeds, to make collisions between different sources negligible. */
+  uint32_t hash[2];
+  for (int i = 0; i < ARRAY_SIZE(hash); i++) {
+    BLI_HashMurmur2A mm2;
+    BLI_hash_mm2a_init(&mm2, i);
+    for (const char *str : strings) {
+      /* Include the terminator so that the boundaries between sources are part of the key. */
+      str = (str != nullptr) ? str : "";
+      BLI_hash_mm2a_add(&mm2, (const uchar *)str, strlen(str) + 1);
+    }
+    hash[i] = BLI_hash_mm2a_end(&mm2);
+  }
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%08x%08x.bin", hash[0], hash[1]);
+  BLI_join_dirfile(r_filepath, FILE_MAX, shader_binary_cache_dir, filename);
+  return true;
+}
+
+static bool shader_binary_cache_read(Shader *shader, const char *filepath)
+{
+  size_t file_len = 0;
+  uint8_t *file_data = (uint8_t *)BLI_file_read_binary_as_mem(filepath, 0, &file_len);
+  if (file_data == nullptr) {
+    return false;
+  }
+  bool success = false;
+  const ShaderBinaryCacheHeader *header = (const ShaderBinaryCacheHeader *)file_data;
+  if (file_len > sizeof(*header) && memcmp(header->magic, "BGSC", 4) == 0 &&
+      header->version == SHADER_BINARY_CACHE_VERSION &&
+      header->binary_len == file_len - sizeof(*header)) {
+    success = shader->binary_load(header->format,
+                                  Span<uint8_t>(file_data + sizeof(*header), header->binary_len));
+  }
+  MEM_freeN(file_data);
+  return success;
+}
+
+static void shader_binary_cache_write(Shader *shader, const char *filepath)
+{
+  uint32_t format;
+  Vector<uint8_t> binary;
+  if (!shader->binary_get(&format, binary)) {
+    return;
+  }
+  if (!BLI_dir_create_recursive(shader_binary_cache_dir)) {
+    return;
+  }
+
+  ShaderBinaryCacheHeader header;
+  memcpy(header.magic, "BGSC", 4);
+  header.version = SHADER_BINARY_CACHE_VERSION;
+  header.format = format;
+  header.binary_len = binary.size();
+
+  /* Write to a temporary file first, so that an interrupted write never leaves a truncated
+   * binary behind. Another session might have written the same file meanwhile, which is fine. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s@", filepath);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+                       (fwrite(binary.data(), binary.size(), 1, file) == 1);
+  fclose(file);
+  if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/**
+ * Same as #GPU_shader_create, but the linked program is read from the cache on disk when the same
+ * sources were already compiled on this GPU and driver, and written to it otherwise.
+ */
+GPUShader *GPU_shader_create_cached(const char *vertcode,
+                                    const char *fragcode,
+                                    const char *geomcode,
+                                    const char *defines,
+                                    const char *shname)
+{
+  char filepath[FILE_MAX];
+  if (!shader_binary_cache_filepath(vertcode, fragcode, geomcode, defines, filepath)) {
+    return GPU_shader_create(vertcode, fragcode, geomcode, nullptr, defines, shname);
+  }
+
+  Shader *shader = GPUBackend::get()->shader_alloc(shname);
+  if (shader_binary_cache_read(shader, filepath)) {
+    return wrap(shader);
+  }
+  delete shader;
+
+  GPUShader *result = shader_create_ex(vertcode,
+                                       fragcode,
+                                       geomcode,
+                                       nullptr,
+                                       defines,
+                                       GPU_SHADER_TFB_NONE,
+                                       nullptr,
+                                       0,
+                                       shname,
+                                       true);
+  if (result != nullptr) {
+    shader_binary_cache_write(unwrap(result), filepath);
+  }
+  return result;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Creation utils
  * \{ */
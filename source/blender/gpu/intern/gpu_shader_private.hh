@@ -21,6 +21,7 @@
 #pragma once
 
 #include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "GPU_shader.h"
 #include "gpu_shader_interface.hh"
@@ -37,6 +38,8 @@ class Shader {
  public:
   /** Uniform & attribute locations for shader. */
   ShaderInterface *interface = nullptr;
+  /** Set before #finalize when the program binary is going to be retrieved by #binary_get. */
+  bool binary_retrievable = false;
 
  protected:
   /** For debugging purpose. */
@@ -51,6 +54,12 @@ class Shader {
   virtual void fragment_shader_from_glsl(MutableSpan<const char *> sources) = 0;
   virtual bool finalize(void) = 0;
 
+  /* Program binaries, used by the shader cache on disk. The format is implementation specific.
+   * #binary_load replaces the compilation of the shader stages and #finalize, return false if the
+   * binary is rejected (e.g: after a driver update). */
+  virtual bool binary_get(uint32_t *r_format, Vector<uint8_t> &r_binary) = 0;
+  virtual bool binary_load(uint32_t format, Span<uint8_t> binary) = 0;
+
   virtual void transform_feedback_names_set(Span<const char *> name_list,
                                             const eGPUShaderTFBType geom_type) = 0;
   virtual bool transform_feedback_enable(GPUVertBuf *) = 0;
@@ -323,6 +323,11 @@ void GPU_viewport_active_view_set(GPUViewport *viewport, int view)
   gpu_viewport_framebuffer_view_set(viewport, view);
 }
 
+int GPU_viewport_active_view_get(GPUViewport *viewport)
+{
+  return viewport->active_view;
+}
+
 void *GPU_viewport_framebuffer_list_get(GPUViewport *viewport)
 {
   return viewport->fbl;
@@ -1032,6 +1037,9 @@ void GPU_viewport_free(GPUViewport *viewport)
   if (viewport->vmempool.obattrs_ubo_pool != NULL) {
     DRW_uniform_attrs_pool_free(viewport->vmempool.obattrs_ubo_pool);
   }
+  for (int i = 0; i < ARRAY_SIZE(viewport->vmempool.occlusion); i++) {
+    DRW_occlusion_buffer_free(viewport->vmempool.occlusion[i]);
+  }
 
   for (int i = 0; i < viewport->vmempool.ubo_len; i++) {
     GPU_uniformbuf_free(viewport->vmempool.matrices_ubo[i]);
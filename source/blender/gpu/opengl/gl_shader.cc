@@ -178,6 +178,10 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (binary_retrievable) {
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -195,6 +199,42 @@ bool GLShader::finalize()
   return true;
 }
 
+bool GLShader::binary_get(uint32_t *r_format, Vector<uint8_t> &r_binary)
+{
+  GLint binary_len = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return false;
+  }
+  r_binary.resize(binary_len);
+
+  GLsizei written_len = 0;
+  GLenum format = 0;
+  glGetProgramBinary(shader_program_, binary_len, &written_len, &format, r_binary.data());
+  if (written_len <= 0) {
+    return false;
+  }
+  r_binary.resize(written_len);
+  *r_format = format;
+  return true;
+}
+
+bool GLShader::binary_load(uint32_t format, Span<uint8_t> binary)
+{
+  glProgramBinary(shader_program_, format, binary.data(), binary.size());
+
+  GLint status;
+  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+  if (!status) {
+    return false;
+  }
+
+  /* Uniform values are not part of the binary, the interface sets the bindings again. */
+  interface = new GLShaderInterface(shader_program_);
+
+  return true;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -58,6 +58,9 @@ class GLShader : public Shader {
   void fragment_shader_from_glsl(MutableSpan<const char *> sources) override;
   bool finalize(void) override;
 
+  bool binary_get(uint32_t *r_format, Vector<uint8_t> &r_binary) override;
+  bool binary_load(uint32_t format, Span<uint8_t> binary) override;
+
   void transform_feedback_names_set(Span<const char *> name_list,
                                     const eGPUShaderTFBType geom_type) override;
   bool transform_feedback_enable(GPUVertBuf *buf) override;
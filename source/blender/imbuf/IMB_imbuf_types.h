@@ -172,6 +172,10 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Decode at half or quarter resolution, for formats that can do so while decoding. Other
+   * formats ignore these flags, the size of the loaded image tells whether they were used. */
+  IB_reduce_half = 1 << 19,
+  IB_reduce_quarter = 1 << 20,
 } eImBufFlags;
 
 /** \} */
@@ -55,6 +55,7 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -573,6 +574,21 @@ static int startffmpeg(struct anim *anim)
 
   pCodecCtx->workaround_bugs = 1;
 
+  /* Decoders only use one thread unless asked otherwise. */
+  if (pCodec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+    pCodecCtx->thread_count = 0;
+  }
+  else {
+    pCodecCtx->thread_count = BLI_system_thread_count();
+  }
+
+  if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
+    pCodecCtx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
+    pCodecCtx->thread_type = FF_THREAD_SLICE;
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -1045,6 +1061,26 @@ static int ffmpeg_seek_by_byte(AVFormatContext *pFormatCtx)
   return false;
 }
 
+/* Whether a seek to pts_to_search would restart decoding from a keyframe that comes before the
+ * next frame of the decoder. Decoding onwards from the current frame is cheaper then. Uses the
+ * index of the demuxer, so it only works for containers that have one. */
+static bool ffmpeg_seek_keyframe_is_decoded(struct anim *anim,
+                                            AVStream *v_st,
+                                            int64_t pts_to_search)
+{
+  /* Negative while nothing was decoded since the last seek. */
+  if (anim->next_pts < 0 || pts_to_search < anim->next_pts) {
+    return false;
+  }
+
+  const int index = av_index_search_timestamp(v_st, pts_to_search, AVSEEK_FLAG_BACKWARD);
+  if (index < 0) {
+    return false;
+  }
+
+  return v_st->index_entries[index].timestamp <= anim->next_pts;
+}
+
 static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Type tc)
 {
   int64_t pts_to_search = 0;
@@ -1120,6 +1156,12 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
     ffmpeg_decode_video_frame_scan(anim, pts_to_search);
   }
+  else if (position > anim->curposition + 1 && !tc_index &&
+           ffmpeg_seek_keyframe_is_decoded(anim, v_st, pts_to_search)) {
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: no keyframe before target, keep decoding\n");
+
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  }
   else if (position != anim->curposition + 1) {
     long long pos;
     int ret;
@@ -100,8 +100,33 @@ static float imbuf_linear_srgb_to_xyz[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Processors of display and color space transforms, creating them is expensive compared to
+ * applying them on small buffers, which happens on every redraw of a partially updated image.
+ * Items are owned by the cache, and only removed when not used by any #ColormanageProcessor. */
+#define PROCESSOR_CACHE_MAX 32
+
+typedef struct ColormanageProcessorCacheItem {
+  struct ColormanageProcessorCacheItem *next, *prev;
+
+  /* Empty destination color space for display transforms. */
+  char look[MAX_COLORSPACE_NAME];
+  char view[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  char from_colorspace[MAX_COLORSPACE_NAME];
+  char to_colorspace[MAX_COLORSPACE_NAME];
+  float exposure, gamma;
+
+  OCIO_ConstProcessorRcPtr *processor;
+  int users;
+} ColormanageProcessorCacheItem;
+
+/* Most recently used first, protected by processor_lock. */
+static ListBase global_processor_cache = {NULL, NULL};
+static int global_tot_processor_cache = 0;
+
 typedef struct ColormanageProcessor {
   OCIO_ConstProcessorRcPtr *processor;
+  ColormanageProcessorCacheItem *cache_item;
   CurveMapping *curve_mapping;
   bool is_data_result;
 } ColormanageProcessor;
@@ -602,6 +627,17 @@ static void colormanage_free_config(void)
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  /* free cached processors */
+  LISTBASE_FOREACH_MUTABLE (ColormanageProcessorCacheItem *, item, &global_processor_cache) {
+    BLI_assert(item->users == 0);
+    if (item->processor) {
+      OCIO_processorRelease(item->processor);
+    }
+    MEM_freeN(item);
+  }
+  BLI_listbase_clear(&global_processor_cache);
+  global_tot_processor_cache = 0;
+
   /* free color spaces */
   colorspace = global_colorspaces.first;
   while (colorspace) {
@@ -3809,6 +3845,87 @@ void IMB_partial_display_buffer_update_delayed(ImBuf *ibuf, int xmin, int ymin,
 /** \name Pixel Processor Functions
  * \{ */
 
+static bool processor_cache_item_matches(const ColormanageProcessorCacheItem *item,
+                                         const ColormanageProcessorCacheItem *key)
+{
+  return STREQ(item->look, key->look) && STREQ(item->view, key->view) &&
+         STREQ(item->display, key->display) &&
+         STREQ(item->from_colorspace, key->from_colorspace) &&
+         STREQ(item->to_colorspace, key->to_colorspace) && item->exposure == key->exposure &&
+         item->gamma == key->gamma;
+}
+
+/* Get the cached processor matching the key, creating it when needed. The processor stays valid
+ * until #processor_cache_release is called for the returned item. */
+static ColormanageProcessorCacheItem *processor_cache_acquire(
+    const ColormanageProcessorCacheItem *key)
+{
+  ColormanageProcessorCacheItem *item;
+
+  BLI_mutex_lock(&processor_lock);
+
+  for (item = global_processor_cache.first; item; item = item->next) {
+    if (processor_cache_item_matches(item, key)) {
+      break;
+    }
+  }
+
+  if (item) {
+    BLI_remlink(&global_processor_cache, item);
+  }
+  else {
+    item = MEM_dupallocN(key);
+    item->users = 0;
+
+    if (key->to_colorspace[0] != '\0') {
+      item->processor = create_colorspace_transform_processor(key->from_colorspace,
+                                                              key->to_colorspace);
+    }
+    else {
+      item->processor = create_display_buffer_processor(key->look,
+                                                        key->view,
+                                                        key->display,
+                                                        key->exposure,
+                                                        key->gamma,
+                                                        key->from_colorspace,
+                                                        false);
+    }
+
+    global_tot_processor_cache++;
+  }
+
+  BLI_addhead(&global_processor_cache, item);
+  item->users++;
+
+  /* Remove least recently used processors which are not in use. */
+  ColormanageProcessorCacheItem *item_iter = global_processor_cache.last;
+  while (item_iter && global_tot_processor_cache > PROCESSOR_CACHE_MAX) {
+    ColormanageProcessorCacheItem *item_prev = item_iter->prev;
+
+    if (item_iter->users == 0) {
+      if (item_iter->processor) {
+        OCIO_processorRelease(item_iter->processor);
+      }
+      BLI_freelinkN(&global_processor_cache, item_iter);
+      global_tot_processor_cache--;
+    }
+
+    item_iter = item_prev;
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+
+  return item;
+}
+
+static void processor_cache_release(ColormanageProcessorCacheItem *item)
+{
+  BLI_mutex_lock(&processor_lock);
+  BLI_assert(item->users > 0);
+  item->users--;
+  BLI_mutex_unlock(&processor_lock);
+}
+
 ColormanageProcessor *IMB_colormanagement_display_processor_new(
     const ColorManagedViewSettings *view_settings,
     const ColorManagedDisplaySettings *display_settings)
@@ -3833,13 +3950,16 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  cm_processor->processor = create_display_buffer_processor(applied_view_settings->look,
-                                                            applied_view_settings->view_transform,
-                                                            display_settings->display_device,
-                                                            applied_view_settings->exposure,
-                                                            applied_view_settings->gamma,
-                                                            global_role_scene_linear,
-                                                            false);
+  ColormanageProcessorCacheItem key = {NULL};
+  BLI_strncpy(key.look, applied_view_settings->look, sizeof(key.look));
+  BLI_strncpy(key.view, applied_view_settings->view_transform, sizeof(key.view));
+  BLI_strncpy(key.display, display_settings->display_device, sizeof(key.display));
+  BLI_strncpy(key.from_colorspace, global_role_scene_linear, sizeof(key.from_colorspace));
+  key.exposure = applied_view_settings->exposure;
+  key.gamma = applied_view_settings->gamma;
+
+  cm_processor->cache_item = processor_cache_acquire(&key);
+  cm_processor->processor = cm_processor->cache_item->processor;
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -3860,7 +3980,12 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
   color_space = colormanage_colorspace_get_named(to_colorspace);
   cm_processor->is_data_result = color_space->is_data;
 
-  cm_processor->processor = create_colorspace_transform_processor(from_colorspace, to_colorspace);
+  ColormanageProcessorCacheItem key = {NULL};
+  BLI_strncpy(key.from_colorspace, from_colorspace, sizeof(key.from_colorspace));
+  BLI_strncpy(key.to_colorspace, to_colorspace, sizeof(key.to_colorspace));
+
+  cm_processor->cache_item = processor_cache_acquire(&key);
+  cm_processor->processor = cm_processor->cache_item->processor;
 
   return cm_processor;
 }
@@ -3986,8 +4111,8 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->processor) {
-    OCIO_processorRelease(cm_processor->processor);
+  if (cm_processor->cache_item) {
+    processor_cache_release(cm_processor->cache_item);
   }
 
   MEM_freeN(cm_processor);
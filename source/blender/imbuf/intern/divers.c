@@ -884,16 +884,25 @@ void IMB_buffer_float_premultiply(float *buf, int width, int height)
 /** \name Alter Saturation
  * \{ */
 
-void IMB_saturation(ImBuf *ibuf, float sat)
+typedef struct SaturationThreadData {
+  ImBuf *ibuf;
+  float sat;
+} SaturationThreadData;
+
+static void imb_saturation_thread_do(void *data_v, int start_scanline, int num_scanlines)
 {
+  SaturationThreadData *data = (SaturationThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+  const float sat = data->sat;
+  const size_t offset = ((size_t)start_scanline) * ibuf->x * 4;
+  const size_t pixels_num = ((size_t)num_scanlines) * ibuf->x;
   size_t i;
-  unsigned char *rct = (unsigned char *)ibuf->rect;
-  float *rct_fl = ibuf->rect_float;
   float hsv[3];
 
-  if (rct) {
+  if (ibuf->rect) {
+    unsigned char *rct = (unsigned char *)ibuf->rect + offset;
     float rgb[3];
-    for (i = ((size_t)ibuf->x) * ibuf->y; i > 0; i--, rct += 4) {
+    for (i = pixels_num; i > 0; i--, rct += 4) {
       rgb_uchar_to_float(rgb, rct);
       rgb_to_hsv_v(rgb, hsv);
       hsv_to_rgb(hsv[0], hsv[1] * sat, hsv[2], rgb, rgb + 1, rgb + 2);
@@ -901,12 +910,27 @@ void IMB_saturation(ImBuf *ibuf, float sat)
     }
   }
 
-  if (rct_fl) {
-    for (i = ((size_t)ibuf->x) * ibuf->y; i > 0; i--, rct_fl += 4) {
+  if (ibuf->rect_float) {
+    float *rct_fl = ibuf->rect_float + offset;
+    for (i = pixels_num; i > 0; i--, rct_fl += 4) {
       rgb_to_hsv_v(rct_fl, hsv);
       hsv_to_rgb(hsv[0], hsv[1] * sat, hsv[2], rct_fl, rct_fl + 1, rct_fl + 2);
     }
   }
 }
 
+void IMB_saturation(ImBuf *ibuf, float sat)
+{
+  SaturationThreadData data;
+  data.ibuf = ibuf;
+  data.sat = sat;
+
+  if (((size_t)ibuf->x) * ibuf->y < 64 * 64) {
+    imb_saturation_thread_do(&data, 0, ibuf->y);
+  }
+  else {
+    IMB_processor_apply_threaded_scanlines(ibuf->y, imb_saturation_thread_do, &data);
+  }
+}
+
 /** \} */
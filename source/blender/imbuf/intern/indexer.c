@@ -29,6 +29,8 @@
 #include "BLI_ghash.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
 #  include "BLI_winstuff.h"
@@ -780,6 +782,20 @@ static IndexBuildContext *index_ffmpeg_create_context(struct anim *anim,
 
   context->iCodecCtx->workaround_bugs = 1;
 
+  if (context->iCodec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+    context->iCodecCtx->thread_count = 0;
+  }
+  else {
+    context->iCodecCtx->thread_count = BLI_system_thread_count();
+  }
+
+  if (context->iCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
+    context->iCodecCtx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (context->iCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
+    context->iCodecCtx->thread_type = FF_THREAD_SLICE;
+  }
+
   if (avcodec_open2(context->iCodecCtx, context->iCodec, NULL) < 0) {
     avformat_close_input(&context->iFormatCtx);
     MEM_freeN(context);
@@ -839,6 +855,20 @@ static void index_rebuild_ffmpeg_finish(FFmpegIndexBuilderContext *context, int
   MEM_freeN(context);
 }
 
+typedef struct ProxyOutputTaskData {
+  FFmpegIndexBuilderContext *context;
+  AVFrame *in_frame;
+} ProxyOutputTaskData;
+
+static void index_rebuild_ffmpeg_proxy_output_task(void *__restrict userdata,
+                                                   const int i,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProxyOutputTaskData *data = userdata;
+
+  add_to_proxy_output_ffmpeg(data->context->proxy_ctx[i], data->in_frame);
+}
+
 static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *context,
                                                     AVPacket *curr_packet,
                                                     AVFrame *in_frame)
@@ -848,9 +878,17 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *c
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(context->iFormatCtx, in_frame);
 
-  for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
-  }
+  /* Every proxy size has its own scaler, encoder and output file, so they can all be written
+   * at the same time. */
+  ProxyOutputTaskData data = {
+      .context = context,
+      .in_frame = in_frame,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, context->num_proxy_sizes, &data, index_rebuild_ffmpeg_proxy_output_task, &settings);
 
   if (!context->start_pts_set) {
     context->start_pts = pts;
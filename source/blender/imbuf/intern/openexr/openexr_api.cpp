@@ -78,6 +78,7 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 }
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -329,6 +330,78 @@ static half float_to_half_safe(const float value)
   return half(clamp_f(value, -HALF_MAX, HALF_MAX));
 }
 
+/* Conversion of the image to half floats before saving, rows are converted in parallel. While
+ * OpenEXR compresses in parallel, the conversion would otherwise be done by a single thread. */
+
+struct ExrSaveHalfData {
+  const ImBuf *ibuf;
+  RGBAZ *pixels;
+};
+
+static void imb_save_openexr_half_row(void *__restrict userdata,
+                                      const int y,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ExrSaveHalfData *data = (const ExrSaveHalfData *)userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int channels = ibuf->channels;
+  const int width = ibuf->x;
+  /* Rows are stored starting with the top one. */
+  RGBAZ *to = data->pixels + (size_t)(ibuf->y - 1 - y) * width;
+
+  if (ibuf->rect_float) {
+    const float *from = ibuf->rect_float + (size_t)channels * y * width;
+
+    for (int j = width; j > 0; j--) {
+      to->r = float_to_half_safe(from[0]);
+      to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
+      to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
+      to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
+      to++;
+      from += channels;
+    }
+  }
+  else {
+    const unsigned char *from = (const unsigned char *)ibuf->rect + (size_t)4 * y * width;
+
+    for (int j = width; j > 0; j--) {
+      to->r = srgb_to_linearrgb((float)from[0] / 255.0f);
+      to->g = srgb_to_linearrgb((float)from[1] / 255.0f);
+      to->b = srgb_to_linearrgb((float)from[2] / 255.0f);
+      to->a = channels >= 4 ? (float)from[3] / 255.0f : 1.0f;
+      to++;
+      from += 4;
+    }
+  }
+}
+
+struct ExrHalfChannel {
+  const float *rect;
+  int xstride;
+  half *rect_half;
+};
+
+struct ExrWriteHalfData {
+  std::vector<ExrHalfChannel> channels;
+  size_t width;
+};
+
+static void imb_exr_write_half_row(void *__restrict userdata,
+                                   const int y,
+                                   const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ExrWriteHalfData *data = (const ExrWriteHalfData *)userdata;
+  const size_t offset = (size_t)y * data->width;
+
+  for (const ExrHalfChannel &channel : data->channels) {
+    const float *rect = channel.rect + offset * channel.xstride;
+    half *cur = channel.rect_half + offset;
+    for (size_t i = 0; i < data->width; i++) {
+      cur[i] = float_to_half_safe(rect[i * channel.xstride]);
+    }
+  }
+}
+
 extern "C" {
 
 /**
@@ -470,38 +543,14 @@ static bool imb_save_openexr_half(ImBuf *ibuf, const char *name, const int flags
                                sizeof(float),
                                sizeof(float) * -width));
     }
-    if (ibuf->rect_float) {
-      float *from;
+    ExrSaveHalfData data;
+    data.ibuf = ibuf;
+    data.pixels = to;
 
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = ibuf->rect_float + channels * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = float_to_half_safe(from[0]);
-          to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
-          to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
-          to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
-          to++;
-          from += channels;
-        }
-      }
-    }
-    else {
-      unsigned char *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = (unsigned char *)ibuf->rect + 4 * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = srgb_to_linearrgb((float)from[0] / 255.0f);
-          to->g = srgb_to_linearrgb((float)from[1] / 255.0f);
-          to->b = srgb_to_linearrgb((float)from[2] / 255.0f);
-          to->a = channels >= 4 ? (float)from[3] / 255.0f : 1.0f;
-          to++;
-          from += 4;
-        }
-      }
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 16;
+    BLI_task_parallel_range(0, height, &data, imb_save_openexr_half_row, &settings);
 
     exr_printf("OpenEXR-save: Writing OpenEXR file of height %d.\n", height);
 
@@ -1115,14 +1164,14 @@ void IMB_exr_write_channels(void *handle)
       current_rect_half = rect_half;
     }
 
+    ExrWriteHalfData half_data;
+    half_data.width = (size_t)data->width;
+
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scanline, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
+        /* Converted below. */
+        half_data.channels.push_back({echan->rect, echan->xstride, current_rect_half});
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -1139,6 +1188,13 @@ void IMB_exr_write_channels(void *handle)
       }
     }
 
+    if (!half_data.channels.empty()) {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 16;
+      BLI_task_parallel_range(0, data->height, &half_data, imb_exr_write_half_row, &settings);
+    }
+
     data->ofile->setFrameBuffer(frameBuffer);
     try {
       data->ofile->writePixels(data->height);
@@ -372,34 +372,28 @@ MINLINE void premul_ushort_to_straight_uchar(unsigned char *result, const unsign
   }
 }
 
-/* result in ibuf2, scaling should be done correctly */
-void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
+typedef struct OneHalfThreadData {
+  const ImBuf *ibuf1;
+  ImBuf *ibuf2;
+  bool do_rect, do_float;
+} OneHalfThreadData;
+
+/* Lines are rows of the half size image. */
+static void onehalf_thread_do(void *data_v, int start_scanline, int num_scanlines)
 {
+  const OneHalfThreadData *data = (const OneHalfThreadData *)data_v;
+  const ImBuf *ibuf1 = data->ibuf1;
+  ImBuf *ibuf2 = data->ibuf2;
   int x, y;
-  const short do_rect = (ibuf1->rect != NULL);
-  const short do_float = (ibuf1->rect_float != NULL) && (ibuf2->rect_float != NULL);
-
-  if (do_rect && (ibuf2->rect == NULL)) {
-    imb_addrectImBuf(ibuf2);
-  }
-
-  if (ibuf1->x <= 1) {
-    imb_half_y_no_alloc(ibuf2, ibuf1);
-    return;
-  }
-  if (ibuf1->y <= 1) {
-    imb_half_x_no_alloc(ibuf2, ibuf1);
-    return;
-  }
-
-  if (do_rect) {
-    unsigned char *cp1, *cp2, *dest;
 
-    cp1 = (unsigned char *)ibuf1->rect;
-    dest = (unsigned char *)ibuf2->rect;
+  if (data->do_rect) {
+    const unsigned char *cp1, *cp2;
+    unsigned char *dest;
 
-    for (y = ibuf2->y; y > 0; y--) {
+    for (y = start_scanline; y < start_scanline + num_scanlines; y++) {
+      cp1 = (unsigned char *)ibuf1->rect + ((size_t)ibuf1->x * y * 8);
       cp2 = cp1 + (ibuf1->x << 2);
+      dest = (unsigned char *)ibuf2->rect + ((size_t)ibuf2->x * y * 4);
       for (x = ibuf2->x; x > 0; x--) {
         unsigned short p1i[8], p2i[8], desti[4];
 
@@ -419,20 +413,17 @@ void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
         cp2 += 8;
         dest += 4;
       }
-      cp1 = cp2;
-      if (ibuf1->x & 1) {
-        cp1 += 4;
-      }
     }
   }
 
-  if (do_float) {
-    float *p1f, *p2f, *destf;
+  if (data->do_float) {
+    const float *p1f, *p2f;
+    float *destf;
 
-    p1f = ibuf1->rect_float;
-    destf = ibuf2->rect_float;
-    for (y = ibuf2->y; y > 0; y--) {
+    for (y = start_scanline; y < start_scanline + num_scanlines; y++) {
+      p1f = ibuf1->rect_float + ((size_t)ibuf1->x * y * 8);
       p2f = p1f + (ibuf1->x << 2);
+      destf = ibuf2->rect_float + ((size_t)ibuf2->x * y * 4);
       for (x = ibuf2->x; x > 0; x--) {
         destf[0] = 0.25f * (p1f[0] + p2f[0] + p1f[4] + p2f[4]);
         destf[1] = 0.25f * (p1f[1] + p2f[1] + p1f[5] + p2f[5]);
@@ -442,14 +433,40 @@ void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
         p2f += 8;
         destf += 4;
       }
-      p1f = p2f;
-      if (ibuf1->x & 1) {
-        p1f += 4;
-      }
     }
   }
 }
 
+/* result in ibuf2, scaling should be done correctly */
+void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
+{
+  OneHalfThreadData data;
+  data.ibuf1 = ibuf1;
+  data.ibuf2 = ibuf2;
+  data.do_rect = (ibuf1->rect != NULL);
+  data.do_float = (ibuf1->rect_float != NULL) && (ibuf2->rect_float != NULL);
+
+  if (data.do_rect && (ibuf2->rect == NULL)) {
+    imb_addrectImBuf(ibuf2);
+  }
+
+  if (ibuf1->x <= 1) {
+    imb_half_y_no_alloc(ibuf2, ibuf1);
+    return;
+  }
+  if (ibuf1->y <= 1) {
+    imb_half_x_no_alloc(ibuf2, ibuf1);
+    return;
+  }
+
+  if (((size_t)ibuf2->x) * ibuf2->y < 64 * 64) {
+    onehalf_thread_do(&data, 0, ibuf2->y);
+  }
+  else {
+    IMB_processor_apply_threaded_scanlines(ibuf2->y, onehalf_thread_do, &data);
+  }
+}
+
 ImBuf *IMB_onehalf(struct ImBuf *ibuf1)
 {
   struct ImBuf *ibuf2;
@@ -908,54 +925,62 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* Rows or columns of the image are filtered independently of each other, split them between
+ * threads unless the image is too small for it to be worth it. */
+static void scale_apply_lines(int total_lines,
+                              size_t pixels_num,
+                              ScanlineThreadFunc do_thread,
+                              void *custom_data)
 {
-  const int do_rect = (ibuf->rect != NULL);
-  const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  if (pixels_num < 64 * 64) {
+    do_thread(custom_data, 0, total_lines);
+  }
+  else {
+    IMB_processor_apply_threaded_scanlines(total_lines, do_thread, custom_data);
+  }
+}
+
+typedef struct ScaleDownThreadData {
+  const ImBuf *ibuf;
+  uchar *newrect;
+  float *newrectf;
+  int newx, newy;
+  float add;
+} ScaleDownThreadData;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
+/* Lines are rows of the image. */
+static void scaledownx_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  const ScaleDownThreadData *data = (const ScaleDownThreadData *)data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int do_rect = (data->newrect != NULL);
+  const int do_float = (data->newrectf != NULL);
+  const int newx = data->newx;
+  const float add = data->add;
+
+  uchar *rect, *newrect;
+  float *rectf, *newrectf;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
   int x, y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
+  rectf = newrectf = NULL;
+  rect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
+  for (y = start_scanline; y < start_scanline + num_scanlines; y++) {
+    const size_t offset = (size_t)ibuf->x * y * 4;
+    const size_t newoffset = (size_t)newx * y * 4;
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
-    if (_newrect == NULL) {
-      return ibuf;
+    if (do_rect) {
+      rect = (uchar *)ibuf->rect + offset;
+      newrect = data->newrect + newoffset;
     }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
+    if (do_float) {
+      rectf = ibuf->rect_float + offset;
+      newrectf = data->newrectf + newoffset;
     }
-  }
-
-  add = (ibuf->x - 0.01) / newx;
 
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
-  }
-
-  for (y = ibuf->y; y > 0; y--) {
     sample = 0.0f;
     val[0] = val[1] = val[2] = val[3] = 0.0f;
     valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
@@ -1027,75 +1052,90 @@ static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 
       sample -= 1.0f;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    /* see bug T26502. */
+    BLI_assert(!do_rect || (size_t)(rect - (uchar *)ibuf->rect) == offset + ibuf->x * 4);
+    BLI_assert(!do_float || (size_t)(rectf - ibuf->rect_float) == offset + ibuf->x * 4);
   }
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->x = newx;
-  return ibuf;
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
-
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  ScaleDownThreadData data = {NULL};
 
   if (!do_rect && !do_float) {
     return ibuf;
   }
 
+  data.ibuf = ibuf;
+  data.newx = newx;
+
   if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
+    if (data.newrect == NULL) {
       return ibuf;
     }
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return ibuf;
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+  data.add = (ibuf->x - 0.01) / newx;
+
+  scale_apply_lines(ibuf->y, (size_t)ibuf->x * ibuf->y, scaledownx_thread_do, &data);
+
+  if (do_rect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)data.newrect;
+  }
+  if (do_float) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = data.newrectf;
+  }
+
+  ibuf->x = newx;
+  return ibuf;
+}
+
+/* Lines are columns of the image. */
+static void scaledowny_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  const ScaleDownThreadData *data = (const ScaleDownThreadData *)data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int do_rect = (data->newrect != NULL);
+  const int do_float = (data->newrectf != NULL);
+  const int newy = data->newy;
+  const int skipx = 4 * ibuf->x;
+  const float add = data->add;
+
+  uchar *rect, *newrect;
+  float *rectf, *newrectf;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int x, y;
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
+  rectf = newrectf = NULL;
+  rect = newrect = NULL;
+  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
+  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+
+  for (x = start_scanline * 4; x < (start_scanline + num_scanlines) * 4; x += 4) {
     if (do_rect) {
       rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
+      newrect = data->newrect + x;
     }
     if (do_float) {
       rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+      newrectf = data->newrectf + x;
     }
 
     sample = 0.0f;
@@ -1169,23 +1209,56 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 
       sample -= 1.0f;
     }
+
+    /* see bug T26502. */
+    BLI_assert(!do_rect || (size_t)(rect - (uchar *)ibuf->rect) == (size_t)skipx * ibuf->y + x);
+    BLI_assert(!do_float || (size_t)(rectf - ibuf->rect_float) == (size_t)skipx * ibuf->y + x);
+  }
+}
+
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
+  ScaleDownThreadData data = {NULL};
+
+  if (!do_rect && !do_float) {
+    return ibuf;
+  }
+
+  data.ibuf = ibuf;
+  data.newy = newy;
+
+  if (do_rect) {
+    data.newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
+    if (data.newrect == NULL) {
+      return ibuf;
+    }
+  }
+  if (do_float) {
+    data.newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
+      }
+      return ibuf;
+    }
   }
 
+  data.add = (ibuf->y - 0.01) / newy;
+
+  scale_apply_lines(ibuf->x, (size_t)ibuf->x * ibuf->y, scaledowny_thread_do, &data);
+
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
+    ibuf->rect = (unsigned int *)data.newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = data.newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->y = newy;
   return ibuf;
@@ -1661,23 +1734,57 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastThreadData {
+  const ImBuf *ibuf;
+  unsigned int *newrect;
+  struct imbufRGBA *newrectf;
+  int newx;
+  size_t stepx, stepy;
+} ScaleFastThreadData;
+
+/* Lines are rows of the scaled image. */
+static void scalefast_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  const ScaleFastThreadData *data = (const ScaleFastThreadData *)data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const size_t stepx = data->stepx;
+  int x, y;
+
+  for (y = start_scanline; y < start_scanline + num_scanlines; y++) {
+    const size_t ofsy = 32768 + y * data->stepy;
+    size_t ofsx;
+
+    if (data->newrect) {
+      const unsigned int *rect = ibuf->rect + (ofsy >> 16) * ibuf->x;
+      unsigned int *newrect = data->newrect + (size_t)data->newx * y;
+      ofsx = 32768;
+
+      for (x = data->newx; x > 0; x--, ofsx += stepx) {
+        *newrect++ = rect[ofsx >> 16];
+      }
+    }
+
+    if (data->newrectf) {
+      const struct imbufRGBA *rectf = (const struct imbufRGBA *)ibuf->rect_float;
+      struct imbufRGBA *newrectf = data->newrectf + (size_t)data->newx * y;
+      rectf += (ofsy >> 16) * ibuf->x;
+      ofsx = 32768;
+
+      for (x = data->newx; x > 0; x--, ofsx += stepx) {
+        *newrectf++ = rectf[ofsx >> 16];
+      }
+    }
+  }
+}
+
 /**
  * Return true if \a ibuf is modified.
  */
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  unsigned int *_newrect = NULL;
+  struct imbufRGBA *_newrectf = NULL;
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1701,7 +1808,6 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
     if (_newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
@@ -1712,34 +1818,17 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
-  stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
-
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
+  ScaleFastThreadData data;
+  data.ibuf = ibuf;
+  data.newrect = _newrect;
+  data.newrectf = _newrectf;
+  data.newx = newx;
+  data.stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
+  data.stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
 
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  scale_apply_lines(newy, (size_t)newx * newy, scalefast_thread_do, &data);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -319,6 +319,44 @@ void IMB_thumb_makedirs(void)
 }
 
 /* create thumbnail for file and returns new imbuf for thumbnail */
+/**
+ * Load an image to make a thumbnail of size \a tsize from, decoding it at a reduced resolution
+ * when the file format can do so and the image is large enough. The size of the image in the
+ * file is returned, since it differs from the size of the loaded image in that case.
+ */
+static ImBuf *thumb_load_image(const char *file_path,
+                               const short tsize,
+                               int *r_width,
+                               int *r_height)
+{
+  int flags = IB_rect | IB_metadata;
+
+  /* Only JPEG supports decoding at a lower resolution, avoid reading the header twice for other
+   * formats. */
+  if (BLI_path_extension_check_n(file_path, ".jpg", ".jpeg", NULL)) {
+    ImBuf *ibuf_header = IMB_loadiffname(file_path, IB_test, NULL);
+    if (ibuf_header != NULL) {
+      const int size_max = MAX2(ibuf_header->x, ibuf_header->y);
+      if (size_max >= tsize * 4) {
+        flags |= IB_reduce_quarter;
+      }
+      else if (size_max >= tsize * 2) {
+        flags |= IB_reduce_half;
+      }
+      *r_width = ibuf_header->x;
+      *r_height = ibuf_header->y;
+      IMB_freeImBuf(ibuf_header);
+    }
+  }
+
+  ImBuf *img = IMB_loadiffname(file_path, flags, NULL);
+  if (img != NULL && (flags & (IB_reduce_half | IB_reduce_quarter)) == 0) {
+    *r_width = img->x;
+    *r_height = img->y;
+  }
+  return img;
+}
+
 static ImBuf *thumb_create_ex(const char *file_path,
                               const char *uri,
                               const char *thumb,
@@ -340,6 +378,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
   short tsize = 128;
   short ex, ey;
   float scaledx, scaledy;
+  int img_width = 0, img_height = 0;
   BLI_stat_t info;
 
   switch (size) {
@@ -384,7 +423,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
         if (img == NULL) {
           switch (source) {
             case THB_SOURCE_IMAGE:
-              img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+              img = thumb_load_image(file_path, tsize, &img_width, &img_height);
               break;
             case THB_SOURCE_BLEND:
               img = IMB_thumb_load_blend(file_path, blen_group, blen_id);
@@ -401,8 +440,12 @@ static ImBuf *thumb_create_ex(const char *file_path,
           if (BLI_stat(file_path, &info) != -1) {
             BLI_snprintf(mtime, sizeof(mtime), "%ld", (long int)info.st_mtime);
           }
-          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
-          BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          if (img_width == 0) {
+            img_width = img->x;
+            img_height = img->y;
+          }
+          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img_width);
+          BLI_snprintf(cheight, sizeof(cheight), "%d", img_height);
         }
       }
       else if (THB_SOURCE_MOVIE == source) {
@@ -592,9 +635,11 @@ ImBuf *IMB_thumb_manage(const char *org_path, ThumbSize size, ThumbSource source
   }
   if (thumbpath_from_uri(uri, thumb_path, sizeof(thumb_path), THB_FAIL)) {
     /* failure thumb exists, don't try recreating */
-    if (BLI_exists(thumb_path)) {
-      /* clear out of date fail case (note for blen IDs we use blender file itself here) */
-      if (BLI_file_older(thumb_path, file_path)) {
+    BLI_stat_t thumb_st;
+    if (BLI_stat(thumb_path, &thumb_st) != -1) {
+      /* clear out of date fail case (note for blen IDs we use blender file itself here),
+       * compared to the file stat above rather than stat-ing both files again */
+      if (thumb_st.st_mtime < st.st_mtime) {
         BLI_delete(thumb_path, false, false);
       }
       else {
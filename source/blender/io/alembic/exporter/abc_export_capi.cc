@@ -167,6 +167,7 @@ static void export_startjob(void *customdata,
     iter.iterate_and_write();
   }
 
+  iter.finish_deferred_writes();
   iter.release_writers();
 
   /* Finish up by going back to the keyframe that was current before we started. */
@@ -29,10 +29,13 @@
 #include "abc_writer_points.h"
 #include "abc_writer_transform.h"
 
+#include <map>
 #include <memory>
 #include <string>
 
 #include "BLI_assert.h"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph_query.h"
 
@@ -47,12 +50,91 @@ ABCHierarchyIterator::ABCHierarchyIterator(Depsgraph *depsgraph,
                                            const AlembicExportParams &params)
     : AbstractHierarchyIterator(depsgraph), abc_archive_(abc_archive), params_(params)
 {
+  deferred_write_pool_ = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_HIGH);
+}
+
+ABCHierarchyIterator::~ABCHierarchyIterator()
+{
+  BLI_task_pool_work_and_wait(deferred_write_pool_);
+  BLI_task_pool_free(deferred_write_pool_);
 }
 
 void ABCHierarchyIterator::iterate_and_write()
 {
+  /* The samples of the previous frame have to be written before anything else calls into
+   * Alembic. */
+  finish_deferred_writes();
+
   AbstractHierarchyIterator::iterate_and_write();
+  prepare_deferred_samples();
   update_archive_bounding_box();
+  start_deferred_writes();
+}
+
+void ABCHierarchyIterator::finish_deferred_writes()
+{
+  BLI_task_pool_work_and_wait(deferred_write_pool_);
+  deferred_writers_.clear();
+
+  if (deferred_write_exception_) {
+    std::exception_ptr exception = deferred_write_exception_;
+    deferred_write_exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void ABCHierarchyIterator::prepare_deferred_samples()
+{
+  /* Writers that read the same data are prepared on the same thread, as reading can update caches
+   * of the evaluated data, for example the loop normals of a mesh. */
+  std::vector<std::vector<ABCAbstractWriter *>> groups;
+  std::map<const void *, size_t> group_index_by_key;
+
+  for (WriterMap::value_type it : writers_) {
+    ABCAbstractWriter *abc_writer = static_cast<ABCAbstractWriter *>(it.second);
+    if (abc_writer == nullptr || !abc_writer->has_deferred_sample()) {
+      continue;
+    }
+    deferred_writers_.push_back(abc_writer);
+
+    auto group = group_index_by_key.emplace(abc_writer->deferred_data_key(), groups.size());
+    if (group.second) {
+      groups.emplace_back();
+    }
+    groups[group.first->second].push_back(abc_writer);
+  }
+
+  parallel_for(IndexRange(groups.size()), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      for (ABCAbstractWriter *abc_writer : groups[i]) {
+        abc_writer->prepare_deferred();
+      }
+    }
+  });
+}
+
+void ABCHierarchyIterator::start_deferred_writes()
+{
+  if (deferred_writers_.empty()) {
+    return;
+  }
+  BLI_task_pool_push(deferred_write_pool_, deferred_write_task, this, false, nullptr);
+}
+
+void ABCHierarchyIterator::deferred_write_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  ABCHierarchyIterator *iter = static_cast<ABCHierarchyIterator *>(taskdata);
+
+  /* Writers are visited in the order of their export path, so that the file does not depend on
+   * the scheduling of the threads. */
+  try {
+    for (ABCAbstractWriter *abc_writer : iter->deferred_writers_) {
+      abc_writer->write_deferred();
+    }
+  }
+  catch (...) {
+    iter->deferred_write_exception_ = std::current_exception();
+  }
 }
 
 void ABCHierarchyIterator::update_archive_bounding_box()
@@ -90,6 +172,10 @@ bool ABCHierarchyIterator::mark_as_weak_export(const Object *object) const
 
 void ABCHierarchyIterator::release_writer(AbstractHierarchyWriter *writer)
 {
+  BLI_assert(deferred_writers_.empty() ||
+             !"finish_deferred_writes() should be called before release_writers()");
+
+  static_cast<ABCAbstractWriter *>(writer)->log_timings();
   delete writer;
 }
 
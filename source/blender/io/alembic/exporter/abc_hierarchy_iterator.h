@@ -23,13 +23,16 @@
 
 #include "IO_abstract_hierarchy_iterator.h"
 
+#include <exception>
 #include <string>
+#include <vector>
 
 #include <Alembic/Abc/OArchive.h>
 #include <Alembic/Abc/OObject.h>
 
 struct Depsgraph;
 struct Object;
+struct TaskPool;
 
 namespace blender::io::alembic {
 
@@ -51,12 +54,26 @@ class ABCHierarchyIterator : public AbstractHierarchyIterator {
   ABCArchive *abc_archive_;
   const AlembicExportParams &params_;
 
+  /* Background task pool that runs the Alembic writer thread. Alembic is not thread-safe, so the
+   * main thread only calls into Alembic when no deferred samples are being written. */
+  TaskPool *deferred_write_pool_;
+  std::vector<ABCAbstractWriter *> deferred_writers_;
+  std::exception_ptr deferred_write_exception_;
+
  public:
   ABCHierarchyIterator(Depsgraph *depsgraph,
                        ABCArchive *abc_archive_,
                        const AlembicExportParams &params);
+  virtual ~ABCHierarchyIterator();
 
+  /* Write the current frame. The deferred samples are still being written when this returns, so
+   * that the depsgraph can be evaluated for the next frame in the meantime. */
   virtual void iterate_and_write() override;
+
+  /* Wait for the deferred samples to be written, and re-throw the exception that writing them may
+   * have thrown. Must be called before release_writers(). */
+  void finish_deferred_writes();
+
   virtual std::string make_valid_name(const std::string &name) const override;
 
   Alembic::Abc::OObject get_alembic_object(const std::string &export_path) const;
@@ -86,6 +103,10 @@ class ABCHierarchyIterator : public AbstractHierarchyIterator {
   void update_archive_bounding_box();
   void update_bounding_box_recursive(Imath::Box3d &bounds, const HierarchyContext *context);
 
+  void prepare_deferred_samples();
+  void start_deferred_writes();
+  static void deferred_write_task(TaskPool *__restrict pool, void *taskdata);
+
   ABCAbstractWriter *create_data_writer_for_object_type(
       const HierarchyContext *context, const ABCWriterConstructorArgs &writer_args);
 };
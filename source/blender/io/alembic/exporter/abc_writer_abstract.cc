@@ -19,6 +19,8 @@
 #include "abc_writer_abstract.h"
 #include "abc_hierarchy_iterator.h"
 
+#include "BLI_assert.h"
+
 #include "BKE_animsys.h"
 #include "BKE_key.h"
 #include "BKE_object.h"
@@ -27,6 +29,8 @@
 
 #include "DEG_depsgraph.h"
 
+#include "PIL_time.h"
+
 #include <Alembic/AbcGeom/Visibility.h>
 
 #include "CLG_log.h"
@@ -41,7 +45,8 @@ ABCAbstractWriter::ABCAbstractWriter(const ABCWriterConstructorArgs &args)
     : args_(args),
       frame_has_been_written_(false),
       is_animated_(false),
-      timesample_index_(args_.abc_archive->time_sampling_index_shapes())
+      timesample_index_(args_.abc_archive->time_sampling_index_shapes()),
+      deferred_sample_pending_(false)
 {
 }
 
@@ -66,6 +71,8 @@ void ABCAbstractWriter::write(HierarchyContext &context)
     return;
   }
 
+  const double start_time = PIL_check_seconds_timer();
+
   do_write(context);
 
   if (custom_props_) {
@@ -73,6 +80,66 @@ void ABCAbstractWriter::write(HierarchyContext &context)
   }
 
   frame_has_been_written_ = true;
+
+  timings_.frames_num++;
+  timings_.write += PIL_check_seconds_timer() - start_time;
+}
+
+bool ABCAbstractWriter::has_deferred_sample() const
+{
+  return deferred_sample_pending_;
+}
+
+void ABCAbstractWriter::prepare_deferred()
+{
+  BLI_assert(deferred_sample_pending_);
+  const double start_time = PIL_check_seconds_timer();
+  do_prepare_deferred();
+  timings_.prepare_deferred += PIL_check_seconds_timer() - start_time;
+}
+
+void ABCAbstractWriter::write_deferred()
+{
+  BLI_assert(deferred_sample_pending_);
+  const double start_time = PIL_check_seconds_timer();
+  deferred_sample_pending_ = false;
+  do_write_deferred();
+  timings_.write_deferred += PIL_check_seconds_timer() - start_time;
+}
+
+const void *ABCAbstractWriter::deferred_data_key() const
+{
+  return this;
+}
+
+void ABCAbstractWriter::do_prepare_deferred()
+{
+  BLI_assert(!"Writers that defer their samples should implement do_prepare_deferred()");
+}
+
+void ABCAbstractWriter::do_write_deferred()
+{
+  BLI_assert(!"Writers that defer their samples should implement do_write_deferred()");
+}
+
+const ABCWriterTimings &ABCAbstractWriter::timings() const
+{
+  return timings_;
+}
+
+void ABCAbstractWriter::log_timings() const
+{
+  if (timings_.frames_num == 0) {
+    return;
+  }
+  CLOG_INFO(&LOG,
+            2,
+            "%s: %d frames, %.3f s writing, %.3f s extracting, %.3f s on the writer thread",
+            args_.abc_path.c_str(),
+            timings_.frames_num,
+            timings_.write,
+            timings_.prepare_deferred,
+            timings_.write_deferred);
 }
 
 void ABCAbstractWriter::ensure_custom_properties_exporter(const HierarchyContext &context)
@@ -33,6 +33,17 @@ struct Object;
 
 namespace blender::io::alembic {
 
+/* Time spent by a writer over all exported frames, in seconds. */
+struct ABCWriterTimings {
+  int frames_num = 0;
+  /* Time spent in write(), on the main thread. */
+  double write = 0.0;
+  /* Time spent extracting deferred samples on worker threads. */
+  double prepare_deferred = 0.0;
+  /* Time spent writing deferred samples on the Alembic writer thread. */
+  double write_deferred = 0.0;
+};
+
 class ABCAbstractWriter : public AbstractHierarchyWriter {
  protected:
   const ABCWriterConstructorArgs args_;
@@ -48,6 +59,11 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
   /* Optional writer for custom properties. */
   std::unique_ptr<CustomPropertiesExporter> custom_props_;
 
+  /* Set by do_write() when the sample of the current frame is deferred. */
+  bool deferred_sample_pending_;
+
+  ABCWriterTimings timings_;
+
  public:
   explicit ABCAbstractWriter(const ABCWriterConstructorArgs &args);
   virtual ~ABCAbstractWriter();
@@ -82,8 +98,29 @@ class ABCAbstractWriter : public AbstractHierarchyWriter {
    */
   virtual Alembic::Abc::OCompoundProperty abc_prop_for_custom_props() = 0;
 
+  /* Writers that spend most of their time extracting data from the evaluated depsgraph can defer
+   * writing a frame: do_write() then only records what it needs and sets
+   * deferred_sample_pending_. The hierarchy iterator calls prepare_deferred() for all pending
+   * writers in parallel, and write_deferred() on the Alembic writer thread while the depsgraph is
+   * evaluated for the next frame.
+   *
+   * prepare_deferred() may only read the evaluated data and must not call into Alembic,
+   * write_deferred() may only call into Alembic. */
+  bool has_deferred_sample() const;
+  void prepare_deferred();
+  void write_deferred();
+
+  /* Writers that return the same key share the data they read in prepare_deferred(), for
+   * example the evaluated mesh, and are prepared on the same thread. */
+  virtual const void *deferred_data_key() const;
+
+  const ABCWriterTimings &timings() const;
+  void log_timings() const;
+
  protected:
   virtual void do_write(HierarchyContext &context) = 0;
+  virtual void do_prepare_deferred();
+  virtual void do_write_deferred();
 
   virtual void update_bounding_box(Object *object);
 
@@ -84,7 +84,7 @@ static void get_loop_normals(struct Mesh *mesh,
                              bool has_flat_shaded_poly);
 
 ABCGenericMeshWriter::ABCGenericMeshWriter(const ABCWriterConstructorArgs &args)
-    : ABCAbstractWriter(args), is_subd_(false)
+    : ABCAbstractWriter(args), is_subd_(false), deferred_object_(nullptr), deferred_mesh_(nullptr)
 {
 }
 
@@ -133,6 +133,16 @@ Alembic::Abc::OCompoundProperty ABCGenericMeshWriter::abc_prop_for_custom_props(
   return abc_schema_prop_for_custom_props(abc_poly_mesh_schema_);
 }
 
+const void *ABCGenericMeshWriter::deferred_data_key() const
+{
+  return deferred_mesh_;
+}
+
+bool ABCGenericMeshWriter::supports_deferred_write() const
+{
+  return false;
+}
+
 bool ABCGenericMeshWriter::export_as_subdivision_surface(Object *ob_eval) const
 {
   ModifierData *md = static_cast<ModifierData *>(ob_eval->modifiers.last);
@@ -182,19 +192,18 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
-  if (args_.export_params->triangulate) {
-    const bool tag_only = false;
-    const int quad_method = args_.export_params->quad_method;
-    const int ngon_method = args_.export_params->ngon_method;
-
-    struct BMeshCreateParams bmcp = {false};
-    struct BMeshFromMeshParams bmfmp = {true, false, false, 0};
-    BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmcp, &bmfmp);
-
-    BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
+  if (frame_has_been_written_ && supports_deferred_write()) {
+    /* Only the first frame needs the mesh for writing UVs, face sets and custom data. The samples
+     * of the next frames are extracted in parallel with those of the other objects. */
+    BLI_assert(!needsfree);
+    deferred_object_ = object;
+    deferred_mesh_ = mesh;
+    deferred_sample_pending_ = true;
+    return;
+  }
 
-    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
-    BM_mesh_free(bm);
+  if (args_.export_params->triangulate) {
+    Mesh *triangulated_mesh = triangulate_mesh(mesh);
 
     if (needsfree) {
       free_export_mesh(mesh);
@@ -230,27 +239,128 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
   }
 }
 
+void ABCGenericMeshWriter::do_prepare_deferred()
+{
+  Mesh *mesh = deferred_mesh_;
+  if (args_.export_params->triangulate) {
+    mesh = triangulate_mesh(mesh);
+  }
+
+  get_sample_data(deferred_object_, mesh, deferred_data_);
+
+  if (mesh != deferred_mesh_) {
+    free_export_mesh(mesh);
+  }
+  deferred_object_ = nullptr;
+  deferred_mesh_ = nullptr;
+}
+
+void ABCGenericMeshWriter::do_write_deferred()
+{
+  /* The extracted data is kept, so that the next frame reuses its memory. */
+  if (is_subd_) {
+    abc_subdiv_schema_.set(get_subd_sample(deferred_data_));
+  }
+  else {
+    abc_poly_mesh_schema_.set(get_mesh_sample(deferred_data_));
+  }
+}
+
 void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
 {
   BKE_id_free(nullptr, mesh);
 }
 
-void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+Mesh *ABCGenericMeshWriter::triangulate_mesh(Mesh *mesh) const
+{
+  const bool tag_only = false;
+  const int quad_method = args_.export_params->quad_method;
+  const int ngon_method = args_.export_params->ngon_method;
+
+  struct BMeshCreateParams bmcp = {false};
+  struct BMeshFromMeshParams bmfmp = {true, false, false, 0};
+  BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmcp, &bmfmp);
+
+  BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
+
+  Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
+  BM_mesh_free(bm);
+
+  return triangulated_mesh;
+}
+
+void ABCGenericMeshWriter::get_sample_data(Object *object, Mesh *mesh, MeshSampleData &r_data)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<Imath::V3f> velocities;
   bool has_flat_shaded_poly = false;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_shaded_poly);
+  get_vertices(mesh, r_data.points);
+  get_topology(mesh, r_data.poly_verts, r_data.loop_counts, has_flat_shaded_poly);
+
+  if (is_subd_) {
+    get_creases(mesh, r_data.crease_indices, r_data.crease_lengths, r_data.crease_sharpness);
+  }
+  else {
+    if (args_.export_params->normals) {
+      get_loop_normals(mesh, r_data.normals, has_flat_shaded_poly);
+    }
+    if (liquid_sim_modifier_ != nullptr) {
+      get_velocities(mesh, r_data.velocities);
+    }
+  }
+
+  update_bounding_box(object);
+}
+
+OPolyMeshSchema::Sample ABCGenericMeshWriter::get_mesh_sample(const MeshSampleData &data) const
+{
+  OPolyMeshSchema::Sample mesh_sample(V3fArraySample(data.points),
+                                      Int32ArraySample(data.poly_verts),
+                                      Int32ArraySample(data.loop_counts));
+
+  if (args_.export_params->normals) {
+    ON3fGeomParam::Sample normals_sample;
+    if (!data.normals.empty()) {
+      normals_sample.setScope(kFacevaryingScope);
+      normals_sample.setVals(V3fArraySample(data.normals));
+    }
+
+    mesh_sample.setNormals(normals_sample);
+  }
+
+  if (liquid_sim_modifier_ != nullptr) {
+    mesh_sample.setVelocities(V3fArraySample(data.velocities));
+  }
+
+  mesh_sample.setSelfBounds(bounding_box_);
+  return mesh_sample;
+}
+
+OSubDSchema::Sample ABCGenericMeshWriter::get_subd_sample(const MeshSampleData &data) const
+{
+  OSubDSchema::Sample subdiv_sample(V3fArraySample(data.points),
+                                    Int32ArraySample(data.poly_verts),
+                                    Int32ArraySample(data.loop_counts));
+
+  if (!data.crease_indices.empty()) {
+    subdiv_sample.setCreaseIndices(Int32ArraySample(data.crease_indices));
+    subdiv_sample.setCreaseLengths(Int32ArraySample(data.crease_lengths));
+    subdiv_sample.setCreaseSharpnesses(FloatArraySample(data.crease_sharpness));
+  }
+
+  subdiv_sample.setSelfBounds(bounding_box_);
+  return subdiv_sample;
+}
+
+void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+{
+  MeshSampleData data;
+  get_sample_data(context.object, mesh, data);
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
   }
 
-  OPolyMeshSchema::Sample mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+  OPolyMeshSchema::Sample mesh_sample = get_mesh_sample(data);
 
   UVSample uvs_and_indices;
 
@@ -271,26 +381,6 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
         abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config, &mesh->ldata, CD_MLOOPUV);
   }
 
-  if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals, has_flat_shaded_poly);
-
-    ON3fGeomParam::Sample normals_sample;
-    if (!normals.empty()) {
-      normals_sample.setScope(kFacevaryingScope);
-      normals_sample.setVals(V3fArraySample(normals));
-    }
-
-    mesh_sample.setNormals(normals_sample);
-  }
-
-  if (liquid_sim_modifier_ != nullptr) {
-    get_velocities(mesh, velocities);
-    mesh_sample.setVelocities(V3fArraySample(velocities));
-  }
-
-  update_bounding_box(context.object);
-  mesh_sample.setSelfBounds(bounding_box_);
-
   abc_poly_mesh_schema_.set(mesh_sample);
 
   write_arb_geo_params(mesh);
@@ -298,22 +388,14 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *mesh)
 {
-  std::vector<float> crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<int32_t> crease_indices, crease_lengths;
-  bool has_flat_poly = false;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_poly);
-  get_creases(mesh, crease_indices, crease_lengths, crease_sharpness);
+  MeshSampleData data;
+  get_sample_data(context.object, mesh, data);
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_subdiv_schema_);
   }
 
-  OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+  OSubDSchema::Sample subdiv_sample = get_subd_sample(data);
 
   UVSample sample;
   if (!frame_has_been_written_ && args_.export_params->uvs) {
@@ -333,14 +415,6 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
         abc_subdiv_schema_.getArbGeomParams(), m_custom_data_config, &mesh->ldata, CD_MLOOPUV);
   }
 
-  if (!crease_indices.empty()) {
-    subdiv_sample.setCreaseIndices(Int32ArraySample(crease_indices));
-    subdiv_sample.setCreaseLengths(Int32ArraySample(crease_lengths));
-    subdiv_sample.setCreaseSharpnesses(FloatArraySample(crease_sharpness));
-  }
-
-  update_bounding_box(context.object);
-  subdiv_sample.setSelfBounds(bounding_box_);
   abc_subdiv_schema_.set(subdiv_sample);
 
   write_arb_geo_params(mesh);
@@ -557,4 +631,9 @@ Mesh *ABCMeshWriter::get_export_mesh(Object *object_eval, bool & /*r_needsfree*/
   return BKE_object_get_evaluated_mesh(object_eval);
 }
 
+bool ABCMeshWriter::supports_deferred_write() const
+{
+  return true;
+}
+
 }  // namespace blender::io::alembic
@@ -49,6 +49,21 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
 
   CDStreamConfig m_custom_data_config;
 
+  /* Data of a frame that changes over time, extracted from the evaluated mesh. */
+  struct MeshSampleData {
+    std::vector<Imath::V3f> points;
+    std::vector<int32_t> poly_verts, loop_counts;
+    std::vector<Imath::V3f> normals;
+    std::vector<Imath::V3f> velocities;
+    std::vector<int32_t> crease_indices, crease_lengths;
+    std::vector<float> crease_sharpness;
+  };
+
+  /* Evaluated data recorded by do_write() when the sample is deferred. */
+  Object *deferred_object_;
+  Mesh *deferred_mesh_;
+  MeshSampleData deferred_data_;
+
  public:
   explicit ABCGenericMeshWriter(const ABCWriterConstructorArgs &args);
   virtual ~ABCGenericMeshWriter();
@@ -56,10 +71,17 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual void create_alembic_objects(const HierarchyContext *context) override;
   virtual Alembic::Abc::OObject get_alembic_object() const override;
   Alembic::Abc::OCompoundProperty abc_prop_for_custom_props() override;
+  virtual const void *deferred_data_key() const override;
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
   virtual void do_write(HierarchyContext &context) override;
+  virtual void do_prepare_deferred() override;
+  virtual void do_write_deferred() override;
+
+  /* Return true when get_export_mesh() returns evaluated data without modifying or copying it, so
+   * that the extraction of the samples can be done in parallel. */
+  virtual bool supports_deferred_write() const;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
@@ -67,6 +89,11 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
  private:
+  Mesh *triangulate_mesh(Mesh *mesh) const;
+  void get_sample_data(Object *object, Mesh *mesh, MeshSampleData &r_data);
+  Alembic::AbcGeom::OPolyMeshSchema::Sample get_mesh_sample(const MeshSampleData &data) const;
+  Alembic::AbcGeom::OSubDSchema::Sample get_subd_sample(const MeshSampleData &data) const;
+
   void write_mesh(HierarchyContext &context, Mesh *mesh);
   void write_subd(HierarchyContext &context, Mesh *mesh);
   template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
@@ -87,6 +114,7 @@ class ABCMeshWriter : public ABCGenericMeshWriter {
 
  protected:
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
+  virtual bool supports_deferred_write() const override;
 };
 
 }  // namespace blender::io::alembic
@@ -27,11 +27,13 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "utfconv.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
 
 using Alembic::Abc::ErrorHandler;
@@ -41,6 +43,9 @@ using Alembic::Abc::kWrapExisting;
 
 namespace blender::io::alembic {
 
+/* More streams than threads reading at the same time are never used. */
+static const int max_streams_num = 16;
+
 static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams)
 {
@@ -82,16 +87,25 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   BLI_strncpy(abs_filename, filename, FILE_MAX);
   BLI_path_abs(abs_filename, BKE_main_blendfile_path(bmain));
 
+  const int streams_num = std::min(BLI_system_thread_count(), max_streams_num);
+  for (int i = 0; i < streams_num; i++) {
+    std::unique_ptr<std::ifstream> infile = std::make_unique<std::ifstream>();
 #ifdef WIN32
-  UTF16_ENCODE(abs_filename);
-  std::wstring wstr(abs_filename_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
-  UTF16_UN_ENCODE(abs_filename);
+    UTF16_ENCODE(abs_filename);
+    std::wstring wstr(abs_filename_16);
+    infile->open(wstr.c_str(), std::ios::in | std::ios::binary);
+    UTF16_UN_ENCODE(abs_filename);
 #else
-  m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+    infile->open(abs_filename, std::ios::in | std::ios::binary);
 #endif
 
-  m_streams.push_back(&m_infile);
+    /* The first stream is always used, so that open_archive() reports the error. */
+    if (i > 0 && !infile->is_open()) {
+      break;
+    }
+    m_streams.push_back(infile.get());
+    m_infiles.push_back(std::move(infile));
+  }
 
   m_archive = open_archive(abs_filename, m_streams);
 }
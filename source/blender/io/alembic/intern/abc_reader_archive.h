@@ -26,6 +26,7 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 
 #include <fstream>
+#include <memory>
 
 struct Main;
 
@@ -38,7 +39,9 @@ namespace blender::io::alembic {
 
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  /* Ogawa reads from any stream that is not used by another thread, so that objects can be read
+   * in parallel. All streams are handles to the same file. */
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
  public:
@@ -35,7 +35,9 @@
 #include "BLI_compiler_compat.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.h"
 
+#include "BKE_customdata.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -57,6 +59,7 @@ using Alembic::AbcGeom::IPolyMeshSchema;
 using Alembic::AbcGeom::ISampleSelector;
 using Alembic::AbcGeom::ISubD;
 using Alembic::AbcGeom::ISubDSchema;
+using Alembic::AbcGeom::index_t;
 using Alembic::AbcGeom::IV2fGeomParam;
 using Alembic::AbcGeom::kWrapExisting;
 using Alembic::AbcGeom::N3fArraySample;
@@ -125,6 +128,19 @@ struct AbcMeshData {
   UInt32ArraySamplePtr uvs_indices;
 };
 
+/* Polygons, loops and edges of a mesh sample in Blender's layout. */
+struct AbcMeshTopology {
+  std::vector<MPoly> mpolys;
+  std::vector<MLoop> mloops;
+  std::vector<MEdge> medges;
+
+  bool matches(const AbcMeshData &mesh_data) const
+  {
+    return mpolys.size() == mesh_data.face_counts->size() &&
+           mloops.size() == mesh_data.face_indices->size();
+  }
+};
+
 static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &positions,
                                const P3fArraySamplePtr &ceil_positions,
@@ -179,7 +195,10 @@ void read_mverts(MVert *mverts, const P3fArraySamplePtr positions, const N3fArra
   }
 }
 
-static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
+/* When r_topology is not null, the polygons, loops and edges are copied into it. */
+static void read_mpolys(CDStreamConfig &config,
+                        const AbcMeshData &mesh_data,
+                        AbcMeshTopology *r_topology)
 {
   MPoly *mpolys = config.mpoly;
   MLoop *mloops = config.mloop;
@@ -248,6 +267,85 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     }
     BKE_mesh_validate(config.mesh, true, true);
   }
+
+  if (r_topology != nullptr) {
+    Mesh *mesh = config.mesh;
+    if (seen_invalid_geometry) {
+      /* The validation changes the topology, don't reuse it. */
+      r_topology->mpolys.clear();
+      r_topology->mloops.clear();
+      r_topology->medges.clear();
+    }
+    else {
+      r_topology->mpolys.assign(mesh->mpoly, mesh->mpoly + mesh->totpoly);
+      r_topology->mloops.assign(mesh->mloop, mesh->mloop + mesh->totloop);
+      r_topology->medges.assign(mesh->medge, mesh->medge + mesh->totedge);
+    }
+  }
+}
+
+static void read_loop_uvs(CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  MLoopUV *mloopuvs = config.mloopuv;
+  const V2fArraySamplePtr &uvs = mesh_data.uvs;
+  const UInt32ArraySamplePtr &uvs_indices = mesh_data.uvs_indices;
+
+  if (!(mloopuvs && uvs && uvs_indices) ||
+      (uvs_indices->size() != mesh_data.face_indices->size())) {
+    return;
+  }
+
+  const size_t uvs_size = uvs->size();
+  const MPoly *mpolys = config.mpoly;
+
+  for (int i = 0; i < config.totpoly; i++) {
+    const MPoly &poly = mpolys[i];
+
+    /* NOTE: Alembic data is stored in the reverse order. */
+    unsigned int rev_loop_index = poly.loopstart + (poly.totloop - 1);
+    for (int f = 0; f < poly.totloop; f++, rev_loop_index--) {
+      const unsigned int uv_index = (*uvs_indices)[poly.loopstart + f];
+
+      /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+      if (uv_index >= uvs_size) {
+        continue;
+      }
+
+      MLoopUV &loopuv = mloopuvs[rev_loop_index];
+      loopuv.uv[0] = (*uvs)[uv_index][0];
+      loopuv.uv[1] = (*uvs)[uv_index][1];
+    }
+  }
+}
+
+/* Same as read_mpolys(), but copies the polygons, loops and edges of a previous sample with the
+ * same topology instead of computing them again. */
+static void read_mpolys_from_topology(CDStreamConfig &config,
+                                      const AbcMeshData &mesh_data,
+                                      const AbcMeshTopology &topology)
+{
+  Mesh *mesh = config.mesh;
+  MPoly *mpolys = config.mpoly;
+
+  for (size_t i = 0; i < topology.mpolys.size(); i++) {
+    mpolys[i].loopstart = topology.mpolys[i].loopstart;
+    mpolys[i].totloop = topology.mpolys[i].totloop;
+    mpolys[i].flag |= ME_SMOOTH;
+  }
+  std::copy(topology.mloops.begin(), topology.mloops.end(), config.mloop);
+
+  const int totedge = static_cast<int>(topology.medges.size());
+  MEdge *medges = static_cast<MEdge *>(MEM_malloc_arrayN(totedge, sizeof(MEdge), __func__));
+  std::copy(topology.medges.begin(), topology.medges.end(), medges);
+
+  /* Like BKE_mesh_calc_edges(), replace all edge data. */
+  CustomData_free(&mesh->edata, mesh->totedge);
+  CustomData_reset(&mesh->edata);
+  CustomData_add_layer(&mesh->edata, CD_MEDGE, CD_ASSIGN, medges, totedge);
+  mesh->totedge = totedge;
+  mesh->medge = medges;
+
+  read_loop_uvs(config, mesh_data);
 }
 
 static void process_no_normals(CDStreamConfig &config)
@@ -412,24 +510,24 @@ static void get_weight_and_index(CDStreamConfig &config,
   config.ceil_index = i1;
 }
 
+/* The weight and indices of config must have been set by get_weight_and_index(), ceil_sample is
+ * only used when the weight is not zero. When topology is not null, it is reused if it matches
+ * the sample, and updated otherwise. */
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
                              const ISampleSelector &selector,
-                             CDStreamConfig &config)
+                             const IPolyMeshSchema::Sample &sample,
+                             const IPolyMeshSchema::Sample &ceil_sample,
+                             CDStreamConfig &config,
+                             AbcMeshTopology *topology)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
   abc_mesh_data.positions = sample.getPositions();
 
-  get_weight_and_index(config, schema.getTimeSampling(), schema.getNumSamples());
-
   if (config.weight != 0.0f) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(config.ceil_index));
     abc_mesh_data.ceil_positions = ceil_sample.getPositions();
   }
 
@@ -442,7 +540,12 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
+    if (topology != nullptr && topology->matches(abc_mesh_data)) {
+      read_mpolys_from_topology(config, abc_mesh_data, *topology);
+    }
+    else {
+      read_mpolys(config, abc_mesh_data, topology);
+    }
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
@@ -473,7 +576,7 @@ CDStreamConfig get_config(Mesh *mesh, const bool use_vertex_interpolation)
 /* ************************************************************************** */
 
 AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
-    : AbcObjectReader(object, settings)
+    : AbcObjectReader(object, settings), m_prefetch_pool(nullptr), m_samples_first(0)
 {
   m_settings->read_flag |= MOD_MESHSEQ_READ_ALL;
 
@@ -481,6 +584,19 @@ AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
   m_schema = ipoly_mesh.getSchema();
 
   get_min_max_time(m_iobject, m_schema, m_min_time, m_max_time);
+
+  if (m_schema.valid() &&
+      m_schema.getTopologyVariance() != Alembic::AbcGeom::kHeterogenousTopology) {
+    m_topology = std::make_unique<AbcMeshTopology>();
+  }
+}
+
+AbcMeshReader::~AbcMeshReader()
+{
+  if (m_prefetch_pool != nullptr) {
+    BLI_task_pool_cancel(m_prefetch_pool);
+    BLI_task_pool_free(m_prefetch_pool);
+  }
 }
 
 bool AbcMeshReader::valid() const
@@ -597,7 +713,7 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -625,7 +741,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -692,7 +808,21 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  get_weight_and_index(config, m_schema.getTimeSampling(), m_schema.getNumSamples());
+
+  IPolyMeshSchema::Sample ceil_sample;
+  if (config.weight != 0.0f) {
+    ceil_sample = get_sample(ISampleSelector(config.ceil_index), false);
+  }
+
+  read_mesh_sample(m_iobject.getFullName(),
+                   &settings,
+                   m_schema,
+                   sample_sel,
+                   sample,
+                   ceil_sample,
+                   config,
+                   m_topology.get());
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -710,6 +840,115 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   return existing_mesh;
 }
 
+void AbcMeshReader::enable_sample_prefetch()
+{
+  if (m_prefetch_pool == nullptr && m_schema.valid() && m_schema.getNumSamples() > 1) {
+    m_prefetch_pool = BLI_task_pool_create(this, TASK_PRIORITY_LOW);
+  }
+}
+
+/* Number of samples following the requested one that are read in the background. */
+static const index_t prefetch_samples_num = 2;
+
+struct PrefetchTaskData {
+  index_t index;
+};
+
+/* Return the sample from the prefetched ones when possible. When update_window is true, the
+ * sample becomes the first of the samples being prefetched. */
+IPolyMeshSchema::Sample AbcMeshReader::get_sample(const ISampleSelector &sample_sel,
+                                                  const bool update_window)
+{
+  if (m_prefetch_pool == nullptr) {
+    return m_schema.getValue(sample_sel);
+  }
+
+  const index_t index = sample_sel.getIndex(m_schema.getTimeSampling(), m_schema.getNumSamples());
+  IPolyMeshSchema::Sample sample;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+    if (update_window) {
+      /* Samples from before the requested one are only used again when playback loops. */
+      m_samples_first = index;
+      for (auto it = m_samples.begin(); it != m_samples.end();) {
+        if (it->first < index || it->first > index + prefetch_samples_num) {
+          it = m_samples.erase(it);
+        }
+        else {
+          ++it;
+        }
+      }
+    }
+    auto it = m_samples.find(index);
+    if (it != m_samples.end()) {
+      sample = it->second;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    sample = m_schema.getValue(ISampleSelector(index));
+    if (update_window) {
+      /* Kept for the other reads of the same sample, topology_changed() and read_mesh() are
+       * usually both called. */
+      std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+      m_samples[index] = sample;
+    }
+  }
+
+  if (update_window) {
+    prefetch_samples(index);
+  }
+  return sample;
+}
+
+void AbcMeshReader::prefetch_samples(const index_t index)
+{
+  const index_t last_index = std::min(index + prefetch_samples_num,
+                                      static_cast<index_t>(m_schema.getNumSamples()) - 1);
+  std::vector<index_t> indices;
+  {
+    std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+    for (index_t i = index + 1; i <= last_index; i++) {
+      if (m_samples.count(i) == 0 && m_samples_pending.insert(i).second) {
+        indices.push_back(i);
+      }
+    }
+  }
+
+  /* Not pushed while locked, as the task runs immediately when threading is disabled. */
+  for (const index_t i : indices) {
+    PrefetchTaskData *task_data = static_cast<PrefetchTaskData *>(
+        MEM_mallocN(sizeof(PrefetchTaskData), __func__));
+    task_data->index = i;
+    BLI_task_pool_push(m_prefetch_pool, prefetch_sample_task, task_data, true, nullptr);
+  }
+}
+
+void AbcMeshReader::prefetch_sample_task(TaskPool *__restrict pool, void *taskdata)
+{
+  AbcMeshReader *reader = static_cast<AbcMeshReader *>(BLI_task_pool_user_data(pool));
+  const index_t index = static_cast<const PrefetchTaskData *>(taskdata)->index;
+
+  IPolyMeshSchema::Sample sample;
+  bool is_read = false;
+  try {
+    reader->m_schema.get(sample, ISampleSelector(index));
+    is_read = true;
+  }
+  catch (Alembic::Util::Exception & /*ex*/) {
+    /* The error is reported when the sample is requested. */
+  }
+
+  std::lock_guard<std::mutex> lock(reader->m_prefetch_mutex);
+  reader->m_samples_pending.erase(index);
+  if (is_read && index > reader->m_samples_first &&
+      index <= reader->m_samples_first + prefetch_samples_num) {
+    reader->m_samples[index] = sample;
+  }
+}
+
 void AbcMeshReader::assign_facesets_to_mpoly(const ISampleSelector &sample_sel,
                                              MPoly *mpoly,
                                              int totpoly,
@@ -812,7 +1051,7 @@ static void read_subd_sample(const std::string &iobject_full_name,
     /* Alembic's 'SubD' scheme is used to store subdivision surfaces, i.e. the pre-subdivision
      * mesh. Currently we don't add a subdivision modifier when we load such data. This code is
      * assuming that the subdivided surface should be smooth. */
-    read_mpolys(config, abc_mesh_data);
+    read_mpolys(config, abc_mesh_data, nullptr);
     process_no_normals(config);
   }
 
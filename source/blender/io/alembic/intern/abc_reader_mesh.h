@@ -22,17 +22,38 @@
 #include "abc_customdata.h"
 #include "abc_reader_object.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
 struct Mesh;
+struct TaskPool;
 
 namespace blender::io::alembic {
 
+struct AbcMeshTopology;
+
 class AbcMeshReader : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
 
   CDStreamConfig m_mesh_data;
 
+  /* Polygons, loops and edges of the last sample read, reused by the next samples when the
+   * topology of the schema doesn't change over time. Null otherwise. */
+  std::unique_ptr<AbcMeshTopology> m_topology;
+
+  /* Samples read ahead by the tasks of the prefetch pool, see enable_sample_prefetch(). Only the
+   * last requested sample and the ones following it are kept. */
+  TaskPool *m_prefetch_pool;
+  std::mutex m_prefetch_mutex;
+  std::map<Alembic::AbcGeom::index_t, Alembic::AbcGeom::IPolyMeshSchema::Sample> m_samples;
+  std::set<Alembic::AbcGeom::index_t> m_samples_pending;
+  Alembic::AbcGeom::index_t m_samples_first;
+
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
+  ~AbcMeshReader() override;
 
   bool valid() const override;
   bool accepts_object_type(const Alembic::AbcCoreAbstract::ObjectHeader &alembic_header,
@@ -46,8 +67,14 @@ class AbcMeshReader : public AbcObjectReader {
                          const char **err_str) override;
   bool topology_changed(Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
+  void enable_sample_prefetch() override;
 
  private:
+  Alembic::AbcGeom::IPolyMeshSchema::Sample get_sample(
+      const Alembic::Abc::ISampleSelector &sample_sel, bool update_window = true);
+  void prefetch_samples(Alembic::AbcGeom::index_t index);
+  static void prefetch_sample_task(TaskPool *__restrict pool, void *taskdata);
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
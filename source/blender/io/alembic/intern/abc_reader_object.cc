@@ -184,6 +184,10 @@ bool AbcObjectReader::topology_changed(Mesh * /*existing_mesh*/,
   return false;
 }
 
+void AbcObjectReader::enable_sample_prefetch()
+{
+}
+
 void AbcObjectReader::setupObjectTransform(const float time)
 {
   bool is_constant = false;
@@ -146,6 +146,10 @@ class AbcObjectReader {
   virtual bool topology_changed(Mesh *existing_mesh,
                                 const Alembic::Abc::ISampleSelector &sample_sel);
 
+  /** Start reading the next samples in the background whenever a sample is read, for readers
+   * that are used to stream animated data. */
+  virtual void enable_sample_prefetch();
+
   /** Reads the object matrix and sets up an object transform if animated. */
   void setupObjectTransform(const float time);
 
@@ -18,6 +18,7 @@
  * \ingroup collada
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "COLLADABUUtils.h"
@@ -29,6 +30,10 @@
 
 #include "DNA_meshdata_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_array_parallel.h"
+#include "BLI_map.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
@@ -63,7 +68,7 @@ void GeometryExporter::operator()(Object *ob)
 
   std::string geom_id = get_geometry_id(ob, use_instantiation);
   std::vector<Normal> nor;
-  std::vector<BCPolygonNormalsIndices> norind;
+  std::vector<unsigned int> loop_normal_indices;
 
   /* Skip if linked geometry was already exported from another reference */
   if (use_instantiation && exportedGeometry.find(geom_id) != exportedGeometry.end()) {
@@ -77,7 +82,7 @@ void GeometryExporter::operator()(Object *ob)
 
   bool has_color = (bool)CustomData_has_layer(&me->fdata, CD_MCOL);
 
-  create_normals(nor, norind, me);
+  create_normals(nor, loop_normal_indices, me);
 
   /* openMesh(geoId, geoName, meshId) */
   openMesh(geom_id, geom_name);
@@ -112,15 +117,7 @@ void GeometryExporter::operator()(Object *ob)
 
   /* Only create Polylists if number of faces > 0 */
   if (me->totface > 0) {
-    /* XXX slow */
-    if (ob->totcol) {
-      for (int a = 0; a < ob->totcol; a++) {
-        create_mesh_primitive_list(a, has_uvs, has_color, ob, me, geom_id, norind);
-      }
-    }
-    else {
-      create_mesh_primitive_list(0, has_uvs, has_color, ob, me, geom_id, norind);
-    }
+    create_mesh_primitive_lists(has_uvs, has_color, ob, me, geom_id, loop_normal_indices);
   }
 
   closeMesh();
@@ -147,7 +144,7 @@ void GeometryExporter::export_key_mesh(Object *ob, Mesh *me, KeyBlock *kb)
 {
   std::string geom_id = get_geometry_id(ob, false) + "_morph_" + translate_id(kb->name);
   std::vector<Normal> nor;
-  std::vector<BCPolygonNormalsIndices> norind;
+  std::vector<unsigned int> loop_normal_indices;
 
   if (exportedGeometry.find(geom_id) != exportedGeometry.end()) {
     return;
@@ -159,7 +156,7 @@ void GeometryExporter::export_key_mesh(Object *ob, Mesh *me, KeyBlock *kb)
 
   bool has_color = (bool)CustomData_has_layer(&me->fdata, CD_MCOL);
 
-  create_normals(nor, norind, me);
+  create_normals(nor, loop_normal_indices, me);
 
   // openMesh(geoId, geoName, meshId)
   openMesh(geom_id, geom_name);
@@ -193,15 +190,7 @@ void GeometryExporter::export_key_mesh(Object *ob, Mesh *me, KeyBlock *kb)
 
   // createLooseEdgeList(ob, me, geom_id, norind);
 
-  /* XXX slow */
-  if (ob->totcol) {
-    for (int a = 0; a < ob->totcol; a++) {
-      create_mesh_primitive_list(a, has_uvs, has_color, ob, me, geom_id, norind);
-    }
-  }
-  else {
-    create_mesh_primitive_list(0, has_uvs, has_color, ob, me, geom_id, norind);
-  }
+  create_mesh_primitive_lists(has_uvs, has_color, ob, me, geom_id, loop_normal_indices);
 
   closeMesh();
 
@@ -214,7 +203,7 @@ void GeometryExporter::createLooseEdgeList(Object *ob, Mesh *me, std::string &ge
   MEdge *medges = me->medge;
   int totedges = me->totedge;
   int edges_in_linelist = 0;
-  std::vector<unsigned int> edge_list;
+  std::vector<unsigned long> edge_list;
   int index;
 
   /* Find all loose edges in Mesh
@@ -224,8 +213,8 @@ void GeometryExporter::createLooseEdgeList(Object *ob, Mesh *me, std::string &ge
 
     if (edge->flag & ME_LOOSEEDGE) {
       edges_in_linelist += 1;
-      edge_list.push_back(edge->v1);
       edge_list.push_back(edge->v2);
+      edge_list.push_back(edge->v1);
     }
   }
 
@@ -244,11 +233,7 @@ void GeometryExporter::createLooseEdgeList(Object *ob, Mesh *me, std::string &ge
     til.push_back(input1);
 
     lines.prepareToAppendValues();
-
-    for (index = 0; index < edges_in_linelist; index++) {
-      lines.appendValues(edge_list[2 * index + 1]);
-      lines.appendValues(edge_list[2 * index]);
-    }
+    lines.appendValues(edge_list);
     lines.finish();
   }
 }
@@ -294,29 +279,6 @@ static COLLADASW::PrimitivesBase *create_primitive_list(bool is_triangulated,
   return primitive_list;
 }
 
-static bool collect_vertex_counts_per_poly(Mesh *me,
-                                           int material_index,
-                                           std::vector<unsigned long> &vcount_list)
-{
-  MPoly *mpolys = me->mpoly;
-  int totpolys = me->totpoly;
-  bool is_triangulated = true;
-
-  int i;
-  /* Expecting that p->mat_nr is always 0 if the mesh has no materials assigned */
-  for (i = 0; i < totpolys; i++) {
-    MPoly *p = &mpolys[i];
-    if (p->mat_nr == material_index) {
-      int vertex_count = p->totloop;
-      vcount_list.push_back(vertex_count);
-      if (vertex_count != 3) {
-        is_triangulated = false;
-      }
-    }
-  }
-  return is_triangulated;
-}
-
 std::string GeometryExporter::makeVertexColorSourceId(std::string &geom_id, char *layer_name)
 {
   std::string result = getIdBySemantics(geom_id, COLLADASW::InputSemantic::COLOR) + "-" +
@@ -324,24 +286,54 @@ std::string GeometryExporter::makeVertexColorSourceId(std::string &geom_id, char
   return result;
 }
 
+void GeometryExporter::create_mesh_primitive_lists(bool has_uvs,
+                                                   bool has_color,
+                                                   Object *ob,
+                                                   Mesh *me,
+                                                   std::string &geom_id,
+                                                   blender::Span<unsigned int> loop_normal_indices)
+{
+  /* Expecting that p->mat_nr is always 0 if the mesh has no materials assigned */
+  const int materials_num = std::max<int>(ob->totcol, 1);
+
+  blender::Array<int> material_indices(me->totpoly);
+  blender::parallel_for(blender::IndexRange(me->totpoly), 4096, [&](blender::IndexRange range) {
+    for (const int i : range) {
+      const int mat_nr = me->mpoly[i].mat_nr;
+      material_indices[i] = (mat_nr >= 0 && mat_nr < materials_num) ? mat_nr : -1;
+    }
+  });
+
+  blender::Array<int> material_offsets(materials_num + 1);
+  blender::Array<int> material_polys(me->totpoly);
+  BLI_array_group_indices_by_key(material_indices.data(),
+                                 me->totpoly,
+                                 materials_num,
+                                 material_offsets.data(),
+                                 material_polys.data());
+
+  for (int a = 0; a < materials_num; a++) {
+    const blender::Span<int> polys = material_polys.as_span().slice(
+        material_offsets[a], material_offsets[a + 1] - material_offsets[a]);
+    create_mesh_primitive_list(a, polys, has_uvs, has_color, ob, me, geom_id, loop_normal_indices);
+  }
+}
+
 /* powerful because it handles both cases when there is material and when there's not */
 void GeometryExporter::create_mesh_primitive_list(short material_index,
+                                                  blender::Span<int> polys,
                                                   bool has_uvs,
                                                   bool has_color,
                                                   Object *ob,
                                                   Mesh *me,
                                                   std::string &geom_id,
-                                                  std::vector<BCPolygonNormalsIndices> &norind)
+                                                  blender::Span<unsigned int> loop_normal_indices)
 {
 
   MPoly *mpolys = me->mpoly;
   MLoop *mloops = me->mloop;
-  int totpolys = me->totpoly;
-
-  std::vector<unsigned long> vcount_list;
 
-  bool is_triangulated = collect_vertex_counts_per_poly(me, material_index, vcount_list);
-  int polygon_count = vcount_list.size();
+  int polygon_count = polys.size();
 
   /* no faces using this material */
   if (polygon_count == 0) {
@@ -350,6 +342,21 @@ void GeometryExporter::create_mesh_primitive_list(short material_index,
     return;
   }
 
+  /* The vertex counts, and the offset of every polygon in the <p> values. */
+  std::vector<unsigned long> vcount_list(polygon_count);
+  blender::Array<int> value_offsets(polygon_count + 1);
+  bool is_triangulated = true;
+  for (int i = 0; i < polygon_count; i++) {
+    const int vertex_count = mpolys[polys[i]].totloop;
+    vcount_list[i] = vertex_count;
+    value_offsets[i] = vertex_count;
+    if (vertex_count != 3) {
+      is_triangulated = false;
+    }
+  }
+  value_offsets[polygon_count] = 0;
+  const int corners_num = BLI_array_exclusive_scan_i(value_offsets.data(), polygon_count + 1);
+
   Material *ma = ob->totcol ? BKE_object_material_get(ob, material_index + 1) : nullptr;
   COLLADASW::PrimitivesBase *primitive_list = create_primitive_list(is_triangulated, mSW);
 
@@ -409,34 +416,31 @@ void GeometryExporter::create_mesh_primitive_list(short material_index,
     }
   }
 
-  /* performs the actual writing */
-  prepareToAppendValues(is_triangulated, *primitive_list, vcount_list);
-
-  /* <p> */
-  int texindex = 0;
-  for (int i = 0; i < totpolys; i++) {
-    MPoly *p = &mpolys[i];
-    int loop_count = p->totloop;
-
-    if (p->mat_nr == material_index) {
-      MLoop *l = &mloops[p->loopstart];
-      BCPolygonNormalsIndices normal_indices = norind[i];
-
-      for (int j = 0; j < loop_count; j++) {
-        primitive_list->appendValues(l[j].v);
-        primitive_list->appendValues(normal_indices[j]);
+  /* The texture coordinates and colors are indexed by loop, like their sources. */
+  const int values_per_corner = 2 + int(has_uvs) + int(has_color);
+  std::vector<unsigned long> values((size_t)corners_num * values_per_corner);
+  blender::parallel_for(blender::IndexRange(polygon_count), 1024, [&](blender::IndexRange range) {
+    for (const int i : range) {
+      const MPoly *p = &mpolys[polys[i]];
+      unsigned long *value = &values[(size_t)value_offsets[i] * values_per_corner];
+      for (int loop = p->loopstart; loop < p->loopstart + p->totloop; loop++) {
+        *value++ = mloops[loop].v;
+        *value++ = loop_normal_indices[loop];
         if (has_uvs) {
-          primitive_list->appendValues(texindex + j);
+          *value++ = loop;
         }
-
         if (has_color) {
-          primitive_list->appendValues(texindex + j);
+          *value++ = loop;
         }
       }
     }
+  });
 
-    texindex += loop_count;
-  }
+  /* performs the actual writing */
+  prepareToAppendValues(is_triangulated, *primitive_list, vcount_list);
+
+  /* <p> */
+  primitive_list->appendValues(values);
 
   finish_and_delete_primitive_List(is_triangulated, primitive_list);
 }
@@ -462,21 +466,27 @@ void GeometryExporter::createVertsSource(std::string geom_id, Mesh *me)
   param.push_back("X");
   param.push_back("Y");
   param.push_back("Z");
+  std::vector<float> values((size_t)totverts * 3);
+  const bool apply_global_orientation = export_settings.get_apply_global_orientation();
+  Matrix global_mat;
+  export_settings.get_global_transform().get_matrix(global_mat, false, 6);
+  blender::parallel_for(blender::IndexRange(totverts), 4096, [&](blender::IndexRange range) {
+    for (const int i : range) {
+      float *co = &values[(size_t)i * 3];
+      if (apply_global_orientation) {
+        mul_v3_m4v3(co, global_mat, verts[i].co);
+      }
+      else {
+        copy_v3_v3(co, verts[i].co);
+      }
+    }
+  });
+
   /* main function, it creates <source id = "">, <float_array id = ""
    * count = ""> */
   source.prepareToAppendValues();
   /* appends data to <float_array> */
-  int i = 0;
-  for (i = 0; i < totverts; i++) {
-    Vector co;
-    if (export_settings.get_apply_global_orientation()) {
-      bc_add_global_transform(co, verts[i].co, export_settings.get_global_transform());
-    }
-    else {
-      copy_v3_v3(co, verts[i].co);
-    }
-    source.appendValues(co[0], co[1], co[2]);
-  }
+  source.appendValues(values);
 
   source.finish();
 }
@@ -513,17 +523,20 @@ void GeometryExporter::createVertexColorSource(std::string geom_id, Mesh *me)
     param.push_back("B");
     param.push_back("A");
 
-    source.prepareToAppendValues();
-
-    MPoly *mpoly;
-    int i;
-    for (i = 0, mpoly = me->mpoly; i < me->totpoly; i++, mpoly++) {
-      MLoopCol *mlc = mloopcol + mpoly->loopstart;
-      for (int j = 0; j < mpoly->totloop; j++, mlc++) {
-        source.appendValues(mlc->r / 255.0f, mlc->g / 255.0f, mlc->b / 255.0f, mlc->a / 255.0f);
+    std::vector<float> values((size_t)me->totloop * 4);
+    blender::parallel_for(blender::IndexRange(me->totloop), 4096, [&](blender::IndexRange range) {
+      for (const int i : range) {
+        const MLoopCol *mlc = &mloopcol[i];
+        float *color = &values[(size_t)i * 4];
+        color[0] = mlc->r / 255.0f;
+        color[1] = mlc->g / 255.0f;
+        color[2] = mlc->b / 255.0f;
+        color[3] = mlc->a / 255.0f;
       }
-    }
+    });
 
+    source.prepareToAppendValues();
+    source.appendValues(values);
     source.finish();
   }
 }
@@ -546,9 +559,7 @@ std::string GeometryExporter::makeTexcoordSourceId(std::string &geom_id,
 void GeometryExporter::createTexcoordsSource(std::string geom_id, Mesh *me)
 {
 
-  int totpoly = me->totpoly;
   int totuv = me->totloop;
-  MPoly *mpolys = me->mpoly;
 
   int num_layers = CustomData_number_of_layers(&me->ldata, CD_MLOOPUV);
 
@@ -572,16 +583,15 @@ void GeometryExporter::createTexcoordsSource(std::string geom_id, Mesh *me)
       param.push_back("S");
       param.push_back("T");
 
-      source.prepareToAppendValues();
-
-      for (int index = 0; index < totpoly; index++) {
-        MPoly *mpoly = mpolys + index;
-        MLoopUV *mloop = mloops + mpoly->loopstart;
-        for (int j = 0; j < mpoly->totloop; j++) {
-          source.appendValues(mloop[j].uv[0], mloop[j].uv[1]);
+      std::vector<float> values((size_t)totuv * 2);
+      blender::parallel_for(blender::IndexRange(totuv), 4096, [&](blender::IndexRange range) {
+        for (const int i : range) {
+          copy_v2_v2(&values[(size_t)i * 2], mloops[i].uv);
         }
-      }
+      });
 
+      source.prepareToAppendValues();
+      source.appendValues(values);
       source.finish();
     }
   }
@@ -593,6 +603,20 @@ bool operator<(const Normal &a, const Normal &b)
   return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.z < b.z)));
 }
 
+bool operator==(const Normal &a, const Normal &b)
+{
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+uint64_t Normal::hash() const
+{
+  /* Adding zero turns -0.0f into 0.0f, they compare equal so they must hash the same. */
+  const float co[3] = {x + 0.0f, y + 0.0f, z + 0.0f};
+  const uint32_t *bits = reinterpret_cast<const uint32_t *>(co);
+  return ((uint64_t)bits[0] * 435109) ^ ((uint64_t)bits[1] * 380867) ^
+         ((uint64_t)bits[2] * 1059217);
+}
+
 /* creates <source> for normals */
 void GeometryExporter::createNormalsSource(std::string geom_id, Mesh *me, std::vector<Normal> &nor)
 {
@@ -611,29 +635,33 @@ void GeometryExporter::createNormalsSource(std::string geom_id, Mesh *me, std::v
   param.push_back("Y");
   param.push_back("Z");
 
-  source.prepareToAppendValues();
-
-  std::vector<Normal>::iterator it;
-  for (it = nor.begin(); it != nor.end(); it++) {
-    Normal &n = *it;
-
-    Vector no{n.x, n.y, n.z};
-    if (export_settings.get_apply_global_orientation()) {
-      bc_add_global_transform(no, export_settings.get_global_transform());
+  std::vector<float> values(nor.size() * 3);
+  const bool apply_global_orientation = export_settings.get_apply_global_orientation();
+  Matrix global_mat;
+  export_settings.get_global_transform().get_matrix(global_mat, false, 6);
+  blender::parallel_for(blender::IndexRange(nor.size()), 4096, [&](blender::IndexRange range) {
+    for (const int i : range) {
+      const Normal &n = nor[i];
+      float *no = &values[(size_t)i * 3];
+      const float n_co[3] = {n.x, n.y, n.z};
+      if (apply_global_orientation) {
+        mul_v3_m4v3(no, global_mat, n_co);
+      }
+      else {
+        copy_v3_v3(no, n_co);
+      }
     }
-    source.appendValues(no[0], no[1], no[2]);
-  }
+  });
 
+  source.prepareToAppendValues();
+  source.appendValues(values);
   source.finish();
 }
 
 void GeometryExporter::create_normals(std::vector<Normal> &normals,
-                                      std::vector<BCPolygonNormalsIndices> &polygons_normals,
+                                      std::vector<unsigned int> &loop_normal_indices,
                                       Mesh *me)
 {
-  std::map<Normal, unsigned int> shared_normal_indices;
-  int last_normal_index = -1;
-
   MVert *verts = me->mvert;
   MLoop *mloops = me->mloop;
   float(*lnors)[3] = nullptr;
@@ -645,52 +673,60 @@ void GeometryExporter::create_normals(std::vector<Normal> &normals,
     use_custom_normals = true;
   }
 
-  for (int poly_index = 0; poly_index < me->totpoly; poly_index++) {
-    MPoly *mpoly = &me->mpoly[poly_index];
-    bool use_vertex_normals = use_custom_normals || mpoly->flag & ME_SMOOTH;
-
-    if (!use_vertex_normals) {
-      /* For flat faces use face normal as vertex normal: */
-
-      float vector[3];
-      BKE_mesh_calc_poly_normal(mpoly, mloops + mpoly->loopstart, verts, vector);
-
-      Normal n = {vector[0], vector[1], vector[2]};
-      normals.push_back(n);
-      last_normal_index++;
-    }
-
-    BCPolygonNormalsIndices poly_indices;
-    for (int loop_index = 0; loop_index < mpoly->totloop; loop_index++) {
-      unsigned int loop_idx = mpoly->loopstart + loop_index;
-      if (use_vertex_normals) {
-        float normalized[3];
+  /* Evaluate the normals of all polygons and loops in parallel. Flat polygons store their
+   * normal in their first loop. */
+  blender::Array<Normal> loop_normals(me->totloop);
+  blender::parallel_for(blender::IndexRange(me->totpoly), 1024, [&](blender::IndexRange range) {
+    for (const int poly_index : range) {
+      const MPoly *mpoly = &me->mpoly[poly_index];
+      const bool use_vertex_normals = use_custom_normals || mpoly->flag & ME_SMOOTH;
+      float normalized[3];
+
+      if (!use_vertex_normals) {
+        /* For flat faces use face normal as vertex normal: */
+        BKE_mesh_calc_poly_normal(mpoly, mloops + mpoly->loopstart, verts, normalized);
+        loop_normals[mpoly->loopstart] = {normalized[0], normalized[1], normalized[2]};
+        continue;
+      }
 
+      for (int loop_index = 0; loop_index < mpoly->totloop; loop_index++) {
+        const int loop_idx = mpoly->loopstart + loop_index;
         if (use_custom_normals) {
           normalize_v3_v3(normalized, lnors[loop_idx]);
         }
         else {
-          normal_short_to_float_v3(normalized, verts[mloops[loop_index].v].no);
+          normal_short_to_float_v3(normalized, verts[mloops[loop_idx].v].no);
           normalize_v3(normalized);
         }
-        Normal n = {normalized[0], normalized[1], normalized[2]};
-
-        if (shared_normal_indices.find(n) != shared_normal_indices.end()) {
-          poly_indices.add_index(shared_normal_indices[n]);
-        }
-        else {
-          last_normal_index++;
-          poly_indices.add_index(last_normal_index);
-          shared_normal_indices[n] = last_normal_index;
-          normals.push_back(n);
-        }
-      }
-      else {
-        poly_indices.add_index(last_normal_index);
+        loop_normals[loop_idx] = {normalized[0], normalized[1], normalized[2]};
       }
     }
+  });
+
+  /* Number the normals in polygon order, smooth normals are shared. */
+  blender::Map<Normal, unsigned int> shared_normal_indices;
+  loop_normal_indices.resize(me->totloop);
+
+  for (int poly_index = 0; poly_index < me->totpoly; poly_index++) {
+    const MPoly *mpoly = &me->mpoly[poly_index];
+    const bool use_vertex_normals = use_custom_normals || mpoly->flag & ME_SMOOTH;
+
+    if (!use_vertex_normals) {
+      const unsigned int normal_index = normals.size();
+      normals.push_back(loop_normals[mpoly->loopstart]);
+      std::fill_n(&loop_normal_indices[mpoly->loopstart], mpoly->totloop, normal_index);
+      continue;
+    }
 
-    polygons_normals.push_back(poly_indices);
+    for (int loop_idx = mpoly->loopstart; loop_idx < mpoly->loopstart + mpoly->totloop;
+         loop_idx++) {
+      const Normal &n = loop_normals[loop_idx];
+      const unsigned int normal_index = shared_normal_indices.lookup_or_add(n, normals.size());
+      if (normal_index == normals.size()) {
+        normals.push_back(n);
+      }
+      loop_normal_indices[loop_idx] = normal_index;
+    }
   }
 }
 
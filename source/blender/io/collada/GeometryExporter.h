@@ -28,6 +28,8 @@
 #include "COLLADASWLibraryGeometries.h"
 #include "COLLADASWStreamWriter.h"
 
+#include "BLI_span.hh"
+
 #include "DNA_key_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
@@ -44,10 +46,14 @@ class Normal {
   float y;
   float z;
 
+  uint64_t hash() const;
+
   friend bool operator<(const Normal &, const Normal &);
+  friend bool operator==(const Normal &, const Normal &);
 };
 
 bool operator<(const Normal &, const Normal &);
+bool operator==(const Normal &, const Normal &);
 
 /* TODO: optimize UV sets by making indexed list with duplicates removed */
 class GeometryExporter : COLLADASW::LibraryGeometries {
@@ -74,12 +80,21 @@ class GeometryExporter : COLLADASW::LibraryGeometries {
 
   /* powerful because it handles both cases when there is material and when there's not */
   void create_mesh_primitive_list(short material_index,
+                                  blender::Span<int> polys,
                                   bool has_uvs,
                                   bool has_color,
                                   Object *ob,
                                   Mesh *me,
                                   std::string &geom_id,
-                                  std::vector<BCPolygonNormalsIndices> &norind);
+                                  blender::Span<unsigned int> loop_normal_indices);
+
+  /* writes the primitive lists of all materials */
+  void create_mesh_primitive_lists(bool has_uvs,
+                                   bool has_color,
+                                   Object *ob,
+                                   Mesh *me,
+                                   std::string &geom_id,
+                                   blender::Span<unsigned int> loop_normal_indices);
 
   /* creates <source> for positions */
   void createVertsSource(std::string geom_id, Mesh *me);
@@ -96,7 +111,7 @@ class GeometryExporter : COLLADASW::LibraryGeometries {
   void createNormalsSource(std::string geom_id, Mesh *me, std::vector<Normal> &nor);
 
   void create_normals(std::vector<Normal> &nor,
-                      std::vector<BCPolygonNormalsIndices> &polygons_normals,
+                      std::vector<unsigned int> &loop_normal_indices,
                       Mesh *me);
 
   std::string getIdBySemantics(std::string geom_id,
@@ -38,10 +38,12 @@
 #include "BKE_mesh.h"
 #include "BKE_object.h"
 
+#include "BLI_array.hh"
 #include "BLI_edgehash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "ArmatureImporter.h"
 #include "MeshImporter.h"
@@ -348,12 +350,12 @@ void MeshImporter::read_vertices(COLLADAFW::Mesh *mesh, Mesh *me)
   me->totvert = pos.getFloatValues()->getCount() / stride;
   me->mvert = (MVert *)CustomData_add_layer(&me->vdata, CD_MVERT, CD_CALLOC, nullptr, me->totvert);
 
-  MVert *mvert;
-  int i;
-
-  for (i = 0, mvert = me->mvert; i < me->totvert; i++, mvert++) {
-    get_vector(mvert->co, pos, i, stride);
-  }
+  MVert *mvert = me->mvert;
+  blender::parallel_for(blender::IndexRange(me->totvert), 4096, [&](blender::IndexRange range) {
+    for (const int i : range) {
+      get_vector(mvert[i].co, pos, i, stride);
+    }
+  });
 }
 
 /* =====================================================================
@@ -726,6 +728,36 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
       COLLADAFW::IndexListArray &index_list_array_uvcoord = mp->getUVCoordIndicesArray();
       COLLADAFW::IndexListArray &index_list_array_vcolor = mp->getColorIndicesArray();
 
+      /* Look the layers up by name once per primitive, not for every polygon. */
+      blender::Array<MLoopUV *> mloopuvs(index_list_array_uvcoord.getCount());
+      for (unsigned int uvset_index = 0; uvset_index < index_list_array_uvcoord.getCount();
+           uvset_index++) {
+        COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
+        mloopuvs[uvset_index] = (MLoopUV *)CustomData_get_layer_named(
+            &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
+        if (mloopuvs[uvset_index] == nullptr) {
+          fprintf(stderr,
+                  "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
+                  me->id.name,
+                  index_list.getName().c_str());
+        }
+      }
+
+      const int vcolor_count = mp->hasColorIndices() ? index_list_array_vcolor.getCount() : 0;
+      blender::Array<MLoopCol *> mloopcols(vcolor_count);
+      for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
+        COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
+        COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
+        mloopcols[vcolor_index] = (MLoopCol *)CustomData_get_layer_named(
+            &me->ldata, CD_MLOOPCOL, colname.c_str());
+        if (mloopcols[vcolor_index] == nullptr) {
+          fprintf(stderr,
+                  "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
+                  me->id.name,
+                  color_index_list.getName().c_str());
+        }
+      }
+
       int invalid_loop_holes = 0;
       for (unsigned int j = 0; j < prim_totpoly; j++) {
 
@@ -743,17 +775,8 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
         for (unsigned int uvset_index = 0; uvset_index < index_list_array_uvcoord.getCount();
              uvset_index++) {
           /* get mtface by face index and uv set index */
-          COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
-          MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_named(
-              &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
-          if (mloopuv == nullptr) {
-            fprintf(stderr,
-                    "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
-                    me->id.name,
-                    index_list.getName().c_str());
-          }
-          else {
-            set_face_uv(mloopuv + loop_index,
+          if (mloopuvs[uvset_index] != nullptr) {
+            set_face_uv(mloopuvs[uvset_index] + loop_index,
                         uvs,
                         start_index,
                         *index_list_array_uvcoord[uvset_index],
@@ -767,24 +790,11 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
           }
         }
 
-        if (mp->hasColorIndices()) {
-          int vcolor_count = index_list_array_vcolor.getCount();
-
-          for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
-
+        for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
+          if (mloopcols[vcolor_index] != nullptr) {
             COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
-            COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
-            MLoopCol *mloopcol = (MLoopCol *)CustomData_get_layer_named(
-                &me->ldata, CD_MLOOPCOL, colname.c_str());
-            if (mloopcol == nullptr) {
-              fprintf(stderr,
-                      "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
-                      me->id.name,
-                      color_index_list.getName().c_str());
-            }
-            else {
-              set_vcol(mloopcol + loop_index, vcol, start_index, color_index_list, vcount);
-            }
+            set_vcol(
+                mloopcols[vcolor_index] + loop_index, vcol, start_index, color_index_list, vcount);
           }
         }
 
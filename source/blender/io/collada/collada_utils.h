@@ -291,21 +291,6 @@ class ColladaBaseNodes {
   }
 };
 
-class BCPolygonNormalsIndices {
-  std::vector<unsigned int> normal_indices;
-
- public:
-  void add_index(unsigned int index)
-  {
-    normal_indices.push_back(index);
-  }
-
-  unsigned int operator[](unsigned int i)
-  {
-    return normal_indices[i];
-  }
-};
-
 class BoneExtended {
 
  private:
@@ -0,0 +1,60 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_utility_mixins.hh"
+
+struct BLI_mmap_file;
+
+namespace blender::io {
+
+/* Read-only view of the contents of a file, through memory-mapped IO when possible, so that the
+ * importers can parse large files without copying them first. Files that cannot be mapped are
+ * read in memory. */
+class MappedFile : NonCopyable, NonMovable {
+ private:
+  int file_ = -1;
+  BLI_mmap_file *mmap_file_ = nullptr;
+  void *read_buffer_ = nullptr;
+  const char *data_ = nullptr;
+  int64_t size_ = 0;
+
+ public:
+  MappedFile(const char *filepath);
+  ~MappedFile();
+
+  bool is_open() const
+  {
+    return data_ != nullptr;
+  }
+
+  Span<char> data() const
+  {
+    return Span<char>(data_, size_);
+  }
+
+  StringRef text() const
+  {
+    return StringRef(data_, size_);
+  }
+};
+
+}  // namespace blender::io
@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "BLI_float2.hh"
+#include "BLI_float3.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+struct Main;
+struct Mesh;
+struct Object;
+struct ViewLayer;
+
+/* Construction of the meshes read by the importers of simple file formats like OBJ, PLY and
+ * STL. The geometry is gathered in plain arrays, which are copied to the arrays of the mesh in
+ * one go, without going through BMesh. */
+
+namespace blender::io {
+
+struct MeshBuilder {
+  Vector<float3> positions;
+  /* Number of corners of every face. */
+  Vector<int> face_sizes;
+  /* Vertex of every face corner, the corners of a face are consecutive. */
+  Vector<int> corner_verts;
+
+  /* Optional attributes, they are ignored when their size doesn't match. */
+  Vector<float2> corner_uvs;
+  /* Zero vectors keep the automatic normal of the corner. */
+  Vector<float3> corner_normals;
+  Vector<float3> vertex_normals;
+  Vector<std::array<uint8_t, 4>> vertex_colors;
+  Vector<bool> face_smooth;
+  /* Index in #materials of every face. */
+  Vector<int> face_materials;
+  Vector<std::string> materials;
+
+  /* Create a mesh outside of the main database, with its edges and normals computed. */
+  Mesh *build() const;
+};
+
+/* Add an object to the main database that takes the data of a mesh created by
+ * #MeshBuilder::build(). The materials are looked up by name, and added when they don't exist. */
+Object *import_add_mesh_object(Main *bmain,
+                               const char *name,
+                               Mesh *mesh_nomain,
+                               Span<std::string> materials);
+
+/* Link the imported objects to the active collection of the view layer, and select them. */
+void import_link_objects(Main *bmain, ViewLayer *view_layer, Span<Object *> objects);
+
+}  // namespace blender::io
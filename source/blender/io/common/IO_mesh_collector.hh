@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include <string>
+
+#include "BLI_float4x4.hh"
+#include "BLI_vector.hh"
+
+#include "IO_abstract_hierarchy_iterator.h"
+
+struct Depsgraph;
+struct Material;
+struct Mesh;
+
+/* Gathering of the evaluated meshes of a depsgraph, for the exporters of file formats that only
+ * store geometry, like OBJ, PLY and STL. The dupli-objects are included, with their own names
+ * and matrices. */
+
+namespace blender::io {
+
+struct CollectedMesh {
+  /* Name of the object, unique within the export. */
+  std::string name;
+  /* Evaluated mesh, owned by the depsgraph. */
+  Mesh *mesh;
+  float4x4 matrix_world;
+  /* Material of every slot of the object, can be null. */
+  Vector<Material *> materials;
+};
+
+class MeshCollector : public AbstractHierarchyIterator {
+ private:
+  const bool selected_objects_only_;
+  Vector<CollectedMesh> meshes_;
+
+ public:
+  MeshCollector(Depsgraph *depsgraph, bool selected_objects_only);
+
+  /* Collect the meshes of the visible objects, in the order of the export hierarchy. */
+  Vector<CollectedMesh> &collect();
+
+  void add_mesh(const HierarchyContext &context);
+
+ protected:
+  bool mark_as_weak_export(const Object *object) const override;
+
+  AbstractHierarchyWriter *create_transform_writer(const HierarchyContext *context) override;
+  AbstractHierarchyWriter *create_data_writer(const HierarchyContext *context) override;
+  AbstractHierarchyWriter *create_hair_writer(const HierarchyContext *context) override;
+  AbstractHierarchyWriter *create_particle_writer(const HierarchyContext *context) override;
+
+  void release_writer(AbstractHierarchyWriter *writer) override;
+};
+
+}  // namespace blender::io
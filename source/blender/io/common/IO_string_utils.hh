@@ -0,0 +1,127 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+
+#include "BLI_array.hh"
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+/* Parsing and formatting of the text of file formats like OBJ and PLY.
+ *
+ * The numbers are parsed and written without the C library, which depends on the locale and is
+ * much slower. The parse functions take the text that starts with the value, and return the text
+ * after it. When there is no valid value, the fallback is used and nothing is consumed. */
+
+namespace blender::io {
+
+/* Return the first line of the buffer without its end of line, and remove it from the buffer. */
+StringRef read_next_line(StringRef &buffer);
+
+/* Drop the spaces and tabs at the start of the text. */
+StringRef drop_whitespace(StringRef str);
+/* Drop everything until the first space, tab or end of line of the text. */
+StringRef drop_non_whitespace(StringRef str);
+
+/* The first word of the text, after its whitespace. */
+StringRef first_word(StringRef str);
+
+StringRef parse_int(StringRef str, int fallback, int &dst, bool skip_space = true);
+StringRef parse_float(StringRef str, float fallback, float &dst, bool skip_space = true);
+StringRef parse_floats(StringRef str, float fallback, float *dst, int count);
+
+/* Split the buffer in parts of at least chunk_size bytes which end at a line end, so that they
+ * can be parsed independently of each other. */
+Vector<StringRef> split_in_line_chunks(StringRef buffer, int64_t chunk_size);
+
+/* Growing buffer of text, with formatting of numbers. Files are made of buffers filled in
+ * parallel and written in order. */
+class TextBuffer {
+ private:
+  Vector<char, 0> chars_;
+
+ public:
+  void append(const StringRef str)
+  {
+    chars_.extend(Span<char>(str.data(), str.size()));
+  }
+
+  void append(const char c)
+  {
+    chars_.append(c);
+  }
+
+  /* The bytes of a value, for binary files. */
+  template<typename T> void append_binary(const T &value)
+  {
+    chars_.extend(Span<char>(reinterpret_cast<const char *>(&value), sizeof(T)));
+  }
+
+  void append_int(int64_t value);
+  /* Fixed point notation with the given number of decimals, like `%.6f`. */
+  void append_float(float value, int precision = 6);
+
+  Span<char> data() const
+  {
+    return chars_;
+  }
+
+  int64_t size() const
+  {
+    return chars_.size();
+  }
+
+  void clear()
+  {
+    chars_.clear();
+  }
+};
+
+/* Format the parts of a file in parallel and write them in order. The parts are formatted in
+ * batches, so that only a few of them are in memory at once. Returns false when a write fails. */
+template<typename FormatFn>
+bool write_parts_in_order(FILE *file, const int64_t parts_num, const FormatFn &format)
+{
+  constexpr int64_t batch_size = 64;
+  Array<TextBuffer> buffers(std::min(parts_num, batch_size));
+  for (int64_t batch_start = 0; batch_start < parts_num; batch_start += batch_size) {
+    const IndexRange batch(batch_start, std::min(batch_size, parts_num - batch_start));
+    parallel_for(batch, 1, [&](const IndexRange range) {
+      for (const int64_t part : range) {
+        TextBuffer &buffer = buffers[part - batch_start];
+        buffer.clear();
+        format(part, buffer);
+      }
+    });
+    for (const int64_t part : batch) {
+      const Span<char> data = buffers[part - batch_start].data();
+      if (fwrite(data.data(), 1, static_cast<size_t>(data.size()), file) !=
+          static_cast<size_t>(data.size())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace blender::io
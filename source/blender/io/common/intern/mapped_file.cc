@@ -0,0 +1,79 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_mapped_file.hh"
+
+#include <fcntl.h>
+#ifndef WIN32
+#  include <unistd.h> /* for close */
+#else
+#  include "BLI_winstuff.h"
+#  include <io.h> /* for close */
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_mmap.h"
+
+namespace blender::io {
+
+MappedFile::MappedFile(const char *filepath)
+{
+  file_ = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file_ == -1) {
+    return;
+  }
+
+  const size_t size = BLI_file_descriptor_size(file_);
+  if (size == 0 || size == size_t(-1)) {
+    /* Empty files can't be mapped, but are valid. */
+    static const char empty = '\0';
+    data_ = &empty;
+    return;
+  }
+
+  mmap_file_ = BLI_mmap_open(file_);
+  if (mmap_file_ != nullptr) {
+    data_ = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file_));
+    size_ = static_cast<int64_t>(size);
+    return;
+  }
+
+  size_t read_size = 0;
+  read_buffer_ = BLI_file_read_binary_as_mem(filepath, 0, &read_size);
+  if (read_buffer_ != nullptr) {
+    data_ = static_cast<const char *>(read_buffer_);
+    size_ = static_cast<int64_t>(read_size);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (mmap_file_ != nullptr) {
+    BLI_mmap_free(mmap_file_);
+  }
+  if (read_buffer_ != nullptr) {
+    MEM_freeN(read_buffer_);
+  }
+  if (file_ != -1) {
+    close(file_);
+  }
+}
+
+}  // namespace blender::io
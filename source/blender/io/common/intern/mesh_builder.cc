@@ -0,0 +1,176 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_mesh_builder.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_customdata_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "BKE_collection.h"
+#include "BKE_customdata.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+namespace blender::io {
+
+Mesh *MeshBuilder::build() const
+{
+  const int verts_num = static_cast<int>(positions.size());
+  const int faces_num = static_cast<int>(face_sizes.size());
+  const int corners_num = static_cast<int>(corner_verts.size());
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, 0, corners_num, faces_num);
+
+  parallel_for(IndexRange(verts_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(mesh->mvert[i].co, positions[i]);
+    }
+  });
+
+  int loopstart = 0;
+  for (const int i : IndexRange(faces_num)) {
+    mesh->mpoly[i].loopstart = loopstart;
+    mesh->mpoly[i].totloop = face_sizes[i];
+    loopstart += face_sizes[i];
+  }
+  BLI_assert(loopstart == corners_num);
+
+  const bool has_smooth = face_smooth.size() == faces_num;
+  const bool has_materials = face_materials.size() == faces_num;
+  parallel_for(IndexRange(faces_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mesh->mpoly[i];
+      if (has_smooth && face_smooth[i]) {
+        poly.flag |= ME_SMOOTH;
+      }
+      if (has_materials) {
+        poly.mat_nr = static_cast<short>(face_materials[i]);
+      }
+    }
+  });
+
+  parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh->mloop[i].v = static_cast<unsigned int>(corner_verts[i]);
+    }
+  });
+
+  if (corner_uvs.size() == corners_num) {
+    MLoopUV *mloopuv = static_cast<MLoopUV *>(CustomData_add_layer_named(
+        &mesh->ldata, CD_MLOOPUV, CD_DEFAULT, nullptr, corners_num, "UVMap"));
+    parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        copy_v2_v2(mloopuv[i].uv, corner_uvs[i]);
+      }
+    });
+  }
+
+  if (vertex_colors.size() == verts_num) {
+    MLoopCol *mloopcol = static_cast<MLoopCol *>(CustomData_add_layer_named(
+        &mesh->ldata, CD_MLOOPCOL, CD_DEFAULT, nullptr, corners_num, "Col"));
+    parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const std::array<uint8_t, 4> &color = vertex_colors[corner_verts[i]];
+        mloopcol[i].r = color[0];
+        mloopcol[i].g = color[1];
+        mloopcol[i].b = color[2];
+        mloopcol[i].a = color[3];
+      }
+    });
+  }
+
+  BKE_mesh_calc_edges(mesh, false, false);
+  BKE_mesh_calc_normals(mesh);
+
+  /* The custom normals take a copy, since they are changed to the space of the corners. */
+  if (corner_normals.size() == corners_num) {
+    Array<float3> normals(corner_normals.as_span());
+    mesh->flag |= ME_AUTOSMOOTH;
+    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(normals.data()));
+  }
+  else if (vertex_normals.size() == verts_num) {
+    Array<float3> normals(vertex_normals.as_span());
+    mesh->flag |= ME_AUTOSMOOTH;
+    BKE_mesh_set_custom_normals_from_vertices(mesh,
+                                              reinterpret_cast<float(*)[3]>(normals.data()));
+  }
+
+  return mesh;
+}
+
+Object *import_add_mesh_object(Main *bmain,
+                               const char *name,
+                               Mesh *mesh_nomain,
+                               Span<std::string> materials)
+{
+  Mesh *mesh = BKE_mesh_add(bmain, name);
+  Object *ob = BKE_object_add_only_object(bmain, OB_MESH, name);
+  ob->data = mesh;
+
+  /* The flag isn't copied by BKE_mesh_nomain_to_mesh(), which frees the mesh. */
+  const short autosmooth = mesh_nomain->flag & ME_AUTOSMOOTH;
+  BKE_mesh_nomain_to_mesh(mesh_nomain, mesh, ob, &CD_MASK_MESH, true);
+  mesh->flag |= autosmooth;
+
+  for (const int i : materials.index_range()) {
+    Material *material = reinterpret_cast<Material *>(
+        BKE_libblock_find_name(bmain, ID_MA, materials[i].c_str()));
+    if (material == nullptr) {
+      material = BKE_material_add(bmain, materials[i].c_str());
+    }
+    BKE_object_material_assign(
+        bmain, ob, material, static_cast<short>(i + 1), BKE_MAT_ASSIGN_OBDATA);
+  }
+
+  return ob;
+}
+
+void import_link_objects(Main *bmain, ViewLayer *view_layer, Span<Object *> objects)
+{
+  BKE_view_layer_base_deselect_all(view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+
+  for (Object *ob : objects) {
+    BKE_collection_object_add(bmain, lc->collection, ob);
+    Base *base = BKE_view_layer_base_find(view_layer, ob);
+    BKE_view_layer_base_select_and_set_active(view_layer, base);
+    DEG_id_tag_update_ex(bmain, &ob->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
+  }
+
+  DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+  DEG_relations_tag_update(bmain);
+}
+
+}  // namespace blender::io
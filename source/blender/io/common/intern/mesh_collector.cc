@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_mesh_collector.hh"
+
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_material.h"
+#include "BKE_object.h"
+
+#include "DEG_depsgraph_query.h"
+
+namespace blender::io {
+
+namespace {
+
+/* The collector has nothing to write for the transforms, but the hierarchy iterator only
+ * visits the data of objects that have a transform writer. */
+class MeshCollectorWriter : public AbstractHierarchyWriter {
+ private:
+  MeshCollector *collector_;
+
+ public:
+  MeshCollectorWriter(MeshCollector *collector) : collector_(collector)
+  {
+  }
+
+  void write(HierarchyContext &context) override
+  {
+    if (collector_ != nullptr) {
+      collector_->add_mesh(context);
+    }
+  }
+};
+
+}  // namespace
+
+MeshCollector::MeshCollector(Depsgraph *depsgraph, const bool selected_objects_only)
+    : AbstractHierarchyIterator(depsgraph), selected_objects_only_(selected_objects_only)
+{
+}
+
+Vector<CollectedMesh> &MeshCollector::collect()
+{
+  meshes_.clear();
+  iterate_and_write();
+  release_writers();
+  return meshes_;
+}
+
+void MeshCollector::add_mesh(const HierarchyContext &context)
+{
+  if (!context.is_object_visible(DEG_get_mode(depsgraph_))) {
+    return;
+  }
+  Object *object = context.object;
+  Mesh *mesh = BKE_object_get_evaluated_mesh(object);
+  if (mesh == nullptr) {
+    return;
+  }
+
+  CollectedMesh collected;
+  /* The export name of the data context is the name of the mesh, the name of the object is the
+   * last part of the path of its transform. */
+  const std::string &path = context.higher_up_export_path;
+  collected.name = path.substr(path.rfind('/') + 1);
+  collected.mesh = mesh;
+  collected.matrix_world = float4x4(context.matrix_world);
+  for (const int i : IndexRange(object->totcol)) {
+    collected.materials.append(BKE_object_material_get(object, static_cast<short>(i + 1)));
+  }
+  meshes_.append(std::move(collected));
+}
+
+bool MeshCollector::mark_as_weak_export(const Object *object) const
+{
+  return selected_objects_only_ && (object->base_flag & BASE_SELECTED) == 0;
+}
+
+AbstractHierarchyWriter *MeshCollector::create_transform_writer(
+    const HierarchyContext * /*context*/)
+{
+  return new MeshCollectorWriter(nullptr);
+}
+
+AbstractHierarchyWriter *MeshCollector::create_data_writer(const HierarchyContext *context)
+{
+  switch (context->object->type) {
+    case OB_MESH:
+    case OB_CURVE:
+    case OB_SURF:
+    case OB_FONT:
+    case OB_MBALL:
+      return new MeshCollectorWriter(this);
+    default:
+      return nullptr;
+  }
+}
+
+AbstractHierarchyWriter *MeshCollector::create_hair_writer(const HierarchyContext * /*context*/)
+{
+  return nullptr;
+}
+
+AbstractHierarchyWriter *MeshCollector::create_particle_writer(
+    const HierarchyContext * /*context*/)
+{
+  return nullptr;
+}
+
+void MeshCollector::release_writer(AbstractHierarchyWriter *writer)
+{
+  delete writer;
+}
+
+}  // namespace blender::io
@@ -0,0 +1,283 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_string_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+
+/* NOTE: the functions are used on large files, they don't rely on the C library and its locale
+ * on purpose. */
+
+namespace blender::io {
+
+static bool is_whitespace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/* Exactly representable powers of ten. */
+static const double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static double power_of_ten(const int exponent)
+{
+  if (exponent >= 0 && exponent < ARRAY_SIZE(exact_powers_of_ten)) {
+    return exact_powers_of_ten[exponent];
+  }
+  return std::pow(10.0, exponent);
+}
+
+StringRef read_next_line(StringRef &buffer)
+{
+  const int64_t end = buffer.find('\n');
+  StringRef line;
+  if (end == -1) {
+    line = buffer;
+    buffer = StringRef();
+  }
+  else {
+    line = buffer.substr(0, end);
+    buffer = buffer.drop_prefix(end + 1);
+  }
+  if (!line.is_empty() && line.back() == '\r') {
+    line = line.drop_suffix(1);
+  }
+  return line;
+}
+
+StringRef drop_whitespace(StringRef str)
+{
+  const char *p = str.begin();
+  while (p < str.end() && is_whitespace(*p)) {
+    p++;
+  }
+  return StringRef(p, str.end());
+}
+
+StringRef drop_non_whitespace(StringRef str)
+{
+  const char *p = str.begin();
+  while (p < str.end() && !is_whitespace(*p) && *p != '\n') {
+    p++;
+  }
+  return StringRef(p, str.end());
+}
+
+StringRef first_word(StringRef str)
+{
+  str = drop_whitespace(str);
+  const StringRef rest = drop_non_whitespace(str);
+  return StringRef(str.begin(), rest.begin());
+}
+
+StringRef parse_int(StringRef str, const int fallback, int &dst, const bool skip_space)
+{
+  if (skip_space) {
+    str = drop_whitespace(str);
+  }
+  const char *p = str.begin();
+  const char *end = str.end();
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    p++;
+  }
+  if (p == end || !is_digit(*p)) {
+    dst = fallback;
+    return str;
+  }
+
+  int64_t value = 0;
+  while (p < end && is_digit(*p)) {
+    if (value <= INT32_MAX) {
+      value = value * 10 + (*p - '0');
+    }
+    p++;
+  }
+  value = negative ? -value : value;
+  dst = static_cast<int>(std::max<int64_t>(std::min<int64_t>(value, INT32_MAX), INT32_MIN));
+  return StringRef(p, end);
+}
+
+StringRef parse_float(StringRef str, const float fallback, float &dst, const bool skip_space)
+{
+  if (skip_space) {
+    str = drop_whitespace(str);
+  }
+  const char *p = str.begin();
+  const char *end = str.end();
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    p++;
+  }
+
+  /* The first 19 significant digits fit in the mantissa, the following ones only change the
+   * exponent. */
+  uint64_t mantissa = 0;
+  int significant_digits = 0;
+  int exponent = 0;
+  bool has_digits = false;
+  while (p < end && is_digit(*p)) {
+    if (significant_digits < 19) {
+      mantissa = mantissa * 10 + uint64_t(*p - '0');
+      significant_digits += mantissa != 0;
+    }
+    else {
+      exponent++;
+    }
+    has_digits = true;
+    p++;
+  }
+  if (p < end && *p == '.') {
+    p++;
+    while (p < end && is_digit(*p)) {
+      if (significant_digits < 19) {
+        mantissa = mantissa * 10 + uint64_t(*p - '0');
+        significant_digits += mantissa != 0;
+        exponent--;
+      }
+      has_digits = true;
+      p++;
+    }
+  }
+  if (!has_digits) {
+    dst = fallback;
+    return str;
+  }
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    bool exponent_negative = false;
+    if (q < end && (*q == '-' || *q == '+')) {
+      exponent_negative = *q == '-';
+      q++;
+    }
+    if (q < end && is_digit(*q)) {
+      int value = 0;
+      while (q < end && is_digit(*q)) {
+        if (value < 10000) {
+          value = value * 10 + (*q - '0');
+        }
+        q++;
+      }
+      exponent += exponent_negative ? -value : value;
+      p = q;
+    }
+  }
+
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0) {
+    value /= power_of_ten(-exponent);
+  }
+  else if (exponent > 0) {
+    value *= power_of_ten(exponent);
+  }
+  dst = static_cast<float>(negative ? -value : value);
+  return StringRef(p, end);
+}
+
+StringRef parse_floats(StringRef str, const float fallback, float *dst, const int count)
+{
+  for (int i = 0; i < count; i++) {
+    str = parse_float(str, fallback, dst[i]);
+  }
+  return str;
+}
+
+Vector<StringRef> split_in_line_chunks(StringRef buffer, const int64_t chunk_size)
+{
+  Vector<StringRef> chunks;
+  while (!buffer.is_empty()) {
+    if (buffer.size() <= chunk_size) {
+      chunks.append(buffer);
+      break;
+    }
+    /* The chunk ends with the first line end that makes it at least chunk_size bytes long. */
+    const int64_t line_end = buffer.find('\n', chunk_size - 1);
+    if (line_end == -1) {
+      chunks.append(buffer);
+      break;
+    }
+    chunks.append(buffer.substr(0, line_end + 1));
+    buffer = buffer.drop_prefix(line_end + 1);
+  }
+  return chunks;
+}
+
+void TextBuffer::append_int(const int64_t value)
+{
+  char digits[24];
+  int len = 0;
+  uint64_t magnitude = value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+  do {
+    digits[len++] = char('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0) {
+    chars_.append('-');
+  }
+  while (len > 0) {
+    chars_.append(digits[--len]);
+  }
+}
+
+void TextBuffer::append_float(const float value, const int precision)
+{
+  BLI_assert(precision >= 0 && precision < 16);
+  const double scale = exact_powers_of_ten[precision];
+  const double scaled = std::abs(static_cast<double>(value)) * scale;
+
+  if (!std::isfinite(value) || scaled >= 1e18) {
+    /* Use the C library for what does not fit the integer formatting. */
+    char buffer[64];
+    const int len = snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    append(StringRef(buffer, std::min<int64_t>(len, sizeof(buffer) - 1)));
+    return;
+  }
+
+  const uint64_t units = static_cast<uint64_t>(scaled + 0.5);
+  const uint64_t unit_scale = static_cast<uint64_t>(scale);
+  if (value < 0.0f && units != 0) {
+    chars_.append('-');
+  }
+  append_int(static_cast<int64_t>(units / unit_scale));
+  if (precision == 0) {
+    return;
+  }
+  chars_.append('.');
+  uint64_t fraction = units % unit_scale;
+  char digits[16];
+  for (int i = precision - 1; i >= 0; i--) {
+    digits[i] = char('0' + fraction % 10);
+    fraction /= 10;
+  }
+  chars_.extend(Span<char>(digits, precision));
+}
+
+}  // namespace blender::io
@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_string_utils.hh"
+
+#include "testing/testing.h"
+
+#include <string>
+
+namespace blender::io::tests {
+
+TEST(string_utils, read_next_line)
+{
+  StringRef buffer = "v 1 2 3\r\nf 1 2 3\n\nlast";
+  EXPECT_EQ(read_next_line(buffer), "v 1 2 3");
+  EXPECT_EQ(read_next_line(buffer), "f 1 2 3");
+  EXPECT_EQ(read_next_line(buffer), "");
+  EXPECT_EQ(read_next_line(buffer), "last");
+  EXPECT_TRUE(buffer.is_empty());
+}
+
+TEST(string_utils, first_word)
+{
+  EXPECT_EQ(first_word("  usemtl Material"), "usemtl");
+  EXPECT_EQ(first_word("\tv"), "v");
+  EXPECT_EQ(first_word(""), "");
+}
+
+TEST(string_utils, parse_int)
+{
+  int value = 0;
+  StringRef rest = parse_int(" 42/7", -1, value);
+  EXPECT_EQ(value, 42);
+  EXPECT_EQ(rest, "/7");
+  rest = parse_int(rest.drop_prefix(1), -1, value);
+  EXPECT_EQ(value, 7);
+  EXPECT_TRUE(rest.is_empty());
+
+  parse_int("-12", 0, value);
+  EXPECT_EQ(value, -12);
+  rest = parse_int("abc", -1, value);
+  EXPECT_EQ(value, -1);
+  EXPECT_EQ(rest, "abc");
+  parse_int("99999999999999", 0, value);
+  EXPECT_EQ(value, INT32_MAX);
+}
+
+TEST(string_utils, parse_float)
+{
+  float value = 0.0f;
+  StringRef rest = parse_float("  1.5 2", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 1.5f);
+  EXPECT_EQ(rest, " 2");
+
+  parse_float("-0.000125", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, -0.000125f);
+  parse_float("1e3", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 1000.0f);
+  parse_float("2.5E-2", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 0.025f);
+  parse_float(".5", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 0.5f);
+  parse_float("+7.", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 7.0f);
+  parse_float("3.14159265358979323846264338", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 3.14159265f);
+  parse_float("123456789012345678901234", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 1.23456789e23f);
+
+  /* An exponent without digits is not part of the number. */
+  rest = parse_float("4e", 0.0f, value);
+  EXPECT_FLOAT_EQ(value, 4.0f);
+  EXPECT_EQ(rest, "e");
+
+  rest = parse_float("-x", 9.0f, value);
+  EXPECT_FLOAT_EQ(value, 9.0f);
+  EXPECT_EQ(rest, "-x");
+
+  float values[3];
+  rest = parse_floats("0.1 0.2 0.3 rest", 0.0f, values, 3);
+  EXPECT_FLOAT_EQ(values[0], 0.1f);
+  EXPECT_FLOAT_EQ(values[1], 0.2f);
+  EXPECT_FLOAT_EQ(values[2], 0.3f);
+  EXPECT_EQ(rest, " rest");
+}
+
+TEST(string_utils, split_in_line_chunks)
+{
+  const StringRef buffer = "aaaa\nbb\ncccccc\nd";
+  Vector<StringRef> chunks = split_in_line_chunks(buffer, 3);
+  ASSERT_EQ(chunks.size(), 4);
+  EXPECT_EQ(chunks[0], "aaaa\n");
+  EXPECT_EQ(chunks[1], "bb\n");
+  EXPECT_EQ(chunks[2], "cccccc\n");
+  EXPECT_EQ(chunks[3], "d");
+
+  chunks = split_in_line_chunks(buffer, 100);
+  ASSERT_EQ(chunks.size(), 1);
+  EXPECT_EQ(chunks[0], buffer);
+
+  EXPECT_TRUE(split_in_line_chunks("", 10).is_empty());
+}
+
+static std::string format_float(const float value, const int precision)
+{
+  TextBuffer buffer;
+  buffer.append_float(value, precision);
+  return std::string(buffer.data().data(), buffer.size());
+}
+
+TEST(string_utils, append_float)
+{
+  EXPECT_EQ(format_float(0.0f, 6), "0.000000");
+  EXPECT_EQ(format_float(1.5f, 6), "1.500000");
+  EXPECT_EQ(format_float(-2.25f, 4), "-2.2500");
+  EXPECT_EQ(format_float(0.1f, 6), "0.100000");
+  EXPECT_EQ(format_float(123456.789f, 2), "123456.79");
+  EXPECT_EQ(format_float(-0.0000001f, 6), "0.000000");
+  EXPECT_EQ(format_float(0.9999999f, 6), "1.000000");
+  EXPECT_EQ(format_float(7.0f, 0), "7");
+  EXPECT_EQ(format_float(1e30f, 1), "1000000015047466219876688855040.0");
+}
+
+TEST(string_utils, append_int)
+{
+  TextBuffer buffer;
+  buffer.append_int(0);
+  buffer.append(' ');
+  buffer.append_int(-1234);
+  buffer.append(' ');
+  buffer.append_int(INT64_MIN);
+  EXPECT_EQ(std::string(buffer.data().data(), buffer.size()), "0 -1234 -9223372036854775808");
+}
+
+TEST(string_utils, write_parts_in_order)
+{
+  FILE *file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  const int64_t parts_num = 1000;
+  EXPECT_TRUE(write_parts_in_order(file, parts_num, [](const int64_t part, TextBuffer &buffer) {
+    buffer.append_int(part);
+    buffer.append('\n');
+  }));
+
+  std::string expected;
+  for (const int64_t part : IndexRange(parts_num)) {
+    expected += std::to_string(part) + "\n";
+  }
+  std::string written(expected.size() + 1, '\0');
+  rewind(file);
+  written.resize(fread(written.data(), 1, written.size(), file));
+  fclose(file);
+  EXPECT_EQ(written, expected);
+}
+
+}  // namespace blender::io::tests
@@ -0,0 +1,52 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bContext;
+
+struct PLYImportParams {
+  float global_scale;
+  bool validate_meshes;
+};
+
+struct PLYExportParams {
+  float global_scale;
+  bool selected_objects_only;
+  /* Write the text format instead of the little endian binary one. */
+  bool ascii;
+  bool export_normals;
+  /* Write the colors of the first vertex color layer. */
+  bool export_colors;
+};
+
+/* The text and both binary formats are read: the positions, normals, texture coordinates and
+ * colors of the vertices, and the faces. All meshes are written to a single file.
+ * Both functions return false when the file can't be read or written. */
+
+bool PLY_import(struct bContext *C, const char *filepath, const struct PLYImportParams *params);
+
+bool PLY_export(struct bContext *C, const char *filepath, const struct PLYExportParams *params);
+
+#ifdef __cplusplus
+}
+#endif
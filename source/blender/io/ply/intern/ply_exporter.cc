@@ -0,0 +1,243 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_ply.h"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include "DNA_customdata_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_float3.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_global.h"
+
+#include "IO_mesh_collector.hh"
+#include "IO_string_utils.hh"
+
+namespace blender::io::ply {
+
+static constexpr int elements_per_part = 1 << 15;
+
+struct ExportObject {
+  const Mesh *mesh;
+  float4x4 matrix;
+  float4x4 normal_matrix;
+  bool is_negative;
+  /* Color of every vertex, from the last face corner using it. */
+  Array<std::array<uint8_t, 4>> colors;
+  int vert_offset;
+};
+
+struct Part {
+  int object;
+  bool is_faces;
+  IndexRange range;
+};
+
+template<typename T> static void append_value(TextBuffer &buffer, const bool ascii, T value)
+{
+  if (ascii) {
+    if constexpr (std::is_floating_point_v<T>) {
+      buffer.append_float(value);
+    }
+    else {
+      buffer.append_int(value);
+    }
+    buffer.append(' ');
+    return;
+  }
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    char *bytes = reinterpret_cast<char *>(&value);
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  buffer.append_binary(value);
+}
+
+static void end_element(TextBuffer &buffer, const bool ascii)
+{
+  if (ascii) {
+    /* Every value is followed by a space, every element by a line end. */
+    buffer.append('\n');
+  }
+}
+
+static void format_vertices(const ExportObject &object,
+                            const IndexRange range,
+                            const PLYExportParams &params,
+                            TextBuffer &buffer)
+{
+  const Mesh *mesh = object.mesh;
+  for (const int i : range) {
+    const float3 co = object.matrix * float3(mesh->mvert[i].co);
+    for (const int j : IndexRange(3)) {
+      append_value(buffer, params.ascii, co[j]);
+    }
+    if (params.export_normals) {
+      float3 normal;
+      normal_short_to_float_v3(normal, mesh->mvert[i].no);
+      mul_mat3_m4_v3(object.normal_matrix.ptr(), normal);
+      normalize_v3(normal);
+      for (const int j : IndexRange(3)) {
+        append_value(buffer, params.ascii, normal[j]);
+      }
+    }
+    if (params.export_colors) {
+      for (const int j : IndexRange(4)) {
+        append_value(buffer, params.ascii, object.colors.is_empty() ? uint8_t(255) :
+                                                                      object.colors[i][j]);
+      }
+    }
+    end_element(buffer, params.ascii);
+  }
+}
+
+static void format_faces(const ExportObject &object,
+                         const IndexRange range,
+                         const bool ascii,
+                         const bool use_int_sizes,
+                         TextBuffer &buffer)
+{
+  const Mesh *mesh = object.mesh;
+  for (const int i : range) {
+    const MPoly &poly = mesh->mpoly[i];
+    if (use_int_sizes) {
+      append_value(buffer, ascii, int32_t(poly.totloop));
+    }
+    else {
+      append_value(buffer, ascii, uint8_t(poly.totloop));
+    }
+    for (const int j : IndexRange(poly.totloop)) {
+      const int loop = poly.loopstart + (object.is_negative ? poly.totloop - 1 - j : j);
+      append_value(buffer, ascii, int32_t(object.vert_offset + mesh->mloop[loop].v));
+    }
+    end_element(buffer, ascii);
+  }
+}
+
+static void add_parts(Vector<Part> &parts, const int object, const bool is_faces, const int size)
+{
+  for (int start = 0; start < size; start += elements_per_part) {
+    parts.append({object, is_faces, IndexRange(start, std::min(elements_per_part, size - start))});
+  }
+}
+
+static bool export_file(bContext *C, const char *filepath, const PLYExportParams &params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  MeshCollector collector(depsgraph, params.selected_objects_only);
+  const Vector<CollectedMesh> &meshes = collector.collect();
+
+  Array<ExportObject> objects(meshes.size());
+  Vector<Part> vertex_parts;
+  Vector<Part> face_parts;
+  int verts_num = 0;
+  int faces_num = 0;
+  int max_face_size = 0;
+  for (const int i : meshes.index_range()) {
+    ExportObject &object = objects[i];
+    const Mesh *mesh = meshes[i].mesh;
+    object.mesh = mesh;
+    float scale_mat[4][4];
+    scale_m4_fl(scale_mat, params.global_scale);
+    mul_m4_m4m4(object.matrix.ptr(), scale_mat, meshes[i].matrix_world.ptr());
+    object.normal_matrix = meshes[i].matrix_world.inverted_transposed_affine();
+    object.is_negative = is_negative_m4(object.matrix.ptr());
+    object.vert_offset = verts_num;
+
+    const MLoopCol *mloopcol = static_cast<const MLoopCol *>(
+        CustomData_get_layer(&mesh->ldata, CD_MLOOPCOL));
+    if (params.export_colors && mloopcol != nullptr) {
+      object.colors.reinitialize(mesh->totvert);
+      object.colors.fill({255, 255, 255, 255});
+      for (const int j : IndexRange(mesh->totloop)) {
+        const MLoopCol &color = mloopcol[j];
+        object.colors[mesh->mloop[j].v] = {color.r, color.g, color.b, color.a};
+      }
+    }
+    for (const int j : IndexRange(mesh->totpoly)) {
+      max_face_size = std::max(max_face_size, mesh->mpoly[j].totloop);
+    }
+
+    add_parts(vertex_parts, i, false, mesh->totvert);
+    add_parts(face_parts, i, true, mesh->totpoly);
+    verts_num += mesh->totvert;
+    faces_num += mesh->totpoly;
+  }
+  /* The faces are written after all vertices. */
+  Vector<Part> parts = std::move(vertex_parts);
+  parts.extend(face_parts);
+  const bool use_int_sizes = max_face_size > 255;
+
+  TextBuffer header;
+  header.append("ply\n");
+  header.append(params.ascii ? "format ascii 1.0\n" : "format binary_little_endian 1.0\n");
+  header.append("comment Created by Blender\n");
+  header.append("element vertex ");
+  header.append_int(verts_num);
+  header.append("\nproperty float x\nproperty float y\nproperty float z\n");
+  if (params.export_normals) {
+    header.append("property float nx\nproperty float ny\nproperty float nz\n");
+  }
+  if (params.export_colors) {
+    header.append("property uchar red\nproperty uchar green\nproperty uchar blue\n");
+    header.append("property uchar alpha\n");
+  }
+  header.append("element face ");
+  header.append_int(faces_num);
+  header.append(use_int_sizes ? "\nproperty list int int vertex_indices\n" :
+                                "\nproperty list uchar int vertex_indices\n");
+  header.append("end_header\n");
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = fwrite(header.data().data(), 1, static_cast<size_t>(header.size()), file) ==
+            static_cast<size_t>(header.size());
+  ok = ok && write_parts_in_order(file, parts.size(), [&](const int64_t i, TextBuffer &buffer) {
+         const Part &part = parts[i];
+         const ExportObject &object = objects[part.object];
+         if (part.is_faces) {
+           format_faces(object, part.range, params.ascii, use_int_sizes, buffer);
+         }
+         else {
+           format_vertices(object, part.range, params, buffer);
+         }
+       });
+  return (fclose(file) == 0) && ok;
+}
+
+}  // namespace blender::io::ply
+
+bool PLY_export(bContext *C, const char *filepath, const PLYExportParams *params)
+{
+  return blender::io::ply::export_file(C, filepath, *params);
+}
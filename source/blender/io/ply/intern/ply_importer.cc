@@ -0,0 +1,701 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_ply.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "DNA_object_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_float2.hh"
+#include "BLI_float3.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_mesh.h"
+
+#include "IO_mapped_file.hh"
+#include "IO_mesh_builder.hh"
+#include "IO_string_utils.hh"
+
+/* The elements of PLY files have a fixed size in the binary formats, unless they contain lists,
+ * and are on a line each in the text format. The vertices and the text faces are parsed in
+ * parallel, the binary faces are decoded serially since their lists have to be walked through
+ * anyway to find where every face starts. */
+
+namespace blender::io::ply {
+
+static constexpr int64_t lines_per_block = 1 << 14;
+
+enum class Format {
+  Ascii,
+  BinaryLittleEndian,
+  BinaryBigEndian,
+};
+
+enum class DataType {
+  Invalid,
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Float,
+  Double,
+};
+
+static DataType parse_data_type(const StringRef name)
+{
+  if (ELEM(name, "char", "int8")) {
+    return DataType::Int8;
+  }
+  if (ELEM(name, "uchar", "uint8")) {
+    return DataType::UInt8;
+  }
+  if (ELEM(name, "short", "int16")) {
+    return DataType::Int16;
+  }
+  if (ELEM(name, "ushort", "uint16")) {
+    return DataType::UInt16;
+  }
+  if (ELEM(name, "int", "int32")) {
+    return DataType::Int32;
+  }
+  if (ELEM(name, "uint", "uint32")) {
+    return DataType::UInt32;
+  }
+  if (ELEM(name, "float", "float32")) {
+    return DataType::Float;
+  }
+  if (ELEM(name, "double", "float64")) {
+    return DataType::Double;
+  }
+  return DataType::Invalid;
+}
+
+static int data_type_size(const DataType type)
+{
+  switch (type) {
+    case DataType::Int8:
+    case DataType::UInt8:
+      return 1;
+    case DataType::Int16:
+    case DataType::UInt16:
+      return 2;
+    case DataType::Int32:
+    case DataType::UInt32:
+    case DataType::Float:
+      return 4;
+    case DataType::Double:
+      return 8;
+    case DataType::Invalid:
+      break;
+  }
+  return 0;
+}
+
+struct Property {
+  std::string name;
+  DataType type = DataType::Invalid;
+  /* The type of the number of values of lists. */
+  DataType count_type = DataType::Invalid;
+
+  bool is_list() const
+  {
+    return count_type != DataType::Invalid;
+  }
+};
+
+struct Element {
+  std::string name;
+  int64_t count = 0;
+  Vector<Property> properties;
+
+  /* Size of an element in the binary formats, -1 when it contains lists. */
+  int64_t stride() const
+  {
+    int64_t size = 0;
+    for (const Property &property : properties) {
+      if (property.is_list()) {
+        return -1;
+      }
+      size += data_type_size(property.type);
+    }
+    return size;
+  }
+
+  int property_index(const Span<StringRef> names) const
+  {
+    for (const int i : properties.index_range()) {
+      if (names.contains(properties[i].name)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+};
+
+struct Header {
+  Format format = Format::Ascii;
+  Vector<Element> elements;
+  /* The data comes after the header. */
+  int64_t size = 0;
+};
+
+static StringRef next_word(StringRef &str)
+{
+  const StringRef word = first_word(str);
+  str = drop_whitespace(str).drop_prefix(word.size());
+  return word;
+}
+
+static bool parse_header(const StringRef text, Header &r_header)
+{
+  StringRef buffer = text;
+  if (read_next_line(buffer) != "ply") {
+    return false;
+  }
+  bool has_format = false;
+  while (!buffer.is_empty()) {
+    StringRef line = read_next_line(buffer);
+    const StringRef keyword = next_word(line);
+    if (keyword == "format") {
+      const StringRef format = next_word(line);
+      if (format == "ascii") {
+        r_header.format = Format::Ascii;
+      }
+      else if (format == "binary_little_endian") {
+        r_header.format = Format::BinaryLittleEndian;
+      }
+      else if (format == "binary_big_endian") {
+        r_header.format = Format::BinaryBigEndian;
+      }
+      else {
+        return false;
+      }
+      has_format = true;
+    }
+    else if (keyword == "element") {
+      Element element;
+      element.name = next_word(line);
+      int count;
+      parse_int(line, -1, count);
+      if (count < 0) {
+        return false;
+      }
+      element.count = count;
+      r_header.elements.append(std::move(element));
+    }
+    else if (keyword == "property") {
+      if (r_header.elements.is_empty()) {
+        return false;
+      }
+      Property property;
+      StringRef type = next_word(line);
+      if (type == "list") {
+        property.count_type = parse_data_type(next_word(line));
+        if (property.count_type == DataType::Invalid) {
+          return false;
+        }
+        type = next_word(line);
+      }
+      property.type = parse_data_type(type);
+      property.name = next_word(line);
+      if (property.type == DataType::Invalid) {
+        return false;
+      }
+      r_header.elements.last().properties.append(std::move(property));
+    }
+    else if (keyword == "end_header") {
+      r_header.size = buffer.begin() - text.begin();
+      return has_format;
+    }
+  }
+  return false;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Values
+ * \{ */
+
+template<typename T> static T read_binary_value(const char *data, const bool swap)
+{
+  char bytes[sizeof(T)];
+  memcpy(bytes, data, sizeof(T));
+  if (swap) {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  T value;
+  memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+static double read_binary(const char *data, const DataType type, const bool swap)
+{
+  switch (type) {
+    case DataType::Int8:
+      return read_binary_value<int8_t>(data, swap);
+    case DataType::UInt8:
+      return read_binary_value<uint8_t>(data, swap);
+    case DataType::Int16:
+      return read_binary_value<int16_t>(data, swap);
+    case DataType::UInt16:
+      return read_binary_value<uint16_t>(data, swap);
+    case DataType::Int32:
+      return read_binary_value<int32_t>(data, swap);
+    case DataType::UInt32:
+      return read_binary_value<uint32_t>(data, swap);
+    case DataType::Float:
+      return read_binary_value<float>(data, swap);
+    case DataType::Double:
+      return read_binary_value<double>(data, swap);
+    case DataType::Invalid:
+      break;
+  }
+  return 0.0;
+}
+
+static StringRef parse_ascii(const StringRef str, const DataType type, double &r_value)
+{
+  if (ELEM(type, DataType::Float, DataType::Double)) {
+    float value;
+    const StringRef rest = parse_float(str, 0.0f, value);
+    r_value = value;
+    return rest;
+  }
+  int value;
+  const StringRef rest = parse_int(str, 0, value);
+  r_value = value;
+  return rest;
+}
+
+/* Colors are stored as numbers from 0 to 255, or as floats from 0 to 1. */
+static uint8_t color_component(const double value, const DataType type)
+{
+  const double scaled = ELEM(type, DataType::Float, DataType::Double) ? value * 255.0 : value;
+  return static_cast<uint8_t>(std::clamp(scaled + 0.5, 0.0, 255.0));
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Vertices
+ * \{ */
+
+struct VertexLayout {
+  int position[3];
+  int normal[3];
+  int uv[2];
+  int color[4];
+
+  VertexLayout(const Element &element)
+  {
+    position[0] = element.property_index({"x"});
+    position[1] = element.property_index({"y"});
+    position[2] = element.property_index({"z"});
+    normal[0] = element.property_index({"nx"});
+    normal[1] = element.property_index({"ny"});
+    normal[2] = element.property_index({"nz"});
+    uv[0] = element.property_index({"s", "u", "texture_u", "texture_s"});
+    uv[1] = element.property_index({"t", "v", "texture_v", "texture_t"});
+    color[0] = element.property_index({"red", "diffuse_red"});
+    color[1] = element.property_index({"green", "diffuse_green"});
+    color[2] = element.property_index({"blue", "diffuse_blue"});
+    color[3] = element.property_index({"alpha"});
+  }
+
+  bool has_normals() const
+  {
+    return normal[0] != -1 && normal[1] != -1 && normal[2] != -1;
+  }
+
+  bool has_uvs() const
+  {
+    return uv[0] != -1 && uv[1] != -1;
+  }
+
+  bool has_colors() const
+  {
+    return color[0] != -1 && color[1] != -1 && color[2] != -1;
+  }
+};
+
+struct VertexData {
+  Array<float3> positions;
+  Array<float3> normals;
+  Array<float2> uvs;
+  Array<std::array<uint8_t, 4>> colors;
+};
+
+static void store_vertex(const Element &element,
+                         const VertexLayout &layout,
+                         const Span<double> values,
+                         const int64_t i,
+                         const float scale,
+                         VertexData &r_data)
+{
+  auto value = [&](const int property) {
+    return property == -1 ? 0.0f : static_cast<float>(values[property]);
+  };
+  r_data.positions[i] = float3(value(layout.position[0]),
+                               value(layout.position[1]),
+                               value(layout.position[2])) *
+                        scale;
+  if (!r_data.normals.is_empty()) {
+    r_data.normals[i] = float3(
+        value(layout.normal[0]), value(layout.normal[1]), value(layout.normal[2]));
+  }
+  if (!r_data.uvs.is_empty()) {
+    r_data.uvs[i] = float2(value(layout.uv[0]), value(layout.uv[1]));
+  }
+  if (!r_data.colors.is_empty()) {
+    for (const int j : IndexRange(4)) {
+      const int property = layout.color[j];
+      if (property == -1) {
+        r_data.colors[i][j] = 255;
+      }
+      else {
+        r_data.colors[i][j] = color_component(values[property], element.properties[property].type);
+      }
+    }
+  }
+}
+
+static VertexData allocate_vertex_data(const Element &element, const VertexLayout &layout)
+{
+  VertexData data;
+  data.positions.reinitialize(element.count);
+  if (layout.has_normals()) {
+    data.normals.reinitialize(element.count);
+  }
+  if (layout.has_uvs()) {
+    data.uvs.reinitialize(element.count);
+  }
+  if (layout.has_colors()) {
+    data.colors.reinitialize(element.count);
+  }
+  return data;
+}
+
+static bool read_binary_vertices(const Element &element,
+                                 const Span<char> data,
+                                 const bool swap,
+                                 const float scale,
+                                 VertexData &r_data)
+{
+  const int64_t stride = element.stride();
+  if (stride == -1 || data.size() < stride * element.count) {
+    return false;
+  }
+  const VertexLayout layout(element);
+  r_data = allocate_vertex_data(element, layout);
+
+  parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+    Array<double> values(element.properties.size());
+    for (const int64_t i : range) {
+      const char *vertex = data.data() + i * stride;
+      for (const int j : element.properties.index_range()) {
+        const DataType type = element.properties[j].type;
+        values[j] = read_binary(vertex, type, swap);
+        vertex += data_type_size(type);
+      }
+      store_vertex(element, layout, values, i, scale, r_data);
+    }
+  });
+  return true;
+}
+
+static void read_ascii_vertices(const Element &element,
+                                const Span<StringRef> lines,
+                                const float scale,
+                                VertexData &r_data)
+{
+  const VertexLayout layout(element);
+  r_data = allocate_vertex_data(element, layout);
+
+  parallel_for(lines.index_range(), 4096, [&](const IndexRange range) {
+    Array<double> values(element.properties.size());
+    for (const int64_t i : range) {
+      StringRef line = lines[i];
+      for (const int j : element.properties.index_range()) {
+        const Property &property = element.properties[j];
+        if (property.is_list()) {
+          /* Lists of vertices are not used, they are skipped. */
+          int count;
+          line = parse_int(line, 0, count);
+          for (int k = 0; k < count; k++) {
+            line = drop_non_whitespace(drop_whitespace(line));
+          }
+          values[j] = 0.0;
+          continue;
+        }
+        line = parse_ascii(line, property.type, values[j]);
+      }
+      store_vertex(element, layout, values, i, scale, r_data);
+    }
+  });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Faces
+ * \{ */
+
+struct FaceData {
+  Vector<int> face_sizes;
+  Vector<int> corner_verts;
+};
+
+static int face_indices_property(const Element &element)
+{
+  const int index = element.property_index({"vertex_indices", "vertex_index"});
+  return (index != -1 && element.properties[index].is_list()) ? index : -1;
+}
+
+/* Walk through the binary elements, their lists make their size vary. Returns the size of the
+ * data of the elements, or -1 when the data ends before them. */
+static int64_t read_binary_elements(const Element &element,
+                                    const Span<char> data,
+                                    const bool swap,
+                                    FaceData *r_faces)
+{
+  const int indices_property = face_indices_property(element);
+  const char *p = data.data();
+  const char *end = data.data() + data.size();
+  for (int64_t i = 0; i < element.count; i++) {
+    for (const int j : element.properties.index_range()) {
+      const Property &property = element.properties[j];
+      const int value_size = data_type_size(property.type);
+      if (!property.is_list()) {
+        if (end - p < value_size) {
+          return -1;
+        }
+        p += value_size;
+        continue;
+      }
+      const int count_size = data_type_size(property.count_type);
+      if (end - p < count_size) {
+        return -1;
+      }
+      const int count = static_cast<int>(read_binary(p, property.count_type, swap));
+      p += count_size;
+      if (count < 0 || end - p < int64_t(count) * value_size) {
+        return -1;
+      }
+      if (r_faces != nullptr && j == indices_property) {
+        for (int k = 0; k < count; k++) {
+          r_faces->corner_verts.append(static_cast<int>(read_binary(p, property.type, swap)));
+          p += value_size;
+        }
+        r_faces->face_sizes.append(count);
+      }
+      else {
+        p += int64_t(count) * value_size;
+      }
+    }
+  }
+  return p - data.data();
+}
+
+static void read_ascii_faces(const Element &element,
+                             const Span<StringRef> lines,
+                             FaceData &r_faces)
+{
+  const int indices_property = face_indices_property(element);
+  if (indices_property == -1) {
+    return;
+  }
+
+  /* The faces are parsed in blocks of lines, which are concatenated in order. */
+  const int64_t blocks_num = (lines.size() + lines_per_block - 1) / lines_per_block;
+  Array<FaceData> blocks(blocks_num);
+  parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      FaceData &faces = blocks[block];
+      const int64_t start = block * lines_per_block;
+      for (StringRef line : lines.slice(start, std::min(lines_per_block, lines.size() - start))) {
+        for (const int j : element.properties.index_range()) {
+          const Property &property = element.properties[j];
+          if (!property.is_list()) {
+            line = drop_non_whitespace(drop_whitespace(line));
+            continue;
+          }
+          int count;
+          line = parse_int(line, 0, count);
+          for (int k = 0; k < count; k++) {
+            if (j == indices_property) {
+              int vert;
+              line = parse_int(line, -1, vert);
+              faces.corner_verts.append(vert);
+            }
+            else {
+              line = drop_non_whitespace(drop_whitespace(line));
+            }
+          }
+          if (j == indices_property) {
+            faces.face_sizes.append(std::max(count, 0));
+          }
+        }
+      }
+    }
+  });
+
+  for (const FaceData &faces : blocks) {
+    r_faces.face_sizes.extend(faces.face_sizes);
+    r_faces.corner_verts.extend(faces.corner_verts);
+  }
+}
+
+/** \} */
+
+static bool read_elements(const Header &header,
+                          const Span<char> data,
+                          const float scale,
+                          VertexData &r_vertices,
+                          FaceData &r_faces)
+{
+  if (header.format == Format::Ascii) {
+    StringRef text(data.data(), data.size());
+    for (const Element &element : header.elements) {
+      Array<StringRef> lines(element.count);
+      for (const int64_t i : lines.index_range()) {
+        if (text.is_empty()) {
+          return false;
+        }
+        lines[i] = read_next_line(text);
+      }
+      if (element.name == "vertex") {
+        read_ascii_vertices(element, lines, scale, r_vertices);
+      }
+      else if (element.name == "face") {
+        read_ascii_faces(element, lines, r_faces);
+      }
+    }
+    return true;
+  }
+
+  const bool is_big_endian = header.format == Format::BinaryBigEndian;
+  const bool swap = is_big_endian != (ENDIAN_ORDER == B_ENDIAN);
+  int64_t offset = 0;
+  for (const Element &element : header.elements) {
+    const Span<char> element_data = data.drop_front(std::min(offset, data.size()));
+    int64_t size;
+    if (element.name == "vertex") {
+      if (!read_binary_vertices(element, element_data, swap, scale, r_vertices)) {
+        return false;
+      }
+      size = element.stride() * element.count;
+    }
+    else if (element.name == "face") {
+      size = read_binary_elements(element, element_data, swap, &r_faces);
+    }
+    else {
+      const int64_t stride = element.stride();
+      size = stride == -1 ? read_binary_elements(element, element_data, swap, nullptr) :
+                            stride * element.count;
+    }
+    if (size == -1) {
+      return false;
+    }
+    offset += size;
+  }
+  return true;
+}
+
+static bool import_file(bContext *C, const char *filepath, const PLYImportParams &params)
+{
+  MappedFile file(filepath);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  Header header;
+  if (!parse_header(file.text(), header)) {
+    return false;
+  }
+
+  VertexData vertices;
+  FaceData faces;
+  if (!read_elements(header, file.data().drop_front(header.size), params.global_scale, vertices,
+                     faces)) {
+    return false;
+  }
+  if (vertices.positions.is_empty()) {
+    return false;
+  }
+
+  MeshBuilder builder;
+  const int verts_num = static_cast<int>(vertices.positions.size());
+  builder.positions.extend(vertices.positions.as_span());
+  int corner = 0;
+  for (const int face_size : faces.face_sizes) {
+    const Span<int> face_verts = faces.corner_verts.as_span().slice(corner, face_size);
+    corner += face_size;
+    const bool is_valid = face_size >= 3 && std::all_of(face_verts.begin(),
+                                                         face_verts.end(),
+                                                         [&](const int vert) {
+                                                           return vert >= 0 && vert < verts_num;
+                                                         });
+    if (is_valid) {
+      builder.face_sizes.append(face_size);
+      builder.corner_verts.extend(face_verts);
+    }
+  }
+
+  if (!vertices.normals.is_empty()) {
+    builder.vertex_normals.extend(vertices.normals.as_span());
+    /* The custom normals are only used by smooth faces. */
+    builder.face_smooth.append_n_times(true, builder.face_sizes.size());
+  }
+  if (!vertices.uvs.is_empty()) {
+    for (const int vert : builder.corner_verts) {
+      builder.corner_uvs.append(vertices.uvs[vert]);
+    }
+  }
+  if (!vertices.colors.is_empty()) {
+    builder.vertex_colors.extend(vertices.colors.as_span());
+  }
+
+  char name[FILE_MAX];
+  BLI_strncpy(name, BLI_path_basename(filepath), sizeof(name));
+  BLI_path_extension_replace(name, sizeof(name), "");
+
+  Main *bmain = CTX_data_main(C);
+  Object *ob = import_add_mesh_object(bmain, name, builder.build(), {});
+  if (params.validate_meshes) {
+    BKE_mesh_validate(static_cast<Mesh *>(ob->data), false, false);
+  }
+  import_link_objects(bmain, CTX_data_view_layer(C), {ob});
+  return true;
+}
+
+}  // namespace blender::io::ply
+
+bool PLY_import(bContext *C, const char *filepath, const PLYImportParams *params)
+{
+  return blender::io::ply::import_file(C, filepath, *params);
+}
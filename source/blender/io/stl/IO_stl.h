@@ -0,0 +1,48 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bContext;
+
+struct STLImportParams {
+  float global_scale;
+  bool validate_meshes;
+};
+
+struct STLExportParams {
+  float global_scale;
+  bool selected_objects_only;
+  /* Write the text format instead of the binary one. */
+  bool ascii;
+};
+
+/* Both the binary and the text format are read. All meshes are written to a single solid.
+ * Both functions return false when the file can't be read or written. */
+
+bool STL_import(struct bContext *C, const char *filepath, const struct STLImportParams *params);
+
+bool STL_export(struct bContext *C, const char *filepath, const struct STLExportParams *params);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_stl.h"
+
+#include <cstring>
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_float3.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_math_geom.h"
+#include "BLI_math_matrix.h"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_mesh_runtime.h"
+
+#include "IO_mesh_collector.hh"
+#include "IO_string_utils.hh"
+
+namespace blender::io::stl {
+
+static constexpr int triangles_per_part = 1 << 15;
+
+struct ExportObject {
+  const Mesh *mesh;
+  const MLoopTri *looptris;
+  int looptris_num;
+  float4x4 matrix;
+  bool is_negative;
+};
+
+struct Part {
+  int object;
+  IndexRange triangles;
+};
+
+static void triangle_positions(const ExportObject &object, const int i, float3 r_positions[3])
+{
+  const MLoopTri &looptri = object.looptris[i];
+  for (const int j : IndexRange(3)) {
+    /* The corners of mirrored objects are reversed to keep the normals pointing outside. */
+    const int corner = object.is_negative ? 2 - j : j;
+    const MLoop &loop = object.mesh->mloop[looptri.tri[corner]];
+    r_positions[j] = object.matrix * float3(object.mesh->mvert[loop.v].co);
+  }
+}
+
+static void append_binary_float3(TextBuffer &buffer, float3 value)
+{
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_float_array(value, 3);
+  }
+  buffer.append_binary(value);
+}
+
+static void append_ascii_float3(TextBuffer &buffer, const char *keyword, const float3 &value)
+{
+  buffer.append(keyword);
+  for (const int i : IndexRange(3)) {
+    buffer.append(' ');
+    buffer.append_float(value[i]);
+  }
+  buffer.append('\n');
+}
+
+static void format_part(const Part &part,
+                        const ExportObject &object,
+                        const bool ascii,
+                        TextBuffer &buffer)
+{
+  for (const int i : part.triangles) {
+    float3 positions[3];
+    triangle_positions(object, i, positions);
+    float3 normal;
+    normal_tri_v3(normal, positions[0], positions[1], positions[2]);
+
+    if (ascii) {
+      append_ascii_float3(buffer, "facet normal", normal);
+      buffer.append("outer loop\n");
+      for (const float3 &co : positions) {
+        append_ascii_float3(buffer, "vertex", co);
+      }
+      buffer.append("endloop\nendfacet\n");
+    }
+    else {
+      append_binary_float3(buffer, normal);
+      for (const float3 &co : positions) {
+        append_binary_float3(buffer, co);
+      }
+      buffer.append_binary(uint16_t(0));
+    }
+  }
+}
+
+static bool export_file(bContext *C, const char *filepath, const STLExportParams &params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  MeshCollector collector(depsgraph, params.selected_objects_only);
+  const Vector<CollectedMesh> &meshes = collector.collect();
+
+  /* The triangulation of the meshes is computed serially, the parts are formatted in parallel. */
+  Array<ExportObject> objects(meshes.size());
+  Vector<Part> parts;
+  uint32_t triangles_num = 0;
+  for (const int i : meshes.index_range()) {
+    ExportObject &object = objects[i];
+    object.mesh = meshes[i].mesh;
+    object.looptris = BKE_mesh_runtime_looptri_ensure(meshes[i].mesh);
+    object.looptris_num = BKE_mesh_runtime_looptri_len(meshes[i].mesh);
+    float scale_mat[4][4];
+    scale_m4_fl(scale_mat, params.global_scale);
+    mul_m4_m4m4(object.matrix.ptr(), scale_mat, meshes[i].matrix_world.ptr());
+    object.is_negative = is_negative_m4(object.matrix.ptr());
+
+    for (int start = 0; start < object.looptris_num; start += triangles_per_part) {
+      const int size = std::min(triangles_per_part, object.looptris_num - start);
+      parts.append({i, IndexRange(start, size)});
+    }
+    triangles_num += static_cast<uint32_t>(object.looptris_num);
+  }
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  TextBuffer header;
+  if (params.ascii) {
+    header.append("solid Blender\n");
+  }
+  else {
+    char description[80] = "Binary STL written by Blender";
+    header.append(StringRef(description, sizeof(description)));
+    if (ENDIAN_ORDER == B_ENDIAN) {
+      BLI_endian_switch_uint32(&triangles_num);
+    }
+    header.append_binary(triangles_num);
+  }
+
+  bool ok = fwrite(header.data().data(), 1, static_cast<size_t>(header.size()), file) ==
+            static_cast<size_t>(header.size());
+  ok = ok && write_parts_in_order(file, parts.size(), [&](const int64_t i, TextBuffer &buffer) {
+         format_part(parts[i], objects[parts[i].object], params.ascii, buffer);
+       });
+  if (ok && params.ascii) {
+    const char *footer = "endsolid Blender\n";
+    ok = fwrite(footer, 1, strlen(footer), file) == strlen(footer);
+  }
+  return (fclose(file) == 0) && ok;
+}
+
+}  // namespace blender::io::stl
+
+bool STL_export(bContext *C, const char *filepath, const STLExportParams *params)
+{
+  return blender::io::stl::export_file(C, filepath, *params);
+}
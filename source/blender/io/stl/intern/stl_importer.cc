@@ -0,0 +1,216 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_stl.h"
+
+#include <cstring>
+
+#include "DNA_object_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_array_parallel.h"
+#include "BLI_endian_switch.h"
+#include "BLI_float3.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_mesh.h"
+
+#include "IO_mapped_file.hh"
+#include "IO_mesh_builder.hh"
+#include "IO_string_utils.hh"
+
+/* STL files store the positions of the three corners of every triangle, the vertices shared by
+ * the triangles are found by sorting the corners by a hash of their position. */
+
+namespace blender::io::stl {
+
+static constexpr int64_t binary_header_size = 84;
+static constexpr int64_t binary_triangle_size = 50;
+static constexpr int64_t chunk_size = 1 << 20;
+
+static bool is_binary_file(const Span<char> data)
+{
+  if (data.size() < binary_header_size) {
+    return false;
+  }
+  uint32_t triangles_num;
+  memcpy(&triangles_num, data.data() + 80, sizeof(triangles_num));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&triangles_num);
+  }
+  /* Some binary files start with "solid" as well, their size tells them apart. */
+  return data.size() == binary_header_size + binary_triangle_size * int64_t(triangles_num);
+}
+
+static Array<float3> read_binary_corners(const Span<char> data, const float scale)
+{
+  const int64_t triangles_num = (data.size() - binary_header_size) / binary_triangle_size;
+  Array<float3> corners(triangles_num * 3);
+  parallel_for(IndexRange(triangles_num), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      /* The positions come after the normal of the triangle. */
+      const char *triangle = data.data() + binary_header_size + i * binary_triangle_size + 12;
+      for (const int j : IndexRange(3)) {
+        float3 &co = corners[i * 3 + j];
+        memcpy(&co, triangle + j * 12, sizeof(float3));
+        if (ENDIAN_ORDER == B_ENDIAN) {
+          BLI_endian_switch_float_array(co, 3);
+        }
+        co *= scale;
+      }
+    }
+  });
+  return corners;
+}
+
+static Array<float3> read_ascii_corners(const StringRef text, const float scale)
+{
+  const Vector<StringRef> texts = split_in_line_chunks(text, chunk_size);
+  Array<Vector<float3>> chunks(texts.size());
+  parallel_for(texts.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      StringRef chunk_text = texts[i];
+      while (!chunk_text.is_empty()) {
+        const StringRef line = drop_whitespace(read_next_line(chunk_text));
+        if (line.startswith("vertex")) {
+          float3 co;
+          parse_floats(line.drop_prefix(6), 0.0f, co, 3);
+          chunks[i].append(co * scale);
+        }
+      }
+    }
+  });
+
+  int64_t corners_num = 0;
+  for (const Vector<float3> &chunk : chunks) {
+    corners_num += chunk.size();
+  }
+  /* Incomplete triangles at the end of the file are ignored. */
+  Array<float3> corners(corners_num - corners_num % 3);
+  int64_t offset = 0;
+  for (const Vector<float3> &chunk : chunks) {
+    const int64_t size = std::min(chunk.size(), corners.size() - offset);
+    std::copy(chunk.begin(), chunk.begin() + size, corners.begin() + offset);
+    offset += size;
+  }
+  return corners;
+}
+
+static uint64_t position_key(const float3 &co)
+{
+  uint64_t hash = 0;
+  for (const int i : IndexRange(3)) {
+    /* Adding zero turns negative zeros into positive ones. */
+    const float value = co[i] + 0.0f;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    hash = (hash ^ bits) * 0x100000001b3ull;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+/* The vertices are the distinct positions of the corners. Corners with the same key are next to
+ * each other once sorted, their positions are compared to tell apart the collisions. */
+static void merge_corners(Span<float3> corners, MeshBuilder &r_builder)
+{
+  const int corners_num = static_cast<int>(corners.size());
+  Array<uint64_t> keys(corners_num);
+  parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      keys[i] = position_key(corners[i]);
+    }
+  });
+  Array<int> sorted(corners_num);
+  BLI_array_sort_indices_by_key_u64(keys.data(), corners_num, sorted.data());
+
+  Array<int> corner_verts(corners_num);
+  int run_start = 0;
+  while (run_start < corners_num) {
+    const uint64_t key = keys[sorted[run_start]];
+    int run_end = run_start + 1;
+    while (run_end < corners_num && keys[sorted[run_end]] == key) {
+      run_end++;
+    }
+    const int run_first_vert = static_cast<int>(r_builder.positions.size());
+    for (const int i : IndexRange(run_start, run_end - run_start)) {
+      const float3 &co = corners[sorted[i]];
+      int vert = run_first_vert;
+      while (vert < r_builder.positions.size() && r_builder.positions[vert] != co) {
+        vert++;
+      }
+      if (vert == r_builder.positions.size()) {
+        r_builder.positions.append(co);
+      }
+      corner_verts[sorted[i]] = vert;
+    }
+    run_start = run_end;
+  }
+
+  for (int i = 0; i < corners_num; i += 3) {
+    const int *tri = &corner_verts[i];
+    /* The triangles that have collapsed to a line or a point are dropped. */
+    if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0]) {
+      continue;
+    }
+    r_builder.face_sizes.append(3);
+    r_builder.corner_verts.extend({tri[0], tri[1], tri[2]});
+  }
+}
+
+static bool import_file(bContext *C, const char *filepath, const STLImportParams &params)
+{
+  MappedFile file(filepath);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  const Array<float3> corners = is_binary_file(file.data()) ?
+                                    read_binary_corners(file.data(), params.global_scale) :
+                                    read_ascii_corners(file.text(), params.global_scale);
+  if (corners.is_empty()) {
+    return false;
+  }
+
+  MeshBuilder builder;
+  merge_corners(corners, builder);
+
+  char name[FILE_MAX];
+  BLI_strncpy(name, BLI_path_basename(filepath), sizeof(name));
+  BLI_path_extension_replace(name, sizeof(name), "");
+
+  Main *bmain = CTX_data_main(C);
+  Object *ob = import_add_mesh_object(bmain, name, builder.build(), {});
+  if (params.validate_meshes) {
+    BKE_mesh_validate(static_cast<Mesh *>(ob->data), false, false);
+  }
+  import_link_objects(bmain, CTX_data_view_layer(C), {ob});
+  return true;
+}
+
+}  // namespace blender::io::stl
+
+bool STL_import(bContext *C, const char *filepath, const STLImportParams *params)
+{
+  return blender::io::stl::import_file(C, filepath, *params);
+}
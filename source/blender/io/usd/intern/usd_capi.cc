@@ -19,33 +19,58 @@
 
 #include "usd.h"
 #include "usd_hierarchy_iterator.h"
+#include "usd_reader_instance.h"
+#include "usd_reader_mesh.h"
+#include "usd_reader_stage.h"
+#include "usd_reader_xform.h"
 
 #include <pxr/base/plug/registry.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/tokens.h>
 
+#include <cmath>
+#include <iostream>
+#include <map>
+
 #include "MEM_guardedalloc.h"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "DNA_cachefile_types.h"
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "BKE_appdir.h"
 #include "BKE_blender_version.h"
+#include "BKE_cachefile.h"
+#include "BKE_collection.h"
 #include "BKE_context.h"
 #include "BKE_global.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_object.h"
 #include "BKE_scene.h"
 
 #include "BLI_fileops.h"
+#include "BLI_math_matrix.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+
+#include "ED_undo.h"
 
 #include "WM_api.h"
 #include "WM_types.h"
 
+struct CacheArchiveHandle {
+  int unused;
+};
+
 namespace blender::io::usd {
 
 struct ExportJobData {
@@ -183,8 +208,323 @@ static void export_endjob(void *customdata)
   WM_set_locked_interface(data->wm, false);
 }
 
+struct ImportJobData {
+  bContext *C;
+  Main *bmain;
+  Scene *scene;
+  ViewLayer *view_layer;
+  wmWindowManager *wm;
+
+  char filename[FILE_MAX];
+  USDImportParams params;
+
+  USDStageReader *stage_reader;
+
+  short *stop;
+  short *do_update;
+  float *progress;
+
+  bool stage_fail;
+  bool was_cancelled;
+  bool import_ok;
+  bool is_background_job;
+};
+
+/* The readers of the prims of the stage followed by those of the prototypes. */
+static std::vector<USDPrimReader *> import_readers_get(const USDStageReader &stage_reader)
+{
+  std::vector<USDPrimReader *> readers = stage_reader.readers();
+  for (const pxr::SdfPath &master_path : stage_reader.prototype_paths()) {
+    const std::vector<USDPrimReader *> &prototype_readers = stage_reader.prototype_readers(
+        master_path);
+    readers.insert(readers.end(), prototype_readers.begin(), prototype_readers.end());
+  }
+  return readers;
+}
+
+static void import_startjob(void *customdata, short *stop, short *do_update, float *progress)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+
+  data->stop = stop;
+  data->do_update = do_update;
+  data->progress = progress;
+
+  WM_set_locked_interface(data->wm, true);
+
+  USDStageReader *stage_reader = new USDStageReader(data->filename);
+  data->stage_reader = stage_reader;
+
+  if (!stage_reader->valid()) {
+    data->stage_fail = true;
+    return;
+  }
+
+  CacheFile *cache_file = static_cast<CacheFile *>(
+      BKE_cachefile_add(data->bmain, BLI_path_basename(data->filename)));
+
+  /* Decrement the ID ref-count because it is going to be incremented for each
+   * modifier and constraint that it will be attached to, so since currently
+   * it is not used by anyone, its use count will off by one. */
+  id_us_min(&cache_file->id);
+
+  cache_file->type = CACHEFILE_TYPE_USD;
+  cache_file->scale = data->params.scale;
+  STRNCPY(cache_file->filepath, data->filename);
+
+  ImportSettings &settings = stage_reader->settings();
+  settings.scale = data->params.scale;
+  settings.validate_meshes = data->params.validate_meshes;
+  settings.use_instancing = data->params.use_instancing;
+  settings.defer_mesh_loading = data->params.defer_mesh_loading;
+  settings.cache_file = cache_file;
+
+  *data->do_update = true;
+  *data->progress = 0.05f;
+
+  stage_reader->collect_readers();
+
+  if (G.is_break) {
+    data->was_cancelled = true;
+    return;
+  }
+
+  *data->do_update = true;
+  *data->progress = 0.1f;
+
+  const std::vector<USDPrimReader *> readers = import_readers_get(*stage_reader);
+  const float size = static_cast<float>(readers.size());
+  size_t i = 0;
+
+  /* Objects and their data are added to Main, one after the other. */
+  for (USDPrimReader *reader : readers) {
+    if (reader->valid()) {
+      reader->create_object(data->bmain);
+    }
+    else {
+      std::cerr << "Prim " << reader->object_path() << " in USD file " << data->filename
+                << " is invalid.\n";
+    }
+
+    *data->progress = 0.1f + 0.2f * (++i / size);
+    *data->do_update = true;
+
+    if (G.is_break) {
+      data->was_cancelled = true;
+      return;
+    }
+  }
+
+  /* Reading the data of the objects only changes the objects themselves, which is done in
+   * parallel since most of the import time is spent there for large stages. */
+  const pxr::UsdStageRefPtr stage = stage_reader->stage();
+  const double time = stage->GetStartTimeCode();
+  parallel_for(IndexRange(readers.size()), 16, [&](const IndexRange range) {
+    for (const int64_t index : range) {
+      if (readers[index]->object() != nullptr) {
+        readers[index]->read_object_data(time);
+      }
+    }
+  });
+
+  if (G.is_break) {
+    data->was_cancelled = true;
+    return;
+  }
+
+  *data->do_update = true;
+  *data->progress = 0.7f;
+
+  if (data->params.set_frame_range && stage->HasAuthoredTimeCodeRange()) {
+    Scene *scene = data->scene;
+    const double frames_per_time_code = FPS / settings.time_codes_per_second;
+    SFRA = static_cast<int>(round(stage->GetStartTimeCode() * frames_per_time_code));
+    EFRA = static_cast<int>(round(stage->GetEndTimeCode() * frames_per_time_code));
+    CFRA = SFRA;
+  }
+
+  /* Setup parenthood. */
+  for (const USDPrimReader *reader : readers) {
+    const USDPrimReader *parent_reader = reader->parent();
+    Object *ob = reader->object();
+    if (ob == nullptr) {
+      continue;
+    }
+
+    if (parent_reader == nullptr || !reader->inherits_xform()) {
+      ob->parent = nullptr;
+    }
+    else {
+      ob->parent = parent_reader->object();
+    }
+  }
+
+  /* Setup transformations, materials, modifiers and constraints. */
+  i = 0;
+  for (USDPrimReader *reader : readers) {
+    if (reader->object() != nullptr) {
+      reader->setup_object(data->bmain, time);
+    }
+
+    *data->progress = 0.7f + 0.3f * (++i / size);
+    *data->do_update = true;
+
+    if (G.is_break) {
+      data->was_cancelled = true;
+      return;
+    }
+  }
+}
+
+static void import_link_object(ImportJobData *data, Collection *collection, Object *ob)
+{
+  BKE_collection_object_add(data->bmain, collection, ob);
+
+  DEG_id_tag_update_ex(data->bmain,
+                       &ob->id,
+                       ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+                           ID_RECALC_BASE_FLAGS);
+}
+
+static void import_endjob(void *customdata)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+  USDStageReader *stage_reader = data->stage_reader;
+
+  std::vector<USDPrimReader *> readers;
+  if (stage_reader != nullptr && stage_reader->valid()) {
+    readers = import_readers_get(*stage_reader);
+  }
+
+  /* Delete objects on cancellation. */
+  if (data->was_cancelled) {
+    for (USDPrimReader *reader : readers) {
+      Object *ob = reader->object();
+
+      /* It's possible that cancellation occurred between the creation of
+       * the reader and the creation of the Blender object. */
+      if (ob == nullptr) {
+        continue;
+      }
+
+      BKE_id_free_us(data->bmain, ob);
+    }
+  }
+  else if (!data->stage_fail) {
+    /* Add object to scene. */
+    ViewLayer *view_layer = data->view_layer;
+
+    BKE_view_layer_base_deselect_all(view_layer);
+
+    LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+
+    for (USDPrimReader *reader : stage_reader->readers()) {
+      Object *ob = reader->object();
+      if (ob == nullptr) {
+        continue;
+      }
+
+      import_link_object(data, lc->collection, ob);
+
+      Base *base = BKE_view_layer_base_find(view_layer, ob);
+      BKE_view_layer_base_select_and_set_active(view_layer, base);
+    }
+    DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+
+    /* The objects of every prototype are in a collection that is not part of the scene, and
+     * instanced by the objects of the instances. The collections are added from the main thread,
+     * since this synchronizes the view layers. */
+    std::map<pxr::SdfPath, Collection *> prototype_collections;
+    for (const pxr::SdfPath &master_path : stage_reader->prototype_paths()) {
+      const std::string name = stage_reader->prototype_instance_path(master_path).GetName();
+      Collection *collection = BKE_collection_add(data->bmain, nullptr, name.c_str());
+      prototype_collections[master_path] = collection;
+
+      for (USDPrimReader *reader : stage_reader->prototype_readers(master_path)) {
+        if (reader->object() != nullptr) {
+          import_link_object(data, collection, reader->object());
+        }
+      }
+      DEG_id_tag_update(&collection->id, ID_RECALC_COPY_ON_WRITE);
+    }
+
+    for (USDPrimReader *reader : readers) {
+      if (USDInstanceReader *instance_reader = dynamic_cast<USDInstanceReader *>(reader)) {
+        instance_reader->set_instance_collection(
+            prototype_collections[instance_reader->master_path()]);
+      }
+    }
+
+    DEG_id_tag_update(&data->scene->id, ID_RECALC_BASE_FLAGS);
+    DEG_relations_tag_update(data->bmain);
+
+    if (data->is_background_job) {
+      /* Blender already returned from the import operator, so we need to store our own extra undo
+       * step. */
+      ED_undo_push(data->C, "USD Import Finished");
+    }
+  }
+
+  if (stage_reader != nullptr) {
+    stage_reader->clear_readers();
+  }
+
+  WM_set_locked_interface(data->wm, false);
+
+  if (data->stage_fail) {
+    WM_reportf(RPT_ERROR, "USD Import: unable to open stage to read %s", data->filename);
+  }
+  else {
+    data->import_ok = !data->was_cancelled;
+  }
+
+  WM_main_add_notifier(NC_SCENE | ND_FRAME, data->scene);
+}
+
+static void import_freejob(void *customdata)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+  delete data->stage_reader;
+  delete data;
+}
+
+BLI_INLINE USDStageReader *stage_reader_from_handle(CacheArchiveHandle *handle)
+{
+  return reinterpret_cast<USDStageReader *>(handle);
+}
+
+BLI_INLINE CacheArchiveHandle *handle_from_stage_reader(USDStageReader *stage_reader)
+{
+  return reinterpret_cast<CacheArchiveHandle *>(stage_reader);
+}
+
+static USDPrimReader *get_usd_reader(CacheReader *reader, Object *ob, const char **err_str)
+{
+  USDPrimReader *usd_reader = reinterpret_cast<USDPrimReader *>(reader);
+
+  if (!usd_reader->valid()) {
+    *err_str = "Invalid object: verify object path";
+    return nullptr;
+  }
+
+  if (!usd_reader->accepts_object_type(ob, err_str)) {
+    /* err_str is set by accepts_object_type() */
+    return nullptr;
+  }
+
+  return usd_reader;
+}
+
+/* Cache files give the time in seconds. */
+static double time_code_for_time(const USDPrimReader *usd_reader, const float time)
+{
+  return time * usd_reader->settings().time_codes_per_second;
+}
+
 }  // namespace blender::io::usd
 
+using namespace blender::io::usd;
+
 bool USD_export(bContext *C,
                 const char *filepath,
                 const USDExportParams *params,
@@ -237,6 +577,62 @@ bool USD_export(bContext *C,
   return export_ok;
 }
 
+bool USD_import(bContext *C,
+                const char *filepath,
+                const USDImportParams *params,
+                bool as_background_job)
+{
+  blender::io::usd::ensure_usd_plugin_path_registered();
+
+  /* Using new here since MEM_* functions do not call constructor to properly initialize data. */
+  ImportJobData *job = new ImportJobData();
+  job->C = C;
+  job->bmain = CTX_data_main(C);
+  job->scene = CTX_data_scene(C);
+  job->view_layer = CTX_data_view_layer(C);
+  job->wm = CTX_wm_manager(C);
+  job->import_ok = false;
+  BLI_strncpy(job->filename, filepath, sizeof(job->filename));
+
+  job->params = *params;
+  job->stage_reader = nullptr;
+  job->stage_fail = false;
+  job->was_cancelled = false;
+  job->is_background_job = as_background_job;
+
+  G.is_break = false;
+
+  bool import_ok = false;
+  if (as_background_job) {
+    wmJob *wm_job = WM_jobs_get(CTX_wm_manager(C),
+                                CTX_wm_window(C),
+                                job->scene,
+                                "USD Import",
+                                WM_JOB_PROGRESS,
+                                WM_JOB_TYPE_ALEMBIC);
+
+    /* setup job */
+    WM_jobs_customdata_set(wm_job, job, import_freejob);
+    WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_FRAME, NC_SCENE | ND_FRAME);
+    WM_jobs_callbacks(wm_job, import_startjob, nullptr, nullptr, import_endjob);
+
+    WM_jobs_start(CTX_wm_manager(C), wm_job);
+  }
+  else {
+    /* Fake a job context, so that we don't need NULL pointer checks while importing. */
+    short stop = 0, do_update = 0;
+    float progress = 0.0f;
+
+    import_startjob(job, &stop, &do_update, &progress);
+    import_endjob(job);
+    import_ok = job->import_ok;
+
+    import_freejob(job);
+  }
+
+  return import_ok;
+}
+
 int USD_get_version(void)
 {
   /* USD 19.11 defines:
@@ -250,3 +646,149 @@ int USD_get_version(void)
    */
   return PXR_VERSION;
 }
+
+/* ************************************************************************** */
+
+CacheArchiveHandle *USD_create_handle(Main * /*bmain*/,
+                                      const char *filename,
+                                      ListBase *object_paths)
+{
+  blender::io::usd::ensure_usd_plugin_path_registered();
+
+  USDStageReader *stage_reader = new USDStageReader(filename);
+
+  if (!stage_reader->valid()) {
+    delete stage_reader;
+    return nullptr;
+  }
+
+  if (object_paths) {
+    stage_reader->gather_object_paths(object_paths);
+  }
+
+  return handle_from_stage_reader(stage_reader);
+}
+
+void USD_free_handle(CacheArchiveHandle *handle)
+{
+  delete stage_reader_from_handle(handle);
+}
+
+void USD_get_transform(CacheReader *reader, float r_mat_world[4][4], float time, float scale)
+{
+  if (!reader) {
+    return;
+  }
+
+  USDXformReader *xform_reader = dynamic_cast<USDXformReader *>(
+      reinterpret_cast<USDPrimReader *>(reader));
+  if (xform_reader == nullptr) {
+    return;
+  }
+
+  bool is_constant = false;
+  const double time_code = time_code_for_time(xform_reader, time);
+
+  /* Like for Alembic, the local matrix is converted to world coordinates here rather than by
+   * Blender, see ABC_get_transform(). The prims of instances are relative to the instancing
+   * object, which is at the root. */
+  Object *object = xform_reader->object();
+  if (object->parent == nullptr) {
+    /* No parent, so local space is the same as world space. */
+    const bool is_root = !xform_reader->prim().IsInstanceProxy();
+    xform_reader->read_matrix(r_mat_world, time_code, scale, is_root, &is_constant);
+    return;
+  }
+
+  float mat_parent[4][4];
+  BKE_object_get_parent_matrix(object, object->parent, mat_parent);
+
+  float mat_local[4][4];
+  xform_reader->read_matrix(mat_local, time_code, scale, false, &is_constant);
+  mul_m4_m4m4(r_mat_world, mat_parent, object->parentinv);
+  mul_m4_m4m4(r_mat_world, r_mat_world, mat_local);
+}
+
+Mesh *USD_read_mesh(CacheReader *reader,
+                    Object *ob,
+                    Mesh *existing_mesh,
+                    const float time,
+                    const char **err_str,
+                    int read_flag)
+{
+  USDPrimReader *usd_reader = get_usd_reader(reader, ob, err_str);
+  USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(usd_reader);
+  if (mesh_reader == nullptr) {
+    return existing_mesh;
+  }
+
+  return mesh_reader->read_mesh(
+      existing_mesh, time_code_for_time(mesh_reader, time), read_flag, err_str);
+}
+
+bool USD_mesh_topology_changed(
+    CacheReader *reader, Object *ob, Mesh *existing_mesh, const float time, const char **err_str)
+{
+  USDPrimReader *usd_reader = get_usd_reader(reader, ob, err_str);
+  USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(usd_reader);
+  if (mesh_reader == nullptr) {
+    return false;
+  }
+
+  return mesh_reader->topology_changed(existing_mesh, time_code_for_time(mesh_reader, time));
+}
+
+void USD_CacheReader_free(CacheReader *reader)
+{
+  USDPrimReader *usd_reader = reinterpret_cast<USDPrimReader *>(reader);
+  usd_reader->decref();
+
+  if (usd_reader->refcount() == 0) {
+    delete usd_reader;
+  }
+}
+
+void USD_CacheReader_incref(CacheReader *reader)
+{
+  USDPrimReader *usd_reader = reinterpret_cast<USDPrimReader *>(reader);
+  usd_reader->incref();
+}
+
+CacheReader *CacheReader_open_usd_object(CacheArchiveHandle *handle,
+                                         CacheReader *reader,
+                                         Object *object,
+                                         const char *object_path)
+{
+  if (object_path[0] == '\0') {
+    return reader;
+  }
+
+  USDStageReader *stage_reader = stage_reader_from_handle(handle);
+
+  if (!stage_reader || !stage_reader->valid()) {
+    return reader;
+  }
+
+  pxr::UsdPrim prim;
+  if (pxr::SdfPath::IsValidPathString(object_path)) {
+    prim = stage_reader->stage()->GetPrimAtPath(pxr::SdfPath(object_path));
+  }
+
+  if (reader) {
+    USD_CacheReader_free(reader);
+  }
+
+  if (!prim) {
+    return nullptr;
+  }
+
+  USDPrimReader *usd_reader = stage_reader->create_reader(prim);
+  if (usd_reader == nullptr) {
+    /* This prim is not supported */
+    return nullptr;
+  }
+  usd_reader->object(object);
+  usd_reader->incref();
+
+  return reinterpret_cast<CacheReader *>(usd_reader);
+}
@@ -28,12 +28,14 @@
 #include "usd_writer_transform.h"
 
 #include <string>
+#include <vector>
 
 #include <pxr/base/tf/stringUtils.h>
 
 #include "BKE_duplilist.h"
 
 #include "BLI_assert.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DEG_depsgraph_query.h"
@@ -51,6 +53,35 @@ USDHierarchyIterator::USDHierarchyIterator(Depsgraph *depsgraph,
 {
 }
 
+void USDHierarchyIterator::iterate_and_write()
+{
+  AbstractHierarchyIterator::iterate_and_write();
+  write_deferred_data();
+}
+
+void USDHierarchyIterator::write_deferred_data()
+{
+  std::vector<USDAbstractWriter *> deferred_writers;
+  for (WriterMap::value_type it : writers_) {
+    USDAbstractWriter *usd_writer = static_cast<USDAbstractWriter *>(it.second);
+    if (usd_writer != nullptr && usd_writer->has_deferred_data()) {
+      deferred_writers.push_back(usd_writer);
+    }
+  }
+
+  /* Extracting the data only reads the evaluated objects, while authoring the stage is not
+   * thread-safe. The writers are visited in the order of their export path, so that the file does
+   * not depend on the scheduling of the threads. */
+  parallel_for(IndexRange(deferred_writers.size()), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      deferred_writers[i]->prepare_deferred();
+    }
+  });
+  for (USDAbstractWriter *usd_writer : deferred_writers) {
+    usd_writer->write_deferred();
+  }
+}
+
 bool USDHierarchyIterator::mark_as_weak_export(const Object *object) const
 {
   if (params_.selected_objects_only && (object->base_flag & BASE_SELECTED) == 0) {
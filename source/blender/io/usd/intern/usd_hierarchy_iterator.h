@@ -50,6 +50,8 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
   void set_export_frame(float frame_nr);
   const pxr::UsdTimeCode &get_export_time_code() const;
 
+  virtual void iterate_and_write() override;
+
   virtual std::string make_valid_name(const std::string &name) const override;
 
  protected:
@@ -66,6 +68,9 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
 
  private:
   USDExporterContext create_usd_export_context(const HierarchyContext *context);
+
+  /* Extract the data of the writers that deferred it in parallel, then write it to the stage. */
+  void write_deferred_data();
 };
 
 }  // namespace blender::io::usd
@@ -0,0 +1,45 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "usd_reader_xform.h"
+
+#include <pxr/usd/sdf/path.h>
+
+struct Collection;
+
+namespace blender::io::usd {
+
+/* Reader of instanced prims, imported as empties instancing the collection made of the objects
+ * of the prototype, when instancing is used by the import. */
+class USDInstanceReader : public USDXformReader {
+ public:
+  USDInstanceReader(const pxr::UsdPrim &prim, const ImportSettings &settings);
+
+  bool valid() const override;
+
+  void create_object(Main *bmain) override;
+
+  /* Path of the master prim of the instance, which holds its prototype. */
+  pxr::SdfPath master_path() const;
+
+  void set_instance_collection(Collection *collection);
+};
+
+}  // namespace blender::io::usd
@@ -0,0 +1,464 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_reader_mesh.h"
+
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usdGeom/primvarsAPI.h>
+#include <pxr/usd/usdGeom/subset.h>
+#include <pxr/usd/usdShade/material.h>
+#include <pxr/usd/usdShade/materialBindingAPI.h>
+
+#include <iostream>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_customdata_types.h"
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_vector.h"
+
+#include "BKE_customdata.h"
+#include "BKE_main.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+namespace blender::io::usd {
+
+/* Some helpers for mesh generation */
+namespace utils {
+
+static std::map<std::string, Material *> build_material_map(const Main *bmain)
+{
+  std::map<std::string, Material *> mat_map;
+  LISTBASE_FOREACH (Material *, material, &bmain->materials) {
+    mat_map[material->id.name + 2] = material;
+  }
+  return mat_map;
+}
+
+static void assign_materials(Main *bmain,
+                             Object *ob,
+                             const std::map<std::string, int> &mat_index_map)
+{
+  std::map<std::string, int>::const_iterator it;
+  for (it = mat_index_map.begin(); it != mat_index_map.end(); ++it) {
+    if (!BKE_object_material_slot_add(bmain, ob)) {
+      return;
+    }
+  }
+
+  std::map<std::string, Material *> matname_to_material = build_material_map(bmain);
+  std::map<std::string, Material *>::iterator mat_iter;
+
+  for (it = mat_index_map.begin(); it != mat_index_map.end(); ++it) {
+    const std::string mat_name = it->first;
+    const int mat_index = it->second;
+
+    Material *assigned_mat;
+    mat_iter = matname_to_material.find(mat_name);
+    if (mat_iter == matname_to_material.end()) {
+      assigned_mat = BKE_material_add(bmain, mat_name.c_str());
+      matname_to_material[mat_name] = assigned_mat;
+    }
+    else {
+      assigned_mat = mat_iter->second;
+    }
+
+    BKE_object_material_assign(bmain, ob, assigned_mat, mat_index, BKE_MAT_ASSIGN_OBDATA);
+  }
+}
+
+} /* namespace utils */
+
+/* Index in the USD face vertices of a loop of the polygon. The winding of left handed meshes is
+ * the opposite of Blender's, their face vertices are reversed. */
+static int usd_loop_index(const MPoly &poly, const int j, const bool left_handed)
+{
+  return poly.loopstart + (left_handed ? poly.totloop - 1 - j : j);
+}
+
+static bool is_uv_primvar(const pxr::UsdGeomPrimvar &primvar)
+{
+  const pxr::SdfValueTypeName type_name = primvar.GetTypeName();
+  return type_name == pxr::SdfValueTypeNames->TexCoord2fArray ||
+         type_name == pxr::SdfValueTypeNames->Float2Array;
+}
+
+static void read_uvs(Mesh *mesh,
+                     const pxr::UsdGeomMesh &mesh_prim,
+                     const pxr::UsdTimeCode time,
+                     const bool left_handed)
+{
+  const pxr::UsdGeomPrimvarsAPI primvars_api(mesh_prim.GetPrim());
+  for (const pxr::UsdGeomPrimvar &primvar : primvars_api.GetPrimvars()) {
+    if (!is_uv_primvar(primvar)) {
+      continue;
+    }
+
+    pxr::VtVec2fArray uvs;
+    if (!primvar.ComputeFlattened(&uvs, time)) {
+      continue;
+    }
+
+    const pxr::TfToken interpolation = primvar.GetInterpolation();
+    const bool is_face_varying = interpolation == pxr::UsdGeomTokens->faceVarying &&
+                                 uvs.size() == mesh->totloop;
+    const bool is_vertex = (interpolation == pxr::UsdGeomTokens->vertex ||
+                            interpolation == pxr::UsdGeomTokens->varying) &&
+                           uvs.size() == mesh->totvert;
+    if (!is_face_varying && !is_vertex) {
+      continue;
+    }
+
+    const std::string name = primvar.GetBaseName().GetString();
+    MLoopUV *mloopuv = static_cast<MLoopUV *>(
+        CustomData_get_layer_named(&mesh->ldata, CD_MLOOPUV, name.c_str()));
+    if (mloopuv == nullptr) {
+      if (CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV) >= MAX_MTFACE) {
+        continue;
+      }
+      mloopuv = static_cast<MLoopUV *>(CustomData_add_layer_named(
+          &mesh->ldata, CD_MLOOPUV, CD_DEFAULT, nullptr, mesh->totloop, name.c_str()));
+    }
+
+    for (int i = 0; i < mesh->totpoly; i++) {
+      const MPoly &poly = mesh->mpoly[i];
+      for (int j = 0; j < poly.totloop; j++) {
+        const int loop_index = poly.loopstart + j;
+        const int uv_index = is_face_varying ? usd_loop_index(poly, j, left_handed) :
+                                               mesh->mloop[loop_index].v;
+        copy_v2_v2(mloopuv[loop_index].uv, uvs[uv_index].data());
+      }
+    }
+  }
+}
+
+static void process_normals(Mesh *mesh,
+                            const pxr::UsdGeomMesh &mesh_prim,
+                            const pxr::UsdTimeCode time,
+                            const bool left_handed)
+{
+  pxr::VtVec3fArray normals;
+  mesh_prim.GetNormalsAttr().Get(&normals, time);
+
+  const pxr::TfToken interpolation = mesh_prim.GetNormalsInterpolation();
+  if (interpolation == pxr::UsdGeomTokens->faceVarying && !normals.empty() &&
+      normals.size() == mesh->totloop) {
+    float(*lnors)[3] = static_cast<float(*)[3]>(
+        MEM_malloc_arrayN(mesh->totloop, sizeof(float[3]), "USD::LoopNormals"));
+    for (int i = 0; i < mesh->totpoly; i++) {
+      const MPoly &poly = mesh->mpoly[i];
+      for (int j = 0; j < poly.totloop; j++) {
+        const int usd_index = usd_loop_index(poly, j, left_handed);
+        copy_v3_v3(lnors[poly.loopstart + j], normals[usd_index].data());
+      }
+    }
+    mesh->flag |= ME_AUTOSMOOTH;
+    BKE_mesh_set_custom_normals(mesh, lnors);
+    MEM_freeN(lnors);
+  }
+  else if ((interpolation == pxr::UsdGeomTokens->vertex ||
+            interpolation == pxr::UsdGeomTokens->varying) &&
+           !normals.empty() && normals.size() == mesh->totvert) {
+    float(*vnors)[3] = static_cast<float(*)[3]>(
+        MEM_malloc_arrayN(mesh->totvert, sizeof(float[3]), "USD::VertexNormals"));
+    for (int i = 0; i < mesh->totvert; i++) {
+      copy_v3_v3(vnors[i], normals[i].data());
+    }
+    mesh->flag |= ME_AUTOSMOOTH;
+    BKE_mesh_set_custom_normals_from_vertices(mesh, vnors);
+    MEM_freeN(vnors);
+  }
+  else {
+    /* Absence of normals in the USD mesh is interpreted as 'smooth'. Normals that do not match
+     * the mesh are ignored as well. */
+    BKE_mesh_calc_normals(mesh);
+  }
+}
+
+static bool face_vertices_are_valid(const int totvert,
+                                    const pxr::VtIntArray &face_counts,
+                                    const pxr::VtIntArray &face_indices)
+{
+  size_t loops_num = 0;
+  for (const int count : face_counts) {
+    if (count < 3) {
+      return false;
+    }
+    loops_num += count;
+  }
+  if (loops_num != face_indices.size()) {
+    return false;
+  }
+  for (const int index : face_indices) {
+    if (index < 0 || index >= totvert) {
+      return false;
+    }
+  }
+  return true;
+}
+
+USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim, const ImportSettings &settings)
+    : USDXformReader(prim, settings), mesh_prim_(prim), is_animated_(false)
+{
+}
+
+bool USDMeshReader::valid() const
+{
+  return static_cast<bool>(mesh_prim_);
+}
+
+bool USDMeshReader::accepts_object_type(const Object *ob, const char **err_str) const
+{
+  if (!mesh_prim_) {
+    *err_str =
+        "Object type mismatch, USD object path pointed to a mesh when importing, but not any "
+        "more.";
+    return false;
+  }
+
+  if (ob->type != OB_MESH) {
+    *err_str = "Object type mismatch, USD object path points to a mesh.";
+    return false;
+  }
+
+  return true;
+}
+
+void USDMeshReader::create_object(Main *bmain)
+{
+  Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
+
+  object_ = BKE_object_add_only_object(bmain, OB_MESH, name_.c_str());
+  object_->data = mesh;
+}
+
+void USDMeshReader::read_object_data(const double time)
+{
+  is_animated_ = is_animated();
+  assign_materials_to_polys(time, nullptr, 0, material_indices_);
+
+  if (settings_->defer_mesh_loading) {
+    /* The mesh is read by the cache modifier when the object is evaluated. */
+    return;
+  }
+
+  Mesh *mesh = static_cast<Mesh *>(object_->data);
+  Mesh *read_mesh = this->read_mesh(mesh, time, MOD_MESHSEQ_READ_ALL, nullptr);
+  if (read_mesh != mesh) {
+    /* XXX fixme after 2.80; mesh->flag isn't copied by BKE_mesh_nomain_to_mesh() */
+    /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
+    short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
+    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
+    mesh->flag |= autosmooth;
+  }
+
+  if (settings_->validate_meshes) {
+    BKE_mesh_validate(mesh, false, false);
+  }
+}
+
+void USDMeshReader::setup_object(Main *bmain, const double time)
+{
+  USDXformReader::setup_object(bmain, time);
+
+  if (!material_indices_.empty()) {
+    utils::assign_materials(bmain, object_, material_indices_);
+  }
+
+  if (is_animated_ || settings_->defer_mesh_loading) {
+    add_cache_modifier();
+  }
+}
+
+bool USDMeshReader::is_animated() const
+{
+  if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying() ||
+      mesh_prim_.GetFaceVertexCountsAttr().ValueMightBeTimeVarying() ||
+      mesh_prim_.GetFaceVertexIndicesAttr().ValueMightBeTimeVarying() ||
+      mesh_prim_.GetNormalsAttr().ValueMightBeTimeVarying()) {
+    return true;
+  }
+
+  const pxr::UsdGeomPrimvarsAPI primvars_api(prim_);
+  for (const pxr::UsdGeomPrimvar &primvar : primvars_api.GetPrimvars()) {
+    if (is_uv_primvar(primvar) && primvar.ValueMightBeTimeVarying()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool USDMeshReader::topology_changed(const Mesh *existing_mesh, const double time) const
+{
+  const pxr::UsdTimeCode time_code(time);
+  pxr::VtVec3fArray positions;
+  pxr::VtIntArray face_counts;
+  pxr::VtIntArray face_indices;
+  mesh_prim_.GetPointsAttr().Get(&positions, time_code);
+  mesh_prim_.GetFaceVertexCountsAttr().Get(&face_counts, time_code);
+  mesh_prim_.GetFaceVertexIndicesAttr().Get(&face_indices, time_code);
+
+  return positions.size() != existing_mesh->totvert ||
+         face_counts.size() != existing_mesh->totpoly ||
+         face_indices.size() != existing_mesh->totloop;
+}
+
+Mesh *USDMeshReader::read_mesh(Mesh *existing_mesh,
+                               const double time,
+                               const int read_flag,
+                               const char **err_str) const
+{
+  const pxr::UsdTimeCode time_code(time);
+  pxr::VtVec3fArray positions;
+  pxr::VtIntArray face_counts;
+  pxr::VtIntArray face_indices;
+  mesh_prim_.GetPointsAttr().Get(&positions, time_code);
+  mesh_prim_.GetFaceVertexCountsAttr().Get(&face_counts, time_code);
+  mesh_prim_.GetFaceVertexIndicesAttr().Get(&face_indices, time_code);
+
+  /* Face vertices out of bounds would be read outside of the vertex arrays. */
+  if (!face_vertices_are_valid(static_cast<int>(positions.size()), face_counts, face_indices)) {
+    if (err_str != nullptr) {
+      *err_str = "Invalid mesh; more detail on the console";
+    }
+    std::cerr << "USD: invalid mesh sample for '" << prim_.GetPath().GetString()
+              << "' at time code " << time << ", the face vertices do not match the points\n";
+    return existing_mesh;
+  }
+
+  const int totvert = static_cast<int>(positions.size());
+  const int totpoly = static_cast<int>(face_counts.size());
+  const int totloop = static_cast<int>(face_indices.size());
+
+  Mesh *new_mesh = nullptr;
+  int flag = read_flag;
+  if (totvert != existing_mesh->totvert || totpoly != existing_mesh->totpoly ||
+      totloop != existing_mesh->totloop) {
+    new_mesh = BKE_mesh_new_nomain_from_template(existing_mesh, totvert, 0, 0, totloop, totpoly);
+    flag |= MOD_MESHSEQ_READ_ALL;
+  }
+  Mesh *mesh = new_mesh ? new_mesh : existing_mesh;
+
+  pxr::TfToken orientation;
+  mesh_prim_.GetOrientationAttr().Get(&orientation);
+  const bool left_handed = orientation == pxr::UsdGeomTokens->leftHanded;
+
+  if ((flag & MOD_MESHSEQ_READ_VERT) != 0) {
+    for (int i = 0; i < totvert; i++) {
+      copy_v3_v3(mesh->mvert[i].co, positions[i].data());
+    }
+  }
+
+  if ((flag & MOD_MESHSEQ_READ_POLY) != 0) {
+    int loopstart = 0;
+    for (int i = 0; i < totpoly; i++) {
+      MPoly &poly = mesh->mpoly[i];
+      poly.loopstart = loopstart;
+      poly.totloop = face_counts[i];
+      poly.flag |= ME_SMOOTH;
+      for (int j = 0; j < poly.totloop; j++) {
+        mesh->mloop[loopstart + j].v = face_indices[usd_loop_index(poly, j, left_handed)];
+      }
+      loopstart += poly.totloop;
+    }
+    BKE_mesh_calc_edges(mesh, false, false);
+  }
+
+  if ((flag & (MOD_MESHSEQ_READ_VERT | MOD_MESHSEQ_READ_POLY)) != 0) {
+    process_normals(mesh, mesh_prim_, time_code, left_handed);
+  }
+
+  if ((flag & MOD_MESHSEQ_READ_UV) != 0) {
+    read_uvs(mesh, mesh_prim_, time_code, left_handed);
+  }
+
+  if (new_mesh) {
+    /* Here we assume that the number of materials doesn't change, i.e. that
+     * the material slots that were created when the object was loaded from
+     * USD are still valid now. */
+    if (totpoly > 0) {
+      std::map<std::string, int> mat_map;
+      assign_materials_to_polys(time, new_mesh->mpoly, totpoly, mat_map);
+    }
+
+    return new_mesh;
+  }
+
+  return existing_mesh;
+}
+
+void USDMeshReader::assign_materials_to_polys(const double time,
+                                              MPoly *mpoly,
+                                              const int totpoly,
+                                              std::map<std::string, int> &r_mat_map) const
+{
+  const std::vector<pxr::UsdGeomSubset> subsets = pxr::UsdGeomSubset::GetAllGeomSubsets(
+      mesh_prim_);
+
+  if (subsets.empty()) {
+    /* A material bound to the whole mesh is in the first slot, like the polygons. */
+    const pxr::UsdShadeMaterial material =
+        pxr::UsdShadeMaterialBindingAPI(prim_).ComputeBoundMaterial();
+    if (material) {
+      r_mat_map.emplace(material.GetPrim().GetName().GetString(), 1);
+    }
+    return;
+  }
+
+  for (const pxr::UsdGeomSubset &subset : subsets) {
+    const pxr::UsdShadeMaterial material =
+        pxr::UsdShadeMaterialBindingAPI(subset.GetPrim()).ComputeBoundMaterial();
+    if (!material) {
+      continue;
+    }
+
+    const std::string mat_name = material.GetPrim().GetName().GetString();
+    std::map<std::string, int>::const_iterator it = r_mat_map.find(mat_name);
+    int mat_index;
+    if (it == r_mat_map.end()) {
+      mat_index = static_cast<int>(r_mat_map.size()) + 1;
+      r_mat_map.emplace(mat_name, mat_index);
+    }
+    else {
+      mat_index = it->second;
+    }
+
+    if (mpoly == nullptr) {
+      continue;
+    }
+
+    pxr::VtIntArray indices;
+    subset.GetIndicesAttr().Get(&indices, pxr::UsdTimeCode(time));
+    for (const int face : indices) {
+      if (face >= 0 && face < totpoly) {
+        mpoly[face].mat_nr = static_cast<short>(mat_index - 1);
+      }
+    }
+  }
+}
+
+}  // namespace blender::io::usd
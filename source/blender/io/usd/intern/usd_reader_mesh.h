@@ -0,0 +1,66 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "usd_reader_xform.h"
+
+#include <pxr/usd/usdGeom/mesh.h>
+
+#include <map>
+
+struct MPoly;
+struct Mesh;
+
+namespace blender::io::usd {
+
+class USDMeshReader : public USDXformReader {
+ private:
+  pxr::UsdGeomMesh mesh_prim_;
+
+  /* Index of the material slot of every bound material by name, starting at 1 like the slots of
+   * BKE_object_material_assign(). Set by read_object_data(). */
+  std::map<std::string, int> material_indices_;
+  bool is_animated_;
+
+ public:
+  USDMeshReader(const pxr::UsdPrim &prim, const ImportSettings &settings);
+
+  bool valid() const override;
+  bool accepts_object_type(const Object *ob, const char **err_str) const override;
+
+  void create_object(Main *bmain) override;
+  void read_object_data(double time) override;
+  void setup_object(Main *bmain, double time) override;
+
+  /* Either modifies existing_mesh in-place or constructs a new mesh. */
+  Mesh *read_mesh(Mesh *existing_mesh, double time, int read_flag, const char **err_str) const;
+  bool topology_changed(const Mesh *existing_mesh, double time) const;
+
+ private:
+  bool is_animated() const;
+
+  /* Set the material index of the polygons from the geometry subsets bound to materials. The
+   * polygons are optional, to only find the materials. */
+  void assign_materials_to_polys(double time,
+                                 MPoly *mpoly,
+                                 int totpoly,
+                                 std::map<std::string, int> &r_mat_map) const;
+};
+
+}  // namespace blender::io::usd
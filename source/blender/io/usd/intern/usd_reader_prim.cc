@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_reader_prim.h"
+
+#include "BLI_assert.h"
+#include "BLI_math_matrix.h"
+
+namespace blender::io::usd {
+
+ImportSettings::ImportSettings()
+    : scale(1.0f),
+      time_codes_per_second(24.0),
+      validate_meshes(false),
+      use_instancing(false),
+      defer_mesh_loading(false),
+      cache_file(nullptr)
+{
+  unit_m4(conversion_mat);
+}
+
+USDPrimReader::USDPrimReader(const pxr::UsdPrim &prim, const ImportSettings &settings)
+    : prim_(prim),
+      name_(prim.GetName().GetString()),
+      object_path_(prim.GetPath().GetString()),
+      object_(nullptr),
+      settings_(&settings),
+      parent_reader_(nullptr),
+      refcount_(0)
+{
+}
+
+USDPrimReader::~USDPrimReader()
+{
+}
+
+const pxr::UsdPrim &USDPrimReader::prim() const
+{
+  return prim_;
+}
+
+const std::string &USDPrimReader::name() const
+{
+  return name_;
+}
+
+const ImportSettings &USDPrimReader::settings() const
+{
+  return *settings_;
+}
+
+const std::string &USDPrimReader::object_path() const
+{
+  return object_path_;
+}
+
+void USDPrimReader::object_path(const std::string &object_path)
+{
+  object_path_ = object_path;
+}
+
+Object *USDPrimReader::object() const
+{
+  return object_;
+}
+
+void USDPrimReader::object(Object *ob)
+{
+  object_ = ob;
+}
+
+USDPrimReader *USDPrimReader::parent() const
+{
+  return parent_reader_;
+}
+
+void USDPrimReader::parent(USDPrimReader *parent)
+{
+  parent_reader_ = parent;
+}
+
+bool USDPrimReader::valid() const
+{
+  return prim_.IsValid();
+}
+
+void USDPrimReader::read_object_data(double /*time*/)
+{
+}
+
+void USDPrimReader::setup_object(Main * /*bmain*/, double /*time*/)
+{
+}
+
+bool USDPrimReader::inherits_xform() const
+{
+  return true;
+}
+
+int USDPrimReader::refcount() const
+{
+  return refcount_;
+}
+
+void USDPrimReader::incref()
+{
+  refcount_++;
+}
+
+void USDPrimReader::decref()
+{
+  refcount_--;
+  BLI_assert(refcount_ >= 0);
+}
+
+}  // namespace blender::io::usd
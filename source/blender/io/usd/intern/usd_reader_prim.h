@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include <pxr/usd/usd/prim.h>
+
+#include <string>
+
+struct CacheFile;
+struct Main;
+struct Object;
+
+namespace blender::io::usd {
+
+struct ImportSettings {
+  /* Conversion from the space of the stage to Blender's, applied to the prims at its root: the
+   * rotation of stages with Y up. The scale is applied separately, since cache files have their
+   * own. */
+  float conversion_mat[4][4];
+  float scale;
+
+  double time_codes_per_second;
+  bool validate_meshes;
+  bool use_instancing;
+  bool defer_mesh_loading;
+
+  CacheFile *cache_file;
+
+  ImportSettings();
+};
+
+/* Import of a prim as a Blender object. The object is created by create_object(), which changes
+ * Main and is called for one reader after the other. Its data is then read by read_object_data(),
+ * which only changes the object and its data, and is called for many readers in parallel.
+ * setup_object() finally adds what needs Main again, like materials and cache modifiers.
+ *
+ * Readers are also used by the Mesh Sequence Cache modifier and the Transform Cache constraint,
+ * which share them through reference counting. */
+class USDPrimReader {
+ protected:
+  pxr::UsdPrim prim_;
+  std::string name_;
+  /* Path used to find the prim again in a cache file. It is the path of the prim, except for
+   * prims in the prototype of instances, which have no stable path. */
+  std::string object_path_;
+  Object *object_;
+
+  const ImportSettings *settings_;
+
+  USDPrimReader *parent_reader_;
+
+  /* Use reference counting since the same reader may be used by multiple
+   * modifiers and/or constraints. */
+  int refcount_;
+
+ public:
+  USDPrimReader(const pxr::UsdPrim &prim, const ImportSettings &settings);
+  virtual ~USDPrimReader();
+
+  const pxr::UsdPrim &prim() const;
+  const std::string &name() const;
+  const ImportSettings &settings() const;
+
+  const std::string &object_path() const;
+  void object_path(const std::string &object_path);
+
+  Object *object() const;
+  void object(Object *ob);
+
+  USDPrimReader *parent() const;
+  void parent(USDPrimReader *parent);
+
+  virtual bool valid() const;
+
+  /* Returns true when the object can be read by this reader, for readers opened by cache files
+   * on existing objects. */
+  virtual bool accepts_object_type(const Object *ob, const char **err_str) const = 0;
+
+  virtual void create_object(Main *bmain) = 0;
+  virtual void read_object_data(double time);
+  virtual void setup_object(Main *bmain, double time);
+
+  /* Whether the Blender parent of the object is the object of the parent reader. */
+  virtual bool inherits_xform() const;
+
+  int refcount() const;
+  void incref();
+  void decref();
+};
+
+}  // namespace blender::io::usd
@@ -0,0 +1,220 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_reader_stage.h"
+#include "usd_reader_instance.h"
+#include "usd_reader_mesh.h"
+#include "usd_reader_xform.h"
+
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/metrics.h>
+#include <pxr/usd/usdGeom/scope.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <utility>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_cachefile_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_string.h"
+
+namespace blender::io::usd {
+
+USDStageReader::USDStageReader(const char *filename)
+{
+  stage_ = pxr::UsdStage::Open(filename);
+  if (!stage_) {
+    return;
+  }
+
+  settings_.time_codes_per_second = stage_->GetTimeCodesPerSecond();
+  if (pxr::UsdGeomGetStageUpAxis(stage_) == pxr::UsdGeomTokens->y) {
+    axis_angle_to_mat4_single(settings_.conversion_mat, 'X', M_PI_2);
+  }
+}
+
+USDStageReader::~USDStageReader()
+{
+  clear_readers();
+}
+
+bool USDStageReader::valid() const
+{
+  return static_cast<bool>(stage_);
+}
+
+pxr::UsdStageRefPtr USDStageReader::stage() const
+{
+  return stage_;
+}
+
+ImportSettings &USDStageReader::settings()
+{
+  return settings_;
+}
+
+USDPrimReader *USDStageReader::create_reader(const pxr::UsdPrim &prim) const
+{
+  if (settings_.use_instancing && prim.IsInstance()) {
+    return new USDInstanceReader(prim, settings_);
+  }
+  if (prim.IsA<pxr::UsdGeomMesh>()) {
+    return new USDMeshReader(prim, settings_);
+  }
+  if (prim.IsA<pxr::UsdGeomXformable>() || prim.IsA<pxr::UsdGeomScope>()) {
+    return new USDXformReader(prim, settings_);
+  }
+  return nullptr;
+}
+
+void USDStageReader::collect_readers()
+{
+  clear_readers();
+  if (!stage_) {
+    return;
+  }
+
+  collect_readers(
+      stage_->GetPseudoRoot(), nullptr, pxr::SdfPath(), pxr::SdfPath(), readers_);
+
+  /* Prototypes can contain instances of other prototypes, which are added to the list while
+   * going through it. */
+  for (size_t i = 0; i < prototype_paths_.size(); i++) {
+    const pxr::SdfPath master_path = prototype_paths_[i];
+    const pxr::UsdPrim master = stage_->GetPrimAtPath(master_path);
+    std::vector<USDPrimReader *> readers;
+    if (master) {
+      collect_readers(
+          master, nullptr, master_path, prototype_instance_paths_[master_path], readers);
+    }
+    prototype_readers_[master_path] = std::move(readers);
+  }
+}
+
+void USDStageReader::collect_readers(const pxr::UsdPrim &prim,
+                                     USDPrimReader *parent_reader,
+                                     const pxr::SdfPath &master_path,
+                                     const pxr::SdfPath &instance_path,
+                                     std::vector<USDPrimReader *> &r_readers)
+{
+  pxr::Usd_PrimFlagsPredicate predicate = pxr::UsdPrimDefaultPredicate;
+  if (!settings_.use_instancing) {
+    /* Import the prims of the instances as copies of their prototype. */
+    predicate = pxr::UsdTraverseInstanceProxies(predicate);
+  }
+
+  for (const pxr::UsdPrim &child : prim.GetFilteredChildren(predicate)) {
+    USDPrimReader *reader = create_reader(child);
+    if (reader == nullptr) {
+      /* Prims like materials are not imported, but their descendants may be. */
+      collect_readers(child, parent_reader, master_path, instance_path, r_readers);
+      continue;
+    }
+
+    if (!master_path.IsEmpty()) {
+      /* The prims of prototypes are found in cache files by the path of the first instance. */
+      reader->object_path(child.GetPath().ReplacePrefix(master_path, instance_path).GetString());
+    }
+    reader->parent(parent_reader);
+    reader->incref();
+    r_readers.push_back(reader);
+
+    if (USDInstanceReader *instance_reader = dynamic_cast<USDInstanceReader *>(reader)) {
+      const pxr::SdfPath instance_master_path = instance_reader->master_path();
+      if (prototype_instance_paths_
+              .emplace(instance_master_path, pxr::SdfPath(instance_reader->object_path()))
+              .second) {
+        prototype_paths_.push_back(instance_master_path);
+      }
+      continue;
+    }
+
+    collect_readers(child, reader, master_path, instance_path, r_readers);
+  }
+}
+
+static void free_readers(std::vector<USDPrimReader *> &readers)
+{
+  for (USDPrimReader *reader : readers) {
+    reader->decref();
+    if (reader->refcount() == 0) {
+      delete reader;
+    }
+  }
+  readers.clear();
+}
+
+void USDStageReader::clear_readers()
+{
+  free_readers(readers_);
+  for (auto &item : prototype_readers_) {
+    free_readers(item.second);
+  }
+  prototype_paths_.clear();
+  prototype_readers_.clear();
+  prototype_instance_paths_.clear();
+}
+
+const std::vector<USDPrimReader *> &USDStageReader::readers() const
+{
+  return readers_;
+}
+
+const std::vector<pxr::SdfPath> &USDStageReader::prototype_paths() const
+{
+  return prototype_paths_;
+}
+
+const std::vector<USDPrimReader *> &USDStageReader::prototype_readers(
+    const pxr::SdfPath &master_path) const
+{
+  return prototype_readers_.at(master_path);
+}
+
+const pxr::SdfPath &USDStageReader::prototype_instance_path(const pxr::SdfPath &master_path) const
+{
+  return prototype_instance_paths_.at(master_path);
+}
+
+void USDStageReader::gather_object_paths(ListBase *object_paths) const
+{
+  if (!stage_) {
+    return;
+  }
+
+  for (const pxr::UsdPrim &prim : stage_->Traverse(pxr::UsdTraverseInstanceProxies())) {
+    if (!prim.IsA<pxr::UsdGeomXformable>() && !prim.IsA<pxr::UsdGeomScope>()) {
+      continue;
+    }
+
+    void *usd_path_void = MEM_callocN(sizeof(AlembicObjectPath), "AlembicObjectPath");
+    AlembicObjectPath *usd_path = static_cast<AlembicObjectPath *>(usd_path_void);
+
+    BLI_strncpy(usd_path->path, prim.GetPath().GetString().c_str(), sizeof(usd_path->path));
+    BLI_addtail(object_paths, usd_path);
+  }
+}
+
+}  // namespace blender::io::usd
@@ -0,0 +1,82 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "usd_reader_prim.h"
+
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <map>
+#include <vector>
+
+struct ListBase;
+
+namespace blender::io::usd {
+
+/* The stage opened by the import and by cache files, and the readers of its prims. */
+class USDStageReader {
+ private:
+  pxr::UsdStageRefPtr stage_;
+  ImportSettings settings_;
+
+  /* Readers of the prims of the stage, parents before their children. */
+  std::vector<USDPrimReader *> readers_;
+
+  /* Readers of the prims of the prototypes of instances, when instancing is used. The prototypes
+   * are in the order they are found in, and stored by the path of their master prim. */
+  std::vector<pxr::SdfPath> prototype_paths_;
+  std::map<pxr::SdfPath, std::vector<USDPrimReader *>> prototype_readers_;
+  /* Path of the first instance of every prototype, without any master prim in it. */
+  std::map<pxr::SdfPath, pxr::SdfPath> prototype_instance_paths_;
+
+ public:
+  USDStageReader(const char *filename);
+  ~USDStageReader();
+
+  bool valid() const;
+
+  pxr::UsdStageRefPtr stage() const;
+  ImportSettings &settings();
+
+  /* Create the readers of all prims that are imported. */
+  void collect_readers();
+  void clear_readers();
+
+  const std::vector<USDPrimReader *> &readers() const;
+  const std::vector<pxr::SdfPath> &prototype_paths() const;
+  const std::vector<USDPrimReader *> &prototype_readers(const pxr::SdfPath &master_path) const;
+  const pxr::SdfPath &prototype_instance_path(const pxr::SdfPath &master_path) const;
+
+  /* Reader of a single prim, or nullptr when the type of prim is not imported. */
+  USDPrimReader *create_reader(const pxr::UsdPrim &prim) const;
+
+  /* Add the path of every prim that can be read by a cache file to the list of
+   * #AlembicObjectPath. */
+  void gather_object_paths(ListBase *object_paths) const;
+
+ private:
+  void collect_readers(const pxr::UsdPrim &prim,
+                       USDPrimReader *parent_reader,
+                       const pxr::SdfPath &master_path,
+                       const pxr::SdfPath &instance_path,
+                       std::vector<USDPrimReader *> &r_readers);
+};
+
+}  // namespace blender::io::usd
@@ -0,0 +1,151 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_reader_xform.h"
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include "DNA_cachefile_types.h"
+#include "DNA_constraint_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_space_types.h" /* for FILE_MAX */
+
+#include "BKE_constraint.h"
+#include "BKE_lib_id.h"
+#include "BKE_modifier.h"
+#include "BKE_object.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.h"
+#include "BLI_string.h"
+
+namespace blender::io::usd {
+
+USDXformReader::USDXformReader(const pxr::UsdPrim &prim, const ImportSettings &settings)
+    : USDPrimReader(prim, settings), resets_xform_stack_(false)
+{
+  pxr::UsdGeomXformable xformable(prim_);
+  if (xformable) {
+    resets_xform_stack_ = xformable.GetResetXformStack();
+  }
+}
+
+bool USDXformReader::accepts_object_type(const Object *ob, const char **err_str) const
+{
+  if (ob->type != OB_EMPTY) {
+    *err_str = "Object type mismatch, USD object path points to a transform.";
+    return false;
+  }
+  return true;
+}
+
+void USDXformReader::create_object(Main *bmain)
+{
+  object_ = BKE_object_add_only_object(bmain, OB_EMPTY, name_.c_str());
+  object_->data = nullptr;
+}
+
+void USDXformReader::setup_object(Main * /*bmain*/, const double time)
+{
+  bool is_constant = true;
+  float mat[4][4];
+  read_matrix(mat, time, settings_->scale, is_root(), &is_constant);
+
+  BKE_object_apply_mat4(object_, mat, true, false);
+  BKE_object_to_mat4(object_, object_->obmat);
+
+  if (!is_constant) {
+    add_cache_constraint();
+  }
+}
+
+bool USDXformReader::inherits_xform() const
+{
+  return !resets_xform_stack_;
+}
+
+bool USDXformReader::is_root() const
+{
+  if (prim_.IsInMaster()) {
+    return false;
+  }
+  return parent_reader_ == nullptr || resets_xform_stack_;
+}
+
+void USDXformReader::read_matrix(float r_mat[4][4],
+                                 const double time,
+                                 const float scale,
+                                 const bool is_root,
+                                 bool *r_is_constant) const
+{
+  unit_m4(r_mat);
+  *r_is_constant = true;
+
+  pxr::UsdGeomXformable xformable(prim_);
+  if (xformable) {
+    bool resets_xform_stack = false;
+    pxr::GfMatrix4d usd_mat;
+    if (xformable.GetLocalTransformation(
+            &usd_mat, &resets_xform_stack, pxr::UsdTimeCode(time))) {
+      /* USD transforms row vectors, so its row major matrices have the layout of Blender's. */
+      for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+          r_mat[i][j] = static_cast<float>(usd_mat[i][j]);
+        }
+      }
+    }
+    *r_is_constant = !xformable.TransformMightBeTimeVarying();
+  }
+
+  if (is_root || resets_xform_stack_) {
+    /* Only convert the root objects, parenting will propagate it. */
+    mul_m4_m4m4(r_mat, settings_->conversion_mat, r_mat);
+
+    float scale_mat[4][4];
+    scale_m4_fl(scale_mat, scale);
+    mul_m4_m4m4(r_mat, scale_mat, r_mat);
+  }
+}
+
+void USDXformReader::add_cache_modifier()
+{
+  ModifierData *md = BKE_modifier_new(eModifierType_MeshSequenceCache);
+  BLI_addtail(&object_->modifiers, md);
+
+  MeshSeqCacheModifierData *mcmd = reinterpret_cast<MeshSeqCacheModifierData *>(md);
+
+  mcmd->cache_file = settings_->cache_file;
+  id_us_plus(&mcmd->cache_file->id);
+
+  BLI_strncpy(mcmd->object_path, object_path_.c_str(), FILE_MAX);
+}
+
+void USDXformReader::add_cache_constraint()
+{
+  bConstraint *con = BKE_constraint_add_for_object(
+      object_, nullptr, CONSTRAINT_TYPE_TRANSFORM_CACHE);
+  bTransformCacheConstraint *data = static_cast<bTransformCacheConstraint *>(con->data);
+  BLI_strncpy(data->object_path, object_path_.c_str(), FILE_MAX);
+
+  data->cache_file = settings_->cache_file;
+  id_us_plus(&data->cache_file->id);
+}
+
+}  // namespace blender::io::usd
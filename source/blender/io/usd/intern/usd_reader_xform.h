@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#include "usd_reader_prim.h"
+
+namespace blender::io::usd {
+
+/* Reader of the prims that only have a transform, imported as empties. Prims without a transform,
+ * like scopes, are imported as empties with an identity transform. */
+class USDXformReader : public USDPrimReader {
+ protected:
+  bool resets_xform_stack_;
+
+ public:
+  USDXformReader(const pxr::UsdPrim &prim, const ImportSettings &settings);
+
+  bool accepts_object_type(const Object *ob, const char **err_str) const override;
+
+  void create_object(Main *bmain) override;
+  void setup_object(Main *bmain, double time) override;
+
+  bool inherits_xform() const override;
+
+  /* Local matrix of the prim at the time code, which is converted to Blender's space and scaled
+   * for the prims at the root of the stage. */
+  void read_matrix(float r_mat[4][4],
+                   double time,
+                   float scale,
+                   bool is_root,
+                   bool *r_is_constant) const;
+
+ protected:
+  /* Whether the object of the reader has no Blender parent, in which case its matrix is
+   * converted to Blender's space. Prims in the prototype of instances are never converted, the
+   * instancing empties are. */
+  bool is_root() const;
+
+  void add_cache_modifier();
+  void add_cache_constraint();
+};
+
+}  // namespace blender::io::usd
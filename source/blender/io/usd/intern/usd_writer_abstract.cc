@@ -37,7 +37,10 @@ static const pxr::TfToken surface("surface", pxr::TfToken::Immortal);
 namespace blender::io::usd {
 
 USDAbstractWriter::USDAbstractWriter(const USDExporterContext &usd_export_context)
-    : usd_export_context_(usd_export_context), frame_has_been_written_(false), is_animated_(false)
+    : usd_export_context_(usd_export_context),
+      frame_has_been_written_(false),
+      is_animated_(false),
+      deferred_data_pending_(false)
 {
 }
 
@@ -82,6 +85,34 @@ const pxr::SdfPath &USDAbstractWriter::usd_path() const
   return usd_export_context_.usd_path;
 }
 
+bool USDAbstractWriter::has_deferred_data() const
+{
+  return deferred_data_pending_;
+}
+
+void USDAbstractWriter::prepare_deferred()
+{
+  BLI_assert(deferred_data_pending_);
+  do_prepare_deferred();
+}
+
+void USDAbstractWriter::write_deferred()
+{
+  BLI_assert(deferred_data_pending_);
+  deferred_data_pending_ = false;
+  do_write_deferred();
+}
+
+void USDAbstractWriter::do_prepare_deferred()
+{
+  BLI_assert(!"Writers that defer their data should implement do_prepare_deferred()");
+}
+
+void USDAbstractWriter::do_write_deferred()
+{
+  BLI_assert(!"Writers that defer their data should implement do_write_deferred()");
+}
+
 pxr::UsdShadeMaterial USDAbstractWriter::ensure_usd_material(Material *material)
 {
   static pxr::SdfPath material_library_path("/_materials");
@@ -125,8 +156,9 @@ void USDAbstractWriter::write_visibility(const HierarchyContext &context,
   usd_value_writer_.SetAttribute(attr_visibility, pxr::VtValue(visibility), timecode);
 }
 
-/* Reference the original data instead of writing a copy. */
-bool USDAbstractWriter::mark_as_instance(const HierarchyContext &context, const pxr::UsdPrim &prim)
+static bool add_instance_reference(const HierarchyContext &context,
+                                   const pxr::UsdPrim &prim,
+                                   const pxr::SdfPath &ref_path)
 {
   BLI_assert(context.is_instance());
 
@@ -136,18 +168,60 @@ bool USDAbstractWriter::mark_as_instance(const HierarchyContext &context, const
     return false;
   }
 
-  pxr::SdfPath ref_path(context.original_export_path);
   if (!prim.GetReferences().AddInternalReference(ref_path)) {
     /* See this URL for a description fo why referencing may fail"
      * https://graphics.pixar.com/usd/docs/api/class_usd_references.html#Usd_Failing_References
      */
     printf("USD Export warning: unable to add reference from %s to %s, not instancing object\n",
            context.export_path.c_str(),
-           context.original_export_path.c_str());
+           ref_path.GetText());
     return false;
   }
 
   return true;
 }
 
+/* Reference the original data instead of writing a copy. */
+bool USDAbstractWriter::mark_as_instance(const HierarchyContext &context, const pxr::UsdPrim &prim)
+{
+  return add_instance_reference(context, prim, pxr::SdfPath(context.original_export_path));
+}
+
+bool USDAbstractWriter::mark_as_native_instance(const HierarchyContext &context,
+                                                const pxr::UsdPrim &prim)
+{
+  if (!add_instance_reference(context, prim, ensure_instance_prototype(context))) {
+    return false;
+  }
+  prim.SetInstanceable(true);
+  return true;
+}
+
+pxr::SdfPath USDAbstractWriter::ensure_instance_prototype(const HierarchyContext &context)
+{
+  static pxr::SdfPath prototype_library_path("/_prototypes");
+  pxr::UsdStageRefPtr stage = usd_export_context_.stage;
+
+  /* A native instance shares the descendants of the prim it references, not that prim itself.
+   * The prototype is a prim with the original data as its only child, stored at the same path in
+   * the library as the original data, which keeps the names unique. */
+  const pxr::SdfPath original_path(context.original_export_path);
+  const pxr::SdfPath prototype_path = prototype_library_path.AppendPath(
+      original_path.MakeRelativePath(pxr::SdfPath::AbsoluteRootPath()));
+  if (stage->GetPrimAtPath(prototype_path)) {
+    return prototype_path;
+  }
+
+  /* The library is a class, so that the prototypes themselves are not rendered. */
+  if (!stage->GetPrimAtPath(prototype_library_path)) {
+    stage->CreateClassPrim(prototype_library_path);
+  }
+  stage->DefinePrim(prototype_path);
+  pxr::UsdPrim prototype_data = stage->DefinePrim(
+      prototype_path.AppendChild(original_path.GetNameToken()));
+  prototype_data.GetReferences().AddInternalReference(original_path);
+
+  return prototype_path;
+}
+
 }  // namespace blender::io::usd
@@ -47,6 +47,9 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
   bool frame_has_been_written_;
   bool is_animated_;
 
+  /* Set by do_write() when the data of the current frame is written by write_deferred(). */
+  bool deferred_data_pending_;
+
  public:
   USDAbstractWriter(const USDExporterContext &usd_export_context);
   virtual ~USDAbstractWriter();
@@ -64,8 +67,17 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
 
   const pxr::SdfPath &usd_path() const;
 
+  /* Deferred data is extracted from Blender by prepare_deferred(), which is called for several
+   * writers in parallel and must not touch the USD stage. write_deferred() then writes it to the
+   * stage, one writer after the other. */
+  bool has_deferred_data() const;
+  void prepare_deferred();
+  void write_deferred();
+
  protected:
   virtual void do_write(HierarchyContext &context) = 0;
+  virtual void do_prepare_deferred();
+  virtual void do_write_deferred();
   pxr::UsdTimeCode get_export_time_code() const;
 
   pxr::UsdShadeMaterial ensure_usd_material(Material *material);
@@ -77,6 +89,16 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
   /* Turn `prim` into an instance referencing `context.original_export_path`.
    * Return true when the instancing was successful, false otherwise. */
   virtual bool mark_as_instance(const HierarchyContext &context, const pxr::UsdPrim &prim);
+
+  /* Turn `prim` into a native USD instance of the prototype of `context.original_export_path`,
+   * so that all instances of the same data share it when the stage is loaded. The data of the
+   * instance itself cannot be overridden then, only the properties of `prim`.
+   * Return true when the instancing was successful, false otherwise. */
+  bool mark_as_native_instance(const HierarchyContext &context, const pxr::UsdPrim &prim);
+
+  /* Return the path of the prototype referencing `context.original_export_path`, creating it when
+   * it does not exist yet. */
+  pxr::SdfPath ensure_instance_prototype(const HierarchyContext &context);
 };
 
 }  // namespace blender::io::usd
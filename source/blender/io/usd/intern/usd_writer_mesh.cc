@@ -20,6 +20,7 @@
 #include "usd_hierarchy_iterator.h"
 
 #include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 
@@ -46,10 +47,22 @@
 
 namespace blender::io::usd {
 
-USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx) : USDAbstractWriter(ctx)
+USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx)
+    : USDAbstractWriter(ctx),
+      deferred_object_(nullptr),
+      deferred_mesh_(nullptr),
+      deferred_mesh_needsfree_(false),
+      deferred_is_first_frame_(false)
 {
 }
 
+USDGenericMeshWriter::~USDGenericMeshWriter()
+{
+  if (deferred_mesh_ != nullptr && deferred_mesh_needsfree_) {
+    BKE_id_free(nullptr, deferred_mesh_);
+  }
+}
+
 bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
 {
   if (usd_export_context_.export_params.visible_objects_only) {
@@ -68,19 +81,54 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
-  try {
-    write_mesh(context, mesh);
+  if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
+    try {
+      write_instance(context, mesh);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
+      if (needsfree) {
+        free_export_mesh(mesh);
+      }
     }
-  }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
+    catch (...) {
+      if (needsfree) {
+        free_export_mesh(mesh);
+      }
+      throw;
     }
-    throw;
+    return;
   }
+
+  /* The visibility check temporarily changes the object, so it cannot be deferred. */
+  pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(usd_export_context_.stage,
+                                                       usd_export_context_.usd_path);
+  write_visibility(context, get_export_time_code(), usd_mesh);
+
+  /* The mesh data is extracted in parallel with that of the other meshes once the whole hierarchy
+   * has been visited, see #USDHierarchyIterator::write_deferred_data(). */
+  deferred_object_ = object_eval;
+  deferred_mesh_ = mesh;
+  deferred_mesh_needsfree_ = needsfree;
+  deferred_is_first_frame_ = !frame_has_been_written_;
+  deferred_data_pending_ = true;
+}
+
+void USDGenericMeshWriter::do_prepare_deferred()
+{
+  deferred_data_ = std::make_unique<USDMeshData>();
+  get_geometry_data(deferred_object_, deferred_mesh_, *deferred_data_);
+
+  if (deferred_mesh_needsfree_) {
+    free_export_mesh(deferred_mesh_);
+  }
+  deferred_mesh_ = nullptr;
+  deferred_mesh_needsfree_ = false;
+}
+
+void USDGenericMeshWriter::do_write_deferred()
+{
+  write_mesh(deferred_object_, *deferred_data_, deferred_is_first_frame_);
+  deferred_object_ = nullptr;
+  deferred_data_.reset();
 }
 
 void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
@@ -109,12 +157,17 @@ struct USDMeshData {
    * single sharpness or a value per-edge, USD will encode either a single sharpness per crease on
    * a mesh, or sharpness's for all edges making up the creases on a mesh. */
   pxr::VtFloatArray crease_sharpnesses;
+
+  /* Primvar name and coordinates of every UV map, only filled when exporting UV maps. */
+  std::vector<std::pair<pxr::TfToken, pxr::VtArray<pxr::GfVec2f>>> uv_maps;
+  /* Face-varying normals, only filled when exporting normals. */
+  pxr::VtVec3fArray loop_normals;
+  /* Per-vertex velocities, only filled for meshes of a fluid simulation. */
+  pxr::VtVec3fArray velocities;
 };
 
-void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+static void get_uv_maps(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  pxr::UsdTimeCode timecode = get_export_time_code();
-
   const CustomData *ldata = &mesh->ldata;
   for (int layer_idx = 0; layer_idx < ldata->totlayer; layer_idx++) {
     const CustomDataLayer *layer = &ldata->layers[layer_idx];
@@ -127,15 +180,28 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
      * for texture coordinates by naming the UV Map as such, without having to guess which UV Map
      * is the "standard" one. */
     pxr::TfToken primvar_name(pxr::TfMakeValidIdentifier(layer->name));
-    pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
-        primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
     MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
     pxr::VtArray<pxr::GfVec2f> uv_coords;
+    uv_coords.reserve(mesh->totloop);
     for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
       uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
     }
 
+    usd_mesh_data.uv_maps.emplace_back(primvar_name, std::move(uv_coords));
+  }
+}
+
+void USDGenericMeshWriter::write_uv_maps(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
+{
+  pxr::UsdTimeCode timecode = get_export_time_code();
+
+  for (const auto &uv_map : usd_mesh_data.uv_maps) {
+    const pxr::VtArray<pxr::GfVec2f> &uv_coords = uv_map.second;
+    pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
+        uv_map.first, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
+
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
     }
@@ -144,34 +210,16 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
   }
 }
 
-void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void USDGenericMeshWriter::write_mesh(Object *object,
+                                      const USDMeshData &usd_mesh_data,
+                                      const bool is_first_frame)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdTimeCode defaultTime = pxr::UsdTimeCode::Default();
   pxr::UsdStageRefPtr stage = usd_export_context_.stage;
   const pxr::SdfPath &usd_path = usd_export_context_.usd_path;
 
-  pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
-  write_visibility(context, timecode, usd_mesh);
-
-  USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
-
-  if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
-    if (!mark_as_instance(context, usd_mesh.GetPrim())) {
-      return;
-    }
-
-    /* The material path will be of the form </_materials/{material name}>, which is outside the
-     * sub-tree pointed to by ref_path. As a result, the referenced data is not allowed to point
-     * out of its own sub-tree. It does work when we override the material with exactly the same
-     * path, though.*/
-    if (usd_export_context_.export_params.export_materials) {
-      assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
-    }
-
-    return;
-  }
+  pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Get(stage, usd_path);
 
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
@@ -214,22 +262,24 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (usd_export_context_.export_params.export_uvmaps) {
-    write_uv_maps(mesh, usd_mesh);
+    write_uv_maps(usd_mesh_data, usd_mesh);
   }
   if (usd_export_context_.export_params.export_normals) {
-    write_normals(mesh, usd_mesh);
+    write_normals(usd_mesh_data, usd_mesh);
+  }
+  if (!usd_mesh_data.velocities.empty()) {
+    usd_mesh.CreateVelocitiesAttr().Set(usd_mesh_data.velocities, timecode);
   }
-  write_surface_velocity(context.object, mesh, usd_mesh);
 
   /* TODO(Sybren): figure out what happens when the face groups change. */
-  if (frame_has_been_written_) {
+  if (!is_first_frame) {
     return;
   }
 
   usd_mesh.CreateSubdivisionSchemeAttr().Set(pxr::UsdGeomTokens->none);
 
   if (usd_export_context_.export_params.export_materials) {
-    assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
+    assign_materials(object, usd_mesh, usd_mesh_data.face_groups);
   }
 }
 
@@ -292,18 +342,111 @@ static void get_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
   }
 }
 
-void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_normals(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+
+  pxr::VtVec3fArray &loop_normals = usd_mesh_data.loop_normals;
+  loop_normals.reserve(mesh->totloop);
+
+  if (lnors != nullptr) {
+    /* Export custom loop normals. */
+    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
+      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
+    }
+  }
+  else {
+    /* Compute the loop normals based on the 'smooth' flag. */
+    float normal[3];
+    MPoly *mpoly = mesh->mpoly;
+    const MVert *mvert = mesh->mvert;
+    for (int poly_idx = 0, totpoly = mesh->totpoly; poly_idx < totpoly; ++poly_idx, ++mpoly) {
+      MLoop *mloop = mesh->mloop + mpoly->loopstart;
+
+      if ((mpoly->flag & ME_SMOOTH) == 0) {
+        /* Flat shaded, use common normal for all verts. */
+        BKE_mesh_calc_poly_normal(mpoly, mloop, mvert, normal);
+        pxr::GfVec3f pxr_normal(normal);
+        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
+          loop_normals.push_back(pxr_normal);
+        }
+      }
+      else {
+        /* Smooth shaded, use individual vert normals. */
+        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
+          normal_short_to_float_v3(normal, mvert[mloop->v].no);
+          loop_normals.push_back(pxr::GfVec3f(normal));
+        }
+      }
+    }
+  }
+}
+
+/* Only reads the object and mesh, so that it can run for several meshes in parallel. */
+void USDGenericMeshWriter::get_geometry_data(Object *object,
+                                             const Mesh *mesh,
+                                             USDMeshData &usd_mesh_data)
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
   get_creases(mesh, usd_mesh_data);
+
+  if (usd_export_context_.export_params.export_uvmaps) {
+    get_uv_maps(mesh, usd_mesh_data);
+  }
+  if (usd_export_context_.export_params.export_normals) {
+    get_normals(mesh, usd_mesh_data);
+  }
+  get_surface_velocity(object, mesh, usd_mesh_data);
+}
+
+void USDGenericMeshWriter::write_instance(const HierarchyContext &context, const Mesh *mesh)
+{
+  pxr::UsdTimeCode timecode = get_export_time_code();
+  pxr::UsdStageRefPtr stage = usd_export_context_.stage;
+  const pxr::SdfPath &usd_path = usd_export_context_.usd_path;
+  const bool export_materials = usd_export_context_.export_params.export_materials;
+
+  /* Binding materials to faces requires geometry subsets, which cannot be authored on a native
+   * instance. Such meshes reference the original data directly, without sharing it. */
+  if (export_materials && context.object->totcol > 1) {
+    pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
+    write_visibility(context, timecode, usd_mesh);
+
+    if (!mark_as_instance(context, usd_mesh.GetPrim())) {
+      return;
+    }
+
+    /* The material path will be of the form </_materials/{material name}>, which is outside the
+     * sub-tree pointed to by ref_path. As a result, the referenced data is not allowed to point
+     * out of its own sub-tree. It does work when we override the material with exactly the same
+     * path, though.*/
+    USDMeshData usd_mesh_data;
+    get_loops_polys(mesh, usd_mesh_data);
+    assign_materials(context.object, usd_mesh, usd_mesh_data.face_groups);
+    return;
+  }
+
+  pxr::UsdGeomXform usd_xform = pxr::UsdGeomXform::Define(stage, usd_path);
+  write_visibility(context, timecode, usd_xform);
+
+  if (!mark_as_native_instance(context, usd_xform.GetPrim()) || !export_materials) {
+    return;
+  }
+
+  /* The binding of the referenced data points outside of the prototype, and is ignored. The
+   * binding of the instance itself applies to the data of the prototype. */
+  Material *material = BKE_object_material_get(context.object, 1);
+  if (material != nullptr) {
+    pxr::UsdShadeMaterialBindingAPI(usd_xform.GetPrim()).Bind(ensure_usd_material(material));
+  }
 }
 
-void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
+void USDGenericMeshWriter::assign_materials(Object *object,
                                             pxr::UsdGeomMesh usd_mesh,
                                             const MaterialFaceGroups &usd_face_groups)
 {
-  if (context.object->totcol == 0) {
+  if (object->totcol == 0) {
     return;
   }
 
@@ -313,7 +456,7 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
   bool mesh_material_bound = false;
   pxr::UsdShadeMaterialBindingAPI material_binding_api(usd_mesh.GetPrim());
   for (int mat_num = 0; mat_num < context.object->totcol; mat_num++) {
-    Material *material = BKE_object_material_get(context.object, mat_num + 1);
+    Material *material = BKE_object_material_get(object, mat_num + 1);
     if (material == nullptr) {
       continue;
     }
@@ -347,7 +490,7 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
     short material_number = face_group.first;
     const pxr::VtIntArray &face_indices = face_group.second;
 
-    Material *material = BKE_object_material_get(context.object, material_number + 1);
+    Material *material = BKE_object_material_get(object, material_number + 1);
     if (material == nullptr) {
       continue;
     }
@@ -361,45 +504,11 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
   }
 }
 
-void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+void USDGenericMeshWriter::write_normals(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
-  const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
-
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
-
-  if (lnors != nullptr) {
-    /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
-  }
-  else {
-    /* Compute the loop normals based on the 'smooth' flag. */
-    float normal[3];
-    MPoly *mpoly = mesh->mpoly;
-    const MVert *mvert = mesh->mvert;
-    for (int poly_idx = 0, totpoly = mesh->totpoly; poly_idx < totpoly; ++poly_idx, ++mpoly) {
-      MLoop *mloop = mesh->mloop + mpoly->loopstart;
-
-      if ((mpoly->flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        BKE_mesh_calc_poly_normal(mpoly, mloop, mvert, normal);
-        pxr::GfVec3f pxr_normal(normal);
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
-        }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
-          normal_short_to_float_v3(normal, mvert[mloop->v].no);
-          loop_normals.push_back(pxr::GfVec3f(normal));
-        }
-      }
-    }
-  }
+  const pxr::VtVec3fArray &loop_normals = usd_mesh_data.loop_normals;
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
   if (!attr_normals.HasValue()) {
@@ -409,9 +518,9 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   usd_mesh.SetNormalsInterpolation(pxr::UsdGeomTokens->faceVarying);
 }
 
-void USDGenericMeshWriter::write_surface_velocity(Object *object,
-                                                  const Mesh *mesh,
-                                                  pxr::UsdGeomMesh usd_mesh)
+void USDGenericMeshWriter::get_surface_velocity(Object *object,
+                                                const Mesh *mesh,
+                                                USDMeshData &usd_mesh_data)
 {
   /* Only velocities from the fluid simulation are exported. This is the most important case,
    * though, as the baked mesh changes topology all the time, and thus computing the velocities
@@ -438,7 +547,7 @@ void USDGenericMeshWriter::write_surface_velocity(Object *object,
   }
 
   /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
+  pxr::VtVec3fArray &usd_velocities = usd_mesh_data.velocities;
   usd_velocities.reserve(mesh->totvert);
 
   FluidVertexVelocity *mesh_velocities = fss->meshVelocities;
@@ -446,9 +555,6 @@ void USDGenericMeshWriter::write_surface_velocity(Object *object,
        ++vertex_idx, ++mesh_velocities) {
     usd_velocities.push_back(pxr::GfVec3f(mesh_velocities->vel));
   }
-
-  pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx) : USDGenericMeshWriter(ctx)
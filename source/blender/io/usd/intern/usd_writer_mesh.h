@@ -22,6 +22,8 @@
 
 #include <pxr/usd/usdGeom/mesh.h>
 
+#include <memory>
+
 namespace blender::io::usd {
 
 struct USDMeshData;
@@ -30,10 +32,13 @@ struct USDMeshData;
 class USDGenericMeshWriter : public USDAbstractWriter {
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  virtual ~USDGenericMeshWriter();
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
   virtual void do_write(HierarchyContext &context) override;
+  virtual void do_prepare_deferred() override;
+  virtual void do_write_deferred() override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
@@ -42,14 +47,22 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   /* Mapping from material slot number to array of face indices with that material. */
   typedef std::map<short, pxr::VtIntArray> MaterialFaceGroups;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
-  void assign_materials(const HierarchyContext &context,
+  /* The mesh of the current frame, set by do_write() and extracted by do_prepare_deferred(). */
+  Object *deferred_object_;
+  Mesh *deferred_mesh_;
+  bool deferred_mesh_needsfree_;
+  bool deferred_is_first_frame_;
+  std::unique_ptr<USDMeshData> deferred_data_;
+
+  void write_instance(const HierarchyContext &context, const Mesh *mesh);
+  void write_mesh(Object *object, const USDMeshData &usd_mesh_data, bool is_first_frame);
+  void get_geometry_data(Object *object, const Mesh *mesh, struct USDMeshData &usd_mesh_data);
+  void assign_materials(Object *object,
                         pxr::UsdGeomMesh usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
-  void write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_surface_velocity(Object *object, const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
+  void write_uv_maps(const USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void write_normals(const USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void get_surface_velocity(Object *object, const Mesh *mesh, USDMeshData &usd_mesh_data);
 };
 
 class USDMeshWriter : public USDGenericMeshWriter {
@@ -25,6 +25,12 @@
 extern "C" {
 #endif
 
+struct CacheArchiveHandle;
+struct CacheReader;
+struct ListBase;
+struct Main;
+struct Mesh;
+struct Object;
 struct bContext;
 
 struct USDExportParams {
@@ -39,6 +45,16 @@ struct USDExportParams {
   enum eEvaluationMode evaluation_mode;
 };
 
+struct USDImportParams {
+  float scale;
+  bool set_frame_range;
+  bool validate_meshes;
+  /* Import instanced prims as instances of a collection per prototype, instead of copies. */
+  bool use_instancing;
+  /* Only create the mesh objects, their data is read by a Mesh Sequence Cache modifier. */
+  bool defer_mesh_loading;
+};
+
 /* The USD_export takes a as_background_job parameter, and returns a boolean.
  *
  * When as_background_job=true, returns false immediately after scheduling
@@ -53,8 +69,50 @@ bool USD_export(struct bContext *C,
                 const struct USDExportParams *params,
                 bool as_background_job);
 
+/* Same behavior as USD_export() for the as_background_job parameter. */
+bool USD_import(struct bContext *C,
+                const char *filepath,
+                const struct USDImportParams *params,
+                bool as_background_job);
+
 int USD_get_version(void);
 
+/* Cache files, used by the Mesh Sequence Cache modifier and the Transform Cache constraint.
+ * The sample time is in seconds, like for Alembic. */
+
+struct CacheArchiveHandle *USD_create_handle(struct Main *bmain,
+                                             const char *filename,
+                                             struct ListBase *object_paths);
+
+void USD_free_handle(struct CacheArchiveHandle *handle);
+
+void USD_get_transform(struct CacheReader *reader,
+                       float r_mat_world[4][4],
+                       float time,
+                       float scale);
+
+/* Either modifies existing_mesh in-place or constructs a new mesh. */
+struct Mesh *USD_read_mesh(struct CacheReader *reader,
+                           struct Object *ob,
+                           struct Mesh *existing_mesh,
+                           const float time,
+                           const char **err_str,
+                           int read_flag);
+
+bool USD_mesh_topology_changed(struct CacheReader *reader,
+                               struct Object *ob,
+                               struct Mesh *existing_mesh,
+                               const float time,
+                               const char **err_str);
+
+void USD_CacheReader_incref(struct CacheReader *reader);
+void USD_CacheReader_free(struct CacheReader *reader);
+
+struct CacheReader *CacheReader_open_usd_object(struct CacheArchiveHandle *handle,
+                                                struct CacheReader *reader,
+                                                struct Object *object,
+                                                const char *object_path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,52 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct bContext;
+
+struct OBJImportParams {
+  float global_scale;
+  /* Start a new object at every group, not only at every object. */
+  bool use_split_groups;
+  bool validate_meshes;
+};
+
+struct OBJExportParams {
+  float global_scale;
+  bool selected_objects_only;
+  bool export_uvs;
+  bool export_normals;
+  /* Write the colors of the materials to a MTL file next to the OBJ file. */
+  bool export_materials;
+};
+
+/* The positions are converted between the Y up axis of OBJ files and the Z up axis of Blender.
+ * Both functions return false when the file can't be read or written. */
+
+bool OBJ_import(struct bContext *C, const char *filepath, const struct OBJImportParams *params);
+
+bool OBJ_export(struct bContext *C, const char *filepath, const struct OBJExportParams *params);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,338 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_wavefront_obj.h"
+
+#include <string>
+
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_float3.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+
+#include "IO_mesh_collector.hh"
+#include "IO_string_utils.hh"
+
+/* Every object is written in parts of a limited number of elements, the parts of all objects
+ * are formatted in parallel. The numbers of the elements of every object are known beforehand,
+ * so that the faces of any part can refer to them. */
+
+namespace blender::io::obj {
+
+static constexpr int elements_per_part = 1 << 15;
+
+/* Convert to the Y up axis of OBJ files. */
+static float3 blender_to_obj(const float3 &co)
+{
+  return float3(co.x, co.z, -co.y);
+}
+
+enum class PartType {
+  Name,
+  Positions,
+  UVs,
+  VertexNormals,
+  FaceNormals,
+  Faces,
+};
+
+struct Part {
+  PartType type;
+  int object;
+  IndexRange range;
+};
+
+struct ExportObject {
+  const CollectedMesh *collected;
+  const MLoopUV *uvs = nullptr;
+  float4x4 matrix;
+  float4x4 normal_matrix;
+  bool is_negative = false;
+  /* Index of the normal of every flat face among the face normals, -1 for smooth faces. */
+  Array<int> flat_face_indices;
+  int flat_faces_num = 0;
+  /* Number of the elements before the object in the file, the vertex normals come before the
+   * face normals. */
+  int vert_offset = 0;
+  int uv_offset = 0;
+  int normal_offset = 0;
+};
+
+static std::string material_name(const Material *material)
+{
+  return material->id.name + 2;
+}
+
+static void append_float3(TextBuffer &buffer, const char *keyword, const float3 &value)
+{
+  buffer.append(keyword);
+  for (const int i : IndexRange(3)) {
+    buffer.append(' ');
+    buffer.append_float(value[i]);
+  }
+  buffer.append('\n');
+}
+
+static float3 transform_normal(const ExportObject &object, float3 normal)
+{
+  mul_mat3_m4_v3(object.normal_matrix.ptr(), normal);
+  normalize_v3(normal);
+  return blender_to_obj(normal);
+}
+
+static void format_faces(const ExportObject &object,
+                         const IndexRange faces,
+                         const OBJExportParams &params,
+                         TextBuffer &buffer)
+{
+  const Mesh *mesh = object.collected->mesh;
+  const Span<Material *> materials = object.collected->materials;
+  const bool export_uvs = object.uvs != nullptr;
+
+  for (const int i : faces) {
+    const MPoly &poly = mesh->mpoly[i];
+
+    /* The state changes are relative to the previous face, also when it is in another part. */
+    const MPoly *prev_poly = i > 0 ? &mesh->mpoly[i - 1] : nullptr;
+    const bool is_smooth = (poly.flag & ME_SMOOTH) != 0;
+    if (prev_poly == nullptr || ((prev_poly->flag & ME_SMOOTH) != 0) != is_smooth) {
+      buffer.append(is_smooth ? "s 1\n" : "s off\n");
+    }
+    if (params.export_materials && (prev_poly == nullptr || prev_poly->mat_nr != poly.mat_nr) &&
+        poly.mat_nr < materials.size() && materials[poly.mat_nr] != nullptr) {
+      buffer.append("usemtl ");
+      buffer.append(material_name(materials[poly.mat_nr]));
+      buffer.append('\n');
+    }
+
+    buffer.append('f');
+    for (const int j : IndexRange(poly.totloop)) {
+      const int loop = poly.loopstart + (object.is_negative ? poly.totloop - 1 - j : j);
+      const int vert = static_cast<int>(mesh->mloop[loop].v);
+      buffer.append(' ');
+      buffer.append_int(object.vert_offset + vert + 1);
+      if (!export_uvs && !params.export_normals) {
+        continue;
+      }
+      buffer.append('/');
+      if (export_uvs) {
+        buffer.append_int(object.uv_offset + loop + 1);
+      }
+      if (params.export_normals) {
+        buffer.append('/');
+        const int normal = is_smooth ? vert : mesh->totvert + object.flat_face_indices[i];
+        buffer.append_int(object.normal_offset + normal + 1);
+      }
+    }
+    buffer.append('\n');
+  }
+}
+
+static void format_part(const Part &part,
+                        Span<ExportObject> objects,
+                        const OBJExportParams &params,
+                        TextBuffer &buffer)
+{
+  const ExportObject &object = objects[part.object];
+  const Mesh *mesh = object.collected->mesh;
+  switch (part.type) {
+    case PartType::Name:
+      buffer.append("o ");
+      buffer.append(object.collected->name);
+      buffer.append('\n');
+      break;
+    case PartType::Positions:
+      for (const int i : part.range) {
+        const float3 co = object.matrix * float3(mesh->mvert[i].co);
+        append_float3(buffer, "v", blender_to_obj(co));
+      }
+      break;
+    case PartType::UVs:
+      for (const int i : part.range) {
+        buffer.append("vt ");
+        buffer.append_float(object.uvs[i].uv[0]);
+        buffer.append(' ');
+        buffer.append_float(object.uvs[i].uv[1]);
+        buffer.append('\n');
+      }
+      break;
+    case PartType::VertexNormals:
+      for (const int i : part.range) {
+        float3 normal;
+        normal_short_to_float_v3(normal, mesh->mvert[i].no);
+        append_float3(buffer, "vn", transform_normal(object, normal));
+      }
+      break;
+    case PartType::FaceNormals:
+      for (const int i : part.range) {
+        if (object.flat_face_indices[i] == -1) {
+          continue;
+        }
+        const MPoly &poly = mesh->mpoly[i];
+        float3 normal;
+        BKE_mesh_calc_poly_normal(&poly, &mesh->mloop[poly.loopstart], mesh->mvert, normal);
+        append_float3(buffer, "vn", transform_normal(object, normal));
+      }
+      break;
+    case PartType::Faces:
+      format_faces(object, part.range, params, buffer);
+      break;
+  }
+}
+
+static void add_parts(Vector<Part> &parts, const PartType type, const int object, const int size)
+{
+  for (int start = 0; start < size; start += elements_per_part) {
+    parts.append({type, object, IndexRange(start, std::min(elements_per_part, size - start))});
+  }
+}
+
+static bool write_mtl_file(const char *filepath, Span<ExportObject> objects)
+{
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  TextBuffer buffer;
+  Vector<const Material *> written;
+  for (const ExportObject &object : objects) {
+    for (const Material *material : object.collected->materials) {
+      if (material == nullptr || written.contains(material)) {
+        continue;
+      }
+      written.append(material);
+      buffer.append("newmtl ");
+      buffer.append(material_name(material));
+      buffer.append('\n');
+      append_float3(buffer, "Kd", float3(material->r, material->g, material->b));
+      append_float3(buffer, "Ks", float3(material->specr, material->specg, material->specb));
+      buffer.append("d ");
+      buffer.append_float(material->a);
+      buffer.append("\n\n");
+    }
+  }
+
+  const Span<char> data = buffer.data();
+  const bool ok = fwrite(data.data(), 1, static_cast<size_t>(data.size()), file) ==
+                  static_cast<size_t>(data.size());
+  return (fclose(file) == 0) && ok;
+}
+
+static bool export_file(bContext *C, const char *filepath, const OBJExportParams &params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  MeshCollector collector(depsgraph, params.selected_objects_only);
+  const Vector<CollectedMesh> &meshes = collector.collect();
+
+  Array<ExportObject> objects(meshes.size());
+  int vert_offset = 0;
+  int uv_offset = 0;
+  int normal_offset = 0;
+  for (const int i : meshes.index_range()) {
+    ExportObject &object = objects[i];
+    const Mesh *mesh = meshes[i].mesh;
+    object.collected = &meshes[i];
+    float scale_mat[4][4];
+    scale_m4_fl(scale_mat, params.global_scale);
+    mul_m4_m4m4(object.matrix.ptr(), scale_mat, meshes[i].matrix_world.ptr());
+    object.normal_matrix = meshes[i].matrix_world.inverted_transposed_affine();
+    object.is_negative = is_negative_m4(object.matrix.ptr());
+    if (params.export_uvs) {
+      object.uvs = static_cast<const MLoopUV *>(CustomData_get_layer(&mesh->ldata, CD_MLOOPUV));
+    }
+
+    if (params.export_normals) {
+      object.flat_face_indices.reinitialize(mesh->totpoly);
+      for (const int j : IndexRange(mesh->totpoly)) {
+        const bool is_smooth = (mesh->mpoly[j].flag & ME_SMOOTH) != 0;
+        object.flat_face_indices[j] = is_smooth ? -1 : object.flat_faces_num++;
+      }
+    }
+
+    object.vert_offset = vert_offset;
+    object.uv_offset = uv_offset;
+    object.normal_offset = normal_offset;
+    vert_offset += mesh->totvert;
+    uv_offset += object.uvs ? mesh->totloop : 0;
+    normal_offset += params.export_normals ? mesh->totvert + object.flat_faces_num : 0;
+  }
+
+  Vector<Part> parts;
+  for (const int i : objects.index_range()) {
+    const Mesh *mesh = objects[i].collected->mesh;
+    parts.append({PartType::Name, i, IndexRange()});
+    add_parts(parts, PartType::Positions, i, mesh->totvert);
+    if (objects[i].uvs != nullptr) {
+      add_parts(parts, PartType::UVs, i, mesh->totloop);
+    }
+    if (params.export_normals) {
+      add_parts(parts, PartType::VertexNormals, i, mesh->totvert);
+      add_parts(parts, PartType::FaceNormals, i, mesh->totpoly);
+    }
+    add_parts(parts, PartType::Faces, i, mesh->totpoly);
+  }
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  TextBuffer header;
+  header.append("# Blender OBJ File\n");
+  char mtl_filepath[FILE_MAX];
+  if (params.export_materials) {
+    BLI_strncpy(mtl_filepath, filepath, sizeof(mtl_filepath));
+    BLI_path_extension_replace(mtl_filepath, sizeof(mtl_filepath), ".mtl");
+    header.append("mtllib ");
+    header.append(BLI_path_basename(mtl_filepath));
+    header.append('\n');
+  }
+
+  bool ok = fwrite(header.data().data(), 1, static_cast<size_t>(header.size()), file) ==
+            static_cast<size_t>(header.size());
+  ok = ok && write_parts_in_order(file, parts.size(), [&](const int64_t part, TextBuffer &buffer) {
+         format_part(parts[part], objects, params, buffer);
+       });
+  ok = (fclose(file) == 0) && ok;
+
+  if (ok && params.export_materials) {
+    ok = write_mtl_file(mtl_filepath, objects);
+  }
+  return ok;
+}
+
+}  // namespace blender::io::obj
+
+bool OBJ_export(bContext *C, const char *filepath, const OBJExportParams *params)
+{
+  return blender::io::obj::export_file(C, filepath, *params);
+}
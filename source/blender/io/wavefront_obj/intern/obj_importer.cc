@@ -0,0 +1,544 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+#include "IO_wavefront_obj.h"
+
+#include <string>
+
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_float2.hh"
+#include "BLI_float3.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BKE_context.h"
+#include "BKE_mesh.h"
+
+#include "IO_mapped_file.hh"
+#include "IO_mesh_builder.hh"
+#include "IO_string_utils.hh"
+
+/* The file is split in chunks of lines that are parsed in parallel. The elements are numbered
+ * in the order of the file, their numbers are only known once the chunks before are parsed, so
+ * the faces that use numbers relative to the last element are fixed up after the parsing. */
+
+namespace blender::io::obj {
+
+static constexpr int64_t chunk_size = 1 << 20;
+
+enum class ChangeType {
+  Object,
+  Group,
+  Material,
+  Smooth,
+};
+
+/* Change of the state that applies to the faces after it. */
+struct StateChange {
+  ChangeType type;
+  /* Index of the first face the change applies to. */
+  int face;
+  std::string name;
+  bool smooth = false;
+};
+
+struct ChunkData {
+  Vector<float3> positions;
+  Vector<float2> uvs;
+  Vector<float3> normals;
+
+  Vector<int> face_sizes;
+  /* The indices of the elements used by the corners, -1 when the corner doesn't use one. */
+  Vector<int> corner_verts;
+  Vector<int> corner_uvs;
+  Vector<int> corner_normals;
+  /* The corners using an index relative to the last element, the indices are relative to the
+   * elements of the chunk until they are fixed up. */
+  Vector<int> relative_verts;
+  Vector<int> relative_uvs;
+  Vector<int> relative_normals;
+
+  Vector<StateChange> changes;
+};
+
+/* Convert from the Y up axis of OBJ files. */
+static float3 obj_to_blender(const float3 &co)
+{
+  return float3(co.x, -co.z, co.y);
+}
+
+static void add_corner_index(const int index,
+                             const int elements_num,
+                             Vector<int> &corners,
+                             Vector<int> &relative_corners)
+{
+  if (index < 0) {
+    relative_corners.append(static_cast<int>(corners.size()));
+    corners.append(elements_num + index);
+  }
+  else {
+    corners.append(index - 1);
+  }
+}
+
+static void parse_face(StringRef line, ChunkData &chunk)
+{
+  int face_size = 0;
+  while (true) {
+    line = drop_whitespace(line);
+    if (line.is_empty()) {
+      break;
+    }
+    int vert;
+    StringRef rest = parse_int(line, 0, vert, false);
+    if (vert == 0) {
+      /* Not a valid number, like the comments at the end of some lines. */
+      break;
+    }
+    int uv = 0;
+    int normal = 0;
+    if (rest.startswith("/")) {
+      rest = parse_int(rest.drop_prefix(1), 0, uv, false);
+      if (rest.startswith("/")) {
+        rest = parse_int(rest.drop_prefix(1), 0, normal, false);
+      }
+    }
+    add_corner_index(vert, static_cast<int>(chunk.positions.size()), chunk.corner_verts,
+                     chunk.relative_verts);
+    if (uv != 0) {
+      add_corner_index(uv, static_cast<int>(chunk.uvs.size()), chunk.corner_uvs,
+                       chunk.relative_uvs);
+    }
+    else {
+      chunk.corner_uvs.append(-1);
+    }
+    if (normal != 0) {
+      add_corner_index(normal, static_cast<int>(chunk.normals.size()), chunk.corner_normals,
+                       chunk.relative_normals);
+    }
+    else {
+      chunk.corner_normals.append(-1);
+    }
+    face_size++;
+    line = drop_non_whitespace(rest);
+  }
+
+  if (face_size < 3) {
+    /* Drop the lines and points, the relative indices of their corners as well. */
+    const int64_t corners_num = chunk.corner_verts.size() - face_size;
+    for (Vector<int> *relative : {&chunk.relative_verts, &chunk.relative_uvs,
+                                  &chunk.relative_normals}) {
+      while (!relative->is_empty() && relative->last() >= corners_num) {
+        relative->remove_last();
+      }
+    }
+    chunk.corner_verts.resize(corners_num);
+    chunk.corner_uvs.resize(corners_num);
+    chunk.corner_normals.resize(corners_num);
+    return;
+  }
+  chunk.face_sizes.append(face_size);
+}
+
+static std::string parse_name(const StringRef line)
+{
+  StringRef name = drop_whitespace(line);
+  while (!name.is_empty() && ELEM(name.back(), ' ', '\t')) {
+    name = name.drop_suffix(1);
+  }
+  return name;
+}
+
+static void parse_chunk(StringRef text, const float scale, ChunkData &chunk)
+{
+  while (!text.is_empty()) {
+    const StringRef line = drop_whitespace(read_next_line(text));
+    const StringRef keyword = first_word(line);
+    const StringRef rest = line.drop_prefix(keyword.size());
+    if (keyword == "v") {
+      float3 co;
+      parse_floats(rest, 0.0f, co, 3);
+      chunk.positions.append(obj_to_blender(co) * scale);
+    }
+    else if (keyword == "vt") {
+      float2 uv;
+      parse_floats(rest, 0.0f, uv, 2);
+      chunk.uvs.append(uv);
+    }
+    else if (keyword == "vn") {
+      float3 normal;
+      parse_floats(rest, 0.0f, normal, 3);
+      chunk.normals.append(obj_to_blender(normal));
+    }
+    else if (keyword == "f") {
+      parse_face(rest, chunk);
+    }
+    else if (keyword == "o" || keyword == "g" || keyword == "usemtl") {
+      StateChange change;
+      change.type = keyword == "o" ? ChangeType::Object :
+                                     keyword == "g" ? ChangeType::Group : ChangeType::Material;
+      change.face = static_cast<int>(chunk.face_sizes.size());
+      change.name = parse_name(rest);
+      chunk.changes.append(std::move(change));
+    }
+    else if (keyword == "s") {
+      const StringRef value = first_word(rest);
+      StateChange change;
+      change.type = ChangeType::Smooth;
+      change.face = static_cast<int>(chunk.face_sizes.size());
+      change.smooth = !(value == "off" || value == "0");
+      chunk.changes.append(std::move(change));
+    }
+  }
+}
+
+/* The elements of all chunks, in the order of the file. */
+struct FileData {
+  Array<float3> positions;
+  Array<float2> uvs;
+  Array<float3> normals;
+
+  /* First corner of every face, followed by the number of corners. */
+  Array<int> face_offsets;
+  Array<int> corner_verts;
+  Array<int> corner_uvs;
+  Array<int> corner_normals;
+
+  Vector<StateChange> changes;
+};
+
+template<typename T>
+static Array<T> concatenate_chunks(Span<ChunkData> chunks,
+                                   const Vector<T> ChunkData::*member,
+                                   Span<int> offsets)
+{
+  Array<T> result(offsets.last());
+  parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Vector<T> &values = chunks[i].*member;
+      std::copy(values.begin(), values.end(), result.begin() + offsets[i]);
+    }
+  });
+  return result;
+}
+
+template<typename SizeFn>
+static Array<int> chunk_offsets(Span<ChunkData> chunks, const SizeFn &size)
+{
+  Array<int> offsets(chunks.size() + 1);
+  int offset = 0;
+  for (const int i : chunks.index_range()) {
+    offsets[i] = offset;
+    offset += static_cast<int>(size(chunks[i]));
+  }
+  offsets.last() = offset;
+  return offsets;
+}
+
+static void fix_relative_indices(MutableSpan<ChunkData> chunks,
+                                 Vector<int> ChunkData::*corners,
+                                 Vector<int> ChunkData::*relative,
+                                 Span<int> element_offsets)
+{
+  parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Vector<int> &corner_indices = chunks[i].*corners;
+      for (const int corner : chunks[i].*relative) {
+        corner_indices[corner] += element_offsets[i];
+      }
+    }
+  });
+}
+
+static FileData read_file_data(StringRef text, const float scale)
+{
+  const Vector<StringRef> texts = split_in_line_chunks(text, chunk_size);
+  Array<ChunkData> chunks(texts.size());
+  parallel_for(texts.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      parse_chunk(texts[i], scale, chunks[i]);
+    }
+  });
+
+  const Array<int> position_offsets = chunk_offsets(
+      chunks, [](const ChunkData &chunk) { return chunk.positions.size(); });
+  const Array<int> uv_offsets = chunk_offsets(
+      chunks, [](const ChunkData &chunk) { return chunk.uvs.size(); });
+  const Array<int> normal_offsets = chunk_offsets(
+      chunks, [](const ChunkData &chunk) { return chunk.normals.size(); });
+  const Array<int> face_offsets = chunk_offsets(
+      chunks, [](const ChunkData &chunk) { return chunk.face_sizes.size(); });
+  const Array<int> corner_offsets = chunk_offsets(
+      chunks, [](const ChunkData &chunk) { return chunk.corner_verts.size(); });
+
+  fix_relative_indices(chunks, &ChunkData::corner_verts, &ChunkData::relative_verts,
+                       position_offsets);
+  fix_relative_indices(chunks, &ChunkData::corner_uvs, &ChunkData::relative_uvs, uv_offsets);
+  fix_relative_indices(chunks, &ChunkData::corner_normals, &ChunkData::relative_normals,
+                       normal_offsets);
+
+  FileData data;
+  data.positions = concatenate_chunks(chunks.as_span(), &ChunkData::positions, position_offsets);
+  data.uvs = concatenate_chunks(chunks.as_span(), &ChunkData::uvs, uv_offsets);
+  data.normals = concatenate_chunks(chunks.as_span(), &ChunkData::normals, normal_offsets);
+  data.corner_verts = concatenate_chunks(
+      chunks.as_span(), &ChunkData::corner_verts, corner_offsets);
+  data.corner_uvs = concatenate_chunks(chunks.as_span(), &ChunkData::corner_uvs, corner_offsets);
+  data.corner_normals = concatenate_chunks(
+      chunks.as_span(), &ChunkData::corner_normals, corner_offsets);
+
+  /* The face sizes become the offsets of the faces. */
+  Array<int> face_sizes = concatenate_chunks(
+      chunks.as_span(), &ChunkData::face_sizes, face_offsets);
+  data.face_offsets.reinitialize(face_sizes.size() + 1);
+  int corner = 0;
+  for (const int i : face_sizes.index_range()) {
+    data.face_offsets[i] = corner;
+    corner += face_sizes[i];
+  }
+  data.face_offsets.last() = corner;
+
+  for (const int i : chunks.index_range()) {
+    for (StateChange &change : chunks[i].changes) {
+      change.face += face_offsets[i];
+      data.changes.append(std::move(change));
+    }
+  }
+  return data;
+}
+
+/* Faces of the file that become one object. */
+struct ObjectFaces {
+  std::string name;
+  IndexRange faces;
+};
+
+static Vector<ObjectFaces> split_objects(const FileData &data,
+                                         const std::string &default_name,
+                                         const bool use_split_groups,
+                                         MutableSpan<bool> face_smooth,
+                                         MutableSpan<int> face_materials,
+                                         Vector<std::string> &r_materials)
+{
+  const int faces_num = static_cast<int>(face_smooth.size());
+  Vector<ObjectFaces> objects;
+  objects.append({default_name, IndexRange()});
+
+  int material = -1;
+  bool smooth = false;
+  int face = 0;
+  auto fill_until = [&](const int end) {
+    face_smooth.slice(face, end - face).fill(smooth);
+    face_materials.slice(face, end - face).fill(material);
+    face = end;
+  };
+
+  for (const StateChange &change : data.changes) {
+    fill_until(change.face);
+    switch (change.type) {
+      case ChangeType::Group:
+        if (!use_split_groups) {
+          break;
+        }
+        ATTR_FALLTHROUGH;
+      case ChangeType::Object: {
+        ObjectFaces &last = objects.last();
+        last.faces = IndexRange(last.faces.start(), change.face - last.faces.start());
+        if (last.faces.size() == 0) {
+          /* Nothing was added to the object before its name changed. */
+          last.name = change.name;
+        }
+        else {
+          objects.append({change.name, IndexRange(change.face, 0)});
+        }
+        break;
+      }
+      case ChangeType::Material: {
+        int64_t index = r_materials.first_index_of_try(change.name);
+        if (index == -1) {
+          index = r_materials.append_and_get_index(change.name);
+        }
+        material = static_cast<int>(index);
+        break;
+      }
+      case ChangeType::Smooth:
+        smooth = change.smooth;
+        break;
+    }
+  }
+  fill_until(faces_num);
+
+  ObjectFaces &last = objects.last();
+  last.faces = IndexRange(last.faces.start(), faces_num - last.faces.start());
+  return objects;
+}
+
+/* Geometry of one object, using the vertices used by its faces. */
+static bool build_object_mesh(const FileData &data,
+                              const IndexRange faces,
+                              Span<bool> face_smooth,
+                              Span<int> face_materials,
+                              Span<std::string> materials,
+                              MeshBuilder &r_builder)
+{
+  const IndexRange corners(data.face_offsets[faces.start()],
+                           data.face_offsets[faces.one_after_last()] -
+                               data.face_offsets[faces.start()]);
+  const int positions_num = static_cast<int>(data.positions.size());
+  const int uvs_num = static_cast<int>(data.uvs.size());
+  const int normals_num = static_cast<int>(data.normals.size());
+
+  /* The vertices of an object are usually a range of the vertices of the file. */
+  int min_vert = INT32_MAX;
+  int max_vert = -1;
+  bool has_uvs = false;
+  bool has_normals = false;
+  for (const int corner : corners) {
+    const int vert = data.corner_verts[corner];
+    if (vert >= 0 && vert < positions_num) {
+      min_vert = std::min(min_vert, vert);
+      max_vert = std::max(max_vert, vert);
+    }
+    has_uvs |= data.corner_uvs[corner] >= 0;
+    has_normals |= data.corner_normals[corner] >= 0;
+  }
+  if (max_vert == -1) {
+    return false;
+  }
+
+  Array<int> vert_map(max_vert - min_vert + 1, -1);
+  Vector<int> object_materials(materials.size(), -1);
+
+  for (const int face : faces) {
+    const IndexRange face_corners(data.face_offsets[face],
+                                  data.face_offsets[face + 1] - data.face_offsets[face]);
+    bool is_valid = true;
+    for (const int corner : face_corners) {
+      const int vert = data.corner_verts[corner];
+      is_valid &= vert >= 0 && vert < positions_num;
+    }
+    if (!is_valid) {
+      continue;
+    }
+
+    for (const int corner : face_corners) {
+      int &vert = vert_map[data.corner_verts[corner] - min_vert];
+      if (vert == -1) {
+        vert = static_cast<int>(r_builder.positions.append_and_get_index(
+            data.positions[data.corner_verts[corner]]));
+      }
+      r_builder.corner_verts.append(vert);
+
+      if (has_uvs) {
+        const int uv = data.corner_uvs[corner];
+        r_builder.corner_uvs.append((uv >= 0 && uv < uvs_num) ? data.uvs[uv] : float2(0.0f));
+      }
+      if (has_normals) {
+        const int normal = data.corner_normals[corner];
+        r_builder.corner_normals.append((normal >= 0 && normal < normals_num) ?
+                                            data.normals[normal] :
+                                            float3(0.0f));
+      }
+    }
+    r_builder.face_sizes.append(static_cast<int>(face_corners.size()));
+    /* The custom normals are only used by smooth faces. */
+    r_builder.face_smooth.append(face_smooth[face] || has_normals);
+
+    int material = face_materials[face];
+    if (material != -1) {
+      if (object_materials[material] == -1) {
+        object_materials[material] = static_cast<int>(r_builder.materials.size());
+        r_builder.materials.append(materials[material]);
+      }
+      material = object_materials[material];
+    }
+    r_builder.face_materials.append(std::max(material, 0));
+  }
+  return !r_builder.face_sizes.is_empty();
+}
+
+static bool import_file(bContext *C, const char *filepath, const OBJImportParams &params)
+{
+  MappedFile file(filepath);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  const FileData data = read_file_data(file.text(), params.global_scale);
+
+  char default_name[FILE_MAX];
+  BLI_strncpy(default_name, BLI_path_basename(filepath), sizeof(default_name));
+  BLI_path_extension_replace(default_name, sizeof(default_name), "");
+
+  const int faces_num = static_cast<int>(data.face_offsets.size() - 1);
+  Array<bool> face_smooth(faces_num);
+  Array<int> face_materials(faces_num);
+  Vector<std::string> materials;
+  const Vector<ObjectFaces> objects = split_objects(
+      data, default_name, params.use_split_groups, face_smooth, face_materials, materials);
+
+  Array<Mesh *> meshes(objects.size(), nullptr);
+  Array<Vector<std::string>> object_materials(objects.size());
+  parallel_for(objects.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      MeshBuilder builder;
+      if (build_object_mesh(
+              data, objects[i].faces, face_smooth, face_materials, materials, builder)) {
+        meshes[i] = builder.build();
+        object_materials[i] = std::move(builder.materials);
+      }
+    }
+  });
+
+  if (faces_num == 0 && !data.positions.is_empty()) {
+    /* Files of points or lines, only the vertices are imported. */
+    MeshBuilder builder;
+    builder.positions.extend(data.positions.as_span());
+    meshes[0] = builder.build();
+  }
+
+  Main *bmain = CTX_data_main(C);
+  Vector<Object *> imported_objects;
+  for (const int i : objects.index_range()) {
+    if (meshes[i] == nullptr) {
+      continue;
+    }
+    Object *ob = import_add_mesh_object(
+        bmain, objects[i].name.c_str(), meshes[i], object_materials[i]);
+    if (params.validate_meshes) {
+      BKE_mesh_validate(static_cast<Mesh *>(ob->data), false, false);
+    }
+    imported_objects.append(ob);
+  }
+
+  import_link_objects(bmain, CTX_data_view_layer(C), imported_objects);
+  return true;
+}
+
+}  // namespace blender::io::obj
+
+bool OBJ_import(bContext *C, const char *filepath, const OBJImportParams *params)
+{
+  return blender::io::obj::import_file(C, filepath, *params);
+}
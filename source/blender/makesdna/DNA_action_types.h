@@ -42,6 +42,7 @@ struct Collection;
 struct GHash;
 struct Object;
 struct SpaceLink;
+struct bPoseEvalProgram;
 
 /* ************************************************ */
 /* Visualization */
@@ -470,6 +471,8 @@ typedef struct bPose {
    * chanbase. Used for quick pose channel lookup from an index.
    */
   bPoseChannel **chan_array;
+  /** Evaluation order of the bones for #POSE_COMPILED_EVAL. Not saved in file. */
+  struct bPoseEvalProgram *eval_program;
 
   short flag;
   char _pad[2];
@@ -525,6 +528,8 @@ typedef enum ePose_Flags {
   POSE_MIRROR_EDIT = (1 << 9),
   /* Use relative mirroring in mirror mode */
   POSE_MIRROR_RELATIVE = (1 << 10),
+  /* Evaluate all bones in a single dependency graph operation */
+  POSE_COMPILED_EVAL = (1 << 11),
 } ePose_Flags;
 
 /* IK Solvers ------------------------------------ */
@@ -675,7 +680,11 @@ typedef struct bAction {
    * (if 0, will be set to whatever ID first evaluates it).
    */
   int idroot;
-  char _pad[4];
+  /**
+   * Runtime: changes with every copy of the action, so that data compiled from the F-Curves of an
+   * evaluated copy can tell when they have been replaced.
+   */
+  int eval_generation;
 } bAction;
 
 /* Flags for the action */
@@ -32,6 +32,8 @@
 extern "C" {
 #endif
 
+struct AnimCompiledAction;
+
 /* ************************************************ */
 /* F-Curve DataTypes */
 
@@ -1106,6 +1108,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved targets of the active action in evaluated copies. */
+  struct AnimCompiledAction *compiled_action;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
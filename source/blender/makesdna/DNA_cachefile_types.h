@@ -52,6 +52,13 @@ typedef struct AlembicObjectPath {
   char path[4096];
 } AlembicObjectPath;
 
+/* CacheFile::type
+ * Format of the cache file, determined from the extension of its path when it is opened. */
+enum {
+  CACHEFILE_TYPE_ALEMBIC = 0,
+  CACHEFILE_TYPE_USD = 1,
+};
+
 /* CacheFile::velocity_unit
  * Determines what temporal unit is used to interpret velocity vectors for motion blur effects. */
 enum {
@@ -84,14 +91,15 @@ typedef struct CacheFile {
   short flag;
   short draw_flag; /* UNUSED */
 
-  char _pad[3];
+  char type;
+  char _pad[2];
 
   char velocity_unit;
   /* Name of the velocity property in the Alembic file. */
   char velocity_name[64];
 
   /* Runtime */
-  struct AbcArchiveHandle *handle;
+  struct CacheArchiveHandle *handle;
   char handle_filepath[1024];
   struct GSet *handle_readers;
 } CacheFile;
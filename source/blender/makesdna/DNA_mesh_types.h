@@ -103,6 +103,9 @@ typedef struct Mesh_Runtime {
   /** Non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /** Vertex group weights packed for armature deform, see #MeshDeformWeights. */
+  struct MeshDeformWeights *deform_weights;
+
   /** Set by modifier stack if only deformed from original. */
   char deformed_only;
   /**
@@ -644,7 +644,10 @@ typedef struct UserDef_Experimental {
   char use_switch_object_operator;
   char use_sculpt_tools_tilt;
   char use_asset_browser;
-  char _pad[7];
+  char use_depsgraph_animation_cache;
+  char use_gpu_shader_cache;
+  char use_viewport_lod;
+  char _pad[4];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -489,6 +489,7 @@ enum {
   V3D_SHADING_SCENE_LIGHTS_RENDER = (1 << 12),
   V3D_SHADING_SCENE_WORLD_RENDER = (1 << 13),
   V3D_SHADING_STUDIOLIGHT_VIEW_ROTATION = (1 << 14),
+  V3D_SHADING_OCCLUSION_CULLING = (1 << 15),
 };
 
 /** #View3DShading.cavity_type */
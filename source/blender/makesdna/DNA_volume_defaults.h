@@ -37,6 +37,7 @@
 
 #define _DNA_DEFAULT_VolumeRender \
   { \
+    .precision = VOLUME_PRECISION_FULL, \
     .space = VOLUME_SPACE_OBJECT, \
     .step_size = 0.0f, \
     .clipping = 0.001f, \
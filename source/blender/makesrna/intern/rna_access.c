@@ -4573,6 +4573,13 @@ static int rna_raw_access(ReportList *reports,
       /* avoid creating temporary buffer if the data type match */
       needconv = 0;
     }
+    /* Items that aren't stored in an array (ID lists for example) can still be read directly
+     * from their DNA when the types match. Writing uses the set functions, they clamp. */
+    const bool use_raw_item = !set && itemprop &&
+                              (itemprop->flag_internal & PROP_INTERN_RAW_ACCESS) &&
+                              (itemprop->rawtype == in.type);
+    const int raw_item_len = max_ii(itemlen, 1);
+    const int raw_item_size = use_raw_item ? RNA_raw_type_sizeof(in.type) * raw_item_len : 0;
     /* no item property pointer, can still be id property, or
      * property of a type derived from the collection pointer type */
     RNA_PROP_BEGIN (ptr, itemptr, prop) {
@@ -4611,7 +4618,19 @@ static int rna_raw_access(ReportList *reports,
             break;
           }
 
-          if (itemlen == 0) {
+          if (use_raw_item) {
+            if (a + raw_item_len > in.len) {
+              BKE_reportf(
+                  reports, RPT_ERROR, "Array length mismatch (got %d, expected more)", in.len);
+              err = 1;
+              break;
+            }
+            memcpy((char *)in.array + (size_t)a * RNA_raw_type_sizeof(in.type),
+                   (char *)itemptr.data + itemprop->rawoffset,
+                   raw_item_size);
+            a += raw_item_len;
+          }
+          else if (itemlen == 0) {
             /* handle conversions */
             if (set) {
               switch (itemtype) {
@@ -561,6 +561,12 @@ static void rna_def_cloth_solver_result(BlenderRNA *brna)
   RNA_def_property_clear_flag(prop, PROP_EDITABLE);
   RNA_def_property_ui_text(prop, "Average Iterations", "Average iterations during substeps");
 
+  prop = RNA_def_property(srna, "solve_time", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_sdna(prop, NULL, "time");
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Solve Time", "Time spent in the solver during substeps, in seconds");
+
   RNA_define_verify_sdna(1);
 }
 
@@ -1562,6 +1562,10 @@ static int rna_MeshSequenceCacheModifier_has_velocity_get(PointerRNA *ptr)
 {
 #  ifdef WITH_ALEMBIC
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)ptr->data;
+  /* Velocities are only read from Alembic files. */
+  if (mcmd->cache_file == NULL || mcmd->cache_file->type != CACHEFILE_TYPE_ALEMBIC) {
+    return false;
+  }
   return ABC_has_vec3_array_property_named(mcmd->reader, mcmd->cache_file->velocity_name);
 #  else
   return false;
@@ -1574,7 +1578,8 @@ static int rna_MeshSequenceCacheModifier_read_velocity_get(PointerRNA *ptr)
 #  ifdef WITH_ALEMBIC
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)ptr->data;
 
-  if (mcmd->num_vertices == 0) {
+  if (mcmd->num_vertices == 0 || mcmd->cache_file == NULL ||
+      mcmd->cache_file->type != CACHEFILE_TYPE_ALEMBIC) {
     return 0;
   }
 
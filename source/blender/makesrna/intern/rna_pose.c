@@ -1752,6 +1752,16 @@ static void rna_def_pose(BlenderRNA *brna)
 
   RNA_define_lib_overridable(false);
 
+  prop = RNA_def_property(srna, "use_compiled_evaluation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", POSE_COMPILED_EVAL);
+  RNA_def_property_ui_text(
+      prop,
+      "Compiled Evaluation",
+      "Evaluate all bones of the pose in a single step, in parallel where the bones don't depend "
+      "on each other. Poses using IK solvers or depending on other objects are evaluated bone by "
+      "bone");
+  RNA_def_property_update(prop, 0, "rna_Pose_dependency_update");
+
   /* animviz */
   rna_def_animviz_common(srna);
 
@@ -464,12 +464,21 @@ static int rna_RenderPass_rect_get_length(PointerRNA *ptr, int length[RNA_MAX_AR
 static void rna_RenderPass_rect_get(PointerRNA *ptr, float *values)
 {
   RenderPass *rpass = (RenderPass *)ptr->data;
-  memcpy(values, rpass->rect, sizeof(float) * rpass->rectx * rpass->recty * rpass->channels);
+  const size_t size = sizeof(float) * rpass->rectx * rpass->recty * rpass->channels;
+  /* Passes only saved to disk or not rendered to yet have no buffer. */
+  if (rpass->rect == NULL) {
+    memset(values, 0, size);
+    return;
+  }
+  memcpy(values, rpass->rect, size);
 }
 
 void rna_RenderPass_rect_set(PointerRNA *ptr, const float *values)
 {
   RenderPass *rpass = (RenderPass *)ptr->data;
+  if (rpass->rect == NULL) {
+    return;
+  }
   memcpy(rpass->rect, values, sizeof(float) * rpass->rectx * rpass->recty * rpass->channels);
 }
 
@@ -772,6 +781,15 @@ static void rna_def_render_engine(BlenderRNA *brna)
   prop = RNA_def_property(srna, "is_preview", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", RE_ENGINE_PREVIEW);
 
+  prop = RNA_def_property(srna, "is_depsgraph_reused", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", RE_ENGINE_DEPSGRAPH_REUSED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop,
+      "Depsgraph Reused",
+      "The depsgraph was kept from the previous render with persistent data, or from the "
+      "previous object when baking several objects, its updates list what changed since");
+
   prop = RNA_def_property(srna, "camera_override", PROP_POINTER, PROP_NONE);
   RNA_def_property_pointer_funcs(prop, "rna_RenderEngine_camera_override_get", NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "Object");
@@ -5399,7 +5399,10 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   prop = RNA_def_property(srna, "sequencer_disk_cache_dir", PROP_STRING, PROP_DIRPATH);
   RNA_def_property_string_sdna(prop, NULL, "sequencer_disk_cache_dir");
   RNA_def_property_update(prop, 0, "rna_Userdef_disk_cache_dir_update");
-  RNA_def_property_ui_text(prop, "Disk Cache Directory", "Override default directory");
+  RNA_def_property_ui_text(
+      prop,
+      "Disk Cache Directory",
+      "Override default directory, sound waveforms are also cached there when it is set");
 
   prop = RNA_def_property(srna, "sequencer_disk_cache_size_limit", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "sequencer_disk_cache_size_limit");
@@ -6242,6 +6245,27 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop,
       "Asset Browser",
       "Enable Asset Browser editor and operators to manage data-blocks as asset");
+
+  prop = RNA_def_property(srna, "use_depsgraph_animation_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_depsgraph_animation_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Skip Unchanged Animation",
+                           "Do not re-evaluate actions on frame change when all their F-Curves "
+                           "evaluate to the same values as on the previous frame");
+
+  prop = RNA_def_property(srna, "use_gpu_shader_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_gpu_shader_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Material Shader Cache",
+                           "Store compiled material shaders on disk, so that they do not need to "
+                           "be compiled again in following sessions");
+
+  prop = RNA_def_property(srna, "use_viewport_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_viewport_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Level of Detail",
+                           "Draw the bounding box of objects that are only a few pixels large in "
+                           "the viewport, and delay the creation of their full geometry");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
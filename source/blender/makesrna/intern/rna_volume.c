@@ -482,6 +482,31 @@ static void rna_def_volume_render(BlenderRNA *brna)
       {0, NULL, 0, NULL, NULL},
   };
 
+  static const EnumPropertyItem precision_items[] = {
+      {VOLUME_PRECISION_FULL, "FULL", 0, "Full", "Full float precision"},
+      {VOLUME_PRECISION_HALF,
+       "HALF",
+       0,
+       "Half",
+       "Half float precision, using half the memory of full precision"},
+      {VOLUME_PRECISION_VARIABLE,
+       "VARIABLE",
+       0,
+       "Variable",
+       "Use variable bit quantization, picking the smallest bit width that keeps the error "
+       "small for each part of the volume"},
+      {0, NULL, 0, NULL, NULL},
+  };
+
+  prop = RNA_def_property(srna, "precision", PROP_ENUM, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_enum_items(prop, precision_items);
+  RNA_def_property_ui_text(prop,
+                           "Precision",
+                           "Specify volume data precision. Lower values reduce memory "
+                           "consumption at the cost of detail");
+  RNA_def_property_update(prop, 0, "rna_Volume_update_display");
+
   prop = RNA_def_property(srna, "space", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_items(prop, space_items);
   RNA_def_property_ui_text(
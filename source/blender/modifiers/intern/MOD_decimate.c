@@ -288,7 +288,8 @@ ModifierTypeInfo modifierType_Decimate = {
     /* structSize */ sizeof(DecimateModifierData),
     /* srna */ &RNA_DecimateModifier,
     /* type */ eModifierTypeType_Nonconstructive,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
+        eModifierTypeFlag_CacheResult,
     /* icon */ ICON_MOD_DECIM,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -304,14 +305,14 @@ ModifierTypeInfo modifierType_Decimate = {
 
     /* initData */ initData,
     /* requiredDataMask */ requiredDataMask,
-    /* freeData */ NULL,
+    /* freeData */ BKE_modifier_result_cache_free_data,
     /* isDisabled */ NULL,
     /* updateDepsgraph */ NULL,
     /* dependsOnTime */ NULL,
     /* dependsOnNormals */ NULL,
     /* foreachIDLink */ NULL,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ BKE_modifier_result_cache_free,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
@@ -55,12 +55,19 @@
 #include "MOD_modifiertypes.h"
 #include "MOD_ui_common.h"
 
-#ifdef WITH_ALEMBIC
-#  include "ABC_alembic.h"
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
 #  include "BKE_global.h"
 #  include "BKE_lib_id.h"
 #endif
 
+#ifdef WITH_ALEMBIC
+#  include "ABC_alembic.h"
+#endif
+
+#ifdef WITH_USD
+#  include "usd.h"
+#endif
+
 static void initData(ModifierData *md)
 {
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)md;
@@ -107,9 +114,55 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return (mcmd->cache_file == NULL) || (mcmd->object_path[0] == '\0');
 }
 
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
+static bool cache_mesh_topology_changed(const CacheFile *cache_file,
+                                        MeshSeqCacheModifierData *mcmd,
+                                        Object *object,
+                                        Mesh *mesh,
+                                        const float time,
+                                        const char **err_str)
+{
+  switch (cache_file->type) {
+    case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+      return ABC_mesh_topology_changed(mcmd->reader, object, mesh, time, err_str);
+#  endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+      return USD_mesh_topology_changed(mcmd->reader, object, mesh, time, err_str);
+#  endif
+      break;
+  }
+  return false;
+}
+
+static Mesh *cache_read_mesh(const CacheFile *cache_file,
+                             MeshSeqCacheModifierData *mcmd,
+                             Object *object,
+                             Mesh *mesh,
+                             const float time,
+                             const char **err_str)
+{
+  switch (cache_file->type) {
+    case CACHEFILE_TYPE_ALEMBIC:
+#  ifdef WITH_ALEMBIC
+      return ABC_read_mesh(mcmd->reader, object, mesh, time, err_str, mcmd->read_flag);
+#  endif
+      break;
+    case CACHEFILE_TYPE_USD:
+#  ifdef WITH_USD
+      return USD_read_mesh(mcmd->reader, object, mesh, time, err_str, mcmd->read_flag);
+#  endif
+      break;
+  }
+  return NULL;
+}
+#endif
+
 static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)md;
 
   /* Only used to check whether we are operating on org data or not... */
@@ -127,15 +180,15 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     BKE_cachefile_reader_open(cache_file, &mcmd->reader, ctx->object, mcmd->object_path);
     if (!mcmd->reader) {
       BKE_modifier_set_error(
-          ctx->object, md, "Could not create Alembic reader for file %s", cache_file->filepath);
+          ctx->object, md, "Could not create reader for file %s", cache_file->filepath);
       return mesh;
     }
   }
 
-  /* If this invocation is for the ORCO mesh, and the mesh in Alembic hasn't changed topology, we
-   * must return the mesh as-is instead of deforming it. */
+  /* If this invocation is for the ORCO mesh, and the mesh in the cache hasn't changed topology,
+   * we must return the mesh as-is instead of deforming it. */
   if (ctx->flag & MOD_APPLY_ORCO &&
-      !ABC_mesh_topology_changed(mcmd->reader, ctx->object, mesh, time, &err_str)) {
+      !cache_mesh_topology_changed(cache_file, mcmd, ctx->object, mesh, time, &err_str)) {
     return mesh;
   }
 
@@ -156,7 +209,7 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     }
   }
 
-  Mesh *result = ABC_read_mesh(mcmd->reader, ctx->object, mesh, time, &err_str, mcmd->read_flag);
+  Mesh *result = cache_read_mesh(cache_file, mcmd, ctx->object, mesh, time, &err_str);
 
   mcmd->velocity_delta = 1.0f;
   if (mcmd->cache_file->velocity_unit == CACHEFILE_VELOCITY_UNIT_SECOND) {
@@ -187,7 +240,7 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 
 static bool dependsOnTime(ModifierData *md)
 {
-#ifdef WITH_ALEMBIC
+#if defined(WITH_ALEMBIC) || defined(WITH_USD)
   MeshSeqCacheModifierData *mcmd = (MeshSeqCacheModifierData *)md;
   return (mcmd->cache_file != NULL);
 #else
@@ -21,18 +21,26 @@
  * \ingroup modifiers
  */
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_float3.hh"
+#include "BLI_hash.h"
 #include "BLI_listbase.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "DNA_collection_types.h"
 #include "DNA_defaults.h"
 #include "DNA_mesh_types.h"
@@ -75,6 +83,7 @@
 #include "NOD_node_tree_multi_function.hh"
 #include "NOD_type_callbacks.hh"
 
+using blender::Array;
 using blender::float3;
 using blender::IndexRange;
 using blender::Map;
@@ -86,6 +95,7 @@ using blender::bke::PersistentCollectionHandle;
 using blender::bke::PersistentDataHandleMap;
 using blender::bke::PersistentObjectHandle;
 using blender::fn::GMutablePointer;
+using blender::fn::GPointer;
 using blender::fn::GValueMap;
 using blender::nodes::GeoNodeExecParams;
 using namespace blender::nodes::derived_node_tree_types;
@@ -212,117 +222,630 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return false;
 }
 
+/**
+ * Compute a key from the content of the geometry passed to the modifier, which is a new one for
+ * every evaluation. Returns false when the geometry contains components that are not supported.
+ */
+static bool geometry_set_content_key(const GeometrySet &geometry_set, uint64_t *r_key)
+{
+  if (geometry_set.has_instances() || geometry_set.has_volume()) {
+    return false;
+  }
+  uint64_t hash = 0;
+  if (const MeshComponent *component = geometry_set.get_component_for_read<MeshComponent>()) {
+    for (const auto item : component->vertex_group_names().items()) {
+      hash = BLI_hash_buffer_u64(item.key.data(), item.key.size(), hash);
+      hash = BLI_hash_u64_combine(hash, (uint64_t)item.value);
+    }
+    if (const Mesh *mesh = component->get_for_read()) {
+      hash = BKE_mesh_content_hash(mesh, hash);
+    }
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+    hash = CustomData_hash(&pointcloud->pdata, pointcloud->totpoint, hash);
+  }
+  *r_key = hash;
+  return true;
+}
+
+/**
+ * Outputs of nodes that took long to compute, kept between evaluations of the modifier so that
+ * changing the inputs of the last nodes of a tree does not recompute the first ones. Entries are
+ * identified by a key computed from the node settings and the keys of its inputs, see
+ * #GeometryNodesEvaluator. Entries that were not used by an evaluation are removed at its end.
+ *
+ * Stored as the runtime data of the evaluated modifier.
+ */
+class NodeOutputsCache {
+ public:
+  /** Outputs that are faster (in seconds) to compute again are not kept. */
+  static constexpr double min_execution_time = 0.005;
+
+ private:
+  struct Entry {
+    Vector<GMutablePointer> values;
+    bool is_used = true;
+  };
+
+  std::mutex mutex_;
+  Map<uint64_t, std::unique_ptr<Entry>> entries_;
+  uint64_t evaluations_num_ = 0;
+
+ public:
+  ~NodeOutputsCache()
+  {
+    for (std::unique_ptr<Entry> &entry : entries_.values()) {
+      free_entry(*entry);
+    }
+  }
+
+  /** Returns a different number for every evaluation using the cache. */
+  uint64_t begin_evaluation()
+  {
+    return ++evaluations_num_;
+  }
+
+  /** Copy the cached values of the outputs into \a r_values, returns false on a cache miss. */
+  bool lookup(const uint64_t key, const DNode &node, GValueMap<StringRef> &r_values)
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    std::unique_ptr<Entry> *entry = entries_.lookup_ptr(key);
+    if (entry == nullptr) {
+      return false;
+    }
+    int index = 0;
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (socket->is_available()) {
+        r_values.add_new_by_copy(socket->identifier(), (*entry)->values[index]);
+        index++;
+      }
+    }
+    (*entry)->is_used = true;
+    return true;
+  }
+
+  void add(const uint64_t key, Span<GMutablePointer> values)
+  {
+    std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+    for (const GMutablePointer value : values) {
+      const CPPType &type = *value.type();
+      void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+      type.copy_to_uninitialized(value.get(), buffer);
+      if (type.is<GeometrySet>()) {
+        ensure_owns_direct_data(*(GeometrySet *)buffer);
+      }
+      entry->values.append({type, buffer});
+    }
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (entries_.contains(key)) {
+      /* An identical node has been added by another thread. */
+      free_entry(*entry);
+      return;
+    }
+    entries_.add_new(key, std::move(entry));
+  }
+
+  void remove_unused_entries()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    Vector<uint64_t> unused_keys;
+    for (auto item : entries_.items()) {
+      if (item.value->is_used) {
+        item.value->is_used = false;
+      }
+      else {
+        unused_keys.append(item.key);
+      }
+    }
+    for (const uint64_t key : unused_keys) {
+      free_entry(*entries_.lookup(key));
+      entries_.remove(key);
+    }
+  }
+
+ private:
+  static void free_entry(Entry &entry)
+  {
+    for (GMutablePointer value : entry.values) {
+      value.destruct();
+      MEM_freeN(value.get());
+    }
+    entry.values.clear();
+  }
+
+  /* Components referencing data owned by someone else, e.g. the mesh passed to the modifier, are
+   * replaced by a copy. The geometry set shares its components with the evaluated one, so they
+   * are copied rather than changed. */
+  static void ensure_owns_direct_data(GeometrySet &geometry_set)
+  {
+    for (const GeometryComponentType type : {GeometryComponentType::Mesh,
+                                             GeometryComponentType::PointCloud,
+                                             GeometryComponentType::Instances,
+                                             GeometryComponentType::Volume}) {
+      const GeometryComponent *component = geometry_set.get_component_for_read(type);
+      if (component != nullptr && !component->owns_direct_data()) {
+        geometry_set.get_component_for_write(type);
+      }
+    }
+  }
+};
+
+/** Identifies a value, equal keys mean equal values. */
+struct ValueKey {
+  uint64_t hash;
+  /** Only valid during the current evaluation, the value can not be cached. */
+  bool is_unique;
+};
+
+/** Evaluation state of a node input, see #NodeState. */
+struct InputState {
+  /** Value forwarded to the socket, null as long as it has not been computed. */
+  GMutablePointer value;
+  /** Set together with the value, kept when the node uses the value. */
+  std::optional<ValueKey> key;
+  /** The node can not be executed (again) before the value is available. */
+  bool is_required = false;
+  /** The node computing the value has been scheduled already. */
+  bool is_requested = false;
+};
+
+/**
+ * Evaluation state of a node. The inputs and flags are shared by all threads and are protected by
+ * the mutex. The allocator and the output values are only used by the thread executing the node,
+ * a node is never executed by more than one thread at a time.
+ */
+struct NodeState {
+  std::mutex mutex;
+  Array<InputState> inputs;
+  bool inputs_initialized = false;
+  /** Number of required inputs that don't have a value yet. */
+  int missing_inputs = 0;
+  /** The node is in the task pool or it is being executed. */
+  bool is_scheduled = false;
+  /** The node is scheduled again once all of its required inputs are available. */
+  bool is_waiting = false;
+  /** All outputs have been computed and forwarded. */
+  bool is_finished = false;
+
+  blender::LinearAllocator<> allocator;
+  /** Outputs computed so far, nodes supporting laziness might need multiple executions. */
+  GValueMap<StringRef> output_values{allocator};
+
+  NodeState(const int inputs_num) : inputs(inputs_num)
+  {
+  }
+};
+
+/**
+ * Computes the group outputs, starting from the nodes they are linked to. A node only requests
+ * the nodes computing its inputs when it is executed, so nodes that don't contribute to the
+ * result are never executed. Nodes supporting laziness request their inputs one by one, which
+ * allows e.g. the switch node to only compute the branch it passes through.
+ *
+ * Every scheduled node is a task of a task pool, so independent nodes are executed in parallel.
+ * A node that is missing inputs does not block its thread, it is pushed to the task pool again
+ * once the last of them has been forwarded to it.
+ *
+ * Every value has a key, computed from the node settings and the keys of the inputs for node
+ * outputs, so that the outputs of nodes can be found in the #NodeOutputsCache.
+ */
 class GeometryNodesEvaluator {
  private:
-  blender::LinearAllocator<> allocator_;
-  Map<const DInputSocket *, GMutablePointer> value_by_input_;
+  Array<std::unique_ptr<NodeState>> node_states_;
   Vector<const DInputSocket *> group_outputs_;
   blender::nodes::MultiFunctionByNode &mf_by_node_;
   const blender::nodes::DataTypeConversions &conversions_;
   const PersistentDataHandleMap &handle_map_;
   const Object *self_object_;
   Depsgraph *depsgraph_;
+  TaskPool *task_pool_ = nullptr;
+  NodeOutputsCache &cache_;
+  /* Used to generate the keys of values that are only valid during this evaluation. */
+  uint64_t evaluation_hash_;
+  std::atomic<uint64_t> unique_keys_num_ = 0;
 
  public:
-  GeometryNodesEvaluator(const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
+  GeometryNodesEvaluator(const DerivedNodeTree &tree,
+                         const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
                          Vector<const DInputSocket *> group_outputs,
                          blender::nodes::MultiFunctionByNode &mf_by_node,
                          const PersistentDataHandleMap &handle_map,
                          const Object *self_object,
-                         Depsgraph *depsgraph)
-      : group_outputs_(std::move(group_outputs)),
+                         Depsgraph *depsgraph,
+                         NodeOutputsCache &cache)
+      : node_states_(tree.nodes().size()),
+        group_outputs_(std::move(group_outputs)),
         mf_by_node_(mf_by_node),
         conversions_(blender::nodes::get_implicit_type_conversions()),
         handle_map_(handle_map),
         self_object_(self_object),
-        depsgraph_(depsgraph)
+        depsgraph_(depsgraph),
+        cache_(cache),
+        evaluation_hash_(BLI_hash_u64_combine(0x5a1b2c3d4e5f6071ull, cache.begin_evaluation()))
   {
+    for (const DNode *node : tree.nodes()) {
+      node_states_[node->id()] = std::make_unique<NodeState>(node->inputs().size());
+    }
     for (auto item : group_input_data.items()) {
-      this->forward_to_inputs(*item.key, item.value);
+      NodeState &state = this->node_state(item.key->node());
+      const ValueKey key = this->value_key(item.value);
+      this->forward_to_inputs(*item.key, item.value, key, state.allocator);
+    }
+    /* The group inputs are never executed, their values are available from the start. */
+    for (const DNode *node : tree.nodes_by_type("NodeGroupInput")) {
+      this->node_state(*node).is_finished = true;
     }
   }
 
   Vector<GMutablePointer> execute()
   {
+    task_pool_ = BLI_task_pool_create(this, TASK_PRIORITY_HIGH);
+    for (const DInputSocket *group_output : group_outputs_) {
+      this->require_group_output(*group_output);
+    }
+    BLI_task_pool_work_and_wait(task_pool_);
+    BLI_task_pool_free(task_pool_);
+    task_pool_ = nullptr;
+
     Vector<GMutablePointer> results;
     for (const DInputSocket *group_output : group_outputs_) {
-      GMutablePointer result = this->get_input_value(*group_output);
-      results.append(result);
+      InputState &input = this->node_state(group_output->node()).inputs[group_output->index()];
+      BLI_assert(input.value.get() != nullptr);
+      results.append(input.value);
+      input.value = {};
     }
-    for (GMutablePointer value : value_by_input_.values()) {
-      value.destruct();
+    /* Destruct the values that have been computed but were not used. */
+    for (std::unique_ptr<NodeState> &state : node_states_) {
+      for (InputState &input : state->inputs) {
+        if (input.value.get() != nullptr) {
+          input.value.destruct();
+        }
+      }
     }
     return results;
   }
 
  private:
-  GMutablePointer get_input_value(const DInputSocket &socket_to_compute)
+  NodeState &node_state(const DNode &node)
   {
-    std::optional<GMutablePointer> value = value_by_input_.pop_try(&socket_to_compute);
-    if (value.has_value()) {
-      /* This input has been computed before, return it directly. */
-      return *value;
-    }
+    return *node_states_[node.id()];
+  }
 
-    Span<const DOutputSocket *> from_sockets = socket_to_compute.linked_sockets();
-    Span<const DGroupInput *> from_group_inputs = socket_to_compute.linked_group_inputs();
-    const int total_inputs = from_sockets.size() + from_group_inputs.size();
-    BLI_assert(total_inputs <= 1);
+  static void run_node_from_task_pool(TaskPool *__restrict pool, void *taskdata)
+  {
+    GeometryNodesEvaluator &evaluator = *(GeometryNodesEvaluator *)BLI_task_pool_user_data(pool);
+    const DNode &node = *(const DNode *)taskdata;
+    evaluator.run_node(node);
+  }
+
+  void push_to_task_pool(const DNode &node)
+  {
+    BLI_task_pool_push(task_pool_, run_node_from_task_pool, (void *)&node, false, nullptr);
+  }
 
-    if (total_inputs == 0) {
-      /* The input is not connected, use the value from the socket itself. */
-      return get_unlinked_input_value(socket_to_compute);
+  void require_group_output(const DInputSocket &socket)
+  {
+    const DNode &node = socket.node();
+    NodeState &state = this->node_state(node);
+    bool request_origin;
+    {
+      /* The group output node is never executed, its inputs only receive the results. */
+      std::lock_guard<std::mutex> lock{state.mutex};
+      if (!state.inputs_initialized) {
+        Vector<const DInputSocket *> sockets_to_request;
+        this->initialize_inputs(node, state, false, sockets_to_request);
+      }
+      request_origin = this->require_input(state, socket);
     }
-    if (from_group_inputs.size() == 1) {
-      /* The input gets its value from the input of a group that is not further connected. */
-      return get_unlinked_input_value(socket_to_compute);
+    if (request_origin) {
+      this->schedule_node(socket.linked_sockets()[0]->node());
     }
+  }
 
-    /* Compute the socket now. */
-    const DOutputSocket &from_socket = *from_sockets[0];
-    this->compute_output_and_forward(from_socket);
-    return value_by_input_.pop(&socket_to_compute);
+  /**
+   * Make sure the node is executed, unless it has been already or it will be once its inputs
+   * have been computed.
+   */
+  void schedule_node(const DNode &node)
+  {
+    NodeState &state = this->node_state(node);
+    {
+      std::lock_guard<std::mutex> lock{state.mutex};
+      if (state.is_finished || state.is_scheduled || state.is_waiting) {
+        return;
+      }
+      state.is_scheduled = true;
+    }
+    this->push_to_task_pool(node);
   }
 
-  void compute_output_and_forward(const DOutputSocket &socket_to_compute)
+  void run_node(const DNode &node)
   {
-    const DNode &node = socket_to_compute.node();
-    const bNode &bnode = *node.bnode();
+    NodeState &state = this->node_state(node);
+    const bool supports_laziness = node.typeinfo()->geometry_node_execute_supports_laziness;
+    Vector<StringRef> lazy_required_inputs;
+    ValueKey node_key = {0, true};
+    bool add_to_cache = false;
+
+    while (true) {
+      Vector<const DInputSocket *> sockets_to_request;
+      GValueMap<StringRef> input_values{state.allocator};
+      bool is_waiting;
+      {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        if (!state.inputs_initialized) {
+          this->initialize_inputs(node, state, !supports_laziness, sockets_to_request);
+        }
+        for (StringRef identifier : lazy_required_inputs) {
+          const DInputSocket &socket = find_input_socket(node, identifier);
+          if (this->require_input(state, socket)) {
+            sockets_to_request.append(&socket);
+          }
+        }
+        is_waiting = state.missing_inputs > 0;
+        if (is_waiting) {
+          /* The node is pushed to the task pool again by #forward_to_input. */
+          state.is_scheduled = false;
+          state.is_waiting = true;
+        }
+        else {
+          for (const DInputSocket *socket : node.inputs()) {
+            InputState &input = state.inputs[socket->index()];
+            if (socket->is_available() && input.value.get() != nullptr) {
+              input_values.add_new_direct(socket->identifier(), input.value);
+              input.value = {};
+            }
+          }
+          if (!supports_laziness) {
+            node_key = this->node_key(node, state);
+          }
+        }
+      }
 
-    if (!socket_to_compute.is_available()) {
-      /* If the output is not available, use a default value. */
-      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket_to_compute.typeinfo());
-      void *buffer = allocator_.allocate(type.size(), type.alignment());
-      type.copy_to_uninitialized(type.default_value(), buffer);
-      this->forward_to_inputs(socket_to_compute, {type, buffer});
-      return;
-    }
+      if (is_waiting) {
+        /* The state must not be used anymore, the node might be running on another thread
+         * already. */
+        for (const DInputSocket *socket : sockets_to_request) {
+          this->schedule_node(socket->linked_sockets()[0]->node());
+        }
+        return;
+      }
 
-    /* Prepare inputs required to execute the node. */
-    GValueMap<StringRef> node_inputs_map{allocator_};
-    for (const DInputSocket *input_socket : node.inputs()) {
-      if (input_socket->is_available()) {
-        GMutablePointer value = this->get_input_value(*input_socket);
-        node_inputs_map.add_new_direct(input_socket->identifier(), value);
+      /* Nodes supporting laziness are not cached, the inputs they use are only known once they
+       * are finished. They are usually cheap, since they don't compute anything themselves. */
+      const bool use_cache = !supports_laziness && !node_key.is_unique;
+      if (use_cache && cache_.lookup(node_key.hash, node, state.output_values)) {
+        break;
+      }
+
+      lazy_required_inputs.clear();
+      GeoNodeExecParams params{*node.bnode(),
+                               input_values,
+                               state.output_values,
+                               handle_map_,
+                               self_object_,
+                               depsgraph_,
+                               &lazy_required_inputs};
+      const double start_time = PIL_check_seconds_timer();
+      this->execute_node(node, params, state.allocator);
+
+      if (!supports_laziness) {
+        add_to_cache = use_cache && PIL_check_seconds_timer() - start_time >=
+                                        NodeOutputsCache::min_execution_time;
+        break;
+      }
+      if (this->has_all_outputs(node, state)) {
+        break;
+      }
+      if (lazy_required_inputs.is_empty()) {
+        /* The node did not set all outputs but does not need more inputs either. */
+        BLI_assert(false);
+        this->set_missing_outputs_to_default(node, state);
+        break;
+      }
+
+      /* Give the values that have not been used back to the node, they are passed to the next
+       * execution. */
+      std::lock_guard<std::mutex> lock{state.mutex};
+      for (const DInputSocket *socket : node.inputs()) {
+        if (input_values.contains(socket->identifier())) {
+          state.inputs[socket->index()].value = input_values.extract(socket->identifier());
+        }
       }
     }
 
-    /* Execute the node. */
-    GValueMap<StringRef> node_outputs_map{allocator_};
-    GeoNodeExecParams params{
-        bnode, node_inputs_map, node_outputs_map, handle_map_, self_object_, depsgraph_};
-    this->execute_node(node, params);
+    if (supports_laziness) {
+      /* All the inputs used by the node are known now. */
+      std::lock_guard<std::mutex> lock{state.mutex};
+      node_key = this->node_key(node, state);
+    }
 
     /* Forward computed outputs to linked input sockets. */
+    Vector<GMutablePointer> output_values;
     for (const DOutputSocket *output_socket : node.outputs()) {
       if (output_socket->is_available()) {
-        GMutablePointer value = node_outputs_map.extract(output_socket->identifier());
-        this->forward_to_inputs(*output_socket, value);
+        output_values.append(state.output_values.extract(output_socket->identifier()));
+      }
+    }
+    if (add_to_cache) {
+      cache_.add(node_key.hash, output_values);
+    }
+    int output_index = 0;
+    for (const DOutputSocket *output_socket : node.outputs()) {
+      if (output_socket->is_available()) {
+        const ValueKey key = {
+            BLI_hash_u64_combine(node_key.hash, (uint64_t)output_socket->index()),
+            node_key.is_unique};
+        this->forward_to_inputs(
+            *output_socket, output_values[output_index], key, state.allocator);
+        output_index++;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock{state.mutex};
+    state.is_scheduled = false;
+    state.is_finished = true;
+  }
+
+  ValueKey unique_key()
+  {
+    return {BLI_hash_u64_combine(evaluation_hash_, unique_keys_num_++), true};
+  }
+
+  /** Key of a value that is not computed by a node, e.g. the geometry passed to the modifier. */
+  ValueKey value_key(const GPointer value)
+  {
+    const CPPType &type = *value.type();
+    if (type.is<GeometrySet>()) {
+      /* The hash of the type is based on the address of the geometry set. */
+      uint64_t hash;
+      if (geometry_set_content_key(*(const GeometrySet *)value.get(), &hash)) {
+        return {hash, false};
+      }
+      return this->unique_key();
+    }
+    return {BLI_hash_u64_combine(blender::DefaultHash<StringRef>{}(type.name()),
+                                 type.hash(value.get())),
+            false};
+  }
+
+  /**
+   * The outputs of a node only depend on its settings and on its inputs, unless it uses other
+   * data-blocks. Must be called with the node state locked.
+   */
+  ValueKey node_key(const DNode &node, const NodeState &state)
+  {
+    const bNode &bnode = *node.bnode();
+    if (bnode.id != nullptr) {
+      /* E.g. a texture, its content is not part of the key. */
+      return this->unique_key();
+    }
+
+    uint64_t hash = blender::DefaultHash<StringRef>{}(bnode.idname);
+    hash = BLI_hash_u64_combine(hash, (uint64_t)bnode.custom1);
+    hash = BLI_hash_u64_combine(hash, (uint64_t)bnode.custom2);
+    hash = BLI_hash_u64_combine(hash, blender::DefaultHash<float>{}(bnode.custom3));
+    hash = BLI_hash_u64_combine(hash, blender::DefaultHash<float>{}(bnode.custom4));
+    if (bnode.storage != nullptr) {
+      hash = BLI_hash_buffer_u64(bnode.storage, MEM_allocN_len(bnode.storage), hash);
+    }
+
+    for (const DInputSocket *socket : node.inputs()) {
+      if (!socket->is_available()) {
+        continue;
+      }
+      if (ELEM(socket->bsocket()->type, SOCK_OBJECT, SOCK_COLLECTION)) {
+        /* The node uses the evaluated data of objects. */
+        return this->unique_key();
+      }
+      const std::optional<ValueKey> &key = state.inputs[socket->index()].key;
+      if (!key.has_value()) {
+        /* Not used by a node supporting laziness. */
+        continue;
+      }
+      if (key->is_unique) {
+        return this->unique_key();
+      }
+      hash = BLI_hash_u64_combine(hash,
+                                  BLI_hash_u64_combine((uint64_t)socket->index(), key->hash));
+    }
+    return {hash, false};
+  }
+
+  /**
+   * Load the values of inputs that don't have to be computed by another node. When
+   * \a require_all is true, all available inputs are required and the linked ones are added to
+   * \a r_sockets_to_request. Must be called with the node state locked.
+   */
+  void initialize_inputs(const DNode &node,
+                         NodeState &state,
+                         const bool require_all,
+                         Vector<const DInputSocket *> &r_sockets_to_request)
+  {
+    state.inputs_initialized = true;
+
+    for (const DInputSocket *socket : node.inputs()) {
+      if (!socket->is_available()) {
+        continue;
+      }
+      InputState &input = state.inputs[socket->index()];
+      if (input.value.get() == nullptr) {
+        Span<const DOutputSocket *> from_sockets = socket->linked_sockets();
+        if (from_sockets.size() == 0) {
+          /* The input is not connected or linked to an unconnected group input. */
+          input.value = this->get_unlinked_input_value(*socket, state.allocator);
+          input.key = this->value_key(input.value);
+        }
+        else if (!from_sockets[0]->is_available()) {
+          /* If the output is not available, use a default value. */
+          const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket->typeinfo());
+          void *buffer = state.allocator.allocate(type.size(), type.alignment());
+          type.copy_to_uninitialized(type.default_value(), buffer);
+          input.value = {type, buffer};
+          input.key = this->value_key(input.value);
+        }
+      }
+      if (require_all && this->require_input(state, *socket)) {
+        r_sockets_to_request.append(socket);
+      }
+    }
+  }
+
+  /**
+   * Tag the input as required. Returns true when the node computing it has to be scheduled.
+   * Must be called with the node state locked.
+   */
+  bool require_input(NodeState &state, const DInputSocket &socket)
+  {
+    InputState &input = state.inputs[socket.index()];
+    if (input.is_required) {
+      return false;
+    }
+    input.is_required = true;
+    if (input.value.get() != nullptr) {
+      return false;
+    }
+    state.missing_inputs++;
+    BLI_assert(!input.is_requested);
+    input.is_requested = true;
+    return true;
+  }
+
+  static const DInputSocket &find_input_socket(const DNode &node, StringRef identifier)
+  {
+    for (const DInputSocket *socket : node.inputs()) {
+      if (socket->identifier() == identifier) {
+        return *socket;
       }
     }
+    BLI_assert(false);
+    return node.input(0);
   }
 
-  void execute_node(const DNode &node, GeoNodeExecParams params)
+  bool has_all_outputs(const DNode &node, const NodeState &state)
+  {
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (socket->is_available() && !state.output_values.contains(socket->identifier())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void set_missing_outputs_to_default(const DNode &node, NodeState &state)
+  {
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (socket->is_available() && !state.output_values.contains(socket->identifier())) {
+        const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket->typeinfo());
+        state.output_values.add_new_by_copy(socket->identifier(), {type, type.default_value()});
+      }
+    }
+  }
+
+  void execute_node(const DNode &node,
+                    GeoNodeExecParams params,
+                    blender::LinearAllocator<> &allocator)
   {
     const bNode &bnode = params.node();
 
@@ -335,7 +858,7 @@ class GeometryNodesEvaluator {
     /* Use the multi-function implementation if it exists. */
     const MultiFunction *multi_function = mf_by_node_.lookup_default(&node, nullptr);
     if (multi_function != nullptr) {
-      this->execute_multi_function_node(node, params, *multi_function);
+      this->execute_multi_function_node(node, params, *multi_function, allocator);
       return;
     }
 
@@ -345,7 +868,8 @@ class GeometryNodesEvaluator {
 
   void execute_multi_function_node(const DNode &node,
                                    GeoNodeExecParams params,
-                                   const MultiFunction &fn)
+                                   const MultiFunction &fn,
+                                   blender::LinearAllocator<> &allocator)
   {
     MFContextBuilder fn_context;
     MFParamsBuilder fn_params{fn, 1};
@@ -361,7 +885,7 @@ class GeometryNodesEvaluator {
     for (const DOutputSocket *dsocket : node.outputs()) {
       if (dsocket->is_available()) {
         const CPPType &type = *blender::nodes::socket_cpp_type_get(*dsocket->typeinfo());
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         fn_params.add_uninitialized_single_output(GMutableSpan(type, buffer, 1));
         output_data.append(GMutablePointer(type, buffer));
       }
@@ -391,7 +915,14 @@ class GeometryNodesEvaluator {
     }
   }
 
-  void forward_to_inputs(const DOutputSocket &from_socket, GMutablePointer value_to_forward)
+  /**
+   * Pass the value to all linked inputs, converting and copying it when necessary. The copies
+   * are allocated with the allocator of the node computing the value.
+   */
+  void forward_to_inputs(const DOutputSocket &from_socket,
+                         GMutablePointer value_to_forward,
+                         const ValueKey key,
+                         blender::LinearAllocator<> &allocator)
   {
     Span<const DInputSocket *> to_sockets_all = from_socket.linked_sockets();
 
@@ -404,14 +935,17 @@ class GeometryNodesEvaluator {
         to_sockets_same_type.append(to_socket);
       }
       else {
-        void *buffer = allocator_.allocate(to_type.size(), to_type.alignment());
+        void *buffer = allocator.allocate(to_type.size(), to_type.alignment());
         if (conversions_.is_convertible(from_type, to_type)) {
           conversions_.convert(from_type, to_type, value_to_forward.get(), buffer);
         }
         else {
           to_type.copy_to_uninitialized(to_type.default_value(), buffer);
         }
-        value_by_input_.add_new(to_socket, GMutablePointer{to_type, buffer});
+        const ValueKey converted_key = {
+            BLI_hash_u64_combine(key.hash, blender::DefaultHash<StringRef>{}(to_type.name())),
+            key.is_unique};
+        this->forward_to_input(*to_socket, GMutablePointer{to_type, buffer}, converted_key);
       }
     }
 
@@ -422,7 +956,7 @@ class GeometryNodesEvaluator {
     else if (to_sockets_same_type.size() == 1) {
       /* This value is only used on one input socket, no need to copy it. */
       const DInputSocket *to_socket = to_sockets_same_type[0];
-      value_by_input_.add_new(to_socket, value_to_forward);
+      this->forward_to_input(*to_socket, value_to_forward, key);
     }
     else {
       /* Multiple inputs use the value, make a copy for every input except for one. */
@@ -430,16 +964,44 @@ class GeometryNodesEvaluator {
       Span<const DInputSocket *> other_to_sockets = to_sockets_same_type.as_span().drop_front(1);
       const CPPType &type = *value_to_forward.type();
 
-      value_by_input_.add_new(first_to_socket, value_to_forward);
       for (const DInputSocket *to_socket : other_to_sockets) {
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         type.copy_to_uninitialized(value_to_forward.get(), buffer);
-        value_by_input_.add_new(to_socket, GMutablePointer{type, buffer});
+        this->forward_to_input(*to_socket, GMutablePointer{type, buffer}, key);
+      }
+      /* Forwarded last, the receiving node might move the value as soon as it has it. */
+      this->forward_to_input(*first_to_socket, value_to_forward, key);
+    }
+  }
+
+  /** Store the value in the input and schedule its node if it was the last one it waited for. */
+  void forward_to_input(const DInputSocket &socket, GMutablePointer value, const ValueKey key)
+  {
+    NodeState &state = this->node_state(socket.node());
+    bool is_ready;
+    {
+      std::lock_guard<std::mutex> lock{state.mutex};
+      InputState &input = state.inputs[socket.index()];
+      BLI_assert(input.value.get() == nullptr);
+      input.value = value;
+      input.key = key;
+      if (!input.is_required) {
+        return;
       }
+      state.missing_inputs--;
+      is_ready = state.missing_inputs == 0 && state.is_waiting;
+      if (is_ready) {
+        state.is_waiting = false;
+        state.is_scheduled = true;
+      }
+    }
+    if (is_ready) {
+      this->push_to_task_pool(socket.node());
     }
   }
 
-  GMutablePointer get_unlinked_input_value(const DInputSocket &socket)
+  GMutablePointer get_unlinked_input_value(const DInputSocket &socket,
+                                           blender::LinearAllocator<> &allocator)
   {
     bNodeSocket *bsocket;
     if (socket.linked_group_inputs().size() == 0) {
@@ -449,7 +1011,7 @@ class GeometryNodesEvaluator {
       bsocket = socket.linked_group_inputs()[0]->bsocket();
     }
     const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket.typeinfo());
-    void *buffer = allocator_.allocate(type.size(), type.alignment());
+    void *buffer = allocator.allocate(type.size(), type.alignment());
 
     if (bsocket->type == SOCK_OBJECT) {
       Object *object = ((bNodeSocketValueObject *)bsocket->default_value)->value;
@@ -885,8 +1447,7 @@ static void fill_data_handle_map(const NodesModifierSettings &settings,
 
 /**
  * Evaluate a node group to compute the output geometry.
- * Currently, this uses a fairly basic and inefficient algorithm that might compute things more
- * often than necessary. It's going to be replaced soon.
+ * Only the nodes the output depends on are executed, independent nodes in parallel.
  */
 static GeometrySet compute_geometry(const DerivedNodeTree &tree,
                                     Span<const DOutputSocket *> group_input_sockets,
@@ -929,13 +1490,26 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   Vector<const DInputSocket *> group_outputs;
   group_outputs.append(&socket_to_compute);
 
-  GeometryNodesEvaluator evaluator{
-      group_inputs, group_outputs, mf_by_node, handle_map, ctx->object, ctx->depsgraph};
+  if (nmd->modifier.runtime == nullptr) {
+    nmd->modifier.runtime = new NodeOutputsCache();
+  }
+  NodeOutputsCache &cache = *(NodeOutputsCache *)nmd->modifier.runtime;
+
+  GeometryNodesEvaluator evaluator{tree,
+                                   group_inputs,
+                                   group_outputs,
+                                   mf_by_node,
+                                   handle_map,
+                                   ctx->object,
+                                   ctx->depsgraph,
+                                   cache};
   Vector<GMutablePointer> results = evaluator.execute();
   BLI_assert(results.size() == 1);
   GMutablePointer result = results[0];
 
   GeometrySet output_geometry = std::move(*(GeometrySet *)result.get());
+  result.destruct();
+  cache.remove_unused_entries();
   return output_geometry;
 }
 
@@ -1172,6 +1746,11 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   }
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  delete (NodeOutputsCache *)runtime_data;
+}
+
 static void freeData(ModifierData *md)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
@@ -1179,6 +1758,8 @@ static void freeData(ModifierData *md)
     IDP_FreeProperty_ex(nmd->settings.properties, false);
     nmd->settings.properties = nullptr;
   }
+  freeRuntimeData(md->runtime);
+  md->runtime = nullptr;
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -1222,7 +1803,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ nullptr,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
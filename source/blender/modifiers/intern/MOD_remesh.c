@@ -289,7 +289,7 @@ ModifierTypeInfo modifierType_Remesh = {
     /* srna */ &RNA_RemeshModifier,
     /* type */ eModifierTypeType_Nonconstructive,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_CacheResult,
     /* icon */ ICON_MOD_REMESH,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -305,14 +305,14 @@ ModifierTypeInfo modifierType_Remesh = {
 
     /* initData */ initData,
     /* requiredDataMask */ NULL,
-    /* freeData */ NULL,
+    /* freeData */ BKE_modifier_result_cache_free_data,
     /* isDisabled */ NULL,
     /* updateDepsgraph */ NULL,
     /* dependsOnTime */ NULL,
     /* dependsOnNormals */ NULL,
     /* foreachIDLink */ NULL,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ BKE_modifier_result_cache_free,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
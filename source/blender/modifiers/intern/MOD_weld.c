@@ -2041,7 +2041,7 @@ ModifierTypeInfo modifierType_Weld = {
     /* type */ eModifierTypeType_Constructive,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsMapping |
         eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
-        eModifierTypeFlag_AcceptsCVs,
+        eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_CacheResult,
     /* icon */ ICON_AUTOMERGE_OFF, /* TODO: Use correct icon. */
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -2057,14 +2057,14 @@ ModifierTypeInfo modifierType_Weld = {
 
     /* initData */ initData,
     /* requiredDataMask */ requiredDataMask,
-    /* freeData */ NULL,
+    /* freeData */ BKE_modifier_result_cache_free_data,
     /* isDisabled */ NULL,
     /* updateDepsgraph */ NULL,
     /* dependsOnTime */ NULL,
     /* dependsOnNormals */ NULL,
     /* foreachIDLink */ NULL,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ BKE_modifier_result_cache_free,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
@@ -59,6 +59,8 @@ class GeoNodeExecParams {
   const PersistentDataHandleMap &handle_map_;
   const Object *self_object_;
   Depsgraph *depsgraph_;
+  /* Inputs requested by a node supporting laziness, only used by these nodes. */
+  Vector<StringRef> *lazy_required_inputs_;
 
  public:
   GeoNodeExecParams(const bNode &node,
@@ -66,16 +68,27 @@ class GeoNodeExecParams {
                     GValueMap<StringRef> &output_values,
                     const PersistentDataHandleMap &handle_map,
                     const Object *self_object,
-                    Depsgraph *depsgraph)
+                    Depsgraph *depsgraph,
+                    Vector<StringRef> *lazy_required_inputs = nullptr)
       : node_(node),
         input_values_(input_values),
         output_values_(output_values),
         handle_map_(handle_map),
         self_object_(self_object),
-        depsgraph_(depsgraph)
+        depsgraph_(depsgraph),
+        lazy_required_inputs_(lazy_required_inputs)
   {
   }
 
+  /**
+   * Tell the evaluator that the input with the given identifier is needed. Returns true when the
+   * value is not available yet, in which case the node should return and it will be executed
+   * again once the value has been computed. Inputs that are never required are not computed.
+   *
+   * This can only be used by nodes supporting laziness, other nodes get all their inputs.
+   */
+  bool lazy_require_input(StringRef identifier);
+
   /**
    * Get the input value for the input socket with the given identifier.
    *
@@ -15,6 +15,9 @@
  */
 
 #include "BLI_listbase.h"
+
+#include "NOD_geometry_exec.hh"
+
 #include "node_function_util.hh"
 
 static bNodeSocketTemplate fn_node_switch_in[] = {
@@ -28,6 +31,8 @@ static bNodeSocketTemplate fn_node_switch_in[] = {
     {SOCK_RGBA, N_("If False"), 0.8f, 0.8f, 0.8f, 1.0f},
     {SOCK_OBJECT, N_("If False")},
     {SOCK_IMAGE, N_("If False")},
+    {SOCK_GEOMETRY, N_("If False")},
+    {SOCK_COLLECTION, N_("If False")},
 
     {SOCK_FLOAT, N_("If True"), 0.0f, 0.0f, 0.0f, 0.0f, -10000.0f, 10000.0f},
     {SOCK_INT, N_("If True"), 0, 0, 0, 0, -10000, 10000},
@@ -37,6 +42,8 @@ static bNodeSocketTemplate fn_node_switch_in[] = {
     {SOCK_RGBA, N_("If True"), 0.8f, 0.8f, 0.8f, 1.0f},
     {SOCK_OBJECT, N_("If True")},
     {SOCK_IMAGE, N_("If True")},
+    {SOCK_GEOMETRY, N_("If True")},
+    {SOCK_COLLECTION, N_("If True")},
 
     {-1, ""},
 };
@@ -50,6 +57,8 @@ static bNodeSocketTemplate fn_node_switch_out[] = {
     {SOCK_RGBA, N_("Result")},
     {SOCK_OBJECT, N_("Result")},
     {SOCK_IMAGE, N_("Result")},
+    {SOCK_GEOMETRY, N_("Result")},
+    {SOCK_COLLECTION, N_("Result")},
     {-1, ""},
 };
 
@@ -65,6 +74,42 @@ static void fn_node_switch_update(bNodeTree *UNUSED(ntree), bNode *node)
   }
 }
 
+namespace blender::nodes {
+
+static const bNodeSocket *find_available_socket(const ListBase &sockets, const StringRef name)
+{
+  LISTBASE_FOREACH (const bNodeSocket *, socket, &sockets) {
+    if ((socket->flag & SOCK_UNAVAIL) == 0 && name == socket->name) {
+      return socket;
+    }
+  }
+  return nullptr;
+}
+
+static void fn_node_switch_geometry_exec(GeoNodeExecParams params)
+{
+  /* Only the input that is passed through is computed, the other branch is not evaluated. */
+  if (params.lazy_require_input("Switch")) {
+    return;
+  }
+  const bool switch_value = params.get_input<bool>("Switch");
+
+  const bNode &node = params.node();
+  const bNodeSocket *input_socket = find_available_socket(node.inputs,
+                                                          switch_value ? "If True" : "If False");
+  const bNodeSocket *output_socket = find_available_socket(node.outputs, "Result");
+  BLI_assert(input_socket != nullptr && output_socket != nullptr);
+
+  if (params.lazy_require_input(input_socket->identifier)) {
+    return;
+  }
+  GMutablePointer value = params.extract_input(input_socket->identifier);
+  params.set_output_by_move(output_socket->identifier, value);
+  value.destruct();
+}
+
+}  // namespace blender::nodes
+
 void register_node_type_fn_switch()
 {
   static bNodeType ntype;
@@ -72,5 +117,7 @@ void register_node_type_fn_switch()
   fn_node_type_base(&ntype, FN_NODE_SWITCH, "Switch", 0, 0);
   node_type_socket_templates(&ntype, fn_node_switch_in, fn_node_switch_out);
   node_type_update(&ntype, fn_node_switch_update);
+  ntype.geometry_node_execute = blender::nodes::fn_node_switch_geometry_exec;
+  ntype.geometry_node_execute_supports_laziness = true;
   nodeRegisterType(&ntype);
 }
@@ -17,6 +17,8 @@
 #include "node_geometry_util.hh"
 #include "node_util.h"
 
+#include "BLI_task.hh"
+
 namespace blender::nodes {
 
 /**
@@ -89,6 +91,28 @@ CustomDataType attribute_data_type_highest_complexity(Span<CustomDataType> data_
   return most_complex_type;
 }
 
+/**
+ * Evaluate a multi-function with single inputs followed by a single output for all elements of
+ * \a output. The elements are processed in chunks in parallel, which also keeps the values of a
+ * chunk in the CPU cache when the function is made of several steps.
+ */
+void evaluate_multi_function_on_attributes(const fn::MultiFunction &fn,
+                                           Span<fn::GVSpan> inputs,
+                                           fn::GMutableSpan output)
+{
+  BLI_assert(fn.param_amount() == inputs.size() + 1);
+  const int64_t size = output.size();
+  parallel_for(IndexRange(size), 4096, [&](const IndexRange range) {
+    fn::MFParamsBuilder params{fn, size};
+    for (const fn::GVSpan &input : inputs) {
+      params.add_readonly_single_input(input);
+    }
+    params.add_uninitialized_single_output(output);
+    fn::MFContextBuilder context;
+    fn.call(range, params, context);
+  });
+}
+
 }  // namespace blender::nodes
 
 bool geo_node_poll_default(bNodeType *UNUSED(ntype), bNodeTree *ntree)
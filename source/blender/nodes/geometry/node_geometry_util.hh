@@ -29,6 +29,8 @@
 
 #include "BLT_translation.h"
 
+#include "FN_multi_function_builder.hh"
+
 #include "NOD_geometry.h"
 #include "NOD_geometry_exec.hh"
 
@@ -49,4 +51,100 @@ CustomDataType attribute_data_type_highest_complexity(Span<CustomDataType>);
 Array<uint32_t> get_geometry_element_ids_as_uints(const GeometryComponent &component,
                                                   const AttributeDomain domain);
 
+void evaluate_multi_function_on_attributes(const fn::MultiFunction &fn,
+                                           Span<fn::GVSpan> inputs,
+                                           fn::GMutableSpan output);
+
+/* Indexed like a span, but always returns the same value. */
+template<typename T> struct SingleValueSpan {
+  T value;
+
+  const T &operator[](const int64_t UNUSED(index)) const
+  {
+    return value;
+  }
+};
+
+/**
+ * Call \a func with either a #SingleValueSpan or a #Span giving access to the values of \a span.
+ * Loops in \a func are compiled for each case, so that they don't check the kind of virtual span
+ * for every element and can be vectorized.
+ */
+template<typename T, typename Func>
+inline void devirtualize_vspan(const fn::VSpan<T> span, const Func &func)
+{
+  if (span.is_single_element()) {
+    func(SingleValueSpan<T>{span.as_single_element()});
+  }
+  else if (span.is_full_array()) {
+    func(span.as_full_array());
+  }
+  else {
+    func(span);
+  }
+}
+
+/**
+ * Multi-functions computing \a element_fn for every index, with loops devirtualized using
+ * #devirtualize_vspan. There is one function for every type of \a element_fn, so it has to be a
+ * lambda or function object without state.
+ */
+template<typename In1, typename Out1, typename ElementFn>
+const fn::MultiFunction &get_multi_function_SI_SO(StringRef name, const ElementFn element_fn)
+{
+  using FunctionT = std::function<void(IndexMask, fn::VSpan<In1>, MutableSpan<Out1>)>;
+  static fn::CustomMF_SI_SO<In1, Out1> fn{
+      name, FunctionT([=](IndexMask mask, fn::VSpan<In1> in1, MutableSpan<Out1> out1) {
+        devirtualize_vspan(in1, [&](const auto values1) {
+          mask.foreach_index([&](const int64_t i) { out1[i] = element_fn(values1[i]); });
+        });
+      })};
+  return fn;
+}
+
+template<typename In1, typename In2, typename Out1, typename ElementFn>
+const fn::MultiFunction &get_multi_function_SI_SI_SO(StringRef name, const ElementFn element_fn)
+{
+  using FunctionT =
+      std::function<void(IndexMask, fn::VSpan<In1>, fn::VSpan<In2>, MutableSpan<Out1>)>;
+  static fn::CustomMF_SI_SI_SO<In1, In2, Out1> fn{
+      name,
+      FunctionT(
+          [=](IndexMask mask, fn::VSpan<In1> in1, fn::VSpan<In2> in2, MutableSpan<Out1> out1) {
+            devirtualize_vspan(in1, [&](const auto values1) {
+              devirtualize_vspan(in2, [&](const auto values2) {
+                mask.foreach_index(
+                    [&](const int64_t i) { out1[i] = element_fn(values1[i], values2[i]); });
+              });
+            });
+          })};
+  return fn;
+}
+
+template<typename In1, typename In2, typename In3, typename Out1, typename ElementFn>
+const fn::MultiFunction &get_multi_function_SI_SI_SI_SO(StringRef name,
+                                                        const ElementFn element_fn)
+{
+  using FunctionT = std::function<void(
+      IndexMask, fn::VSpan<In1>, fn::VSpan<In2>, fn::VSpan<In3>, MutableSpan<Out1>)>;
+  static fn::CustomMF_SI_SI_SI_SO<In1, In2, In3, Out1> fn{
+      name,
+      FunctionT([=](IndexMask mask,
+                    fn::VSpan<In1> in1,
+                    fn::VSpan<In2> in2,
+                    fn::VSpan<In3> in3,
+                    MutableSpan<Out1> out1) {
+        devirtualize_vspan(in1, [&](const auto values1) {
+          devirtualize_vspan(in2, [&](const auto values2) {
+            devirtualize_vspan(in3, [&](const auto values3) {
+              mask.foreach_index([&](const int64_t i) {
+                out1[i] = element_fn(values1[i], values2[i], values3[i]);
+              });
+            });
+          });
+        });
+      })};
+  return fn;
+}
+
 }  // namespace blender::nodes
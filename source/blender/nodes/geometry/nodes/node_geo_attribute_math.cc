@@ -138,49 +138,27 @@ static void geo_node_attribute_math_update(bNodeTree *UNUSED(ntree), bNode *node
       operation_use_input_c(operation));
 }
 
-static void do_math_operation(Span<float> span_a,
-                              Span<float> span_b,
-                              Span<float> span_c,
-                              MutableSpan<float> span_result,
-                              const NodeMathOperation operation)
+static const fn::MultiFunction &get_multi_function(const NodeMathOperation operation)
 {
-  bool success = try_dispatch_float_math_fl_fl_fl_to_fl(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(span_result.size())) {
-          span_result[i] = math_function(span_a[i], span_b[i], span_c[i]);
-        }
-      });
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
+  const fn::MultiFunction *multi_fn = nullptr;
 
-static void do_math_operation(Span<float> span_a,
-                              Span<float> span_b,
-                              MutableSpan<float> span_result,
-                              const NodeMathOperation operation)
-{
-  bool success = try_dispatch_float_math_fl_fl_to_fl(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(span_result.size())) {
-          span_result[i] = math_function(span_a[i], span_b[i]);
-        }
+  try_dispatch_float_math_fl_to_fl(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SO<float, float>(info.title_case_name, math_function);
       });
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
-
-static void do_math_operation(Span<float> span_input,
-                              MutableSpan<float> span_result,
-                              const NodeMathOperation operation)
-{
-  bool success = try_dispatch_float_math_fl_to_fl(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(span_result.size())) {
-          span_result[i] = math_function(span_input[i]);
-        }
+  try_dispatch_float_math_fl_fl_to_fl(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SO<float, float, float>(info.title_case_name,
+                                                                     math_function);
       });
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
+  try_dispatch_float_math_fl_fl_fl_to_fl(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SI_SO<float, float, float, float>(
+            info.title_case_name, math_function);
+      });
+
+  BLI_assert(multi_fn != nullptr);
+  return *multi_fn;
 }
 
 static void attribute_math_calc(GeometryComponent &component, const GeoNodeExecParams &params)
@@ -202,45 +180,38 @@ static void attribute_math_calc(GeometryComponent &component, const GeoNodeExecP
     return;
   }
 
-  ReadAttributePtr attribute_a = params.get_input_attribute(
-      "A", component, result_domain, result_type, nullptr);
-  if (!attribute_a) {
+  /* Inputs with a single value are not expanded to arrays. The attributes are kept alive until
+   * the function has been evaluated. */
+  Vector<ReadAttributePtr, 3> attributes;
+  Vector<fn::GVSpan, 3> inputs;
+  auto add_input = [&](const StringRef name) {
+    ReadAttributePtr attribute = params.get_input_attribute(
+        name, component, result_domain, result_type, nullptr);
+    if (!attribute) {
+      return false;
+    }
+    inputs.append(attribute->get_virtual_span());
+    attributes.append(std::move(attribute));
+    return true;
+  };
+
+  if (!add_input("A")) {
     return;
   }
-
-  /* Note that passing the data with `get_span<float>()` works
-   * because the attributes were accessed with #CD_PROP_FLOAT. */
   if (operation_use_input_b(operation)) {
-    ReadAttributePtr attribute_b = params.get_input_attribute(
-        "B", component, result_domain, result_type, nullptr);
-    if (!attribute_b) {
+    if (!add_input("B")) {
       return;
     }
     if (operation_use_input_c(operation)) {
-      ReadAttributePtr attribute_c = params.get_input_attribute(
-          "C", component, result_domain, result_type, nullptr);
-      if (!attribute_c) {
+      if (!add_input("C")) {
         return;
       }
-      do_math_operation(attribute_a->get_span<float>(),
-                        attribute_b->get_span<float>(),
-                        attribute_c->get_span<float>(),
-                        attribute_result->get_span_for_write_only<float>(),
-                        operation);
     }
-    else {
-      do_math_operation(attribute_a->get_span<float>(),
-                        attribute_b->get_span<float>(),
-                        attribute_result->get_span_for_write_only<float>(),
-                        operation);
-    }
-  }
-  else {
-    do_math_operation(attribute_a->get_span<float>(),
-                      attribute_result->get_span_for_write_only<float>(),
-                      operation);
   }
 
+  evaluate_multi_function_on_attributes(
+      get_multi_function(operation), inputs, attribute_result->get_span_for_write_only());
+
   attribute_result.apply_span_and_save();
 }
 
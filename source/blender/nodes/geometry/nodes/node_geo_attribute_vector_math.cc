@@ -140,169 +140,42 @@ static void geo_node_attribute_vector_math_update(bNodeTree *UNUSED(ntree), bNod
       operation_use_input_c(operation));
 }
 
-static void do_math_operation_fl3_fl3_to_fl3(const Float3ReadAttribute &input_a,
-                                             const Float3ReadAttribute &input_b,
-                                             Float3WriteAttribute result,
-                                             const NodeVectorMathOperation operation)
+static const fn::MultiFunction &get_multi_function(const NodeVectorMathOperation operation)
 {
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  Span<float3> span_b = input_b.get_span();
-  MutableSpan<float3> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_fl3_to_fl3(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 a = span_a[i];
-          const float3 b = span_b[i];
-          const float3 out = math_function(a, b);
-          span_result[i] = out;
-        }
-      });
-
-  result.apply_span();
-
-  /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
+  const fn::MultiFunction *multi_fn = nullptr;
 
-static void do_math_operation_fl3_fl3_fl3_to_fl3(const Float3ReadAttribute &input_a,
-                                                 const Float3ReadAttribute &input_b,
-                                                 const Float3ReadAttribute &input_c,
-                                                 Float3WriteAttribute result,
-                                                 const NodeVectorMathOperation operation)
-{
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  Span<float3> span_b = input_b.get_span();
-  Span<float3> span_c = input_c.get_span();
-  MutableSpan<float3> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_fl3_fl3_to_fl3(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 a = span_a[i];
-          const float3 b = span_b[i];
-          const float3 c = span_c[i];
-          const float3 out = math_function(a, b, c);
-          span_result[i] = out;
-        }
+  try_dispatch_float_math_fl3_fl3_to_fl3(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SO<float3, float3, float3>(info.title_case_name,
+                                                                        math_function);
       });
-
-  result.apply_span();
-
-  /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
-
-static void do_math_operation_fl3_fl3_to_fl(const Float3ReadAttribute &input_a,
-                                            const Float3ReadAttribute &input_b,
-                                            FloatWriteAttribute result,
-                                            const NodeVectorMathOperation operation)
-{
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  Span<float3> span_b = input_b.get_span();
-  MutableSpan<float> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_fl3_to_fl(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 a = span_a[i];
-          const float3 b = span_b[i];
-          const float out = math_function(a, b);
-          span_result[i] = out;
-        }
+  try_dispatch_float_math_fl3_fl3_fl3_to_fl3(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SI_SO<float3, float3, float3, float3>(
+            info.title_case_name, math_function);
       });
-
-  result.apply_span();
-
-  /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
-
-static void do_math_operation_fl3_fl_to_fl3(const Float3ReadAttribute &input_a,
-                                            const FloatReadAttribute &input_b,
-                                            Float3WriteAttribute result,
-                                            const NodeVectorMathOperation operation)
-{
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  Span<float> span_b = input_b.get_span();
-  MutableSpan<float3> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_fl_to_fl3(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 a = span_a[i];
-          const float b = span_b[i];
-          const float3 out = math_function(a, b);
-          span_result[i] = out;
-        }
+  try_dispatch_float_math_fl3_fl3_to_fl(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SO<float3, float3, float>(info.title_case_name,
+                                                                       math_function);
       });
-
-  result.apply_span();
-
-  /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
-
-static void do_math_operation_fl3_to_fl3(const Float3ReadAttribute &input_a,
-                                         Float3WriteAttribute result,
-                                         const NodeVectorMathOperation operation)
-{
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  MutableSpan<float3> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_to_fl3(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 in = span_a[i];
-          const float3 out = math_function(in);
-          span_result[i] = out;
-        }
+  try_dispatch_float_math_fl3_fl_to_fl3(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SI_SO<float3, float, float3>(info.title_case_name,
+                                                                       math_function);
       });
-
-  result.apply_span();
-
-  /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
-}
-
-static void do_math_operation_fl3_to_fl(const Float3ReadAttribute &input_a,
-                                        FloatWriteAttribute result,
-                                        const NodeVectorMathOperation operation)
-{
-  const int size = input_a.size();
-
-  Span<float3> span_a = input_a.get_span();
-  MutableSpan<float> span_result = result.get_span_for_write_only();
-
-  bool success = try_dispatch_float_math_fl3_to_fl(
-      operation, [&](auto math_function, const FloatMathOperationInfo &UNUSED(info)) {
-        for (const int i : IndexRange(size)) {
-          const float3 in = span_a[i];
-          const float out = math_function(in);
-          span_result[i] = out;
-        }
+  try_dispatch_float_math_fl3_to_fl3(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SO<float3, float3>(info.title_case_name, math_function);
+      });
+  try_dispatch_float_math_fl3_to_fl(
+      operation, [&](auto math_function, const FloatMathOperationInfo &info) {
+        multi_fn = &get_multi_function_SI_SO<float3, float>(info.title_case_name, math_function);
       });
-
-  result.apply_span();
 
   /* The operation is not supported by this node currently. */
-  BLI_assert(success);
-  UNUSED_VARS_NDEBUG(success);
+  BLI_assert(multi_fn != nullptr);
+  return *multi_fn;
 }
 
 static void attribute_vector_math_calc(GeometryComponent &component,
@@ -351,46 +224,20 @@ static void attribute_vector_math_calc(GeometryComponent &component,
     return;
   }
 
-  switch (operation) {
-    case NODE_VECTOR_MATH_ADD:
-    case NODE_VECTOR_MATH_SUBTRACT:
-    case NODE_VECTOR_MATH_MULTIPLY:
-    case NODE_VECTOR_MATH_DIVIDE:
-    case NODE_VECTOR_MATH_CROSS_PRODUCT:
-    case NODE_VECTOR_MATH_PROJECT:
-    case NODE_VECTOR_MATH_REFLECT:
-    case NODE_VECTOR_MATH_SNAP:
-    case NODE_VECTOR_MATH_MODULO:
-    case NODE_VECTOR_MATH_MINIMUM:
-    case NODE_VECTOR_MATH_MAXIMUM:
-      do_math_operation_fl3_fl3_to_fl3(*attribute_a, *attribute_b, *attribute_result, operation);
-      break;
-    case NODE_VECTOR_MATH_DOT_PRODUCT:
-    case NODE_VECTOR_MATH_DISTANCE:
-      do_math_operation_fl3_fl3_to_fl(*attribute_a, *attribute_b, *attribute_result, operation);
-      break;
-    case NODE_VECTOR_MATH_LENGTH:
-      do_math_operation_fl3_to_fl(*attribute_a, *attribute_result, operation);
-      break;
-    case NODE_VECTOR_MATH_SCALE:
-      do_math_operation_fl3_fl_to_fl3(*attribute_a, *attribute_b, *attribute_result, operation);
-      break;
-    case NODE_VECTOR_MATH_NORMALIZE:
-    case NODE_VECTOR_MATH_FLOOR:
-    case NODE_VECTOR_MATH_CEIL:
-    case NODE_VECTOR_MATH_FRACTION:
-    case NODE_VECTOR_MATH_ABSOLUTE:
-    case NODE_VECTOR_MATH_SINE:
-    case NODE_VECTOR_MATH_COSINE:
-    case NODE_VECTOR_MATH_TANGENT:
-      do_math_operation_fl3_to_fl3(*attribute_a, *attribute_result, operation);
-      break;
-    case NODE_VECTOR_MATH_WRAP:
-      do_math_operation_fl3_fl3_fl3_to_fl3(
-          *attribute_a, *attribute_b, *attribute_c, *attribute_result, operation);
-      break;
+  /* Inputs with a single value are not expanded to arrays. */
+  Vector<fn::GVSpan, 3> inputs;
+  inputs.append(attribute_a->get_virtual_span());
+  if (use_input_b) {
+    inputs.append(attribute_b->get_virtual_span());
   }
-  attribute_result.save();
+  if (use_input_c) {
+    inputs.append(attribute_c->get_virtual_span());
+  }
+
+  evaluate_multi_function_on_attributes(
+      get_multi_function(operation), inputs, attribute_result->get_span_for_write_only());
+
+  attribute_result.apply_span_and_save();
 }
 
 static void geo_node_attribute_vector_math_exec(GeoNodeExecParams params)
@@ -17,14 +17,22 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_float4x4.hh"
 #include "BLI_math_matrix.h"
 
+#include "DNA_collection_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
 
 #include "RNA_enum_types.h"
 
+#include "BKE_collection.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_wrapper.h"
+#include "BKE_modifier.h"
+
+#include "DEG_depsgraph_query.h"
 
 #include "bmesh.h"
 #include "tools/bmesh_boolean.h"
@@ -47,9 +55,30 @@ static int bm_face_isect_pair(BMFace *f, void *UNUSED(user_data))
   return BM_elem_flag_test(f, BM_ELEM_DRAW) ? 1 : 0;
 }
 
-static Mesh *mesh_boolean_calc(const Mesh *mesh_a, const Mesh *mesh_b, int boolean_mode)
+namespace blender::nodes {
+
+/** A mesh of the second operand, with its transform into the space of the modified object. */
+struct BooleanOperandMesh {
+  const Mesh *mesh;
+  float4x4 transform;
+};
+
+/**
+ * Compute the boolean of the first mesh with all meshes of the second operand at once. The meshes
+ * of the second operand are treated as a single shape, so that cutting many holes only requires
+ * one intersection pass instead of a chain of booleans.
+ */
+static Mesh *mesh_boolean_calc(const Mesh *mesh_a,
+                               Span<BooleanOperandMesh> meshes_b,
+                               int boolean_mode)
 {
-  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(mesh_a, mesh_b);
+  BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(mesh_a);
+  for (const BooleanOperandMesh &mesh_b : meshes_b) {
+    allocsize.totvert += mesh_b.mesh->totvert;
+    allocsize.totedge += mesh_b.mesh->totedge;
+    allocsize.totloop += mesh_b.mesh->totloop;
+    allocsize.totface += mesh_b.mesh->totpoly;
+  }
 
   BMesh *bm;
   {
@@ -61,7 +90,26 @@ static Mesh *mesh_boolean_calc(const Mesh *mesh_a, const Mesh *mesh_b, int boole
   {
     struct BMeshFromMeshParams bmesh_from_mesh_params = {0};
     bmesh_from_mesh_params.calc_face_normal = true;
-    BM_mesh_bm_from_me(bm, mesh_b, &bmesh_from_mesh_params);
+    for (const BooleanOperandMesh &mesh_b : meshes_b) {
+      const int verts_start = bm->totvert;
+      const int faces_start = bm->totface;
+      BM_mesh_bm_from_me(bm, mesh_b.mesh, &bmesh_from_mesh_params);
+      if (equals_m4m4(mesh_b.transform.values, float4x4::identity().values)) {
+        continue;
+      }
+      /* The new elements are appended, so they are the last ones in the mesh. */
+      BM_mesh_elem_table_ensure(bm, BM_VERT | BM_FACE);
+      for (const int i : IndexRange(verts_start, bm->totvert - verts_start)) {
+        BMVert *bm_vert = BM_vert_at_index(bm, i);
+        copy_v3_v3(bm_vert->co, mesh_b.transform * float3(bm_vert->co));
+      }
+      if (is_negative_m4(mesh_b.transform.values)) {
+        /* Keep the faces pointing outwards, the boolean depends on their orientation. */
+        for (const int i : IndexRange(faces_start, bm->totface - faces_start)) {
+          BM_face_normal_flip(bm, BM_face_at_index(bm, i));
+        }
+      }
+    }
     BM_mesh_bm_from_me(bm, mesh_a, &bmesh_from_mesh_params);
   }
 
@@ -71,7 +119,7 @@ static Mesh *mesh_boolean_calc(const Mesh *mesh_a, const Mesh *mesh_b, int boole
                             (*)[3])(MEM_malloc_arrayN(looptris_tot, sizeof(*looptris), __func__));
   BM_mesh_calc_tessellation_beauty(bm, looptris, &tottri);
 
-  const int i_faces_end = mesh_b->totpoly;
+  const int i_faces_end = bm->totface - mesh_a->totpoly;
 
   /* We need face normals because of 'BM_face_split_edgenet'
    * we could calculate on the fly too (before calling split). */
@@ -80,15 +128,16 @@ static Mesh *mesh_boolean_calc(const Mesh *mesh_a, const Mesh *mesh_b, int boole
   BMIter iter;
   BMFace *bm_face;
   BM_ITER_MESH (bm_face, &iter, bm, BM_FACES_OF_MESH) {
-    normalize_v3(bm_face->no);
+    if (i == i_faces_end) {
+      break;
+    }
+    /* The vertices might have been transformed after the normals were calculated. */
+    BM_face_normal_update(bm_face);
 
     /* Temp tag to test which side split faces are from. */
     BM_elem_flag_enable(bm_face, BM_ELEM_DRAW);
 
     i++;
-    if (i == i_faces_end) {
-      break;
-    }
   }
 
   BM_mesh_boolean(
@@ -102,7 +151,71 @@ static Mesh *mesh_boolean_calc(const Mesh *mesh_a, const Mesh *mesh_b, int boole
   return result;
 }
 
-namespace blender::nodes {
+static void add_object_operand_mesh(const Object &object,
+                                    const float4x4 &transform,
+                                    Vector<BooleanOperandMesh> &r_meshes)
+{
+  if (object.type != OB_MESH) {
+    return;
+  }
+  Mesh *mesh = BKE_modifier_get_evaluated_mesh_from_evaluated_object(
+      const_cast<Object *>(&object), false);
+  if (mesh == nullptr || mesh->totpoly == 0) {
+    return;
+  }
+  BKE_mesh_wrapper_ensure_mdata(mesh);
+  r_meshes.append({mesh, transform});
+}
+
+/**
+ * Gather the meshes of the geometry, including the ones of mesh objects referenced by instances.
+ * The instanced meshes are not copied, they are transformed while they are added to the BMesh.
+ */
+static Vector<BooleanOperandMesh> gather_operand_meshes(const GeometrySet &geometry_set,
+                                                        const GeoNodeExecParams &params)
+{
+  Vector<BooleanOperandMesh> meshes;
+  const Mesh *mesh = geometry_set.get_mesh_for_read();
+  if (mesh != nullptr) {
+    meshes.append({mesh, float4x4::identity()});
+  }
+
+  const InstancesComponent *instances = geometry_set.get_component_for_read<InstancesComponent>();
+  if (instances == nullptr) {
+    return meshes;
+  }
+  const Object *self_object = params.self_object();
+  const eEvaluationMode mode = DEG_get_mode(params.depsgraph());
+  Span<InstancedData> instanced_data = instances->instanced_data();
+  Span<float4x4> transforms = instances->transforms();
+  for (const int i : instanced_data.index_range()) {
+    const InstancedData &data = instanced_data[i];
+    if (data.type == INSTANCE_DATA_TYPE_OBJECT) {
+      const Object *object = data.data.object;
+      if (object != nullptr && object != self_object) {
+        add_object_operand_mesh(*object, transforms[i], meshes);
+      }
+    }
+    else if (data.type == INSTANCE_DATA_TYPE_COLLECTION) {
+      Collection *collection = data.data.collection;
+      if (collection == nullptr) {
+        continue;
+      }
+      float4x4 collection_transform = float4x4::identity();
+      sub_v3_v3(collection_transform.values[3], collection->instance_offset);
+      collection_transform = transforms[i] * collection_transform;
+      FOREACH_COLLECTION_VISIBLE_OBJECT_RECURSIVE_BEGIN (collection, object, mode) {
+        if (object != self_object) {
+          add_object_operand_mesh(
+              *object, collection_transform * float4x4(object->obmat), meshes);
+        }
+      }
+      FOREACH_COLLECTION_VISIBLE_OBJECT_RECURSIVE_END;
+    }
+  }
+  return meshes;
+}
+
 static void geo_node_boolean_exec(GeoNodeExecParams params)
 {
   GeometrySet geometry_set_in_a = params.extract_input<GeometrySet>("Geometry 1");
@@ -117,9 +230,9 @@ static void geo_node_boolean_exec(GeoNodeExecParams params)
   }
 
   const Mesh *mesh_in_a = geometry_set_in_a.get_mesh_for_read();
-  const Mesh *mesh_in_b = geometry_set_in_b.get_mesh_for_read();
+  const Vector<BooleanOperandMesh> meshes_in_b = gather_operand_meshes(geometry_set_in_b, params);
 
-  if (mesh_in_a == nullptr || mesh_in_b == nullptr) {
+  if (mesh_in_a == nullptr || meshes_in_b.is_empty()) {
     if (operation == GEO_NODE_BOOLEAN_UNION) {
       if (mesh_in_a != nullptr) {
         params.set_output("Geometry", geometry_set_in_a);
@@ -134,7 +247,7 @@ static void geo_node_boolean_exec(GeoNodeExecParams params)
     return;
   }
 
-  Mesh *mesh_out = mesh_boolean_calc(mesh_in_a, mesh_in_b, operation);
+  Mesh *mesh_out = mesh_boolean_calc(mesh_in_a, meshes_in_b, operation);
   geometry_set_out = GeometrySet::create_with_mesh(mesh_out);
 
   params.set_output("Geometry", std::move(geometry_set_out));
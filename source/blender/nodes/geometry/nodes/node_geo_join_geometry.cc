@@ -232,14 +232,25 @@ static void join_components(Span<const PointCloudComponent *> src_components, Ge
 
 static void join_components(Span<const InstancesComponent *> src_components, GeometrySet &result)
 {
+  int tot_instances = 0;
+  for (const InstancesComponent *component : src_components) {
+    tot_instances += component->instances_amount();
+  }
+
+  /* Only the references to the instanced data are copied, the instances are not realized. */
   InstancesComponent &dst_component = result.get_component_for_write<InstancesComponent>();
+  dst_component.resize(tot_instances);
+  MutableSpan<InstancedData> dst_instanced_data = dst_component.instanced_data();
+  MutableSpan<float4x4> dst_transforms = dst_component.transforms();
+  MutableSpan<int> dst_ids = dst_component.ids();
+
+  int offset = 0;
   for (const InstancesComponent *component : src_components) {
     const int size = component->instances_amount();
-    Span<InstancedData> instanced_data = component->instanced_data();
-    Span<float4x4> transforms = component->transforms();
-    for (const int i : IndexRange(size)) {
-      dst_component.add_instance(instanced_data[i], transforms[i]);
-    }
+    dst_instanced_data.slice(offset, size).copy_from(component->instanced_data());
+    dst_transforms.slice(offset, size).copy_from(component->transforms());
+    dst_ids.slice(offset, size).copy_from(component->ids());
+    offset += size;
   }
 }
 
@@ -20,6 +20,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_rand.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_mesh_types.h"
@@ -78,6 +79,39 @@ static Span<MLoopTri> get_mesh_looptris(const Mesh &mesh)
   return {looptris, looptris_len};
 }
 
+/**
+ * Decide how many points are added on the looptri, using the first random number of \a rng.
+ */
+static int looptri_point_amount(const Mesh &mesh,
+                                const MLoopTri &looptri,
+                                const float base_density,
+                                const Span<float> density_factors,
+                                RandomNumberGenerator &rng)
+{
+  const int v0_index = mesh.mloop[looptri.tri[0]].v;
+  const int v1_index = mesh.mloop[looptri.tri[1]].v;
+  const int v2_index = mesh.mloop[looptri.tri[2]].v;
+
+  float looptri_density_factor = 1.0f;
+  if (!density_factors.is_empty()) {
+    const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
+    const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
+    const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+    looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+  }
+  const float area = area_tri_v3(
+      mesh.mvert[v0_index].co, mesh.mvert[v1_index].co, mesh.mvert[v2_index].co);
+
+  const float points_amount_fl = area * base_density * looptri_density_factor;
+  const float add_point_probability = fractf(points_amount_fl);
+  const bool add_point = add_point_probability > rng.get_float();
+  return (int)points_amount_fl + (int)add_point;
+}
+
+/**
+ * The points are generated in parallel. Every looptri uses its own random number generator
+ * seeded with its index, so the result does not depend on how the work is split between threads.
+ */
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const FloatReadAttribute *density_factors,
@@ -87,42 +121,56 @@ static void sample_mesh_surface(const Mesh &mesh,
                                 Vector<int> &r_looptri_indices)
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-
-  for (const int looptri_index : looptris.index_range()) {
-    const MLoopTri &looptri = looptris[looptri_index];
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
-    const float3 v0_pos = mesh.mvert[v0_index].co;
-    const float3 v1_pos = mesh.mvert[v1_index].co;
-    const float3 v2_pos = mesh.mvert[v2_index].co;
-
-    float looptri_density_factor = 1.0f;
-    if (density_factors != nullptr) {
-      const float v0_density_factor = std::max(0.0f, (*density_factors)[v0_index]);
-      const float v1_density_factor = std::max(0.0f, (*density_factors)[v1_index]);
-      const float v2_density_factor = std::max(0.0f, (*density_factors)[v2_index]);
-      looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
-    }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int looptri_seed = BLI_hash_int(looptri_index + seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const float points_amount_fl = area * base_density * looptri_density_factor;
-    const float add_point_probability = fractf(points_amount_fl);
-    const bool add_point = add_point_probability > looptri_rng.get_float();
-    const int point_amount = (int)points_amount_fl + (int)add_point;
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+  const Span<float> density_factor_span = (density_factors == nullptr) ?
+                                              Span<float>() :
+                                              density_factors->get_span();
+
+  /* Count the points of every looptri first, to know where to write them in the second pass. */
+  Array<int> looptri_offsets(looptris.size() + 1);
+  parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng(BLI_hash_int(looptri_index + seed));
+      looptri_offsets[looptri_index] = looptri_point_amount(
+          mesh, looptris[looptri_index], base_density, density_factor_span, looptri_rng);
     }
+  });
+  int points_amount = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int looptri_points_amount = looptri_offsets[looptri_index];
+    looptri_offsets[looptri_index] = points_amount;
+    points_amount += looptri_points_amount;
   }
+  looptri_offsets.last() = points_amount;
+
+  const int start_index = r_positions.size();
+  r_positions.resize(start_index + points_amount);
+  r_bary_coords.resize(start_index + points_amount);
+  r_looptri_indices.resize(start_index + points_amount);
+
+  parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = mesh.mvert[mesh.mloop[looptri.tri[0]].v].co;
+      const float3 v1_pos = mesh.mvert[mesh.mloop[looptri.tri[1]].v].co;
+      const float3 v2_pos = mesh.mvert[mesh.mloop[looptri.tri[2]].v].co;
+
+      RandomNumberGenerator looptri_rng(BLI_hash_int(looptri_index + seed));
+      /* Skip the random number used by #looptri_point_amount. */
+      looptri_rng.get_float();
+
+      const IndexRange points_range{looptri_offsets[looptri_index],
+                                    looptri_offsets[looptri_index + 1] -
+                                        looptri_offsets[looptri_index]};
+      for (const int i : points_range) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        float3 point_pos;
+        interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
+        r_positions[start_index + i] = point_pos;
+        r_bary_coords[start_index + i] = bary_coord;
+        r_looptri_indices[start_index + i] = looptri_index;
+      }
+    }
+  });
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
@@ -178,30 +226,34 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     MutableSpan<bool> elimination_mask)
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  const Span<float> density_factor_span = density_factors.get_span();
+  parallel_for(bary_coords.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+      const float v0_density_factor = std::max(0.0f, density_factor_span[v0_index]);
+      const float v1_density_factor = std::max(0.0f, density_factor_span[v1_index]);
+      const float v2_density_factor = std::max(0.0f, density_factor_span[v2_index]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = BLI_hash_int_01(bary_coord.hash());
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = BLI_hash_int_01(bary_coord.hash());
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(Span<bool> elimination_mask,
@@ -228,22 +280,24 @@ BLI_NOINLINE static void interpolate_attribute_point(const Mesh &mesh,
   BLI_assert(data_in.size() == mesh.totvert);
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
 
-  for (const int i : bary_coords.index_range()) {
-    const int looptri_index = looptri_indices[i];
-    const MLoopTri &looptri = looptris[looptri_index];
-    const float3 &bary_coord = bary_coords[i];
+  parallel_for(bary_coords.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int looptri_index = looptri_indices[i];
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &bary_coord = bary_coords[i];
 
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
 
-    const T &v0 = data_in[v0_index];
-    const T &v1 = data_in[v1_index];
-    const T &v2 = data_in[v2_index];
+      const T &v0 = data_in[v0_index];
+      const T &v1 = data_in[v1_index];
+      const T &v2 = data_in[v2_index];
 
-    const T interpolated_value = attribute_math::mix3(bary_coord, v0, v1, v2);
-    data_out[i] = interpolated_value;
-  }
+      const T interpolated_value = attribute_math::mix3(bary_coord, v0, v1, v2);
+      data_out[i] = interpolated_value;
+    }
+  });
 }
 
 template<typename T>
@@ -256,22 +310,24 @@ BLI_NOINLINE static void interpolate_attribute_corner(const Mesh &mesh,
   BLI_assert(data_in.size() == mesh.totloop);
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
 
-  for (const int i : bary_coords.index_range()) {
-    const int looptri_index = looptri_indices[i];
-    const MLoopTri &looptri = looptris[looptri_index];
-    const float3 &bary_coord = bary_coords[i];
+  parallel_for(bary_coords.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int looptri_index = looptri_indices[i];
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &bary_coord = bary_coords[i];
 
-    const int loop_index_0 = looptri.tri[0];
-    const int loop_index_1 = looptri.tri[1];
-    const int loop_index_2 = looptri.tri[2];
+      const int loop_index_0 = looptri.tri[0];
+      const int loop_index_1 = looptri.tri[1];
+      const int loop_index_2 = looptri.tri[2];
 
-    const T &v0 = data_in[loop_index_0];
-    const T &v1 = data_in[loop_index_1];
-    const T &v2 = data_in[loop_index_2];
+      const T &v0 = data_in[loop_index_0];
+      const T &v1 = data_in[loop_index_1];
+      const T &v2 = data_in[loop_index_2];
 
-    const T interpolated_value = attribute_math::mix3(bary_coord, v0, v1, v2);
-    data_out[i] = interpolated_value;
-  }
+      const T interpolated_value = attribute_math::mix3(bary_coord, v0, v1, v2);
+      data_out[i] = interpolated_value;
+    }
+  });
 }
 
 BLI_NOINLINE static void interpolate_attribute(const Mesh &mesh,
@@ -354,22 +410,24 @@ BLI_NOINLINE static void compute_special_attributes(const Mesh &mesh,
   MutableSpan<float3> rotations = rotation_attribute->get_span_for_write_only<float3>();
 
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-  for (const int i : bary_coords.index_range()) {
-    const int looptri_index = looptri_indices[i];
-    const MLoopTri &looptri = looptris[looptri_index];
-    const float3 &bary_coord = bary_coords[i];
-
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
-    const float3 v0_pos = mesh.mvert[v0_index].co;
-    const float3 v1_pos = mesh.mvert[v1_index].co;
-    const float3 v2_pos = mesh.mvert[v2_index].co;
-
-    ids[i] = (int)(bary_coord.hash()) + looptri_index;
-    normal_tri_v3(normals[i], v0_pos, v1_pos, v2_pos);
-    rotations[i] = normal_to_euler_rotation(normals[i]);
-  }
+  parallel_for(bary_coords.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int looptri_index = looptri_indices[i];
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &bary_coord = bary_coords[i];
+
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const float3 v0_pos = mesh.mvert[v0_index].co;
+      const float3 v1_pos = mesh.mvert[v1_index].co;
+      const float3 v2_pos = mesh.mvert[v2_index].co;
+
+      ids[i] = (int)(bary_coord.hash()) + looptri_index;
+      normal_tri_v3(normals[i], v0_pos, v1_pos, v2_pos);
+      rotations[i] = normal_to_euler_rotation(normals[i]);
+    }
+  });
 
   id_attribute.apply_span_and_save();
   normal_attribute.apply_span_and_save();
@@ -461,10 +519,7 @@ static void geo_node_point_distribute_exec(GeoNodeExecParams params)
 
   PointCloud *pointcloud = BKE_pointcloud_new_nomain(tot_points);
   memcpy(pointcloud->co, positions.data(), sizeof(float3) * tot_points);
-  for (const int i : positions.index_range()) {
-    *(float3 *)(pointcloud->co + i) = positions[i];
-    pointcloud->radius[i] = 0.05f;
-  }
+  MutableSpan<float>(pointcloud->radius, tot_points).fill(0.05f);
 
   PointCloudComponent &point_component =
       geometry_set_out.get_component_for_write<PointCloudComponent>();
@@ -23,6 +23,7 @@
 #include "DNA_pointcloud_types.h"
 
 #include "BLI_hash.h"
+#include "BLI_task.hh"
 
 #include "node_geometry_util.hh"
 
@@ -169,13 +170,39 @@ static void add_instances_from_geometry_component(InstancesComponent &instances,
       "scale", domain, {1, 1, 1});
   Int32ReadAttribute ids = src_geometry.attribute_get_for_read<int>("id", domain, -1);
 
+  Vector<int> point_indices;
   for (const int i : IndexRange(domain_size)) {
     if (instances_data[i].has_value()) {
-      float transform[4][4];
-      loc_eul_size_to_mat4(transform, positions[i], rotations[i], scales[i]);
-      instances.add_instance(*instances_data[i], transform, ids[i]);
+      point_indices.append(i);
     }
   }
+  if (point_indices.is_empty()) {
+    return;
+  }
+
+  /* Access the attributes as spans, to avoid a virtual call per element in the loop. */
+  Span<float3> position_span = positions.get_span();
+  Span<float3> rotation_span = rotations.get_span();
+  Span<float3> scale_span = scales.get_span();
+  Span<int> id_span = ids.get_span();
+
+  const int start_index = instances.instances_amount();
+  instances.resize(start_index + point_indices.size());
+  MutableSpan<InstancedData> instanced_data = instances.instanced_data().drop_front(start_index);
+  MutableSpan<float4x4> transforms = instances.transforms().drop_front(start_index);
+  MutableSpan<int> instance_ids = instances.ids().drop_front(start_index);
+
+  parallel_for(point_indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int point_index = point_indices[i];
+      instanced_data[i] = *instances_data[point_index];
+      loc_eul_size_to_mat4(transforms[i].values,
+                           position_span[point_index],
+                           rotation_span[point_index],
+                           scale_span[point_index]);
+      instance_ids[i] = id_span[point_index];
+    }
+  });
 }
 
 static void geo_node_point_instance_exec(GeoNodeExecParams params)
@@ -43,6 +43,18 @@ static void execute_on_component(GeoNodeExecParams params, GeometryComponent &co
   }
 
   Span<float3> data = attribute->get_span<float3>();
+
+  /* Modify the positions in place when possible, this avoids copying them for meshes. */
+  std::optional<bke::StridedSpan<float3>> positions =
+      position_attribute->try_get_strided_span<float3>();
+  if (positions) {
+    for (const int i : positions->index_range()) {
+      (*positions)[i] += data[i];
+    }
+    position_attribute.save();
+    return;
+  }
+
   MutableSpan<float3> scale_span = position_attribute->get_span<float3>();
   for (const int i : scale_span.index_range()) {
     scale_span[i] = scale_span[i] + data[i];
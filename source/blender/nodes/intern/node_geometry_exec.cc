@@ -19,6 +19,17 @@
 
 namespace blender::nodes {
 
+bool GeoNodeExecParams::lazy_require_input(StringRef identifier)
+{
+  BLI_assert(node_.typeinfo->geometry_node_execute_supports_laziness);
+  BLI_assert(lazy_required_inputs_ != nullptr);
+  if (input_values_.contains(identifier)) {
+    return false;
+  }
+  lazy_required_inputs_->append(identifier);
+  return true;
+}
+
 const bNodeSocket *GeoNodeExecParams::find_available_socket(const StringRef name) const
 {
   LISTBASE_FOREACH (const bNodeSocket *, socket, &node_.inputs) {
@@ -425,6 +425,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_drivers",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DRIVERS},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -438,6 +443,12 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_global_flag_doc,
      (void *)G_FLAG_USERPREF_NO_SAVE_ON_EXIT},
 
+    {"use_addons_lazy",
+     bpy_app_global_flag_get,
+     NULL,
+     bpy_app_global_flag_doc,
+     (void *)G_FLAG_SCRIPT_ADDONS_LAZY},
+
     {"binary_path_python",
      bpy_app_binary_path_python_get,
      NULL,
@@ -3575,6 +3575,8 @@ static PyObject *BPy_RemoveProperty(PyObject *self, PyObject *args, PyObject *kw
     return NULL;
   }
 
+  pyrna_struct_prop_cache_clear();
+
   Py_RETURN_NONE;
 }
 
@@ -33,6 +33,7 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_string.h"
@@ -4229,6 +4230,73 @@ static PyObject *pyrna_struct_dir(BPy_StructRNA *self)
 }
 
 /* ---------------getattr-------------------------------------------- */
+/* -------------------------------------------------------------------- */
+/** \name Property Lookup Cache
+ *
+ * Attribute access from Python looks properties up by name for every access, which hashes the
+ * name again in every #StructRNA of the type hierarchy. The results are cached per #StructRNA in
+ * a dictionary keyed by the attribute name, Python interns identifiers so a hit only compares
+ * pointers. Names that aren't RNA properties are cached too (as `None`), so methods and
+ * attributes of Python sub-classes skip the RNA lookup as well.
+ *
+ * The cache is cleared whenever properties are added or removed at run-time,
+ * see #pyrna_struct_prop_cache_clear.
+ * \{ */
+
+/** #StructRNA -> `dict` of attribute names to the #PropertyRNA pointer or `None`. */
+static GHash *pyrna_struct_prop_cache = NULL;
+
+/** Names that are looked up dynamically (with `getattr`) shouldn't grow the cache forever. */
+#define PYRNA_STRUCT_PROP_CACHE_MAX 1024
+
+static void pyrna_struct_prop_cache_free_dict(void *dict)
+{
+  Py_DECREF((PyObject *)dict);
+}
+
+void pyrna_struct_prop_cache_clear(void)
+{
+  if (pyrna_struct_prop_cache) {
+    BLI_ghash_free(pyrna_struct_prop_cache, NULL, pyrna_struct_prop_cache_free_dict);
+    pyrna_struct_prop_cache = NULL;
+  }
+}
+
+static PropertyRNA *pyrna_struct_find_property_cached(PointerRNA *ptr,
+                                                      PyObject *pyname,
+                                                      const char *name)
+{
+  /* ID property paths depend on the data. */
+  if (name[0] == '[') {
+    return RNA_struct_find_property(ptr, name);
+  }
+
+  if (pyrna_struct_prop_cache == NULL) {
+    pyrna_struct_prop_cache = BLI_ghash_ptr_new(__func__);
+  }
+
+  void **dict_p;
+  if (!BLI_ghash_ensure_p(pyrna_struct_prop_cache, ptr->type, &dict_p)) {
+    *dict_p = PyDict_New();
+  }
+  PyObject *dict = *dict_p;
+
+  PyObject *item = PyDict_GetItem(dict, pyname);
+  if (item) {
+    return (item == Py_None) ? NULL : PyLong_AsVoidPtr(item);
+  }
+
+  PropertyRNA *prop = RNA_struct_find_property(ptr, name);
+  if (PyDict_GET_SIZE(dict) < PYRNA_STRUCT_PROP_CACHE_MAX) {
+    item = prop ? PyLong_FromVoidPtr(prop) : Py_INCREF_RET(Py_None);
+    PyDict_SetItem(dict, pyname, item);
+    Py_DECREF(item);
+  }
+  return prop;
+}
+
+/** \} */
+
 static PyObject *pyrna_struct_getattro(BPy_StructRNA *self, PyObject *pyname)
 {
   const char *name = _PyUnicode_AsString(pyname);
@@ -4255,7 +4323,7 @@ static PyObject *pyrna_struct_getattro(BPy_StructRNA *self, PyObject *pyname)
       ret = PyObject_GenericGetAttr((PyObject *)self, pyname);
     }
   }
-  else if ((prop = RNA_struct_find_property(&self->ptr, name))) {
+  else if ((prop = pyrna_struct_find_property_cached(&self->ptr, pyname, name))) {
     ret = pyrna_prop_to_py(&self->ptr, prop);
   }
   /* RNA function only if callback is declared (no optional functions). */
@@ -4452,6 +4520,8 @@ static int pyrna_struct_meta_idprop_setattro(PyObject *cls, PyObject *attr, PyOb
     }
   }
 
+  pyrna_struct_prop_cache_clear();
+
   /* Fallback to standard py, delattr/setattr. */
   return PyType_Type.tp_setattro(cls, attr, value);
 }
@@ -4473,7 +4543,7 @@ static int pyrna_struct_setattro(BPy_StructRNA *self, PyObject *pyname, PyObject
     PyErr_SetString(PyExc_AttributeError, "bpy_struct: __setattr__ must be a string");
     return -1;
   }
-  if (name[0] != '_' && (prop = RNA_struct_find_property(&self->ptr, name))) {
+  if (name[0] != '_' && (prop = pyrna_struct_find_property_cached(&self->ptr, pyname, name))) {
     if (!RNA_property_editable_flag(&self->ptr, prop)) {
       PyErr_Format(PyExc_AttributeError,
                    "bpy_struct: attribute \"%.200s\" from \"%.200s\" is read-only",
@@ -5419,6 +5489,208 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Collection Buffer
+ *
+ * Exposes an attribute of all items of a collection as a buffer that shares the memory of the
+ * items, so the data can be read or written by NumPy without any copy.
+ * \{ */
+
+typedef struct BPy_PropertyCollectionBuffer {
+  PyObject_HEAD
+  /** Keeps the collection alive, the memory belongs to its owner. */
+  BPy_PropertyRNA *collection;
+  /** The first item and its attribute, used to run the update after writing. */
+  PointerRNA itemptr;
+  PropertyRNA *itemprop;
+
+  void *data;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+  int ndim;
+  int itemsize;
+  char format[2];
+  bool writable;
+  /** Number of views that reference the memory. */
+  int exports_num;
+} BPy_PropertyCollectionBuffer;
+
+static PyTypeObject pyrna_prop_collection_buffer_Type = BLANK_PYTHON_TYPE;
+
+static char foreach_buffer_format(RawPropertyType raw_type, bool attr_signed)
+{
+  switch (raw_type) {
+    case PROP_RAW_CHAR:
+      return attr_signed ? 'b' : 'B';
+    case PROP_RAW_SHORT:
+      return attr_signed ? 'h' : 'H';
+    case PROP_RAW_INT:
+      return attr_signed ? 'i' : 'I';
+    case PROP_RAW_BOOLEAN:
+      return '?';
+    case PROP_RAW_FLOAT:
+      return 'f';
+    case PROP_RAW_DOUBLE:
+      return 'd';
+    case PROP_RAW_UNSET:
+      break;
+  }
+  return '\0';
+}
+
+static int pyrna_prop_collection_buffer_getbuffer(BPy_PropertyCollectionBuffer *self,
+                                                  Py_buffer *view,
+                                                  int flags)
+{
+  const bool is_contiguous = (self->strides[0] == self->itemsize * self->shape[1]);
+
+  if ((flags & PyBUF_WRITABLE) && !self->writable) {
+    PyErr_SetString(PyExc_BufferError, "buffer is read-only, use as_buffer(attr, write=True)");
+    return -1;
+  }
+  if (!is_contiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+    PyErr_SetString(PyExc_BufferError, "buffer is not contiguous, strides are required");
+    return -1;
+  }
+
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->buf = self->data;
+  view->len = self->shape[0] * self->shape[1] * self->itemsize;
+  view->readonly = !self->writable;
+  view->itemsize = self->itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? self->format : NULL;
+  view->ndim = self->ndim;
+  view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+
+  self->exports_num++;
+  return 0;
+}
+
+static void pyrna_prop_collection_buffer_releasebuffer(BPy_PropertyCollectionBuffer *self,
+                                                       Py_buffer *UNUSED(view))
+{
+  self->exports_num--;
+
+  /* Tag the owner once all views are released, like a single assignment from Python would.
+   * The items aren't updated one by one, this is what `foreach_set` does too. */
+  if (self->exports_num == 0 && self->writable && self->itemptr.data &&
+      PYRNA_PROP_IS_VALID(self->collection)) {
+    RNA_property_update(BPY_context_get(), &self->itemptr, self->itemprop);
+  }
+}
+
+static PyBufferProcs pyrna_prop_collection_buffer_as_buffer = {
+    (getbufferproc)pyrna_prop_collection_buffer_getbuffer,
+    (releasebufferproc)pyrna_prop_collection_buffer_releasebuffer,
+};
+
+static void pyrna_prop_collection_buffer_dealloc(BPy_PropertyCollectionBuffer *self)
+{
+  Py_DECREF(self->collection);
+  Py_TYPE(self)->tp_free(self);
+}
+
+PyDoc_STRVAR(pyrna_prop_collection_as_buffer_doc,
+             ".. method:: as_buffer(attr, write=False)\n"
+             "\n"
+             "   Access an attribute of all items of the collection without copying it.\n"
+             "\n"
+             "   :arg attr: The name of the attribute, it must be stored directly in the items.\n"
+             "   :type attr: string\n"
+             "   :arg write: Allow writing to the memory. The update of the attribute runs once\n"
+             "      when the memory-view and all buffers created from it are released.\n"
+             "   :type write: bool\n"
+             "   :return: A view shaped ``(len(self), attribute_length)`` that may be strided.\n"
+             "   :rtype: :class:`memoryview`\n"
+             "\n"
+             "   .. warning::\n"
+             "\n"
+             "      The memory-view references the data of the items directly, it must not be\n"
+             "      used after the collection is resized or its owner changes the geometry.\n");
+static PyObject *pyrna_prop_collection_as_buffer(BPy_PropertyRNA *self,
+                                                 PyObject *args,
+                                                 PyObject *kw)
+{
+  const char *attr;
+  bool write = false;
+
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  static const char *_keywords[] = {"", "write", NULL};
+  static _PyArg_Parser _parser = {"s|$O&:as_buffer", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &attr, PyC_ParseBool, &write)) {
+    return NULL;
+  }
+
+  PointerRNA itemptr_base;
+  RNA_pointer_create(NULL, RNA_property_pointer_type(&self->ptr, self->prop), NULL, &itemptr_base);
+  PropertyRNA *itemprop = RNA_struct_find_property(&itemptr_base, attr);
+  if (itemprop == NULL) {
+    PyErr_Format(PyExc_AttributeError,
+                 "as_buffer: '%.200s.%.200s[...]' elements have no attribute '%.200s'",
+                 RNA_struct_identifier(self->ptr.type),
+                 RNA_property_identifier(self->prop),
+                 attr);
+    return NULL;
+  }
+
+  /* Dynamic arrays have no length without an item, they can't be accessed as raw arrays. */
+  const bool is_array = RNA_property_array_check(itemprop);
+  const int attr_len = RNA_property_array_length(&itemptr_base, itemprop);
+
+  RawArray raw;
+  if (!ELEM(RNA_property_type(itemprop), PROP_BOOLEAN, PROP_INT, PROP_FLOAT, PROP_ENUM) ||
+      (is_array && attr_len == 0) ||
+      !RNA_property_collection_raw_array(&self->ptr, self->prop, itemprop, &raw) ||
+      (raw.len != 0 && RNA_raw_type_sizeof(raw.type) == 0)) {
+    PyErr_Format(PyExc_TypeError,
+                 "as_buffer: '%.200s' isn't stored as an array, use foreach_get/foreach_set",
+                 attr);
+    return NULL;
+  }
+
+  BPy_PropertyCollectionBuffer *buffer = PyObject_New(BPy_PropertyCollectionBuffer,
+                                                      &pyrna_prop_collection_buffer_Type);
+  buffer->collection = self;
+  Py_INCREF(self);
+  buffer->itemprop = itemprop;
+  if (raw.len == 0 ||
+      !RNA_property_collection_lookup_int(&self->ptr, self->prop, 0, &buffer->itemptr)) {
+    buffer->itemptr = PointerRNA_NULL;
+  }
+
+  if (raw.len == 0) {
+    /* The array of an empty collection is null, buffers need a valid pointer. */
+    static float empty_data;
+    raw.array = &empty_data;
+    raw.type = RNA_property_raw_type(itemprop);
+    raw.stride = RNA_raw_type_sizeof(raw.type);
+  }
+
+  buffer->data = raw.array;
+  buffer->itemsize = RNA_raw_type_sizeof(raw.type);
+  buffer->ndim = is_array ? 2 : 1;
+  buffer->shape[0] = raw.len;
+  buffer->shape[1] = is_array ? attr_len : 1;
+  buffer->strides[0] = raw.stride;
+  buffer->strides[1] = buffer->itemsize;
+  buffer->format[0] = foreach_buffer_format(raw.type,
+                                            RNA_property_subtype(itemprop) != PROP_UNSIGNED);
+  buffer->format[1] = '\0';
+  buffer->writable = write;
+  buffer->exports_num = 0;
+
+  PyObject *view = PyMemoryView_FromObject((PyObject *)buffer);
+  Py_DECREF(buffer);
+  return view;
+}
+
+/** \} */
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -5756,6 +6028,10 @@ static struct PyMethodDef pyrna_prop_collection_methods[] = {
      (PyCFunction)pyrna_prop_collection_foreach_set,
      METH_VARARGS,
      pyrna_prop_collection_foreach_set_doc},
+    {"as_buffer",
+     (PyCFunction)pyrna_prop_collection_as_buffer,
+     METH_VARARGS | METH_KEYWORDS,
+     pyrna_prop_collection_as_buffer_doc},
 
     {"keys", (PyCFunction)pyrna_prop_collection_keys, METH_NOARGS, pyrna_prop_collection_keys_doc},
     {"items",
@@ -7647,6 +7923,15 @@ void BPY_rna_init(void)
     return;
   }
 #endif
+
+  pyrna_prop_collection_buffer_Type.tp_name = "bpy_prop_collection_buffer";
+  pyrna_prop_collection_buffer_Type.tp_basicsize = sizeof(BPy_PropertyCollectionBuffer);
+  pyrna_prop_collection_buffer_Type.tp_dealloc = (destructor)pyrna_prop_collection_buffer_dealloc;
+  pyrna_prop_collection_buffer_Type.tp_as_buffer = &pyrna_prop_collection_buffer_as_buffer;
+  pyrna_prop_collection_buffer_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+  if (PyType_Ready(&pyrna_prop_collection_buffer_Type) < 0) {
+    return;
+  }
 }
 
 /* 'bpy.data' from Python. */
@@ -8078,6 +8363,8 @@ int pyrna_deferred_register_class(StructRNA *srna, PyTypeObject *py_class)
     return 0;
   }
 
+  pyrna_struct_prop_cache_clear();
+
   return pyrna_deferred_register_class_recursive(srna, py_class);
 }
 
@@ -8719,6 +9006,8 @@ void pyrna_free_types(void)
   PointerRNA ptr;
   PropertyRNA *prop;
 
+  pyrna_struct_prop_cache_clear();
+
   /* Avoid doing this lookup for every getattr. */
   RNA_blender_rna_pointer_create(&ptr);
   prop = RNA_struct_find_property(&ptr, "structs");
@@ -9049,6 +9338,9 @@ static PyObject *pyrna_unregister_class(PyObject *UNUSED(self), PyObject *py_cla
   /* Call unregister. */
   unreg(CTX_data_main(C), srna); /* Calls bpy_class_free, this decref's py_class. */
 
+  /* The freed struct may be reused for another type. */
+  pyrna_struct_prop_cache_clear();
+
   PyDict_DelItem(((PyTypeObject *)py_class)->tp_dict, bpy_intern_str_bl_rna);
   if (PyErr_Occurred()) {
     PyErr_Clear();  // return NULL;
@@ -230,6 +230,7 @@ void pyrna_struct_type_extend_capi(struct StructRNA *srna,
 /* called before stopping python */
 void pyrna_alloc_types(void);
 void pyrna_free_types(void);
+void pyrna_struct_prop_cache_clear(void);
 
 /* primitive type conversion */
 int pyrna_py_to_array(
@@ -87,6 +87,9 @@ bool RE_bake_engine(struct Render *re,
                     const int pass_filter,
                     float result[]);
 
+void RE_bake_engine_batch_begin(struct Render *re);
+void RE_bake_engine_batch_end(struct Render *re);
+
 /* bake.c */
 int RE_pass_depth(const eScenePassType pass_type);
 
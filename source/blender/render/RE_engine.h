@@ -72,6 +72,7 @@ extern "C" {
 #define RE_ENGINE_DO_UPDATE 8
 #define RE_ENGINE_RENDERING 16
 #define RE_ENGINE_HIGHLIGHT_TILES 32
+#define RE_ENGINE_DEPSGRAPH_REUSED 64
 
 extern ListBase R_engines;
 
@@ -239,6 +240,7 @@ void RE_bake_engine_set_engine_parameters(struct Render *re,
                                           struct Main *bmain,
                                           struct Scene *scene);
 
+void RE_engine_free_gpu_depsgraph(struct RenderEngine *engine);
 void RE_engine_free_blender_memory(struct RenderEngine *engine);
 
 #ifdef __cplusplus
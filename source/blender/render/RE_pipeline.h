@@ -143,6 +143,8 @@ typedef struct RenderResult {
 
   /* optional saved endresult on disk */
   int do_exr_tile;
+  /* passes other than combined are allocated when first merged into */
+  int do_lazy_passes;
 
   /* for render results in Image, verify validity for sequences */
   int framenr;
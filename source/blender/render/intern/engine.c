@@ -140,6 +140,21 @@ RenderEngine *RE_engine_create(RenderEngineType *type)
   return engine;
 }
 
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  if (engine->depsgraph && (engine->type->flag & RE_USE_GPU_CONTEXT)) {
+    /* The evaluated data holds GPU resources of the engine, which are freed with it. */
+    DRW_render_context_enable(engine->re);
+    DEG_graph_free(engine->depsgraph);
+    DRW_render_context_disable(engine->re);
+  }
+  else {
+    DEG_graph_free(engine->depsgraph);
+  }
+
+  engine->depsgraph = NULL;
+}
+
 void RE_engine_free(RenderEngine *engine)
 {
 #ifdef WITH_PYTHON
@@ -148,6 +163,9 @@ void RE_engine_free(RenderEngine *engine)
   }
 #endif
 
+  /* Kept with persistent data. */
+  engine_depsgraph_free(engine);
+
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
   MEM_freeN(engine);
@@ -599,11 +617,38 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+/* With persistent data the depsgraph is kept between renders, so that it only needs to be
+ * updated for changes and the engine can keep its own copy of the evaluated data around.
+ * Engines using the GPU context only keep it for the frames of a single render job, since
+ * freeing their data needs that context, see #RE_engine_free_gpu_depsgraph. */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  return (engine->re->r.mode & R_PERSISTENT_DATA) && !(engine->re->r.scemode & R_BUTS_PREVIEW);
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
+  engine->flag &= ~RE_ENGINE_DEPSGRAPH_REUSED;
+
+  if (engine->depsgraph) {
+    Depsgraph *depsgraph = engine->depsgraph;
+    if (DEG_get_bmain(depsgraph) == bmain && DEG_get_input_scene(depsgraph) == scene &&
+        DEG_get_input_view_layer(depsgraph) == view_layer) {
+      /* Kept from the previous render, only evaluate what changed since. The recalc flags are
+       * kept for the engine to sync the changes, and cleared when done rendering. */
+      BKE_scene_graph_update_for_newframe_ex(depsgraph, false);
+      engine->flag |= RE_ENGINE_DEPSGRAPH_REUSED;
+      engine->has_grease_pencil = DRW_render_check_grease_pencil(depsgraph);
+      return;
+    }
+
+    /* Only kept for a single view layer. */
+    engine_depsgraph_free(engine);
+  }
+
   engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
   DEG_debug_name_set(engine->depsgraph, "RENDER");
 
@@ -621,13 +666,6 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
   engine->has_grease_pencil = DRW_render_check_grease_pencil(engine->depsgraph);
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
-{
-  DEG_graph_free(engine->depsgraph);
-
-  engine->depsgraph = NULL;
-}
-
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
 {
   if (!engine->depsgraph) {
@@ -699,8 +737,16 @@ bool RE_bake_engine(Render *re,
   BLI_rw_mutex_unlock(&re->partsmutex);
 
   if (type->bake) {
+    /* Baking uses its own depsgraph, free any kept with persistent data. */
+    engine_depsgraph_free(engine);
     engine->depsgraph = depsgraph;
 
+    engine->flag &= ~RE_ENGINE_DEPSGRAPH_REUSED;
+    if (re->bake_batch && re->bake_batch_depsgraph == depsgraph) {
+      /* Same depsgraph as the previous object, only what changed since needs to be synced. */
+      engine->flag |= RE_ENGINE_DEPSGRAPH_REUSED;
+    }
+
     /* update is only called so we create the engine.session */
     if (type->update) {
       type->update(engine, re->main, engine->depsgraph);
@@ -722,7 +768,14 @@ bool RE_bake_engine(Render *re,
       memset(&engine->bake, 0, sizeof(engine->bake));
     }
 
+    if (re->bake_batch) {
+      /* The engine synced all updates by now. */
+      DEG_ids_clear_recalc(re->main, depsgraph);
+      re->bake_batch_depsgraph = depsgraph;
+    }
+
     engine->depsgraph = NULL;
+    engine->flag &= ~RE_ENGINE_DEPSGRAPH_REUSED;
   }
 
   engine->tile_x = 0;
@@ -732,7 +785,7 @@ bool RE_bake_engine(Render *re,
   BLI_rw_mutex_lock(&re->partsmutex, THREAD_LOCK_WRITE);
 
   /* re->engine becomes zero if user changed active render engine during render */
-  if (!persistent_data || !re->engine) {
+  if (!(persistent_data || re->bake_batch) || !re->engine) {
     RE_engine_free(engine);
     re->engine = NULL;
   }
@@ -747,6 +800,32 @@ bool RE_bake_engine(Render *re,
   return true;
 }
 
+/**
+ * Bake several objects with #RE_bake_engine, all using the same depsgraph. The engine is kept
+ * until #RE_bake_engine_batch_end, so that it only syncs the scene and initializes its device
+ * once, and then only syncs what changed for each following object.
+ */
+void RE_bake_engine_batch_begin(Render *re)
+{
+  re->bake_batch = true;
+  re->bake_batch_depsgraph = NULL;
+}
+
+void RE_bake_engine_batch_end(Render *re)
+{
+  const bool persistent_data = (re->r.mode & R_PERSISTENT_DATA) != 0;
+
+  re->bake_batch = false;
+  re->bake_batch_depsgraph = NULL;
+
+  BLI_rw_mutex_lock(&re->partsmutex, THREAD_LOCK_WRITE);
+  if (re->engine && !persistent_data) {
+    RE_engine_free(re->engine);
+    re->engine = NULL;
+  }
+  BLI_rw_mutex_unlock(&re->partsmutex);
+}
+
 /* Render */
 
 static void engine_render_view_layer(Render *re,
@@ -800,7 +879,13 @@ static void engine_render_view_layer(Render *re,
   }
 
   /* Free dependency graph, if engine has not done it already. */
-  engine_depsgraph_free(engine);
+  if (engine->depsgraph && engine_keep_depsgraph(engine)) {
+    /* The engine synced all updates by now. */
+    DEG_ids_clear_recalc(re->main, engine->depsgraph);
+  }
+  else {
+    engine_depsgraph_free(engine);
+  }
 }
 
 bool RE_engine_render(Render *re, bool do_all)
@@ -836,7 +921,8 @@ bool RE_engine_render(Render *re, bool do_all)
   /* create render result */
   BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
   if (re->result == NULL || !(re->r.scemode & R_BUTS_PREVIEW)) {
-    int savebuffers = RR_USE_MEM;
+    /* Passes that are never rendered to are only allocated once rendering finished. */
+    int savebuffers = RR_USE_MEM_LAZY;
 
     if (re->result) {
       render_result_free(re->result);
@@ -930,6 +1016,10 @@ bool RE_engine_render(Render *re, bool do_all)
 
   render_result_free_list(&engine->fullresult, engine->fullresult.first);
 
+  BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
+  render_result_passes_allocated_ensure(re->result);
+  BLI_rw_mutex_unlock(&re->resultmutex);
+
   BLI_rw_mutex_lock(&re->partsmutex, THREAD_LOCK_WRITE);
 
   /* For save buffers, read back from disk. */
@@ -1017,6 +1107,17 @@ void RE_engine_register_pass(struct RenderEngine *engine,
       engine->update_render_passes_data, scene, view_layer, name, channels, chanid, type);
 }
 
+/**
+ * Free the depsgraph kept with persistent data by engines using the GPU context. Their draw
+ * data lives in the context of the render job, so must be freed before that context is.
+ */
+void RE_engine_free_gpu_depsgraph(RenderEngine *engine)
+{
+  if (engine->type->flag & RE_USE_GPU_CONTEXT) {
+    engine_depsgraph_free(engine);
+  }
+}
+
 void RE_engine_free_blender_memory(RenderEngine *engine)
 {
   /* Weak way to save memory, but not crash grease pencil.
@@ -1026,6 +1127,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (engine->has_grease_pencil) {
     return;
   }
+  /* Needed by the next render with persistent data. */
+  if (engine_keep_depsgraph(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
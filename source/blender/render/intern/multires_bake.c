@@ -345,6 +345,11 @@ static int multiresbake_test_break(MultiresBakeRender *bkr)
 
 /* **** Threading routines **** */
 
+/* Number of consecutive triangles handed out to a thread at once. Neighboring triangles are
+ * likely to touch the same image tiles and grids, and this keeps lock contention low on meshes
+ * with many small triangles. */
+#define MULTIRES_BAKE_QUEUE_CHUNK 32
+
 typedef struct MultiresBakeQueue {
   int cur_tri;
   int tot_tri;
@@ -366,22 +371,24 @@ typedef struct MultiresBakeThread {
   float height_min, height_max;
 } MultiresBakeThread;
 
-static int multires_bake_queue_next_tri(MultiresBakeQueue *queue)
+/**
+ * Get the next range of triangles to bake.
+ * \return false when all triangles were handed out already.
+ */
+static bool multires_bake_queue_next_tris(MultiresBakeQueue *queue, int *r_start, int *r_end)
 {
-  int face = -1;
-
-  /* TODO: it could worth making it so thread will handle neighbor faces
-   *       for better memory cache utilization
-   */
+  bool found = false;
 
   BLI_spin_lock(&queue->spin);
   if (queue->cur_tri < queue->tot_tri) {
-    face = queue->cur_tri;
-    queue->cur_tri++;
+    *r_start = queue->cur_tri;
+    *r_end = min_ii(queue->cur_tri + MULTIRES_BAKE_QUEUE_CHUNK, queue->tot_tri);
+    queue->cur_tri = *r_end;
+    found = true;
   }
   BLI_spin_unlock(&queue->spin);
 
-  return face;
+  return found;
 }
 
 static void *do_multires_bake_thread(void *data_v)
@@ -390,27 +397,36 @@ static void *do_multires_bake_thread(void *data_v)
   MResolvePixelData *data = &handle->data;
   MBakeRast *bake_rast = &handle->bake_rast;
   MultiresBakeRender *bkr = handle->bkr;
-  int tri_index;
+  int tri_start, tri_end;
 
-  while ((tri_index = multires_bake_queue_next_tri(handle->queue)) >= 0) {
-    const MLoopTri *lt = &data->mlooptri[tri_index];
-    const MPoly *mp = &data->mpoly[lt->poly];
-    const short mat_nr = mp->mat_nr;
+  while (multires_bake_queue_next_tris(handle->queue, &tri_start, &tri_end)) {
     const MLoopUV *mloopuv = data->mloopuv;
+    int baked_faces = 0;
 
     if (multiresbake_test_break(bkr)) {
       break;
     }
 
-    Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
-    if (tri_image != handle->image) {
-      continue;
-    }
+    for (int tri_index = tri_start; tri_index < tri_end; tri_index++) {
+      const MLoopTri *lt = &data->mlooptri[tri_index];
+      const MPoly *mp = &data->mpoly[lt->poly];
+      const short mat_nr = mp->mat_nr;
+
+      Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
+      if (tri_image != handle->image) {
+        continue;
+      }
 
-    data->tri_index = tri_index;
+      data->tri_index = tri_index;
 
-    bake_rasterize(
-        bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
+      bake_rasterize(
+          bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
+      baked_faces++;
+    }
+
+    if (baked_faces == 0) {
+      continue;
+    }
 
     /* tag image buffer for refresh */
     if (data->ibuf->rect_float) {
@@ -421,7 +437,7 @@ static void *do_multires_bake_thread(void *data_v)
 
     /* update progress */
     BLI_spin_lock(&handle->queue->spin);
-    bkr->baked_faces++;
+    bkr->baked_faces += baked_faces;
 
     if (bkr->do_update) {
       *bkr->do_update = true;
@@ -47,6 +47,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -158,12 +159,16 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 
 /* ********* alloc and free ******** */
 
+struct RenderWriteImageTask;
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override);
+                                   const char *name_override,
+                                   TaskPool *write_pool,
+                                   struct RenderWriteImageTask **r_write_task);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void *UNUSED(arg), RenderResult *UNUSED(rr))
@@ -1985,7 +1990,7 @@ void RE_RenderFrame(Render *re,
                                      NULL);
 
         /* reports only used for Movie */
-        do_write_image_or_movie(re, bmain, scene, NULL, 0, name);
+        do_write_image_or_movie(re, bmain, scene, NULL, 0, name, NULL, NULL);
       }
     }
 
@@ -2253,12 +2258,92 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Background Image Writing
+ *
+ * Image sequences rendered as animation are written while the next frame renders. Only one
+ * frame is written at a time, the next frame waits for it to be written before being queued.
+ * \{ */
+
+typedef struct RenderWriteImageTask {
+  /* Copy of the scene, settings may be animated and change for the next frame. */
+  Scene scene;
+  RenderResult *rr;
+  char name[FILE_MAX];
+  int cfra;
+  ReportList reports;
+  bool ok;
+} RenderWriteImageTask;
+
+static void render_write_image_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderWriteImageTask *task = taskdata;
+  task->ok = RE_WriteRenderViewsImage(&task->reports, task->rr, &task->scene, true, task->name);
+}
+
+static RenderWriteImageTask *render_write_image_push(TaskPool *pool,
+                                                     RenderResult *rr,
+                                                     Scene *scene,
+                                                     const char *name)
+{
+  RenderWriteImageTask *task = MEM_callocN(sizeof(*task), __func__);
+  task->scene = *scene;
+  task->rr = RE_DuplicateRenderResult(rr);
+  BLI_strncpy(task->name, name, sizeof(task->name));
+  task->cfra = scene->r.cfra;
+  BKE_reports_init(&task->reports, RPT_STORE);
+
+  BLI_task_pool_push(pool, render_write_image_task, task, false, NULL);
+  return task;
+}
+
+/* Wait for the image to be written, then report like a synchronous write would. */
+static bool render_write_image_finish(Render *re,
+                                      TaskPool *pool,
+                                      RenderWriteImageTask *task,
+                                      Scene *scene)
+{
+  BLI_task_pool_work_and_wait(pool);
+
+  if (re->reports) {
+    BLI_movelisttolist(&re->reports->list, &task->reports.list);
+  }
+  else {
+    BKE_reports_print(&task->reports, RPT_ERROR);
+  }
+  BKE_reports_clear(&task->reports);
+
+  const bool ok = task->ok;
+  if (ok) {
+    /* Handlers expect the frame of the written file. */
+    const int cfra = scene->r.cfra;
+    scene->r.cfra = task->cfra;
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+    scene->r.cfra = cfra;
+  }
+  else if ((scene->r.mode & R_TOUCH) && BLI_file_size(task->name) == 0) {
+    /* Remove touched file. */
+    BLI_delete(task->name, false, false);
+  }
+
+  RE_FreeRenderResult(task->rr);
+  MEM_freeN(task);
+
+  return ok;
+}
+
+/** \} */
+
+/* When write_pool is given, images are written in the background and r_write_task is set to the
+ * queued write, movies are always written immediately. */
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override)
+                                   const char *name_override,
+                                   TaskPool *write_pool,
+                                   RenderWriteImageTask **r_write_task)
 {
   char name[FILE_MAX];
   RenderResult rres;
@@ -2287,8 +2372,13 @@ static int do_write_image_or_movie(Render *re,
                                    NULL);
     }
 
-    /* write images as individual images or stereo */
-    ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    if (write_pool) {
+      *r_write_task = render_write_image_push(write_pool, &rres, scene, name);
+    }
+    else {
+      /* write images as individual images or stereo */
+      ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    }
   }
 
   RE_ReleaseResultImageViews(re, &rres);
@@ -2373,6 +2463,8 @@ void RE_RenderAnim(Render *re,
   const bool is_movie = BKE_imtype_is_movie(rd.im_format.imtype);
   const bool is_multiview_name = ((rd.scemode & R_MULTIVIEW) != 0 &&
                                   (rd.im_format.views_format == R_IMF_VIEWS_INDIVIDUAL));
+  TaskPool *write_pool = NULL;
+  RenderWriteImageTask *write_task = NULL;
 
   /* do not fully call for each frame, it initializes & pops output window */
   if (!render_init_from_main(re, &rd, bmain, scene, single_layer, camera_override, 0, 1)) {
@@ -2428,6 +2520,10 @@ void RE_RenderAnim(Render *re,
 
   re->flag |= R_ANIMATION;
 
+  if (!is_movie) {
+    write_pool = BLI_task_pool_create_background_serial(NULL, TASK_PRIORITY_HIGH);
+  }
+
   {
     for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
       char name[FILE_MAX];
@@ -2544,9 +2640,17 @@ void RE_RenderAnim(Render *re,
       do_render_all_options(re);
       totrendered++;
 
+      if (write_task) {
+        if (!render_write_image_finish(re, write_pool, write_task, scene)) {
+          G.is_break = true;
+        }
+        write_task = NULL;
+      }
+
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          if (!do_write_image_or_movie(
+                  re, bmain, scene, mh, totvideos, NULL, write_pool, &write_task)) {
             G.is_break = true;
           }
         }
@@ -2591,11 +2695,22 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        if (write_pool == NULL) {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (write_task) {
+    if (!render_write_image_finish(re, write_pool, write_task, scene)) {
+      G.is_break = true;
+    }
+  }
+  if (write_pool) {
+    BLI_task_pool_free(write_pool);
+  }
+
   /* end movie */
   if (is_movie) {
     re_movie_free_all(re, mh, totvideos);
@@ -2642,6 +2757,12 @@ void RE_PreviewRender(Render *re, Main *bmain, Scene *sce)
 
 void RE_CleanAfterRender(Render *re)
 {
+  /* The depsgraph kept between frames by engines using the GPU context holds data from the
+   * context destroyed below. */
+  if (re->engine) {
+    RE_engine_free_gpu_depsgraph(re->engine);
+  }
+
   /* Destroy the opengl context in the correct thread. */
   RE_gl_context_destroy(re);
   if (re->pipeline_depsgraph != NULL) {
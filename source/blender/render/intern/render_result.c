@@ -28,6 +28,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_ghash.h"
 #include "BLI_hash_md5.h"
 #include "BLI_listbase.h"
@@ -213,6 +215,58 @@ static void set_pass_full_name(
 
 /********************************** New **************************************/
 
+/* Allocate the buffer of a pass, initialized to the value of pixels that were not rendered. */
+static float *render_pass_rect_alloc(const RenderPass *rpass)
+{
+  const size_t rectsize = ((size_t)rpass->rectx) * rpass->recty * rpass->channels;
+  float *rect = MEM_callocN(sizeof(float) * rectsize, rpass->name);
+  if (rect == NULL) {
+    return NULL;
+  }
+
+  if (STREQ(rpass->name, RE_PASSNAME_VECTOR)) {
+    /* initialize to max speed */
+    for (size_t x = 0; x < rectsize; x++) {
+      rect[x] = PASS_VECTOR_MAX;
+    }
+  }
+  else if (STREQ(rpass->name, RE_PASSNAME_Z)) {
+    for (size_t x = 0; x < rectsize; x++) {
+      rect[x] = 10e10;
+    }
+  }
+
+  return rect;
+}
+
+/* Allocate the buffer of a lazily allocated pass, tiles can be merged from multiple threads. */
+static float *render_pass_rect_ensure(RenderPass *rpass)
+{
+  if (rpass->rect == NULL) {
+    float *rect = render_pass_rect_alloc(rpass);
+    if (rect != NULL && atomic_cas_ptr((void **)&rpass->rect, NULL, rect) != NULL) {
+      /* Allocated by another thread in the meantime. */
+      MEM_freeN(rect);
+    }
+  }
+  return rpass->rect;
+}
+
+/* Allocate the passes of a render result created with RR_USE_MEM_LAZY that were never merged
+ * into, so that the result can be used like any other in-memory result afterwards. */
+void render_result_passes_allocated_ensure(RenderResult *rr)
+{
+  if (!rr->do_lazy_passes) {
+    return;
+  }
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      render_pass_rect_ensure(rpass);
+    }
+  }
+  rr->do_lazy_passes = false;
+}
+
 RenderPass *render_layer_add_pass(RenderResult *rr,
                                   RenderLayer *rl,
                                   int channels,
@@ -222,7 +276,6 @@ RenderPass *render_layer_add_pass(RenderResult *rr,
 {
   const int view_id = BLI_findstringindex(&rr->views, viewname, offsetof(RenderView, name));
   RenderPass *rpass = MEM_callocN(sizeof(RenderPass), name);
-  size_t rectsize = ((size_t)rr->rectx) * rr->recty * channels;
 
   rpass->channels = channels;
   rpass->rectx = rl->rectx;
@@ -250,30 +303,15 @@ RenderPass *render_layer_add_pass(RenderResult *rr,
   }
 
   /* Always allocate combined for display, in case of save buffers
-   * other passes are not allocated and only saved to the EXR file. */
-  if (rl->exrhandle == NULL || STREQ(rpass->name, RE_PASSNAME_COMBINED)) {
-    float *rect;
-    int x;
-
-    rpass->rect = MEM_callocN(sizeof(float) * rectsize, name);
+   * other passes are not allocated and only saved to the EXR file.
+   * For lazy passes they are allocated when first merged into. */
+  if ((rl->exrhandle == NULL && !rr->do_lazy_passes) ||
+      STREQ(rpass->name, RE_PASSNAME_COMBINED)) {
+    rpass->rect = render_pass_rect_alloc(rpass);
     if (rpass->rect == NULL) {
       MEM_freeN(rpass);
       return NULL;
     }
-
-    if (STREQ(rpass->name, RE_PASSNAME_VECTOR)) {
-      /* initialize to max speed */
-      rect = rpass->rect;
-      for (x = rectsize - 1; x >= 0; x--) {
-        rect[x] = PASS_VECTOR_MAX;
-      }
-    }
-    else if (STREQ(rpass->name, RE_PASSNAME_Z)) {
-      rect = rpass->rect;
-      for (x = rectsize - 1; x >= 0; x--) {
-        rect[x] = 10e10;
-      }
-    }
   }
 
   BLI_addtail(&rl->passes, rpass);
@@ -312,9 +350,12 @@ RenderResult *render_result_new(
   rr->tilerect.ymin = partrct->ymin - re->disprect.ymin;
   rr->tilerect.ymax = partrct->ymax - re->disprect.ymin;
 
-  if (savebuffers) {
+  if (savebuffers == RR_USE_EXR) {
     rr->do_exr_tile = true;
   }
+  else if (savebuffers == RR_USE_MEM_LAZY) {
+    rr->do_lazy_passes = true;
+  }
 
   render_result_views_new(rr, &re->r);
 
@@ -849,6 +890,11 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
       /* Passes are allocated in sync. */
       for (rpass = rl->passes.first, rpassp = rlp->passes.first; rpass && rpassp;
            rpass = rpass->next) {
+        /* Allocate lazy passes when they are first rendered to. */
+        if (rr->do_lazy_passes && rpass->rect == NULL && rpassp->rect != NULL &&
+            STREQ(rpassp->fullname, rpass->fullname)) {
+          render_pass_rect_ensure(rpass);
+        }
         /* For save buffers, skip any passes that are only saved to disk. */
         if (rpass->rect == NULL || rpassp->rect == NULL) {
           continue;
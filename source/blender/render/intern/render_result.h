@@ -27,6 +27,8 @@
 
 #define RR_USE_MEM 0
 #define RR_USE_EXR 1
+/* Like RR_USE_MEM, but only allocate passes when results are merged into them. */
+#define RR_USE_MEM_LAZY 2
 
 #define RR_ALL_LAYERS NULL
 #define RR_ALL_VIEWS NULL
@@ -55,6 +57,8 @@ struct RenderResult *render_result_new(struct Render *re,
                                        const char *layername,
                                        const char *viewname);
 
+void render_result_passes_allocated_ensure(struct RenderResult *rr);
+
 struct RenderResult *render_result_new_from_exr(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
 
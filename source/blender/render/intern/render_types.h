@@ -121,6 +121,11 @@ struct Render {
   /* render engine */
   struct RenderEngine *engine;
 
+  /* Baking several objects with the same depsgraph, see #RE_bake_engine_batch_begin. */
+  bool bake_batch;
+  /* Depsgraph of the previous object baked in the batch. */
+  Depsgraph *bake_batch_depsgraph;
+
   /* NOTE: This is a minimal dependency graph and evaluated scene which is enough to access view
    * layer visibility and use for post-precessing (compositor and sequencer). */
   Depsgraph *pipeline_depsgraph;
@@ -26,6 +26,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h" /* for FILE_MAX. */
@@ -42,10 +44,12 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_global.h"
 #include "BKE_main.h"
+#include "BKE_mask.h"
 #include "BKE_scene.h"
 
 #include "SEQ_prefetch.h"
@@ -57,6 +61,8 @@
 #include "prefetch.h"
 #include "strip_time.h"
 
+#include "zlib.h"
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -79,6 +85,11 @@
  * Once again, this is to reduce number of iterations, but also more controllable than removing
  * entries one by one in reverse order to their creation.
  *
+ * Before frames are freed, the #SEQ_CACHE_STORE_FINAL_OUT image of frames chosen for recycling
+ * is compressed in RAM instead, while the other images of the frame are freed. Compressed frames
+ * are only freed once there are no uncompressed frames left to recycle. The image is decompressed
+ * when it is requested again.
+ *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
  *
  *
@@ -90,7 +101,9 @@
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
  * Zlib compression with user definable level can be used to compress image data(per image)
- * Images are written in order in which they are rendered.
+ * Images are written in order in which they are rendered, by a background thread so rendering
+ * doesn't wait for compression. Writes are queued up to DCACHE_WRITE_QUEUE_MAX images, past that
+ * the rendering thread writes the image itself.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
@@ -103,6 +116,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 1
+#define DCACHE_WRITE_QUEUE_MAX 8
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
 typedef struct DiskCacheHeaderEntry {
@@ -124,6 +138,9 @@ typedef struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /* Writes images in the background, see #seq_disk_cache_write_file_async. */
+  TaskPool *write_pool;
+  int32_t write_queue_len;
 } SeqDiskCache;
 
 typedef struct DiskCacheFile {
@@ -150,9 +167,18 @@ typedef struct SeqCache {
   SeqDiskCache *disk_cache;
 } SeqCache;
 
+typedef struct SeqCacheCompressedChunk {
+  void *data;
+  size_t size;
+} SeqCacheCompressedChunk;
+
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Pixels of ibuf when they are compressed, see #seq_cache_item_compress. */
+  SeqCacheCompressedChunk *chunks;
+  int chunks_num;
+  bool is_float;
 } SeqCacheItem;
 
 typedef struct SeqCacheKey {
@@ -319,6 +345,12 @@ static bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
   return true;
 }
 
+/* Finish queued writes, so they don't recreate files that are about to be deleted. */
+static void seq_disk_cache_write_wait(SeqDiskCache *disk_cache)
+{
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+}
+
 static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache, char *path)
 {
   DiskCacheFile *cache_file = disk_cache->files.first;
@@ -478,6 +510,7 @@ static void seq_disk_cache_invalidate(Scene *scene,
   int end;
   SeqDiskCache *disk_cache = scene->ed->cache->disk_cache;
 
+  seq_disk_cache_write_wait(disk_cache);
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = seq_changed->startdisp - DCACHE_IMAGES_PER_FILE;
@@ -603,11 +636,11 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
   return -1;
 }
 
-static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache,
+                                      SeqCacheKey *key,
+                                      char *path,
+                                      ImBuf *ibuf)
 {
-  char path[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
   BLI_make_existing_file(path);
 
   FILE *file = BLI_fopen(path, "rb+");
@@ -646,9 +679,62 @@ static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key
     return true;
   }
 
+  fclose(file);
   return false;
 }
 
+typedef struct DiskCacheWriteTask {
+  /* Copy of the cache key, the strip it points to may be freed before the task runs, so only
+   * the fields used by #seq_disk_cache_add_header_entry are valid. */
+  SeqCacheKey key;
+  char path[FILE_MAX];
+  ImBuf *ibuf;
+} DiskCacheWriteTask;
+
+static void seq_disk_cache_write_file_locked(SeqDiskCache *disk_cache,
+                                             SeqCacheKey *key,
+                                             char *path,
+                                             ImBuf *ibuf)
+{
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  seq_disk_cache_write_file(disk_cache, key, path, ibuf);
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+  seq_disk_cache_enforce_limits(disk_cache);
+}
+
+static void seq_disk_cache_write_task(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = BLI_task_pool_user_data(pool);
+  DiskCacheWriteTask *task = taskdata;
+
+  seq_disk_cache_write_file_locked(disk_cache, &task->key, task->path, task->ibuf);
+  IMB_freeImBuf(task->ibuf);
+  atomic_sub_and_fetch_int32(&disk_cache->write_queue_len, 1);
+}
+
+/* Write image to disk cache without waiting for it to be compressed. The image must not be
+ * modified afterwards, which is the case for all images stored in cache. */
+static void seq_disk_cache_write_file_async(SeqDiskCache *disk_cache,
+                                            SeqCacheKey *key,
+                                            ImBuf *ibuf)
+{
+  DiskCacheWriteTask *task = MEM_mallocN(sizeof(*task), __func__);
+  task->key = *key;
+  seq_disk_cache_get_file_path(disk_cache, key, task->path, sizeof(task->path));
+
+  if (atomic_add_and_fetch_int32(&disk_cache->write_queue_len, 1) > DCACHE_WRITE_QUEUE_MAX) {
+    /* Writing is slower than rendering, don't queue more images than that. */
+    atomic_sub_and_fetch_int32(&disk_cache->write_queue_len, 1);
+    seq_disk_cache_write_file_locked(disk_cache, key, task->path, ibuf);
+    MEM_freeN(task);
+    return;
+  }
+
+  IMB_refImBuf(ibuf);
+  task->ibuf = ibuf;
+  BLI_task_pool_push(disk_cache->write_pool, seq_disk_cache_write_task, task, true, NULL);
+}
+
 static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   char path[FILE_MAX];
@@ -713,6 +799,7 @@ static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *ke
 #undef DCACHE_IMAGES_PER_FILE
 #undef COLORSPACE_NAME_MAX
 #undef DCACHE_CURRENT_VERSION
+#undef DCACHE_WRITE_QUEUE_MAX
 
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
 {
@@ -764,6 +851,10 @@ static float seq_cache_timeline_frame_to_frame_index(Sequence *seq, float timeli
    * images or extended frame range of movies will only generate one cache entry. No special
    * treatment in converting frame index to timeline_frame is needed. */
   if (type == SEQ_CACHE_STORE_RAW) {
+    /* Masks without animation rasterize the same for every frame, share one entry too. */
+    if (seq->type == SEQ_TYPE_MASK && seq->mask != NULL && !BKE_mask_is_animated(seq->mask)) {
+      return 0.0f;
+    }
     return seq_give_frame_index(seq, timeline_frame);
   }
 
@@ -813,6 +904,196 @@ static void seq_cache_keyfree(void *val)
   BLI_mempool_free(key->cache_owner->keys_pool, key);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compressed Items
+ *
+ * Images are split in chunks that are compressed in parallel. Each pixel is XOR-ed with the
+ * previous one, which clears the high bytes of each component in smooth areas, the bytes are
+ * grouped by their position in the 32 bit words and the result is compressed with zlib at its
+ * fastest level. This is lossless.
+ * \{ */
+
+#define SEQ_CACHE_COMPRESS_CHUNK_SIZE (1 << 20)
+
+typedef struct SeqCacheCompressData {
+  uint32_t *words;
+  size_t raw_size;
+  /* Number of words per pixel. */
+  int stride;
+  SeqCacheCompressedChunk *chunks;
+  bool failed;
+} SeqCacheCompressData;
+
+static void seq_cache_compress_chunk(void *__restrict userdata,
+                                     const int chunk_index,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqCacheCompressData *data = userdata;
+  SeqCacheCompressedChunk *chunk = &data->chunks[chunk_index];
+  const size_t offset = (size_t)chunk_index * SEQ_CACHE_COMPRESS_CHUNK_SIZE;
+  const size_t raw_size = MIN2(data->raw_size - offset, SEQ_CACHE_COMPRESS_CHUNK_SIZE);
+  const size_t words_num = raw_size / sizeof(uint32_t);
+  const uint32_t *words = data->words + offset / sizeof(uint32_t);
+  const size_t stride = (size_t)data->stride;
+
+  uchar *encoded = MEM_mallocN(raw_size, __func__);
+  for (size_t i = 0; i < words_num; i++) {
+    const uint32_t word = (i >= stride) ? words[i] ^ words[i - stride] : words[i];
+    for (int b = 0; b < 4; b++) {
+      encoded[b * words_num + i] = (uchar)(word >> (b * 8));
+    }
+  }
+
+  uLongf size = compressBound((uLong)raw_size);
+  Bytef *compressed = MEM_mallocN(size, __func__);
+  const int result = compress2(compressed, &size, encoded, (uLong)raw_size, Z_BEST_SPEED);
+  MEM_freeN(encoded);
+
+  if (result != Z_OK) {
+    MEM_freeN(compressed);
+    chunk->data = NULL;
+    chunk->size = 0;
+    data->failed = true;
+    return;
+  }
+
+  chunk->data = MEM_reallocN(compressed, size);
+  chunk->size = size;
+}
+
+static void seq_cache_decompress_chunk(void *__restrict userdata,
+                                       const int chunk_index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqCacheCompressData *data = userdata;
+  SeqCacheCompressedChunk *chunk = &data->chunks[chunk_index];
+  const size_t offset = (size_t)chunk_index * SEQ_CACHE_COMPRESS_CHUNK_SIZE;
+  const size_t raw_size = MIN2(data->raw_size - offset, SEQ_CACHE_COMPRESS_CHUNK_SIZE);
+  const size_t words_num = raw_size / sizeof(uint32_t);
+  uint32_t *words = data->words + offset / sizeof(uint32_t);
+  const size_t stride = (size_t)data->stride;
+
+  uchar *encoded = MEM_mallocN(raw_size, __func__);
+  uLongf size = (uLongf)raw_size;
+  const int result = uncompress(encoded, &size, chunk->data, (uLong)chunk->size);
+  BLI_assert(result == Z_OK && size == raw_size);
+  UNUSED_VARS_NDEBUG(result);
+
+  for (size_t i = 0; i < words_num; i++) {
+    uint32_t word = 0;
+    for (int b = 0; b < 4; b++) {
+      word |= (uint32_t)encoded[b * words_num + i] << (b * 8);
+    }
+    words[i] = (i >= stride) ? word ^ words[i - stride] : word;
+  }
+  MEM_freeN(encoded);
+}
+
+static void seq_cache_item_free_chunks(SeqCacheItem *item)
+{
+  for (int i = 0; i < item->chunks_num; i++) {
+    MEM_SAFE_FREE(item->chunks[i].data);
+  }
+  MEM_SAFE_FREE(item->chunks);
+  item->chunks_num = 0;
+}
+
+static size_t seq_cache_item_raw_size(const SeqCacheItem *item)
+{
+  const size_t pixels_num = (size_t)item->ibuf->x * item->ibuf->y;
+  return item->is_float ? pixels_num * 4 * sizeof(float) : pixels_num * 4;
+}
+
+/* Replace pixels of the item image with a compressed copy. Returns false when the image is used
+ * outside of the cache, or when it doesn't compress. */
+static bool seq_cache_item_compress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+
+  if (ibuf == NULL || item->chunks != NULL || ibuf->refcounter != 0 || ibuf->zbuf != NULL ||
+      ibuf->zbuf_float != NULL) {
+    return false;
+  }
+
+  if (ibuf->rect != NULL && ibuf->rect_float == NULL && (ibuf->mall & IB_rect)) {
+    item->is_float = false;
+  }
+  else if (ibuf->rect_float != NULL && ibuf->rect == NULL && (ibuf->mall & IB_rectfloat) &&
+           ibuf->channels == 4) {
+    item->is_float = true;
+  }
+  else {
+    return false;
+  }
+
+  SeqCacheCompressData data = {
+      .words = item->is_float ? (uint32_t *)ibuf->rect_float : ibuf->rect,
+      .raw_size = seq_cache_item_raw_size(item),
+      .stride = item->is_float ? 4 : 1,
+      .failed = false,
+  };
+  const int chunks_num = (int)((data.raw_size + SEQ_CACHE_COMPRESS_CHUNK_SIZE - 1) /
+                               SEQ_CACHE_COMPRESS_CHUNK_SIZE);
+  if (chunks_num == 0) {
+    return false;
+  }
+  data.chunks = MEM_calloc_arrayN(chunks_num, sizeof(*data.chunks), __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, chunks_num, &data, seq_cache_compress_chunk, &settings);
+
+  item->chunks = data.chunks;
+  item->chunks_num = chunks_num;
+
+  size_t compressed_size = 0;
+  for (int i = 0; i < chunks_num; i++) {
+    compressed_size += data.chunks[i].size;
+  }
+
+  if (data.failed || compressed_size >= data.raw_size) {
+    seq_cache_item_free_chunks(item);
+    return false;
+  }
+
+  if (item->is_float) {
+    imb_freerectfloatImBuf(ibuf);
+  }
+  else {
+    imb_freerectImBuf(ibuf);
+  }
+
+  return true;
+}
+
+static void seq_cache_item_decompress(SeqCacheItem *item)
+{
+  ImBuf *ibuf = item->ibuf;
+
+  if (item->is_float ? !imb_addrectfloatImBuf(ibuf) : !imb_addrectImBuf(ibuf)) {
+    return;
+  }
+
+  SeqCacheCompressData data = {
+      .words = item->is_float ? (uint32_t *)ibuf->rect_float : ibuf->rect,
+      .raw_size = seq_cache_item_raw_size(item),
+      .stride = item->is_float ? 4 : 1,
+      .chunks = item->chunks,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, item->chunks_num, &data, seq_cache_decompress_chunk, &settings);
+
+  seq_cache_item_free_chunks(item);
+}
+
+#undef SEQ_CACHE_COMPRESS_CHUNK_SIZE
+
+/** \} */
+
 static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
@@ -820,6 +1101,7 @@ static void seq_cache_valfree(void *val)
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
+  seq_cache_item_free_chunks(item);
 
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
@@ -847,6 +1129,9 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->chunks = NULL;
+  item->chunks_num = 0;
+  item->is_float = false;
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -885,6 +1170,13 @@ static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
   if (item && item->ibuf) {
+    if (item->chunks != NULL) {
+      seq_cache_item_decompress(item);
+    }
+    if (item->chunks != NULL) {
+      /* Not enough memory to decompress. */
+      return NULL;
+    }
     IMB_refImBuf(item->ibuf);
 
     return item->ibuf;
@@ -989,7 +1281,32 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   }
 }
 
-static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
+/* Keep the final image of the frame compressed, and free its sources. */
+static bool seq_cache_compress_linked(Scene *scene, SeqCacheKey *base)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache || base->type != SEQ_CACHE_STORE_FINAL_OUT) {
+    return false;
+  }
+
+  SeqCacheItem *item = BLI_ghash_lookup(cache->hash, base);
+  if (!seq_cache_item_compress(item)) {
+    return false;
+  }
+
+  SeqCacheKey *prev = base->link_prev;
+  base->link_prev = NULL;
+  while (prev) {
+    SeqCacheKey *prev_prev = prev->link_prev;
+    BLI_ghash_remove(cache->hash, prev, seq_cache_keyfree, seq_cache_valfree);
+    prev = prev_prev;
+  }
+
+  return true;
+}
+
+/* Choose a frame to recycle among the compressed or uncompressed ones. */
+static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene, const bool compressed)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = NULL;
@@ -1016,7 +1333,7 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
-    if (key->is_temp_cache || key->link_next != NULL) {
+    if (key->is_temp_cache || key->link_next != NULL || (item->chunks != NULL) != compressed) {
       continue;
     }
 
@@ -1058,7 +1375,16 @@ bool seq_cache_recycle_item(Scene *scene)
   seq_cache_lock(scene);
 
   while (seq_cache_is_full()) {
-    SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
+    SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene, false);
+
+    if (finalkey) {
+      if (!seq_cache_compress_linked(scene, finalkey)) {
+        seq_cache_recycle_linked(scene, finalkey);
+      }
+      continue;
+    }
+
+    finalkey = seq_cache_get_item_for_removal(scene, true);
 
     if (finalkey) {
       seq_cache_recycle_linked(scene, finalkey);
@@ -1112,6 +1438,8 @@ static void seq_disk_cache_create(Main *bmain, Scene *scene)
   cache->disk_cache = MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache");
   cache->disk_cache->bmain = bmain;
   BLI_mutex_init(&cache->disk_cache->read_write_mutex);
+  cache->disk_cache->write_pool = BLI_task_pool_create_background_serial(cache->disk_cache,
+                                                                         TASK_PRIORITY_LOW);
   seq_disk_cache_handle_versioning(cache->disk_cache);
   seq_disk_cache_get_files(cache->disk_cache, seq_disk_cache_base_dir());
   cache->disk_cache->timestamp = scene->ed->disk_cache_timestamp;
@@ -1210,6 +1538,8 @@ void seq_cache_destruct(Scene *scene)
   BLI_mutex_end(&cache->iterator_mutex);
 
   if (cache->disk_cache != NULL) {
+    seq_disk_cache_write_wait(cache->disk_cache);
+    BLI_task_pool_free(cache->disk_cache->write_pool);
     BLI_freelistN(&cache->disk_cache->files);
     BLI_mutex_end(&cache->disk_cache->read_write_mutex);
     MEM_freeN(cache->disk_cache);
@@ -1442,10 +1772,7 @@ void seq_cache_put(
         seq_disk_cache_create(context->bmain, context->scene);
       }
 
-      BLI_mutex_lock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_write_file(cache->disk_cache, key, i);
-      BLI_mutex_unlock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
+      seq_disk_cache_write_file_async(cache->disk_cache, key, i);
     }
   }
 }
@@ -538,6 +538,15 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
   }
 }
 
+/**
+ * Movie proxies are built from their own index context, so rebuilding them can run in parallel
+ * with other contexts. Image proxies go through the sequencer render pipeline.
+ */
+bool SEQ_proxy_rebuild_is_threadsafe(const SeqIndexBuildContext *context)
+{
+  return context->seq->type == SEQ_TYPE_MOVIE;
+}
+
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->index_context) {
@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -492,6 +493,7 @@ typedef struct ImageTransformThreadInitData {
   float image_scale_factor;
   float preview_scale_factor;
   bool for_render;
+  bool flip_x, flip_y;
 } ImageTransformThreadInitData;
 
 typedef struct ImageTransformThreadData {
@@ -504,6 +506,8 @@ typedef struct ImageTransformThreadData {
   /* Preview scale factor is needed to correct translation to match preview size. */
   float preview_scale_factor;
   bool for_render;
+  /* Flip the output, avoids separate passes over the image. */
+  bool flip_x, flip_y;
   int start_line;
   int tot_line;
 } ImageTransformThreadData;
@@ -522,6 +526,8 @@ static void sequencer_image_transform_init(void *handle_v,
   handle->image_scale_factor = init_data->image_scale_factor;
   handle->preview_scale_factor = init_data->preview_scale_factor;
   handle->for_render = init_data->for_render;
+  handle->flip_x = init_data->flip_x;
+  handle->flip_y = init_data->flip_y;
 
   handle->start_line = start_line;
   handle->tot_line = tot_line;
@@ -547,11 +553,19 @@ static void *sequencer_image_transform_do_thread(void *data_v)
   transform_pivot_set_m3(transform_matrix, pivot);
 
   const int width = data->ibuf_out->x;
+  const int height = data->ibuf_out->y;
+  /* The source position changes by the first column of the matrix for every pixel. */
+  float uv_step[2];
+  copy_v2_v2(uv_step, transform_matrix[0]);
+  if (data->flip_x) {
+    negate_v2(uv_step);
+  }
+
   for (int yi = data->start_line; yi < data->start_line + data->tot_line; yi++) {
-    for (int xi = 0; xi < width; xi++) {
-      float uv[2] = {xi, yi};
-      mul_v2_m3v2(uv, transform_matrix, uv);
+    float uv[2] = {data->flip_x ? width - 1 : 0, data->flip_y ? height - 1 - yi : yi};
+    mul_v2_m3v2(uv, transform_matrix, uv);
 
+    for (int xi = 0; xi < width; xi++, add_v2_v2(uv, uv_step)) {
       if (data->for_render) {
         bilinear_interpolation(data->ibuf_source, data->ibuf_out, uv[0], uv[1], xi, yi);
       }
@@ -564,19 +578,29 @@ static void *sequencer_image_transform_do_thread(void *data_v)
   return NULL;
 }
 
-static void multibuf(ImBuf *ibuf, const float fmul)
+typedef struct MultibufThreadData {
+  ImBuf *ibuf;
+  float fmul;
+} MultibufThreadData;
+
+static void multibuf_thread_do(void *data_v, int start_scanline, int num_scanlines)
 {
+  const MultibufThreadData *data = (MultibufThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+  const float fmul = data->fmul;
+  const size_t offset = (size_t)start_scanline * ibuf->x * 4;
   char *rt;
   float *rt_float;
 
-  int a;
+  size_t a;
 
   rt = (char *)ibuf->rect;
   rt_float = ibuf->rect_float;
 
   if (rt) {
     const int imul = (int)(256.0f * fmul);
-    a = ibuf->x * ibuf->y;
+    rt += offset;
+    a = (size_t)num_scanlines * ibuf->x;
     while (a--) {
       rt[0] = min_ii((imul * rt[0]) >> 8, 255);
       rt[1] = min_ii((imul * rt[1]) >> 8, 255);
@@ -587,7 +611,8 @@ static void multibuf(ImBuf *ibuf, const float fmul)
     }
   }
   if (rt_float) {
-    a = ibuf->x * ibuf->y;
+    rt_float += offset;
+    a = (size_t)num_scanlines * ibuf->x;
     while (a--) {
       rt_float[0] *= fmul;
       rt_float[1] *= fmul;
@@ -599,6 +624,15 @@ static void multibuf(ImBuf *ibuf, const float fmul)
   }
 }
 
+static void multibuf(ImBuf *ibuf, const float fmul)
+{
+  MultibufThreadData data = {
+      .ibuf = ibuf,
+      .fmul = fmul,
+  };
+  IMB_processor_apply_threaded_scanlines(ibuf->y, multibuf_thread_do, &data);
+}
+
 /* Effect, mask and scene in strip input strips are rendered in preview resolution. They are
  * already downscaled. input_preprocess() does not expect this to happen. Other strip types are
  * rendered with original media resolution, unless proxies are enabled for them. With proxies
@@ -623,6 +657,8 @@ static ImBuf *input_preprocess(const SeqRenderData *context,
 {
   Scene *scene = context->scene;
   ImBuf *preprocessed_ibuf = NULL;
+  /* Flips are done by the transform when there is one. */
+  bool flipped = false;
 
   /* Deinterlace. */
   if ((seq->flag & SEQ_FILTERY) && !ELEM(seq->type, SEQ_TYPE_MOVIE, SEQ_TYPE_MOVIECLIP)) {
@@ -689,6 +725,9 @@ static ImBuf *input_preprocess(const SeqRenderData *context,
     }
     init_data.preview_scale_factor = preview_scale_factor;
     init_data.for_render = context->for_render;
+    init_data.flip_x = (seq->flag & SEQ_FLIPX) != 0;
+    init_data.flip_y = (seq->flag & SEQ_FLIPY) != 0;
+    flipped = true;
     IMB_processor_apply_threaded(context->recty,
                                  sizeof(ImageTransformThreadData),
                                  &init_data,
@@ -704,11 +743,11 @@ static ImBuf *input_preprocess(const SeqRenderData *context,
     preprocessed_ibuf = IMB_makeSingleUser(ibuf);
   }
 
-  if (seq->flag & SEQ_FLIPX) {
+  if (!flipped && (seq->flag & SEQ_FLIPX)) {
     IMB_flipx(preprocessed_ibuf);
   }
 
-  if (seq->flag & SEQ_FLIPY) {
+  if (!flipped && (seq->flag & SEQ_FLIPY)) {
     IMB_flipy(preprocessed_ibuf);
   }
 
@@ -975,12 +1014,13 @@ static ImBuf *seq_render_image_strip_view(const SeqRenderData *context,
                                           char *name,
                                           char *prefix,
                                           const char *ext,
-                                          int view_id)
+                                          int view_id,
+                                          int reduce_flag)
 {
 
   ImBuf *ibuf = NULL;
 
-  int flag = IB_rect | IB_metadata;
+  int flag = IB_rect | IB_metadata | reduce_flag;
   if (seq->alpha_mode == SEQ_ALPHA_PREMUL) {
     flag |= IB_alphamode_premul;
   }
@@ -1026,6 +1066,56 @@ static bool seq_image_strip_is_multiview_render(
   return (seq->flag & SEQ_USE_VIEWS) != 0 && (scene->r.scemode & R_MULTIVIEW) != 0;
 }
 
+/* Images are decoded at preview resolution directly when their format allows it, they are then
+ * handled as proxy images. */
+static int seq_render_image_reduce_flag(const SeqRenderData *context)
+{
+  if (context->for_render || context->is_proxy_render) {
+    return 0;
+  }
+
+  switch (context->preview_render_size) {
+    case SEQ_RENDER_SIZE_PROXY_25:
+      return IB_reduce_quarter;
+    case SEQ_RENDER_SIZE_PROXY_50:
+      return IB_reduce_half;
+  }
+
+  return 0;
+}
+
+/* Set the size of the image file, which is only known from the image itself when it was decoded
+ * at full resolution. */
+static void seq_render_image_strip_orig_size_set(StripElem *s_elem,
+                                                 const char *name,
+                                                 const ImBuf *ibuf,
+                                                 const int reduce_flag)
+{
+  if (reduce_flag == 0 || ibuf->ftype != IMB_FTYPE_JPG) {
+    s_elem->orig_width = ibuf->x;
+    s_elem->orig_height = ibuf->y;
+    return;
+  }
+
+  /* Keep the size found by an earlier full resolution load when it matches. */
+  const int denom = (reduce_flag & IB_reduce_quarter) ? 4 : 2;
+  if ((s_elem->orig_width + denom - 1) / denom == ibuf->x &&
+      (s_elem->orig_height + denom - 1) / denom == ibuf->y) {
+    return;
+  }
+
+  ImBuf *ibuf_header = IMB_loadiffname(name, IB_test, NULL);
+  if (ibuf_header != NULL) {
+    s_elem->orig_width = ibuf_header->x;
+    s_elem->orig_height = ibuf_header->y;
+    IMB_freeImBuf(ibuf_header);
+  }
+  else {
+    s_elem->orig_width = ibuf->x * denom;
+    s_elem->orig_height = ibuf->y * denom;
+  }
+}
+
 static ImBuf *seq_render_image_strip(const SeqRenderData *context,
                                      Sequence *seq,
                                      float UNUSED(frame_index),
@@ -1036,6 +1126,7 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context,
   const char *ext = NULL;
   char prefix[FILE_MAX];
   ImBuf *ibuf = NULL;
+  int reduce_flag = 0;
 
   StripElem *s_elem = SEQ_render_give_stripelem(seq, timeline_frame);
   if (s_elem == NULL) {
@@ -1064,7 +1155,8 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context,
     ImBuf **ibufs_arr = MEM_callocN(sizeof(ImBuf *) * totviews, "Sequence Image Views Imbufs");
 
     for (int view_id = 0; view_id < totfiles; view_id++) {
-      ibufs_arr[view_id] = seq_render_image_strip_view(context, seq, name, prefix, ext, view_id);
+      ibufs_arr[view_id] = seq_render_image_strip_view(
+          context, seq, name, prefix, ext, view_id, 0);
     }
 
     if (ibufs_arr[0] == NULL) {
@@ -1098,15 +1190,20 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context,
     MEM_freeN(ibufs_arr);
   }
   else {
-    ibuf = seq_render_image_strip_view(context, seq, name, prefix, ext, context->view_id);
+    reduce_flag = seq_render_image_reduce_flag(context);
+    ibuf = seq_render_image_strip_view(
+        context, seq, name, prefix, ext, context->view_id, reduce_flag);
   }
 
   if (ibuf == NULL) {
     return NULL;
   }
 
-  s_elem->orig_width = ibuf->x;
-  s_elem->orig_height = ibuf->y;
+  seq_render_image_strip_orig_size_set(s_elem, name, ibuf, reduce_flag);
+
+  if (reduce_flag != 0 && ibuf->ftype == IMB_FTYPE_JPG) {
+    *r_is_proxy_image = true;
+  }
 
   return ibuf;
 }
@@ -1905,6 +2002,86 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Image and movie strips only read their own files, other strips may render scenes or other
+ * strips of the stack. */
+static bool seq_render_strip_is_threadsafe(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (const SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_input_type == SEQUENCE_MASK_INPUT_STRIP && smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Marks a strip of the stack to be rendered by #seq_render_strip_stack_strips. */
+#define SEQ_RENDER_STACK_PENDING ((ImBuf *)-1)
+
+typedef struct RenderStripStackTask {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence *seq;
+  float timeline_frame;
+  ImBuf **r_ibuf;
+} RenderStripStackTask;
+
+static void seq_render_strip_stack_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderStripStackTask *task = taskdata;
+  *task->r_ibuf = seq_render_strip(task->context, task->state, task->seq, task->timeline_frame);
+}
+
+/**
+ * Render the strips marked as pending in \a r_ibufs, image and movie strips are decoded and
+ * preprocessed in parallel while the other ones are rendered on the calling thread.
+ */
+static void seq_render_strip_stack_strips(const SeqRenderData *context,
+                                          SeqRenderState *state,
+                                          Sequence **seq_arr,
+                                          int count,
+                                          float timeline_frame,
+                                          ImBuf **r_ibufs)
+{
+  RenderStripStackTask tasks[MAXSEQ + 1];
+  int tasks_num = 0;
+
+  for (int i = 0; i < count; i++) {
+    if (r_ibufs[i] == SEQ_RENDER_STACK_PENDING && seq_render_strip_is_threadsafe(seq_arr[i])) {
+      tasks[tasks_num++] = (RenderStripStackTask){
+          .context = context,
+          .state = state,
+          .seq = seq_arr[i],
+          .timeline_frame = timeline_frame,
+          .r_ibuf = &r_ibufs[i],
+      };
+    }
+  }
+
+  TaskPool *pool = NULL;
+  if (tasks_num > 1) {
+    pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    for (int i = 0; i < tasks_num; i++) {
+      BLI_task_pool_push(pool, seq_render_strip_stack_task, &tasks[i], false, NULL);
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    /* Don't read the pointers tasks are writing to. */
+    if ((pool == NULL || !seq_render_strip_is_threadsafe(seq_arr[i])) &&
+        r_ibufs[i] == SEQ_RENDER_STACK_PENDING) {
+      r_ibufs[i] = seq_render_strip(context, state, seq_arr[i], timeline_frame);
+    }
+  }
+
+  if (pool) {
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1912,9 +2089,12 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      int chanshown)
 {
   Sequence *seq_arr[MAXSEQ + 1];
+  ImBuf *ibufs[MAXSEQ + 1] = {NULL};
   int count;
   int i;
   ImBuf *out = NULL;
+  bool out_is_pending = false;
+  bool blend_first = false;
 
   count = seq_get_shown_sequences(seqbasep, timeline_frame, chanshown, (Sequence **)&seq_arr);
 
@@ -1922,6 +2102,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  /* Find the strip blending starts from, strips below it are not visible. */
   for (i = count - 1; i >= 0; i--) {
     int early_out;
     Sequence *seq = seq_arr[i];
@@ -1932,7 +2113,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, timeline_frame);
+      out_is_pending = true;
       break;
     }
 
@@ -1941,7 +2122,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     switch (early_out) {
       case EARLY_NO_INPUT:
       case EARLY_USE_INPUT_2:
-        out = seq_render_strip(context, state, seq, timeline_frame);
+        out_is_pending = true;
         break;
       case EARLY_USE_INPUT_1:
         if (i == 0) {
@@ -1950,30 +2131,50 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
         break;
       case EARLY_DO_EFFECT:
         if (i == 0) {
-          ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
-
-          out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
-
-          seq_cache_put(context, seq_arr[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
-
-          IMB_freeImBuf(ibuf1);
-          IMB_freeImBuf(ibuf2);
+          out_is_pending = true;
+          blend_first = true;
         }
         break;
     }
-    if (out) {
+    if (out || out_is_pending) {
       break;
     }
   }
 
+  /* Render all strips that are needed at once, so they can be rendered in parallel. */
+  if (out_is_pending) {
+    ibufs[i] = SEQ_RENDER_STACK_PENDING;
+  }
+  for (int j = i + 1; j < count; j++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[j]) == EARLY_DO_EFFECT) {
+      ibufs[j] = SEQ_RENDER_STACK_PENDING;
+    }
+  }
+  seq_render_strip_stack_strips(context, state, seq_arr, count, timeline_frame, ibufs);
+
+  if (out_is_pending) {
+    out = ibufs[i];
+
+    if (blend_first) {
+      ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
+      ImBuf *ibuf2 = out;
+
+      out = seq_render_strip_stack_apply_effect(context, seq_arr[i], timeline_frame, ibuf1, ibuf2);
+
+      seq_cache_put(context, seq_arr[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
+
+      IMB_freeImBuf(ibuf1);
+      IMB_freeImBuf(ibuf2);
+    }
+  }
+
   i++;
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
-    if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
+    if (ibufs[i] != NULL) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = ibufs[i];
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
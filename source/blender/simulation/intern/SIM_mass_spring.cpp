@@ -1225,6 +1225,7 @@ static void cloth_clear_result(ClothModifierData *clmd)
   sres->max_error = sres->min_error = sres->avg_error = 0.0f;
   sres->max_iterations = sres->min_iterations = 0;
   sres->avg_iterations = 0.0f;
+  sres->time = 0.0f;
 }
 
 static void cloth_record_result(ClothModifierData *clmd, ImplicitSolverResult *result, float dt)
@@ -1254,6 +1255,7 @@ static void cloth_record_result(ClothModifierData *clmd, ImplicitSolverResult *r
     sres->avg_iterations += (float)result->iterations * dt;
   }
 
+  sres->time += result->time;
   sres->status |= result->status;
 }
 
@@ -57,6 +57,8 @@ typedef struct ImplicitSolverResult {
 
   int iterations;
   float error;
+  /* Time spent solving, in seconds. */
+  float time;
 } ImplicitSolverResult;
 
 BLI_INLINE void implicit_print_matrix_elem(float v)
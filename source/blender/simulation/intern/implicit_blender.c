@@ -34,12 +34,15 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
 #  include "BKE_collision.h"
 #  include "BKE_effect.h"
 
+#  include "PIL_time.h"
+
 #  include "SIM_mass_spring.h"
 
 #  ifdef __GNUC__
@@ -52,9 +55,9 @@
 
 //#define DEBUG_TIME
 
-#  ifdef DEBUG_TIME
-#    include "PIL_time.h"
-#  endif
+/* Precondition the conjugate gradient solver with the inverse of the diagonal blocks of the
+ * system matrix, comment out to solve without preconditioning. */
+#  define USE_BLOCK_JACOBI_PRECONDITIONER
 
 static float I[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
 static float ZERO[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
@@ -644,6 +647,99 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Blocks of each row of a big matrix, so multiplying it with a long vector can be split over
+ * the rows without two threads writing the same element. */
+typedef struct BigMatrixRows {
+  /* First entry of each row in #blocks, followed by the end of the last row. */
+  int *offsets;
+  /* Index of an off-diagonal block in the big matrix. The blocks in the lower triangle are
+   * stored as the negated index minus one, they are multiplied transposed. */
+  int *blocks;
+} BigMatrixRows;
+
+/* Build the rows of a big matrix, using only its first \a num_blocks off-diagonal blocks. */
+static void create_bfmatrix_rows(BigMatrixRows *rows, fmatrix3x3 *matrix, unsigned int num_blocks)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  int *offsets = MEM_calloc_arrayN(vcount + 1, sizeof(int), "cloth_implicit_rows");
+  int *blocks = MEM_malloc_arrayN(max_ii(2 * num_blocks, 1), sizeof(int), "cloth_implicit_rows");
+
+  for (unsigned int i = vcount; i < vcount + num_blocks; i++) {
+    offsets[matrix[i].r + 1]++;
+    offsets[matrix[i].c + 1]++;
+  }
+  for (unsigned int i = 0; i < vcount; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  int *fill = MEM_dupallocN(offsets);
+  for (unsigned int i = vcount; i < vcount + num_blocks; i++) {
+    blocks[fill[matrix[i].r]++] = (int)i;
+    blocks[fill[matrix[i].c]++] = -(int)i - 1;
+  }
+  MEM_freeN(fill);
+
+  rows->offsets = offsets;
+  rows->blocks = blocks;
+}
+
+static void del_bfmatrix_rows(BigMatrixRows *rows)
+{
+  MEM_freeN(rows->offsets);
+  MEM_freeN(rows->blocks);
+}
+
+typedef struct MulBigMatrixRowsData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  const BigMatrixRows *rows;
+  lfVector *fLongVector;
+} MulBigMatrixRowsData;
+
+static void mul_bfmatrix_rows_lfvector_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBigMatrixRowsData *data = userdata;
+  fmatrix3x3 *from = data->from;
+  lfVector *fLongVector = data->fLongVector;
+  const BigMatrixRows *rows = data->rows;
+  float r[3];
+
+  mul_fmatrix_fvector(r, from[i].m, fLongVector[i]);
+  for (int j = rows->offsets[i]; j < rows->offsets[i + 1]; j++) {
+    const int block = rows->blocks[j];
+    if (block >= 0) {
+      muladd_fmatrix_fvector(r, from[block].m, fLongVector[from[block].c]);
+    }
+    else {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      const fmatrix3x3 *block_lower = &from[-block - 1];
+      muladd_fmatrixT_fvector(r, block_lower->m, fLongVector[block_lower->r]);
+    }
+  }
+  copy_v3_v3(data->to[i], r);
+}
+
+/* Same as #mul_bfmatrix_lfvector, multiplying the rows in parallel. */
+static void mul_bfmatrix_rows_lfvector(float (*to)[3],
+                                       fmatrix3x3 *from,
+                                       const BigMatrixRows *rows,
+                                       lfVector *fLongVector)
+{
+  MulBigMatrixRowsData data = {
+      .to = to,
+      .from = from,
+      .rows = rows,
+      .fLongVector = fLongVector,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, from[0].vcount, &data, mul_bfmatrix_rows_lfvector_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -780,6 +876,26 @@ DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
   }
 }
 
+/* Multiply a long vector with the diagonal blocks of a big matrix. */
+DO_INLINE void mul_prevfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+{
+  for (unsigned int i = 0; i < from[0].vcount; i++) {
+    mul_fmatrix_fvector(to[i], from[i].m, fLongVector[i]);
+  }
+}
+
+#  ifdef USE_BLOCK_JACOBI_PRECONDITIONER
+/* Store the inverse of the diagonal blocks of lA in Pinv. */
+static void build_block_jacobi_pinv(fmatrix3x3 *lA, fmatrix3x3 *Pinv)
+{
+  for (unsigned int i = 0; i < lA[0].vcount; i++) {
+    if (!invert_m3_m3(Pinv[i].m, lA[i].m)) {
+      unit_m3(Pinv[i].m);
+    }
+  }
+}
+#  endif
+
 /* this version of the CG algorithm does not work very well with partial constraints
  * (where S has non-zero elements). */
 #  if 0
@@ -850,11 +966,15 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 }
 #  endif
 
+/* Pinv is the inverse of the pre-conditioning matrix, only its diagonal blocks are used.
+ * When it is NULL no pre-conditioning is done. */
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BigMatrixRows *lA_rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       fmatrix3x3 *Pinv,
                        ImplicitSolverResult *result)
 {
   /* Solves for unknown X in equation AX=B */
@@ -872,19 +992,30 @@ static int cg_filtered(lfVector *ldV,
 
   cp_lfvector(ldV, z, numverts);
 
-  /* d0 = filter(B)^T * P * filter(B) */
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  if (Pinv) {
+    mul_prevfmatrix_lfvector(s, Pinv, fB);
+    bnorm2 = dot_lfvector(fB, s, numverts);
+  }
+  else {
+    bnorm2 = dot_lfvector(fB, fB, numverts);
+  }
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_rows_lfvector(AdV, lA, lA_rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  if (Pinv) {
+    mul_prevfmatrix_lfvector(c, Pinv, r);
+  }
+  else {
+    cp_lfvector(c, r, numverts);
+  }
   filter(c, S);
 
   /* delta = r^T * c */
@@ -902,7 +1033,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_rows_lfvector(q, lA, lA_rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -912,7 +1043,12 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    if (Pinv) {
+      mul_prevfmatrix_lfvector(s, Pinv, r);
+    }
+    else {
+      cp_lfvector(s, r, numverts);
+    }
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
 
@@ -1162,28 +1298,39 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All the matrices share the same off-diagonal blocks. */
+  BigMatrixRows rows;
+  create_bfmatrix_rows(&rows, data->A, data->num_blocks);
+
+  mul_bfmatrix_rows_lfvector(dFdXmV, data->dFdX, &rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
-#  ifdef DEBUG_TIME
   double start = PIL_check_seconds_timer();
+
+#  ifdef USE_BLOCK_JACOBI_PRECONDITIONER
+  fmatrix3x3 *Pinv = data->Pinv;
+  build_block_jacobi_pinv(data->A, Pinv);
+#  else
+  fmatrix3x3 *Pinv = NULL;
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &rows, data->B, data->z, data->S, Pinv, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
+  result->time = (float)(PIL_check_seconds_timer() - start);
+
 #  ifdef DEBUG_TIME
-  double end = PIL_check_seconds_timer();
-  printf("cg_filtered calc time: %f\n", (float)(end - start));
+  printf("cg_filtered calc time: %f\n", result->time);
 #  endif
 
   /* advance velocities */
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
   del_lfvector(dFdXmV);
+  del_bfmatrix_rows(&rows);
 
   return result->status == SIM_SOLVER_SUCCESS;
 }
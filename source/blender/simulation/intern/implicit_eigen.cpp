@@ -581,6 +581,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   result->iterations = cg.iterations();
   result->error = cg.error();
+  result->time = 0.0f;
 
   return cg.info() == Eigen::Success;
 }
@@ -773,6 +773,15 @@ void WM_jobs_callbacks(struct wmJob *,
                        void (*update)(void *),
                        void (*endjob)(void *));
 
+typedef void (*wm_jobs_task_callback)(
+    void *userdata, int index, short *stop, short *do_update, float *progress);
+void WM_jobs_tasks_run(int tasks_num,
+                       wm_jobs_task_callback task_cb,
+                       void *userdata,
+                       short *stop,
+                       short *do_update,
+                       float *progress);
+
 void WM_jobs_start(struct wmWindowManager *wm, struct wmJob *);
 void WM_jobs_stop(struct wmWindowManager *wm, void *owner, void *startjob);
 void WM_jobs_kill(struct wmWindowManager *wm,
@@ -717,6 +717,12 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
     /* also exit screens and editors */
     wm_window_match_init(C, &wmbase);
 
+    eBLOReadSkip skip_flags = BLO_READ_SKIP_USERDEF;
+    /* Files only loaded to be rendered don't need their UI. */
+    if (G.background && (G.f & G_FLAG_FILE_READ_NO_UI_DATA)) {
+      skip_flags |= BLO_READ_SKIP_UI;
+    }
+
     /* confusing this global... */
     G.relbase_valid = 1;
     success = BKE_blendfile_read(
@@ -727,7 +733,7 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
          * Further it's just confusing if a user loads a file and various preferences change. */
         &(const struct BlendFileReadParams){
             .is_startup = false,
-            .skip_flags = BLO_READ_SKIP_USERDEF,
+            .skip_flags = skip_flags,
         },
         reports);
 
@@ -1557,6 +1563,9 @@ static bool wm_file_write(bContext *C,
 /** \name Auto-Save API
  * \{ */
 
+/** Chunks written by the last auto-save from an undo memfile, to only write what changed. */
+static MemFileWriteState *wm_autosave_memfile_write_state = NULL;
+
 void wm_autosave_location(char *filepath)
 {
   const int pid = abs(getpid());
@@ -1628,7 +1637,7 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer *UNUSED(wt))
     /* fast save of last undobuffer, now with UI */
     struct MemFile *memfile = ED_undosys_stack_memfile_get_active(wm->undo_stack);
     if (memfile) {
-      BLO_memfile_write_file(memfile, filepath);
+      BLO_memfile_write_file_incremental(memfile, filepath, &wm_autosave_memfile_write_state);
     }
   }
   else {
@@ -1658,6 +1667,11 @@ void wm_autosave_delete(void)
 
   wm_autosave_location(filename);
 
+  if (wm_autosave_memfile_write_state) {
+    BLO_memfile_write_state_free(wm_autosave_memfile_write_state);
+    wm_autosave_memfile_write_state = NULL;
+  }
+
   if (BLI_exists(filename)) {
     char str[FILE_MAX];
     BLI_join_dirfile(str, sizeof(str), BKE_tempdir_base(), BLENDER_QUIT_FILE);
@@ -46,6 +46,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
@@ -119,6 +120,8 @@
 #include "ED_undo.h"
 #include "ED_util.h"
 
+#include "PIL_time.h"
+
 #include "BLF_api.h"
 #include "BLT_lang.h"
 #include "UI_interface.h"
@@ -221,9 +224,23 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
   }
 }
 
+static CLG_LogRef LOG = {"wm.init"};
+
+/* Time of the end of the previous startup phase, see #wm_init_phase_report. */
+static double wm_init_phase_time = 0.0;
+
+/* Report the time spent since the previous startup phase in the `wm.init` log. */
+static void wm_init_phase_report(const char *phase)
+{
+  const double time = PIL_check_seconds_timer();
+  CLOG_INFO(&LOG, 1, "%s: %.4f seconds", phase, time - wm_init_phase_time);
+  wm_init_phase_time = time;
+}
+
 /* only called once, for startup */
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  const double init_time = wm_init_phase_time = PIL_check_seconds_timer();
 
   if (!G.background) {
     wm_ghost_init(C); /* note: it assigns C to ghost! */
@@ -233,6 +250,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   GHOST_CreateSystemPaths();
 
+  wm_init_phase_report("Window system");
+
   BKE_addon_pref_type_init();
   BKE_keyconfig_pref_type_init();
 
@@ -260,6 +279,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_node_init_butfuncs();
 
+  wm_init_phase_report("Types registration");
+
   BLF_init();
 
   BLT_lang_init();
@@ -272,6 +293,8 @@ void WM_init(bContext *C, int argc, const char **argv)
    * for scripts that do background processing with preview icons. */
   BKE_icons_init(BIFICONID_LAST);
 
+  wm_init_phase_report("Fonts, translations and icons");
+
   /* reports cant be initialized before the wm,
    * but keep before file reading, since that may report errors */
   wm_init_reports(C);
@@ -283,9 +306,8 @@ void WM_init(bContext *C, int argc, const char **argv)
   const bool use_data = true;
   const bool use_userdef = true;
 
-  /* Studio-lights needs to be init before we read the home-file,
-   * otherwise the versioning cannot find the default studio-light. */
-  BKE_studiolight_init();
+  /* Studio-lights are initialized on first use, which includes the versioning of the home-file
+   * looking for the default studio-light. */
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
@@ -299,6 +321,8 @@ void WM_init(bContext *C, int argc, const char **argv)
                    WM_init_state_app_template_get(),
                    &is_factory_startup);
 
+  wm_init_phase_report("Startup file and preferences");
+
   /* Call again to set from userpreferences... */
   BLT_lang_set(NULL);
 
@@ -327,6 +351,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_spacemacros_init();
 
+  wm_init_phase_report("GPU and interface");
+
   /* note: there is a bug where python needs initializing before loading the
    * startup.blend because it may contain PyDrivers. It also needs to be after
    * initializing space types and other internal data.
@@ -338,6 +364,7 @@ void WM_init(bContext *C, int argc, const char **argv)
 #ifdef WITH_PYTHON
   BPY_python_start(C, argc, argv);
   BPY_python_reset(C);
+  wm_init_phase_report("Python, scripts and add-ons");
 #else
   (void)argc; /* unused */
   (void)argv; /* unused */
@@ -393,6 +420,9 @@ void WM_init(bContext *C, int argc, const char **argv)
       CTX_wm_window_set(C, NULL);
     }
   }
+
+  wm_init_phase_report("Load handlers");
+  CLOG_INFO(&LOG, 1, "Total: %.4f seconds", PIL_check_seconds_timer() - init_time);
 }
 
 void WM_init_splash(bContext *C)
@@ -654,6 +684,11 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   DNA_sdna_current_free();
 
+  if (G.debug & G_DEBUG) {
+    BLI_task_parallel_range_stats_print();
+  }
+  BLI_trace_exit();
+
   BLI_threadapi_exit();
   BLI_task_scheduler_exit();
 
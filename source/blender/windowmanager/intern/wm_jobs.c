@@ -30,6 +30,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -392,6 +393,103 @@ static void *do_job_thread(void *job_v)
   return NULL;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Job Tasks
+ *
+ * Lets a job split its work in independent tasks executed by the task scheduler,
+ * so running jobs share the worker threads with each other and with the main thread.
+ * The job thread only streams the progress of the tasks and forwards its stop flag.
+ * \{ */
+
+typedef struct wmJobTask {
+  short do_update;
+  short ready;
+  float progress;
+} wmJobTask;
+
+typedef struct wmJobTasksData {
+  wm_jobs_task_callback task_cb;
+  void *userdata;
+  short *stop;
+  wmJobTask *tasks;
+} wmJobTasksData;
+
+static void wm_jobs_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  wmJobTasksData *data = BLI_task_pool_user_data(pool);
+  const int index = POINTER_AS_INT(taskdata);
+  wmJobTask *task = &data->tasks[index];
+
+  /* Tasks that didn't start yet are skipped once the job is stopped. */
+  if (!*data->stop) {
+    data->task_cb(data->userdata, index, data->stop, &task->do_update, &task->progress);
+  }
+  task->progress = 1.0f;
+  task->do_update = true;
+  task->ready = true;
+}
+
+/**
+ * Run `task_cb` for every index in `[0, tasks_num)` in the task scheduler, waiting until all
+ * tasks finished. To be called from the start callback of a job, with its own stop, update and
+ * progress pointers: each task gets a stop pointer honoring the job stop, and private progress
+ * which is averaged for the job while the tasks run.
+ */
+void WM_jobs_tasks_run(const int tasks_num,
+                       wm_jobs_task_callback task_cb,
+                       void *userdata,
+                       short *stop,
+                       short *do_update,
+                       float *progress)
+{
+  if (tasks_num == 0) {
+    return;
+  }
+
+  wmJobTasksData data = {
+      .task_cb = task_cb,
+      .userdata = userdata,
+      .stop = stop,
+      .tasks = MEM_callocN(sizeof(wmJobTask) * (size_t)tasks_num, __func__),
+  };
+
+  /* Low priority, interactive work of the main thread is scheduled first. */
+  TaskPool *pool = BLI_task_pool_create(&data, TASK_PRIORITY_LOW);
+  for (int i = 0; i < tasks_num; i++) {
+    BLI_task_pool_push(pool, wm_jobs_task_run, POINTER_FROM_INT(i), false, NULL);
+  }
+
+  int tasks_ready;
+  do {
+    PIL_sleep_ms(20);
+
+    bool task_update = false;
+    float progress_sum = 0.0f;
+    tasks_ready = 0;
+    for (int i = 0; i < tasks_num; i++) {
+      wmJobTask *task = &data.tasks[i];
+      if (task->do_update) {
+        task->do_update = false;
+        task_update = true;
+      }
+      progress_sum += task->progress;
+      tasks_ready += task->ready;
+    }
+
+    if (task_update) {
+      *progress = progress_sum / (float)tasks_num;
+      *do_update = true;
+    }
+  } while (tasks_ready < tasks_num);
+
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  MEM_freeN(data.tasks);
+}
+
+/** \} */
+
 /* don't allow same startjob to be executed twice */
 static void wm_jobs_test_suspend_stop(wmWindowManager *wm, wmJob *test)
 {
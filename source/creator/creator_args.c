@@ -41,6 +41,7 @@
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
@@ -563,6 +564,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   printf("Debug Options:\n");
   BLI_args_print_arg_doc(ba, "--debug");
   BLI_args_print_arg_doc(ba, "--debug-value");
+  BLI_args_print_arg_doc(ba, "--debug-trace");
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-events");
@@ -589,6 +591,9 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
   BLI_args_print_arg_doc(ba, "--debug-wm");
+#  ifdef WITH_PYTHON
+  BLI_args_print_arg_doc(ba, "--debug-drivers");
+#  endif
 #  ifdef WITH_XR_OPENXR
   BLI_args_print_arg_doc(ba, "--debug-xr");
   BLI_args_print_arg_doc(ba, "--debug-xr-time");
@@ -606,6 +611,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--app-template");
   BLI_args_print_arg_doc(ba, "--factory-startup");
   BLI_args_print_arg_doc(ba, "--enable-event-simulate");
+  BLI_args_print_arg_doc(ba, "--enable-addons-lazy");
+  BLI_args_print_arg_doc(ba, "--no-ui-data");
   printf("\n");
   BLI_args_print_arg_doc(ba, "--env-system-datafiles");
   BLI_args_print_arg_doc(ba, "--env-system-scripts");
@@ -938,6 +945,12 @@ static const char arg_handle_debug_mode_generic_set_doc_wm[] =
     "\n\t"
     "Enable debug messages for the window manager, shows all operators in search, shows "
     "keymap errors.";
+#  ifdef WITH_PYTHON
+static const char arg_handle_debug_mode_generic_set_doc_drivers[] =
+    "\n\t"
+    "Enable time profiling for drivers that can only be evaluated by Python,\n"
+    "\tthe statistics are printed on exit.";
+#  endif
 #  ifdef WITH_XR_OPENXR
 static const char arg_handle_debug_mode_generic_set_doc_xr[] =
     "\n\t"
@@ -1075,6 +1088,21 @@ static int arg_handle_debug_value_set(int argc, const char **argv, void *UNUSED(
   return 0;
 }
 
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filename>\n"
+    "\tRecord the time spent in depsgraph operations, modifiers, draw passes, file reading and\n"
+    "\twriting and Cycles synchronization by every thread. The timeline is written on exit to\n"
+    "\t<filename> in the Chrome trace format, to be opened in 'chrome://tracing' or Perfetto.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+    BLI_trace_init(argv[1]);
+    return 1;
+  }
+  printf("\nError: '%s' no args given.\n", "--debug-trace");
+  return 0;
+}
+
 static const char arg_handle_debug_fpe_set_doc[] =
     "\n\t"
     "Enable floating-point exceptions.";
@@ -1112,6 +1140,30 @@ static int arg_handle_factory_startup_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_enable_addons_lazy_doc[] =
+    "\n\t"
+    "In background mode, only enable add-ons once an operator which is not found is used, or\n"
+    "\twhen rendering a scene using a render engine which is not found.\n"
+    "\tScripts can enable them explicitly using 'addon_utils.enable_lazy()'.";
+static int arg_handle_enable_addons_lazy(int UNUSED(argc),
+                                         const char **UNUSED(argv),
+                                         void *UNUSED(data))
+{
+  G.f |= G_FLAG_SCRIPT_ADDONS_LAZY;
+  return 0;
+}
+
+static const char arg_handle_no_ui_data_doc[] =
+    "\n\t"
+    "In background mode, don't read the UI and editor-only data-blocks of loaded files\n"
+    "\t(window managers, workspaces, screens, brushes, palettes and paint curves).\n"
+    "\tMeant for files which are only rendered, saving them loses this data.";
+static int arg_handle_no_ui_data(int UNUSED(argc), const char **UNUSED(argv), void *UNUSED(data))
+{
+  G.f |= G_FLAG_FILE_READ_NO_UI_DATA;
+  return 0;
+}
+
 static const char arg_handle_enable_event_simulate_doc[] =
     "\n\t"
     "Enable event simulation testing feature 'bpy.types.Window.event_simulate'.";
@@ -1533,6 +1585,22 @@ static const char arg_handle_render_frame_doc[] =
     "\t* A comma separated list of frames can also be used (no spaces).\n"
     "\t* A range of frames can be expressed using '..' separator between the first and last "
     "frames (inclusive).\n";
+/**
+ * Add-ons deferred by `--enable-addons-lazy` may register the render engine of the scene,
+ * enable them before rendering when it is not found.
+ */
+static void arg_render_addons_lazy_ensure(bContext *C, const Scene *scene)
+{
+#  ifdef WITH_PYTHON
+  if ((G.f & G_FLAG_SCRIPT_ADDONS_LAZY) &&
+      BLI_findstring(&R_engines, scene->r.engine, offsetof(RenderEngineType, idname)) == NULL) {
+    BPY_run_string_eval(C, (const char *[]){"addon_utils", NULL}, "addon_utils.enable_lazy()");
+  }
+#  else
+  UNUSED_VARS(C, scene);
+#  endif
+}
+
 static int arg_handle_render_frame(int argc, const char **argv, void *data)
 {
   const char *arg_id = "-f / --render-frame";
@@ -1558,6 +1626,8 @@ static int arg_handle_render_frame(int argc, const char **argv, void *data)
         return 1;
       }
 
+      arg_render_addons_lazy_ensure(C, scene);
+
       re = RE_NewSceneRender(scene);
       BKE_reports_init(&reports, RPT_STORE);
       RE_SetReports(re, &reports);
@@ -1593,6 +1663,7 @@ static int arg_handle_render_animation(int UNUSED(argc), const char **UNUSED(arg
   Scene *scene = CTX_data_scene(C);
   if (scene) {
     Main *bmain = CTX_data_main(C);
+    arg_render_addons_lazy_ensure(C, scene);
     Render *re = RE_NewSceneRender(scene);
     ReportList reports;
     BKE_reports_init(&reports, RPT_STORE);
@@ -2077,6 +2148,13 @@ void main_args_setup(bContext *C, bArgs *ba)
                (void *)G_DEBUG_HANDLERS);
   BLI_args_add(
       ba, NULL, "--debug-wm", CB_EX(arg_handle_debug_mode_generic_set, wm), (void *)G_DEBUG_WM);
+#  ifdef WITH_PYTHON
+  BLI_args_add(ba,
+               NULL,
+               "--debug-drivers",
+               CB_EX(arg_handle_debug_mode_generic_set, drivers),
+               (void *)G_DEBUG_DRIVERS);
+#  endif
 #  ifdef WITH_XR_OPENXR
   BLI_args_add(
       ba, NULL, "--debug-xr", CB_EX(arg_handle_debug_mode_generic_set, xr), (void *)G_DEBUG_XR);
@@ -2107,6 +2185,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
+  BLI_args_add(ba, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), NULL);
   BLI_args_add(ba,
                NULL,
                "--debug-jobs",
@@ -2167,6 +2246,8 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--app-template", CB(arg_handle_app_template), NULL);
   BLI_args_add(ba, NULL, "--factory-startup", CB(arg_handle_factory_startup_set), NULL);
   BLI_args_add(ba, NULL, "--enable-event-simulate", CB(arg_handle_enable_event_simulate), NULL);
+  BLI_args_add(ba, NULL, "--enable-addons-lazy", CB(arg_handle_enable_addons_lazy), NULL);
+  BLI_args_add(ba, NULL, "--no-ui-data", CB(arg_handle_no_ui_data), NULL);
 
   /* Pass: Custom Window Stuff. */
   BLI_args_pass_set(ba, ARG_PASS_SETTINGS_GUI);
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# Apache License, Version 2.0
+
+"""
+Run performance benchmarks of core operations and compare results between revisions.
+
+Each benchmark runs in a new Blender process, results are written as JSON so runs of
+different commits can be compared.
+
+Run all benchmarks, or the ones matching a regular expression:
+
+  python3 tests/performance/benchmark.py run --blender ./blender.bin --output new.json
+  python3 tests/performance/benchmark.py run --blender ./blender.bin --filter "modifiers\\."
+
+Compare two runs, exits with an error code when a benchmark got slower than the threshold:
+
+  python3 tests/performance/benchmark.py compare old.json new.json --threshold 0.1
+"""
+
+import argparse
+import datetime
+import glob
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+BASE_DIR = os.path.dirname(os.path.realpath(__file__))
+TESTS_DIR = os.path.join(BASE_DIR, "tests")
+DRIVER_PATH = os.path.join(BASE_DIR, "blender_benchmark.py")
+
+# Prefix of the lines printed by the driver, the rest of the line is a JSON object.
+RESULT_PREFIX = "BENCHMARK_RESULT: "
+RESULTS_VERSION = 1
+
+
+def benchmarks_list(pattern):
+    """Returns the (module, function, background) of all benchmarks."""
+    benchmarks = []
+    for filepath in sorted(glob.glob(os.path.join(TESTS_DIR, "*.py"))):
+        module = os.path.splitext(os.path.basename(filepath))[0]
+        with open(filepath, encoding="utf-8") as fh:
+            source = fh.read()
+        # Benchmarks needing a window to draw in run without `--background`.
+        background = re.search(r"^BACKGROUND\s*=\s*False", source, re.MULTILINE) is None
+        for function in re.findall(r"^def (benchmark_\w+)\(", source, re.MULTILINE):
+            name = module + "." + function[len("benchmark_"):]
+            if pattern is None or re.search(pattern, name):
+                benchmarks.append((module, function, background))
+    return benchmarks
+
+
+def benchmark_run(blender, module, function, background, repeat):
+    command = [blender]
+    if background:
+        command.append("--background")
+    command += [
+        "--factory-startup",
+        "-noaudio",
+        "--python-exit-code", "1",
+        "--python", DRIVER_PATH,
+        "--",
+        "--tests-dir", TESTS_DIR,
+        "--module", module,
+        "--function", function,
+        "--repeat", str(repeat),
+    ]
+    proc = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    for line in proc.stdout.splitlines():
+        if line.startswith(RESULT_PREFIX):
+            return json.loads(line[len(RESULT_PREFIX):])
+    sys.stdout.write(proc.stdout)
+    return None
+
+
+def blender_version(blender):
+    proc = subprocess.run([blender, "--version"], stdout=subprocess.PIPE, text=True)
+    lines = proc.stdout.splitlines()
+    return lines[0] if lines else ""
+
+
+def git_revision():
+    proc = subprocess.run(["git", "rev-parse", "HEAD"], cwd=BASE_DIR,
+                          stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    return proc.stdout.strip()
+
+
+def command_run(args):
+    benchmarks = benchmarks_list(args.filter)
+    if not benchmarks:
+        print("No benchmark matches", args.filter)
+        return 1
+
+    results = {
+        "version": RESULTS_VERSION,
+        "revision": git_revision(),
+        "blender": blender_version(args.blender),
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "tests": {},
+    }
+
+    failed = False
+    for module, function, background in benchmarks:
+        name = module + "." + function[len("benchmark_"):]
+        result = benchmark_run(args.blender, module, function, background, args.repeat)
+        if result is None:
+            print("%-40s FAILED" % name)
+            failed = True
+            continue
+        times = result["times"]
+        results["tests"][name] = {
+            "times": times,
+            "median": statistics.median(times),
+            "min": min(times),
+        }
+        print("%-40s %10.4f s" % (name, statistics.median(times)))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as fh:
+            json.dump(results, fh, indent=2)
+
+    return 1 if failed else 0
+
+
+def command_compare(args):
+    with open(args.old, encoding="utf-8") as fh:
+        old = json.load(fh)
+    with open(args.new, encoding="utf-8") as fh:
+        new = json.load(fh)
+
+    print("Old: %s %s" % (old["revision"][:12], old["blender"]))
+    print("New: %s %s" % (new["revision"][:12], new["blender"]))
+    print()
+
+    regressions = []
+    for name in sorted(set(old["tests"]) | set(new["tests"])):
+        if name not in old["tests"] or name not in new["tests"]:
+            print("%-40s only in %s" % (name, "new" if name in new["tests"] else "old"))
+            continue
+        time_old = old["tests"][name]["median"]
+        time_new = new["tests"][name]["median"]
+        ratio = time_new / time_old if time_old > 0.0 else 1.0
+        status = ""
+        if ratio > 1.0 + args.threshold:
+            status = "SLOWER"
+            regressions.append(name)
+        elif ratio < 1.0 - args.threshold:
+            status = "faster"
+        print("%-40s %10.4f s %10.4f s %7.2fx %s" % (name, time_old, time_new, ratio, status))
+
+    if regressions:
+        print()
+        print("%d benchmark(s) slower than the threshold of %d%%" %
+              (len(regressions), round(args.threshold * 100)))
+        return 1
+    return 0
+
+
+def argparse_create():
+    parser = argparse.ArgumentParser(description="Blender performance benchmarks.")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    parser_run = subparsers.add_parser("run", help="Run benchmarks")
+    parser_run.add_argument("--blender", required=True, help="Blender executable to run")
+    parser_run.add_argument("--output", help="JSON file to write the results to")
+    parser_run.add_argument("--filter", help="Regular expression matching benchmark names")
+    parser_run.add_argument("--repeat", type=int, default=5,
+                            help="Number of timed runs of each benchmark, the median is reported")
+    parser_run.set_defaults(func=command_run)
+
+    parser_compare = subparsers.add_parser("compare", help="Compare the results of two runs")
+    parser_compare.add_argument("old", help="JSON results of the reference run")
+    parser_compare.add_argument("new", help="JSON results to compare")
+    parser_compare.add_argument("--threshold", type=float, default=0.1,
+                                help="Relative slowdown reported as a regression")
+    parser_compare.set_defaults(func=command_compare)
+
+    return parser
+
+
+def main():
+    args = argparse_create().parse_args()
+    sys.exit(args.func(args))
+
+
+if __name__ == "__main__":
+    main()
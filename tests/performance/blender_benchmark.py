@@ -0,0 +1,70 @@
+# Apache License, Version 2.0
+
+"""
+Runs a single benchmark inside Blender, used by `benchmark.py`.
+
+Benchmarks are functions named `benchmark_*` taking a `Timer`. They set up their data,
+then time the measured operation with `with timer:`, which is run several times.
+"""
+
+import argparse
+import importlib
+import json
+import os
+import sys
+import time
+
+import bpy
+
+RESULT_PREFIX = "BENCHMARK_RESULT: "
+
+
+class Timer:
+    """Accumulates the time spent in `with` blocks."""
+
+    def __init__(self):
+        self.elapsed = 0.0
+        self._start = 0.0
+
+    def __enter__(self):
+        self._start = time.perf_counter()
+        return self
+
+    def __exit__(self, *args):
+        self.elapsed += time.perf_counter() - self._start
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:]
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--tests-dir", required=True)
+    parser.add_argument("--module", required=True)
+    parser.add_argument("--function", required=True)
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args(argv)
+
+    sys.path.append(args.tests_dir)
+    function = getattr(importlib.import_module(args.module), args.function)
+
+    times = []
+    for _ in range(args.repeat):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+        timer = Timer()
+        function(timer)
+        times.append(timer.elapsed)
+
+    # The runner parses this line, it must be printed on a line of its own.
+    sys.stdout.write("\n" + RESULT_PREFIX + json.dumps({"times": times}) + "\n")
+    sys.stdout.flush()
+
+    if not bpy.app.background:
+        bpy.ops.wm.quit_blender()
+
+
+try:
+    main()
+except BaseException:
+    import traceback
+    traceback.print_exc()
+    # Let `--python-exit-code` report the failure.
+    raise
@@ -0,0 +1,49 @@
+# Apache License, Version 2.0
+
+"""File save and load of a scene with many objects, meshes and materials."""
+
+import os
+import tempfile
+
+import bpy
+
+
+def scene_generate(objects_num=400, grid_size=64):
+    verts = [(x / grid_size, y / grid_size, 0.0)
+             for y in range(grid_size) for x in range(grid_size)]
+    faces = [(y * grid_size + x, y * grid_size + x + 1,
+              (y + 1) * grid_size + x + 1, (y + 1) * grid_size + x)
+             for y in range(grid_size - 1) for x in range(grid_size - 1)]
+    collection = bpy.context.scene.collection
+    for i in range(objects_num):
+        mesh = bpy.data.meshes.new("Mesh%d" % i)
+        mesh.from_pydata(verts, [], faces)
+        mesh.materials.append(bpy.data.materials.new("Material%d" % i))
+        ob = bpy.data.objects.new("Object%d" % i, mesh)
+        ob.location = (i % 20, i // 20, 0.0)
+        collection.objects.link(ob)
+
+
+def benchmark_save(timer):
+    scene_generate()
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "benchmark.blend")
+        with timer:
+            bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=False)
+
+
+def benchmark_load(timer):
+    scene_generate()
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "benchmark.blend")
+        bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=False)
+        with timer:
+            bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=False)
+
+
+def benchmark_save_compressed(timer):
+    scene_generate(objects_num=100)
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "benchmark.blend")
+        with timer:
+            bpy.ops.wm.save_as_mainfile(filepath=filepath, check_existing=False, compress=True)
@@ -0,0 +1,95 @@
+# Apache License, Version 2.0
+
+"""Dependency graph evaluation of animated scenes."""
+
+import random
+
+import bpy
+
+FRAMES = range(1, 51)
+
+
+def rig_generate(chains_num, chain_length):
+    """Animated chains of bones parented to a common root, with constraints between chains."""
+    armature = bpy.data.armatures.new("Rig")
+    ob = bpy.data.objects.new("Rig", armature)
+    bpy.context.scene.collection.objects.link(ob)
+    bpy.context.view_layer.objects.active = ob
+
+    bpy.ops.object.mode_set(mode='EDIT')
+    root = armature.edit_bones.new("root")
+    root.tail = (0.0, 0.0, 1.0)
+    for chain in range(chains_num):
+        parent = root
+        for i in range(chain_length):
+            bone = armature.edit_bones.new("chain%d.%d" % (chain, i))
+            bone.head = (chain * 0.1, 0.0, 1.0 + i * 0.5)
+            bone.tail = (chain * 0.1, 0.0, 1.5 + i * 0.5)
+            bone.parent = parent
+            bone.use_connect = (i > 0)
+            bone.bbone_segments = 4
+            parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    for chain in range(1, chains_num):
+        con = ob.pose.bones["chain%d.%d" % (chain, chain_length - 1)].constraints.new(
+            'COPY_ROTATION')
+        con.target = ob
+        con.subtarget = "chain%d.%d" % (chain - 1, chain_length - 1)
+        con.influence = 0.5
+
+    rng = random.Random(0)
+    for pchan in ob.pose.bones:
+        pchan.rotation_mode = 'XYZ'
+        for frame in (FRAMES[0], FRAMES[len(FRAMES) // 2], FRAMES[-1]):
+            pchan.rotation_euler = [rng.uniform(-0.5, 0.5) for _ in range(3)]
+            pchan.keyframe_insert("rotation_euler", frame=frame)
+    return ob
+
+
+def skinned_mesh_generate(rig, grid_size=128):
+    """Grid deformed by the rig, using automatic weights from the bone envelopes."""
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=grid_size, y_subdivisions=grid_size, size=8.0)
+    ob = bpy.context.active_object
+    ob.rotation_euler = (1.5708, 0.0, 0.0)
+    ob.location = (0.0, 0.0, 4.0)
+    ob.parent = rig
+    mod = ob.modifiers.new("Armature", 'ARMATURE')
+    mod.object = rig
+    mod.use_vertex_groups = False
+    mod.use_bone_envelopes = True
+    return ob
+
+
+def frames_evaluate(timer):
+    scene = bpy.context.scene
+    scene.frame_set(FRAMES[0])
+    with timer:
+        for frame in FRAMES:
+            scene.frame_set(frame)
+
+
+def benchmark_rig(timer):
+    rig_generate(chains_num=64, chain_length=12)
+    frames_evaluate(timer)
+
+
+def benchmark_rig_skinned_mesh(timer):
+    rig = rig_generate(chains_num=16, chain_length=8)
+    skinned_mesh_generate(rig)
+    frames_evaluate(timer)
+
+
+def benchmark_many_objects(timer):
+    """Animated transforms of many objects parented to each other in short chains."""
+    collection = bpy.context.scene.collection
+    parent = None
+    for i in range(5000):
+        ob = bpy.data.objects.new("Empty%d" % i, None)
+        collection.objects.link(ob)
+        ob.parent = parent if i % 10 else None
+        parent = ob
+        for frame, value in ((FRAMES[0], 0.0), (FRAMES[-1], 1.0)):
+            ob.location.z = value
+            ob.keyframe_insert("location", index=2, frame=frame)
+    frames_evaluate(timer)
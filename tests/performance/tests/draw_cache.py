@@ -0,0 +1,35 @@
+# Apache License, Version 2.0
+
+"""Extraction of the draw cache of edited meshes, this needs a window to draw in."""
+
+import bpy
+
+BACKGROUND = False
+
+
+def view3d_redraw(timer, ob, iterations=20):
+    """Redraw after changing the mesh, so its batch cache is extracted again every time."""
+    mesh = ob.data
+    bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+    with timer:
+        for i in range(iterations):
+            mesh.vertices[0].co.z = i * 0.01
+            mesh.update()
+            bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+
+
+def benchmark_object_mode(timer):
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=512, y_subdivisions=512, size=4.0)
+    view3d_redraw(timer, bpy.context.active_object)
+
+
+def benchmark_edit_mode(timer):
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=256, y_subdivisions=256, size=4.0)
+    ob = bpy.context.active_object
+    bpy.ops.object.mode_set(mode='EDIT')
+    bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+    with timer:
+        for _ in range(20):
+            bpy.ops.transform.translate(value=(0.0, 0.0, 0.01))
+            bpy.ops.wm.redraw_timer(type='DRAW_WIN_SWAP', iterations=1)
+    bpy.ops.object.mode_set(mode='OBJECT')
@@ -0,0 +1,62 @@
+# Apache License, Version 2.0
+
+"""Evaluation of geometry node trees scattering and instancing geometry."""
+
+import bpy
+
+
+def node_group_create(ob):
+    group = bpy.data.node_groups.new("Geometry Nodes", 'GeometryNodeTree')
+    group.inputs.new('NodeSocketGeometry', "Geometry")
+    group.outputs.new('NodeSocketGeometry', "Geometry")
+    modifier = ob.modifiers.new("Nodes", 'NODES')
+    modifier.node_group = group
+    return group
+
+
+def nodes_chain(group, node_types):
+    """Links the geometry of nodes of the given types one after the other, returns the nodes."""
+    nodes = [group.nodes.new('NodeGroupInput')]
+    nodes += [group.nodes.new(node_type) for node_type in node_types]
+    nodes.append(group.nodes.new('NodeGroupOutput'))
+    for node_from, node_to in zip(nodes[:-1], nodes[1:]):
+        group.links.new(node_from.outputs[0], node_to.inputs[0])
+    return nodes[1:-1]
+
+
+def tree_evaluate(timer, ob, socket, values):
+    """Evaluate the object after each change of a node input."""
+    view_layer = bpy.context.view_layer
+    view_layer.update()
+    with timer:
+        for value in values:
+            socket.default_value = value
+            view_layer.update()
+            ob.evaluated_get(bpy.context.evaluated_depsgraph_get())
+
+
+def benchmark_scatter_instances(timer):
+    bpy.ops.mesh.primitive_ico_sphere_add(subdivisions=2, radius=0.02)
+    instance = bpy.context.active_object
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=64, y_subdivisions=64, size=10.0)
+    ob = bpy.context.active_object
+
+    group = node_group_create(ob)
+    distribute, point_instance = nodes_chain(
+        group, ('GeometryNodePointDistribute', 'GeometryNodePointInstance'))
+    distribute.inputs["Density Max"].default_value = 500.0
+    point_instance.instance_type = 'OBJECT'
+    point_instance.inputs["Object"].default_value = instance
+    tree_evaluate(timer, ob, distribute.inputs["Seed"], list(range(10)))
+
+
+def benchmark_subdivide_transform(timer):
+    bpy.ops.mesh.primitive_monkey_add()
+    ob = bpy.context.active_object
+
+    group = node_group_create(ob)
+    subdivision, transform = nodes_chain(
+        group, ('GeometryNodeSubdivisionSurface', 'GeometryNodeTransform'))
+    subdivision.inputs["Level"].default_value = 3
+    tree_evaluate(timer, ob, transform.inputs["Scale"], [
+        (1.0 + 0.1 * i,) * 3 for i in range(10)])
@@ -0,0 +1,62 @@
+# Apache License, Version 2.0
+
+"""Evaluation of modifier stacks on dense meshes, like the cases of `bl_mesh_modifiers.py`."""
+
+import bpy
+
+
+def grid_add(size=256):
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=size, y_subdivisions=size, size=4.0)
+    return bpy.context.active_object
+
+
+def stack_evaluate(timer, ob, modifier, prop, values):
+    """Evaluate the stack after each change of a property of its first modifier."""
+    view_layer = bpy.context.view_layer
+    view_layer.update()
+    with timer:
+        for value in values:
+            setattr(modifier, prop, value)
+            view_layer.update()
+            ob.evaluated_get(bpy.context.evaluated_depsgraph_get())
+
+
+def benchmark_subdivision(timer):
+    ob = grid_add(size=128)
+    displace = ob.modifiers.new("Displace", 'DISPLACE')
+    subsurf = ob.modifiers.new("Subdivision", 'SUBSURF')
+    subsurf.levels = 2
+    stack_evaluate(timer, ob, displace, "strength", [0.1 * i for i in range(10)])
+
+
+def benchmark_deform_stack(timer):
+    ob = grid_add()
+    wave = ob.modifiers.new("Wave", 'WAVE')
+    ob.modifiers.new("Smooth", 'SMOOTH').iterations = 4
+    ob.modifiers.new("SimpleDeform", 'SIMPLE_DEFORM').angle = 0.5
+    ob.modifiers.new("Displace", 'DISPLACE')
+    stack_evaluate(timer, ob, wave, "time_offset", [float(i) for i in range(20)])
+
+
+def benchmark_generate_stack(timer):
+    ob = grid_add(size=64)
+    array = ob.modifiers.new("Array", 'ARRAY')
+    array.count = 4
+    ob.modifiers.new("Solidify", 'SOLIDIFY').thickness = 0.05
+    bevel = ob.modifiers.new("Bevel", 'BEVEL')
+    bevel.segments = 2
+    ob.modifiers.new("Triangulate", 'TRIANGULATE')
+    stack_evaluate(timer, ob, array, "relative_offset_displace", [
+        (1.0 + 0.01 * i, 0.0, 0.0) for i in range(10)])
+
+
+def benchmark_boolean(timer):
+    ob = grid_add(size=64)
+    ob.modifiers.new("Solidify", 'SOLIDIFY').thickness = 0.5
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=64, ring_count=32, radius=1.5)
+    cutter = bpy.context.active_object
+    cutter.hide_viewport = True
+    boolean = ob.modifiers.new("Boolean", 'BOOLEAN')
+    boolean.object = cutter
+    boolean.solver = 'EXACT'
+    stack_evaluate(timer, ob, boolean, "operation", ['DIFFERENCE', 'UNION', 'INTERSECT'])
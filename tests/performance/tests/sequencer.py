@@ -0,0 +1,43 @@
+# Apache License, Version 2.0
+
+"""Rendering of sequencer frames with stacked effect strips."""
+
+import bpy
+
+FRAMES = range(1, 11)
+
+
+def strips_generate(layers_num=8):
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.frame_start = FRAMES[0]
+    scene.frame_end = FRAMES[-1]
+
+    sequences = scene.sequence_editor_create().sequences
+    for i in range(layers_num):
+        color = sequences.new_effect(
+            "Color%d" % i, 'COLOR', channel=i * 3 + 1,
+            frame_start=FRAMES[0], frame_end=FRAMES[-1] + 1)
+        color.color = (i / layers_num, 0.5, 1.0 - i / layers_num)
+        transform = sequences.new_effect(
+            "Transform%d" % i, 'TRANSFORM', channel=i * 3 + 2,
+            frame_start=FRAMES[0], frame_end=FRAMES[-1] + 1, seq1=color)
+        transform.rotation_start = 10.0 * i
+        transform.scale_start_x = transform.scale_start_y = 0.8
+        transform.blend_type = 'ALPHA_OVER'
+        blur = sequences.new_effect(
+            "Blur%d" % i, 'GAUSSIAN_BLUR', channel=i * 3 + 3,
+            frame_start=FRAMES[0], frame_end=FRAMES[-1] + 1, seq1=transform)
+        blur.size_x = blur.size_y = 4.0
+        blur.blend_type = 'ALPHA_OVER'
+
+
+def benchmark_render_effects(timer):
+    strips_generate()
+    scene = bpy.context.scene
+    with timer:
+        for frame in FRAMES:
+            scene.frame_set(frame)
+            bpy.ops.render.render()
@@ -0,0 +1,154 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+"""
+Compare the compiled pose evaluation with the evaluation bone by bone, and time both.
+
+blender -b -noaudio --factory-startup --python tests/python/bl_animation_pose_compiled.py
+"""
+
+import random
+import sys
+import time
+import unittest
+
+import bpy
+
+FRAMES = range(1, 41)
+
+
+def rig_create(chains_num, chain_length):
+    """Chains of bones parented to a common root, with constraints between the chains."""
+    armature = bpy.data.armatures.new("Rig")
+    ob = bpy.data.objects.new("Rig", armature)
+    bpy.context.scene.collection.objects.link(ob)
+    bpy.context.view_layer.objects.active = ob
+
+    bpy.ops.object.mode_set(mode='EDIT')
+    root = armature.edit_bones.new("root")
+    root.head = (0.0, 0.0, 0.0)
+    root.tail = (0.0, 0.0, 1.0)
+    for chain in range(chains_num):
+        parent = root
+        for i in range(chain_length):
+            bone = armature.edit_bones.new("chain%d.%d" % (chain, i))
+            bone.head = (chain * 0.1, 0.0, 1.0 + i * 0.5)
+            bone.tail = (chain * 0.1, 0.0, 1.5 + i * 0.5)
+            bone.parent = parent
+            bone.use_connect = (i > 0)
+            bone.bbone_segments = 4 if (i % 2) else 1
+            parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    for chain in range(1, chains_num):
+        tip = ob.pose.bones["chain%d.%d" % (chain, chain_length - 1)]
+        con = tip.constraints.new('COPY_ROTATION')
+        con.target = ob
+        con.subtarget = "chain%d.%d" % (chain - 1, chain_length - 1)
+        con.influence = 0.5
+
+        middle = ob.pose.bones["chain%d.2" % chain]
+        con = middle.constraints.new('DAMPED_TRACK')
+        con.target = ob
+        con.subtarget = "chain%d.1" % (chain - 1)
+        con.head_tail = 0.5
+        con.use_bbone_shape = True
+
+    rng = random.Random(0)
+    for pchan in ob.pose.bones:
+        pchan.rotation_mode = 'XYZ'
+        for frame in (FRAMES[0], FRAMES[len(FRAMES) // 2], FRAMES[-1]):
+            pchan.rotation_euler = [rng.uniform(-0.5, 0.5) for _ in range(3)]
+            pchan.keyframe_insert("rotation_euler", frame=frame)
+    return ob
+
+
+def pose_evaluate(ob, use_compiled_evaluation):
+    """Evaluate all frames, returns the bone matrices of every frame and the time it took."""
+    ob.pose.use_compiled_evaluation = use_compiled_evaluation
+    scene = bpy.context.scene
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    # Build the relations before timing.
+    scene.frame_set(FRAMES[0])
+
+    result = []
+    start_time = time.perf_counter()
+    for frame in FRAMES:
+        scene.frame_set(frame)
+        ob_eval = ob.evaluated_get(depsgraph)
+        matrices = []
+        for pchan in ob_eval.pose.bones:
+            matrices.append(pchan.matrix.copy())
+            if pchan.bone.bbone_segments > 1:
+                matrices.append(pchan.bbone_segment_matrix(1))
+        result.append(matrices)
+    return result, time.perf_counter() - start_time
+
+
+class PoseCompiledEvaluationTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    def assertPosesEqual(self, poses, poses_expected):
+        self.assertEqual(len(poses), len(poses_expected))
+        for matrices, matrices_expected in zip(poses, poses_expected):
+            self.assertEqual(len(matrices), len(matrices_expected))
+            for matrix, matrix_expected in zip(matrices, matrices_expected):
+                for row, row_expected in zip(matrix, matrix_expected):
+                    for value, value_expected in zip(row, row_expected):
+                        self.assertAlmostEqual(value, value_expected, places=5)
+
+    def compare_evaluations(self, ob):
+        poses_expected, time_bones = pose_evaluate(ob, False)
+        poses, time_compiled = pose_evaluate(ob, True)
+        self.assertPosesEqual(poses, poses_expected)
+        return time_bones, time_compiled
+
+    def test_constrained_chains(self):
+        ob = rig_create(chains_num=4, chain_length=6)
+        self.compare_evaluations(ob)
+
+    def test_ik_fallback(self):
+        """Rigs using IK are evaluated bone by bone, the option must not change the result."""
+        ob = rig_create(chains_num=3, chain_length=4)
+        con = ob.pose.bones["chain1.3"].constraints.new('IK')
+        con.target = ob
+        con.subtarget = "chain0.3"
+        con.chain_count = 3
+        self.compare_evaluations(ob)
+
+    def test_benchmark(self):
+        ob = rig_create(chains_num=64, chain_length=12)
+        time_bones, time_compiled = self.compare_evaluations(ob)
+        bones_num = len(ob.pose.bones)
+        print("\nPose evaluation of %d bones over %d frames:" % (bones_num, len(FRAMES)))
+        print("  Bone by bone: %.4f seconds" % time_bones)
+        print("  Compiled:     %.4f seconds" % time_compiled)
+
+
+def main():
+    argv = [sys.argv[0]]
+    if '--' in sys.argv:
+        argv += sys.argv[sys.argv.index('--') + 1:]
+    unittest.main(argv=argv)
+
+
+if __name__ == "__main__":
+    main()
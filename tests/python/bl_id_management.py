@@ -178,6 +178,58 @@ class TestIdRename(TestHelper, unittest.TestCase):
         self.ensure_proper_order()
 
 
+
+class TestIdBatchRemove(unittest.TestCase):
+
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+        scene = bpy.context.scene
+        self.material = bpy.data.materials.new("Material")
+        self.mesh = bpy.data.meshes.new("Mesh")
+        self.mesh.materials.append(self.material)
+        self.collection = bpy.data.collections.new("Collection")
+        scene.collection.children.link(self.collection)
+        for i in range(20):
+            ob = bpy.data.objects.new("Object%.2d" % i, self.mesh)
+            self.collection.objects.link(ob)
+            if i % 2:
+                scene.collection.objects.link(ob)
+
+    def test_remove_users(self):
+        bpy.data.batch_remove([ob for ob in bpy.data.objects if ob.name < "Object10"])
+        self.assertEqual(len(bpy.data.objects), 10)
+        self.assertEqual(len(self.collection.objects), 10)
+        self.assertEqual(len(bpy.context.scene.collection.objects), 5)
+        self.assertEqual(self.mesh.users, 10)
+        self.assertEqual(self.material.users, 1)
+
+    def test_remove_never_null_usage(self):
+        # Objects can't exist without their data, removing the mesh removes them too.
+        bpy.data.batch_remove([self.mesh])
+        self.assertEqual(len(bpy.data.objects), 0)
+        self.assertEqual(len(self.collection.objects), 0)
+        self.assertEqual(len(bpy.context.scene.collection.objects), 0)
+        self.assertEqual(self.material.users, 0)
+
+    def test_remove_used_by_embedded(self):
+        # Images used by the node tree of a material, which isn't an ID of its own in Main.
+        image = bpy.data.images.new("Image", 4, 4)
+        self.material.use_nodes = True
+        node = self.material.node_tree.nodes.new('ShaderNodeTexImage')
+        node.image = image
+        bpy.data.batch_remove([image])
+        self.assertEqual(len(bpy.data.images), 0)
+        self.assertIsNone(node.image)
+
+    def test_remove_collection(self):
+        bpy.data.batch_remove([self.collection] + list(bpy.data.objects)[:4])
+        self.assertEqual(len(bpy.data.collections), 0)
+        self.assertEqual(len(bpy.data.objects), 16)
+        self.assertEqual(len(bpy.context.scene.collection.children), 0)
+        self.assertEqual(len(bpy.context.scene.collection.objects), 8)
+        self.assertEqual(self.mesh.users, 16)
+
+
 if __name__ == '__main__':
     import sys
     sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
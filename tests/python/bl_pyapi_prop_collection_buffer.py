@@ -0,0 +1,63 @@
+# Apache License, Version 2.0
+
+# ./blender.bin --background -noaudio --python tests/python/bl_pyapi_prop_collection_buffer.py -- --verbose
+import bpy
+import unittest
+import numpy as np
+
+
+class TestPropCollectionBuffer(unittest.TestCase):
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("test_buffer")
+        self.mesh.vertices.add(4)
+        self.mesh.loops.add(4)
+        self.mesh.polygons.add(1)
+        co = np.arange(12, dtype=np.float32)
+        self.mesh.vertices.foreach_set("co", co)
+        self.mesh.loops.foreach_set("vertex_index", np.arange(4, dtype=np.int32))
+        self.mesh.polygons.foreach_set("loop_start", (0,))
+        self.mesh.polygons.foreach_set("loop_total", (4,))
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.mesh)
+
+    def test_read(self):
+        co = np.asarray(self.mesh.vertices.as_buffer("co"))
+        self.assertEqual(co.shape, (4, 3))
+        self.assertEqual(co.dtype, np.float32)
+        self.assertEqual(co.tolist(), np.arange(12, dtype=np.float32).reshape(4, 3).tolist())
+
+        indices = np.asarray(self.mesh.loops.as_buffer("vertex_index"))
+        self.assertEqual(indices.shape, (4,))
+        self.assertEqual(indices.tolist(), [0, 1, 2, 3])
+
+    def test_read_only(self):
+        view = self.mesh.vertices.as_buffer("co")
+        self.assertTrue(view.readonly)
+        with self.assertRaises(TypeError):
+            view[0, 0] = 1.0
+
+    def test_write(self):
+        with self.mesh.vertices.as_buffer("co", write=True) as view:
+            co = np.asarray(view)
+            co[:, 2] = 5.0
+            del co
+        self.assertEqual([v.co.z for v in self.mesh.vertices], [5.0] * 4)
+
+    def test_attribute(self):
+        attr = self.mesh.attributes.new("test", 'FLOAT', 'POINT')
+        with attr.data.as_buffer("value", write=True) as view:
+            np.asarray(view)[:] = (1.0, 2.0, 3.0, 4.0)
+        self.assertEqual([v.value for v in attr.data], [1.0, 2.0, 3.0, 4.0])
+
+    def test_unsupported(self):
+        with self.assertRaises(AttributeError):
+            self.mesh.vertices.as_buffer("not_an_attribute")
+        with self.assertRaises(TypeError):
+            self.mesh.vertices.as_buffer("normal")
+
+
+if __name__ == '__main__':
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()